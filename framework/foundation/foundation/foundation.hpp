@@ -6,7 +6,19 @@
 #include "foundation/gemo.hpp"
 #include "foundation/wrapper.hpp"
 #include "foundation/module.hpp"
-#include "foundation/cost_timer.hpp"
+#include "foundation/profiler.hpp"
+#include "foundation/mesh_optimizer.hpp"
+#include "foundation/mesh_simplifier.hpp"
+#include "foundation/mesh_cluster.hpp"
+#include "foundation/mesh_cache.hpp"
+#include "foundation/thread_pool.hpp"
+#include "foundation/texture_streaming.hpp"
+#include "foundation/texture_compression.hpp"
+#include "foundation/mipmap_generator.hpp"
+#include "foundation/rect_packer.hpp"
+#include "foundation/light_cluster.hpp"
+#include "foundation/frame_arena.hpp"
+#include "foundation/vertex_transform.hpp"
 
 namespace fd
 {
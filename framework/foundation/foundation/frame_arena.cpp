@@ -0,0 +1,122 @@
+#include "foundation/frame_arena.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace fd
+{
+    const size_t FrameArena::DEFAULT_BLOCK_SIZE = 64u * 1024u;
+
+    FrameArena::Marker::Marker(uint32_t blockIndex
+        , size_t offset
+        )
+        : blockIndex(blockIndex)
+        , offset(offset)
+    {
+
+    }
+
+    FrameArena::FrameArena(size_t blockSize)
+        : m_blockSize(blockSize)
+        , m_blocks()
+        , m_blockIndex(0u)
+        , m_offset(0u)
+        , m_blockAllocationCount(0u)
+    {
+
+    }
+
+    void *FrameArena::allocate(size_t size, size_t alignment)
+    {
+#ifdef DEBUG
+        if (alignment == 0u || (alignment & (alignment - 1u)) != 0u)
+            throw std::invalid_argument("Alignment of frame arena allocation should be a power of 2.");
+#endif //DEBUG
+        //Blocks too small for the allocation are skipped, a new block is inserted when no kept block fits it.
+        while (m_blockIndex < static_cast<uint32_t>(m_blocks.size()))
+        {
+            const auto &block = m_blocks[m_blockIndex];
+            uintptr_t address = reinterpret_cast<uintptr_t>(block.pMemory.get());
+            size_t offset = static_cast<size_t>(((address + m_offset + alignment - 1u) & ~(alignment - 1u)) - address);
+            if (offset + size <= block.size)
+            {
+                m_offset = offset + size;
+                return block.pMemory.get() + offset;
+            }
+            ++m_blockIndex;
+            m_offset = 0u;
+        }
+        _Block block;
+        block.size = std::max(m_blockSize, size + alignment);
+        block.pMemory = std::unique_ptr<uint8_t[]>(new uint8_t[block.size]);
+        ++m_blockAllocationCount;
+        m_blocks.push_back(std::move(block));
+        return allocate(size, alignment);
+    }
+
+    FrameArena::Marker FrameArena::getMarker() const
+    {
+        return Marker(m_blockIndex, m_offset);
+    }
+
+    void FrameArena::rewind(const Marker &marker)
+    {
+        m_blockIndex = marker.blockIndex;
+        m_offset = marker.offset;
+    }
+
+    void FrameArena::reset()
+    {
+        m_blockIndex = 0u;
+        m_offset = 0u;
+    }
+
+    size_t FrameArena::getBlockSize() const
+    {
+        return m_blockSize;
+    }
+
+    size_t FrameArena::getUsedSize() const
+    {
+        size_t size = m_offset;
+        uint32_t blockCount = std::min(m_blockIndex, static_cast<uint32_t>(m_blocks.size()));
+        for (uint32_t i = 0u; i < blockCount; ++i)
+        {
+            size += m_blocks[i].size;
+        }
+        return size;
+    }
+
+    size_t FrameArena::getCapacity() const
+    {
+        size_t capacity = 0u;
+        for (const auto &block : m_blocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+    uint64_t FrameArena::getBlockAllocationCount() const
+    {
+        return m_blockAllocationCount;
+    }
+
+    FrameArenaScope::FrameArenaScope(FrameArena &arena)
+        : m_arena(arena)
+        , m_marker(arena.getMarker())
+    {
+
+    }
+
+    FrameArenaScope::~FrameArenaScope()
+    {
+        m_arena.rewind(m_marker);
+    }
+
+    FrameArena &getDefaultFrameArena()
+    {
+        static FrameArena arena;
+        return arena;
+    }
+} //fd
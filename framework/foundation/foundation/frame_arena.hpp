@@ -0,0 +1,85 @@
+#ifndef FD_FRAME_ARENA_HPP
+#define FD_FRAME_ARENA_HPP
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    /*Bump allocator of temporary arrays of a frame, memory is got by moving an offset in blocks and is never
+      freed alone, it is reused after the arena is reset or rewound. Blocks are kept when it is reset, so a
+      frame allocates from heap only when it needs more memory than any frame before it.
+      Destructors of items aren't called, so only trivially destructible types can be allocated.*/
+    class FrameArena
+    {
+    public:
+        static const size_t DEFAULT_BLOCK_SIZE;
+
+        struct Marker
+        {
+            uint32_t blockIndex;
+            size_t offset;
+
+            Marker(uint32_t blockIndex = 0u
+                , size_t offset = 0u
+                );
+        };
+
+        FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        FrameArena(const FrameArena &) = delete;
+        FrameArena& operator=(const FrameArena &) = delete;
+
+        void *allocate(size_t size, size_t alignment);
+        //Items are value initialized.
+        template <typename T>
+        T *allocateArray(size_t count);
+
+        Marker getMarker() const;
+        //Memory allocated after the marker is got is reused by following allocations.
+        void rewind(const Marker &marker);
+        void reset();
+
+        size_t getBlockSize() const;
+        //Bytes from beginning of the first block to the current offset, skipped tails of blocks are included.
+        size_t getUsedSize() const;
+        size_t getCapacity() const;
+        //Count of blocks allocated from heap since it is created.
+        uint64_t getBlockAllocationCount() const;
+    private:
+        struct _Block
+        {
+            std::unique_ptr<uint8_t[]> pMemory;
+            size_t size;
+        };
+
+        size_t m_blockSize;
+        std::vector<_Block> m_blocks;
+        uint32_t m_blockIndex;
+        size_t m_offset;
+        uint64_t m_blockAllocationCount;
+    };
+
+    //Memory allocated in the scope is reused after the scope is left, so functions not called in frames don't grow the arena.
+    class FrameArenaScope
+    {
+    public:
+        FrameArenaScope(FrameArena &arena);
+        ~FrameArenaScope();
+        FrameArenaScope(const FrameArenaScope &) = delete;
+        FrameArenaScope& operator=(const FrameArenaScope &) = delete;
+    private:
+        FrameArena &m_arena;
+        FrameArena::Marker m_marker;
+    };
+
+    //The arena of the rendering thread, renderer resets it when a frame begins, so its memory can't be kept across rendering.
+    extern FrameArena &getDefaultFrameArena();
+} //fd
+
+#include "foundation/frame_arena.inl"
+
+#endif //FD_FRAME_ARENA_HPP
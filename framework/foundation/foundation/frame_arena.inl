@@ -0,0 +1,15 @@
+namespace fd
+{
+    template <typename T>
+    T *FrameArena::allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Items of frame arena are never destroyed.");
+        if (count == 0u) return nullptr;
+        T *pItems = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0u; i < count; ++i)
+        {
+            new (pItems + i) T();
+        }
+        return pItems;
+    }
+} //fd
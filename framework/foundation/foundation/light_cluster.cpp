@@ -0,0 +1,343 @@
+#include "foundation/light_cluster.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "foundation/thread_pool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FD_LIGHT_CLUSTER_USE_SSE
+#endif
+
+namespace fd
+{
+    //Lights handled by one task when light ranges are caculated.
+    static const uint32_t LIGHT_RANGE_BATCH_SIZE = 64u;
+    static const float HALF_PI = 1.57079632679f;
+    static const float QUARTER_PI = 0.78539816339f;
+
+    /*Test the sphere with a group of 4 planes through the origin, bits of the less mask are set for planes
+      whose signed distances to the center aren't greater than radius, and bits of the greater mask are set
+      for planes whose signed distances aren't less than -radius.*/
+    static void _testPlanes(const float *pNormals
+        , const float *pNormalsZ
+        , float center
+        , float centerZ
+        , float radius
+        , uint32_t &lessMask
+        , uint32_t &greaterMask
+        )
+    {
+#ifdef FD_LIGHT_CLUSTER_USE_SSE
+        __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pNormals), _mm_set1_ps(center)),
+            _mm_mul_ps(_mm_loadu_ps(pNormalsZ), _mm_set1_ps(centerZ)));
+        lessMask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distance, _mm_set1_ps(radius))));
+        greaterMask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(distance, _mm_set1_ps(-radius))));
+#else
+        lessMask = 0u;
+        greaterMask = 0u;
+        for (uint32_t i = 0u; i < 4u; ++i)
+        {
+            float distance = pNormals[i] * center + pNormalsZ[i] * centerZ;
+            if (distance <= radius) lessMask |= 1u << i;
+            if (distance >= -radius) greaterMask |= 1u << i;
+        }
+#endif //FD_LIGHT_CLUSTER_USE_SSE
+    }
+
+    /*Tile i is between plane i and plane i + 1, the sphere may touch the tile only when it isn't on the
+      right of plane i + 1 and isn't on the left of plane i. It returns false when no tile is touched.*/
+    static Bool32 _findTileRange(const std::vector<float> &normals
+        , const std::vector<float> &normalsZ
+        , uint32_t tileCount
+        , float center
+        , float centerZ
+        , float radius
+        , uint32_t &begin
+        , uint32_t &end
+        )
+    {
+        begin = tileCount;
+        end = 0u;
+        uint32_t planeCount = static_cast<uint32_t>(normals.size());
+        for (uint32_t groupBegin = 0u; groupBegin < planeCount; groupBegin += 4u)
+        {
+            uint32_t lessMask;
+            uint32_t greaterMask;
+            _testPlanes(normals.data() + groupBegin, normalsZ.data() + groupBegin, center, centerZ, radius,
+                lessMask, greaterMask);
+            for (uint32_t i = 0u; i < 4u; ++i)
+            {
+                uint32_t plane = groupBegin + i;
+                if (plane >= 1u && plane <= tileCount && (lessMask & (1u << i)) != 0u)
+                    begin = std::min(begin, plane - 1u);
+                if (plane < tileCount && (greaterMask & (1u << i)) != 0u)
+                    end = std::max(end, plane + 1u);
+            }
+        }
+        return begin < end ? FD_TRUE : FD_FALSE;
+    }
+
+    //Planes dividing [-tanHalfFov, tanHalfFov] evenly, normals point to the positive side.
+    static void _createTilePlanes(uint32_t tileCount
+        , float tanHalfFov
+        , std::vector<float> &normals
+        , std::vector<float> &normalsZ
+        )
+    {
+        uint32_t planeCount = tileCount + 1u;
+        uint32_t paddedCount = (planeCount + 3u) / 4u * 4u;
+        normals.assign(paddedCount, 0.0f);
+        normalsZ.assign(paddedCount, 0.0f);
+        for (uint32_t i = 0u; i < planeCount; ++i)
+        {
+            float tangent = -tanHalfFov + 2.0f * tanHalfFov * static_cast<float>(i) / static_cast<float>(tileCount);
+            float length = std::sqrt(1.0f + tangent * tangent);
+            normals[i] = 1.0f / length;
+            normalsZ[i] = -tangent / length;
+        }
+    }
+
+    LightClusterGridInfo::LightClusterGridInfo(uint32_t clusterCountX
+        , uint32_t clusterCountY
+        , uint32_t clusterCountZ
+        , float tanHalfFovX
+        , float tanHalfFovY
+        , float depthNear
+        , float depthFar
+        )
+        : clusterCountX(clusterCountX)
+        , clusterCountY(clusterCountY)
+        , clusterCountZ(clusterCountZ)
+        , tanHalfFovX(tanHalfFovX)
+        , tanHalfFovY(tanHalfFovY)
+        , depthNear(depthNear)
+        , depthFar(depthFar)
+    {
+
+    }
+
+    LightClusterAssigner::LightClusterAssigner(const LightClusterGridInfo &gridInfo)
+        : m_gridInfo(gridInfo)
+        , m_sliceScale()
+        , m_xPlaneNormalsX()
+        , m_xPlaneNormalsZ()
+        , m_yPlaneNormalsY()
+        , m_yPlaneNormalsZ()
+        , m_lightSpheres()
+        , m_lightRanges()
+        , m_clusters()
+        , m_sliceLightIndices()
+        , m_sliceOffsets()
+        , m_lightIndices()
+    {
+        _updateGrid();
+    }
+
+    const LightClusterGridInfo &LightClusterAssigner::getGridInfo() const
+    {
+        return m_gridInfo;
+    }
+
+    void LightClusterAssigner::setGridInfo(const LightClusterGridInfo &gridInfo)
+    {
+        m_gridInfo = gridInfo;
+        _updateGrid();
+    }
+
+    uint32_t LightClusterAssigner::getClusterCount() const
+    {
+        return m_gridInfo.clusterCountX * m_gridInfo.clusterCountY * m_gridInfo.clusterCountZ;
+    }
+
+    uint32_t LightClusterAssigner::getClusterIndex(uint32_t x, uint32_t y, uint32_t z) const
+    {
+        return (z * m_gridInfo.clusterCountY + y) * m_gridInfo.clusterCountX + x;
+    }
+
+    uint32_t LightClusterAssigner::caculateSlice(float depth) const
+    {
+        if (depth < m_gridInfo.depthNear || depth >= m_gridInfo.depthFar) return m_gridInfo.clusterCountZ;
+        auto slice = static_cast<uint32_t>(std::log(depth / m_gridInfo.depthNear) * m_sliceScale);
+        return std::min(slice, m_gridInfo.clusterCountZ - 1u);
+    }
+
+    void LightClusterAssigner::clearLights()
+    {
+        m_lightSpheres.clear();
+    }
+
+    uint32_t LightClusterAssigner::addPointLight(const glm::vec3 &position, float range)
+    {
+        m_lightSpheres.push_back(glm::vec4(position, range));
+        return static_cast<uint32_t>(m_lightSpheres.size()) - 1u;
+    }
+
+    uint32_t LightClusterAssigner::addSpotLight(const glm::vec3 &position
+        , const glm::vec3 &direction
+        , float range
+        , float outerAngle
+        )
+    {
+        //Bounding sphere of the cone, the cone wider than a hemisphere is bounded by the sphere of its range.
+        glm::vec4 sphere;
+        if (outerAngle >= HALF_PI)
+        {
+            sphere = glm::vec4(position, range);
+        }
+        else if (outerAngle > QUARTER_PI)
+        {
+            glm::vec3 center = position + glm::normalize(direction) * (std::cos(outerAngle) * range);
+            sphere = glm::vec4(center, std::sin(outerAngle) * range);
+        }
+        else
+        {
+            float radius = range / (2.0f * std::cos(outerAngle));
+            sphere = glm::vec4(position + glm::normalize(direction) * radius, radius);
+        }
+        m_lightSpheres.push_back(sphere);
+        return static_cast<uint32_t>(m_lightSpheres.size()) - 1u;
+    }
+
+    uint32_t LightClusterAssigner::getLightCount() const
+    {
+        return static_cast<uint32_t>(m_lightSpheres.size());
+    }
+
+    void LightClusterAssigner::assign()
+    {
+        auto &threadPool = getDefaultThreadPool();
+        uint32_t lightCount = static_cast<uint32_t>(m_lightSpheres.size());
+        uint32_t sliceCount = m_gridInfo.clusterCountZ;
+        uint32_t tileCount = m_gridInfo.clusterCountX * m_gridInfo.clusterCountY;
+
+        m_lightRanges.resize(lightCount);
+        threadPool.parallelFor((lightCount + LIGHT_RANGE_BATCH_SIZE - 1u) / LIGHT_RANGE_BATCH_SIZE, [&](uint32_t batch) {
+            uint32_t end = std::min(lightCount, (batch + 1u) * LIGHT_RANGE_BATCH_SIZE);
+            for (uint32_t i = batch * LIGHT_RANGE_BATCH_SIZE; i < end; ++i)
+            {
+                m_lightRanges[i] = _caculateLightRange(m_lightSpheres[i]);
+            }
+        });
+
+        //Every slice is owned by one task, so clusters and index lists of the slice are written by it only.
+        m_clusters.resize(getClusterCount());
+        m_sliceLightIndices.resize(sliceCount);
+        threadPool.parallelFor(sliceCount, [&](uint32_t slice) {
+            _assignSlice(slice);
+        });
+
+        m_sliceOffsets.resize(sliceCount);
+        uint32_t indexCount = 0u;
+        for (uint32_t slice = 0u; slice < sliceCount; ++slice)
+        {
+            m_sliceOffsets[slice] = indexCount;
+            indexCount += static_cast<uint32_t>(m_sliceLightIndices[slice].size());
+        }
+        m_lightIndices.resize(indexCount);
+        threadPool.parallelFor(sliceCount, [&](uint32_t slice) {
+            const auto &sliceIndices = m_sliceLightIndices[slice];
+            uint32_t sliceOffset = m_sliceOffsets[slice];
+            if (sliceIndices.empty() == false)
+            {
+                memcpy(m_lightIndices.data() + sliceOffset, sliceIndices.data(), sliceIndices.size() * sizeof(uint32_t));
+            }
+            Cluster *pClusters = m_clusters.data() + static_cast<size_t>(slice) * tileCount;
+            for (uint32_t tile = 0u; tile < tileCount; ++tile)
+            {
+                pClusters[tile].offset += sliceOffset;
+            }
+        });
+    }
+
+    const std::vector<LightClusterAssigner::Cluster> &LightClusterAssigner::getClusters() const
+    {
+        return m_clusters;
+    }
+
+    const std::vector<uint32_t> &LightClusterAssigner::getLightIndices() const
+    {
+        return m_lightIndices;
+    }
+
+    void LightClusterAssigner::_updateGrid()
+    {
+#ifdef DEBUG
+        if (m_gridInfo.clusterCountX == 0u || m_gridInfo.clusterCountY == 0u || m_gridInfo.clusterCountZ == 0u)
+            throw std::invalid_argument("Cluster counts of the light cluster grid should be greater than 0.");
+        if (m_gridInfo.depthNear <= 0.0f || m_gridInfo.depthFar <= m_gridInfo.depthNear)
+            throw std::invalid_argument("Depth range of the light cluster grid should be positive and not empty.");
+#endif //DEBUG
+        m_sliceScale = static_cast<float>(m_gridInfo.clusterCountZ) / std::log(m_gridInfo.depthFar / m_gridInfo.depthNear);
+        _createTilePlanes(m_gridInfo.clusterCountX, m_gridInfo.tanHalfFovX, m_xPlaneNormalsX, m_xPlaneNormalsZ);
+        _createTilePlanes(m_gridInfo.clusterCountY, m_gridInfo.tanHalfFovY, m_yPlaneNormalsY, m_yPlaneNormalsZ);
+    }
+
+    LightClusterAssigner::_LightRange LightClusterAssigner::_caculateLightRange(const glm::vec4 &sphere) const
+    {
+        _LightRange range = {0u, 0u, 0u, 0u, 0u, 0u};
+        float minDepth = sphere.z - sphere.w;
+        float maxDepth = sphere.z + sphere.w;
+        if (maxDepth < m_gridInfo.depthNear || minDepth >= m_gridInfo.depthFar) return range;
+        if (_findTileRange(m_xPlaneNormalsX, m_xPlaneNormalsZ, m_gridInfo.clusterCountX, sphere.x, sphere.z, sphere.w,
+            range.beginX, range.endX) == FD_FALSE) return range;
+        if (_findTileRange(m_yPlaneNormalsY, m_yPlaneNormalsZ, m_gridInfo.clusterCountY, sphere.y, sphere.z, sphere.w,
+            range.beginY, range.endY) == FD_FALSE) return range;
+        //Depth is clamped into the grid, so slices are valid.
+        range.beginZ = caculateSlice(std::max(minDepth, m_gridInfo.depthNear));
+        range.endZ = std::min(caculateSlice(maxDepth), m_gridInfo.clusterCountZ - 1u) + 1u;
+        return range;
+    }
+
+    void LightClusterAssigner::_assignSlice(uint32_t slice)
+    {
+        uint32_t countX = m_gridInfo.clusterCountX;
+        uint32_t tileCount = countX * m_gridInfo.clusterCountY;
+        Cluster *pClusters = m_clusters.data() + static_cast<size_t>(slice) * tileCount;
+        for (uint32_t tile = 0u; tile < tileCount; ++tile)
+        {
+            pClusters[tile].count = 0u;
+        }
+
+        //Count lights of clusters first, then fill lists with offsets inside the slice.
+        uint32_t lightCount = static_cast<uint32_t>(m_lightRanges.size());
+        for (uint32_t i = 0u; i < lightCount; ++i)
+        {
+            const auto &range = m_lightRanges[i];
+            if (slice < range.beginZ || slice >= range.endZ) continue;
+            for (uint32_t y = range.beginY; y < range.endY; ++y)
+            {
+                for (uint32_t x = range.beginX; x < range.endX; ++x)
+                {
+                    ++pClusters[y * countX + x].count;
+                }
+            }
+        }
+        uint32_t indexCount = 0u;
+        for (uint32_t tile = 0u; tile < tileCount; ++tile)
+        {
+            pClusters[tile].offset = indexCount;
+            indexCount += pClusters[tile].count;
+            pClusters[tile].count = 0u;
+        }
+
+        auto &sliceIndices = m_sliceLightIndices[slice];
+        sliceIndices.resize(indexCount);
+        for (uint32_t i = 0u; i < lightCount; ++i)
+        {
+            const auto &range = m_lightRanges[i];
+            if (slice < range.beginZ || slice >= range.endZ) continue;
+            for (uint32_t y = range.beginY; y < range.endY; ++y)
+            {
+                for (uint32_t x = range.beginX; x < range.endX; ++x)
+                {
+                    auto &cluster = pClusters[y * countX + x];
+                    sliceIndices[cluster.offset + cluster.count] = i;
+                    ++cluster.count;
+                }
+            }
+        }
+    }
+} //fd
@@ -0,0 +1,109 @@
+#ifndef FD_LIGHT_CLUSTER_H
+#define FD_LIGHT_CLUSTER_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+#define FD_LIGHT_CLUSTER_DEFAULT_COUNT_X 16u
+#define FD_LIGHT_CLUSTER_DEFAULT_COUNT_Y 9u
+#define FD_LIGHT_CLUSTER_DEFAULT_COUNT_Z 24u
+
+namespace fd
+{
+    /*Grid dividing the view frustum of a perspective projection, view space is left hand and looks
+      along positive z. Tiles divide x / z and y / z evenly in [-tanHalfFov, tanHalfFov], slices divide
+      depth exponentially from depthNear to depthFar, so clusters far away aren't too thin.*/
+    struct LightClusterGridInfo
+    {
+        uint32_t clusterCountX;
+        uint32_t clusterCountY;
+        uint32_t clusterCountZ;
+        float tanHalfFovX;
+        float tanHalfFovY;
+        float depthNear;
+        float depthFar;
+
+        LightClusterGridInfo(uint32_t clusterCountX = FD_LIGHT_CLUSTER_DEFAULT_COUNT_X
+            , uint32_t clusterCountY = FD_LIGHT_CLUSTER_DEFAULT_COUNT_Y
+            , uint32_t clusterCountZ = FD_LIGHT_CLUSTER_DEFAULT_COUNT_Z
+            , float tanHalfFovX = 1.0f
+            , float tanHalfFovY = 1.0f
+            , float depthNear = 0.1f
+            , float depthFar = 100.0f
+            );
+    };
+
+    /*Assign point and spot lights to the clusters of a grid and build compact light index lists of clusters.
+      Lights are bounded by spheres and tested with the planes of tiles and slices, so a light may be
+      assigned to a few clusters it doesn't touch but never misses a cluster it touches.*/
+    class LightClusterAssigner
+    {
+    public:
+        //Range of light indices of a cluster, it matches uvec2 of std430 layout.
+        struct Cluster
+        {
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        LightClusterAssigner(const LightClusterGridInfo &gridInfo = LightClusterGridInfo());
+
+        const LightClusterGridInfo &getGridInfo() const;
+        void setGridInfo(const LightClusterGridInfo &gridInfo);
+        uint32_t getClusterCount() const;
+        //Clusters are in x, y, z order.
+        uint32_t getClusterIndex(uint32_t x, uint32_t y, uint32_t z) const;
+        //Slice containing the depth, it returns the slice count when the depth is out of the grid.
+        uint32_t caculateSlice(float depth) const;
+
+        void clearLights();
+        //Light index is the order of adding, position and direction are in view space.
+        uint32_t addPointLight(const glm::vec3 &position, float range);
+        uint32_t addSpotLight(const glm::vec3 &position
+            , const glm::vec3 &direction
+            , float range
+            , float outerAngle
+            );
+        uint32_t getLightCount() const;
+
+        /*Assign added lights to clusters, lights and slices are handled by the default thread pool.
+          Light indices of every cluster are in ascending order, the result doesn't depend on thread count.*/
+        void assign();
+        const std::vector<Cluster> &getClusters() const;
+        const std::vector<uint32_t> &getLightIndices() const;
+    private:
+        //Range of clusters covered by a light, it is empty when beginZ isn't less than endZ.
+        struct _LightRange
+        {
+            uint32_t beginX;
+            uint32_t endX;
+            uint32_t beginY;
+            uint32_t endY;
+            uint32_t beginZ;
+            uint32_t endZ;
+        };
+
+        LightClusterGridInfo m_gridInfo;
+        //Slice count divided by log(depthFar / depthNear).
+        float m_sliceScale;
+        /*Normals of tile planes through the origin, planes of x are (xPlaneNormalsX[i], 0, xPlaneNormalsZ[i])
+          and planes of y are (0, yPlaneNormalsY[i], yPlaneNormalsZ[i]). Arrays are padded to multiple of 4.*/
+        std::vector<float> m_xPlaneNormalsX;
+        std::vector<float> m_xPlaneNormalsZ;
+        std::vector<float> m_yPlaneNormalsY;
+        std::vector<float> m_yPlaneNormalsZ;
+        std::vector<glm::vec4> m_lightSpheres;
+        std::vector<_LightRange> m_lightRanges;
+        std::vector<Cluster> m_clusters;
+        std::vector<std::vector<uint32_t>> m_sliceLightIndices;
+        std::vector<uint32_t> m_sliceOffsets;
+        std::vector<uint32_t> m_lightIndices;
+
+        void _updateGrid();
+        _LightRange _caculateLightRange(const glm::vec4 &sphere) const;
+        void _assignSlice(uint32_t slice);
+    };
+} //fd
+
+#endif //FD_LIGHT_CLUSTER_H
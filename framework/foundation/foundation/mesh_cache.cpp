@@ -0,0 +1,433 @@
+#include "foundation/mesh_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif //_WIN32
+#include "foundation/util.hpp"
+
+namespace fd
+{
+    inline static uint64_t _alignCacheOffset(uint64_t offset)
+    {
+        return (offset + FD_MESH_CACHE_ALIGNMENT - 1u) / FD_MESH_CACHE_ALIGNMENT * FD_MESH_CACHE_ALIGNMENT;
+    }
+
+    inline static void _copyCacheName(char *pDst, const std::string &src)
+    {
+        size_t size = std::min(src.size(), static_cast<size_t>(FD_MESH_CACHE_NAME_SIZE - 1u));
+        memcpy(pDst, src.data(), size);
+        pDst[size] = '\0';
+    }
+
+    MeshCacheSubMesh::MeshCacheSubMesh()
+        : vertexStreamIndex(0u)
+        , vertexOffset(0u)
+        , vertexCount(0u)
+        , indexStreamIndex(0u)
+        , indexOffset(0u)
+        , indexCount(0u)
+        , materialIndex(0u)
+        , boundsMin{0.0f, 0.0f, 0.0f}
+        , boundsMax{0.0f, 0.0f, 0.0f}
+    {
+
+    }
+
+    MeshCacheMaterial::MeshCacheMaterial()
+        : name()
+        , diffuseTexture()
+        , diffuseColor{1.0f, 1.0f, 1.0f, 1.0f}
+    {
+
+    }
+
+    MeshCacheMaterial::MeshCacheMaterial(const std::string &name
+        , const std::string &diffuseTexture
+        , const float *pDiffuseColor
+        )
+        : name()
+        , diffuseTexture()
+        , diffuseColor{1.0f, 1.0f, 1.0f, 1.0f}
+    {
+        _copyCacheName(this->name, name);
+        _copyCacheName(this->diffuseTexture, diffuseTexture);
+        if (pDiffuseColor != nullptr) memcpy(diffuseColor, pDiffuseColor, sizeof(diffuseColor));
+    }
+
+    MeshCacheWriter::MeshCacheWriter()
+        : m_vertexStreams()
+        , m_vertexStreamDatas()
+        , m_indexStreams()
+        , m_indexStreamDatas()
+        , m_subMeshes()
+        , m_materials()
+    {
+
+    }
+
+    uint32_t MeshCacheWriter::addVertexStream(const void *pData, uint32_t stride, uint32_t vertexCount)
+    {
+        MeshCacheStream stream;
+        stream.stride = stride;
+        stream.count = vertexCount;
+        stream.dataOffset = 0u;
+        stream.dataSize = static_cast<uint64_t>(stride) * vertexCount;
+        m_vertexStreams.push_back(stream);
+        m_vertexStreamDatas.push_back(pData);
+        return static_cast<uint32_t>(m_vertexStreams.size() - 1u);
+    }
+
+    uint32_t MeshCacheWriter::addIndexStream(const uint32_t *pIndices, uint32_t indexCount)
+    {
+        MeshCacheStream stream;
+        stream.stride = static_cast<uint32_t>(sizeof(uint32_t));
+        stream.count = indexCount;
+        stream.dataOffset = 0u;
+        stream.dataSize = static_cast<uint64_t>(sizeof(uint32_t)) * indexCount;
+        m_indexStreams.push_back(stream);
+        m_indexStreamDatas.push_back(pIndices);
+        return static_cast<uint32_t>(m_indexStreams.size() - 1u);
+    }
+
+    void MeshCacheWriter::addSubMesh(const MeshCacheSubMesh &subMesh)
+    {
+        m_subMeshes.push_back(subMesh);
+    }
+
+    void MeshCacheWriter::addMaterial(const MeshCacheMaterial &material)
+    {
+        m_materials.push_back(material);
+    }
+
+    Bool32 MeshCacheWriter::write(const char *fileName, uint64_t key) const
+    {
+        //Layout tables and data blocks.
+        MeshCacheHeader header = {};
+        header.magic = FD_MESH_CACHE_MAGIC;
+        header.version = FD_MESH_CACHE_VERSION;
+        header.key = key;
+        header.vertexStreamCount = static_cast<uint32_t>(m_vertexStreams.size());
+        header.indexStreamCount = static_cast<uint32_t>(m_indexStreams.size());
+        header.subMeshCount = static_cast<uint32_t>(m_subMeshes.size());
+        header.materialCount = static_cast<uint32_t>(m_materials.size());
+        uint64_t offset = _alignCacheOffset(sizeof(MeshCacheHeader));
+        header.vertexStreamTableOffset = offset;
+        offset = _alignCacheOffset(offset + sizeof(MeshCacheStream) * header.vertexStreamCount);
+        header.indexStreamTableOffset = offset;
+        offset = _alignCacheOffset(offset + sizeof(MeshCacheStream) * header.indexStreamCount);
+        header.subMeshTableOffset = offset;
+        offset = _alignCacheOffset(offset + sizeof(MeshCacheSubMesh) * header.subMeshCount);
+        header.materialTableOffset = offset;
+        offset = _alignCacheOffset(offset + sizeof(MeshCacheMaterial) * header.materialCount);
+        std::vector<MeshCacheStream> vertexStreams(m_vertexStreams);
+        for (auto &stream : vertexStreams)
+        {
+            stream.dataOffset = offset;
+            offset = _alignCacheOffset(offset + stream.dataSize);
+        }
+        std::vector<MeshCacheStream> indexStreams(m_indexStreams);
+        for (auto &stream : indexStreams)
+        {
+            stream.dataOffset = offset;
+            offset = _alignCacheOffset(offset + stream.dataSize);
+        }
+        header.fileSize = offset;
+
+        FILE *pFile = fopen(fileName, "wb");
+        if (pFile == nullptr)
+        {
+            FD_LOG(plog::warning) << "Failed to create mesh cache file: " << fileName << std::endl;
+            return FD_FALSE;
+        }
+        uint64_t position = 0u;
+        const uint8_t zeros[FD_MESH_CACHE_ALIGNMENT] = {};
+        Bool32 result = FD_TRUE;
+        auto writeBlock = [&](uint64_t blockOffset, const void *pData, uint64_t size)
+        {
+            if (result == FD_FALSE) return;
+            if (blockOffset > position)
+            {
+                size_t paddingSize = static_cast<size_t>(blockOffset - position);
+                if (fwrite(zeros, 1u, paddingSize, pFile) != paddingSize) result = FD_FALSE;
+                position = blockOffset;
+            }
+            if (size != 0u && fwrite(pData, 1u, static_cast<size_t>(size), pFile) != static_cast<size_t>(size)) result = FD_FALSE;
+            position += size;
+        };
+        writeBlock(0u, &header, sizeof(MeshCacheHeader));
+        writeBlock(header.vertexStreamTableOffset, vertexStreams.data(), sizeof(MeshCacheStream) * vertexStreams.size());
+        writeBlock(header.indexStreamTableOffset, indexStreams.data(), sizeof(MeshCacheStream) * indexStreams.size());
+        writeBlock(header.subMeshTableOffset, m_subMeshes.data(), sizeof(MeshCacheSubMesh) * m_subMeshes.size());
+        writeBlock(header.materialTableOffset, m_materials.data(), sizeof(MeshCacheMaterial) * m_materials.size());
+        for (size_t i = 0; i < vertexStreams.size(); ++i)
+        {
+            writeBlock(vertexStreams[i].dataOffset, m_vertexStreamDatas[i], vertexStreams[i].dataSize);
+        }
+        for (size_t i = 0; i < indexStreams.size(); ++i)
+        {
+            writeBlock(indexStreams[i].dataOffset, m_indexStreamDatas[i], indexStreams[i].dataSize);
+        }
+        writeBlock(header.fileSize, nullptr, 0u);
+        if (fclose(pFile) != 0) result = FD_FALSE;
+        if (result == FD_FALSE)
+        {
+            //Don't leave a broken cache.
+            remove(fileName);
+            FD_LOG(plog::warning) << "Failed to write mesh cache file: " << fileName << std::endl;
+        }
+        return result;
+    }
+
+    MeshCacheFile::MeshCacheFile()
+        : m_pMemory(nullptr)
+        , m_size(0u)
+#ifdef _WIN32
+        , m_fileHandle(INVALID_HANDLE_VALUE)
+        , m_mappingHandle(nullptr)
+#else
+        , m_fileDescriptor(-1)
+#endif //_WIN32
+    {
+
+    }
+
+    MeshCacheFile::~MeshCacheFile()
+    {
+        close();
+    }
+
+    Bool32 MeshCacheFile::open(const char *fileName, uint64_t expectedKey)
+    {
+        close();
+#ifdef _WIN32
+        m_fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE) return FD_FALSE;
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(m_fileHandle, &size) == FALSE || size.QuadPart == 0)
+        {
+            close();
+            return FD_FALSE;
+        }
+        m_size = static_cast<uint64_t>(size.QuadPart);
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr)
+        {
+            close();
+            return FD_FALSE;
+        }
+        m_pMemory = static_cast<const uint8_t *>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+        m_fileDescriptor = ::open(fileName, O_RDONLY);
+        if (m_fileDescriptor < 0) return FD_FALSE;
+        struct stat fileStat;
+        if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close();
+            return FD_FALSE;
+        }
+        m_size = static_cast<uint64_t>(fileStat.st_size);
+        void *pMemory = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+        if (pMemory != MAP_FAILED) m_pMemory = static_cast<const uint8_t *>(pMemory);
+#endif //_WIN32
+        if (m_pMemory == nullptr || _verify(expectedKey) == FD_FALSE)
+        {
+            close();
+            return FD_FALSE;
+        }
+        return FD_TRUE;
+    }
+
+    void MeshCacheFile::close()
+    {
+#ifdef _WIN32
+        if (m_pMemory != nullptr) UnmapViewOfFile(m_pMemory);
+        if (m_mappingHandle != nullptr) CloseHandle(m_mappingHandle);
+        if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+        m_mappingHandle = nullptr;
+        m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (m_pMemory != nullptr) munmap(const_cast<uint8_t *>(m_pMemory), static_cast<size_t>(m_size));
+        if (m_fileDescriptor >= 0) ::close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+#endif //_WIN32
+        m_pMemory = nullptr;
+        m_size = 0u;
+    }
+
+    Bool32 MeshCacheFile::getIsOpen() const
+    {
+        return m_pMemory != nullptr;
+    }
+
+    const MeshCacheHeader &MeshCacheFile::getHeader() const
+    {
+        return *_getHeader();
+    }
+
+    uint32_t MeshCacheFile::getVertexStreamCount() const
+    {
+        return _getHeader()->vertexStreamCount;
+    }
+
+    const MeshCacheStream &MeshCacheFile::getVertexStream(uint32_t index) const
+    {
+#ifdef DEBUG
+        if (index >= getVertexStreamCount())
+            throw std::range_error("The index is out of range of vertex stream count of mesh cache.");
+#endif // DEBUG
+        return reinterpret_cast<const MeshCacheStream *>(m_pMemory + _getHeader()->vertexStreamTableOffset)[index];
+    }
+
+    const void *MeshCacheFile::getVertexStreamData(uint32_t index) const
+    {
+        return m_pMemory + getVertexStream(index).dataOffset;
+    }
+
+    uint32_t MeshCacheFile::getIndexStreamCount() const
+    {
+        return _getHeader()->indexStreamCount;
+    }
+
+    const MeshCacheStream &MeshCacheFile::getIndexStream(uint32_t index) const
+    {
+#ifdef DEBUG
+        if (index >= getIndexStreamCount())
+            throw std::range_error("The index is out of range of index stream count of mesh cache.");
+#endif // DEBUG
+        return reinterpret_cast<const MeshCacheStream *>(m_pMemory + _getHeader()->indexStreamTableOffset)[index];
+    }
+
+    const uint32_t *MeshCacheFile::getIndexStreamData(uint32_t index) const
+    {
+        return reinterpret_cast<const uint32_t *>(m_pMemory + getIndexStream(index).dataOffset);
+    }
+
+    uint32_t MeshCacheFile::getSubMeshCount() const
+    {
+        return _getHeader()->subMeshCount;
+    }
+
+    const MeshCacheSubMesh *MeshCacheFile::getSubMeshes() const
+    {
+        return reinterpret_cast<const MeshCacheSubMesh *>(m_pMemory + _getHeader()->subMeshTableOffset);
+    }
+
+    uint32_t MeshCacheFile::getMaterialCount() const
+    {
+        return _getHeader()->materialCount;
+    }
+
+    const MeshCacheMaterial *MeshCacheFile::getMaterials() const
+    {
+        return reinterpret_cast<const MeshCacheMaterial *>(m_pMemory + _getHeader()->materialTableOffset);
+    }
+
+    const MeshCacheHeader *MeshCacheFile::_getHeader() const
+    {
+#ifdef DEBUG
+        if (m_pMemory == nullptr)
+            throw std::runtime_error("The mesh cache file isn't open.");
+#endif // DEBUG
+        return reinterpret_cast<const MeshCacheHeader *>(m_pMemory);
+    }
+
+    Bool32 MeshCacheFile::_verify(uint64_t expectedKey) const
+    {
+        if (m_size < sizeof(MeshCacheHeader)) return FD_FALSE;
+        const auto &header = *_getHeader();
+        if (header.magic != FD_MESH_CACHE_MAGIC || header.version != FD_MESH_CACHE_VERSION ||
+            header.key != expectedKey || header.fileSize != m_size) return FD_FALSE;
+        auto isRangeValid = [this](uint64_t offset, uint64_t size)
+        {
+            return offset % FD_MESH_CACHE_ALIGNMENT == 0u && offset <= m_size && size <= m_size - offset;
+        };
+        if (! isRangeValid(header.vertexStreamTableOffset, sizeof(MeshCacheStream) * static_cast<uint64_t>(header.vertexStreamCount)) ||
+            ! isRangeValid(header.indexStreamTableOffset, sizeof(MeshCacheStream) * static_cast<uint64_t>(header.indexStreamCount)) ||
+            ! isRangeValid(header.subMeshTableOffset, sizeof(MeshCacheSubMesh) * static_cast<uint64_t>(header.subMeshCount)) ||
+            ! isRangeValid(header.materialTableOffset, sizeof(MeshCacheMaterial) * static_cast<uint64_t>(header.materialCount)))
+            return FD_FALSE;
+        for (uint32_t i = 0; i < header.vertexStreamCount; ++i)
+        {
+            const auto &stream = getVertexStream(i);
+            if (! isRangeValid(stream.dataOffset, stream.dataSize) ||
+                stream.dataSize < static_cast<uint64_t>(stream.stride) * stream.count) return FD_FALSE;
+        }
+        for (uint32_t i = 0; i < header.indexStreamCount; ++i)
+        {
+            const auto &stream = getIndexStream(i);
+            if (stream.stride != sizeof(uint32_t) || ! isRangeValid(stream.dataOffset, stream.dataSize) ||
+                stream.dataSize < static_cast<uint64_t>(stream.stride) * stream.count) return FD_FALSE;
+        }
+        const MeshCacheSubMesh *pSubMeshes = getSubMeshes();
+        for (uint32_t i = 0; i < header.subMeshCount; ++i)
+        {
+            const auto &subMesh = pSubMeshes[i];
+            if (subMesh.vertexStreamIndex >= header.vertexStreamCount ||
+                subMesh.indexStreamIndex >= header.indexStreamCount) return FD_FALSE;
+            const auto &vertexStream = getVertexStream(subMesh.vertexStreamIndex);
+            const auto &indexStream = getIndexStream(subMesh.indexStreamIndex);
+            if (static_cast<uint64_t>(subMesh.vertexOffset) + subMesh.vertexCount > vertexStream.count ||
+                static_cast<uint64_t>(subMesh.indexOffset) + subMesh.indexCount > indexStream.count) return FD_FALSE;
+        }
+        return FD_TRUE;
+    }
+
+    uint64_t hashMeshCacheKey(const void *pData, uint32_t size, uint64_t hash)
+    {
+        return hashBytes(pData, size, hash);
+    }
+
+    uint64_t hashMeshCacheSource(const char *fileName, uint64_t hash)
+    {
+        int64_t fileSize = -1;
+        int64_t modifyTime = -1;
+#ifdef _WIN32
+        struct _stat64 fileStat;
+        if (_stat64(fileName, &fileStat) == 0)
+#else
+        struct stat fileStat;
+        if (stat(fileName, &fileStat) == 0)
+#endif //_WIN32
+        {
+            fileSize = static_cast<int64_t>(fileStat.st_size);
+            modifyTime = static_cast<int64_t>(fileStat.st_mtime);
+        }
+        hash = hashMeshCacheKey(&fileSize, sizeof(fileSize), hash);
+        hash = hashMeshCacheKey(&modifyTime, sizeof(modifyTime), hash);
+        if (fileSize <= 0) return hash;
+
+        FILE *pFile = fopen(fileName, "rb");
+        if (pFile == nullptr) return hash;
+        //Small files are hashed wholly, head, middle and tail are hashed for big files.
+        const int64_t sampleSize = static_cast<int64_t>(FD_MESH_CACHE_SOURCE_SAMPLE_SIZE);
+        int64_t offsets[3] = {0, (fileSize - sampleSize) / 2, fileSize - sampleSize};
+        uint32_t sampleCount = 3u;
+        int64_t readSize = sampleSize;
+        if (fileSize <= sampleSize * 3)
+        {
+            sampleCount = 1u;
+            readSize = fileSize;
+        }
+        std::vector<uint8_t> buffer(static_cast<size_t>(readSize));
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            if (fseek(pFile, static_cast<long>(offsets[i]), SEEK_SET) != 0) break;
+            size_t size = fread(buffer.data(), 1u, buffer.size(), pFile);
+            hash = hashMeshCacheKey(buffer.data(), static_cast<uint32_t>(size), hash);
+        }
+        fclose(pFile);
+        return hash;
+    }
+} //fd
@@ -0,0 +1,142 @@
+#ifndef FD_MESH_CACHE_H
+#define FD_MESH_CACHE_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include "foundation/global.hpp"
+
+#define FD_MESH_CACHE_MAGIC 0x4843454du //"MECH"
+#define FD_MESH_CACHE_VERSION 1u
+#define FD_MESH_CACHE_ALIGNMENT 16u
+#define FD_MESH_CACHE_NAME_SIZE 128u
+//Bytes read from each of head, middle and tail of a source file to hash its content.
+#define FD_MESH_CACHE_SOURCE_SAMPLE_SIZE 65536u
+
+namespace fd
+{
+    /**
+     * Layout of the binary mesh cache file, all tables and data blocks are aligned to FD_MESH_CACHE_ALIGNMENT:
+     * header | vertex stream table | index stream table | sub mesh table | material table | data blocks.
+     * The key is decided by the user to check if the cache matches the source and import settings.
+     */
+    struct MeshCacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint64_t fileSize;
+        uint32_t vertexStreamCount;
+        uint32_t indexStreamCount;
+        uint32_t subMeshCount;
+        uint32_t materialCount;
+        uint64_t vertexStreamTableOffset;
+        uint64_t indexStreamTableOffset;
+        uint64_t subMeshTableOffset;
+        uint64_t materialTableOffset;
+    };
+
+    /*A data block of vertices or indices, stride of index stream is size of index.*/
+    struct MeshCacheStream
+    {
+        uint32_t stride;
+        uint32_t count;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+    };
+
+    struct MeshCacheSubMesh
+    {
+        uint32_t vertexStreamIndex;
+        uint32_t vertexOffset;
+        uint32_t vertexCount;
+        uint32_t indexStreamIndex;
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        uint32_t materialIndex;
+        float boundsMin[3];
+        float boundsMax[3];
+
+        MeshCacheSubMesh();
+    };
+
+    struct MeshCacheMaterial
+    {
+        char name[FD_MESH_CACHE_NAME_SIZE];
+        char diffuseTexture[FD_MESH_CACHE_NAME_SIZE];
+        float diffuseColor[4];
+
+        MeshCacheMaterial();
+        MeshCacheMaterial(const std::string &name
+            , const std::string &diffuseTexture = std::string()
+            , const float *pDiffuseColor = nullptr
+            );
+    };
+
+    /*Collect streams, sub meshes and materials, then write them to a cache file. Data of streams isn't copied,
+      it should be alive until the cache is written.*/
+    class MeshCacheWriter
+    {
+    public:
+        MeshCacheWriter();
+        uint32_t addVertexStream(const void *pData, uint32_t stride, uint32_t vertexCount);
+        uint32_t addIndexStream(const uint32_t *pIndices, uint32_t indexCount);
+        void addSubMesh(const MeshCacheSubMesh &subMesh);
+        void addMaterial(const MeshCacheMaterial &material);
+        Bool32 write(const char *fileName, uint64_t key) const;
+    private:
+        std::vector<MeshCacheStream> m_vertexStreams;
+        std::vector<const void *> m_vertexStreamDatas;
+        std::vector<MeshCacheStream> m_indexStreams;
+        std::vector<const void *> m_indexStreamDatas;
+        std::vector<MeshCacheSubMesh> m_subMeshes;
+        std::vector<MeshCacheMaterial> m_materials;
+    };
+
+    /*Memory-mapped cache file, pointers got from it are in the mapped memory and valid until it is closed.*/
+    class MeshCacheFile
+    {
+    public:
+        MeshCacheFile();
+        ~MeshCacheFile();
+        MeshCacheFile(const MeshCacheFile &) = delete;
+        MeshCacheFile &operator=(const MeshCacheFile &) = delete;
+
+        /*Map the file and check its header, it fails when the file doesn't exist, it is broken,
+          its version is different or its key isn't the expected key.*/
+        Bool32 open(const char *fileName, uint64_t expectedKey);
+        void close();
+        Bool32 getIsOpen() const;
+
+        const MeshCacheHeader &getHeader() const;
+        uint32_t getVertexStreamCount() const;
+        const MeshCacheStream &getVertexStream(uint32_t index) const;
+        const void *getVertexStreamData(uint32_t index) const;
+        uint32_t getIndexStreamCount() const;
+        const MeshCacheStream &getIndexStream(uint32_t index) const;
+        const uint32_t *getIndexStreamData(uint32_t index) const;
+        uint32_t getSubMeshCount() const;
+        const MeshCacheSubMesh *getSubMeshes() const;
+        uint32_t getMaterialCount() const;
+        const MeshCacheMaterial *getMaterials() const;
+    private:
+        const uint8_t *m_pMemory;
+        uint64_t m_size;
+#ifdef _WIN32
+        void *m_fileHandle;
+        void *m_mappingHandle;
+#else
+        int m_fileDescriptor;
+#endif //_WIN32
+        const MeshCacheHeader *_getHeader() const;
+        Bool32 _verify(uint64_t expectedKey) const;
+    };
+
+    /*FNV-1a hash to make cache key from import settings, it is same as hashBytes.*/
+    extern uint64_t hashMeshCacheKey(const void *pData, uint32_t size, uint64_t hash = 14695981039346656037ull);
+    /*Hash size, modification time and sampled content of a source file into the key, so the cache is
+      invalid when the source is changed without reading whole source. Missing file is hashed as size -1.*/
+    extern uint64_t hashMeshCacheSource(const char *fileName, uint64_t hash = 14695981039346656037ull);
+} //fd
+
+#endif //FD_MESH_CACHE_H
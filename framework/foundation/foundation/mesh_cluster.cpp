@@ -0,0 +1,255 @@
+#include "foundation/mesh_cluster.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace fd
+{
+    MeshCluster::MeshCluster()
+        : indexOffset(0u)
+        , indexCount(0u)
+        , vertexCount(0u)
+        , center{0.0f, 0.0f, 0.0f}
+        , radius(0.0f)
+        , coneAxis{0.0f, 0.0f, 0.0f}
+        , coneCutoff(1.0f)
+    {
+
+    }
+
+    inline static float _getSqrDistance(const float *a, const float *b)
+    {
+        float x = a[0] - b[0];
+        float y = a[1] - b[1];
+        float z = a[2] - b[2];
+        return x * x + y * y + z * z;
+    }
+
+    //Bounding sphere with Ritter's algorithm and normal cone of the triangles.
+    static void _computeClusterBounds(MeshCluster &cluster
+        , const uint32_t *pIndices
+        , const float *pPositions
+        , uint32_t positionStride
+        )
+    {
+        auto getPosition = [pPositions, positionStride](uint32_t vertex)
+        {
+            return reinterpret_cast<const float *>(reinterpret_cast<const char *>(pPositions) + vertex * positionStride);
+        };
+        const uint32_t *pClusterIndices = pIndices + cluster.indexOffset;
+        uint32_t indexCount = cluster.indexCount;
+
+        //Start with the most distant point pair of the points which are extreme on axises.
+        const float *pExtremes[3][2];
+        for (uint32_t axis = 0; axis < 3u; ++axis)
+        {
+            pExtremes[axis][0] = getPosition(pClusterIndices[0]);
+            pExtremes[axis][1] = pExtremes[axis][0];
+        }
+        for (uint32_t i = 1; i < indexCount; ++i)
+        {
+            const float *p = getPosition(pClusterIndices[i]);
+            for (uint32_t axis = 0; axis < 3u; ++axis)
+            {
+                if (p[axis] < pExtremes[axis][0][axis]) pExtremes[axis][0] = p;
+                if (p[axis] > pExtremes[axis][1][axis]) pExtremes[axis][1] = p;
+            }
+        }
+        uint32_t maxAxis = 0u;
+        float maxSqrDistance = -1.0f;
+        for (uint32_t axis = 0; axis < 3u; ++axis)
+        {
+            float sqrDistance = _getSqrDistance(pExtremes[axis][0], pExtremes[axis][1]);
+            if (sqrDistance > maxSqrDistance)
+            {
+                maxSqrDistance = sqrDistance;
+                maxAxis = axis;
+            }
+        }
+        float *center = cluster.center;
+        for (uint32_t j = 0; j < 3u; ++j)
+        {
+            center[j] = (pExtremes[maxAxis][0][j] + pExtremes[maxAxis][1][j]) * 0.5f;
+        }
+        float radius = std::sqrt(maxSqrDistance) * 0.5f;
+        //Grow sphere to contain all points.
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            const float *p = getPosition(pClusterIndices[i]);
+            float sqrDistance = _getSqrDistance(p, center);
+            if (sqrDistance > radius * radius)
+            {
+                float distance = std::sqrt(sqrDistance);
+                float newRadius = (radius + distance) * 0.5f;
+                float k = (newRadius - radius) / distance;
+                for (uint32_t j = 0; j < 3u; ++j)
+                {
+                    center[j] += (p[j] - center[j]) * k;
+                }
+                radius = newRadius;
+            }
+        }
+        cluster.radius = radius;
+
+        //Normal cone.
+        uint32_t triangleCount = indexCount / 3u;
+        std::vector<float> normals(triangleCount * 3u, 0.0f);
+        float axis[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < triangleCount; ++i)
+        {
+            const float *p0 = getPosition(pClusterIndices[i * 3u]);
+            const float *p1 = getPosition(pClusterIndices[i * 3u + 1u]);
+            const float *p2 = getPosition(pClusterIndices[i * 3u + 2u]);
+            float e0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float *n = normals.data() + i * 3u;
+            n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+            n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+            n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0f) continue;
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                n[j] /= length;
+                axis[j] += n[j];
+            }
+        }
+        float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        cluster.coneCutoff = 1.0f;
+        if (axisLength == 0.0f) return;
+        for (uint32_t j = 0; j < 3u; ++j)
+        {
+            cluster.coneAxis[j] = axis[j] / axisLength;
+        }
+        float minDot = 1.0f;
+        for (uint32_t i = 0; i < triangleCount; ++i)
+        {
+            const float *n = normals.data() + i * 3u;
+            if (n[0] == 0.0f && n[1] == 0.0f && n[2] == 0.0f) continue;
+            minDot = std::min(minDot, n[0] * cluster.coneAxis[0] + n[1] * cluster.coneAxis[1] + n[2] * cluster.coneAxis[2]);
+        }
+        //The spread is more than 90 degrees, some triangles always face to the viewer.
+        if (minDot <= 0.0f) return;
+        cluster.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    uint32_t buildMeshClusters(std::vector<MeshCluster> &clusters
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t vertexCount
+        , uint32_t positionStride
+        , uint32_t maxVertexCount
+        , uint32_t maxTriangleCount
+        )
+    {
+        clusters.clear();
+        uint32_t triangleCount = indexCount / 3u;
+        if (triangleCount == 0u) return 0u;
+        maxVertexCount = std::max(maxVertexCount, 3u);
+        maxTriangleCount = std::max(maxTriangleCount, 1u);
+
+        //Stamp of the last cluster using the vertex, it is used to count unique vertices of the current cluster.
+        std::vector<uint32_t> vertexStamps(vertexCount, 0u);
+        uint32_t stamp = 1u;
+        MeshCluster cluster;
+        for (uint32_t i = 0; i < triangleCount; ++i)
+        {
+            const uint32_t *pTriangle = pIndices + i * 3u;
+            uint32_t newVertexCount = 0u;
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                if (vertexStamps[pTriangle[j]] != stamp &&
+                    (j == 0u || pTriangle[j] != pTriangle[0]) &&
+                    (j != 2u || pTriangle[j] != pTriangle[1])) ++newVertexCount;
+            }
+            if (cluster.indexCount != 0u &&
+                (cluster.vertexCount + newVertexCount > maxVertexCount || cluster.indexCount / 3u + 1u > maxTriangleCount))
+            {
+                _computeClusterBounds(cluster, pIndices, pPositions, positionStride);
+                clusters.push_back(cluster);
+                cluster = MeshCluster();
+                cluster.indexOffset = i * 3u;
+                ++stamp;
+                newVertexCount = 0u;
+                for (uint32_t j = 0; j < 3u; ++j)
+                {
+                    if (vertexStamps[pTriangle[j]] != stamp)
+                    {
+                        vertexStamps[pTriangle[j]] = stamp;
+                        ++newVertexCount;
+                    }
+                }
+            }
+            else
+            {
+                for (uint32_t j = 0; j < 3u; ++j)
+                {
+                    vertexStamps[pTriangle[j]] = stamp;
+                }
+            }
+            cluster.vertexCount += newVertexCount;
+            cluster.indexCount += 3u;
+        }
+        _computeClusterBounds(cluster, pIndices, pPositions, positionStride);
+        clusters.push_back(cluster);
+        return static_cast<uint32_t>(clusters.size());
+    }
+
+    void getFrustumPlanes(const float *pClipMatrix, float *pPlanes)
+    {
+        //Row i of the column major matrix.
+        auto getRow = [pClipMatrix](uint32_t row, float *pRow)
+        {
+            for (uint32_t column = 0; column < 4u; ++column)
+            {
+                pRow[column] = pClipMatrix[column * 4u + row];
+            }
+        };
+        float rows[4][4];
+        for (uint32_t i = 0; i < 4u; ++i) getRow(i, rows[i]);
+        for (uint32_t j = 0; j < 4u; ++j)
+        {
+            pPlanes[j] = rows[3][j] + rows[0][j];        //left
+            pPlanes[4u + j] = rows[3][j] - rows[0][j];   //right
+            pPlanes[8u + j] = rows[3][j] + rows[1][j];   //bottom
+            pPlanes[12u + j] = rows[3][j] - rows[1][j];  //top
+            pPlanes[16u + j] = rows[2][j];               //near, depth is in range [0, 1]
+            pPlanes[20u + j] = rows[3][j] - rows[2][j];  //far
+        }
+        for (uint32_t i = 0; i < 6u; ++i)
+        {
+            float *pPlane = pPlanes + i * 4u;
+            float length = std::sqrt(pPlane[0] * pPlane[0] + pPlane[1] * pPlane[1] + pPlane[2] * pPlane[2]);
+            if (length == 0.0f) continue;
+            for (uint32_t j = 0; j < 4u; ++j)
+            {
+                pPlane[j] /= length;
+            }
+        }
+    }
+
+    Bool32 isClusterOutsideFrustum(const MeshCluster &cluster, const float *pPlanes)
+    {
+        const float *center = cluster.center;
+        for (uint32_t i = 0; i < 6u; ++i)
+        {
+            const float *pPlane = pPlanes + i * 4u;
+            float distance = pPlane[0] * center[0] + pPlane[1] * center[1] + pPlane[2] * center[2] + pPlane[3];
+            if (distance < - cluster.radius) return FD_TRUE;
+        }
+        return FD_FALSE;
+    }
+
+    Bool32 isClusterBackfacing(const MeshCluster &cluster, const float *pViewerPosition)
+    {
+        float direction[3] = {
+            cluster.center[0] - pViewerPosition[0],
+            cluster.center[1] - pViewerPosition[1],
+            cluster.center[2] - pViewerPosition[2],
+        };
+        float distance = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+        float dot = direction[0] * cluster.coneAxis[0] + direction[1] * cluster.coneAxis[1] + direction[2] * cluster.coneAxis[2];
+        return dot >= cluster.coneCutoff * distance + cluster.radius ? FD_TRUE : FD_FALSE;
+    }
+} //fd
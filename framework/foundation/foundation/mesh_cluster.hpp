@@ -0,0 +1,54 @@
+#ifndef FD_MESH_CLUSTER_H
+#define FD_MESH_CLUSTER_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+#define FD_MESH_CLUSTER_DEFAULT_MAX_VERTEX_COUNT 64u
+#define FD_MESH_CLUSTER_DEFAULT_MAX_TRIANGLE_COUNT 124u
+
+namespace fd
+{
+    /*A range of triangles of the index list with its bounding sphere and normal cone.
+      coneCutoff is sine of the spread angle of triangle normals, it is 1.0 when the cone can't be used for culling.*/
+    struct MeshCluster
+    {
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        uint32_t vertexCount;
+        float center[3];
+        float radius;
+        float coneAxis[3];
+        float coneCutoff;
+
+        MeshCluster();
+    };
+
+    /*Split the triangle list to clusters in order, a new cluster begins when the current one would have more than
+      maxVertexCount unique vertices or maxTriangleCount triangles. The index list isn't changed, so it should be
+      optimized for vertex cache first to get compact clusters.
+      pPositions is array of 3 floats with positionStride bytes between vertices. Return the cluster count.*/
+    extern uint32_t buildMeshClusters(std::vector<MeshCluster> &clusters
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t vertexCount
+        , uint32_t positionStride
+        , uint32_t maxVertexCount = FD_MESH_CLUSTER_DEFAULT_MAX_VERTEX_COUNT
+        , uint32_t maxTriangleCount = FD_MESH_CLUSTER_DEFAULT_MAX_TRIANGLE_COUNT
+        );
+
+    /*Get 6 planes (a, b, c, d) of the frustum from the column major clip matrix with depth range [0, 1],
+      the planes are in the space before the matrix transform, pPlanes should have 24 floats.*/
+    extern void getFrustumPlanes(const float *pClipMatrix, float *pPlanes);
+
+    /*The bounding sphere of the cluster is outside of one of the frustum planes.*/
+    extern Bool32 isClusterOutsideFrustum(const MeshCluster &cluster, const float *pPlanes);
+
+    /*All triangles of the cluster face away from the viewer. Normal of a triangle is cross(p1 - p0, p2 - p0),
+      the viewer position should be in the same space as the cluster.*/
+    extern Bool32 isClusterBackfacing(const MeshCluster &cluster, const float *pViewerPosition);
+} //fd
+
+#endif //FD_MESH_CLUSTER_H
@@ -0,0 +1,416 @@
+#include "foundation/mesh_optimizer.hpp"
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+
+namespace fd
+{
+    VertexCacheStatistics::VertexCacheStatistics()
+        : vertexTransformCount(0u)
+        , triangleCount(0u)
+        , vertexCount(0u)
+        , acmr(0.0f)
+        , atvr(0.0f)
+    {
+
+    }
+
+    VertexStream::VertexStream(const void *pData
+        , uint32_t size
+        , uint32_t stride
+        )
+        : pData(pData)
+        , size(size)
+        , stride(stride)
+    {
+
+    }
+
+    VertexCacheStatistics analyzeVertexCache(const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , uint32_t cacheSize
+        )
+    {
+        VertexCacheStatistics result;
+        //Time stamp of vertex when it entered the cache, a vertex is in the FIFO cache
+        //if less than cacheSize vertices have entered after it.
+        std::vector<uint32_t> cacheTimeStamps(vertexCount, 0u);
+        std::vector<uint8_t> useds(vertexCount, 0u);
+        uint32_t timeStamp = cacheSize + 1u;
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t index = *(pIndices + i);
+            if (timeStamp - cacheTimeStamps[index] > cacheSize)
+            {
+                cacheTimeStamps[index] = timeStamp;
+                ++timeStamp;
+                ++result.vertexTransformCount;
+            }
+            if (useds[index] == 0u)
+            {
+                useds[index] = 1u;
+                ++result.vertexCount;
+            }
+        }
+        result.triangleCount = indexCount / 3u;
+        result.acmr = result.triangleCount != 0u ? static_cast<float>(result.vertexTransformCount) / static_cast<float>(result.triangleCount) : 0.0f;
+        result.atvr = result.vertexCount != 0u ? static_cast<float>(result.vertexTransformCount) / static_cast<float>(result.vertexCount) : 0.0f;
+        return result;
+    }
+
+    void optimizeVertexCache(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , uint32_t cacheSize
+        , std::vector<uint32_t> *pClusterOffsets
+        )
+    {
+        uint32_t triangleCount = indexCount / 3u;
+        if (pClusterOffsets != nullptr) pClusterOffsets->clear();
+
+        //Build vertex-triangle adjacency.
+        std::vector<uint32_t> liveTriangleCounts(vertexCount, 0u);
+        for (uint32_t i = 0; i < triangleCount * 3u; ++i)
+        {
+            ++liveTriangleCounts[*(pIndices + i)];
+        }
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1u, 0u);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            adjacencyOffsets[i + 1u] = adjacencyOffsets[i] + liveTriangleCounts[i];
+        }
+        std::vector<uint32_t> adjacencies(triangleCount * 3u);
+        {
+            std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (uint32_t t = 0; t < triangleCount; ++t)
+            {
+                for (uint32_t k = 0; k < 3u; ++k)
+                {
+                    uint32_t vertex = *(pIndices + t * 3u + k);
+                    adjacencies[fillOffsets[vertex]++] = t;
+                }
+            }
+        }
+
+        std::vector<uint32_t> cacheTimeStamps(vertexCount, 0u);
+        std::vector<uint8_t> emitteds(triangleCount, 0u);
+        std::vector<uint32_t> deadEndStack;
+        std::vector<uint32_t> candidates;
+        deadEndStack.reserve(triangleCount * 3u);
+        uint32_t timeStamp = cacheSize + 1u;
+        uint32_t cursor = 0u;
+        uint32_t outputOffset = 0u;
+
+        uint32_t fanningVertex = FD_MESH_OPTIMIZER_INVALID_INDEX;
+        for (; cursor < vertexCount; ++cursor)
+        {
+            if (liveTriangleCounts[cursor] > 0u)
+            {
+                fanningVertex = cursor;
+                break;
+            }
+        }
+        if (fanningVertex != FD_MESH_OPTIMIZER_INVALID_INDEX && pClusterOffsets != nullptr)
+        {
+            pClusterOffsets->push_back(0u);
+        }
+
+        while (fanningVertex != FD_MESH_OPTIMIZER_INVALID_INDEX)
+        {
+            //Emit all remaining triangles around the fanning vertex.
+            candidates.clear();
+            for (uint32_t a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1u]; ++a)
+            {
+                uint32_t t = adjacencies[a];
+                if (emitteds[t] != 0u) continue;
+                for (uint32_t k = 0; k < 3u; ++k)
+                {
+                    uint32_t vertex = *(pIndices + t * 3u + k);
+                    *(pDstIndices + outputOffset) = vertex;
+                    ++outputOffset;
+                    deadEndStack.push_back(vertex);
+                    candidates.push_back(vertex);
+                    --liveTriangleCounts[vertex];
+                    if (timeStamp - cacheTimeStamps[vertex] > cacheSize)
+                    {
+                        cacheTimeStamps[vertex] = timeStamp;
+                        ++timeStamp;
+                    }
+                }
+                emitteds[t] = 1u;
+            }
+
+            //Select next fanning vertex which will still be in cache after its triangles are emitted.
+            uint32_t nextVertex = FD_MESH_OPTIMIZER_INVALID_INDEX;
+            int32_t maxPriority = -1;
+            for (const auto &candidate : candidates)
+            {
+                if (liveTriangleCounts[candidate] == 0u) continue;
+                int32_t priority = 0;
+                if (timeStamp - cacheTimeStamps[candidate] + 2u * liveTriangleCounts[candidate] <= cacheSize)
+                {
+                    priority = static_cast<int32_t>(timeStamp - cacheTimeStamps[candidate]);
+                }
+                if (priority > maxPriority)
+                {
+                    maxPriority = priority;
+                    nextVertex = candidate;
+                }
+            }
+
+            if (nextVertex == FD_MESH_OPTIMIZER_INVALID_INDEX)
+            {
+                //Dead end, get back to recent vertices, otherwise take next vertex in input order.
+                while (deadEndStack.size() != 0u)
+                {
+                    uint32_t vertex = deadEndStack.back();
+                    deadEndStack.pop_back();
+                    if (liveTriangleCounts[vertex] > 0u)
+                    {
+                        nextVertex = vertex;
+                        break;
+                    }
+                }
+                if (nextVertex == FD_MESH_OPTIMIZER_INVALID_INDEX)
+                {
+                    for (; cursor < vertexCount; ++cursor)
+                    {
+                        if (liveTriangleCounts[cursor] > 0u)
+                        {
+                            nextVertex = cursor;
+                            break;
+                        }
+                    }
+                }
+                if (nextVertex != FD_MESH_OPTIMIZER_INVALID_INDEX && pClusterOffsets != nullptr)
+                {
+                    pClusterOffsets->push_back(outputOffset);
+                }
+            }
+
+            fanningVertex = nextVertex;
+        }
+
+        //Tail indices which can't make up a triangle are kept.
+        for (uint32_t i = triangleCount * 3u; i < indexCount; ++i)
+        {
+            *(pDstIndices + i) = *(pIndices + i);
+        }
+    }
+
+    void optimizeOverdraw(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t positionStride
+        , const std::vector<uint32_t> &clusterOffsets
+        )
+    {
+        uint32_t triangleIndexCount = indexCount / 3u * 3u;
+        uint32_t clusterCount = static_cast<uint32_t>(clusterOffsets.size());
+        if (clusterCount <= 1u)
+        {
+            memcpy(pDstIndices, pIndices, indexCount * sizeof(uint32_t));
+            return;
+        }
+
+        auto getPosition = [pPositions, positionStride](uint32_t vertex) -> const float *
+        {
+            return reinterpret_cast<const float *>(reinterpret_cast<const char *>(pPositions) + vertex * positionStride);
+        };
+
+        //Area weighted centroid and normal of every cluster and of the whole mesh.
+        std::vector<float> clusterDatas(clusterCount * 6u, 0.0f);
+        std::vector<float> clusterAreas(clusterCount, 0.0f);
+        float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+        float meshArea = 0.0f;
+        for (uint32_t c = 0; c < clusterCount; ++c)
+        {
+            uint32_t begin = clusterOffsets[c];
+            uint32_t end = c + 1u < clusterCount ? clusterOffsets[c + 1u] : triangleIndexCount;
+            float *pCentroid = clusterDatas.data() + c * 6u;
+            float *pNormal = pCentroid + 3u;
+            for (uint32_t i = begin; i + 2u < end; i += 3u)
+            {
+                const float *p0 = getPosition(*(pIndices + i));
+                const float *p1 = getPosition(*(pIndices + i + 1u));
+                const float *p2 = getPosition(*(pIndices + i + 2u));
+                float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+                float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (uint32_t k = 0; k < 3u; ++k)
+                {
+                    float center = (p0[k] + p1[k] + p2[k]) / 3.0f;
+                    pCentroid[k] += center * area;
+                    meshCentroid[k] += center * area;
+                    pNormal[k] += n[k];
+                }
+                clusterAreas[c] += area;
+                meshArea += area;
+            }
+            if (clusterAreas[c] > 0.0f)
+            {
+                for (uint32_t k = 0; k < 3u; ++k) pCentroid[k] /= clusterAreas[c];
+            }
+        }
+        if (meshArea > 0.0f)
+        {
+            for (uint32_t k = 0; k < 3u; ++k) meshCentroid[k] /= meshArea;
+        }
+
+        std::vector<float> sortKeys(clusterCount);
+        std::vector<uint32_t> clusterOrders(clusterCount);
+        for (uint32_t c = 0; c < clusterCount; ++c)
+        {
+            const float *pCentroid = clusterDatas.data() + c * 6u;
+            const float *pNormal = pCentroid + 3u;
+            float length = std::sqrt(pNormal[0] * pNormal[0] + pNormal[1] * pNormal[1] + pNormal[2] * pNormal[2]);
+            float dot = 0.0f;
+            for (uint32_t k = 0; k < 3u; ++k) dot += (pCentroid[k] - meshCentroid[k]) * pNormal[k];
+            sortKeys[c] = length > 0.0f ? dot / length : 0.0f;
+            clusterOrders[c] = c;
+        }
+        std::stable_sort(clusterOrders.begin(), clusterOrders.end(), [&sortKeys](uint32_t lhs, uint32_t rhs)
+        {
+            return sortKeys[lhs] > sortKeys[rhs];
+        });
+
+        uint32_t outputOffset = 0u;
+        for (const auto &c : clusterOrders)
+        {
+            uint32_t begin = clusterOffsets[c];
+            uint32_t end = c + 1u < clusterCount ? clusterOffsets[c + 1u] : triangleIndexCount;
+            memcpy(pDstIndices + outputOffset, pIndices + begin, (end - begin) * sizeof(uint32_t));
+            outputOffset += end - begin;
+        }
+        for (uint32_t i = triangleIndexCount; i < indexCount; ++i)
+        {
+            *(pDstIndices + i) = *(pIndices + i);
+        }
+    }
+
+    uint32_t generateVertexFetchRemap(uint32_t *pRemap
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        )
+    {
+        std::fill(pRemap, pRemap + vertexCount, FD_MESH_OPTIMIZER_INVALID_INDEX);
+        uint32_t nextVertex = 0u;
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t index = *(pIndices + i);
+            if (*(pRemap + index) == FD_MESH_OPTIMIZER_INVALID_INDEX)
+            {
+                *(pRemap + index) = nextVertex;
+                ++nextVertex;
+            }
+        }
+        return nextVertex;
+    }
+
+    struct _VertexHasher
+    {
+        const VertexStream *pStreams;
+        uint32_t streamCount;
+
+        size_t operator()(uint32_t vertex) const
+        {
+            //FNV-1a
+            uint32_t hash = 2166136261u;
+            for (uint32_t s = 0; s < streamCount; ++s)
+            {
+                const auto &stream = *(pStreams + s);
+                const unsigned char *pData = static_cast<const unsigned char *>(stream.pData) + vertex * stream.stride;
+                for (uint32_t i = 0; i < stream.size; ++i)
+                {
+                    hash ^= *(pData + i);
+                    hash *= 16777619u;
+                }
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct _VertexEqual
+    {
+        const VertexStream *pStreams;
+        uint32_t streamCount;
+
+        bool operator()(uint32_t lhs, uint32_t rhs) const
+        {
+            for (uint32_t s = 0; s < streamCount; ++s)
+            {
+                const auto &stream = *(pStreams + s);
+                const unsigned char *pData = static_cast<const unsigned char *>(stream.pData);
+                if (memcmp(pData + lhs * stream.stride, pData + rhs * stream.stride, stream.size) != 0) return false;
+            }
+            return true;
+        }
+    };
+
+    uint32_t generateVertexDeduplicateRemap(uint32_t *pRemap
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , const VertexStream *pStreams
+        , uint32_t streamCount
+        )
+    {
+        std::fill(pRemap, pRemap + vertexCount, FD_MESH_OPTIMIZER_INVALID_INDEX);
+        _VertexHasher hasher = {pStreams, streamCount};
+        _VertexEqual equal = {pStreams, streamCount};
+        std::unordered_map<uint32_t, uint32_t, _VertexHasher, _VertexEqual> mapUniqueVertices(vertexCount, hasher, equal);
+        uint32_t nextVertex = 0u;
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t index = *(pIndices + i);
+            if (*(pRemap + index) != FD_MESH_OPTIMIZER_INVALID_INDEX) continue;
+            auto result = mapUniqueVertices.insert(std::make_pair(index, nextVertex));
+            if (result.second)
+            {
+                *(pRemap + index) = nextVertex;
+                ++nextVertex;
+            }
+            else
+            {
+                *(pRemap + index) = result.first->second;
+            }
+        }
+        return nextVertex;
+    }
+
+    void remapIndices(uint32_t *pDst
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const uint32_t *pRemap
+        )
+    {
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            *(pDst + i) = *(pRemap + *(pIndices + i));
+        }
+    }
+
+    void remapVertices(void *pDst
+        , const void *pVertices
+        , uint32_t vertexCount
+        , uint32_t vertexSize
+        , const uint32_t *pRemap
+        )
+    {
+        char *pDstBytes = static_cast<char *>(pDst);
+        const char *pSrcBytes = static_cast<const char *>(pVertices);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            uint32_t target = *(pRemap + i);
+            if (target == FD_MESH_OPTIMIZER_INVALID_INDEX) continue;
+            memcpy(pDstBytes + target * vertexSize, pSrcBytes + i * vertexSize, vertexSize);
+        }
+    }
+} //fd
@@ -0,0 +1,105 @@
+#ifndef FD_MESH_OPTIMIZER_H
+#define FD_MESH_OPTIMIZER_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+#define FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE 16u
+#define FD_MESH_OPTIMIZER_INVALID_INDEX 0xffffffffu
+
+namespace fd
+{
+    /*Statistics of a simulated FIFO post-transform vertex cache.
+      acmr: average cache miss ratio, transformed vertices per triangle, 0.5 is best and 3.0 is worst.
+      atvr: average transformed vertex ratio, transformed vertices per used vertex, 1.0 is best.*/
+    struct VertexCacheStatistics
+    {
+        uint32_t vertexTransformCount;
+        uint32_t triangleCount;
+        uint32_t vertexCount;
+        float acmr;
+        float atvr;
+
+        VertexCacheStatistics();
+    };
+
+    /*One vertex attribute stream, the data of vertex i is at pData + i * stride and its size is size.*/
+    struct VertexStream
+    {
+        const void *pData;
+        uint32_t size;
+        uint32_t stride;
+
+        VertexStream(const void *pData = nullptr
+            , uint32_t size = 0u
+            , uint32_t stride = 0u
+            );
+    };
+
+    /*Simulate a FIFO vertex cache with the triangle list to get ACMR and ATVR.*/
+    extern VertexCacheStatistics analyzeVertexCache(const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , uint32_t cacheSize = FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE
+        );
+
+    /*Reorder the triangle list for post-transform vertex cache with Tipsify (Sander et al. 2007).
+      pDstIndices can't be same as pIndices.
+      If pClusterOffsets isn't null, the triangle offset (in indices) of every cluster is output to it,
+      a cluster begins where the algorithm can't continue in cache and has to jump.*/
+    extern void optimizeVertexCache(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , uint32_t cacheSize = FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE
+        , std::vector<uint32_t> *pClusterOffsets = nullptr
+        );
+
+    /*Reorder the clusters of a vertex cache optimized triangle list to reduce overdraw.
+      Clusters which face outward from the centroid of the mesh are drawn first, it is the view independent
+      sorting of Sander et al. 2007, so the vertex cache efficiency inside every cluster is kept.
+      pPositions is array of 3 floats with positionStride bytes between vertices. pDstIndices can't be same as pIndices.*/
+    extern void optimizeOverdraw(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t positionStride
+        , const std::vector<uint32_t> &clusterOffsets
+        );
+
+    /*Generate remap table which orders vertices by their first use in the index list, it improves vertex fetch locality.
+      Unused vertices are mapped to FD_MESH_OPTIMIZER_INVALID_INDEX. Return the vertex count after remapping.*/
+    extern uint32_t generateVertexFetchRemap(uint32_t *pRemap
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        );
+
+    /*Generate remap table which merges vertices whose data of all streams is same. The vertices are also ordered
+      by their first use, so it includes result of generateVertexFetchRemap. Return the unique vertex count.*/
+    extern uint32_t generateVertexDeduplicateRemap(uint32_t *pRemap
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , uint32_t vertexCount
+        , const VertexStream *pStreams
+        , uint32_t streamCount
+        );
+
+    /*pDst can be same as pIndices.*/
+    extern void remapIndices(uint32_t *pDst
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const uint32_t *pRemap
+        );
+
+    /*Move vertex i to remap[i], pDst can't be same as pVertices.*/
+    extern void remapVertices(void *pDst
+        , const void *pVertices
+        , uint32_t vertexCount
+        , uint32_t vertexSize
+        , const uint32_t *pRemap
+        );
+} //fd
+
+#endif //FD_MESH_OPTIMIZER_H
@@ -0,0 +1,358 @@
+#include "foundation/mesh_simplifier.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include "foundation/mesh_optimizer.hpp"
+
+#define FD_MESH_SIMPLIFIER_BORDER_WEIGHT 10.0
+
+namespace fd
+{
+    //Symmetric quadric, error of point p is p * A * p + 2 * b * p + c.
+    struct _Quadric
+    {
+        double a00, a11, a22, a01, a02, a12;
+        double b0, b1, b2;
+        double c;
+        double weight;
+
+        _Quadric()
+            : a00(0.0), a11(0.0), a22(0.0), a01(0.0), a02(0.0), a12(0.0)
+            , b0(0.0), b1(0.0), b2(0.0)
+            , c(0.0)
+            , weight(0.0)
+        {
+
+        }
+
+        //The plane is nx * x + ny * y + nz * z + d = 0 with normalized normal.
+        void addPlane(double nx, double ny, double nz, double d, double w)
+        {
+            a00 += w * nx * nx;
+            a11 += w * ny * ny;
+            a22 += w * nz * nz;
+            a01 += w * nx * ny;
+            a02 += w * nx * nz;
+            a12 += w * ny * nz;
+            b0 += w * nx * d;
+            b1 += w * ny * d;
+            b2 += w * nz * d;
+            c += w * d * d;
+            weight += w;
+        }
+
+        void add(const _Quadric &target)
+        {
+            a00 += target.a00;
+            a11 += target.a11;
+            a22 += target.a22;
+            a01 += target.a01;
+            a02 += target.a02;
+            a12 += target.a12;
+            b0 += target.b0;
+            b1 += target.b1;
+            b2 += target.b2;
+            c += target.c;
+            weight += target.weight;
+        }
+
+        //Return weighted average of squared distance between the point and planes.
+        double getError(const float *pPoint) const
+        {
+            double x = pPoint[0];
+            double y = pPoint[1];
+            double z = pPoint[2];
+            double error = a00 * x * x + a11 * y * y + a22 * z * z
+                + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                + 2.0 * (b0 * x + b1 * y + b2 * z)
+                + c;
+            return weight > 0.0 ? std::fabs(error) / weight : 0.0;
+        }
+    };
+
+    enum class _VertexKind
+    {
+        MANIFOLD,
+        BORDER,
+        LOCKED,
+    };
+
+    struct _Collapse
+    {
+        uint32_t srcVertex;
+        uint32_t dstVertex;
+        double error;
+    };
+
+    inline static uint64_t _getEdgeKey(uint32_t a, uint32_t b)
+    {
+        return (static_cast<uint64_t>(a) << 32u) | static_cast<uint64_t>(b);
+    }
+
+    inline static void _getNormal(const float *p0, const float *p1, const float *p2, double *pNormal)
+    {
+        double e0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        double e1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        pNormal[0] = e0[1] * e1[2] - e0[2] * e1[1];
+        pNormal[1] = e0[2] * e1[0] - e0[0] * e1[2];
+        pNormal[2] = e0[0] * e1[1] - e0[1] * e1[0];
+    }
+
+    //Count directed edges with positions instead of vertices, so seams don't look like borders.
+    static void _buildEdgeCounts(const std::vector<uint32_t> &indices
+        , const std::vector<uint32_t> &positionRemap
+        , std::unordered_map<uint64_t, uint32_t> &edgeCounts
+        )
+    {
+        edgeCounts.clear();
+        uint32_t indexCount = static_cast<uint32_t>(indices.size());
+        for (uint32_t i = 0; i < indexCount; i += 3u)
+        {
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                uint32_t a = positionRemap[indices[i + j]];
+                uint32_t b = positionRemap[indices[i + (j + 1u) % 3u]];
+                ++edgeCounts[_getEdgeKey(a, b)];
+            }
+        }
+    }
+
+    uint32_t simplifyMesh(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t vertexCount
+        , uint32_t positionStride
+        , uint32_t targetIndexCount
+        , float targetError
+        , float *pResultError
+        )
+    {
+        uint32_t triangleCount = indexCount / 3u;
+        std::vector<uint32_t> indices(pIndices, pIndices + triangleCount * 3u);
+        auto getPosition = [pPositions, positionStride](uint32_t vertex)
+        {
+            return reinterpret_cast<const float *>(reinterpret_cast<const char *>(pPositions) + vertex * positionStride);
+        };
+
+        //Vertices at the same position share one position index.
+        std::vector<uint32_t> positionRemap(vertexCount);
+        VertexStream positionStream(pPositions, 3u * static_cast<uint32_t>(sizeof(float)), positionStride);
+        uint32_t positionCount = generateVertexDeduplicateRemap(positionRemap.data(), indices.data(),
+            static_cast<uint32_t>(indices.size()), vertexCount, &positionStream, 1u);
+        std::vector<uint32_t> positionUseCounts(positionCount, 0u);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            if (positionRemap[i] != FD_MESH_OPTIMIZER_INVALID_INDEX) ++positionUseCounts[positionRemap[i]];
+        }
+
+        //Classify vertices.
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        _buildEdgeCounts(indices, positionRemap, edgeCounts);
+        std::vector<_VertexKind> positionKinds(positionCount, _VertexKind::MANIFOLD);
+        for (const auto &item : edgeCounts)
+        {
+            uint32_t a = static_cast<uint32_t>(item.first >> 32u);
+            uint32_t b = static_cast<uint32_t>(item.first & 0xffffffffu);
+            if (item.second > 1u)
+            {
+                //Non-manifold edge.
+                positionKinds[a] = _VertexKind::LOCKED;
+                positionKinds[b] = _VertexKind::LOCKED;
+            }
+            else if (edgeCounts.count(_getEdgeKey(b, a)) == 0)
+            {
+                if (positionKinds[a] == _VertexKind::MANIFOLD) positionKinds[a] = _VertexKind::BORDER;
+                if (positionKinds[b] == _VertexKind::MANIFOLD) positionKinds[b] = _VertexKind::BORDER;
+            }
+        }
+        std::vector<_VertexKind> vertexKinds(vertexCount, _VertexKind::LOCKED);
+        float minOfBounds[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        float maxOfBounds[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            uint32_t position = positionRemap[i];
+            if (position == FD_MESH_OPTIMIZER_INVALID_INDEX) continue;
+            //Vertices of seams are locked to keep their attributes continuous.
+            vertexKinds[i] = positionUseCounts[position] > 1u ? _VertexKind::LOCKED : positionKinds[position];
+            const float *p = getPosition(i);
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                minOfBounds[j] = std::min(minOfBounds[j], p[j]);
+                maxOfBounds[j] = std::max(maxOfBounds[j], p[j]);
+            }
+        }
+        double scale = 0.0;
+        for (uint32_t j = 0; j < 3u; ++j)
+        {
+            scale = std::max(scale, static_cast<double>(maxOfBounds[j]) - static_cast<double>(minOfBounds[j]));
+        }
+        if (scale <= 0.0) scale = 1.0;
+        double maxError = static_cast<double>(targetError) * scale;
+        maxError = maxError * maxError;
+
+        //Quadrics of triangle planes weighted by area, and planes perpendicular to border edges.
+        std::vector<_Quadric> quadrics(vertexCount);
+        for (uint32_t i = 0; i < triangleCount * 3u; i += 3u)
+        {
+            double normal[3];
+            const float *p0 = getPosition(indices[i]);
+            _getNormal(p0, getPosition(indices[i + 1u]), getPosition(indices[i + 2u]), normal);
+            double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length == 0.0) continue;
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+            double d = -(normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2]);
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                quadrics[indices[i + j]].addPlane(normal[0], normal[1], normal[2], d, length * 0.5);
+            }
+
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                uint32_t a = indices[i + j];
+                uint32_t b = indices[i + (j + 1u) % 3u];
+                if (edgeCounts.count(_getEdgeKey(positionRemap[b], positionRemap[a])) != 0) continue;
+                const float *pa = getPosition(a);
+                const float *pb = getPosition(b);
+                double edge[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+                double borderNormal[3] = {
+                    edge[1] * normal[2] - edge[2] * normal[1],
+                    edge[2] * normal[0] - edge[0] * normal[2],
+                    edge[0] * normal[1] - edge[1] * normal[0],
+                };
+                double edgeLength = std::sqrt(edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2]);
+                if (edgeLength == 0.0) continue;
+                borderNormal[0] /= edgeLength;
+                borderNormal[1] /= edgeLength;
+                borderNormal[2] /= edgeLength;
+                double borderD = -(borderNormal[0] * pa[0] + borderNormal[1] * pa[1] + borderNormal[2] * pa[2]);
+                double w = edgeLength * edgeLength * FD_MESH_SIMPLIFIER_BORDER_WEIGHT;
+                quadrics[a].addPlane(borderNormal[0], borderNormal[1], borderNormal[2], borderD, w);
+                quadrics[b].addPlane(borderNormal[0], borderNormal[1], borderNormal[2], borderD, w);
+            }
+        }
+
+        uint32_t targetTriangleCount = targetIndexCount / 3u;
+        double resultError = 0.0;
+        std::vector<uint32_t> triangleOffsets(vertexCount + 1u);
+        std::vector<uint32_t> adjacentTriangles;
+        std::vector<_Collapse> collapses;
+        std::vector<uint32_t> collapseRemap(vertexCount);
+        std::vector<uint8_t> vertexLocks(vertexCount);
+        while (triangleCount > targetTriangleCount)
+        {
+            //Build vertex-triangle adjacency.
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+            for (const auto &index : indices) ++triangleOffsets[index + 1u];
+            for (uint32_t i = 0; i < vertexCount; ++i) triangleOffsets[i + 1u] += triangleOffsets[i];
+            adjacentTriangles.resize(indices.size());
+            {
+                std::vector<uint32_t> fillCounts(triangleOffsets.begin(), triangleOffsets.end() - 1u);
+                for (uint32_t i = 0; i < triangleCount * 3u; ++i)
+                {
+                    adjacentTriangles[fillCounts[indices[i]]++] = i / 3u;
+                }
+            }
+            _buildEdgeCounts(indices, positionRemap, edgeCounts);
+
+            //Collect collapses of both directions of every edge.
+            collapses.clear();
+            for (uint32_t i = 0; i < triangleCount * 3u; ++i)
+            {
+                uint32_t a = indices[i];
+                uint32_t b = indices[i - i % 3u + (i % 3u + 1u) % 3u];
+                Bool32 isBorderEdge = edgeCounts.count(_getEdgeKey(positionRemap[b], positionRemap[a])) == 0 ? FD_TRUE : FD_FALSE;
+                uint32_t vertices[2] = {a, b};
+                for (uint32_t j = 0; j < 2u; ++j)
+                {
+                    uint32_t src = vertices[j];
+                    uint32_t dst = vertices[1u - j];
+                    _VertexKind kind = vertexKinds[src];
+                    if (kind == _VertexKind::LOCKED) continue;
+                    if (kind == _VertexKind::BORDER && (isBorderEdge == FD_FALSE || vertexKinds[dst] != _VertexKind::BORDER)) continue;
+                    _Collapse collapse = {src, dst, quadrics[src].getError(getPosition(dst))};
+                    collapses.push_back(collapse);
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const _Collapse &a, const _Collapse &b)
+            {
+                return a.error < b.error;
+            });
+
+            //Apply cheapest collapses whose neighborhoods aren't changed in this pass.
+            for (uint32_t i = 0; i < vertexCount; ++i) collapseRemap[i] = i;
+            std::fill(vertexLocks.begin(), vertexLocks.end(), static_cast<uint8_t>(0u));
+            uint32_t collapseCount = 0u;
+            uint32_t remainingTriangleCount = triangleCount;
+            for (const auto &collapse : collapses)
+            {
+                if (collapse.error > maxError || remainingTriangleCount <= targetTriangleCount) break;
+                uint32_t src = collapse.srcVertex;
+                uint32_t dst = collapse.dstVertex;
+                if (vertexLocks[src] != 0u || vertexLocks[dst] != 0u) continue;
+
+                uint32_t removedTriangleCount = 0u;
+                Bool32 isFlipped = FD_FALSE;
+                for (uint32_t j = triangleOffsets[src]; j < triangleOffsets[src + 1u]; ++j)
+                {
+                    const uint32_t *pTriangle = indices.data() + adjacentTriangles[j] * 3u;
+                    if (pTriangle[0] == dst || pTriangle[1] == dst || pTriangle[2] == dst)
+                    {
+                        ++removedTriangleCount;
+                        continue;
+                    }
+                    double normal[3];
+                    double newNormal[3];
+                    const float *p[3];
+                    for (uint32_t k = 0; k < 3u; ++k) p[k] = getPosition(pTriangle[k]);
+                    _getNormal(p[0], p[1], p[2], normal);
+                    for (uint32_t k = 0; k < 3u; ++k) if (pTriangle[k] == src) p[k] = getPosition(dst);
+                    _getNormal(p[0], p[1], p[2], newNormal);
+                    if (normal[0] * newNormal[0] + normal[1] * newNormal[1] + normal[2] * newNormal[2] <= 0.0)
+                    {
+                        isFlipped = FD_TRUE;
+                        break;
+                    }
+                }
+                if (isFlipped == FD_TRUE) continue;
+
+                collapseRemap[src] = dst;
+                quadrics[dst].add(quadrics[src]);
+                for (uint32_t j = triangleOffsets[src]; j < triangleOffsets[src + 1u]; ++j)
+                {
+                    const uint32_t *pTriangle = indices.data() + adjacentTriangles[j] * 3u;
+                    vertexLocks[pTriangle[0]] = 1u;
+                    vertexLocks[pTriangle[1]] = 1u;
+                    vertexLocks[pTriangle[2]] = 1u;
+                }
+                remainingTriangleCount -= std::min(removedTriangleCount, remainingTriangleCount);
+                resultError = std::max(resultError, collapse.error);
+                ++collapseCount;
+            }
+            if (collapseCount == 0u) break;
+
+            //Remap indices and remove degenerate triangles.
+            uint32_t newIndexCount = 0u;
+            for (uint32_t i = 0; i < triangleCount * 3u; i += 3u)
+            {
+                uint32_t a = collapseRemap[indices[i]];
+                uint32_t b = collapseRemap[indices[i + 1u]];
+                uint32_t c = collapseRemap[indices[i + 2u]];
+                if (a == b || b == c || c == a) continue;
+                indices[newIndexCount++] = a;
+                indices[newIndexCount++] = b;
+                indices[newIndexCount++] = c;
+            }
+            indices.resize(newIndexCount);
+            triangleCount = newIndexCount / 3u;
+        }
+
+        std::copy(indices.begin(), indices.end(), pDstIndices);
+        if (pResultError != nullptr) *pResultError = static_cast<float>(std::sqrt(resultError) / scale);
+        return static_cast<uint32_t>(indices.size());
+    }
+} //fd
@@ -0,0 +1,30 @@
+#ifndef FD_MESH_SIMPLIFIER_H
+#define FD_MESH_SIMPLIFIER_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    /*Simplify the triangle list with quadric error metric edge collapses (Garland and Heckbert 1997).
+      Only indices are changed, every edge collapses to one of its original vertices, so the result can share
+      the vertex buffer of the source. Vertices at the same position with different attributes (seams) are locked,
+      border vertices can only move along the border.
+      It stops when index count is not more than targetIndexCount or error of the next collapse is more than targetError,
+      targetError is relative to the extent of the mesh, eg. 0.01 is 1% of the size of the mesh.
+      pPositions is array of 3 floats with positionStride bytes between vertices. pDstIndices can be same as pIndices.
+      Return the index count of the result, pResultError receives the relative error of the result if it isn't null.*/
+    extern uint32_t simplifyMesh(uint32_t *pDstIndices
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        , const float *pPositions
+        , uint32_t vertexCount
+        , uint32_t positionStride
+        , uint32_t targetIndexCount
+        , float targetError
+        , float *pResultError = nullptr
+        );
+} //fd
+
+#endif //FD_MESH_SIMPLIFIER_H
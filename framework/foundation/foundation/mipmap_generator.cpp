@@ -0,0 +1,434 @@
+#include "foundation/mipmap_generator.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "foundation/thread_pool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FD_MIPMAP_USE_SSE
+#endif
+
+namespace fd
+{
+    //Pixels are filtered with 4 floats, so a pixel is one SSE register.
+    static const uint32_t FILTER_CHANNEL_COUNT = 4u;
+    //Radius of kaiser filter in pixels of destination level.
+    static const float KAISER_RADIUS = 2.0f;
+    static const float KAISER_ALPHA = 4.0f;
+    static const uint32_t ALPHA_COVERAGE_SEARCH_COUNT = 16u;
+    static const float ALPHA_COVERAGE_MAX_SCALE = 4.0f;
+
+    MipmapGenerateInfo::MipmapGenerateInfo(MipmapFilter filter
+        , Bool32 isPreserveAlphaCoverage
+        , float alphaCutoff
+        )
+        : filter(filter)
+        , isPreserveAlphaCoverage(isPreserveAlphaCoverage)
+        , alphaCutoff(alphaCutoff)
+    {
+
+    }
+
+    uint32_t getMipmapChannelSize(MipmapChannelType type)
+    {
+        switch (type)
+        {
+        case MipmapChannelType::UNORM16:
+        case MipmapChannelType::UINT16:
+            return 2u;
+        case MipmapChannelType::FLOAT32:
+            return 4u;
+        default:
+            return 1u;
+        }
+    }
+
+    uint32_t caculateMipmapLevelCount(uint32_t width, uint32_t height)
+    {
+        return static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(std::max(width, height))))) + 1u;
+    }
+
+    uint32_t caculateMipmapLevelOffset(MipmapChannelType type
+        , uint32_t channelCount
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t level
+        )
+    {
+        uint32_t pixelSize = getMipmapChannelSize(type) * channelCount;
+        uint32_t offset = 0u;
+        for (uint32_t i = 0u; i < level; ++i)
+        {
+            offset += std::max(1u, width >> i) * std::max(1u, height >> i) * layerCount * pixelSize;
+        }
+        return offset;
+    }
+
+    //Source pixels and their weights of every destination pixel along an axis.
+    struct _FilterWeights
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> indices;
+        std::vector<float> weights;
+    };
+
+    static float _besselI0(float x)
+    {
+        float sum = 1.0f;
+        float term = 1.0f;
+        float halfX = x * 0.5f;
+        for (uint32_t k = 1u; k < 32u; ++k)
+        {
+            term *= (halfX / static_cast<float>(k)) * (halfX / static_cast<float>(k));
+            sum += term;
+            if (term < sum * 1e-7f) break;
+        }
+        return sum;
+    }
+
+    static float _kaiser(float t)
+    {
+        float ratio = t / KAISER_RADIUS;
+        if (std::abs(ratio) >= 1.0f) return 0.0f;
+        const float pi = 3.14159265358979f;
+        float sinc = std::abs(t) < 1e-6f ? 1.0f : std::sin(pi * t) / (pi * t);
+        return sinc * _besselI0(KAISER_ALPHA * std::sqrt(1.0f - ratio * ratio)) / _besselI0(KAISER_ALPHA);
+    }
+
+    static void _caculateFilterWeights(MipmapFilter filter
+        , uint32_t srcSize
+        , uint32_t dstSize
+        , _FilterWeights &result
+        )
+    {
+        result.offsets.resize(dstSize + 1u);
+        result.indices.clear();
+        result.weights.clear();
+        float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+        for (uint32_t dst = 0u; dst < dstSize; ++dst)
+        {
+            result.offsets[dst] = static_cast<uint32_t>(result.indices.size());
+            float center = (static_cast<float>(dst) + 0.5f) * scale;
+            float radius = filter == MipmapFilter::BOX ? scale * 0.5f : KAISER_RADIUS * scale;
+            int32_t first = static_cast<int32_t>(std::floor(center - radius));
+            int32_t last = static_cast<int32_t>(std::ceil(center + radius));
+            float totalWeight = 0.0f;
+            for (int32_t src = first; src < last; ++src)
+            {
+                float weight;
+                if (filter == MipmapFilter::BOX)
+                {
+                    //Length of the source pixel covered by the destination pixel.
+                    weight = std::min(center + radius, static_cast<float>(src + 1)) -
+                        std::max(center - radius, static_cast<float>(src));
+                }
+                else
+                {
+                    weight = _kaiser((static_cast<float>(src) + 0.5f - center) / scale);
+                }
+                if (weight == 0.0f) continue;
+                //Edge pixels are clamped.
+                int32_t index = std::min(std::max(src, 0), static_cast<int32_t>(srcSize) - 1);
+                result.indices.push_back(static_cast<uint32_t>(index));
+                result.weights.push_back(weight);
+                totalWeight += weight;
+            }
+            for (uint32_t i = result.offsets[dst]; i < result.weights.size(); ++i)
+            {
+                result.weights[i] /= totalWeight;
+            }
+        }
+        result.offsets[dstSize] = static_cast<uint32_t>(result.indices.size());
+    }
+
+    inline static void _filterPixel(const float *pBase
+        , uint32_t stride
+        , const _FilterWeights &weights
+        , uint32_t dst
+        , float *pResult
+        )
+    {
+        uint32_t begin = weights.offsets[dst];
+        uint32_t end = weights.offsets[dst + 1u];
+#ifdef FD_MIPMAP_USE_SSE
+        __m128 sum = _mm_setzero_ps();
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            __m128 pixel = _mm_loadu_ps(pBase + weights.indices[i] * stride);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights.weights[i]), pixel));
+        }
+        _mm_storeu_ps(pResult, sum);
+#else
+        float sum[FILTER_CHANNEL_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const float *pPixel = pBase + weights.indices[i] * stride;
+            float weight = weights.weights[i];
+            for (uint32_t c = 0u; c < FILTER_CHANNEL_COUNT; ++c)
+            {
+                sum[c] += weight * pPixel[c];
+            }
+        }
+        memcpy(pResult, sum, sizeof(sum));
+#endif //FD_MIPMAP_USE_SSE
+    }
+
+    static const std::array<float, 256u> &_getSRGBToLinearTable()
+    {
+        static const std::array<float, 256u> table = []() {
+            std::array<float, 256u> result;
+            for (uint32_t i = 0u; i < 256u; ++i)
+            {
+                float value = static_cast<float>(i) / 255.0f;
+                result[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    inline static float _linearToSRGB(float value)
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    inline static Bool32 _isSRGBChannel(MipmapChannelType type, uint32_t channelCount, uint32_t channel)
+    {
+        return type == MipmapChannelType::SRGB8 && (channelCount < 4u || channel < 3u) ? FD_TRUE : FD_FALSE;
+    }
+
+    static void _decodeRow(MipmapChannelType type
+        , uint32_t channelCount
+        , const uint8_t *pSrc
+        , uint32_t pixelCount
+        , float *pDst
+        )
+    {
+        const auto &srgbTable = _getSRGBToLinearTable();
+        uint32_t channelSize = getMipmapChannelSize(type);
+        for (uint32_t i = 0u; i < pixelCount; ++i)
+        {
+            float *pPixel = pDst + i * FILTER_CHANNEL_COUNT;
+            for (uint32_t c = 0u; c < FILTER_CHANNEL_COUNT; ++c)
+            {
+                if (c >= channelCount)
+                {
+                    pPixel[c] = 0.0f;
+                    continue;
+                }
+                const uint8_t *pChannel = pSrc + (i * channelCount + c) * channelSize;
+                switch (type)
+                {
+                case MipmapChannelType::UNORM8:
+                    pPixel[c] = static_cast<float>(*pChannel) / 255.0f;
+                    break;
+                case MipmapChannelType::SRGB8:
+                    pPixel[c] = _isSRGBChannel(type, channelCount, c) ? srgbTable[*pChannel] :
+                        static_cast<float>(*pChannel) / 255.0f;
+                    break;
+                case MipmapChannelType::UINT8:
+                    pPixel[c] = static_cast<float>(*pChannel);
+                    break;
+                case MipmapChannelType::UNORM16:
+                case MipmapChannelType::UINT16:
+                {
+                    uint16_t value;
+                    memcpy(&value, pChannel, sizeof(value));
+                    pPixel[c] = type == MipmapChannelType::UNORM16 ? static_cast<float>(value) / 65535.0f :
+                        static_cast<float>(value);
+                    break;
+                }
+                case MipmapChannelType::FLOAT32:
+                    memcpy(pPixel + c, pChannel, sizeof(float));
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    static void _encodeRow(MipmapChannelType type
+        , uint32_t channelCount
+        , const float *pSrc
+        , uint32_t pixelCount
+        , uint8_t *pDst
+        )
+    {
+        auto quantize = [](float value, float maxValue) {
+            return std::min(std::max(value, 0.0f), maxValue) + 0.5f;
+        };
+        uint32_t channelSize = getMipmapChannelSize(type);
+        for (uint32_t i = 0u; i < pixelCount; ++i)
+        {
+            const float *pPixel = pSrc + i * FILTER_CHANNEL_COUNT;
+            for (uint32_t c = 0u; c < channelCount; ++c)
+            {
+                uint8_t *pChannel = pDst + (i * channelCount + c) * channelSize;
+                float value = pPixel[c];
+                switch (type)
+                {
+                case MipmapChannelType::UNORM8:
+                    *pChannel = static_cast<uint8_t>(quantize(value * 255.0f, 255.0f));
+                    break;
+                case MipmapChannelType::SRGB8:
+                    if (_isSRGBChannel(type, channelCount, c))
+                        value = _linearToSRGB(std::min(std::max(value, 0.0f), 1.0f));
+                    *pChannel = static_cast<uint8_t>(quantize(value * 255.0f, 255.0f));
+                    break;
+                case MipmapChannelType::UINT8:
+                    *pChannel = static_cast<uint8_t>(quantize(value, 255.0f));
+                    break;
+                case MipmapChannelType::UNORM16:
+                case MipmapChannelType::UINT16:
+                {
+                    if (type == MipmapChannelType::UNORM16) value *= 65535.0f;
+                    uint16_t result = static_cast<uint16_t>(quantize(value, 65535.0f));
+                    memcpy(pChannel, &result, sizeof(result));
+                    break;
+                }
+                case MipmapChannelType::FLOAT32:
+                    memcpy(pChannel, &value, sizeof(float));
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    static float _caculateAlphaCoverage(const float *pPixels, uint32_t pixelCount, float cutoff, float scale)
+    {
+        uint32_t count = 0u;
+        for (uint32_t i = 0u; i < pixelCount; ++i)
+        {
+            if (std::min(pPixels[i * FILTER_CHANNEL_COUNT + 3u] * scale, 1.0f) >= cutoff) ++count;
+        }
+        return static_cast<float>(count) / static_cast<float>(pixelCount);
+    }
+
+    //Smallest scale of alpha whose coverage isn't less than target coverage is found with binary search.
+    static void _preserveAlphaCoverage(float *pPixels, uint32_t pixelCount, float cutoff, float targetCoverage)
+    {
+        float minScale = 0.0f;
+        float maxScale = ALPHA_COVERAGE_MAX_SCALE;
+        for (uint32_t i = 0u; i < ALPHA_COVERAGE_SEARCH_COUNT; ++i)
+        {
+            float scale = (minScale + maxScale) * 0.5f;
+            if (_caculateAlphaCoverage(pPixels, pixelCount, cutoff, scale) < targetCoverage)
+                minScale = scale;
+            else
+                maxScale = scale;
+        }
+        for (uint32_t i = 0u; i < pixelCount; ++i)
+        {
+            float &alpha = pPixels[i * FILTER_CHANNEL_COUNT + 3u];
+            alpha = std::min(alpha * maxScale, 1.0f);
+        }
+    }
+
+    void generateMipmaps(MipmapChannelType type
+        , uint32_t channelCount
+        , const MipmapGenerateInfo &info
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t levelCount
+        , uint8_t *pData
+        )
+    {
+#ifdef DEBUG
+        if (channelCount == 0u || channelCount > FILTER_CHANNEL_COUNT)
+            throw std::runtime_error("Channel count of mipmap generation should be in [1, 4].");
+        if (levelCount > caculateMipmapLevelCount(width, height))
+            throw std::runtime_error("Level count of mipmap generation is greater than level count of the image.");
+#endif //DEBUG
+        if (levelCount <= 1u || layerCount == 0u) return;
+        Bool32 isPreserveAlphaCoverage = info.isPreserveAlphaCoverage && channelCount == 4u &&
+            type != MipmapChannelType::UINT8 && type != MipmapChannelType::UINT16 ? FD_TRUE : FD_FALSE;
+        uint32_t pixelSize = getMipmapChannelSize(type) * channelCount;
+        auto &threadPool = getDefaultThreadPool();
+
+        //Float pixels of the source level of all layers.
+        std::vector<float> srcPixels(static_cast<size_t>(width) * height * layerCount * FILTER_CHANNEL_COUNT);
+        threadPool.parallelFor(height * layerCount, [&](uint32_t row) {
+            _decodeRow(type, channelCount, pData + static_cast<size_t>(row) * width * pixelSize, width,
+                srcPixels.data() + static_cast<size_t>(row) * width * FILTER_CHANNEL_COUNT);
+        });
+        std::vector<float> targetCoverages(layerCount);
+        if (isPreserveAlphaCoverage)
+        {
+            threadPool.parallelFor(layerCount, [&](uint32_t layer) {
+                targetCoverages[layer] = _caculateAlphaCoverage(srcPixels.data() +
+                    static_cast<size_t>(layer) * width * height * FILTER_CHANNEL_COUNT,
+                    width * height, info.alphaCutoff, 1.0f);
+            });
+        }
+
+        std::vector<float> tempPixels;
+        std::vector<float> dstPixels;
+        _FilterWeights weightsX;
+        _FilterWeights weightsY;
+        uint32_t srcWidth = width;
+        uint32_t srcHeight = height;
+        uint8_t *pDst = pData + static_cast<size_t>(width) * height * layerCount * pixelSize;
+        for (uint32_t level = 1u; level < levelCount; ++level)
+        {
+            uint32_t dstWidth = std::max(1u, srcWidth >> 1u);
+            uint32_t dstHeight = std::max(1u, srcHeight >> 1u);
+            _caculateFilterWeights(info.filter, srcWidth, dstWidth, weightsX);
+            _caculateFilterWeights(info.filter, srcHeight, dstHeight, weightsY);
+            tempPixels.resize(static_cast<size_t>(dstWidth) * srcHeight * layerCount * FILTER_CHANNEL_COUNT);
+            dstPixels.resize(static_cast<size_t>(dstWidth) * dstHeight * layerCount * FILTER_CHANNEL_COUNT);
+
+            //Horizontal pass, rows of all layers are continuous.
+            threadPool.parallelFor(srcHeight * layerCount, [&](uint32_t row) {
+                const float *pSrcRow = srcPixels.data() + static_cast<size_t>(row) * srcWidth * FILTER_CHANNEL_COUNT;
+                float *pTempRow = tempPixels.data() + static_cast<size_t>(row) * dstWidth * FILTER_CHANNEL_COUNT;
+                for (uint32_t x = 0u; x < dstWidth; ++x)
+                {
+                    _filterPixel(pSrcRow, FILTER_CHANNEL_COUNT, weightsX, x, pTempRow + x * FILTER_CHANNEL_COUNT);
+                }
+            });
+
+            //Vertical pass.
+            threadPool.parallelFor(dstHeight * layerCount, [&](uint32_t row) {
+                uint32_t layer = row / dstHeight;
+                uint32_t y = row % dstHeight;
+                const float *pTempLayer = tempPixels.data() +
+                    static_cast<size_t>(layer) * dstWidth * srcHeight * FILTER_CHANNEL_COUNT;
+                float *pDstRow = dstPixels.data() + static_cast<size_t>(row) * dstWidth * FILTER_CHANNEL_COUNT;
+                for (uint32_t x = 0u; x < dstWidth; ++x)
+                {
+                    _filterPixel(pTempLayer + x * FILTER_CHANNEL_COUNT, dstWidth * FILTER_CHANNEL_COUNT,
+                        weightsY, y, pDstRow + x * FILTER_CHANNEL_COUNT);
+                }
+            });
+
+            if (isPreserveAlphaCoverage)
+            {
+                threadPool.parallelFor(layerCount, [&](uint32_t layer) {
+                    _preserveAlphaCoverage(dstPixels.data() +
+                        static_cast<size_t>(layer) * dstWidth * dstHeight * FILTER_CHANNEL_COUNT,
+                        dstWidth * dstHeight, info.alphaCutoff, targetCoverages[layer]);
+                });
+            }
+
+            threadPool.parallelFor(dstHeight * layerCount, [&](uint32_t row) {
+                _encodeRow(type, channelCount, dstPixels.data() + static_cast<size_t>(row) * dstWidth * FILTER_CHANNEL_COUNT,
+                    dstWidth, pDst + static_cast<size_t>(row) * dstWidth * pixelSize);
+            });
+
+            pDst += static_cast<size_t>(dstWidth) * dstHeight * layerCount * pixelSize;
+            srcPixels.swap(dstPixels);
+            srcWidth = dstWidth;
+            srcHeight = dstHeight;
+        }
+    }
+} //fd
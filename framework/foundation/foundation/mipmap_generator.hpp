@@ -0,0 +1,76 @@
+#ifndef FD_MIPMAP_GENERATOR_H
+#define FD_MIPMAP_GENERATOR_H
+
+#include <cstdint>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    enum class MipmapFilter
+    {
+        //Average of the source pixels covered by the destination pixel.
+        BOX,
+        //Kaiser windowed sinc, it keeps more details than box filter.
+        KAISER,
+        BEGIN_RANGE = BOX,
+        END_RANGE = KAISER,
+        RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+    };
+
+    /*Type of every channel of pixels. Color channels of SRGB8 are filtered in linear space, alpha of
+      4 channel pixels is linear. Channels of integer types are filtered with their values.*/
+    enum class MipmapChannelType
+    {
+        UNORM8,
+        SRGB8,
+        UINT8,
+        UNORM16,
+        UINT16,
+        FLOAT32,
+        BEGIN_RANGE = UNORM8,
+        END_RANGE = FLOAT32,
+        RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+    };
+
+    struct MipmapGenerateInfo
+    {
+        MipmapFilter filter;
+        /*Scale alpha of every level to keep the fraction of pixels passing the alpha test with the cutoff
+          same as level 0, it is used by cutout textures. Alpha is the last channel of 4 channel pixels,
+          it isn't used by integer types.*/
+        Bool32 isPreserveAlphaCoverage;
+        float alphaCutoff;
+
+        MipmapGenerateInfo(MipmapFilter filter = MipmapFilter::BOX
+            , Bool32 isPreserveAlphaCoverage = FD_FALSE
+            , float alphaCutoff = 0.5f
+            );
+    };
+
+    extern uint32_t getMipmapChannelSize(MipmapChannelType type);
+    extern uint32_t caculateMipmapLevelCount(uint32_t width, uint32_t height);
+    /*Offset of the level in the data of a mip chain, levels are in order and every level contains all layers.
+      Offset of the level count is size of the chain.*/
+    extern uint32_t caculateMipmapLevelOffset(MipmapChannelType type
+        , uint32_t channelCount
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t level
+        );
+
+    /*Generate levels from 1 to levelCount - 1 of the chain data from its level 0, every level is
+      filtered from float data of its previous level. Channel count should be in [1, 4].
+      Rows of all layers are filtered by the default thread pool, the result doesn't depend on thread count.*/
+    extern void generateMipmaps(MipmapChannelType type
+        , uint32_t channelCount
+        , const MipmapGenerateInfo &info
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t levelCount
+        , uint8_t *pData
+        );
+} //fd
+
+#endif //FD_MIPMAP_GENERATOR_H
@@ -0,0 +1,319 @@
+#include "foundation/profiler.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+namespace fd
+{
+    const uint32_t Profiler::DEFAULT_THREAD_EVENT_CAPACITY = 16384u;
+
+    //It is initialized constantly, so allocations before dynamic initialization are counted too.
+    static std::atomic<uint64_t> _allocationCount(0u);
+
+    ProfileEvent::ProfileEvent(const char *name
+        , uint64_t beginTime
+        , uint64_t endTime
+        , uint32_t depth
+        , uint32_t threadIndex
+        , uint64_t frameIndex
+        )
+        : name(name)
+        , beginTime(beginTime)
+        , endTime(endTime)
+        , depth(depth)
+        , threadIndex(threadIndex)
+        , frameIndex(frameIndex)
+    {
+
+    }
+
+    ProfileZoneStat::ProfileZoneStat(const char *name
+        , uint32_t minDepth
+        , uint32_t callCount
+        , uint64_t totalTime
+        , uint64_t maxTime
+        )
+        : name(name)
+        , minDepth(minDepth)
+        , callCount(callCount)
+        , totalTime(totalTime)
+        , maxTime(maxTime)
+    {
+
+    }
+
+    Profiler::Profiler(uint32_t threadEventCapacity)
+        : m_threadEventCapacity(threadEventCapacity)
+        , m_startTime(std::chrono::steady_clock::now())
+        , m_isEnable(FD_TRUE)
+        , m_frameIndex(0u)
+        , m_frameBeginTime(0u)
+        , m_lastFrameTime(0u)
+        , m_frameBeginAllocationCount(0u)
+        , m_lastFrameAllocationCount(0u)
+        , m_zoneStats()
+        , m_statIndices()
+        , m_lastFrameStats()
+        , m_threadBuffersMutex()
+        , m_threadBuffers()
+    {
+#ifdef DEBUG
+        if (threadEventCapacity == 0u)
+            throw std::invalid_argument("Event capacity of profiler should not be 0.");
+#endif //DEBUG
+    }
+
+    void Profiler::setEnable(Bool32 value)
+    {
+        m_isEnable = value;
+    }
+
+    Bool32 Profiler::getEnable() const
+    {
+        return m_isEnable;
+    }
+
+    uint64_t Profiler::getTime() const
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_startTime).count());
+    }
+
+    void Profiler::beginZone(const char *name)
+    {
+        if (m_isEnable == FD_FALSE) return;
+        auto pBuffer = _getThreadBuffer();
+        _OpenZone zone = {
+            name,
+            getTime(),
+            m_frameIndex,
+        };
+        pBuffer->openZones.push_back(zone);
+    }
+
+    void Profiler::endZone()
+    {
+        uint64_t endTime = getTime();
+        auto pBuffer = _getThreadBuffer();
+        if (pBuffer->openZones.empty()) return;
+        const auto &zone = pBuffer->openZones.back();
+        uint32_t depth = static_cast<uint32_t>(pBuffer->openZones.size()) - 1u;
+        {
+            std::lock_guard<std::mutex> lock(pBuffer->mutex);
+            auto index = static_cast<size_t>(pBuffer->writeCount % static_cast<uint64_t>(m_threadEventCapacity));
+            pBuffer->events[index] = ProfileEvent(zone.name
+                , zone.beginTime
+                , endTime
+                , depth
+                , pBuffer->threadIndex
+                , zone.frameIndex
+                );
+            ++pBuffer->writeCount;
+        }
+        pBuffer->openZones.pop_back();
+    }
+
+    void Profiler::beginFrame()
+    {
+        m_frameBeginTime = getTime();
+        m_frameBeginAllocationCount = getAllocationCount();
+    }
+
+    void Profiler::endFrame()
+    {
+        uint64_t frameIndex = m_frameIndex;
+        m_lastFrameTime = getTime() - m_frameBeginTime;
+        //It is read before stats are aggregated, allocations of aggregating aren't counted into the frame.
+        m_lastFrameAllocationCount = getAllocationCount() - m_frameBeginAllocationCount;
+        for (auto &stat : m_zoneStats)
+        {
+            stat.callCount = 0u;
+            stat.totalTime = 0u;
+            stat.maxTime = 0u;
+        }
+        {
+            std::lock_guard<std::mutex> buffersLock(m_threadBuffersMutex);
+            for (const auto &pBuffer : m_threadBuffers)
+            {
+                std::lock_guard<std::mutex> lock(pBuffer->mutex);
+                //Events of a thread are written in order of ending, so events of the frame are at the end.
+                uint64_t count = std::min(pBuffer->writeCount, static_cast<uint64_t>(m_threadEventCapacity));
+                for (uint64_t i = pBuffer->writeCount; i > pBuffer->writeCount - count; --i)
+                {
+                    const auto &event = pBuffer->events[static_cast<size_t>((i - 1u) % static_cast<uint64_t>(m_threadEventCapacity))];
+                    if (event.endTime < m_frameBeginTime) break;
+                    if (event.frameIndex != frameIndex) continue;
+                    uint64_t time = event.endTime - event.beginTime;
+                    uint32_t statIndex;
+                    auto iterator = m_statIndices.find(event.name);
+                    if (iterator == m_statIndices.end())
+                    {
+                        statIndex = static_cast<uint32_t>(m_zoneStats.size());
+                        m_statIndices[event.name] = statIndex;
+                        m_zoneStats.push_back(ProfileZoneStat(event.name));
+                    }
+                    else
+                    {
+                        statIndex = iterator->second;
+                    }
+                    auto &stat = m_zoneStats[statIndex];
+                    stat.minDepth = stat.callCount == 0u ? event.depth : std::min(stat.minDepth, event.depth);
+                    ++stat.callCount;
+                    stat.totalTime += time;
+                    stat.maxTime = std::max(stat.maxTime, time);
+                }
+            }
+        }
+        //Zones not called in the frame are skipped, capacity of the stats is kept.
+        m_lastFrameStats.clear();
+        for (const auto &stat : m_zoneStats)
+        {
+            if (stat.callCount != 0u) m_lastFrameStats.push_back(stat);
+        }
+        ++m_frameIndex;
+    }
+
+    uint64_t Profiler::getFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    uint64_t Profiler::getLastFrameTime() const
+    {
+        return m_lastFrameTime;
+    }
+
+    uint64_t Profiler::getLastFrameAllocationCount() const
+    {
+        return m_lastFrameAllocationCount;
+    }
+
+    const std::vector<ProfileZoneStat> &Profiler::getLastFrameStats() const
+    {
+        return m_lastFrameStats;
+    }
+
+    std::vector<ProfileEvent> Profiler::collectEvents() const
+    {
+        std::vector<ProfileEvent> events;
+        std::lock_guard<std::mutex> buffersLock(m_threadBuffersMutex);
+        for (const auto &pBuffer : m_threadBuffers)
+        {
+            std::lock_guard<std::mutex> lock(pBuffer->mutex);
+            uint64_t count = std::min(pBuffer->writeCount, static_cast<uint64_t>(m_threadEventCapacity));
+            for (uint64_t i = pBuffer->writeCount - count; i < pBuffer->writeCount; ++i)
+            {
+                events.push_back(pBuffer->events[static_cast<size_t>(i % static_cast<uint64_t>(m_threadEventCapacity))]);
+            }
+        }
+        return events;
+    }
+
+    void Profiler::exportChromeTrace(std::ostream &stream) const
+    {
+        auto events = collectEvents();
+        //Complete events, times of them are microseconds.
+        stream << "{\"traceEvents\":[";
+        stream << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const auto &event = events[i];
+            if (i != 0u) stream << ",";
+            stream << "\n{\"name\":\"";
+            for (const char *pChar = event.name; pChar != nullptr && *pChar != '\0'; ++pChar)
+            {
+                if (*pChar == '"' || *pChar == '\\') stream << '\\';
+                stream << *pChar;
+            }
+            stream << "\",\"cat\":\"cpu\",\"ph\":\"X\""
+                << ",\"ts\":" << static_cast<double>(event.beginTime) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.endTime - event.beginTime) / 1000.0
+                << ",\"pid\":0,\"tid\":" << event.threadIndex
+                << ",\"args\":{\"frame\":" << event.frameIndex << "}}";
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    Bool32 Profiler::saveChromeTrace(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (file.is_open() == false)
+        {
+            FD_LOG(plog::warning) << "Failed to open file to save chrome trace: " << path << std::endl;
+            return FD_FALSE;
+        }
+        exportChromeTrace(file);
+        return FD_TRUE;
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> buffersLock(m_threadBuffersMutex);
+        for (const auto &pBuffer : m_threadBuffers)
+        {
+            std::lock_guard<std::mutex> lock(pBuffer->mutex);
+            pBuffer->writeCount = 0u;
+        }
+        m_lastFrameAllocationCount = 0u;
+        m_zoneStats.clear();
+        m_statIndices.clear();
+        m_lastFrameStats.clear();
+    }
+
+    Profiler::_ThreadBuffer *Profiler::_getThreadBuffer()
+    {
+        //The buffer of current thread is cached, it is only searched again when another profiler is used.
+        thread_local const Profiler *pCachedProfiler = nullptr;
+        thread_local _ThreadBuffer *pCachedBuffer = nullptr;
+        if (pCachedProfiler == this) return pCachedBuffer;
+
+        auto threadID = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        auto iterator = std::find_if(m_threadBuffers.begin(), m_threadBuffers.end(), [threadID](const std::unique_ptr<_ThreadBuffer> &pBuffer)
+        {
+            return pBuffer->threadID == threadID;
+        });
+        if (iterator == m_threadBuffers.end())
+        {
+            std::unique_ptr<_ThreadBuffer> pBuffer(new _ThreadBuffer());
+            pBuffer->threadID = threadID;
+            pBuffer->threadIndex = static_cast<uint32_t>(m_threadBuffers.size());
+            pBuffer->events.resize(m_threadEventCapacity);
+            pBuffer->writeCount = 0u;
+            m_threadBuffers.push_back(std::move(pBuffer));
+            iterator = m_threadBuffers.end() - 1;
+        }
+        pCachedProfiler = this;
+        pCachedBuffer = iterator->get();
+        return pCachedBuffer;
+    }
+
+    ProfileZone::ProfileZone(const char *name)
+        : m_isBegun(getDefaultProfiler().getEnable())
+    {
+        if (m_isBegun == FD_TRUE) getDefaultProfiler().beginZone(name);
+    }
+
+    ProfileZone::~ProfileZone()
+    {
+        if (m_isBegun == FD_TRUE) getDefaultProfiler().endZone();
+    }
+
+    Profiler &getDefaultProfiler()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void countAllocation()
+    {
+        _allocationCount.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    uint64_t getAllocationCount()
+    {
+        return _allocationCount.load(std::memory_order_relaxed);
+    }
+} //fd
@@ -0,0 +1,180 @@
+#ifndef FD_PROFILER_HPP
+#define FD_PROFILER_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <ostream>
+#include <unordered_map>
+#include <new>
+#include <cstdlib>
+#include "foundation/global.hpp"
+
+#define FD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FD_PROFILE_CONCAT(a, b) FD_PROFILE_CONCAT_IMPL(a, b)
+
+/*Zones are only compiled when FD_ENABLE_PROFILER is defined, it doesn't depend on DEBUG, so release builds
+  can be profiled too. Names should be string literals, they are stored as pointers.*/
+#ifdef FD_ENABLE_PROFILER
+#define FD_PROFILE_ZONE(name) ::fd::ProfileZone FD_PROFILE_CONCAT(_fdProfileZone, __LINE__)(name)
+#define FD_PROFILE_BEGIN(name) ::fd::getDefaultProfiler().beginZone(name)
+#define FD_PROFILE_END() ::fd::getDefaultProfiler().endZone()
+#else
+#define FD_PROFILE_ZONE(name)
+#define FD_PROFILE_BEGIN(name)
+#define FD_PROFILE_END()
+#endif //FD_ENABLE_PROFILER
+
+/*The library never replaces global allocation functions, an executable counts its allocations by putting it
+  into one of its source files, then allocations of frames are got from the profiler.*/
+#define FD_DEFINE_ALLOCATION_COUNTING_NEW() \
+    void *operator new(size_t size) \
+    { \
+        ::fd::countAllocation(); \
+        void *p = std::malloc(size != 0u ? size : 1u); \
+        if (p == nullptr) throw std::bad_alloc(); \
+        return p; \
+    } \
+    void *operator new[](size_t size) { return operator new(size); } \
+    void operator delete(void *p) noexcept { std::free(p); } \
+    void operator delete[](void *p) noexcept { std::free(p); } \
+    void operator delete(void *p, size_t) noexcept { std::free(p); } \
+    void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+namespace fd
+{
+    struct ProfileEvent
+    {
+        const char *name;
+        //Nanoseconds since the profiler is created.
+        uint64_t beginTime;
+        uint64_t endTime;
+        //Count of zones of the thread which contain this one.
+        uint32_t depth;
+        uint32_t threadIndex;
+        uint64_t frameIndex;
+
+        ProfileEvent(const char *name = nullptr
+            , uint64_t beginTime = 0u
+            , uint64_t endTime = 0u
+            , uint32_t depth = 0u
+            , uint32_t threadIndex = 0u
+            , uint64_t frameIndex = 0u
+            );
+    };
+
+    //Zones with same name in a frame are added up.
+    struct ProfileZoneStat
+    {
+        const char *name;
+        uint32_t minDepth;
+        uint32_t callCount;
+        uint64_t totalTime;
+        uint64_t maxTime;
+
+        ProfileZoneStat(const char *name = nullptr
+            , uint32_t minDepth = 0u
+            , uint32_t callCount = 0u
+            , uint64_t totalTime = 0u
+            , uint64_t maxTime = 0u
+            );
+    };
+
+    /*Every thread writes ended zones into a ring buffer of its own, old events are overwritten when it is full,
+      so the cost of a zone is two clock reads and one write of the buffer. The buffer of a thread is locked
+      only by the thread and by reading functions, so the lock is almost never contended.*/
+    class Profiler
+    {
+    public:
+        static const uint32_t DEFAULT_THREAD_EVENT_CAPACITY;
+
+        Profiler(uint32_t threadEventCapacity = DEFAULT_THREAD_EVENT_CAPACITY);
+        Profiler(const Profiler &) = delete;
+        Profiler& operator=(const Profiler &) = delete;
+
+        //It should be changed between frames, zones begun when it is disabled are not recorded.
+        void setEnable(Bool32 value);
+        Bool32 getEnable() const;
+        uint64_t getTime() const;
+
+        void beginZone(const char *name);
+        //It ends the last begun zone of the calling thread.
+        void endZone();
+
+        void beginFrame();
+        //Zones of the frame in all threads are aggregated into stats of the last frame.
+        void endFrame();
+        uint64_t getFrameIndex() const;
+        uint64_t getLastFrameTime() const;
+        //It is always 0 when allocations aren't counted.
+        uint64_t getLastFrameAllocationCount() const;
+        //Zones with same name in all threads are merged, names are compared as pointers of literals.
+        const std::vector<ProfileZoneStat> &getLastFrameStats() const;
+
+        //Recorded events of all threads, events of a thread are in order of ending.
+        std::vector<ProfileEvent> collectEvents() const;
+        //Chrome trace event format, it can be opened with chrome://tracing or Perfetto.
+        void exportChromeTrace(std::ostream &stream) const;
+        Bool32 saveChromeTrace(const std::string &path) const;
+        void clear();
+    private:
+        struct _OpenZone
+        {
+            const char *name;
+            uint64_t beginTime;
+            uint64_t frameIndex;
+        };
+
+        struct _ThreadBuffer
+        {
+            std::thread::id threadID;
+            uint32_t threadIndex;
+            std::mutex mutex;
+            std::vector<ProfileEvent> events;
+            uint64_t writeCount;
+            std::vector<_OpenZone> openZones;
+        };
+
+        uint32_t m_threadEventCapacity;
+        std::chrono::steady_clock::time_point m_startTime;
+        std::atomic<Bool32> m_isEnable;
+        std::atomic<uint64_t> m_frameIndex;
+        uint64_t m_frameBeginTime;
+        uint64_t m_lastFrameTime;
+        uint64_t m_frameBeginAllocationCount;
+        uint64_t m_lastFrameAllocationCount;
+        //Stats of all zones seen, they are kept across frames, so a steady frame doesn't allocate.
+        std::vector<ProfileZoneStat> m_zoneStats;
+        std::unordered_map<const char *, uint32_t> m_statIndices;
+        std::vector<ProfileZoneStat> m_lastFrameStats;
+        mutable std::mutex m_threadBuffersMutex;
+        std::vector<std::unique_ptr<_ThreadBuffer>> m_threadBuffers;
+
+        _ThreadBuffer *_getThreadBuffer();
+    };
+
+    class ProfileZone
+    {
+    public:
+        ProfileZone(const char *name);
+        ~ProfileZone();
+        ProfileZone(const ProfileZone &) = delete;
+        ProfileZone& operator=(const ProfileZone &) = delete;
+    private:
+        Bool32 m_isBegun;
+    };
+
+    //The profiler used by the macros, it is created when it is first used.
+    extern Profiler &getDefaultProfiler();
+
+    //It is called by allocation functions defined with FD_DEFINE_ALLOCATION_COUNTING_NEW, it never allocates.
+    extern void countAllocation();
+    //Count of allocations of all threads since the program is started.
+    extern uint64_t getAllocationCount();
+} //fd
+
+#endif //FD_PROFILER_HPP
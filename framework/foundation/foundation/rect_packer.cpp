@@ -0,0 +1,151 @@
+#include "foundation/rect_packer.hpp"
+
+#include <algorithm>
+
+namespace fd
+{
+    SkylinePacker::Rect::Rect(uint32_t x
+        , uint32_t y
+        , uint32_t width
+        , uint32_t height
+        )
+        : x(x)
+        , y(y)
+        , width(width)
+        , height(height)
+    {
+
+    }
+
+    SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+        : m_width()
+        , m_height()
+        , m_usedArea()
+        , m_skyline()
+    {
+        reset(width, height);
+    }
+
+    void SkylinePacker::reset(uint32_t width, uint32_t height)
+    {
+        m_width = width;
+        m_height = height;
+        m_usedArea = 0u;
+        m_skyline.clear();
+        if (width != 0u) m_skyline.push_back({0u, 0u, width});
+    }
+
+    Bool32 SkylinePacker::pack(uint32_t width, uint32_t height, Rect &result)
+    {
+        if (width == 0u || height == 0u) return FD_FALSE;
+        uint32_t bestIndex = 0u;
+        uint32_t bestTop = UINT32_MAX;
+        uint64_t bestWastedArea = UINT64_MAX;
+        uint32_t bestY = 0u;
+        Bool32 isFound = FD_FALSE;
+        uint32_t nodeCount = static_cast<uint32_t>(m_skyline.size());
+        for (uint32_t i = 0u; i < nodeCount; ++i)
+        {
+            uint32_t y;
+            uint64_t wastedArea;
+            if (_fit(i, width, height, y, wastedArea) == FD_FALSE) continue;
+            uint32_t top = y + height;
+            if (top < bestTop || (top == bestTop && wastedArea < bestWastedArea))
+            {
+                bestIndex = i;
+                bestTop = top;
+                bestWastedArea = wastedArea;
+                bestY = y;
+                isFound = FD_TRUE;
+            }
+        }
+        if (isFound == FD_FALSE) return FD_FALSE;
+        result = Rect(m_skyline[bestIndex].x, bestY, width, height);
+        _addSkylineLevel(bestIndex, result);
+        m_usedArea += static_cast<uint64_t>(width) * height;
+        return FD_TRUE;
+    }
+
+    uint32_t SkylinePacker::getWidth() const
+    {
+        return m_width;
+    }
+
+    uint32_t SkylinePacker::getHeight() const
+    {
+        return m_height;
+    }
+
+    float SkylinePacker::getOccupancy() const
+    {
+        uint64_t area = static_cast<uint64_t>(m_width) * m_height;
+        return area != 0u ? static_cast<float>(static_cast<double>(m_usedArea) / static_cast<double>(area)) : 0.0f;
+    }
+
+    Bool32 SkylinePacker::_fit(uint32_t nodeIndex, uint32_t width, uint32_t height, uint32_t &y, uint64_t &wastedArea) const
+    {
+        uint32_t x = m_skyline[nodeIndex].x;
+        if (x + width > m_width) return FD_FALSE;
+        y = 0u;
+        uint32_t remainingWidth = width;
+        uint32_t index = nodeIndex;
+        while (remainingWidth > 0u)
+        {
+            y = std::max(y, m_skyline[index].y);
+            if (y + height > m_height) return FD_FALSE;
+            uint32_t usedWidth = std::min(remainingWidth, m_skyline[index].width);
+            remainingWidth -= usedWidth;
+            ++index;
+        }
+
+        //Area between the bottom of the rectangle and the skyline.
+        wastedArea = 0u;
+        remainingWidth = width;
+        index = nodeIndex;
+        while (remainingWidth > 0u)
+        {
+            uint32_t usedWidth = std::min(remainingWidth, m_skyline[index].width);
+            wastedArea += static_cast<uint64_t>(y - m_skyline[index].y) * usedWidth;
+            remainingWidth -= usedWidth;
+            ++index;
+        }
+        return FD_TRUE;
+    }
+
+    void SkylinePacker::_addSkylineLevel(uint32_t nodeIndex, const Rect &rect)
+    {
+        _Node node = {rect.x, rect.y + rect.height, rect.width};
+        m_skyline.insert(m_skyline.begin() + nodeIndex, node);
+
+        //Nodes covered by the new node are shrunk or removed.
+        uint32_t right = rect.x + rect.width;
+        for (uint32_t i = nodeIndex + 1u; i < m_skyline.size();)
+        {
+            auto &current = m_skyline[i];
+            if (current.x >= right) break;
+            uint32_t currentRight = current.x + current.width;
+            if (currentRight <= right)
+            {
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+            current.width = currentRight - right;
+            current.x = right;
+            break;
+        }
+
+        //Neighbour nodes with same height are merged.
+        for (uint32_t i = 0u; i + 1u < m_skyline.size();)
+        {
+            if (m_skyline[i].y == m_skyline[i + 1u].y)
+            {
+                m_skyline[i].width += m_skyline[i + 1u].width;
+                m_skyline.erase(m_skyline.begin() + i + 1u);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+} //fd
@@ -0,0 +1,60 @@
+#ifndef FD_RECT_PACKER_H
+#define FD_RECT_PACKER_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    /*Pack rectangles into a bin with a skyline, every rectangle is put at the position of the skyline
+      where its top is lowest, and the position wasting least area below it is chosen for ties.
+      Rectangles aren't rotated.*/
+    class SkylinePacker
+    {
+    public:
+        struct Rect
+        {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+            uint32_t height;
+
+            Rect(uint32_t x = 0u
+                , uint32_t y = 0u
+                , uint32_t width = 0u
+                , uint32_t height = 0u
+                );
+        };
+
+        SkylinePacker(uint32_t width = 0u, uint32_t height = 0u);
+
+        void reset(uint32_t width, uint32_t height);
+        //It returns false when the rectangle can't be put into the bin.
+        Bool32 pack(uint32_t width, uint32_t height, Rect &result);
+
+        uint32_t getWidth() const;
+        uint32_t getHeight() const;
+        //Ratio of area of packed rectangles to area of the bin.
+        float getOccupancy() const;
+    private:
+        struct _Node
+        {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+        };
+
+        uint32_t m_width;
+        uint32_t m_height;
+        uint64_t m_usedArea;
+        std::vector<_Node> m_skyline;
+
+        /*Top of the rectangle when it is put at the node, it is got with the highest node under it.
+          It returns false when the rectangle is out of the bin.*/
+        Bool32 _fit(uint32_t nodeIndex, uint32_t width, uint32_t height, uint32_t &y, uint64_t &wastedArea) const;
+        void _addSkylineLevel(uint32_t nodeIndex, const Rect &rect);
+    };
+} //fd
+
+#endif //FD_RECT_PACKER_H
@@ -0,0 +1,476 @@
+#include "foundation/texture_compression.hpp"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "foundation/thread_pool.hpp"
+
+namespace fd
+{
+    static const uint32_t BLOCK_EXTENT = 4u;
+    static const uint32_t BLOCK_PIXEL_COUNT = 16u;
+
+    uint32_t getBlockByteSize(BlockFormat format)
+    {
+        return format == BlockFormat::BC1 || format == BlockFormat::BC1_RGB || format == BlockFormat::BC4 ? 8u : 16u;
+    }
+
+    uint32_t getBlockFormatChannelCount(BlockFormat format)
+    {
+        switch (format)
+        {
+        case BlockFormat::BC4:
+            return 1u;
+        case BlockFormat::BC5:
+            return 2u;
+        default:
+            return 4u;
+        }
+    }
+
+    uint32_t getBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height)
+    {
+        return ((width + BLOCK_EXTENT - 1u) / BLOCK_EXTENT) * ((height + BLOCK_EXTENT - 1u) / BLOCK_EXTENT) *
+            getBlockByteSize(format);
+    }
+
+    inline static void _writeUint16(uint8_t *p, uint16_t value)
+    {
+        p[0] = static_cast<uint8_t>(value & 0xffu);
+        p[1] = static_cast<uint8_t>(value >> 8u);
+    }
+
+    inline static uint16_t _readUint16(const uint8_t *p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8u));
+    }
+
+    inline static uint16_t _packColor565(const float *pColor)
+    {
+        auto quantize = [](float value, float maxValue) {
+            float result = std::round(value * maxValue / 255.0f);
+            return static_cast<uint32_t>(std::min(std::max(result, 0.0f), maxValue));
+        };
+        return static_cast<uint16_t>((quantize(pColor[0], 31.0f) << 11u) |
+            (quantize(pColor[1], 63.0f) << 5u) |
+            quantize(pColor[2], 31.0f));
+    }
+
+    inline static void _unpackColor565(uint16_t color, uint8_t *pColor)
+    {
+        uint32_t r = (color >> 11u) & 0x1fu;
+        uint32_t g = (color >> 5u) & 0x3fu;
+        uint32_t b = color & 0x1fu;
+        pColor[0] = static_cast<uint8_t>((r << 3u) | (r >> 2u));
+        pColor[1] = static_cast<uint8_t>((g << 2u) | (g >> 4u));
+        pColor[2] = static_cast<uint8_t>((b << 3u) | (b >> 2u));
+        pColor[3] = 255u;
+    }
+
+    //Three color mode with a transparent black color is only used by BC1 when color0 isn't greater than color1.
+    static void _getColorPalette(uint16_t color0, uint16_t color1, Bool32 isAllowThreeColor, uint8_t palette[4][4])
+    {
+        _unpackColor565(color0, palette[0]);
+        _unpackColor565(color1, palette[1]);
+        if (color0 > color1 || isAllowThreeColor == FD_FALSE)
+        {
+            for (uint32_t c = 0; c < 3u; ++c)
+            {
+                palette[2][c] = static_cast<uint8_t>((2u * palette[0][c] + palette[1][c]) / 3u);
+                palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2u * palette[1][c]) / 3u);
+            }
+            palette[2][3] = 255u;
+            palette[3][3] = 255u;
+        }
+        else
+        {
+            for (uint32_t c = 0; c < 3u; ++c)
+            {
+                palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2u);
+                palette[3][c] = 0u;
+            }
+            palette[2][3] = 255u;
+            palette[3][3] = 0u;
+        }
+    }
+
+    //Select the nearest palette color of every pixel, return the squared error.
+    static uint32_t _fitColorIndices(const uint8_t *pPixels, uint16_t color0, uint16_t color1, uint32_t &indices)
+    {
+        uint8_t palette[4][4];
+        _getColorPalette(color0, color1, FD_FALSE, palette);
+        uint32_t totalError = 0u;
+        indices = 0u;
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            const uint8_t *pPixel = pPixels + i * 4u;
+            uint32_t minError = UINT32_MAX;
+            uint32_t index = 0u;
+            for (uint32_t j = 0; j < 4u; ++j)
+            {
+                uint32_t error = 0u;
+                for (uint32_t c = 0; c < 3u; ++c)
+                {
+                    int32_t diff = static_cast<int32_t>(pPixel[c]) - static_cast<int32_t>(palette[j][c]);
+                    error += static_cast<uint32_t>(diff * diff);
+                }
+                if (error < minError)
+                {
+                    minError = error;
+                    index = j;
+                }
+            }
+            indices |= index << (i * 2u);
+            totalError += minError;
+        }
+        return totalError;
+    }
+
+    //Least squares endpoints for the selected indices, return false when the system is singular.
+    static Bool32 _refineColorEndpoints(const uint8_t *pPixels, uint32_t indices, uint16_t &color0, uint16_t &color1)
+    {
+        const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+        float aa = 0.0f;
+        float ab = 0.0f;
+        float bb = 0.0f;
+        float ax[3] = {0.0f, 0.0f, 0.0f};
+        float bx[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            float a = weights[(indices >> (i * 2u)) & 0x3u];
+            float b = 1.0f - a;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (uint32_t c = 0; c < 3u; ++c)
+            {
+                ax[c] += a * pPixels[i * 4u + c];
+                bx[c] += b * pPixels[i * 4u + c];
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::abs(det) < 0.0001f) return FD_FALSE;
+        float endpoint0[3];
+        float endpoint1[3];
+        for (uint32_t c = 0; c < 3u; ++c)
+        {
+            endpoint0[c] = (bb * ax[c] - ab * bx[c]) / det;
+            endpoint1[c] = (aa * bx[c] - ab * ax[c]) / det;
+        }
+        color0 = _packColor565(endpoint0);
+        color1 = _packColor565(endpoint1);
+        return FD_TRUE;
+    }
+
+    //Endpoints are on the principal axis of pixel colors, it always uses four color mode.
+    static void _compressColorBlock(const uint8_t *pPixels, uint8_t *pBlock)
+    {
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            for (uint32_t c = 0; c < 3u; ++c) mean[c] += pPixels[i * 4u + c];
+        }
+        for (uint32_t c = 0; c < 3u; ++c) mean[c] /= static_cast<float>(BLOCK_PIXEL_COUNT);
+
+        //xx, xy, xz, yy, yz, zz
+        float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            float r = pPixels[i * 4u] - mean[0];
+            float g = pPixels[i * 4u + 1u] - mean[1];
+            float b = pPixels[i * 4u + 2u] - mean[2];
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (uint32_t iteration = 0; iteration < 8u; ++iteration)
+        {
+            float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+            float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+            float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+            float maxComponent = std::max(std::abs(x), std::max(std::abs(y), std::abs(z)));
+            if (maxComponent == 0.0f) break;
+            axis[0] = x / maxComponent;
+            axis[1] = y / maxComponent;
+            axis[2] = z / maxComponent;
+        }
+        float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        for (uint32_t c = 0; c < 3u; ++c) axis[c] /= length;
+
+        float minT = FLT_MAX;
+        float maxT = -FLT_MAX;
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            float t = 0.0f;
+            for (uint32_t c = 0; c < 3u; ++c) t += (pPixels[i * 4u + c] - mean[c]) * axis[c];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+        //Inset the endpoints a little, extreme colors are rarely best after quantization.
+        float inset = (maxT - minT) / 16.0f;
+        float endpoint0[3];
+        float endpoint1[3];
+        for (uint32_t c = 0; c < 3u; ++c)
+        {
+            endpoint0[c] = mean[c] + axis[c] * (maxT - inset);
+            endpoint1[c] = mean[c] + axis[c] * (minT + inset);
+        }
+        uint16_t color0 = _packColor565(endpoint0);
+        uint16_t color1 = _packColor565(endpoint1);
+        uint32_t indices;
+        uint32_t error = _fitColorIndices(pPixels, color0, color1, indices);
+
+        uint16_t refinedColor0;
+        uint16_t refinedColor1;
+        if (error != 0u && _refineColorEndpoints(pPixels, indices, refinedColor0, refinedColor1))
+        {
+            uint32_t refinedIndices;
+            uint32_t refinedError = _fitColorIndices(pPixels, refinedColor0, refinedColor1, refinedIndices);
+            if (refinedError < error)
+            {
+                color0 = refinedColor0;
+                color1 = refinedColor1;
+                indices = refinedIndices;
+            }
+        }
+
+        //Four color mode needs color0 greater than color1, swapping endpoints swaps index 0 with 1 and 2 with 3.
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+            indices ^= 0x55555555u;
+        }
+        else if (color0 == color1)
+        {
+            indices = 0u;
+        }
+        _writeUint16(pBlock, color0);
+        _writeUint16(pBlock + 2u, color1);
+        for (uint32_t i = 0; i < 4u; ++i) pBlock[4u + i] = static_cast<uint8_t>((indices >> (i * 8u)) & 0xffu);
+    }
+
+    static void _decompressColorBlock(const uint8_t *pBlock, Bool32 isAllowThreeColor, uint8_t *pPixels)
+    {
+        uint16_t color0 = _readUint16(pBlock);
+        uint16_t color1 = _readUint16(pBlock + 2u);
+        uint8_t palette[4][4];
+        _getColorPalette(color0, color1, isAllowThreeColor, palette);
+        uint32_t indices = pBlock[4] | (pBlock[5] << 8u) | (pBlock[6] << 16u) | (static_cast<uint32_t>(pBlock[7]) << 24u);
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            const uint8_t *pColor = palette[(indices >> (i * 2u)) & 0x3u];
+            for (uint32_t c = 0; c < 4u; ++c) pPixels[i * 4u + c] = pColor[c];
+        }
+    }
+
+    static void _getChannelPalette(uint8_t value0, uint8_t value1, uint8_t palette[8])
+    {
+        palette[0] = value0;
+        palette[1] = value1;
+        if (value0 > value1)
+        {
+            for (uint32_t i = 1; i < 7u; ++i)
+            {
+                palette[i + 1u] = static_cast<uint8_t>(((7u - i) * value0 + i * value1) / 7u);
+            }
+        }
+        else
+        {
+            for (uint32_t i = 1; i < 5u; ++i)
+            {
+                palette[i + 1u] = static_cast<uint8_t>(((5u - i) * value0 + i * value1) / 5u);
+            }
+            palette[6] = 0u;
+            palette[7] = 255u;
+        }
+    }
+
+    //Single channel block of BC4 which is also alpha block of BC3 and a channel of BC5.
+    static void _compressChannelBlock(const uint8_t *pValues, uint32_t stride, uint8_t *pBlock)
+    {
+        uint8_t minValue = 255u;
+        uint8_t maxValue = 0u;
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            minValue = std::min(minValue, pValues[i * stride]);
+            maxValue = std::max(maxValue, pValues[i * stride]);
+        }
+        pBlock[0] = maxValue;
+        pBlock[1] = minValue;
+        uint64_t indices = 0u;
+        if (maxValue != minValue)
+        {
+            uint8_t palette[8];
+            _getChannelPalette(maxValue, minValue, palette);
+            for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+            {
+                int32_t value = pValues[i * stride];
+                int32_t minError = INT32_MAX;
+                uint64_t index = 0u;
+                for (uint32_t j = 0; j < 8u; ++j)
+                {
+                    int32_t error = std::abs(value - static_cast<int32_t>(palette[j]));
+                    if (error < minError)
+                    {
+                        minError = error;
+                        index = j;
+                    }
+                }
+                indices |= index << (i * 3u);
+            }
+        }
+        for (uint32_t i = 0; i < 6u; ++i) pBlock[2u + i] = static_cast<uint8_t>((indices >> (i * 8u)) & 0xffu);
+    }
+
+    static void _decompressChannelBlock(const uint8_t *pBlock, uint8_t *pValues, uint32_t stride)
+    {
+        uint8_t palette[8];
+        _getChannelPalette(pBlock[0], pBlock[1], palette);
+        uint64_t indices = 0u;
+        for (uint32_t i = 0; i < 6u; ++i) indices |= static_cast<uint64_t>(pBlock[2u + i]) << (i * 8u);
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            pValues[i * stride] = palette[(indices >> (i * 3u)) & 0x7u];
+        }
+    }
+
+    //Explicit 4 bits alpha of BC2.
+    static void _compressExplicitAlphaBlock(const uint8_t *pPixels, uint8_t *pBlock)
+    {
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; i += 2u)
+        {
+            uint32_t alpha0 = (pPixels[i * 4u + 3u] * 15u + 127u) / 255u;
+            uint32_t alpha1 = (pPixels[(i + 1u) * 4u + 3u] * 15u + 127u) / 255u;
+            pBlock[i / 2u] = static_cast<uint8_t>(alpha0 | (alpha1 << 4u));
+        }
+    }
+
+    static void _decompressExplicitAlphaBlock(const uint8_t *pBlock, uint8_t *pPixels)
+    {
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+            uint32_t alpha = (pBlock[i / 2u] >> ((i & 1u) * 4u)) & 0xfu;
+            pPixels[i * 4u + 3u] = static_cast<uint8_t>(alpha * 17u);
+        }
+    }
+
+    void compressBlocks(BlockFormat format
+        , const uint8_t *pPixels
+        , uint32_t width
+        , uint32_t height
+        , uint8_t *pBlocks
+        )
+    {
+        if (width == 0u || height == 0u) return;
+        uint32_t blockCountX = (width + BLOCK_EXTENT - 1u) / BLOCK_EXTENT;
+        uint32_t blockCountY = (height + BLOCK_EXTENT - 1u) / BLOCK_EXTENT;
+        uint32_t channelCount = getBlockFormatChannelCount(format);
+        uint32_t blockByteSize = getBlockByteSize(format);
+        getDefaultThreadPool().parallelFor(blockCountY, [=](uint32_t blockY) {
+            uint8_t blockPixels[BLOCK_PIXEL_COUNT * 4u];
+            for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+            {
+                for (uint32_t y = 0; y < BLOCK_EXTENT; ++y)
+                {
+                    uint32_t srcY = std::min(blockY * BLOCK_EXTENT + y, height - 1u);
+                    for (uint32_t x = 0; x < BLOCK_EXTENT; ++x)
+                    {
+                        uint32_t srcX = std::min(blockX * BLOCK_EXTENT + x, width - 1u);
+                        const uint8_t *pSrc = pPixels + (srcY * width + srcX) * channelCount;
+                        uint8_t *pDst = blockPixels + (y * BLOCK_EXTENT + x) * channelCount;
+                        for (uint32_t c = 0; c < channelCount; ++c) pDst[c] = pSrc[c];
+                    }
+                }
+                uint8_t *pBlock = pBlocks + (blockY * blockCountX + blockX) * blockByteSize;
+                switch (format)
+                {
+                case BlockFormat::BC1:
+                case BlockFormat::BC1_RGB:
+                    _compressColorBlock(blockPixels, pBlock);
+                    break;
+                case BlockFormat::BC2:
+                    _compressExplicitAlphaBlock(blockPixels, pBlock);
+                    _compressColorBlock(blockPixels, pBlock + 8u);
+                    break;
+                case BlockFormat::BC3:
+                    _compressChannelBlock(blockPixels + 3u, 4u, pBlock);
+                    _compressColorBlock(blockPixels, pBlock + 8u);
+                    break;
+                case BlockFormat::BC4:
+                    _compressChannelBlock(blockPixels, 1u, pBlock);
+                    break;
+                case BlockFormat::BC5:
+                    _compressChannelBlock(blockPixels, 2u, pBlock);
+                    _compressChannelBlock(blockPixels + 1u, 2u, pBlock + 8u);
+                    break;
+                default:
+                    break;
+                }
+            }
+        });
+    }
+
+    void decompressBlocks(BlockFormat format
+        , const uint8_t *pBlocks
+        , uint32_t width
+        , uint32_t height
+        , uint8_t *pPixels
+        )
+    {
+        if (width == 0u || height == 0u) return;
+        uint32_t blockCountX = (width + BLOCK_EXTENT - 1u) / BLOCK_EXTENT;
+        uint32_t blockCountY = (height + BLOCK_EXTENT - 1u) / BLOCK_EXTENT;
+        uint32_t channelCount = getBlockFormatChannelCount(format);
+        uint32_t blockByteSize = getBlockByteSize(format);
+        getDefaultThreadPool().parallelFor(blockCountY, [=](uint32_t blockY) {
+            uint8_t blockPixels[BLOCK_PIXEL_COUNT * 4u];
+            for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+            {
+                const uint8_t *pBlock = pBlocks + (blockY * blockCountX + blockX) * blockByteSize;
+                switch (format)
+                {
+                case BlockFormat::BC1:
+                    _decompressColorBlock(pBlock, FD_TRUE, blockPixels);
+                    break;
+                case BlockFormat::BC1_RGB:
+                    _decompressColorBlock(pBlock, FD_TRUE, blockPixels);
+                    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i) blockPixels[i * 4u + 3u] = 255u;
+                    break;
+                case BlockFormat::BC2:
+                    _decompressColorBlock(pBlock + 8u, FD_FALSE, blockPixels);
+                    _decompressExplicitAlphaBlock(pBlock, blockPixels);
+                    break;
+                case BlockFormat::BC3:
+                    _decompressColorBlock(pBlock + 8u, FD_FALSE, blockPixels);
+                    _decompressChannelBlock(pBlock, blockPixels + 3u, 4u);
+                    break;
+                case BlockFormat::BC4:
+                    _decompressChannelBlock(pBlock, blockPixels, 1u);
+                    break;
+                case BlockFormat::BC5:
+                    _decompressChannelBlock(pBlock, blockPixels, 2u);
+                    _decompressChannelBlock(pBlock + 8u, blockPixels + 1u, 2u);
+                    break;
+                default:
+                    break;
+                }
+                uint32_t extentX = std::min(BLOCK_EXTENT, width - blockX * BLOCK_EXTENT);
+                uint32_t extentY = std::min(BLOCK_EXTENT, height - blockY * BLOCK_EXTENT);
+                for (uint32_t y = 0; y < extentY; ++y)
+                {
+                    for (uint32_t x = 0; x < extentX; ++x)
+                    {
+                        const uint8_t *pSrc = blockPixels + (y * BLOCK_EXTENT + x) * channelCount;
+                        uint8_t *pDst = pPixels + ((blockY * BLOCK_EXTENT + y) * width + blockX * BLOCK_EXTENT + x) * channelCount;
+                        for (uint32_t c = 0; c < channelCount; ++c) pDst[c] = pSrc[c];
+                    }
+                }
+            }
+        });
+    }
+} //fd
@@ -0,0 +1,48 @@
+#ifndef FD_TEXTURE_COMPRESSION_H
+#define FD_TEXTURE_COMPRESSION_H
+
+#include <cstdint>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    /*Block compression formats which can be encoded and decoded on CPU, every block has 4 x 4 pixels.
+      Pixels of BC1, BC2 and BC3 are RGBA8, pixels of BC4 are R8 and pixels of BC5 are RG8.
+      BC1_RGB has same blocks as BC1, but its pixels are always opaque, so the fourth color
+      of three color mode is opaque black instead of transparent black.*/
+    enum class BlockFormat
+    {
+        BC1,
+        BC1_RGB,
+        BC2,
+        BC3,
+        BC4,
+        BC5,
+        BEGIN_RANGE = BC1,
+        END_RANGE = BC5,
+        RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+    };
+
+    extern uint32_t getBlockByteSize(BlockFormat format);
+    extern uint32_t getBlockFormatChannelCount(BlockFormat format);
+    extern uint32_t getBlockCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+    /*Encode the pixels to blocks, pixels out of the image in edge blocks are copies of edge pixels.
+      Color of BC1 is always opaque. Rows of blocks are encoded by the default thread pool.*/
+    extern void compressBlocks(BlockFormat format
+        , const uint8_t *pPixels
+        , uint32_t width
+        , uint32_t height
+        , uint8_t *pBlocks
+        );
+
+    /*Decode the blocks to pixels, it is the fallback when the device doesn't support the format.*/
+    extern void decompressBlocks(BlockFormat format
+        , const uint8_t *pBlocks
+        , uint32_t width
+        , uint32_t height
+        , uint8_t *pPixels
+        );
+} //fd
+
+#endif //FD_TEXTURE_COMPRESSION_H
@@ -0,0 +1,310 @@
+#include "foundation/texture_streaming.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace fd
+{
+    float caculateUVDensity(const float *pPositions
+        , uint32_t positionStride
+        , const float *pUVs
+        , uint32_t uvStride
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        )
+    {
+        auto getPosition = [pPositions, positionStride](uint32_t vertex)
+        {
+            return reinterpret_cast<const float *>(reinterpret_cast<const char *>(pPositions) + vertex * positionStride);
+        };
+        auto getUV = [pUVs, uvStride](uint32_t vertex)
+        {
+            return reinterpret_cast<const float *>(reinterpret_cast<const char *>(pUVs) + vertex * uvStride);
+        };
+        double worldArea = 0.0;
+        double uvArea = 0.0;
+        for (uint32_t i = 0; i + 2u < indexCount; i += 3u)
+        {
+            const float *p0 = getPosition(pIndices[i]);
+            const float *p1 = getPosition(pIndices[i + 1u]);
+            const float *p2 = getPosition(pIndices[i + 2u]);
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float cross[3] = {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0],
+            };
+            worldArea += 0.5 * std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+            const float *uv0 = getUV(pIndices[i]);
+            const float *uv1 = getUV(pIndices[i + 1u]);
+            const float *uv2 = getUV(pIndices[i + 2u]);
+            uvArea += 0.5 * std::abs((uv1[0] - uv0[0]) * (uv2[1] - uv0[1]) - (uv2[0] - uv0[0]) * (uv1[1] - uv0[1]));
+        }
+        if (worldArea <= 0.0) return 0.0f;
+        return static_cast<float>(std::sqrt(uvArea / worldArea));
+    }
+
+    uint32_t caculateStreamingMipLevel(uint32_t textureSize
+        , uint32_t mipLevelCount
+        , float uvDensity
+        , float pixelsPerWorldUnit
+        )
+    {
+        if (mipLevelCount == 0u) return 0u;
+        uint32_t lastLevel = mipLevelCount - 1u;
+        float texelsPerWorldUnit = static_cast<float>(textureSize) * uvDensity;
+        if (pixelsPerWorldUnit <= 0.0f || texelsPerWorldUnit <= 0.0f) return lastLevel;
+        float level = std::floor(std::log2(texelsPerWorldUnit / pixelsPerWorldUnit));
+        if (level <= 0.0f) return 0u;
+        if (level >= static_cast<float>(lastLevel)) return lastLevel;
+        return static_cast<uint32_t>(level);
+    }
+
+    TextureResidency::Change::Change(uint32_t textureIndex
+        , uint32_t residentLevel
+        )
+        : textureIndex(textureIndex)
+        , residentLevel(residentLevel)
+    {
+
+    }
+
+    TextureResidency::_Texture::_Texture()
+        : levelSizes()
+        , mipTailLevel(0u)
+        , residentLevel(0u)
+        , requestedLevel(0u)
+        , lastRequestedFrame(0u)
+        , isRequested(FD_FALSE)
+        , isUsing(FD_FALSE)
+    {
+
+    }
+
+    TextureResidency::TextureResidency(uint64_t memoryBudget
+        , uint32_t maxLoadCountPerUpdate
+        )
+        : m_memoryBudget(memoryBudget)
+        , m_maxLoadCountPerUpdate(maxLoadCountPerUpdate)
+        , m_frameIndex(0u)
+        , m_residentSize(0u)
+        , m_textures()
+        , m_freeIndices()
+    {
+
+    }
+
+    uint32_t TextureResidency::addTexture(const uint64_t *pMipSizes
+        , uint32_t mipLevelCount
+        , uint32_t mipTailLevel
+        )
+    {
+#ifdef DEBUG
+        if (mipLevelCount == 0u)
+            throw std::invalid_argument("Mip level count of the streaming texture should be greater than 0.");
+#endif //DEBUG
+        uint32_t textureIndex;
+        if (m_freeIndices.size())
+        {
+            textureIndex = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else
+        {
+            textureIndex = static_cast<uint32_t>(m_textures.size());
+            m_textures.resize(m_textures.size() + 1u);
+        }
+        auto &texture = m_textures[textureIndex];
+        texture.levelSizes.resize(mipLevelCount);
+        uint64_t size = 0u;
+        for (uint32_t level = mipLevelCount; level > 0u; --level)
+        {
+            size += pMipSizes[level - 1u];
+            texture.levelSizes[level - 1u] = size;
+        }
+        texture.mipTailLevel = std::min(mipTailLevel, mipLevelCount - 1u);
+        texture.residentLevel = texture.mipTailLevel;
+        texture.requestedLevel = texture.mipTailLevel;
+        texture.lastRequestedFrame = m_frameIndex;
+        texture.isRequested = FD_FALSE;
+        texture.isUsing = FD_TRUE;
+        m_residentSize += texture.levelSizes[texture.residentLevel];
+        return textureIndex;
+    }
+
+    void TextureResidency::removeTexture(uint32_t textureIndex)
+    {
+        auto &texture = m_textures[textureIndex];
+        if (texture.isUsing == FD_FALSE) return;
+        m_residentSize -= texture.levelSizes[texture.residentLevel];
+        texture = _Texture();
+        m_freeIndices.push_back(textureIndex);
+    }
+
+    void TextureResidency::request(uint32_t textureIndex, uint32_t mipLevel)
+    {
+        auto &texture = m_textures[textureIndex];
+        mipLevel = std::min(mipLevel, texture.mipTailLevel);
+        if (texture.isRequested == FD_FALSE || mipLevel < texture.requestedLevel)
+        {
+            texture.requestedLevel = mipLevel;
+        }
+        texture.isRequested = FD_TRUE;
+        texture.lastRequestedFrame = m_frameIndex;
+    }
+
+    void TextureResidency::update(std::vector<Change> &changes)
+    {
+        changes.clear();
+        //The budget may be decreased.
+        while (m_residentSize > m_memoryBudget && _evictOne(changes));
+
+        //Textures which need finer levels, the one missing more levels is loaded first.
+        std::vector<uint32_t> loadIndices;
+        uint32_t textureCount = static_cast<uint32_t>(m_textures.size());
+        for (uint32_t i = 0; i < textureCount; ++i)
+        {
+            const auto &texture = m_textures[i];
+            if (texture.isUsing && texture.isRequested && texture.requestedLevel < texture.residentLevel)
+            {
+                loadIndices.push_back(i);
+            }
+        }
+        std::stable_sort(loadIndices.begin(), loadIndices.end(), [this](uint32_t a, uint32_t b) {
+            const auto &textureA = m_textures[a];
+            const auto &textureB = m_textures[b];
+            return textureA.residentLevel - textureA.requestedLevel > textureB.residentLevel - textureB.requestedLevel;
+        });
+
+        uint32_t loadCount = 0u;
+        for (auto textureIndex : loadIndices)
+        {
+            if (m_maxLoadCountPerUpdate != 0u && loadCount == m_maxLoadCountPerUpdate) break;
+            auto &texture = m_textures[textureIndex];
+            uint64_t currSize = texture.levelSizes[texture.residentLevel];
+            while (m_residentSize - currSize + texture.levelSizes[texture.requestedLevel] > m_memoryBudget &&
+                _evictOne(changes));
+            //Load the finest level which fits the budget.
+            uint32_t level = texture.requestedLevel;
+            while (level < texture.residentLevel && m_residentSize - currSize + texture.levelSizes[level] > m_memoryBudget)
+            {
+                ++level;
+            }
+            if (level < texture.residentLevel)
+            {
+                _setResidentLevel(textureIndex, level, changes);
+                ++loadCount;
+            }
+        }
+
+        for (auto &texture : m_textures)
+        {
+            texture.isRequested = FD_FALSE;
+        }
+        ++m_frameIndex;
+    }
+
+    uint32_t TextureResidency::getResidentLevel(uint32_t textureIndex) const
+    {
+        return m_textures[textureIndex].residentLevel;
+    }
+
+    uint32_t TextureResidency::getMipTailLevel(uint32_t textureIndex) const
+    {
+        return m_textures[textureIndex].mipTailLevel;
+    }
+
+    uint64_t TextureResidency::getResidentSize(uint32_t textureIndex) const
+    {
+        const auto &texture = m_textures[textureIndex];
+        return texture.levelSizes[texture.residentLevel];
+    }
+
+    uint64_t TextureResidency::getResidentSize() const
+    {
+        return m_residentSize;
+    }
+
+    uint64_t TextureResidency::getMemoryBudget() const
+    {
+        return m_memoryBudget;
+    }
+
+    void TextureResidency::setMemoryBudget(uint64_t value)
+    {
+        m_memoryBudget = value;
+    }
+
+    uint32_t TextureResidency::getMaxLoadCountPerUpdate() const
+    {
+        return m_maxLoadCountPerUpdate;
+    }
+
+    void TextureResidency::setMaxLoadCountPerUpdate(uint32_t value)
+    {
+        m_maxLoadCountPerUpdate = value;
+    }
+
+    void TextureResidency::_setResidentLevel(uint32_t textureIndex, uint32_t level, std::vector<Change> &changes)
+    {
+        auto &texture = m_textures[textureIndex];
+        m_residentSize -= texture.levelSizes[texture.residentLevel];
+        m_residentSize += texture.levelSizes[level];
+        texture.residentLevel = level;
+        for (auto &change : changes)
+        {
+            if (change.textureIndex == textureIndex)
+            {
+                change.residentLevel = level;
+                return;
+            }
+        }
+        changes.push_back(Change(textureIndex, level));
+    }
+
+    Bool32 TextureResidency::_evictOne(std::vector<Change> &changes)
+    {
+        //Evict the least recently requested texture which isn't requested in this frame to its mip tail.
+        uint32_t textureCount = static_cast<uint32_t>(m_textures.size());
+        uint32_t victim = textureCount;
+        for (uint32_t i = 0; i < textureCount; ++i)
+        {
+            const auto &texture = m_textures[i];
+            if (texture.isUsing && texture.isRequested == FD_FALSE && texture.residentLevel < texture.mipTailLevel &&
+                (victim == textureCount || texture.lastRequestedFrame < m_textures[victim].lastRequestedFrame))
+            {
+                victim = i;
+            }
+        }
+        if (victim != textureCount)
+        {
+            _setResidentLevel(victim, m_textures[victim].mipTailLevel, changes);
+            return FD_TRUE;
+        }
+
+        //Trim the requested texture which has most memory of levels finer than its requested level.
+        uint64_t maxSize = 0u;
+        for (uint32_t i = 0; i < textureCount; ++i)
+        {
+            const auto &texture = m_textures[i];
+            if (texture.isUsing && texture.isRequested && texture.residentLevel < texture.requestedLevel)
+            {
+                uint64_t size = texture.levelSizes[texture.residentLevel] - texture.levelSizes[texture.requestedLevel];
+                if (size > maxSize)
+                {
+                    maxSize = size;
+                    victim = i;
+                }
+            }
+        }
+        if (victim != textureCount)
+        {
+            _setResidentLevel(victim, m_textures[victim].requestedLevel, changes);
+            return FD_TRUE;
+        }
+        return FD_FALSE;
+    }
+} //fd
@@ -0,0 +1,103 @@
+#ifndef FD_TEXTURE_STREAMING_H
+#define FD_TEXTURE_STREAMING_H
+
+#include <cstdint>
+#include <vector>
+#include "foundation/global.hpp"
+
+#define FD_TEXTURE_STREAMING_DEFAULT_MEMORY_BUDGET (256ull * 1024ull * 1024ull)
+#define FD_TEXTURE_STREAMING_DEFAULT_MAX_LOAD_COUNT 4u
+
+namespace fd
+{
+    /*Texture coordinate units per world unit of the triangle list, it is square root of the ratio of
+      total uv area to total world area. pPositions is array of 3 floats and pUVs is array of 2 floats,
+      with positionStride and uvStride bytes between vertices.*/
+    extern float caculateUVDensity(const float *pPositions
+        , uint32_t positionStride
+        , const float *pUVs
+        , uint32_t uvStride
+        , const uint32_t *pIndices
+        , uint32_t indexCount
+        );
+
+    /*The finest mip level needed when texels of the texture size along the uv density are shown with
+      pixelsPerWorldUnit pixels, it is clamped to [0, mipLevelCount - 1].*/
+    extern uint32_t caculateStreamingMipLevel(uint32_t textureSize
+        , uint32_t mipLevelCount
+        , float uvDensity
+        , float pixelsPerWorldUnit
+        );
+
+    /*Decide which mip levels of textures are resident. Levels from mip tail level to the last level are always
+      resident, finer levels are loaded when they are requested and evicted when the memory budget is exceeded,
+      textures which aren't requested for the longest time are evicted first.
+      Resident level of a texture is its finest resident mip level.*/
+    class TextureResidency
+    {
+    public:
+        struct Change
+        {
+            uint32_t textureIndex;
+            uint32_t residentLevel;
+
+            Change(uint32_t textureIndex = 0u
+                , uint32_t residentLevel = 0u
+                );
+        };
+
+        TextureResidency(uint64_t memoryBudget = FD_TEXTURE_STREAMING_DEFAULT_MEMORY_BUDGET
+            , uint32_t maxLoadCountPerUpdate = FD_TEXTURE_STREAMING_DEFAULT_MAX_LOAD_COUNT
+            );
+
+        /*pMipSizes is memory size of every mip level, the texture begins with its mip tail resident.
+          Return index of the texture, indices of removed textures are reused.*/
+        uint32_t addTexture(const uint64_t *pMipSizes
+            , uint32_t mipLevelCount
+            , uint32_t mipTailLevel
+            );
+        void removeTexture(uint32_t textureIndex);
+        //The finest requested level of the texture in current frame is kept.
+        void request(uint32_t textureIndex, uint32_t mipLevel);
+        /*Get resident level changes of this frame and go to next frame. At most max load count textures
+          become finer in one update, evictions to fit the budget are added to the changes before loads.*/
+        void update(std::vector<Change> &changes);
+
+        uint32_t getResidentLevel(uint32_t textureIndex) const;
+        uint32_t getMipTailLevel(uint32_t textureIndex) const;
+        uint64_t getResidentSize(uint32_t textureIndex) const;
+        //Total memory size of resident levels of all textures.
+        uint64_t getResidentSize() const;
+        uint64_t getMemoryBudget() const;
+        void setMemoryBudget(uint64_t value);
+        uint32_t getMaxLoadCountPerUpdate() const;
+        void setMaxLoadCountPerUpdate(uint32_t value);
+    private:
+        struct _Texture
+        {
+            //Memory size from the level to the last level.
+            std::vector<uint64_t> levelSizes;
+            uint32_t mipTailLevel;
+            uint32_t residentLevel;
+            uint32_t requestedLevel;
+            uint64_t lastRequestedFrame;
+            Bool32 isRequested;
+            Bool32 isUsing;
+
+            _Texture();
+        };
+
+        uint64_t m_memoryBudget;
+        uint32_t m_maxLoadCountPerUpdate;
+        uint64_t m_frameIndex;
+        uint64_t m_residentSize;
+        std::vector<_Texture> m_textures;
+        std::vector<uint32_t> m_freeIndices;
+
+        void _setResidentLevel(uint32_t textureIndex, uint32_t level, std::vector<Change> &changes);
+        //Free memory by evicting or trimming one texture, return false when nothing can be freed.
+        Bool32 _evictOne(std::vector<Change> &changes);
+    };
+} //fd
+
+#endif //FD_TEXTURE_STREAMING_H
@@ -0,0 +1,122 @@
+#include "foundation/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace fd
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+        : m_threads()
+        , m_tasks()
+        , m_mutex()
+        , m_condition()
+        , m_isStopping(FD_FALSE)
+    {
+        if (threadCount == 0u)
+        {
+            uint32_t hardwareCount = static_cast<uint32_t>(std::thread::hardware_concurrency());
+            threadCount = hardwareCount > 1u ? hardwareCount - 1u : 1u;
+        }
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back(&ThreadPool::_runWorker, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = FD_TRUE;
+        }
+        m_condition.notify_all();
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    uint32_t ThreadPool::getThreadCount() const
+    {
+        return static_cast<uint32_t>(m_threads.size());
+    }
+
+    void ThreadPool::addTask(const TaskType &task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(task);
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::parallelFor(uint32_t count, const ForTaskType &func)
+    {
+        if (count == 0u) return;
+        //State is shared with the tasks of workers, a worker may start its task after all indices are done.
+        struct ForState {
+            ForTaskType func;
+            uint32_t count;
+            std::atomic<uint32_t> nextIndex;
+            std::atomic<uint32_t> doneCount;
+            std::mutex mutex;
+            std::condition_variable condition;
+        };
+        auto pState = std::make_shared<ForState>();
+        pState->func = func;
+        pState->count = count;
+        pState->nextIndex = 0u;
+        pState->doneCount = 0u;
+
+        auto runIndices = [pState]() {
+            uint32_t index;
+            while ((index = pState->nextIndex.fetch_add(1u)) < pState->count)
+            {
+                pState->func(index);
+                if (pState->doneCount.fetch_add(1u) + 1u == pState->count)
+                {
+                    std::lock_guard<std::mutex> lock(pState->mutex);
+                    pState->condition.notify_all();
+                }
+            }
+        };
+
+        uint32_t taskCount = std::min(getThreadCount(), count - 1u);
+        for (uint32_t i = 0; i < taskCount; ++i)
+        {
+            addTask(runIndices);
+        }
+        runIndices();
+
+        std::unique_lock<std::mutex> lock(pState->mutex);
+        pState->condition.wait(lock, [&pState]() {
+            return pState->doneCount.load() == pState->count;
+        });
+    }
+
+    void ThreadPool::_runWorker()
+    {
+        while (true)
+        {
+            TaskType task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() {
+                    return m_isStopping == FD_TRUE || m_tasks.empty() == false;
+                });
+                if (m_isStopping == FD_TRUE && m_tasks.empty()) return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    ThreadPool &getDefaultThreadPool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+} //fd
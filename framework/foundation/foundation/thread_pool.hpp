@@ -0,0 +1,46 @@
+#ifndef FD_THREAD_POOL_H
+#define FD_THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    class ThreadPool
+    {
+    public:
+        using TaskType = std::function<void()>;
+        using ForTaskType = std::function<void(uint32_t index)>;
+
+        //Thread count 0 means that it uses hardware concurrency minus one, because the calling thread of
+        //parallelFor takes part in the work too.
+        ThreadPool(uint32_t threadCount = 0u);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool& operator=(const ThreadPool &) = delete;
+
+        uint32_t getThreadCount() const;
+        void addTask(const TaskType &task);
+        /*Call the function with every index in [0, count) and return after all calls are finished.
+          Indices are taken dynamically, so the calls of different indices shouldn't write same data.*/
+        void parallelFor(uint32_t count, const ForTaskType &func);
+    private:
+        std::vector<std::thread> m_threads;
+        std::deque<TaskType> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        Bool32 m_isStopping;
+
+        void _runWorker();
+    };
+
+    /*The pool shared by the loading and building code, it is created when it is first used.*/
+    extern ThreadPool &getDefaultThreadPool();
+} //fd
+
+#endif //FD_THREAD_POOL_H
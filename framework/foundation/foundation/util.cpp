@@ -1,2 +1,16 @@
 #include "foundation/util.hpp"
 
+namespace fd
+{
+    uint64_t hashBytes(const void *pData, uint32_t size, uint64_t seed)
+    {
+        uint64_t hash = seed;
+        const uint8_t *pBytes = static_cast<const uint8_t *>(pData);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            hash ^= pBytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+} //fd
@@ -2,6 +2,7 @@
 #define FD_UTIL_H
 
 #include <cstdint>
+#include <cstddef>
 #include <array>
 #include <vector>
 
@@ -236,5 +237,8 @@ namespace fd
         uint32_t  m_count;
         T *       m_ptr;
     };
+
+    /*FNV-1a hash of bytes, seed is the hash of previous bytes to hash discontinuous data.*/
+    extern uint64_t hashBytes(const void *pData, uint32_t size, uint64_t seed = 14695981039346656037ull);
 } // namespace fd
 #endif // !FD_UTIL_H
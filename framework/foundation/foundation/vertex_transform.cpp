@@ -0,0 +1,77 @@
+#include "foundation/vertex_transform.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FD_VERTEX_TRANSFORM_USE_SSE
+#endif
+
+namespace fd
+{
+    void transformVertices2(const void *pSrcVertices
+        , void *pDstVertices
+        , uint32_t vertexCount
+        , uint32_t vertexStride
+        , uint32_t positionOffset
+        , const glm::mat3 &matrix
+        )
+    {
+        if (vertexCount == 0u) return;
+        //Other attributes are copied with positions, then positions are overwritten.
+        memcpy(pDstVertices, pSrcVertices, static_cast<size_t>(vertexCount) * vertexStride);
+        const uint8_t *pSrc = static_cast<const uint8_t *>(pSrcVertices) + positionOffset;
+        uint8_t *pDst = static_cast<uint8_t *>(pDstVertices) + positionOffset;
+        uint32_t vertexIndex = 0u;
+#ifdef FD_VERTEX_TRANSFORM_USE_SSE
+        //Lanes are x and y of two positions.
+        __m128 column0 = _mm_setr_ps(matrix[0][0], matrix[0][1], matrix[0][0], matrix[0][1]);
+        __m128 column1 = _mm_setr_ps(matrix[1][0], matrix[1][1], matrix[1][0], matrix[1][1]);
+        __m128 column2 = _mm_setr_ps(matrix[2][0], matrix[2][1], matrix[2][0], matrix[2][1]);
+        for (; vertexIndex + 1u < vertexCount; vertexIndex += 2u)
+        {
+            const uint8_t *pSrc0 = pSrc + static_cast<size_t>(vertexIndex) * vertexStride;
+            const uint8_t *pSrc1 = pSrc0 + vertexStride;
+            __m128 positions = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(pSrc0)),
+                reinterpret_cast<const __m64 *>(pSrc1));
+            __m128 xs = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 ys = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, column0), _mm_mul_ps(ys, column1)), column2);
+            uint8_t *pDst0 = pDst + static_cast<size_t>(vertexIndex) * vertexStride;
+            _mm_storel_pi(reinterpret_cast<__m64 *>(pDst0), result);
+            _mm_storeh_pi(reinterpret_cast<__m64 *>(pDst0 + vertexStride), result);
+        }
+#endif //FD_VERTEX_TRANSFORM_USE_SSE
+        for (; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            float position[2];
+            memcpy(position, pSrc + static_cast<size_t>(vertexIndex) * vertexStride, sizeof(position));
+            float result[2] = {
+                matrix[0][0] * position[0] + matrix[1][0] * position[1] + matrix[2][0],
+                matrix[0][1] * position[0] + matrix[1][1] * position[1] + matrix[2][1],
+            };
+            memcpy(pDst + static_cast<size_t>(vertexIndex) * vertexStride, result, sizeof(result));
+        }
+    }
+
+    void offsetIndices(const uint32_t *pSrcIndices
+        , uint32_t *pDstIndices
+        , uint32_t indexCount
+        , uint32_t offset
+        )
+    {
+        uint32_t index = 0u;
+#ifdef FD_VERTEX_TRANSFORM_USE_SSE
+        __m128i offsets = _mm_set1_epi32(static_cast<int>(offset));
+        for (; index + 3u < indexCount; index += 4u)
+        {
+            __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrcIndices + index));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pDstIndices + index), _mm_add_epi32(indices, offsets));
+        }
+#endif //FD_VERTEX_TRANSFORM_USE_SSE
+        for (; index < indexCount; ++index)
+        {
+            pDstIndices[index] = pSrcIndices[index] + offset;
+        }
+    }
+} //fd
@@ -0,0 +1,28 @@
+#ifndef FD_VERTEX_TRANSFORM_HPP
+#define FD_VERTEX_TRANSFORM_HPP
+
+#include <cstdint>
+#include "foundation/global.hpp"
+
+namespace fd
+{
+    /*Copy vertices and transform their 2D positions with the affine matrix, position is two floats at the
+      offset of every vertex and other attributes are copied as they are. Source and destination shouldn't
+      overlap. Two positions are transformed at a time with SSE when it is available.*/
+    extern void transformVertices2(const void *pSrcVertices
+        , void *pDstVertices
+        , uint32_t vertexCount
+        , uint32_t vertexStride
+        , uint32_t positionOffset
+        , const glm::mat3 &matrix
+        );
+
+    //Copy indices and add the offset to them, it is used when vertices of meshes are put into one buffer.
+    extern void offsetIndices(const uint32_t *pSrcIndices
+        , uint32_t *pDstIndices
+        , uint32_t indexCount
+        , uint32_t offset
+        );
+} //fd
+
+#endif //FD_VERTEX_TRANSFORM_HPP
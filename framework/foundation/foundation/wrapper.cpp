@@ -231,4 +231,14 @@ namespace fd
             pDevice->destroyFence(*p);
         });
     }
+
+    std::shared_ptr<vk::QueryPool> createQueryPool(const vk::Device *pDevice,
+        const vk::QueryPoolCreateInfo &createInfo, vk::Optional<const vk::AllocationCallbacks> allocator)
+    {
+        auto queryPool = pDevice->createQueryPool(createInfo, allocator);
+        return std::shared_ptr<vk::QueryPool>(new vk::QueryPool(queryPool),
+            [pDevice](vk::QueryPool *p) {
+            pDevice->destroyQueryPool(*p);
+        });
+    }
 }
@@ -72,6 +72,9 @@ namespace fd
 
     extern std::shared_ptr<vk::Fence> createFence(const vk::Device *pDevice,
         const vk::FenceCreateInfo &createInfo, vk::Optional<const vk::AllocationCallbacks> allocator = nullptr);
+
+    extern std::shared_ptr<vk::QueryPool> createQueryPool(const vk::Device *pDevice,
+        const vk::QueryPoolCreateInfo &createInfo, vk::Optional<const vk::AllocationCallbacks> allocator = nullptr);
 }
 
 #endif // !FD_VK_WRAPPER_H
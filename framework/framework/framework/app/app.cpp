@@ -46,6 +46,7 @@ namespace vgf {
 
         while (m_pWindow->windowShouldClose() == VGF_FALSE)
         {
+            fd::getDefaultProfiler().beginFrame();
             glfwPollEvents();            
             //remove closed child(sub) windows.
             m_pSubWindows.erase(std::remove_if(m_pSubWindows.begin(), m_pSubWindows.end(), [](const std::shared_ptr<Window>& item) {
@@ -61,6 +62,9 @@ namespace vgf {
             //};
             //threadMaster.join();
 
+            //Geometry rebuilt in this frame is written to the next region of the transient buffer,
+            //windows share the buffer, so it moves once per frame.
+            vg::pDefaultTransientBuffer->beginFrame();
             //single thread.
             m_pWindow->run();
             for (const auto& pSubWindow : m_pSubWindows)
@@ -68,6 +72,7 @@ namespace vgf {
                 pSubWindow->run();
             };
             vg::pApp->getDevice()->waitIdle();
+            fd::getDefaultProfiler().endFrame();
         }
     }
 
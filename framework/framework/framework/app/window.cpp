@@ -80,6 +80,7 @@ namespace vgf {
     void Window::run()
     {
         VGF_LOG(plog::debug) << "Window run" << std::endl;
+        m_asyncLoader.update();
         _doUpdate();
         _doDraw();
     }
@@ -107,6 +108,11 @@ namespace vgf {
         return m_pWindow.get();
     }
 
+    AsyncLoader &Window::getAsyncLoader()
+    {
+        return m_asyncLoader;
+    }
+
     void Window::_createWindow(uint32_t width, uint32_t height, const char* title)
     {
         m_pWindow = createGLFWWindow(width, height, title);
@@ -5,6 +5,7 @@
 #include <vector>
 #include <mutex>
 #include "framework/global.hpp"
+#include "framework/util/async_loader.hpp"
 
 namespace vgf
 {
@@ -30,6 +31,8 @@ namespace vgf
         void Window::windowSetShouldClose(Bool32 value);
         vgf::Bool32 windowShouldClose();
         GLFWwindow *getGLFWWindow() const;
+        //Objects loaded by it are created at update of the window.
+        AsyncLoader &getAsyncLoader();
     protected:
         Window(const Window&) = delete;
 
@@ -52,6 +55,7 @@ namespace vgf
         vk::PipelineStageFlags m_renderWaitStageMask;
         std::shared_ptr<vk::Semaphore> m_pRenderFinishedSemaphore;        
         int32_t m_currImageIndex;
+        AsyncLoader m_asyncLoader;
 
         //std::mutex m_windowMutex;
 
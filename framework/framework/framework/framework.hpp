@@ -5,6 +5,7 @@
 #include "framework/module.hpp"
 #include "framework/app/app.hpp"
 #include "framework/app/window.hpp"
+#include "framework/util/async_loader.hpp"
 
 namespace vgf
 {
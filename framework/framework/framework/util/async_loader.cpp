@@ -0,0 +1,457 @@
+#include "framework/util/async_loader.hpp"
+
+#include <fstream>
+#include <fcntl.h>
+#include <gli/gli.hpp>
+
+namespace vgf
+{
+    AsyncLoader::MeshData::MeshData()
+        : positions()
+        , normals()
+        , textureCoordinates()
+        , colors()
+        , indices()
+        , topology(vg::PrimitiveTopology::TRIANGLE_LIST)
+    {
+    }
+
+    AsyncLoader::_Loading::_Loading()
+        : fileNames()
+        , fileDatas()
+        , readCount(0u)
+        , error()
+        , decode()
+        , create()
+        , fail()
+    {
+    }
+
+    AsyncLoader::AsyncLoader(uint32_t maxCreateCountPerUpdate)
+        : m_maxCreateCountPerUpdate(maxCreateCountPerUpdate)
+        , m_loadingCount(0u)
+        , m_workingCount(0u)
+        , m_decodedLoadings()
+        , m_mutex()
+        , m_condition()
+    {
+#ifdef USE_LIBUV
+        uv_loop_init(&m_loop);
+#endif //USE_LIBUV
+    }
+
+    AsyncLoader::~AsyncLoader()
+    {
+#ifdef USE_LIBUV
+        //Finish all file requests, decoding of read files is added to workers by their callbacks.
+        uv_run(&m_loop, UV_RUN_DEFAULT);
+#endif //USE_LIBUV
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() {
+                return m_workingCount == 0u;
+            });
+        }
+#ifdef USE_LIBUV
+        uv_loop_close(&m_loop);
+#endif //USE_LIBUV
+    }
+
+    std::shared_ptr<AsyncHandle<vg::Shader>> AsyncLoader::loadShader(const std::string &vertShaderPath
+        , const std::string &fragShaderPath
+        )
+    {
+        struct ShaderCode {
+            std::vector<char> vertCode;
+            std::vector<char> fragCode;
+        };
+        return load<vg::Shader, ShaderCode>({vertShaderPath, fragShaderPath}
+            , [](std::vector<std::vector<char>> &fileDatas, ShaderCode &code) {
+                code.vertCode.swap(fileDatas[0]);
+                code.fragCode.swap(fileDatas[1]);
+            }
+            , [](ShaderCode &code) {
+                return std::make_shared<vg::Shader>(static_cast<const void *>(code.vertCode.data())
+                    , static_cast<uint32_t>(code.vertCode.size())
+                    , static_cast<const void *>(code.fragCode.data())
+                    , static_cast<uint32_t>(code.fragCode.size())
+                    );
+            });
+    }
+
+    std::shared_ptr<AsyncHandle<vg::Texture2D>> AsyncLoader::loadTexture2D(const std::string &fileName
+        , vk::Format format
+        )
+    {
+        struct TextureData {
+            gli::texture2d texture;
+            vk::Format format;
+            std::vector<vg::TextureDataInfo::Component> components;
+            //It isn't empty when the format isn't supported and the data is decoded on CPU.
+            std::vector<uint8_t> decodedMemory;
+        };
+        return load<vg::Texture2D, TextureData>({fileName}
+            , [fileName, format](std::vector<std::vector<char>> &fileDatas, TextureData &data) {
+                auto &texture = data.texture;
+                texture = gli::texture2d(gli::load(fileDatas[0].data(), fileDatas[0].size()));
+                if (texture.empty())
+                {
+                    throw std::runtime_error("Failed to decode texture: " + fileName);
+                }
+                //Formats of gli are same as formats of vulkan.
+                data.format = format != vk::Format::eUndefined ? format : static_cast<vk::Format>(texture.format());
+                uint32_t mipLevels = static_cast<uint32_t>(texture.levels());
+                auto &components = data.components;
+                components.resize(mipLevels);
+                for (uint32_t i = 0; i < mipLevels; ++i)
+                {
+                    components[i].mipLevel = i;
+                    components[i].baseArrayLayer = 0u;
+                    components[i].layerCount = 1u;
+                    components[i].size = static_cast<uint32_t>(texture[i].size());
+                    components[i].hasImageExtent = VG_TRUE;
+                    components[i].width = texture[i].extent().x;
+                    components[i].height = texture[i].extent().y;
+                    components[i].depth = 1u;
+                }
+
+                //Block compressed data is decoded in the worker when the device can't sample its format.
+                vg::TextureDataInfo textureLayout;
+                textureLayout.componentCount = static_cast<uint32_t>(components.size());
+                textureLayout.pComponent = components.data();
+                vk::Format decodedFormat;
+                std::vector<vg::TextureDataInfo::Component> decodedComponents;
+                if (vg::decodeUnsupportedTextureData(data.format
+                    , texture[0].extent().x
+                    , texture[0].extent().y
+                    , textureLayout
+                    , texture.data()
+                    , decodedFormat
+                    , decodedComponents
+                    , data.decodedMemory
+                    ))
+                {
+                    data.format = decodedFormat;
+                    data.components.swap(decodedComponents);
+                    texture = gli::texture2d();
+                }
+            }
+            , [](TextureData &data) {
+                const auto &components = data.components;
+                auto pTexture = std::make_shared<vg::Texture2D>(data.format, VG_TRUE,
+                    components[0].width,
+                    components[0].height
+                    );
+                vg::TextureDataInfo textureLayout;
+                textureLayout.componentCount = static_cast<uint32_t>(components.size());
+                textureLayout.pComponent = components.data();
+                if (data.decodedMemory.size() != 0u)
+                {
+                    pTexture->applyData(textureLayout, data.decodedMemory.data(),
+                        static_cast<uint32_t>(data.decodedMemory.size()));
+                }
+                else
+                {
+                    pTexture->applyData(textureLayout, data.texture.data(), static_cast<uint32_t>(data.texture.size()));
+                }
+                return pTexture;
+            });
+    }
+
+    std::shared_ptr<AsyncHandle<vg::DimSepMesh3>> AsyncLoader::loadSepMesh3(const std::string &fileName
+        , const MeshDecodeFunc &decodeFunc
+        )
+    {
+        return load<vg::DimSepMesh3, MeshData>({fileName}
+            , [decodeFunc](std::vector<std::vector<char>> &fileDatas, MeshData &meshData) {
+                decodeFunc(fileDatas[0], meshData);
+            }
+            , [](MeshData &meshData) {
+                auto pMesh = std::make_shared<vg::DimSepMesh3>();
+                pMesh->setVertexCount(static_cast<uint32_t>(meshData.positions.size()));
+                pMesh->addPositions(meshData.positions);
+                if (meshData.normals.size() != 0u) pMesh->addNormals(meshData.normals);
+                if (meshData.textureCoordinates.size() != 0u)
+                {
+                    pMesh->addTextureCoordinates<vg::TextureCoordinateType::VECTOR_2,
+                        vg::TextureCoordinateIndex::TextureCoordinate_0>(meshData.textureCoordinates);
+                }
+                if (meshData.colors.size() != 0u) pMesh->addColors(meshData.colors);
+                pMesh->setIndices(meshData.indices, meshData.topology, 0u);
+                pMesh->apply(VG_TRUE);
+                return pMesh;
+            });
+    }
+
+    void AsyncLoader::update()
+    {
+#ifdef USE_LIBUV
+        uv_run(&m_loop, UV_RUN_NOWAIT);
+#endif //USE_LIBUV
+        std::vector<std::shared_ptr<_Loading>> pLoadings;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (m_decodedLoadings.empty() == false &&
+                (m_maxCreateCountPerUpdate == 0u || pLoadings.size() < m_maxCreateCountPerUpdate))
+            {
+                pLoadings.push_back(m_decodedLoadings.front());
+                m_decodedLoadings.pop_front();
+            }
+        }
+        if (pLoadings.size() == 0u) return;
+
+        vg::beginSingleTimeCommandBatch();
+        for (const auto &pLoading : pLoadings)
+        {
+            if (pLoading->error.empty())
+            {
+                try
+                {
+                    pLoading->create();
+                }
+                catch (const std::exception &e)
+                {
+                    pLoading->error = e.what();
+                }
+            }
+            if (pLoading->error.empty() == false)
+            {
+                VGF_LOG(plog::error) << "Failed to load async: " << pLoading->error << std::endl;
+                pLoading->fail(pLoading->error);
+            }
+        }
+        vg::endSingleTimeCommandBatch();
+        m_loadingCount -= static_cast<uint32_t>(pLoadings.size());
+    }
+
+    uint32_t AsyncLoader::getMaxCreateCountPerUpdate() const
+    {
+        return m_maxCreateCountPerUpdate;
+    }
+
+    void AsyncLoader::setMaxCreateCountPerUpdate(uint32_t value)
+    {
+        m_maxCreateCountPerUpdate = value;
+    }
+
+    uint32_t AsyncLoader::getLoadingCount() const
+    {
+        return m_loadingCount;
+    }
+
+    void AsyncLoader::_startLoading(const std::shared_ptr<_Loading> &pLoading)
+    {
+        ++m_loadingCount;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_workingCount;
+        }
+        uint32_t fileCount = static_cast<uint32_t>(pLoading->fileNames.size());
+        pLoading->fileDatas.resize(fileCount);
+#ifdef USE_LIBUV
+        if (fileCount != 0u)
+        {
+            for (uint32_t i = 0; i < fileCount; ++i)
+            {
+                _readFile(pLoading, i);
+            }
+            return;
+        }
+#endif //USE_LIBUV
+        fd::getDefaultThreadPool().addTask([this, pLoading]() {
+#ifndef USE_LIBUV
+            uint32_t fileCount = static_cast<uint32_t>(pLoading->fileNames.size());
+            for (uint32_t i = 0; i < fileCount; ++i)
+            {
+                const auto &fileName = pLoading->fileNames[i];
+                std::ifstream file(fileName, std::ios::ate | std::ios::binary);
+                if (!file.is_open())
+                {
+                    pLoading->error = "Failed to open file: " + fileName;
+                    break;
+                }
+                size_t fileSize = static_cast<size_t>(file.tellg());
+                auto &fileData = pLoading->fileDatas[i];
+                fileData.resize(fileSize);
+                file.seekg(0);
+                file.read(fileData.data(), fileSize);
+            }
+            if (pLoading->error.empty())
+#endif //!USE_LIBUV
+            {
+                _decodeLoading(pLoading);
+            }
+            _finishWorking(pLoading);
+        });
+    }
+
+    void AsyncLoader::_decodeLoading(const std::shared_ptr<_Loading> &pLoading)
+    {
+        try
+        {
+            pLoading->create = pLoading->decode(pLoading->fileDatas);
+        }
+        catch (const std::exception &e)
+        {
+            pLoading->error = e.what();
+        }
+        pLoading->fileDatas.clear();
+        pLoading->fileDatas.shrink_to_fit();
+    }
+
+    void AsyncLoader::_finishWorking(const std::shared_ptr<_Loading> &pLoading)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decodedLoadings.push_back(pLoading);
+            --m_workingCount;
+        }
+        m_condition.notify_all();
+    }
+
+#ifdef USE_LIBUV
+    void AsyncLoader::_readFile(const std::shared_ptr<_Loading> &pLoading, uint32_t fileIndex)
+    {
+        _FileRead *pFileRead = new _FileRead();
+        pFileRead->req.data = pFileRead;
+        pFileRead->pLoader = this;
+        pFileRead->pLoading = pLoading;
+        pFileRead->fileIndex = fileIndex;
+        pFileRead->file = -1;
+        pFileRead->offset = 0u;
+        pFileRead->result = 0;
+        int result = uv_fs_open(&m_loop, &pFileRead->req, pLoading->fileNames[fileIndex].c_str(),
+            O_RDONLY, 0, _onFileOpened);
+        if (result < 0)
+        {
+            uv_fs_req_cleanup(&pFileRead->req);
+            _finishReadFile(pFileRead, result);
+        }
+    }
+
+    void AsyncLoader::_finishReadFile(_FileRead *pFileRead, int result)
+    {
+        auto pLoading = pFileRead->pLoading;
+        if (result < 0 && pLoading->error.empty())
+        {
+            pLoading->error = "Failed to read file: " + pLoading->fileNames[pFileRead->fileIndex] +
+                ", " + uv_strerror(result);
+        }
+        delete pFileRead;
+        if (++pLoading->readCount == static_cast<uint32_t>(pLoading->fileNames.size()))
+        {
+            if (pLoading->error.empty())
+            {
+                fd::getDefaultThreadPool().addTask([this, pLoading]() {
+                    _decodeLoading(pLoading);
+                    _finishWorking(pLoading);
+                });
+            }
+            else
+            {
+                _finishWorking(pLoading);
+            }
+        }
+    }
+
+    void AsyncLoader::_readFileData(_FileRead *pFileRead)
+    {
+        auto &fileData = pFileRead->pLoading->fileDatas[pFileRead->fileIndex];
+        uv_buf_t buffer = uv_buf_init(fileData.data() + pFileRead->offset,
+            static_cast<unsigned int>(fileData.size() - pFileRead->offset));
+        int result = uv_fs_read(&pFileRead->pLoader->m_loop, &pFileRead->req, pFileRead->file,
+            &buffer, 1u, static_cast<int64_t>(pFileRead->offset), _onFileRead);
+        if (result < 0)
+        {
+            uv_fs_req_cleanup(&pFileRead->req);
+            _closeFile(pFileRead, result);
+        }
+    }
+
+    void AsyncLoader::_closeFile(_FileRead *pFileRead, int result)
+    {
+        pFileRead->result = result;
+        int closeResult = uv_fs_close(&pFileRead->pLoader->m_loop, &pFileRead->req, pFileRead->file, _onFileClosed);
+        if (closeResult < 0)
+        {
+            uv_fs_req_cleanup(&pFileRead->req);
+            pFileRead->pLoader->_finishReadFile(pFileRead, result < 0 ? result : closeResult);
+        }
+    }
+
+    void AsyncLoader::_onFileOpened(uv_fs_t *pReq)
+    {
+        _FileRead *pFileRead = static_cast<_FileRead *>(pReq->data);
+        int result = static_cast<int>(pReq->result);
+        uv_fs_req_cleanup(pReq);
+        if (result < 0)
+        {
+            pFileRead->pLoader->_finishReadFile(pFileRead, result);
+            return;
+        }
+        pFileRead->file = static_cast<uv_file>(result);
+        result = uv_fs_fstat(&pFileRead->pLoader->m_loop, pReq, pFileRead->file, _onFileStated);
+        if (result < 0)
+        {
+            uv_fs_req_cleanup(pReq);
+            _closeFile(pFileRead, result);
+        }
+    }
+
+    void AsyncLoader::_onFileStated(uv_fs_t *pReq)
+    {
+        _FileRead *pFileRead = static_cast<_FileRead *>(pReq->data);
+        int result = static_cast<int>(pReq->result);
+        uint64_t fileSize = pReq->statbuf.st_size;
+        uv_fs_req_cleanup(pReq);
+        if (result < 0)
+        {
+            _closeFile(pFileRead, result);
+            return;
+        }
+        pFileRead->pLoading->fileDatas[pFileRead->fileIndex].resize(static_cast<size_t>(fileSize));
+        if (fileSize == 0u)
+        {
+            _closeFile(pFileRead, 0);
+            return;
+        }
+        _readFileData(pFileRead);
+    }
+
+    void AsyncLoader::_onFileRead(uv_fs_t *pReq)
+    {
+        _FileRead *pFileRead = static_cast<_FileRead *>(pReq->data);
+        ssize_t result = pReq->result;
+        uv_fs_req_cleanup(pReq);
+        auto &fileData = pFileRead->pLoading->fileDatas[pFileRead->fileIndex];
+        if (result < 0)
+        {
+            _closeFile(pFileRead, static_cast<int>(result));
+            return;
+        }
+        if (result == 0)
+        {
+            //The file is shorter than its stat size.
+            fileData.resize(static_cast<size_t>(pFileRead->offset));
+            _closeFile(pFileRead, 0);
+            return;
+        }
+        pFileRead->offset += static_cast<uint64_t>(result);
+        if (pFileRead->offset < static_cast<uint64_t>(fileData.size()))
+        {
+            _readFileData(pFileRead);
+        }
+        else
+        {
+            _closeFile(pFileRead, 0);
+        }
+    }
+
+    void AsyncLoader::_onFileClosed(uv_fs_t *pReq)
+    {
+        _FileRead *pFileRead = static_cast<_FileRead *>(pReq->data);
+        uv_fs_req_cleanup(pReq);
+        pFileRead->pLoader->_finishReadFile(pFileRead, pFileRead->result);
+    }
+#endif //USE_LIBUV
+} //namespace vgf
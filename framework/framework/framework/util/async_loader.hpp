@@ -0,0 +1,161 @@
+#ifndef VGF_ASYNC_LOADER_H
+#define VGF_ASYNC_LOADER_H
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "framework/global.hpp"
+
+#ifdef USE_LIBUV
+#include <uv.h>
+#endif //USE_LIBUV
+
+namespace vgf
+{
+    enum class AsyncLoadState
+    {
+        LOADING,
+        READY,
+        FAILED
+    };
+
+    /*It is like a future, the object can be bound only after its state is ready.*/
+    template <typename T>
+    class AsyncHandle
+    {
+    public:
+        AsyncHandle();
+        AsyncLoadState getState() const;
+        Bool32 getIsReady() const;
+        Bool32 getIsFailed() const;
+        //It is nullptr until the state is ready.
+        const std::shared_ptr<T> &get() const;
+        const std::string &getError() const;
+    private:
+        AsyncLoadState m_state;
+        std::shared_ptr<T> m_pObject;
+        std::string m_error;
+
+        friend class AsyncLoader;
+    };
+
+    /*Files are read in background (by the file system requests of libuv when it is used),
+      then decoded by workers of the default thread pool. Objects are created and their data
+      are uploaded in update at the main loop, with a limited count per update, and the uploads
+      of one update are submitted in a single time command batch.*/
+    class AsyncLoader
+    {
+    public:
+        struct MeshData
+        {
+            std::vector<vg::Vector3> positions;
+            std::vector<vg::Vector3> normals;
+            std::vector<vg::Vector2> textureCoordinates;
+            std::vector<vg::Color> colors;
+            std::vector<uint32_t> indices;
+            vg::PrimitiveTopology topology;
+            MeshData();
+        };
+
+        //They are called by workers, file datas are in order of the file names of the loading.
+        template <typename Decoded_T>
+        using DecodeFunc = std::function<void(std::vector<std::vector<char>> &fileDatas, Decoded_T &decoded)>;
+        using MeshDecodeFunc = std::function<void(const std::vector<char> &fileData, MeshData &meshData)>;
+        //It is called at the main loop.
+        template <typename T, typename Decoded_T>
+        using CreateFunc = std::function<std::shared_ptr<T>(Decoded_T &decoded)>;
+
+        //Max create count 0 means that all decoded loadings are created in one update.
+        AsyncLoader(uint32_t maxCreateCountPerUpdate = 4u);
+        ~AsyncLoader();
+
+        template <typename T, typename Decoded_T>
+        std::shared_ptr<AsyncHandle<T>> load(const std::vector<std::string> &fileNames
+            , const DecodeFunc<Decoded_T> &decodeFunc
+            , const CreateFunc<T, Decoded_T> &createFunc
+            );
+
+        std::shared_ptr<AsyncHandle<vg::Shader>> loadShader(const std::string &vertShaderPath
+            , const std::string &fragShaderPath
+            );
+
+        /*Load the texture with gli, the format of texture is got from the file when the format is undefined.
+          BC1 ~ BC5 data is decoded at worker threads when the device doesn't support its format.*/
+        std::shared_ptr<AsyncHandle<vg::Texture2D>> loadTexture2D(const std::string &fileName
+            , vk::Format format = vk::Format::eUndefined
+            );
+
+        std::shared_ptr<AsyncHandle<vg::DimSepMesh3>> loadSepMesh3(const std::string &fileName
+            , const MeshDecodeFunc &decodeFunc
+            );
+
+        /*Run completions of file reading, and create objects of decoded loadings, it should be called at the main loop.*/
+        void update();
+
+        uint32_t getMaxCreateCountPerUpdate() const;
+        void setMaxCreateCountPerUpdate(uint32_t value);
+        //Count of loadings which haven't been finished.
+        uint32_t getLoadingCount() const;
+    private:
+        struct _Loading
+        {
+            std::vector<std::string> fileNames;
+            std::vector<std::vector<char>> fileDatas;
+            uint32_t readCount;
+            std::string error;
+            //Decode at workers, it returns the creating function called at the main loop.
+            std::function<std::function<void()>(std::vector<std::vector<char>> &fileDatas)> decode;
+            std::function<void()> create;
+            std::function<void(const std::string &error)> fail;
+            _Loading();
+        };
+
+        AsyncLoader(const AsyncLoader &) = delete;
+        AsyncLoader& operator=(const AsyncLoader &) = delete;
+
+        uint32_t m_maxCreateCountPerUpdate;
+        uint32_t m_loadingCount;
+        //Count of loadings which are read or decoded by workers.
+        uint32_t m_workingCount;
+        std::deque<std::shared_ptr<_Loading>> m_decodedLoadings;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        void _startLoading(const std::shared_ptr<_Loading> &pLoading);
+        void _decodeLoading(const std::shared_ptr<_Loading> &pLoading);
+        void _finishWorking(const std::shared_ptr<_Loading> &pLoading);
+
+#ifdef USE_LIBUV
+        struct _FileRead
+        {
+            uv_fs_t req;
+            AsyncLoader *pLoader;
+            std::shared_ptr<_Loading> pLoading;
+            uint32_t fileIndex;
+            uv_file file;
+            uint64_t offset;
+            //Error of reading after the file is opened, it is reported after the file is closed.
+            int result;
+        };
+
+        uv_loop_t m_loop;
+
+        void _readFile(const std::shared_ptr<_Loading> &pLoading, uint32_t fileIndex);
+        void _finishReadFile(_FileRead *pFileRead, int result);
+        static void _readFileData(_FileRead *pFileRead);
+        static void _closeFile(_FileRead *pFileRead, int result);
+        static void _onFileOpened(uv_fs_t *pReq);
+        static void _onFileStated(uv_fs_t *pReq);
+        static void _onFileRead(uv_fs_t *pReq);
+        static void _onFileClosed(uv_fs_t *pReq);
+#endif //USE_LIBUV
+    };
+} //namespace vgf
+
+#include "framework/util/async_loader.inl"
+
+#endif // !VGF_ASYNC_LOADER_H
@@ -0,0 +1,65 @@
+namespace vgf
+{
+    template <typename T>
+    AsyncHandle<T>::AsyncHandle()
+        : m_state(AsyncLoadState::LOADING)
+        , m_pObject()
+        , m_error()
+    {
+    }
+
+    template <typename T>
+    AsyncLoadState AsyncHandle<T>::getState() const
+    {
+        return m_state;
+    }
+
+    template <typename T>
+    Bool32 AsyncHandle<T>::getIsReady() const
+    {
+        return m_state == AsyncLoadState::READY ? VGF_TRUE : VGF_FALSE;
+    }
+
+    template <typename T>
+    Bool32 AsyncHandle<T>::getIsFailed() const
+    {
+        return m_state == AsyncLoadState::FAILED ? VGF_TRUE : VGF_FALSE;
+    }
+
+    template <typename T>
+    const std::shared_ptr<T> &AsyncHandle<T>::get() const
+    {
+        return m_pObject;
+    }
+
+    template <typename T>
+    const std::string &AsyncHandle<T>::getError() const
+    {
+        return m_error;
+    }
+
+    template <typename T, typename Decoded_T>
+    std::shared_ptr<AsyncHandle<T>> AsyncLoader::load(const std::vector<std::string> &fileNames
+        , const DecodeFunc<Decoded_T> &decodeFunc
+        , const CreateFunc<T, Decoded_T> &createFunc
+        )
+    {
+        auto pHandle = std::make_shared<AsyncHandle<T>>();
+        auto pLoading = std::make_shared<_Loading>();
+        pLoading->fileNames = fileNames;
+        pLoading->decode = [decodeFunc, createFunc, pHandle](std::vector<std::vector<char>> &fileDatas) {
+            auto pDecoded = std::make_shared<Decoded_T>();
+            decodeFunc(fileDatas, *pDecoded);
+            return std::function<void()>([createFunc, pHandle, pDecoded]() {
+                pHandle->m_pObject = createFunc(*pDecoded);
+                pHandle->m_state = AsyncLoadState::READY;
+            });
+        };
+        pLoading->fail = [pHandle](const std::string &error) {
+            pHandle->m_error = error;
+            pHandle->m_state = AsyncLoadState::FAILED;
+        };
+        _startLoading(pLoading);
+        return pHandle;
+    }
+} //namespace vgf
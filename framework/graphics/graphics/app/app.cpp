@@ -408,7 +408,10 @@ namespace vg
                 }
 
                 //Application can't function without queue family that supports graphics commands.
-                if (UsedQueueFamily::findQueueFamilies(physicalDevice, *pSurface).isComplete() == VG_FALSE)
+                UsedQueueFamily usedQueueFamily = pSurface != nullptr ? 
+                    UsedQueueFamily::findQueueFamilies(physicalDevice, *pSurface) :
+                    UsedQueueFamily::findQueueFamilies(physicalDevice);
+                if (usedQueueFamily.isComplete() == VG_FALSE)
                 {
                     return VG_FALSE;
                 }
@@ -418,6 +421,9 @@ namespace vg
                     return VG_FALSE;
                 }
 
+                //Headless application doesn't present.
+                if (pSurface == nullptr) return VG_TRUE;
+
                 //Application can't function without adequate support of device for swap chain.
                 SwapChainSupportDetails swapChainSupportDetails = SwapChainSupportDetails::querySwapChainSupport(physicalDevice, *pSurface);
                 if (swapChainSupportDetails.formats.empty() || swapChainSupportDetails.presentModes.empty())
@@ -485,7 +491,9 @@ namespace vg
         , uint32_t presentQueueCount
     )
     {
-        UsedQueueFamily usedQueueFamily = UsedQueueFamily::findQueueFamilies(*m_pPhysicalDevice, *pSurface);
+        UsedQueueFamily usedQueueFamily = pSurface != nullptr ? 
+            UsedQueueFamily::findQueueFamilies(*m_pPhysicalDevice, *pSurface) :
+            UsedQueueFamily::findQueueFamilies(*m_pPhysicalDevice);
         m_graphicsFamily = usedQueueFamily.graphicsFamily;
         m_presentFamily = usedQueueFamily.presentFamily;
 
@@ -41,6 +41,7 @@ namespace vg
         ~Application();
 
         void initCreateVkInstance(std::vector<const char*> extensions);
+        //Surface can be nullptr for headless applications, which don't create swapchains.
         void initOther(const Surface *pSurface
             , uint32_t graphicsQueueCount
             , uint32_t presentQueueCount
@@ -88,6 +88,7 @@ namespace vg
             , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
         , m_sortBufferTexInfosSet(_compareBufferTextureInfo)
         , m_descriptorSetChanged(VG_FALSE)
+        , m_textureResourceStateIDs()
         , m_layoutBindingCount()
         , m_descriptorSetLayoutBindings()
         , m_updateDescriptorSetInfos()
@@ -169,7 +170,7 @@ namespace vg
         m_bufferChanged = VG_TRUE;
     }
 
-    Bool32 BindingSet::hasTexture(std::string name) const
+    Bool32 BindingSet::hasTexture(const std::string &name) const
     {
         return m_data.hasTexture(name);
     }
@@ -190,8 +191,13 @@ namespace vg
     {
         return m_data.getTextureInfo(name);
     }
+
+    const std::vector<std::string> &BindingSet::getTextureNames() const
+    {
+        return m_data.arrTexNames;
+    }
     
-    void BindingSet::setTexture(std::string name, const BindingSetTextureInfo &texInfo)
+    void BindingSet::setTexture(const std::string &name, const BindingSetTextureInfo &texInfo)
     {
         m_data.setTexture(name, texInfo);
         m_textureChanged = VG_TRUE;
@@ -328,9 +334,19 @@ namespace vg
             m_textureChanged = VG_FALSE;
         }
 
+        if (m_descriptorSetChanged == VG_FALSE) {
+            for (const auto &textureStateID : m_textureResourceStateIDs) {
+                if (textureStateID.first->getResourceStateID() != textureStateID.second) {
+                    m_descriptorSetChanged = VG_TRUE;
+                    break;
+                }
+            }
+        }
+
         if (m_descriptorSetChanged) {
             // m_layoutBindingCount = 0u;
             uint32_t currBinding = 0u;
+            m_textureResourceStateIDs.clear();
 
             //first part descriptors is build data.
             uint32_t dataBindingCount = 0u;
@@ -446,6 +462,7 @@ namespace vg
                             updateDesSetInfo.imageInfos[i].imageView = imageView;
                             updateDesSetInfo.imageInfos[i].sampler = sampler;
                             updateDesSetInfo.imageInfos[i].imageLayout = imageLayout;
+                            m_textureResourceStateIDs.push_back(std::make_pair(pTexture, pTexture->getResourceStateID()));
                         }
                     }
                     else
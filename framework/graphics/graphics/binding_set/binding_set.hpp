@@ -47,11 +47,12 @@ namespace vg
         BindingSetBufferInfo getBuffer(std::string name);
         void setBuffer(std::string name, const BindingSetBufferInfo &bufferInfo);
 
-        Bool32 hasTexture(std::string name) const;
+        Bool32 hasTexture(const std::string &name) const;
         void addTexture(std::string name, const BindingSetTextureInfo &texInfo);
         void removeTexture(std::string name);
         BindingSetTextureInfo getTexture(std::string name) const;
-        void setTexture(std::string name, const BindingSetTextureInfo &texInfo);
+        void setTexture(const std::string &name, const BindingSetTextureInfo &texInfo);
+        const std::vector<std::string> &getTextureNames() const;
 
         const BufferData &getBufferData() const;
         const vk::DescriptorSetLayout *getDescriptorSetLayout() const;
@@ -106,6 +107,8 @@ namespace vg
         static Bool32 _compareBufferTextureInfo(const BufferTextureSortInfo &, const BufferTextureSortInfo &);
         std::set<BufferTextureSortInfo, Bool32(*)(const BufferTextureSortInfo &, const BufferTextureSortInfo &)> m_sortBufferTexInfosSet;
         Bool32 m_descriptorSetChanged;
+        //Resource state ids of textures written to descriptor set, image of a texture is recreated when it is changed.
+        std::vector<std::pair<const Texture *, uint32_t>> m_textureResourceStateIDs;
         uint32_t m_layoutBindingCount;
         std::vector<vk::DescriptorSetLayoutBinding> m_descriptorSetLayoutBindings;
         struct UpdateDescriptorSetInfo {
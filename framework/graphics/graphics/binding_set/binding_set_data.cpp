@@ -9,6 +9,7 @@ namespace vg
 
     std::array<std::pair<BufferDescriptorType, vk::DescriptorType>, static_cast<size_t>(BufferDescriptorType::RANGE_SIZE)> arrBufferDescriptorTypeToVK = {
         std::pair<BufferDescriptorType, vk::DescriptorType>(BufferDescriptorType::UNIFORM_BUFFER, vk::DescriptorType::eUniformBuffer),
+        std::pair<BufferDescriptorType, vk::DescriptorType>(BufferDescriptorType::STORAGE_BUFFER, vk::DescriptorType::eStorageBuffer),
     };
 
     vk::DescriptorType tranImageDescriptorTypeToVK(ImageDescriptorType type)
@@ -567,7 +568,7 @@ namespace vg
         return arrTexNames;
     }
 
-    Bool32 BindingSetData::hasTexture(std::string name) const
+    Bool32 BindingSetData::hasTexture(const std::string &name) const
     {
         return hasValue<BindingSetTextureData>(name, mapTextures);
     }
@@ -593,7 +594,7 @@ namespace vg
         return getValue(name, mapTextures, arrTexNames);
     }
 
-    void BindingSetData::setTexture(std::string name, const BindingSetTextureInfo &texInfo)
+    void BindingSetData::setTexture(const std::string &name, const BindingSetTextureInfo &texInfo)
     {
         getValue(name, mapTextures, arrTexNames) = texInfo;
     }
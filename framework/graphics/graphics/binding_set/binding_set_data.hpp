@@ -19,8 +19,9 @@ namespace vg {
     enum class BufferDescriptorType
     {
         UNIFORM_BUFFER,
+        STORAGE_BUFFER,
         BEGIN_RANGE = UNIFORM_BUFFER,
-        END_RANGE = UNIFORM_BUFFER,
+        END_RANGE = STORAGE_BUFFER,
         RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
     };
 
@@ -215,12 +216,12 @@ namespace vg {
         void setBuffer(std::string name, const BindingSetBufferInfo &bufferInfo);
 
         const std::vector<std::string> getArrTextureNames() const;
-        Bool32 hasTexture(std::string name) const;
+        Bool32 hasTexture(const std::string &name) const;
         void addTexture(std::string name, const BindingSetTextureInfo &texInfo);
         void removeTexture(std::string name);
         BindingSetTextureInfo getTextureInfo(std::string name) const;
         const BindingSetTextureData &getTextureData(std::string name) const;
-        void setTexture(std::string name, const BindingSetTextureInfo &texInfo);
+        void setTexture(const std::string &name, const BindingSetTextureInfo &texInfo);
     };
 } //vg
 
@@ -1,6 +1,7 @@
 #include "graphics/buffer_data/buffer_data.hpp"
 
 #include "graphics/buffer_data/util.hpp"
+#include "graphics/buffer_data/transient_buffer.hpp"
 
 namespace vg
 {
@@ -17,6 +18,8 @@ namespace vg
         , m_memorySize(0u)
         , m_pMemory(nullptr)
         , m_pMmemoryForHostVisible(nullptr)
+        , m_pTransientBuffer(nullptr)
+        , m_transientBufferOffset(0u)
     {
 
     }
@@ -63,6 +66,8 @@ namespace vg
         }
 
         m_size = size;
+        m_pTransientBuffer = nullptr;
+        m_transientBufferOffset = 0u;
 
         if (size)
         {
@@ -84,6 +89,33 @@ namespace vg
         }
     }
 
+    void BufferData::updateTransientBuffer(TransientBuffer *pTransientBuffer
+        , fd::ArrayProxy<MemorySlice> memories
+        , uint32_t size
+        )
+    {
+        if (m_pMemory != nullptr) {
+            free(m_pMemory);
+            m_pMemory = nullptr;
+            m_memorySize = 0;
+        }
+
+        m_size = size;
+        m_pTransientBuffer = nullptr;
+        m_transientBufferOffset = 0u;
+        if (size)
+        {
+            auto allocation = pTransientBuffer->allocate(size);
+            uint32_t count = memories.size();
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto &memory = *(memories.data() + i);
+                memcpy(static_cast<char *>(allocation.pMemory) + memory.offset, memory.pMemory, memory.size);
+            }
+            m_pTransientBuffer = allocation.pBuffer;
+            m_transientBufferOffset = allocation.offset;
+        }
+    }
+
     vk::BufferUsageFlags BufferData::getBufferUsageFlags() const
     {
         return m_bufferUsageFlags;
@@ -106,7 +138,12 @@ namespace vg
 
     const vk::Buffer *BufferData::getBuffer() const
     {
-        return m_pBuffer.get();
+        return m_pTransientBuffer != nullptr ? m_pTransientBuffer : m_pBuffer.get();
+    }
+
+    uint32_t BufferData::getBufferOffset() const
+    {
+        return m_transientBufferOffset;
     }
 
     uint32_t BufferData::getBufferMemorySize() const
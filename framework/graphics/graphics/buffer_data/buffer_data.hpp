@@ -5,6 +5,8 @@
 #include "graphics/buffer_data/buffer_data_option.hpp"
 
 namespace vg {
+    class TransientBuffer;
+
     class BufferData 
     {
     public:
@@ -27,11 +29,21 @@ namespace vg {
             , uint32_t size
             , Bool32 cacheMemory = VG_FALSE
             );
+
+        /*Write memories into an allocation of the transient buffer instead of the buffer of its own, buffer
+          and offset returned after it are the allocation until the buffer is updated again. It is used by
+          vertices and indices rebuilt every frame.*/
+        void updateTransientBuffer(TransientBuffer *pTransientBuffer
+            , fd::ArrayProxy<MemorySlice> memories
+            , uint32_t size
+            );
         vk::BufferUsageFlags getBufferUsageFlags() const;
         vk::MemoryPropertyFlags getMemoryPropertyFlags() const;
         uint32_t getSize() const;
         uint32_t getBufferSize() const;
         const vk::Buffer *getBuffer() const;
+        //Offset of the data in the buffer, it isn't 0 when data is in a transient buffer.
+        uint32_t getBufferOffset() const;
         uint32_t getBufferMemorySize() const;
         const vk::DeviceMemory *getBufferMemory() const;
         uint32_t getMemorySize() const;
@@ -48,6 +60,8 @@ namespace vg {
         uint32_t m_memorySize;
         void *m_pMemory;
         void *m_pMmemoryForHostVisible;
+        const vk::Buffer *m_pTransientBuffer;
+        uint32_t m_transientBufferOffset;
 
         Bool32 _isDeviceMemoryLocal() const;
         void _createBuffer(fd::ArrayProxy<MemorySlice> memories, uint32_t bufferSize);
@@ -0,0 +1,18 @@
+#include "graphics/buffer_data/buffer_data_default.hpp"
+
+namespace vg
+{
+    std::shared_ptr<TransientBuffer> pDefaultTransientBuffer = nullptr;
+
+    void createDefaultBufferDatas()
+    {
+        pDefaultTransientBuffer = std::shared_ptr<TransientBuffer>{
+            new TransientBuffer()
+        };
+    }
+
+    void destroyDefaultBufferDatas()
+    {
+        pDefaultTransientBuffer = nullptr;
+    }
+} //vg
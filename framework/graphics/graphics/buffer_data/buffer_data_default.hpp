@@ -0,0 +1,16 @@
+#ifndef VG_BUFFER_DATA_DEFAULT_HPP
+#define VG_BUFFER_DATA_DEFAULT_HPP
+
+#include "graphics/global.hpp"
+#include "graphics/buffer_data/transient_buffer.hpp"
+
+namespace vg
+{
+    //Transient buffer shared by geometry rebuilt every frame, beginFrame() of it is called by the owner of the frame loop.
+    extern std::shared_ptr<TransientBuffer> pDefaultTransientBuffer;
+
+    extern void createDefaultBufferDatas();
+    extern void destroyDefaultBufferDatas();
+} //vg
+
+#endif //VG_BUFFER_DATA_DEFAULT_HPP
@@ -219,6 +219,14 @@ namespace vg
         m_bufferData.updateBuffer(memories, size, cacheMemory);
     }
 
+    void IndexData::updateTransientBuffer(TransientBuffer *pTransientBuffer
+        , fd::ArrayProxy<MemorySlice> memories
+        , uint32_t size
+        )
+    {
+        m_bufferData.updateTransientBuffer(pTransientBuffer, memories, size);
+    }
+
     template<vk::IndexType INDEX_TYPE>
     typename IndexData::IndexTypeInfo<INDEX_TYPE>::ValueType IndexData::getIndex(uint32_t index) const
     {
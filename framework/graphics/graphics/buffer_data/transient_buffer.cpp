@@ -0,0 +1,125 @@
+#include "graphics/buffer_data/transient_buffer.hpp"
+
+#include <algorithm>
+#include "graphics/app/app.hpp"
+#include "graphics/util/find_memory.hpp"
+
+namespace vg
+{
+    const uint32_t TransientBuffer::DEFAULT_REGION_SIZE = 1024u * 1024u;
+    const uint32_t TransientBuffer::DEFAULT_REGION_COUNT = 3u;
+    const uint32_t TransientBuffer::ALIGNMENT = 16u;
+
+    TransientBuffer::Allocation::Allocation(const vk::Buffer *pBuffer
+        , uint32_t offset
+        , uint32_t size
+        , void *pMemory
+        )
+        : pBuffer(pBuffer)
+        , offset(offset)
+        , size(size)
+        , pMemory(pMemory)
+    {
+
+    }
+
+    TransientBuffer::_Block::_Block()
+        : pBuffer()
+        , pBufferMemory()
+        , pMemory(nullptr)
+        , regionSize(0u)
+        , retiredFrame(0u)
+    {
+
+    }
+
+    TransientBuffer::TransientBuffer(uint32_t regionSize
+        , uint32_t regionCount
+        , vk::BufferUsageFlags usage
+        )
+        : m_regionCount(regionCount)
+        , m_usage(usage)
+        , m_block()
+        , m_retiredBlocks()
+        , m_frame(0u)
+        , m_usedSize(0u)
+    {
+#ifdef DEBUG
+        if (regionSize == 0u || regionCount == 0u)
+            throw std::invalid_argument("Region size and region count of transient buffer should not be 0.");
+#endif //DEBUG
+        _createBlock(regionSize);
+    }
+
+    uint32_t TransientBuffer::getRegionSize() const
+    {
+        return m_block.regionSize;
+    }
+
+    uint32_t TransientBuffer::getRegionCount() const
+    {
+        return m_regionCount;
+    }
+
+    uint32_t TransientBuffer::getUsedSize() const
+    {
+        return m_usedSize;
+    }
+
+    void TransientBuffer::beginFrame()
+    {
+        ++m_frame;
+        m_usedSize = 0u;
+        //Frames before the block was retired have been finished when their regions come back.
+        m_retiredBlocks.erase(std::remove_if(m_retiredBlocks.begin(), m_retiredBlocks.end(), [this](const _Block &block)
+        {
+            return m_frame - block.retiredFrame >= static_cast<uint64_t>(m_regionCount);
+        }), m_retiredBlocks.end());
+    }
+
+    TransientBuffer::Allocation TransientBuffer::allocate(uint32_t size)
+    {
+        uint32_t alignedSize = (size + ALIGNMENT - 1u) / ALIGNMENT * ALIGNMENT;
+        if (m_usedSize + alignedSize > m_block.regionSize)
+        {
+            //Allocations made before in this frame keep using the old block.
+            uint32_t regionSize = m_block.regionSize;
+            while (regionSize < alignedSize) regionSize *= 2u;
+            m_block.retiredFrame = m_frame;
+            m_retiredBlocks.push_back(m_block);
+            _createBlock(regionSize * 2u);
+            m_usedSize = 0u;
+            VG_LOG(plog::debug) << "Transient buffer grows to " << m_block.regionSize << " bytes per region." << std::endl;
+        }
+        uint32_t region = static_cast<uint32_t>(m_frame % static_cast<uint64_t>(m_regionCount));
+        uint32_t offset = region * m_block.regionSize + m_usedSize;
+        m_usedSize += alignedSize;
+        return Allocation(m_block.pBuffer.get(), offset, size, static_cast<char *>(m_block.pMemory) + offset);
+    }
+
+    void TransientBuffer::_createBlock(uint32_t regionSize)
+    {
+        auto pDevice = pApp->getDevice();
+        vk::DeviceSize bufferSize = static_cast<vk::DeviceSize>(regionSize) * static_cast<vk::DeviceSize>(m_regionCount);
+        vk::BufferCreateInfo createInfo = {
+            vk::BufferCreateFlags(),
+            bufferSize,
+            m_usage,
+            vk::SharingMode::eExclusive
+        };
+        m_block.pBuffer = fd::createBuffer(pDevice, createInfo);
+
+        //Coherent memory doesn't need flushing after caller writes it.
+        vk::MemoryRequirements memReqs = pDevice->getBufferMemoryRequirements(*m_block.pBuffer);
+        vk::MemoryAllocateInfo allocateInfo = {
+            memReqs.size,
+            vg::findMemoryType(pApp->getPhysicalDevice(), memReqs.memoryTypeBits,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        };
+        m_block.pBufferMemory = fd::allocateMemory(pDevice, allocateInfo);
+        pDevice->bindBufferMemory(*m_block.pBuffer, *m_block.pBufferMemory, 0u);
+        pDevice->mapMemory(*m_block.pBufferMemory, 0u, bufferSize, vk::MemoryMapFlags(), &m_block.pMemory);
+        m_block.regionSize = regionSize;
+        m_block.retiredFrame = 0u;
+    }
+} //vg
@@ -0,0 +1,71 @@
+#ifndef VG_TRANSIENT_BUFFER_HPP
+#define VG_TRANSIENT_BUFFER_HPP
+
+#include "graphics/global.hpp"
+
+namespace vg
+{
+    /*Host visible buffer which stays mapped, geometry rebuilt every frame is written into it directly, so it
+      doesn't create buffers or wait queues. The buffer is divided into one region for every frame, allocations
+      are made linearly in the region of current frame and beginFrame() moves to the next region, so memory
+      of a frame is reused after region count frames. When a region is full, a bigger buffer is created and
+      the old one is kept until frames which may use it are finished.*/
+    class TransientBuffer
+    {
+    public:
+        static const uint32_t DEFAULT_REGION_SIZE;
+        static const uint32_t DEFAULT_REGION_COUNT;
+        //Offsets of allocations are aligned to it, it satisfies vertex attributes and index types.
+        static const uint32_t ALIGNMENT;
+
+        struct Allocation
+        {
+            const vk::Buffer *pBuffer;
+            uint32_t offset;
+            uint32_t size;
+            void *pMemory;
+
+            Allocation(const vk::Buffer *pBuffer = nullptr
+                , uint32_t offset = 0u
+                , uint32_t size = 0u
+                , void *pMemory = nullptr
+                );
+        };
+
+        TransientBuffer(uint32_t regionSize = DEFAULT_REGION_SIZE
+            , uint32_t regionCount = DEFAULT_REGION_COUNT
+            , vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer
+            );
+        uint32_t getRegionSize() const;
+        uint32_t getRegionCount() const;
+        //Size allocated in the region of current frame.
+        uint32_t getUsedSize() const;
+        /*It should be called once a frame before geometry of the frame is written, region count should be
+          bigger than count of frames in flight.*/
+        void beginFrame();
+        //Memory of the allocation is written by caller, it is valid until region count frames later.
+        Allocation allocate(uint32_t size);
+    private:
+        struct _Block
+        {
+            std::shared_ptr<vk::Buffer> pBuffer;
+            std::shared_ptr<vk::DeviceMemory> pBufferMemory;
+            void *pMemory;
+            uint32_t regionSize;
+            uint64_t retiredFrame;
+
+            _Block();
+        };
+
+        uint32_t m_regionCount;
+        vk::BufferUsageFlags m_usage;
+        _Block m_block;
+        std::vector<_Block> m_retiredBlocks;
+        uint64_t m_frame;
+        uint32_t m_usedSize;
+
+        void _createBlock(uint32_t regionSize);
+    };
+} //vg
+
+#endif //VG_TRANSIENT_BUFFER_HPP
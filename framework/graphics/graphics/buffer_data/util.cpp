@@ -135,6 +135,8 @@ namespace vg
 
                 pCommandBuffer->copyBuffer(*pStagingBuffer, *resultBuffer, regions);
     
+                holdSingleTimeCommandResource(pStagingBuffer);
+                holdSingleTimeCommandResource(pStagingBufferMemory);
                 endSingleTimeCommands(pCommandBuffer);
             }
         }
@@ -172,7 +174,10 @@ namespace vg
             uint32_t count = memories.size();
             uint32_t offset = 0;
             uint32_t size = 0;
-            std::vector<vk::MappedMemoryRange> ranges(count);
+            //Host visible buffers may be updated every frame, so ranges are got from frame arena.
+            auto &frameArena = fd::getDefaultFrameArena();
+            fd::FrameArenaScope frameArenaScope(frameArena);
+            auto ranges = frameArena.allocateArray<vk::MappedMemoryRange>(count);
             for (uint32_t i = 0; i < count; ++i) {
                 offset = (*(memories.data() + i)).offset;
                 size = (*(memories.data() + i)).size;
@@ -186,45 +191,83 @@ namespace vg
                 auto pDevice = pApp->getDevice();
                 if (count)
                 {
-                    pDevice->flushMappedMemoryRanges(ranges);
+                    pDevice->flushMappedMemoryRanges(vk::ArrayProxy<const vk::MappedMemoryRange>(count, ranges));
                 }
             }
         }
     }
 
-    void vertexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, const VertexData *pVertexData, uint32_t subIndex)
+    void vertexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, const VertexData *pVertexData, uint32_t subIndex
+        , const vk::Buffer *pBuffer
+        , uint32_t bufferOffset
+        )
+    {
+        VulkanCmdRecorder recorder(&commandBuffer);
+        vertexDataToCommandBuffer(recorder, pVertexData, subIndex, pBuffer, bufferOffset);
+    }
+
+    void vertexDataToCommandBuffer(BaseCmdRecorder &recorder, const VertexData *pVertexData, uint32_t subIndex
+        , const vk::Buffer *pBuffer
+        , uint32_t bufferOffset
+        )
     {
+        if (pBuffer == nullptr)
+        {
+            pBuffer = pVertexData->getBufferData().getBuffer();
+            bufferOffset = pVertexData->getBufferData().getBufferOffset();
+        }
         const auto &subVertexDatas = pVertexData->getSubVertexDatas();
         const auto &subVertexData = subVertexDatas[subIndex];
         uint32_t bindingDescCount = subVertexData.vertexInputStateInfo.vertexBindingDescriptionCount;
         const auto &bindingDescs = subVertexData.vertexInputStateInfo.pVertexBindingDescriptions;
-        std::vector<vk::Buffer> vertexBuffers(bindingDescCount);
-        std::vector<vk::DeviceSize> offsets(bindingDescCount);
-        uint32_t offset = 0u;        
+        //It is called for every draw, so arrays are got from frame arena.
+        auto &frameArena = fd::getDefaultFrameArena();
+        fd::FrameArenaScope frameArenaScope(frameArena);
+        auto vertexBuffers = frameArena.allocateArray<vk::Buffer>(bindingDescCount);
+        auto offsets = frameArena.allocateArray<vk::DeviceSize>(bindingDescCount);
+        uint32_t offset = bufferOffset;
         for (uint32_t i = 0; i < subIndex; ++i) {
             offset += subVertexDatas[i].bufferSize;
         }
 
         uint32_t count = static_cast<uint32_t>(bindingDescCount);
         for (uint32_t i = 0; i < count; ++i) {
-            vertexBuffers[i] = *(pVertexData->getBufferData().getBuffer());
+            vertexBuffers[i] = *pBuffer;
             offsets[i] = offset + *(subVertexData.pBindingBufferOffsets + i);
         }
         
-        commandBuffer.bindVertexBuffers(0u, vertexBuffers, offsets);
+        recorder.bindVertexBuffers(0u, count, vertexBuffers, offsets);
     }
 
     void indexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, 
         const IndexData *pIndexData, 
         uint32_t subIndex
+        , const vk::Buffer *pBuffer
+        , uint32_t bufferOffset
         )
     {
-        uint32_t offset = 0u;
+        VulkanCmdRecorder recorder(&commandBuffer);
+        indexDataToCommandBuffer(recorder, pIndexData, subIndex, pBuffer, bufferOffset);
+    }
+
+    void indexDataToCommandBuffer(BaseCmdRecorder &recorder, 
+        const IndexData *pIndexData, 
+        uint32_t subIndex
+        , const vk::Buffer *pBuffer
+        , uint32_t bufferOffset
+        )
+    {
+        if (pBuffer == nullptr)
+        {
+            pBuffer = pIndexData->getBufferData().getBuffer();
+            bufferOffset = pIndexData->getBufferData().getBufferOffset();
+        }
+        uint32_t offset = bufferOffset;
         const auto &subIndexDatas = pIndexData->getSubIndexDatas();
         for (uint32_t i = 0; i < subIndex; ++i)
         {
             offset += subIndexDatas[i].bufferSize;
         }
-        commandBuffer.bindIndexBuffer(*(pIndexData->getBufferData().getBuffer()), static_cast<vk::DeviceSize>(offset), subIndexDatas[subIndex].indexType);
+        recorder.bindIndexBuffer(*pBuffer, static_cast<vk::DeviceSize>(offset), subIndexDatas[subIndex].indexType);
     }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "graphics/global.hpp"
 #include "graphics/buffer_data/vertex_data.hpp"
 #include "graphics/buffer_data/index_data.hpp"
+#include "graphics/renderer/cmd_recorder.hpp"
 
 namespace vg
 {
@@ -19,11 +20,29 @@ namespace vg
         , void **resultMemoryForHostVisible
         );
 
-    extern void vertexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, const VertexData *pVertexData, uint32_t subIndex = 0);
+    //The buffer replaces the buffer of the data when it isn't nullptr, the data is at the offset of it.
+    extern void vertexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, const VertexData *pVertexData, uint32_t subIndex = 0
+        , const vk::Buffer *pBuffer = nullptr
+        , uint32_t bufferOffset = 0u
+        );
 
     extern void indexDataToCommandBuffer(vk::CommandBuffer &commandBuffer, 
         const IndexData *pIndexData, 
         uint32_t subIndex = 0
+        , const vk::Buffer *pBuffer = nullptr
+        , uint32_t bufferOffset = 0u
+        );
+
+    extern void vertexDataToCommandBuffer(BaseCmdRecorder &recorder, const VertexData *pVertexData, uint32_t subIndex = 0
+        , const vk::Buffer *pBuffer = nullptr
+        , uint32_t bufferOffset = 0u
+        );
+
+    extern void indexDataToCommandBuffer(BaseCmdRecorder &recorder, 
+        const IndexData *pIndexData, 
+        uint32_t subIndex = 0
+        , const vk::Buffer *pBuffer = nullptr
+        , uint32_t bufferOffset = 0u
         );
 } //!vg
 
@@ -256,6 +256,14 @@ namespace vg
     {
         m_bufferData.updateBuffer(memories, size, cacheMemory);
     }
+
+    void VertexData::updateTransientBuffer(TransientBuffer *pTransientBuffer
+        , fd::ArrayProxy<MemorySlice> memories
+        , uint32_t size
+        )
+    {
+        m_bufferData.updateTransientBuffer(pTransientBuffer, memories, size);
+    }
     
     Bool32 VertexData::_isEqual(uint32_t subDataCount1, const SubVertexData *pSubDatas1, 
             uint32_t subDataCount2, const SubVertexData *pSubDatas2)
@@ -65,6 +65,11 @@ namespace vg
            , uint32_t size
            , Bool32 cacheMemory
            );
+        //Write data into the transient buffer instead of the buffer of its own, it is used by data rebuilt every frame.
+        void updateTransientBuffer(TransientBuffer *pTransientBuffer
+            , fd::ArrayProxy<MemorySlice> memories
+            , uint32_t size
+            );
     
         template<typename VertexType>
         VertexType getVertex(uint32_t index) const;
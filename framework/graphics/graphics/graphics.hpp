@@ -9,6 +9,8 @@
 #include <graphics/buffer_data/vertex_data.hpp>
 #include <graphics/buffer_data/index_data.hpp>
 #include <graphics/buffer_data/uniform_buffer_data.hpp>
+#include <graphics/buffer_data/transient_buffer.hpp>
+#include <graphics/buffer_data/buffer_data_default.hpp>
 
 #include <graphics/texture/texture_1d.hpp>
 #include <graphics/texture/texture_1d_array.hpp>
@@ -20,6 +22,10 @@
 #include <graphics/texture/texture_color_attachment.hpp>
 #include <graphics/texture/texture_depth_stencil_attachment.hpp>
 #include <graphics/texture/texture_default.hpp>
+#include <graphics/texture/texture_streamer.hpp>
+#include <graphics/texture/texture_format.hpp>
+#include <graphics/texture/texture_atlas.hpp>
+#include <graphics/texture/bindless_texture_array.hpp>
 
 #include <graphics/mesh/mesh.hpp>
 #include <graphics/mesh/mesh_2.hpp>
@@ -35,6 +41,8 @@
 #include <graphics/post_render/post_render.hpp>
 
 #include <graphics/renderer/renderer.hpp>
+#include <graphics/renderer/cmd_recorder.hpp>
+#include <graphics/renderer/frame_capture.hpp>
 #include <graphics/renderer/renderer_target_surface.hpp>
 #include <graphics/renderer/renderer_target_color_texture.hpp>
 
@@ -50,6 +58,8 @@
 #include <graphics/light/light_ambient_3.hpp>
 #include <graphics/light/light_direct_3.hpp>
 #include <graphics/light/light_spot_3.hpp>
+#include <graphics/light/light_cluster_3.hpp>
+#include <graphics/light/light_shadow_atlas.hpp>
 
 #include <graphics/util/queue_family.hpp>
 #include <graphics/util/swapchain_info.hpp>
@@ -0,0 +1,181 @@
+#include "graphics/light/light_cluster_3.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace vg
+{
+    //Cosine of outer angle of point lights, it is less than cosine of any angle.
+    static const float POINT_LIGHT_COS_OUTER = -2.0f;
+    static const float POINT_LIGHT_COS_INNER = -1.0f;
+
+    LightCluster3::LightCluster3(uint32_t clusterCountX
+        , uint32_t clusterCountY
+        , uint32_t clusterCountZ
+        )
+        : m_clusterCountX(clusterCountX)
+        , m_clusterCountY(clusterCountY)
+        , m_clusterCountZ(clusterCountZ)
+        , m_lights()
+        , m_assigner(fd::LightClusterGridInfo(clusterCountX, clusterCountY, clusterCountZ))
+        , m_infoBuffer(vk::BufferUsageFlagBits::eUniformBuffer
+            , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        , m_lightBuffer(vk::BufferUsageFlagBits::eStorageBuffer
+            , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        , m_clusterBuffer(vk::BufferUsageFlagBits::eStorageBuffer
+            , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        , m_indexBuffer(vk::BufferUsageFlagBits::eStorageBuffer
+            , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+    {
+
+    }
+
+    void LightCluster3::clearLights()
+    {
+        m_lights.clear();
+    }
+
+    uint32_t LightCluster3::addPointLight(const Vector3 &position, float range, const Vector3 &strength)
+    {
+        _Light light = {
+            Vector4(position, range),
+            Vector4(0.0f, 0.0f, 0.0f, POINT_LIGHT_COS_OUTER),
+            Vector4(strength, POINT_LIGHT_COS_INNER),
+        };
+        m_lights.push_back(light);
+        return static_cast<uint32_t>(m_lights.size()) - 1u;
+    }
+
+    uint32_t LightCluster3::addSpotLight(const Vector3 &position
+        , const Vector3 &direction
+        , float range
+        , float outerAngle
+        , float innerAngle
+        , const Vector3 &strength
+        )
+    {
+        _Light light = {
+            Vector4(position, range),
+            Vector4(glm::normalize(direction), std::cos(outerAngle)),
+            Vector4(strength, std::cos(innerAngle)),
+        };
+        m_lights.push_back(light);
+        return static_cast<uint32_t>(m_lights.size()) - 1u;
+    }
+
+    uint32_t LightCluster3::getLightCount() const
+    {
+        return static_cast<uint32_t>(m_lights.size());
+    }
+
+    const fd::LightClusterAssigner &LightCluster3::getAssigner() const
+    {
+        return m_assigner;
+    }
+
+    void LightCluster3::update(const Projector3 *pProjector, const Space &space)
+    {
+#ifdef DEBUG
+        if (pProjector == nullptr)
+            throw std::invalid_argument("Projector of the light cluster should not be nullptr.");
+#endif //DEBUG
+        float tanHalfFovY = std::tan(pProjector->getFov() * 0.5f);
+        fd::LightClusterGridInfo gridInfo(m_clusterCountX
+            , m_clusterCountY
+            , m_clusterCountZ
+            , tanHalfFovY * pProjector->getAspect()
+            , tanHalfFovY
+            , pProjector->getDepthNear()
+            , pProjector->getDepthFar()
+            );
+        m_assigner.setGridInfo(gridInfo);
+
+        //View space of the grid is left hand, right hand space is changed like the projection matrix of it.
+        Matrix4x4 viewMatrix = pProjector->getWorldToLocalMatrix();
+        if (space.rightHand == VG_TRUE)
+        {
+            vg::Vector3 eulerAngles = vg::Vector3(glm::radians(-90.0f), 0.0f, 0.0f);
+            viewMatrix = glm::toMat4(vg::Quaternion(eulerAngles)) * viewMatrix;
+        }
+
+        m_assigner.clearLights();
+        for (const auto &light : m_lights)
+        {
+            Vector3 position = Vector3(viewMatrix * Vector4(Vector3(light.positionRange), 1.0f));
+            float range = light.positionRange.w;
+            float cosOuter = light.directionCosOuter.w;
+            if (cosOuter < -1.0f)
+            {
+                m_assigner.addPointLight(position, range);
+            }
+            else
+            {
+                Vector3 direction = Vector3(viewMatrix * Vector4(Vector3(light.directionCosOuter), 0.0f));
+                m_assigner.addSpotLight(position, direction, range, std::acos(cosOuter));
+            }
+        }
+        m_assigner.assign();
+
+        _Info info;
+        info.viewMatrix = viewMatrix;
+        info.tanHalfFovXYNearSliceScale = Vector4(gridInfo.tanHalfFovX
+            , gridInfo.tanHalfFovY
+            , gridInfo.depthNear
+            , static_cast<float>(gridInfo.clusterCountZ) / std::log(gridInfo.depthFar / gridInfo.depthNear)
+            );
+        info.clusterCountXYZLightCount[0] = gridInfo.clusterCountX;
+        info.clusterCountXYZLightCount[1] = gridInfo.clusterCountY;
+        info.clusterCountXYZLightCount[2] = gridInfo.clusterCountZ;
+        info.clusterCountXYZLightCount[3] = static_cast<uint32_t>(m_lights.size());
+        m_infoBuffer.updateBuffer(&info, static_cast<uint32_t>(sizeof(_Info)));
+
+        //Storage buffers can't be empty, so an element is uploaded at least.
+        const auto &clusters = m_assigner.getClusters();
+        const auto &indices = m_assigner.getLightIndices();
+        _Light emptyLight = {Vector4(0.0f), Vector4(0.0f), Vector4(0.0f)};
+        uint32_t emptyIndex = 0u;
+        m_lightBuffer.updateBuffer(m_lights.empty() ? &emptyLight : reinterpret_cast<const void *>(m_lights.data())
+            , static_cast<uint32_t>(std::max(m_lights.size(), static_cast<size_t>(1u)) * sizeof(_Light)));
+        m_clusterBuffer.updateBuffer(clusters.data()
+            , static_cast<uint32_t>(clusters.size() * sizeof(fd::LightClusterAssigner::Cluster)));
+        m_indexBuffer.updateBuffer(indices.empty() ? &emptyIndex : reinterpret_cast<const void *>(indices.data())
+            , static_cast<uint32_t>(std::max(indices.size(), static_cast<size_t>(1u)) * sizeof(uint32_t)));
+    }
+
+    void LightCluster3::bindToPass(Pass *pPass
+        , uint32_t bindingPriority
+        , vk::ShaderStageFlags stageFlags
+        ) const
+    {
+        const char *names[VG_LIGHT_CLUSTER3_BINDING_COUNT] = {
+            VG_LIGHT_CLUSTER3_INFO_NAME,
+            VG_LIGHT_CLUSTER3_LIGHTS_NAME,
+            VG_LIGHT_CLUSTER3_CLUSTERS_NAME,
+            VG_LIGHT_CLUSTER3_INDICES_NAME,
+        };
+        const BufferData *buffers[VG_LIGHT_CLUSTER3_BINDING_COUNT] = {
+            &m_infoBuffer,
+            &m_lightBuffer,
+            &m_clusterBuffer,
+            &m_indexBuffer,
+        };
+        for (uint32_t i = 0u; i < VG_LIGHT_CLUSTER3_BINDING_COUNT; ++i)
+        {
+            PassBufferInfo::BufferInfo bufferInfo(buffers[i], 0u, buffers[i]->getSize());
+            PassBufferInfo info(1u
+                , &bufferInfo
+                , bindingPriority + i
+                , i == 0u ? BufferDescriptorType::UNIFORM_BUFFER : BufferDescriptorType::STORAGE_BUFFER
+                , stageFlags
+                );
+            if (pPass->hasBuffer(names[i]))
+            {
+                pPass->setBuffer(names[i], info);
+            }
+            else
+            {
+                pPass->addBuffer(names[i], info);
+            }
+        }
+    }
+} //vg
@@ -0,0 +1,87 @@
+#ifndef VG_LIGHT_CLUSTER_3_HPP
+#define VG_LIGHT_CLUSTER_3_HPP
+
+#include <foundation/light_cluster.hpp>
+#include "graphics/global.hpp"
+#include "graphics/scene/projector.hpp"
+#include "graphics/buffer_data/buffer_data.hpp"
+#include "graphics/pass/pass.hpp"
+
+namespace vg
+{
+    #define VG_LIGHT_CLUSTER3_INFO_NAME "_light_cluster_info"
+    #define VG_LIGHT_CLUSTER3_LIGHTS_NAME "_light_cluster_lights"
+    #define VG_LIGHT_CLUSTER3_CLUSTERS_NAME "_light_cluster_clusters"
+    #define VG_LIGHT_CLUSTER3_INDICES_NAME "_light_cluster_indices"
+    #define VG_LIGHT_CLUSTER3_BINDING_COUNT 4u
+
+    /*Clustered forward lighting for many point and spot lights without shadows. The view frustum of the
+      projector is divided into a grid of clusters, lights are assigned to clusters on the CPU and every
+      fragment only loops over the lights of its cluster. Buffers are bound from the binding priority in order:
+        uniform Info { mat4 viewMatrix; vec4 tanHalfFovXYNearSliceScale; uvec4 clusterCountXYZLightCount; }
+        buffer Lights { Light lights[]; } with Light { vec4 positionRange; vec4 directionCosOuter; vec4 strengthCosInner; }
+        buffer Clusters { uvec2 clusters[]; } with offset and count of light indices of every cluster.
+        buffer Indices { uint indices[]; }
+      The view position is viewMatrix * worldPosition, its cluster is
+        x = (view.x / view.z / tanHalfFovX + 1) / 2 * countX, y likewise,
+        z = log(view.z / near) * sliceScale, cluster index = (z * countY + y) * countX + x.
+      Positions and directions of lights are in world space, point lights have cosOuter -2 and cosInner -1,
+      so smoothstep(cosOuter, cosInner, dot(-L, direction)) is 1 for them.*/
+    class LightCluster3
+    {
+    public:
+        LightCluster3(uint32_t clusterCountX = FD_LIGHT_CLUSTER_DEFAULT_COUNT_X
+            , uint32_t clusterCountY = FD_LIGHT_CLUSTER_DEFAULT_COUNT_Y
+            , uint32_t clusterCountZ = FD_LIGHT_CLUSTER_DEFAULT_COUNT_Z
+            );
+
+        void clearLights();
+        uint32_t addPointLight(const Vector3 &position, float range, const Vector3 &strength);
+        //Angles are half angles of the cone, light fades from inner angle to outer angle.
+        uint32_t addSpotLight(const Vector3 &position
+            , const Vector3 &direction
+            , float range
+            , float outerAngle
+            , float innerAngle
+            , const Vector3 &strength
+            );
+        uint32_t getLightCount() const;
+        const fd::LightClusterAssigner &getAssigner() const;
+
+        /*Assign lights to the clusters of the projector and upload buffers, the space is the space of the scene
+          rendered with the projector. It should be called after lights or the projector are changed and
+          before passes are bound.*/
+        void update(const Projector3 *pProjector, const Space &space);
+        //Add the buffers to the pass or update them, the pass should be applied after it.
+        void bindToPass(Pass *pPass
+            , uint32_t bindingPriority
+            , vk::ShaderStageFlags stageFlags = vk::ShaderStageFlagBits::eFragment
+            ) const;
+    private:
+        struct _Info
+        {
+            Matrix4x4 viewMatrix;
+            Vector4 tanHalfFovXYNearSliceScale;
+            uint32_t clusterCountXYZLightCount[4];
+        };
+
+        struct _Light
+        {
+            Vector4 positionRange;
+            Vector4 directionCosOuter;
+            Vector4 strengthCosInner;
+        };
+
+        uint32_t m_clusterCountX;
+        uint32_t m_clusterCountY;
+        uint32_t m_clusterCountZ;
+        std::vector<_Light> m_lights;
+        fd::LightClusterAssigner m_assigner;
+        BufferData m_infoBuffer;
+        BufferData m_lightBuffer;
+        BufferData m_clusterBuffer;
+        BufferData m_indexBuffer;
+    };
+} //vg
+
+#endif //VG_LIGHT_CLUSTER_3_HPP
@@ -2,6 +2,49 @@
 
 namespace vg
 {
+//LightDistTargetCubeFace
+    LightDistTargetCubeFace::LightDistTargetCubeFace(uint32_t framebufferWidth
+        , uint32_t framebufferHeight
+        , vk::RenderPass *pRenderPass
+        , const vk::ImageView *pColorAttachment
+        , const vk::ImageView *pDepthAttachment
+        )
+        : OnceRenderTarget(framebufferWidth, framebufferHeight)
+        , m_pMyFramebuffer()
+    {
+        vk::ClearValue clearValueColor = {
+            std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}
+        };
+        vk::ClearValue clearValueDepthStencil = {
+            vk::ClearDepthStencilValue(1.0f, 0)
+        };
+        std::array<vk::ClearValue, 2u> clearValues = { 
+            clearValueColor,
+            clearValueDepthStencil,
+        };
+        setClearValues(clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+
+        auto pDevice = pApp->getDevice();
+        m_pRenderPass = pRenderPass;
+        std::array<vk::ImageView, 2u> attachments = {
+            *pColorAttachment,
+            *pDepthAttachment,
+        };
+
+        vk::FramebufferCreateInfo frameBufferCreateInfo = {
+            vk::FramebufferCreateFlags(),
+            *m_pRenderPass,
+            static_cast<uint32_t>(attachments.size()),
+            attachments.data(),
+            framebufferWidth,
+            framebufferHeight,
+            1u,
+        };
+
+        m_pMyFramebuffer = fd::createFrameBuffer(pDevice, frameBufferCreateInfo);
+        m_pFramebuffer = m_pMyFramebuffer.get();
+    }
+
 //LightDistTargetCube
     const vk::Format LightDistTargetCube::DEFAULT_COLOR_FORMAT(vk::Format::eR32Sfloat);
     const vk::Format LightDistTargetCube::DEFAULT_DEPTH_FORMAT(vk::Format::eD32Sfloat);
@@ -13,6 +56,7 @@ namespace vg
         : OnceRenderTarget(framebufferWidth, framebufferHeight)
         , m_colorImageFormat(colorImageFormat)
         , m_depthImageFormat(depthImageFormat)
+        , m_pFaceTargets()
     {
         vk::ClearValue clearValueColor = {
             std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}
@@ -48,6 +92,46 @@ namespace vg
         return m_pDepthTargetTex.get();
     }
 
+    void LightDistTargetCube::createFaceTargets()
+    {
+        if (m_pFaceTargets.size() != 0u) return;
+        //Every face target uses views of one layer of the cube textures.
+        const uint32_t faceCount = static_cast<uint32_t>(CubemapFace::RANGE_SIZE);
+        auto colorAspect = m_pColorTargetTex->getImageView()->getInfo().subResourceRange.aspectMask;
+        auto depthAspect = m_pDepthTargetTex->getImageView()->getInfo().subResourceRange.aspectMask;
+        m_pFaceTargets.resize(faceCount);
+        for (uint32_t face = 0u; face < faceCount; ++face)
+        {
+            std::string name = "face_" + std::to_string(face);
+            Texture::ImageViewCreateInfo colorCreateInfo = {
+                vk::ImageViewType::e2D,
+                vk::ComponentMapping(),
+                vk::ImageSubresourceRange(colorAspect, 0u, 1u, face, 1u),
+            };
+            auto pColorView = m_pColorTargetTex->createImageView(name, colorCreateInfo);
+            Texture::ImageViewCreateInfo depthCreateInfo = {
+                vk::ImageViewType::e2D,
+                vk::ComponentMapping(),
+                vk::ImageSubresourceRange(depthAspect, 0u, 1u, face, 1u),
+            };
+            auto pDepthView = m_pDepthTargetTex->createImageView(name, depthCreateInfo);
+            m_pFaceTargets[face] = std::shared_ptr<LightDistTargetCubeFace>{
+                new LightDistTargetCubeFace(m_framebufferWidth
+                    , m_framebufferHeight
+                    , m_pRenderPass
+                    , pColorView->getImageView()
+                    , pDepthView->getImageView()
+                    )
+            };
+        }
+    }
+
+    const LightDistTargetCubeFace *LightDistTargetCube::getFaceTarget(CubemapFace face) const
+    {
+        if (m_pFaceTargets.size() == 0u) return nullptr;
+        return m_pFaceTargets[static_cast<size_t>(face)].get();
+    }
+
     void LightDistTargetCube::_createObjs()
     {
         auto pDevice = pApp->getDevice();
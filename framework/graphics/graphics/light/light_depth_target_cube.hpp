@@ -7,6 +7,20 @@
 
 namespace vg
 {
+    //Render target of one face of the cube, it shares the render pass and textures of the cube.
+    class LightDistTargetCubeFace : public OnceRenderTarget
+    {
+    public:
+        LightDistTargetCubeFace(uint32_t framebufferWidth
+            , uint32_t framebufferHeight
+            , vk::RenderPass *pRenderPass
+            , const vk::ImageView *pColorAttachment
+            , const vk::ImageView *pDepthAttachment
+            );
+    private:
+        std::shared_ptr<vk::Framebuffer> m_pMyFramebuffer;
+    };
+
     class LightDistTargetCube : public OnceRenderTarget
     {
     public:
@@ -21,6 +35,10 @@ namespace vg
         vk::Format getDepthImageFormat() const;
         const TextureCubeColorAttachment *getColorTargetTexture() const;
         const TextureCubeDepthAttachment *getDepthTargetTexture() const;
+        /*Face targets render faces in separate passes, they are created by createFaceTargets() and
+          getFaceTarget() returns nullptr before it.*/
+        void createFaceTargets();
+        const LightDistTargetCubeFace *getFaceTarget(CubemapFace face) const;
     private:
         vk::Format m_colorImageFormat;
         vk::Format m_depthImageFormat;
@@ -28,6 +46,7 @@ namespace vg
         std::shared_ptr<TextureCubeDepthAttachment> m_pDepthTargetTex;
         std::shared_ptr<vk::RenderPass> m_pMyRenderPass;
         std::shared_ptr<vk::Framebuffer> m_pMyFramebuffer;
+        std::vector<std::shared_ptr<LightDistTargetCubeFace>> m_pFaceTargets;
         void _createObjs();
     };
 } //vg
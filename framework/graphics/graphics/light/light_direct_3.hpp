@@ -3,6 +3,7 @@
 
 #include "graphics/scene/light_3.hpp"
 #include "graphics/light/light_depth_target_2d.hpp"
+#include "graphics/light/light_shadow_atlas.hpp"
 
 namespace vg
 {
@@ -31,7 +32,12 @@ namespace vg
             , uint32_t depthTextureHeight = DEFAULT_DEPTH_TEXTURE_HEIGHT
             , vk::Format format = DEFAULT_FORMAT
             );
+        ~LightDirect3();
         virtual LightDepthRenderInfo getDepthRenderInfo() const override;
+        LightShadowAtlas *getShadowAtlas() const;
+        /*Depth of the light is rendered to a tile of the atlas with the size of its depth texture instead of
+          its own depth texture, nullptr makes it use its own depth texture again.*/
+        void setShadowAtlas(LightShadowAtlas *pShadowAtlas);
         float getWidth() const;
         void setWidth(float value);
         float getHeight() const;
@@ -45,8 +51,15 @@ namespace vg
         float m_height;
         float m_range;
         vg::Vector3 m_strength;
+        uint32_t m_depthTextureWidth;
+        uint32_t m_depthTextureHeight;
+        vk::Format m_depthTextureFormat;
         std::shared_ptr<LightDepthTarget2D> m_pDepthTarget;
         const LightDepthTarget2D *m_refDepthTarget;
+        LightShadowAtlas *m_pShadowAtlas;
+        //Pack version of the atlas when the tile is got, the tile is got again when the atlas is packed again.
+        uint32_t m_shadowAtlasPackVersion;
+        Matrix4x4 m_shadowTileMatrix;
         std::shared_ptr<ProjectorOP3> m_pProjector;
         const ProjectorOP3 *m_refProjector;
 
@@ -54,8 +67,10 @@ namespace vg
         void _setProjector();
         void _setRange();
         void _setProjection();
+        void _setShadowTile();
         void _setStrength();
         void _setDepthTexture();
+        void _createDepthTarget();
     };
 } //vg
 
@@ -24,6 +24,10 @@ namespace vg
         , m_pDistTarget()
         , m_pProjector()
         , m_depthRenderData()
+        , m_isPerFaceRender(VG_FALSE)
+        , m_pFaceProjectors()
+        , m_refFaceProjectors()
+        , m_refFaceTargets()
     {
         //projector
         m_pProjector = std::shared_ptr<Projector3>{new Projector3(VG_TRUE)};
@@ -73,6 +77,17 @@ namespace vg
 
     LightDepthRenderInfo LightPoint3::getDepthRenderInfo() const
     {
+        if (m_isPerFaceRender == VG_TRUE)
+        {
+            LightDepthRenderInfo faceInfo = {
+                static_cast<uint32_t>(m_refFaceProjectors.size()),
+                m_refFaceProjectors.data(),
+                m_refFaceTargets.data(),
+                reinterpret_cast<const void *>(&m_depthRenderData),
+                static_cast<uint32_t>(sizeof(LightDepthRenderData)),
+            };
+            return faceInfo;
+        }
         LightDepthRenderInfo info = {
             1u,
             reinterpret_cast<const BaseProjector *const *>(&m_refProjector),
@@ -113,6 +128,20 @@ namespace vg
         return m_pDistTarget.get();
     }
 
+    Bool32 LightPoint3::getIsPerFaceRender() const
+    {
+        return m_isPerFaceRender;
+    }
+
+    void LightPoint3::setIsPerFaceRender(Bool32 value)
+    {
+        if (value == VG_TRUE && m_pFaceProjectors.size() == 0u)
+        {
+            _createFaceObjs();
+        }
+        m_isPerFaceRender = value;
+    }
+
     void LightPoint3::_beginRender()
     {
         Light3::_beginRender();
@@ -121,6 +150,13 @@ namespace vg
         auto pos = m_pTransform->getLocalPosition();
         transform = glm::translate(transform, pos);
         m_pProjector->setTransformMatrix(transform);
+        //View matrix of a face projector is the face transform multiplied by the view matrix of the light,
+        //it is same as the transform applied by the geometry shader.
+        uint32_t faceCount = static_cast<uint32_t>(m_pFaceProjectors.size());
+        for (uint32_t face = 0u; face < faceCount; ++face)
+        {
+            m_pFaceProjectors[face]->setTransformMatrix(transform * glm::inverse(m_depthRenderData.cubeFaceTransform[face]));
+        }
     }
 
     void LightPoint3::_setProjector()
@@ -128,6 +164,12 @@ namespace vg
         float f = m_range;
         float n = std::min(0.1f, f);
         m_pProjector->updateProj(glm::radians(90.0f), 1.0f, n, f);
+        for (const auto &pFaceProjector : m_pFaceProjectors)
+        {
+            pFaceProjector->updateProj(glm::radians(90.0f), 1.0f, n, f);
+        }
+        m_depthRenderData.depthNear = n;
+        m_depthRenderData.depthFar = f;
     }
 
     void LightPoint3::_setRange()
@@ -177,4 +219,24 @@ namespace vg
         }
         m_textureChanged = VG_TRUE;
     }
+
+    void LightPoint3::_createFaceObjs()
+    {
+        m_pDistTarget->createFaceTargets();
+        const uint32_t faceCount = static_cast<uint32_t>(CubemapFace::RANGE_SIZE);
+        m_pFaceProjectors.resize(faceCount);
+        for (uint32_t face = 0u; face < faceCount; ++face)
+        {
+            m_pFaceProjectors[face] = std::shared_ptr<Projector3>{new Projector3()};
+            m_pFaceProjectors[face]->updateProj(m_pProjector->getFov()
+                , m_pProjector->getAspect()
+                , m_pProjector->getDepthNear()
+                , m_pProjector->getDepthFar()
+                );
+            m_pFaceProjectors[face]->setTransformMatrix(m_pProjector->getLocalToWorldMatrix() *
+                glm::inverse(m_depthRenderData.cubeFaceTransform[face]));
+            m_refFaceProjectors[face] = m_pFaceProjectors[face].get();
+            m_refFaceTargets[face] = m_pDistTarget->getFaceTarget(static_cast<CubemapFace>(face));
+        }
+    }
 } //vg
\ No newline at end of file
@@ -15,6 +15,12 @@ namespace vg
     #define VG_LIGHT_POINT3_DATA_SIZE LIGHT_DATA_BASE_SIZE + static_cast<uint32_t>(sizeof(vg::Vector4)) + static_cast<uint32_t>(sizeof(vg::Vector4))
     #define VG_LIGHT_POINT3_TEXTURE_COUNT 1u //depth texture.
 
+    /*Distances of all faces are rendered in one pass by default, a geometry shader sends every triangle to
+      six layers. When per face render is enabled, every face is rendered in its own pass with a projector
+      of the face, so casters are culled against the frustum of every face on the CPU and only casters
+      intersecting a face are drawn into it. The lighting material of point lights should be changed to
+      pDefaultLightingPointDistFaceMaterial in that mode, it uses the same data without the geometry shader,
+      so all point lights of a scene should use the same mode.*/
     class LightPoint3 : public Light3<VG_LIGHT_POINT3_DATA_SIZE, VG_LIGHT_POINT3_TEXTURE_COUNT>
     {
     public:
@@ -41,6 +47,8 @@ namespace vg
         vg::Vector3 getStrength() const;
         void setStrength(vg::Vector3 value);
         const LightDistTargetCube *getLightDistTargetCube() const;
+        Bool32 getIsPerFaceRender() const;
+        void setIsPerFaceRender(Bool32 value);
     protected:
         float m_range;
         vg::Vector3 m_strength;
@@ -49,12 +57,17 @@ namespace vg
         std::shared_ptr<Projector3> m_pProjector;
         const Projector3 *m_refProjector;
         LightDepthRenderData m_depthRenderData;
+        Bool32 m_isPerFaceRender;
+        std::vector<std::shared_ptr<Projector3>> m_pFaceProjectors;
+        std::array<const BaseProjector *, static_cast<size_t>(CubemapFace::RANGE_SIZE)> m_refFaceProjectors;
+        std::array<const OnceRenderTarget *, static_cast<size_t>(CubemapFace::RANGE_SIZE)> m_refFaceTargets;
         virtual void _beginRender() override;
 
         void _setProjector();
         void _setRange();
         void _setStrength();
         void _setDistTexture();
+        void _createFaceObjs();
     };
 } //vg
 
@@ -0,0 +1,314 @@
+#include "graphics/light/light_shadow_atlas.hpp"
+
+#include <algorithm>
+
+namespace vg
+{
+    const uint32_t LightShadowAtlas::DEFAULT_WIDTH = 4096u;
+    const uint32_t LightShadowAtlas::DEFAULT_HEIGHT = 4096u;
+    const vk::Format LightShadowAtlas::DEFAULT_FORMAT = vk::Format::eD32Sfloat;
+    const uint32_t LightShadowAtlas::TILE_BORDER = 1u;
+
+    LightShadowAtlas::_Tile::_Tile(uint32_t width
+        , uint32_t height
+        )
+        : width(width)
+        , height(height)
+        , area()
+        , clearArea()
+        , isRendered(VG_FALSE)
+        , casterHash(0u)
+    {
+
+    }
+
+    LightShadowAtlas::LightShadowAtlas(uint32_t width
+        , uint32_t height
+        , vk::Format format
+        )
+        : PreDepthTarget(width, height, format)
+        , m_pDepthTargetTex()
+        , m_pMyRenderPass()
+        , m_pTileRenderPass()
+        , m_pMyFramebuffer()
+        , m_packer(width, height)
+        , m_tileLightIDs()
+        , m_tiles()
+        , m_isCleared(VG_FALSE)
+        , m_packVersion(0u)
+    {
+        _createObjs();
+    }
+
+    const Texture2DDepthAttachment *LightShadowAtlas::getDepthTargetTexture() const
+    {
+        return m_pDepthTargetTex.get();
+    }
+
+    const vk::RenderPass *LightShadowAtlas::getTileRenderPass() const
+    {
+        return m_pTileRenderPass.get();
+    }
+
+    void LightShadowAtlas::addTile(InstanceID lightID, uint32_t width, uint32_t height)
+    {
+#ifdef DEBUG
+        if (hasTile(lightID))
+            throw std::invalid_argument("The light has had a tile in the shadow atlas.");
+        if (width == 0u || height == 0u)
+            throw std::invalid_argument("The size of the shadow tile is 0.");
+#endif //DEBUG
+        m_tileLightIDs.push_back(lightID);
+        m_tiles[lightID] = _Tile(width, height);
+        _pack();
+    }
+
+    void LightShadowAtlas::removeTile(InstanceID lightID)
+    {
+        if (hasTile(lightID) == VG_FALSE) return;
+        m_tileLightIDs.erase(std::remove(m_tileLightIDs.begin(), m_tileLightIDs.end(), lightID), m_tileLightIDs.end());
+        m_tiles.erase(lightID);
+        _pack();
+    }
+
+    Bool32 LightShadowAtlas::hasTile(InstanceID lightID) const
+    {
+        return m_tiles.count(lightID) != 0u;
+    }
+
+    uint32_t LightShadowAtlas::getTileCount() const
+    {
+        return static_cast<uint32_t>(m_tileLightIDs.size());
+    }
+
+    uint32_t LightShadowAtlas::getPackVersion() const
+    {
+        return m_packVersion;
+    }
+
+    const fd::Rect2D &LightShadowAtlas::getTileArea(InstanceID lightID) const
+    {
+        return m_tiles.at(lightID).area;
+    }
+
+    const fd::Rect2D &LightShadowAtlas::getTileClearArea(InstanceID lightID) const
+    {
+        return m_tiles.at(lightID).clearArea;
+    }
+
+    Matrix4x4 LightShadowAtlas::caculateTileProjMatrix(InstanceID lightID, const Matrix4x4 &projMatrix) const
+    {
+        //Shaders get coordinates of shadow maps with ndc * 0.5 + 0.5, ndc is moved to make them fall in the tile.
+        const auto &area = m_tiles.at(lightID).area;
+        Matrix4x4 tileMatrix(1.0f);
+        tileMatrix[0][0] = area.width;
+        tileMatrix[1][1] = area.height;
+        tileMatrix[3][0] = area.x * 2.0f + area.width - 1.0f;
+        tileMatrix[3][1] = area.y * 2.0f + area.height - 1.0f;
+        return tileMatrix * projMatrix;
+    }
+
+    Bool32 LightShadowAtlas::isTileChanged(InstanceID lightID, uint64_t casterHash) const
+    {
+        const auto &tile = m_tiles.at(lightID);
+        return tile.isRendered == VG_FALSE || tile.casterHash != casterHash;
+    }
+
+    void LightShadowAtlas::setTileRendered(InstanceID lightID, uint64_t casterHash)
+    {
+        auto &tile = m_tiles.at(lightID);
+        tile.isRendered = VG_TRUE;
+        tile.casterHash = casterHash;
+    }
+
+    Bool32 LightShadowAtlas::getIsCleared() const
+    {
+        return m_isCleared;
+    }
+
+    void LightShadowAtlas::resetTiles()
+    {
+        invalidate();
+        m_isCleared = VG_TRUE;
+    }
+
+    void LightShadowAtlas::invalidate()
+    {
+        for (auto &pair : m_tiles)
+        {
+            pair.second.isRendered = VG_FALSE;
+        }
+    }
+
+    void LightShadowAtlas::_createObjs()
+    {
+        auto pDevice = pApp->getDevice();
+        //depth attachment
+        auto pTex = new Texture2DDepthAttachment(
+                m_depthImageFormat,
+                m_framebufferWidth,
+                m_framebufferHeight
+                );
+
+        m_pDepthTargetTex = std::shared_ptr<Texture2DDepthAttachment>(pTex);
+        m_pDepthAttachment = m_pDepthTargetTex->getImageView()->getImageView();
+
+        //render passes, contents of the atlas are discarded by the first one and kept by the second one.
+        m_pMyRenderPass = _createRenderPass(vk::ImageLayout::eUndefined);
+        m_pRenderPass = m_pMyRenderPass.get();
+        m_pTileRenderPass = _createRenderPass(vk::ImageLayout::eDepthStencilReadOnlyOptimal);
+
+        //frame buffer, it is compatible with both render passes.
+        std::array<vk::ImageView, 1> attachments = {
+             *m_pDepthAttachment,
+        };
+
+        vk::FramebufferCreateInfo frameBufferCreateInfo = {
+            vk::FramebufferCreateFlags(),
+            *m_pRenderPass,
+            static_cast<uint32_t>(attachments.size()),
+            attachments.data(),
+            m_framebufferWidth,
+            m_framebufferHeight,
+            1u,
+        };
+
+        m_pMyFramebuffer = fd::createFrameBuffer(pDevice, frameBufferCreateInfo);
+        m_pFramebuffer = m_pMyFramebuffer.get();
+    }
+
+    std::shared_ptr<vk::RenderPass> LightShadowAtlas::_createRenderPass(vk::ImageLayout initialLayout)
+    {
+        auto pDevice = pApp->getDevice();
+        //Load operation only clears the render area.
+        vk::AttachmentDescription depthAttachmentDes = {
+            vk::AttachmentDescriptionFlags(),
+            m_depthImageFormat,
+            vk::SampleCountFlagBits::e1,
+            vk::AttachmentLoadOp::eClear,
+            vk::AttachmentStoreOp::eStore,
+            vk::AttachmentLoadOp::eDontCare,
+            vk::AttachmentStoreOp::eDontCare,
+            initialLayout,
+            vk::ImageLayout::eDepthStencilReadOnlyOptimal
+        };
+
+        vk::AttachmentReference depthAttachmentRef = {
+            uint32_t(0),
+            vk::ImageLayout::eDepthStencilAttachmentOptimal
+        };
+
+        vk::SubpassDescription subpass = {
+            vk::SubpassDescriptionFlags(),       //flags
+            vk::PipelineBindPoint::eGraphics,    //pipelineBindPoint
+            0,                                   //inputAttachmentCount
+            nullptr,                             //pInputAttachments
+            0,                                   //colorAttachmentCount
+            nullptr,                             //pColorAttachments
+            nullptr,                             //pResolveAttachments
+            &depthAttachmentRef,                 //pDepthStencilAttachment
+            0,                                   //preserveAttachmentCount
+            nullptr                              //pPreserveAttachments
+        };
+
+        //Tiles are sampled by fragment shaders of last frame before they are rendered again.
+        std::array<vk::SubpassDependency, 2> dependencies = {
+            vk::SubpassDependency
+            {
+                VK_SUBPASS_EXTERNAL,
+                0,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+                vk::AccessFlagBits::eShaderRead,
+                vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+                vk::DependencyFlagBits::eByRegion
+            },
+            vk::SubpassDependency
+            {
+                0,
+                VK_SUBPASS_EXTERNAL,
+                vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+                vk::AccessFlagBits::eShaderRead,
+                vk::DependencyFlagBits::eByRegion
+            }
+        };
+
+        std::array<vk::AttachmentDescription, 1> attachmentDess = { depthAttachmentDes };
+        vk::RenderPassCreateInfo renderPassCreateInfo = {
+            vk::RenderPassCreateFlags(),
+            static_cast<uint32_t>(attachmentDess.size()),
+            attachmentDess.data(),
+            1u,
+            &subpass,
+            static_cast<uint32_t>(dependencies.size()),
+            dependencies.data()
+        };
+
+        return fd::createRenderPass(pDevice, renderPassCreateInfo);
+    }
+
+    void LightShadowAtlas::_pack()
+    {
+        //Big tiles are packed first, it wastes less space of the skyline.
+        std::vector<InstanceID> sortedLightIDs = m_tileLightIDs;
+        std::stable_sort(sortedLightIDs.begin(), sortedLightIDs.end(), [this](InstanceID lightID1, InstanceID lightID2)
+        {
+            const auto &tile1 = m_tiles.at(lightID1);
+            const auto &tile2 = m_tiles.at(lightID2);
+            return tile1.height > tile2.height || (tile1.height == tile2.height && tile1.width > tile2.width);
+        });
+        uint32_t maxSize = 0u;
+        for (const auto &pair : m_tiles)
+        {
+            maxSize = std::max(maxSize, std::max(pair.second.width, pair.second.height));
+        }
+
+        float atlasWidth = static_cast<float>(m_framebufferWidth);
+        float atlasHeight = static_cast<float>(m_framebufferHeight);
+        uint32_t shift = 0u;
+        Bool32 isPacked = VG_FALSE;
+        while (isPacked == VG_FALSE)
+        {
+            m_packer.reset(m_framebufferWidth, m_framebufferHeight);
+            isPacked = VG_TRUE;
+            for (const auto &lightID : sortedLightIDs)
+            {
+                auto &tile = m_tiles.at(lightID);
+                uint32_t width = std::max(tile.width >> shift, 1u);
+                uint32_t height = std::max(tile.height >> shift, 1u);
+                fd::SkylinePacker::Rect rect;
+                if (m_packer.pack(width + TILE_BORDER * 2u, height + TILE_BORDER * 2u, rect) == VG_FALSE)
+                {
+                    isPacked = VG_FALSE;
+                    break;
+                }
+                tile.area = fd::Rect2D(static_cast<float>(rect.x + TILE_BORDER) / atlasWidth
+                    , static_cast<float>(rect.y + TILE_BORDER) / atlasHeight
+                    , static_cast<float>(width) / atlasWidth
+                    , static_cast<float>(height) / atlasHeight
+                    );
+                //Border is cleared with the tile, so filtering near edges doesn't read stale depth.
+                tile.clearArea = fd::Rect2D(static_cast<float>(rect.x) / atlasWidth
+                    , static_cast<float>(rect.y) / atlasHeight
+                    , static_cast<float>(width + TILE_BORDER * 2u) / atlasWidth
+                    , static_cast<float>(height + TILE_BORDER * 2u) / atlasHeight
+                    );
+                tile.isRendered = VG_FALSE;
+            }
+            if (isPacked == VG_FALSE)
+            {
+                if ((maxSize >> shift) <= 1u)
+                    throw std::runtime_error("Shadow tiles can't be put into the shadow atlas.");
+                ++shift;
+            }
+        }
+        ++m_packVersion;
+        if (shift != 0u)
+        {
+            VG_LOG(plog::warning) << "Shadow tiles are shrunk by " << (1u << shift)
+                << " times to be put into the shadow atlas." << std::endl;
+        }
+    }
+} //vg
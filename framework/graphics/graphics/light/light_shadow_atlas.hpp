@@ -0,0 +1,95 @@
+#ifndef VG_LIGHT_SHADOW_ATLAS_HPP
+#define VG_LIGHT_SHADOW_ATLAS_HPP
+
+#include <foundation/rect_packer.hpp>
+#include "graphics/global.hpp"
+#include "graphics/texture/texture_2d.hpp"
+#include "graphics/render_target/pre_depth_target.hpp"
+
+namespace vg
+{
+    /*One large depth texture shared by 2D shadow maps of lights. Every light gets a tile of it and its depth
+      is rendered with the viewport of the tile, the projection of the light exported to shaders is moved into
+      the tile, so shaders sample the atlas like a separate shadow map.
+      Tiles remember a hash of the light and its casters, the render binder skips tiles whose hash isn't
+      changed since they were rendered. The hash only covers projectors of lights and transforms and meshes
+      of casters, invalidate() should be called when vertices or materials of casters are changed.
+      Packing moves tiles of all lights, lights compare getPackVersion() with the version they exported their
+      projections with and export them again when it is changed.
+      Coordinates out of the projection of a light fall in other tiles, so receivers should be covered by it.
+      The atlas should live longer than lights using it.*/
+    class LightShadowAtlas : public PreDepthTarget
+    {
+    public:
+        static const uint32_t DEFAULT_WIDTH;
+        static const uint32_t DEFAULT_HEIGHT;
+        static const vk::Format DEFAULT_FORMAT;
+        //Texels kept around every tile, so filtering near edges of a tile doesn't read other tiles.
+        static const uint32_t TILE_BORDER;
+
+        LightShadowAtlas(uint32_t width = DEFAULT_WIDTH
+            , uint32_t height = DEFAULT_HEIGHT
+            , vk::Format format = DEFAULT_FORMAT
+            );
+        const Texture2DDepthAttachment *getDepthTargetTexture() const;
+        /*The render pass returned by getRenderPass() clears the whole atlas, this one only clears its render
+          area and keeps other tiles. It can be used only after the atlas is cleared once.*/
+        const vk::RenderPass *getTileRenderPass() const;
+
+        /*Tiles are packed again when a tile is added or removed, all tiles are shrunk by half until they can
+          be put into the atlas. All tiles should be rendered again after packing.*/
+        void addTile(InstanceID lightID, uint32_t width, uint32_t height);
+        void removeTile(InstanceID lightID);
+        Bool32 hasTile(InstanceID lightID) const;
+        uint32_t getTileCount() const;
+        //It is increased every time tiles are packed.
+        uint32_t getPackVersion() const;
+        //Area of the tile in range [0, 1] of the atlas, it is the viewport to render the tile.
+        const fd::Rect2D &getTileArea(InstanceID lightID) const;
+        //Area of the tile with its border, it is the render area cleared when the tile is rendered alone.
+        const fd::Rect2D &getTileClearArea(InstanceID lightID) const;
+        //Projection matrix of the light followed by scale and offset in clip space moving it into the tile.
+        Matrix4x4 caculateTileProjMatrix(InstanceID lightID, const Matrix4x4 &projMatrix) const;
+
+        //It returns true when the tile hasn't been rendered with casters of the hash.
+        Bool32 isTileChanged(InstanceID lightID, uint64_t casterHash) const;
+        void setTileRendered(InstanceID lightID, uint64_t casterHash);
+        //It is true after the whole atlas is cleared once, tiles can be rendered alone after it.
+        Bool32 getIsCleared() const;
+        //It is called when the whole atlas is cleared, all tiles should be rendered again after it.
+        void resetTiles();
+        //All tiles will be rendered again.
+        void invalidate();
+    private:
+        struct _Tile
+        {
+            uint32_t width;
+            uint32_t height;
+            fd::Rect2D area;
+            fd::Rect2D clearArea;
+            Bool32 isRendered;
+            uint64_t casterHash;
+
+            _Tile(uint32_t width = 0u
+                , uint32_t height = 0u
+                );
+        };
+
+        std::shared_ptr<Texture2DDepthAttachment> m_pDepthTargetTex;
+        std::shared_ptr<vk::RenderPass> m_pMyRenderPass;
+        std::shared_ptr<vk::RenderPass> m_pTileRenderPass;
+        std::shared_ptr<vk::Framebuffer> m_pMyFramebuffer;
+        fd::SkylinePacker m_packer;
+        //Light ids in order of adding, it makes packing same for same tiles.
+        std::vector<InstanceID> m_tileLightIDs;
+        std::unordered_map<InstanceID, _Tile> m_tiles;
+        Bool32 m_isCleared;
+        uint32_t m_packVersion;
+
+        void _createObjs();
+        std::shared_ptr<vk::RenderPass> _createRenderPass(vk::ImageLayout initialLayout);
+        void _pack();
+    };
+} //vg
+
+#endif //VG_LIGHT_SHADOW_ATLAS_HPP
@@ -17,13 +17,18 @@ namespace vg
         , m_fov(fov)
         , m_range(range)
         , m_strength(1.0f)
+        , m_depthTextureWidth(depthTextureWidth)
+        , m_depthTextureHeight(depthTextureHeight)
+        , m_depthTextureFormat(format)
         , m_pDepthTarget()
         , m_refDepthTarget()
+        , m_pShadowAtlas()
+        , m_shadowAtlasPackVersion(0u)
+        , m_shadowTileMatrix(1.0f)
         , m_pProjector()
         , m_refProjector()
     {
-        m_pDepthTarget = std::shared_ptr<LightDepthTarget2D>{ new LightDepthTarget2D(depthTextureWidth, depthTextureHeight, format)};
-        m_refDepthTarget = m_pDepthTarget.get();
+        _createDepthTarget();
         m_pProjector = std::shared_ptr<Projector3>{new Projector3()};
         _setProjector();
         Matrix4x4 transform(1.0f);
@@ -40,8 +45,28 @@ namespace vg
         _apply();
     }
 
+    LightSpot3::~LightSpot3()
+    {
+        if (m_pShadowAtlas != nullptr)
+        {
+            m_pShadowAtlas->removeTile(getID());
+        }
+    }
+
     LightDepthRenderInfo LightSpot3::getDepthRenderInfo() const
     {
+        if (m_pShadowAtlas != nullptr)
+        {
+            LightDepthRenderInfo info = {
+                1u,
+                reinterpret_cast<const BaseProjector *const *>(&m_refProjector),
+                reinterpret_cast<const OnceRenderTarget *const *>(&m_pShadowAtlas),
+                nullptr,
+                0u,
+                m_pShadowAtlas,
+            };
+            return info;
+        }
         LightDepthRenderInfo info = {
             1u,
             reinterpret_cast<const BaseProjector *const *>(&m_refProjector),
@@ -50,6 +75,36 @@ namespace vg
         return info;
     }
 
+    LightShadowAtlas *LightSpot3::getShadowAtlas() const
+    {
+        return m_pShadowAtlas;
+    }
+
+    void LightSpot3::setShadowAtlas(LightShadowAtlas *pShadowAtlas)
+    {
+        if (m_pShadowAtlas == pShadowAtlas) return;
+        if (m_pShadowAtlas != nullptr)
+        {
+            m_pShadowAtlas->removeTile(getID());
+        }
+        m_pShadowAtlas = pShadowAtlas;
+        if (pShadowAtlas != nullptr)
+        {
+            pShadowAtlas->addTile(getID(), m_depthTextureWidth, m_depthTextureHeight);
+            _setShadowTile();
+            //Own depth texture isn't used by the atlas.
+            m_pDepthTarget = nullptr;
+            m_refDepthTarget = nullptr;
+        }
+        else
+        {
+            _createDepthTarget();
+        }
+        _setProjection();
+        _setDepthTexture();
+        _apply();
+    }
+
     float LightSpot3::getFOV() const
     {
         return m_fov;
@@ -92,6 +147,11 @@ namespace vg
 
         //sync transform between camera and projector.
         m_pProjector->setLocalToWorldMatrix(m_pTransform->getMatrixLocalToWorld());
+        //Packing of the shadow atlas moves tiles of all lights, eg. when other lights are added or removed.
+        if (m_pShadowAtlas != nullptr && m_pShadowAtlas->getPackVersion() != m_shadowAtlasPackVersion)
+        {
+            _setShadowTile();
+        }
         //sync projection data.
         _setProjection();
         _apply();
@@ -121,6 +181,11 @@ namespace vg
     void LightSpot3::_setProjection()
     {
         auto matrix = m_space.getVulkanProjMatrix(m_pProjector->getProjMatrix());
+        //Projection is moved into the tile, so shaders get coordinates of the atlas.
+        if (m_pShadowAtlas != nullptr)
+        {
+            matrix = m_shadowTileMatrix * matrix;
+        }
         if (m_data.hasData(VG_LIGHT_DATA_PROJECTION_NAME) == VG_FALSE) {
             LightDataInfo dataInfo = {
                 VG_LIGHT_DATA_PROJECTION_LAYOUT_PRORITY
@@ -134,6 +199,12 @@ namespace vg
         m_dataContentChanges[VG_LIGHT_DATA_PROJECTION_NAME] = VG_TRUE;
     }
 
+    void LightSpot3::_setShadowTile()
+    {
+        m_shadowTileMatrix = m_pShadowAtlas->caculateTileProjMatrix(getID(), Matrix4x4(1.0f));
+        m_shadowAtlasPackVersion = m_pShadowAtlas->getPackVersion();
+    }
+
     void LightSpot3::_setStrength()
     {
         if (m_data.hasData(VG_LIGHT_SPOT3_DATA_STRENGTH_NAME) == VG_FALSE)
@@ -155,7 +226,7 @@ namespace vg
         LightTextureInfo texInfo = {
             SamplerTextureType::TEX_2D,
             VG_LIGHT_TEXTURE_DEPTH_BINDING_PRIORITY,
-            m_pDepthTarget->getDepthTargetTexture()
+            m_pShadowAtlas != nullptr ? m_pShadowAtlas->getDepthTargetTexture() : m_pDepthTarget->getDepthTargetTexture()
             };
         if (m_data.hasTexture(VG_LIGHT_TEXTURE_DEPTH_NAME) == VG_FALSE)
         {
@@ -165,4 +236,10 @@ namespace vg
         }
         m_textureChanged = VG_TRUE;
     }
+
+    void LightSpot3::_createDepthTarget()
+    {
+        m_pDepthTarget = std::shared_ptr<LightDepthTarget2D>{ new LightDepthTarget2D(m_depthTextureWidth, m_depthTextureHeight, m_depthTextureFormat)};
+        m_refDepthTarget = m_pDepthTarget.get();
+    }
 } //vg
\ No newline at end of file
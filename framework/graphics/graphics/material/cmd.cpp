@@ -1,69 +1,31 @@
 #include "graphics/material/cmd.hpp"
 
-#include "graphics/util/util.hpp"
+#include <new>
+#include <type_traits>
+#include <algorithm>
+
 namespace vg
 {
-    template <typename T, typename ParentT, uint32_t parentPointOffset>
-    void addData(uint32_t &count
-         , uint32_t &capacity
-         , std::vector<T> &arr
-         , std::vector<uint32_t> *pToParentIndices
-         , std::vector<ParentT> *pParentArr
-         , uint32_t parentArrCount
-         , const T &newData
-         )
+    //Items are placed after the size with alignment of them, size is moved to end of them.
+    template <typename T>
+    size_t reserveItems(size_t &size, uint32_t count)
     {
-        if (count == capacity)
-        {
-            capacity = getNextCapacity(capacity);
-            arr.resize(capacity);
-            if (pParentArr != nullptr) {
-                pToParentIndices->resize(capacity);
-                for (uint32_t i = 0; i < count; ++i)
-                {
-                    auto &parent = (*pParentArr)[(*pToParentIndices)[i]];
-                    auto point = &(arr[i]);
-                    memcpy((char *)(&parent) + parentPointOffset, &point, sizeof(point));
-                }
-            }
-        }
-        auto &dstData = arr[count];
-        dstData = newData;
-        if (pParentArr != nullptr) {
-            auto pDst = &dstData;
-            uint32_t parentIndex = parentArrCount - 1;
-            ParentT * pParent = &((*pParentArr)[parentIndex]);
-            memcpy((char *)pParent + parentPointOffset, &pDst, sizeof(pDst));
-            (*pToParentIndices)[count] = parentIndex;
-        }
-        ++count;
+        size_t offset = (size + alignof(T) - 1u) & ~(alignof(T) - 1u);
+        size = offset + sizeof(T) * count;
+        return offset;
     }
 
-    template <typename T, typename ParentT, uint32_t parentPointOffset>
-    void addData(uint32_t &count
-         , uint32_t &capacity
-         , std::vector<std::vector<T>> &arr
-         , std::vector<ParentT> *pParentArr
-         , uint32_t parentArrCount
-         , uint32_t dataCount
-         , const T *pDatas
-         )
+    template <typename T>
+    T *copyItems(uint8_t *pMemory, size_t offset, uint32_t count, const T *pSrcItems)
     {
-        if (count == capacity)
+        static_assert(std::is_trivially_destructible<T>::value, "Items in cmd buffer are never destroyed.");
+        if (count == 0u) return nullptr;
+        T *pItems = reinterpret_cast<T *>(pMemory + offset);
+        for (uint32_t i = 0; i < count; ++i)
         {
-            capacity = getNextCapacity(capacity);
-            arr.resize(capacity);
-        }
-        auto &dstData = arr[count];
-        dstData.resize(dataCount);
-        memcpy(dstData.data(), pDatas, dataCount * sizeof(T));
-        if (pParentArr != nullptr) {
-            auto pDst = dstData.data();
-            uint32_t parentIndex = parentArrCount - 1;
-            ParentT * pParent = &((*pParentArr)[parentIndex]);
-            memcpy((char *)pParent + parentPointOffset, &pDst, sizeof(pDst));
+            new(pItems + i) T(pSrcItems[i]);
         }
-        ++count;
+        return pItems;
     }
 
     CmdInfo::CmdInfo()
@@ -126,6 +88,19 @@ namespace vg
 
     }
 
+    CmdGeometryBinding::CmdGeometryBinding(const vk::Buffer *pVertexBuffer
+        , uint32_t vertexBufferOffset
+        , const vk::Buffer *pIndexBuffer
+        , uint32_t indexBufferOffset
+        )
+        : pVertexBuffer(pVertexBuffer)
+        , vertexBufferOffset(vertexBufferOffset)
+        , pIndexBuffer(pIndexBuffer)
+        , indexBufferOffset(indexBufferOffset)
+    {
+
+    }
+
     RenderPassBeginInfo::RenderPassBeginInfo(const vk::RenderPass *pRenderPass
         , const vk::Framebuffer *pFramebuffer
         , uint32_t framebufferWidth
@@ -161,6 +136,8 @@ namespace vg
         , InstanceID objectID
         , const CmdDraw *pCmdDraw
         , const CmdDrawIndexed *pCmdDrawIndexed
+        , const CmdGeometryBinding *pGeometryBinding
+        , Bool32 omniDirectional
         )
         : pRenderPass(pRenderPass)
         , subPassIndex(subPassIndex)
@@ -178,6 +155,8 @@ namespace vg
         , objectID(objectID)
         , pCmdDraw(pCmdDraw)
         , pCmdDrawIndexed(pCmdDrawIndexed)
+        , pGeometryBinding(pGeometryBinding)
+        , omniDirectional(omniDirectional)
     {    
     }
 
@@ -187,83 +166,114 @@ namespace vg
     }
 
 
-    CmdBuffer::CmdBuffer()
-        : m_cmdInfoCount(0u)
-        , m_cmdInfoCapacity(0u)
-        , m_cmdInfos()
-
-        , m_renderPassBeginInfoCount(0u)
-        , m_renderPassBeginInfoCapacity(0u)
-        , m_renderPassBeginInfos()
-        , m_renderPassBeginInfoToCmdInfoIndices()
-
-        , m_renderPassInfoCount(0u)
-        , m_renderPassInfoCapacity(0u)
-        , m_renderPassInfos()
-        , m_renderPassInfoToCmdInfoIndices()
-
-        , m_renderPassEndInfoCount(0u)
-        , m_renderPassEndInfoCapacity(0u)
-        , m_renderPassEndInfos()
-        , m_renderPassEndInfoToCmdInfoIndices()
-
-        , m_clearValuesCount(0u)
-        , m_clearValuesCapacity(0u)
-        , m_clearValues()
-
-        , m_cmdDrawCount(0u)
-        , m_cmdDrawCapacity(0u)
-        , m_cmdDraws()
-        , m_cmdDrawToRenderPassInfoIndices()
-
-        , m_cmdDrawIndexedCount(0u)
-        , m_cmdDrawIndexedCapacity(0u)
-        , m_cmdDrawIndexeds()
-        , m_cmdDrawIndexedToRenderPassInfoIndices()
-
-        , m_barrierInfoCount(0u)
-        , m_barrierInfosCapacity(0u)
-        , m_barrierInfos()
-        , m_barrierInfoToCmdInfoIndices()
-
-        , m_memoryBarrierCount(0u)
-        , m_memoryBarrierCapacity(0u)
-        , m_memoryBarriers()
-
-        , m_bufferMemoryBarrierCount(0u)
-        , m_bufferMemoryBarrierCapacity(0u)
-        , m_bufferMemoryBarriers()
-
-        , m_imageMemoryBarrierCount(0u)
-        , m_imageMemoryBarrierCapacity(0u)
-        , m_imageMemoryBarriers()
+    const size_t CmdBuffer::DEFAULT_CHUNK_SIZE = 64u * 1024u;
+
+    CmdBuffer::ConstIterator::ConstIterator(const CmdBuffer *pCmdBuffer
+        , uint32_t chunkIndex
+        , size_t offset
+        )
+        : m_pCmdBuffer(pCmdBuffer)
+        , m_chunkIndex(chunkIndex)
+        , m_offset(offset)
+    {
+    }
+
+    const CmdInfo &CmdBuffer::ConstIterator::operator*() const
+    {
+        const auto &chunk = m_pCmdBuffer->m_chunks[m_chunkIndex];
+        return reinterpret_cast<const _CmdHeader *>(chunk.pMemory.get() + m_offset)->cmdInfo;
+    }
+
+    const CmdInfo *CmdBuffer::ConstIterator::operator->() const
+    {
+        return &(operator*());
+    }
+
+    CmdBuffer::ConstIterator &CmdBuffer::ConstIterator::operator++()
+    {
+        const auto &chunk = m_pCmdBuffer->m_chunks[m_chunkIndex];
+        m_offset += reinterpret_cast<const _CmdHeader *>(chunk.pMemory.get() + m_offset)->size;
+        //End of last used chunk is the end of the cmd buffer.
+        if (m_offset == chunk.usedSize && m_chunkIndex < m_pCmdBuffer->m_chunkIndex)
+        {
+            ++m_chunkIndex;
+            m_offset = 0u;
+        }
+        return *this;
+    }
+
+    bool CmdBuffer::ConstIterator::operator==(const ConstIterator &rhs) const
+    {
+        return m_pCmdBuffer == rhs.m_pCmdBuffer && m_chunkIndex == rhs.m_chunkIndex && m_offset == rhs.m_offset;
+    }
+
+    bool CmdBuffer::ConstIterator::operator!=(const ConstIterator &rhs) const
+    {
+        return !operator==(rhs);
+    }
+
+    CmdBuffer::Range::Range(ConstIterator first
+        , ConstIterator last
+        , uint32_t cmdCount
+        )
+        : first(first)
+        , last(last)
+        , cmdCount(cmdCount)
+    {
+    }
+
+    CmdBuffer::CmdBuffer(size_t chunkSize)
+        : m_chunkSize(chunkSize)
+        , m_chunks()
+        , m_chunkIndex(0u)
+        , m_cmdCount(0u)
     {    
     }    
 
     uint32_t CmdBuffer::getCmdCount() const
     {
-        return m_cmdInfoCount;
+        return m_cmdCount;
     }    
 
-    const CmdInfo *CmdBuffer::getCmdInfos() const
+    CmdBuffer::ConstIterator CmdBuffer::getFirstCmd() const
+    {
+        return ConstIterator(this, 0u, 0u);
+    }
+
+    CmdBuffer::ConstIterator CmdBuffer::getEndCmd() const
+    {
+        if (m_chunks.size() == 0u) return ConstIterator(this, 0u, 0u);
+        return ConstIterator(this, m_chunkIndex, m_chunks[m_chunkIndex].usedSize);
+    }
+
+    CmdBuffer::Range CmdBuffer::getRange() const
     {
-        return m_cmdInfos.data();
+        return Range(getFirstCmd(), getEndCmd(), m_cmdCount);
+    }
+
+    void CmdBuffer::splitRanges(uint32_t rangeCount, Range *pRanges) const
+    {
+        auto iterator = getFirstCmd();
+        for (uint32_t rangeIndex = 0u; rangeIndex < rangeCount; ++rangeIndex)
+        {
+            //First ranges get one more cmd when cmds can't be split evenly.
+            uint32_t cmdCount = m_cmdCount / rangeCount + (rangeIndex < m_cmdCount % rangeCount ? 1u : 0u);
+            auto &range = pRanges[rangeIndex];
+            range.first = iterator;
+            for (uint32_t i = 0u; i < cmdCount; ++i)
+            {
+                ++iterator;
+            }
+            range.last = iterator;
+            range.cmdCount = cmdCount;
+        }
     }
 
     void CmdBuffer::empty()
     {
-        m_cmdInfoCount =  0u;
-
-        m_renderPassBeginInfoCount = 0u;
-        m_renderPassInfoCount = 0u;
-        m_renderPassEndInfoCount = 0u;
-        m_cmdDrawCount = 0u;
-        m_cmdDrawIndexedCount = 0u;
-
-        m_barrierInfoCount = 0u;
-        m_memoryBarrierCount = 0u;
-        m_bufferMemoryBarrierCount = 0u;
-        m_imageMemoryBarrierCount = 0u;
+        m_chunkIndex = 0u;
+        if (m_chunks.size() != 0u) m_chunks[0].usedSize = 0u;
+        m_cmdCount = 0u;
     }
 
     void CmdBuffer::begin()
@@ -273,143 +283,112 @@ namespace vg
 
     void CmdBuffer::addCmd(CmdInfo cmdInfo)
     {
-        addData<CmdInfo, nullptr_t, 0>(m_cmdInfoCount, 
-            m_cmdInfoCapacity,
-            m_cmdInfos,
-            nullptr,
-            nullptr,
-            0,
-            cmdInfo
-            );
+        //Offsets of inlined data are got first, so the cmd is allocated once.
+        size_t size = sizeof(_CmdHeader);
+        size_t renderPassBeginInfoOffset = 0u;
+        size_t clearValuesOffset = 0u;
+        size_t renderPassInfoOffset = 0u;
+        size_t cmdDrawOffset = 0u;
+        size_t cmdDrawIndexedOffset = 0u;
+        size_t geometryBindingOffset = 0u;
+        size_t renderPassEndInfoOffset = 0u;
+        size_t barrierInfoOffset = 0u;
+        size_t memoryBarriersOffset = 0u;
+        size_t bufferMemoryBarriersOffset = 0u;
+        size_t imageMemoryBarriersOffset = 0u;
+
+        const auto pSrcRenderPassBeginInfo = cmdInfo.pRenderPassBeginInfo;
+        if (pSrcRenderPassBeginInfo != nullptr)
+        {
+            renderPassBeginInfoOffset = reserveItems<RenderPassBeginInfo>(size, 1u);
+            clearValuesOffset = reserveItems<vk::ClearValue>(size, pSrcRenderPassBeginInfo->clearValueCount);
+        }
+
+        const auto pSrcRenderPassInfo = cmdInfo.pRenderPassInfo;
+        if (pSrcRenderPassInfo != nullptr)
+        {
+            renderPassInfoOffset = reserveItems<RenderPassInfo>(size, 1u);
+            if (pSrcRenderPassInfo->pCmdDraw != nullptr)
+                cmdDrawOffset = reserveItems<CmdDraw>(size, 1u);
+            if (pSrcRenderPassInfo->pCmdDrawIndexed != nullptr)
+                cmdDrawIndexedOffset = reserveItems<CmdDrawIndexed>(size, 1u);
+            if (pSrcRenderPassInfo->pGeometryBinding != nullptr)
+                geometryBindingOffset = reserveItems<CmdGeometryBinding>(size, 1u);
+        }
+
+        if (cmdInfo.pRenderPassEndInfo != nullptr)
+        {
+            renderPassEndInfoOffset = reserveItems<RenderPassEndInfo>(size, 1u);
+        }
+
+        const auto pSrcBarrierInfo = cmdInfo.pBarrierInfo;
+        if (pSrcBarrierInfo != nullptr)
+        {
+            barrierInfoOffset = reserveItems<BarrierInfo>(size, 1u);
+            memoryBarriersOffset = reserveItems<vk::MemoryBarrier>(size, pSrcBarrierInfo->memoryBarrierCount);
+            bufferMemoryBarriersOffset = reserveItems<vk::BufferMemoryBarrier>(size, pSrcBarrierInfo->bufferMemoryBarrierCount);
+            imageMemoryBarriersOffset = reserveItems<vk::ImageMemoryBarrier>(size, pSrcBarrierInfo->imageMemoryBarrierCount);
+        }
+
+        //Keep header of next cmd aligned.
+        reserveItems<_CmdHeader>(size, 0u);
+
+        uint8_t *pMemory = _allocateCmd(size);
+        auto pHeader = new(pMemory) _CmdHeader();
+        pHeader->size = size;
+        auto &dstCmdInfo = pHeader->cmdInfo;
+
         //copy render pass begin info.
-        if (cmdInfo.pRenderPassBeginInfo != nullptr)
+        if (pSrcRenderPassBeginInfo != nullptr)
         {
-            addData<RenderPassBeginInfo, CmdInfo, offsetof(CmdInfo, pRenderPassBeginInfo)>(
-                m_renderPassBeginInfoCount,
-                m_renderPassBeginInfoCapacity,
-                m_renderPassBeginInfos,
-                &m_renderPassBeginInfoToCmdInfoIndices,
-                &m_cmdInfos,
-                m_cmdInfoCount,
-                *(cmdInfo.pRenderPassBeginInfo)
-            );
-
-            auto &renderPassBeginInfo = *(cmdInfo.pRenderPassBeginInfo);
-
-            auto clearValueCount = renderPassBeginInfo.clearValueCount;
-            auto pClearValues = renderPassBeginInfo.pClearValues;
-            addData<vk::ClearValue, RenderPassBeginInfo, offsetof(RenderPassBeginInfo, pClearValues)>(
-                m_clearValuesCount,
-                m_clearValuesCapacity,
-                m_clearValues,
-                &m_renderPassBeginInfos,
-                m_renderPassBeginInfoCount,
-                clearValueCount,
-                pClearValues
-            );
+            auto pRenderPassBeginInfo = copyItems(pMemory, renderPassBeginInfoOffset, 1u, pSrcRenderPassBeginInfo);
+            pRenderPassBeginInfo->pClearValues = copyItems(pMemory
+                , clearValuesOffset
+                , pSrcRenderPassBeginInfo->clearValueCount
+                , pSrcRenderPassBeginInfo->pClearValues
+                );
+            dstCmdInfo.pRenderPassBeginInfo = pRenderPassBeginInfo;
         }
 
         //copy render pass info
-        if (cmdInfo.pRenderPassInfo != nullptr)
+        if (pSrcRenderPassInfo != nullptr)
         {
-            addData<RenderPassInfo, CmdInfo, offsetof(CmdInfo, pRenderPassInfo)>(
-                m_renderPassInfoCount,
-                m_renderPassInfoCapacity,
-                m_renderPassInfos,
-                &m_renderPassInfoToCmdInfoIndices,
-                &m_cmdInfos,
-                m_cmdInfoCount,
-                *(cmdInfo.pRenderPassInfo)
-            );
-
-            auto &renderPassInfo = *(cmdInfo.pRenderPassInfo);
-
-            if (renderPassInfo.pCmdDraw != nullptr) {
-                addData<CmdDraw, RenderPassInfo, offsetof(RenderPassInfo, pCmdDraw)>(
-                    m_cmdDrawCount,
-                    m_cmdDrawCapacity,
-                    m_cmdDraws,
-                    &m_cmdDrawToRenderPassInfoIndices,
-                    &m_renderPassInfos,
-                    m_renderPassInfoCount,
-                    *(renderPassInfo.pCmdDraw)
-                );
-            }
-            if (renderPassInfo.pCmdDrawIndexed != nullptr) {
-                addData<CmdDrawIndexed, RenderPassInfo, offsetof(RenderPassInfo, pCmdDrawIndexed)>(
-                    m_cmdDrawIndexedCount,
-                    m_cmdDrawIndexedCapacity,
-                    m_cmdDrawIndexeds,
-                    &m_cmdDrawIndexedToRenderPassInfoIndices,
-                    &m_renderPassInfos,
-                    m_renderPassInfoCount,
-                    *(renderPassInfo.pCmdDrawIndexed)
-                );
-            }
+            auto pRenderPassInfo = copyItems(pMemory, renderPassInfoOffset, 1u, pSrcRenderPassInfo);
+            if (pSrcRenderPassInfo->pCmdDraw != nullptr)
+                pRenderPassInfo->pCmdDraw = copyItems(pMemory, cmdDrawOffset, 1u, pSrcRenderPassInfo->pCmdDraw);
+            if (pSrcRenderPassInfo->pCmdDrawIndexed != nullptr)
+                pRenderPassInfo->pCmdDrawIndexed = copyItems(pMemory, cmdDrawIndexedOffset, 1u, pSrcRenderPassInfo->pCmdDrawIndexed);
+            if (pSrcRenderPassInfo->pGeometryBinding != nullptr)
+                pRenderPassInfo->pGeometryBinding = copyItems(pMemory, geometryBindingOffset, 1u, pSrcRenderPassInfo->pGeometryBinding);
+            dstCmdInfo.pRenderPassInfo = pRenderPassInfo;
         }
 
         //copy render pass end info.
         if (cmdInfo.pRenderPassEndInfo != nullptr)
         {
-            addData<RenderPassEndInfo, CmdInfo, offsetof(CmdInfo, pRenderPassEndInfo)>(
-                m_renderPassEndInfoCount,
-                m_renderPassEndInfoCapacity,
-                m_renderPassEndInfos,
-                &m_renderPassEndInfoToCmdInfoIndices,
-                &m_cmdInfos,
-                m_cmdInfoCount,
-                *(cmdInfo.pRenderPassEndInfo)
-            );
+            dstCmdInfo.pRenderPassEndInfo = copyItems(pMemory, renderPassEndInfoOffset, 1u, cmdInfo.pRenderPassEndInfo);
         }
 
         //copy barrier info
-        if (cmdInfo.pBarrierInfo != nullptr)
+        if (pSrcBarrierInfo != nullptr)
         {
-            addData<BarrierInfo, CmdInfo, offsetof(CmdInfo, pBarrierInfo)>(
-                m_barrierInfoCount,
-                m_barrierInfosCapacity,
-                m_barrierInfos,
-                &m_barrierInfoToCmdInfoIndices,
-                &m_cmdInfos,
-                m_cmdInfoCount,
-                *(cmdInfo.pBarrierInfo)
-            );
-
-            auto memoryBarrierCount = cmdInfo.pBarrierInfo->memoryBarrierCount;
-            auto pMemoryBarriers = cmdInfo.pBarrierInfo->pMemoryBarriers;
-            addData<vk::MemoryBarrier, BarrierInfo, offsetof(BarrierInfo, pMemoryBarriers)>(
-                m_memoryBarrierCount,
-                m_memoryBarrierCapacity,
-                m_memoryBarriers,
-                &m_barrierInfos,
-                m_barrierInfoCount,
-                memoryBarrierCount,
-                pMemoryBarriers
-            );
-            
-            auto bufferMemoryBarrierCount = cmdInfo.pBarrierInfo->bufferMemoryBarrierCount;
-            auto pBufferMemoryBarriers = cmdInfo.pBarrierInfo->pBufferMemoryBarriers;
-            addData<vk::BufferMemoryBarrier, BarrierInfo, offsetof(BarrierInfo, pBufferMemoryBarriers)>(
-                m_bufferMemoryBarrierCount,
-                m_bufferMemoryBarrierCapacity,
-                m_bufferMemoryBarriers,
-                &m_barrierInfos,
-                m_barrierInfoCount,
-                bufferMemoryBarrierCount,
-                pBufferMemoryBarriers
-            );
-
-            auto imageMemoryBarrierCount = cmdInfo.pBarrierInfo->imageMemoryBarrierCount;
-            auto pImageMemoryBarriers = cmdInfo.pBarrierInfo->pImageMemoryBarriers;
-            addData<vk::ImageMemoryBarrier, BarrierInfo, offsetof(BarrierInfo, pImageMemoryBarriers)>(
-                m_imageMemoryBarrierCount,
-                m_imageMemoryBarrierCapacity,
-                m_imageMemoryBarriers,
-                &m_barrierInfos,
-                m_barrierInfoCount,
-                imageMemoryBarrierCount,
-                pImageMemoryBarriers
-            );
+            auto pBarrierInfo = copyItems(pMemory, barrierInfoOffset, 1u, pSrcBarrierInfo);
+            pBarrierInfo->pMemoryBarriers = copyItems(pMemory
+                , memoryBarriersOffset
+                , pSrcBarrierInfo->memoryBarrierCount
+                , pSrcBarrierInfo->pMemoryBarriers
+                );
+            pBarrierInfo->pBufferMemoryBarriers = copyItems(pMemory
+                , bufferMemoryBarriersOffset
+                , pSrcBarrierInfo->bufferMemoryBarrierCount
+                , pSrcBarrierInfo->pBufferMemoryBarriers
+                );
+            pBarrierInfo->pImageMemoryBarriers = copyItems(pMemory
+                , imageMemoryBarriersOffset
+                , pSrcBarrierInfo->imageMemoryBarrierCount
+                , pSrcBarrierInfo->pImageMemoryBarriers
+                );
+            dstCmdInfo.pBarrierInfo = pBarrierInfo;
         }
     }
     
@@ -419,71 +398,50 @@ namespace vg
 
     void CmdBuffer::clear()
     {
-        m_cmdInfoCount = 0u;
-        m_cmdInfoCapacity = 0u;
-        m_cmdInfos.clear();
-        m_cmdInfos.shrink_to_fit();
-
-        m_renderPassBeginInfoCount = 0u;
-        m_renderPassBeginInfoCapacity = 0u;
-        m_renderPassBeginInfos.clear();
-        m_renderPassBeginInfos.shrink_to_fit();
-        m_renderPassBeginInfoToCmdInfoIndices.clear();
-        m_renderPassBeginInfoToCmdInfoIndices.shrink_to_fit();
-
-        m_renderPassInfoCount = 0u;
-        m_renderPassInfoCapacity = 0u;
-        m_renderPassInfos.clear();
-        m_renderPassInfos.shrink_to_fit();
-        m_renderPassInfoToCmdInfoIndices.clear();
-        m_renderPassInfoToCmdInfoIndices.shrink_to_fit();
-
-        m_renderPassEndInfoCount = 0u;
-        m_renderPassEndInfoCapacity = 0u;
-        m_renderPassEndInfos.clear();
-        m_renderPassEndInfos.shrink_to_fit();
-        m_renderPassEndInfoToCmdInfoIndices.clear();
-        m_renderPassEndInfoToCmdInfoIndices.shrink_to_fit();
-
-        m_clearValuesCount = 0u;
-        m_clearValuesCapacity = 0u;
-        m_clearValues.clear();
-        m_clearValues.shrink_to_fit();
-
-        m_cmdDrawCount = 0u;
-        m_cmdDrawCapacity = 0u;
-        m_cmdDraws.clear();
-        m_cmdDraws.shrink_to_fit();
-        m_cmdDrawToRenderPassInfoIndices.clear();
-        m_cmdDrawToRenderPassInfoIndices.shrink_to_fit();
-
-        m_cmdDrawIndexedCount = 0u;
-        m_cmdDrawIndexedCapacity = 0u;
-        m_cmdDrawIndexeds.clear();
-        m_cmdDrawIndexeds.shrink_to_fit();
-        m_cmdDrawIndexedToRenderPassInfoIndices.clear();
-        m_cmdDrawIndexedToRenderPassInfoIndices.shrink_to_fit();
-
-        m_barrierInfoCount = 0u;
-        m_barrierInfosCapacity = 0u;
-        m_barrierInfos.clear();
-        m_barrierInfos.shrink_to_fit();
-        m_barrierInfoToCmdInfoIndices.clear();
-        m_barrierInfoToCmdInfoIndices.shrink_to_fit();
-
-        m_memoryBarrierCount = 0u;
-        m_memoryBarrierCapacity = 0u;
-        m_memoryBarriers.clear();
-        m_memoryBarriers.shrink_to_fit();
-
-        m_bufferMemoryBarrierCount = 0u;
-        m_bufferMemoryBarrierCapacity = 0u;
-        m_bufferMemoryBarriers.clear();
-        m_bufferMemoryBarriers.shrink_to_fit();
-
-        m_imageMemoryBarrierCount = 0u;
-        m_imageMemoryBarrierCapacity = 0u;
-        m_imageMemoryBarriers.clear();
-        m_imageMemoryBarriers.shrink_to_fit();
+        m_chunks.clear();
+        m_chunks.shrink_to_fit();
+        m_chunkIndex = 0u;
+        m_cmdCount = 0u;
+    }
+
+    size_t CmdBuffer::getChunkSize() const
+    {
+        return m_chunkSize;
+    }
+
+    size_t CmdBuffer::getCapacity() const
+    {
+        size_t capacity = 0u;
+        for (const auto &chunk : m_chunks)
+        {
+            capacity += chunk.size;
+        }
+        return capacity;
+    }
+
+    uint8_t *CmdBuffer::_allocateCmd(size_t size)
+    {
+        if (m_chunks.size() == 0u || m_chunks[m_chunkIndex].size - m_chunks[m_chunkIndex].usedSize < size)
+        {
+            //Used chunks are never empty, so the cmd is put into current chunk when it is empty.
+            uint32_t chunkIndex = m_chunkIndex;
+            if (m_chunks.size() != 0u && m_chunks[m_chunkIndex].usedSize != 0u) ++chunkIndex;
+            //Chunk too small for the cmd is kept for following cmds.
+            if (chunkIndex == static_cast<uint32_t>(m_chunks.size()) || m_chunks[chunkIndex].size < size)
+            {
+                _Chunk chunk;
+                chunk.size = std::max(m_chunkSize, size);
+                chunk.pMemory.reset(new uint8_t[chunk.size]);
+                chunk.usedSize = 0u;
+                m_chunks.insert(m_chunks.begin() + chunkIndex, std::move(chunk));
+            }
+            m_chunkIndex = chunkIndex;
+            m_chunks[m_chunkIndex].usedSize = 0u;
+        }
+        auto &chunk = m_chunks[m_chunkIndex];
+        uint8_t *pMemory = chunk.pMemory.get() + chunk.usedSize;
+        chunk.usedSize += size;
+        ++m_cmdCount;
+        return pMemory;
     }
-} //vg
\ No newline at end of file
+} //vg
@@ -1,6 +1,7 @@
 #ifndef VG_RENDER_PASS_INFO_HPP
 #define VG_RENDER_PASS_INFO_HPP
 
+#include <memory>
 #include "graphics/global.hpp"
 #include "graphics/pass/pass.hpp"
 #include "graphics/mesh/mesh.hpp"
@@ -60,6 +61,21 @@ namespace vg
         );
     };
 
+    //Buffers replacing the buffers of the mesh when its vertices and indices are bound, eg. allocations of a transient buffer.
+    struct CmdGeometryBinding
+    {
+        const vk::Buffer *pVertexBuffer;
+        uint32_t vertexBufferOffset;
+        const vk::Buffer *pIndexBuffer;
+        uint32_t indexBufferOffset;
+
+        CmdGeometryBinding(const vk::Buffer *pVertexBuffer = nullptr
+            , uint32_t vertexBufferOffset = 0u
+            , const vk::Buffer *pIndexBuffer = nullptr
+            , uint32_t indexBufferOffset = 0u
+            );
+    };
+
     struct RenderPassBeginInfo
     {
         const vk::RenderPass *pRenderPass;
@@ -99,6 +115,9 @@ namespace vg
         InstanceID objectID;
         const CmdDraw *pCmdDraw;
         const CmdDrawIndexed *pCmdDrawIndexed;
+        const CmdGeometryBinding *pGeometryBinding;
+        //Projection covers all directions (eg. point lights), so clusters of the mesh aren't culled with projMatrix.
+        Bool32 omniDirectional;
             
         RenderPassInfo(const vk::RenderPass *pRenderPass = nullptr
             , uint32_t subPassIndex = 0u
@@ -116,6 +135,8 @@ namespace vg
             , InstanceID objectID = InstanceID()
             , const CmdDraw *pCmdDraw = nullptr
             , const CmdDrawIndexed *pCmdDrawIndexed = nullptr
+            , const CmdGeometryBinding *pGeometryBinding = nullptr
+            , Bool32 omniDirectional = VG_FALSE
             );
     };
 
@@ -133,68 +154,84 @@ namespace vg
         CmdInfo();
     };
 
+    /*Cmds are appended into a stream of chunks with their infos, clear values, draws and barriers inlined
+      after them, so pointers in a cmd point to memory of the same cmd. Chunks never move and are kept when
+      it begins again, so adding cmds doesn't allocate from heap after first frames and infos got from it
+      are valid until it begins again or is cleared.*/
     class CmdBuffer 
     {
     public:
-        CmdBuffer();
+        static const size_t DEFAULT_CHUNK_SIZE;
+
+        class ConstIterator
+        {
+        public:
+            ConstIterator(const CmdBuffer *pCmdBuffer = nullptr
+                , uint32_t chunkIndex = 0u
+                , size_t offset = 0u
+                );
+            const CmdInfo &operator*() const;
+            const CmdInfo *operator->() const;
+            ConstIterator &operator++();
+            bool operator==(const ConstIterator &rhs) const;
+            bool operator!=(const ConstIterator &rhs) const;
+        private:
+            const CmdBuffer *m_pCmdBuffer;
+            uint32_t m_chunkIndex;
+            size_t m_offset;
+        };
+
+        //Cmds in [first, last) of a cmd buffer, a cmd buffer can be split into ranges recorded into different command buffers.
+        struct Range
+        {
+            ConstIterator first;
+            ConstIterator last;
+            uint32_t cmdCount;
+
+            Range(ConstIterator first = ConstIterator()
+                , ConstIterator last = ConstIterator()
+                , uint32_t cmdCount = 0u
+                );
+        };
+
+        CmdBuffer(size_t chunkSize = DEFAULT_CHUNK_SIZE);
         uint32_t getCmdCount() const;
-        const CmdInfo *getCmdInfos() const;
+        ConstIterator getFirstCmd() const;
+        ConstIterator getEndCmd() const;
+        Range getRange() const;
+        //Cmds are split into ranges in order with nearly same cmd counts, some of them are empty when there are fewer cmds than ranges.
+        void splitRanges(uint32_t rangeCount, Range *pRanges) const;
         void empty();
         void begin();
         void addCmd(CmdInfo cmdInfo);
         void end();
         void clear();
+
+        size_t getChunkSize() const;
+        //Bytes of memory of all chunks.
+        size_t getCapacity() const;
     
     private:
-        uint32_t m_cmdInfoCount;
-        uint32_t m_cmdInfoCapacity;
-        std::vector<CmdInfo> m_cmdInfos;
-
-        uint32_t m_renderPassBeginInfoCount;
-        uint32_t m_renderPassBeginInfoCapacity;
-        std::vector<RenderPassBeginInfo> m_renderPassBeginInfos;
-        std::vector<uint32_t> m_renderPassBeginInfoToCmdInfoIndices;
-
-        uint32_t m_renderPassInfoCount;
-        uint32_t m_renderPassInfoCapacity;
-        std::vector<RenderPassInfo> m_renderPassInfos;
-        std::vector<uint32_t> m_renderPassInfoToCmdInfoIndices;
-
-        uint32_t m_renderPassEndInfoCount;
-        uint32_t m_renderPassEndInfoCapacity;
-        std::vector<RenderPassEndInfo> m_renderPassEndInfos;
-        std::vector<uint32_t> m_renderPassEndInfoToCmdInfoIndices;
-
-        uint32_t m_clearValuesCount;
-        uint32_t m_clearValuesCapacity;
-        std::vector<std::vector<vk::ClearValue>> m_clearValues;
-
-        uint32_t m_cmdDrawCount;
-        uint32_t m_cmdDrawCapacity;
-        std::vector<CmdDraw> m_cmdDraws;
-        std::vector<uint32_t> m_cmdDrawToRenderPassInfoIndices;
-
-        uint32_t m_cmdDrawIndexedCount;
-        uint32_t m_cmdDrawIndexedCapacity;
-        std::vector<CmdDrawIndexed> m_cmdDrawIndexeds;
-        std::vector<uint32_t> m_cmdDrawIndexedToRenderPassInfoIndices;
-
-        uint32_t m_barrierInfoCount;
-        uint32_t m_barrierInfosCapacity;
-        std::vector<BarrierInfo> m_barrierInfos;
-        std::vector<uint32_t> m_barrierInfoToCmdInfoIndices;
-
-        uint32_t m_memoryBarrierCount;
-        uint32_t m_memoryBarrierCapacity;
-        std::vector<std::vector<vk::MemoryBarrier>> m_memoryBarriers;
-
-        uint32_t m_bufferMemoryBarrierCount;
-        uint32_t m_bufferMemoryBarrierCapacity;
-        std::vector<std::vector<vk::BufferMemoryBarrier>> m_bufferMemoryBarriers;
-
-        uint32_t m_imageMemoryBarrierCount;
-        uint32_t m_imageMemoryBarrierCapacity;
-        std::vector<std::vector<vk::ImageMemoryBarrier>> m_imageMemoryBarriers;
+        struct _Chunk
+        {
+            std::unique_ptr<uint8_t[]> pMemory;
+            size_t size;
+            size_t usedSize;
+        };
+
+        //Header of a cmd in the stream, size includes the header and inlined data and keeps next header aligned.
+        struct _CmdHeader
+        {
+            CmdInfo cmdInfo;
+            size_t size;
+        };
+
+        size_t m_chunkSize;
+        std::vector<_Chunk> m_chunks;
+        uint32_t m_chunkIndex;
+        uint32_t m_cmdCount;
+
+        uint8_t *_allocateCmd(size_t size);
     };
 } //vg
 
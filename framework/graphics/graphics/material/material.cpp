@@ -12,10 +12,8 @@ namespace vg
         , uint32_t subMeshIndex
         , Bool32 hasClipRect
         , const fd::Rect2D clipRect
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        , fd::CostTimer *pPreparingPipelineCostTimer
-        , fd::CostTimer *pPreparingCommandBufferCostTimer
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        , fd::Viewport viewport
+        , Bool32 omniDirectional
         )
         : pProjMatrix(pProjMatrix)
         , pViewMatrix(pViewMatrix)
@@ -27,10 +25,8 @@ namespace vg
         , subMeshIndex(subMeshIndex)
         , hasClipRect(hasClipRect)
         , clipRect(clipRect)
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        , pPreparingPipelineCostTimer(pPreparingPipelineCostTimer)
-        , pPreparingCommandBufferCostTimer(pPreparingCommandBufferCostTimer)
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        , viewport(viewport)
+        , omniDirectional(omniDirectional)
     {
     }
 
@@ -222,9 +218,15 @@ namespace vg
             trunkRenderPassInfo.modelMatrix = *(info.pModelMatrix);
             trunkRenderPassInfo.pMesh = info.pMesh;
             trunkRenderPassInfo.subMeshIndex = info.subMeshIndex;
-            trunkRenderPassInfo.viewport = fd::Viewport();
-            trunkRenderPassInfo.scissor = info.hasClipRect ? info.clipRect : fd::Rect2D();
+            trunkRenderPassInfo.viewport = info.viewport;
+            fd::Rect2D clipRect = info.hasClipRect ? info.clipRect : fd::Rect2D();
+            trunkRenderPassInfo.scissor = fd::Rect2D(info.viewport.x + clipRect.x * info.viewport.width
+                , info.viewport.y + clipRect.y * info.viewport.height
+                , clipRect.width * info.viewport.width
+                , clipRect.height * info.viewport.height
+                );
             trunkRenderPassInfo.objectID = info.objectID;
+            trunkRenderPassInfo.omniDirectional = info.omniDirectional;
             CmdInfo cmdInfo;
             cmdInfo.pRenderPassInfo = &trunkRenderPassInfo;
             result.pTrunkRenderPassCmdBuffer->addCmd(cmdInfo);
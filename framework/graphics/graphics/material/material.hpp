@@ -25,10 +25,10 @@ namespace vg
             uint32_t subMeshIndex;
             Bool32 hasClipRect;
             const fd::Rect2D clipRect;
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-            fd::CostTimer *pPreparingPipelineCostTimer;
-            fd::CostTimer *pPreparingCommandBufferCostTimer;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+            //Viewport in the framebuffer, the clip rect is in range of it.
+            fd::Viewport viewport;
+            //It is true when the projection is omni-directional, eg. for point lights.
+            Bool32 omniDirectional;
 
             BindInfo( uint32_t framebufferWidth = 0u
                 , uint32_t framebufferHeight = 0u
@@ -40,10 +40,8 @@ namespace vg
                 , uint32_t subMeshIndex = 0u
                 , Bool32 hasClipRect = VG_FALSE
                 , const fd::Rect2D clipRect = fd::Rect2D()
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                , fd::CostTimer *pPreparingPipelineCostTimer = nullptr
-                , fd::CostTimer *pPreparingCommandBufferCostTimer = nullptr
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                , fd::Viewport viewport = fd::Viewport()
+                , Bool32 omniDirectional = VG_FALSE
                 );
         };
     
@@ -5,6 +5,9 @@ namespace vg
     std::shared_ptr<MaterialPreDepthDefault> pDefaultPreDepthMaterial = nullptr;
     std::shared_ptr<MaterialLightingDepthDefault> pDefaultLightingDepthMaterial = nullptr;
     std::shared_ptr<MaterialLightingPointDistDefault> pDefaultLightingPointDistMaterial = nullptr;
+    std::shared_ptr<MaterialLightingPointDistFaceDefault> pDefaultLightingPointDistFaceMaterial = nullptr;
+    std::shared_ptr<MaterialDeferredCompositionDefault> pDefaultDeferredCompositionMaterial = nullptr;
+    std::shared_ptr<MaterialDeferredResultDefault> pDefaultDeferredResultMaterial = nullptr;
 
     MaterialPreDepthDefault::MaterialPreDepthDefault()
         : Material(VG_FALSE)
@@ -39,6 +42,39 @@ namespace vg
         _addPass(m_pMainPass);
     }
 
+    MaterialLightingPointDistFaceDefault::MaterialLightingPointDistFaceDefault()
+        : Material(VG_FALSE)
+    {
+        _removePass(m_pMainPass);
+        m_pMyMainShader = pDefaultLightingPointDistFaceShader;
+        m_pMainShader = m_pMyMainShader.get();
+        m_pMyMainPass = pDefaultLightingPointDistFacePass;
+        m_pMainPass = m_pMyMainPass.get();
+        _addPass(m_pMainPass);
+    }
+
+    MaterialDeferredCompositionDefault::MaterialDeferredCompositionDefault()
+        : Material(VG_FALSE)
+    {
+        _removePass(m_pMainPass);
+        m_pMyMainShader = pDefaultDeferredCompositionShader;
+        m_pMainShader = m_pMyMainShader.get();
+        m_pMyMainPass = pDefaultDeferredCompositionPass;
+        m_pMainPass = m_pMyMainPass.get();
+        _addPass(m_pMainPass);
+    }
+
+    MaterialDeferredResultDefault::MaterialDeferredResultDefault()
+        : Material(VG_FALSE)
+    {
+        _removePass(m_pMainPass);
+        m_pMyMainShader = pDefaultDeferredResultShader;
+        m_pMainShader = m_pMyMainShader.get();
+        m_pMyMainPass = pDefaultDeferredResultPass;
+        m_pMainPass = m_pMyMainPass.get();
+        _addPass(m_pMainPass);
+    }
+
     void createDefaultMaterials()
     {
         //Pre depth material.
@@ -61,6 +97,27 @@ namespace vg
                 new MaterialLightingPointDistDefault()
             };
         }
+
+        //Light point distance per face material
+        {
+            pDefaultLightingPointDistFaceMaterial = std::shared_ptr<MaterialLightingPointDistFaceDefault>{
+                new MaterialLightingPointDistFaceDefault()
+            };
+        }
+
+        //Deferred composition material
+        {
+            pDefaultDeferredCompositionMaterial = std::shared_ptr<MaterialDeferredCompositionDefault>{
+                new MaterialDeferredCompositionDefault()
+            };
+        }
+
+        //Deferred result material
+        {
+            pDefaultDeferredResultMaterial = std::shared_ptr<MaterialDeferredResultDefault>{
+                new MaterialDeferredResultDefault()
+            };
+        }
         
     }
 
@@ -69,5 +126,8 @@ namespace vg
         pDefaultPreDepthMaterial = nullptr;
         pDefaultLightingDepthMaterial = nullptr;
         pDefaultLightingPointDistMaterial = nullptr;
+        pDefaultLightingPointDistFaceMaterial = nullptr;
+        pDefaultDeferredCompositionMaterial = nullptr;
+        pDefaultDeferredResultMaterial = nullptr;
     }
 } //vg
\ No newline at end of file
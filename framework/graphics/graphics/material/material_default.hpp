@@ -27,9 +27,33 @@ namespace vg
     private:
     };
 
+    class MaterialLightingPointDistFaceDefault : public vg::Material
+    {
+    public:
+        MaterialLightingPointDistFaceDefault();
+    private:
+    };
+
+    class MaterialDeferredCompositionDefault : public vg::Material
+    {
+    public:
+        MaterialDeferredCompositionDefault();
+    private:
+    };
+
+    class MaterialDeferredResultDefault : public vg::Material
+    {
+    public:
+        MaterialDeferredResultDefault();
+    private:
+    };
+
     extern std::shared_ptr<MaterialPreDepthDefault> pDefaultPreDepthMaterial;
     extern std::shared_ptr<MaterialLightingDepthDefault> pDefaultLightingDepthMaterial;
     extern std::shared_ptr<MaterialLightingPointDistDefault> pDefaultLightingPointDistMaterial;
+    extern std::shared_ptr<MaterialLightingPointDistFaceDefault> pDefaultLightingPointDistFaceMaterial;
+    extern std::shared_ptr<MaterialDeferredCompositionDefault> pDefaultDeferredCompositionMaterial;
+    extern std::shared_ptr<MaterialDeferredResultDefault> pDefaultDeferredResultMaterial;
 
     extern void createDefaultMaterials();
     extern void destroyDefaultMaterials();
@@ -88,6 +88,31 @@ namespace vg
         return m_pIndexData->getSubIndexDataCount();
     }
 
+    uint32_t ContentMesh::getLODCount() const
+    {
+        return 1u;
+    }
+
+    uint32_t ContentMesh::getLODSubMeshOffset(uint32_t lodLevel) const
+    {
+        return 0u;
+    }
+
+    uint32_t ContentMesh::getClusterCount(uint32_t subMeshIndex) const
+    {
+        return 0u;
+    }
+
+    const fd::MeshCluster *ContentMesh::getClusters(uint32_t subMeshIndex) const
+    {
+        return nullptr;
+    }
+
+    Bool32 ContentMesh::getIsClusterConeCulling() const
+    {
+        return VG_FALSE;
+    }
+
     VertexData *ContentMesh::getVertexData() const
     {
         return m_pVertexData.get();
@@ -174,6 +199,45 @@ namespace vg
     }
 
 //SepMesh
+    SepMesh::OptimizeInfo::OptimizeInfo(Bool32 optimizeVertexCache
+        , Bool32 optimizeOverdraw
+        , Bool32 optimizeVertexFetch
+        , Bool32 deduplicateVertices
+        , uint32_t cacheSize
+        , uint32_t parallelIndexCountThreshold
+        )
+        : optimizeVertexCache(optimizeVertexCache)
+        , optimizeOverdraw(optimizeOverdraw)
+        , optimizeVertexFetch(optimizeVertexFetch)
+        , deduplicateVertices(deduplicateVertices)
+        , cacheSize(cacheSize)
+        , parallelIndexCountThreshold(parallelIndexCountThreshold)
+    {
+
+    }
+
+    SepMesh::LODInfo::LODInfo(std::vector<float> indexCountRatios
+        , float targetError
+        )
+        : indexCountRatios(indexCountRatios)
+        , targetError(targetError)
+    {
+
+    }
+
+    SepMesh::ClusterInfo::ClusterInfo(Bool32 buildClusters
+        , Bool32 coneCulling
+        , uint32_t maxVertexCount
+        , uint32_t maxTriangleCount
+        )
+        : buildClusters(buildClusters)
+        , coneCulling(coneCulling)
+        , maxVertexCount(maxVertexCount)
+        , maxTriangleCount(maxTriangleCount)
+    {
+
+    }
+
     SepMesh::SepMesh(vk::MemoryPropertyFlags bufferMemoryPropertyFlags)
         : InternalContentMesh(bufferMemoryPropertyFlags)
         , m_vertexCount(0u)
@@ -182,11 +246,19 @@ namespace vg
         , m_subMeshInfos()
         , m_multipliedColor(COLOR_WHITE) //default multiplied color should be (1, 1, 1, 1)
         , m_addedColor()
+        , m_vertexLayoutPolicy(VertexLayoutPolicy::SEPARATE)
+        , m_isCacheMemory(VG_FALSE)
+        , m_optimizeInfo()
+        , m_lodInfo()
+        , m_clusterInfo()
         , m_applied(VG_FALSE)
         , m_appliedVertexCount(0u)
         , m_appliedSubMeshCount(0u)
+        , m_appliedLODCount(1u)
         , m_layoutBindingInfos()
         , m_usingSubMeshInfos()
+        , m_clusters()
+        , m_clusterOffsets()
     {
         _createMeshData();
         setSubMeshCount(1u);
@@ -343,15 +415,120 @@ namespace vg
         // m_applied = VG_FALSE;
     }
 
+    const SepMesh::LODInfo &SepMesh::getLODInfo() const
+    {
+        return m_lodInfo;
+    }
+
+    void SepMesh::setLODInfo(const LODInfo &value)
+    {
+        m_lodInfo = value;
+        m_applied = VG_FALSE;
+    }
+
+    uint32_t SepMesh::getLODCount() const
+    {
+        return m_appliedLODCount;
+    }
+
+    uint32_t SepMesh::getLODSubMeshOffset(uint32_t lodLevel) const
+    {
+#ifdef DEBUG
+        if (lodLevel >= m_appliedLODCount)
+            throw std::range_error("The lodLevel out of range of the applied LOD count.");
+#endif // DEBUG
+        return lodLevel * m_appliedSubMeshCount;
+    }
+
+    const SepMesh::ClusterInfo &SepMesh::getClusterInfo() const
+    {
+        return m_clusterInfo;
+    }
+
+    void SepMesh::setClusterInfo(const ClusterInfo &value)
+    {
+        m_clusterInfo = value;
+        m_applied = VG_FALSE;
+    }
+
+    uint32_t SepMesh::getClusterCount(uint32_t subMeshIndex) const
+    {
+        if (subMeshIndex + 1u >= static_cast<uint32_t>(m_clusterOffsets.size())) return 0u;
+        return m_clusterOffsets[subMeshIndex + 1u] - m_clusterOffsets[subMeshIndex];
+    }
+
+    const fd::MeshCluster *SepMesh::getClusters(uint32_t subMeshIndex) const
+    {
+        if (getClusterCount(subMeshIndex) == 0u) return nullptr;
+        return m_clusters.data() + m_clusterOffsets[subMeshIndex];
+    }
+
+    Bool32 SepMesh::getIsClusterConeCulling() const
+    {
+        return m_clusterInfo.coneCulling;
+    }
+
+    const SepMesh::OptimizeInfo &SepMesh::getOptimizeInfo() const
+    {
+        return m_optimizeInfo;
+    }
+
+    void SepMesh::setOptimizeInfo(const OptimizeInfo &value)
+    {
+        m_optimizeInfo = value;
+        m_applied = VG_FALSE;
+    }
+
+    fd::VertexCacheStatistics SepMesh::analyzeVertexCache(uint32_t subMeshIndex, uint32_t cacheSize) const
+    {
+#ifdef DEBUG
+        _verifySubMeshIndex(subMeshIndex);
+#endif // DEBUG
+        const auto &indices = m_subMeshInfos[subMeshIndex].indices;
+        return fd::analyzeVertexCache(indices.data(), static_cast<uint32_t>(indices.size()), m_vertexCount, cacheSize);
+    }
+
+    VertexLayoutPolicy SepMesh::getVertexLayoutPolicy() const
+    {
+        return m_vertexLayoutPolicy;
+    }
+
+    void SepMesh::setVertexLayoutPolicy(VertexLayoutPolicy value)
+    {
+        if (m_vertexLayoutPolicy == value) return;
+        m_vertexLayoutPolicy = value;
+        m_applied = VG_FALSE;
+    }
+
+    Bool32 SepMesh::getIsCacheMemory() const
+    {
+        return m_isCacheMemory;
+    }
+
+    void SepMesh::setIsCacheMemory(Bool32 value)
+    {
+        if (m_isCacheMemory == value) return;
+        m_isCacheMemory = value;
+        m_applied = VG_FALSE;
+    }
+
     void SepMesh::apply(Bool32 makeUnreadable)
     {
         if (m_applied == VG_FALSE)
         {
+            _optimizeMeshData();
+
             m_appliedVertexCount = m_vertexCount;
 
             m_usingSubMeshInfos = m_subMeshInfos;
             m_appliedSubMeshCount = m_subMeshCount;
 
+            //append LOD sub meshes
+            _createLODSubMeshInfos();
+
+            //build clusters of all sub meshes including LOD sub meshes.
+            _createClusters();
+
             //sort layout binding infos
             _sortLayoutBindingInfos();
 
@@ -388,41 +565,254 @@ namespace vg
         m_pData = std::shared_ptr<MeshData>(new MeshData());
     }
 
+    void SepMesh::_optimizeMeshData()
+    {
+        const auto &info = m_optimizeInfo;
+        uint32_t vertexCount = m_vertexCount;
+        uint32_t subMeshCount = m_subMeshCount;
+        if (vertexCount == 0u) return;
+
+        //Reorder triangles of every sub mesh, large sub meshes are optimized on the default thread pool.
+        if (info.optimizeVertexCache == VG_TRUE)
+        {
+            const float *pPositions = nullptr;
+            std::vector<Vector3> positions;
+            if (info.optimizeOverdraw == VG_TRUE && hasData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME))
+            {
+                positions = getData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME);
+                if (static_cast<uint32_t>(positions.size()) >= vertexCount) pPositions = reinterpret_cast<const float *>(positions.data());
+            }
+
+            auto optimizeSubMesh = [this, &info, vertexCount, pPositions](uint32_t subMeshIndex)
+            {
+                auto &indices = m_subMeshInfos[subMeshIndex].indices;
+                uint32_t indexCount = static_cast<uint32_t>(indices.size());
+                std::vector<uint32_t> optimizedIndices(indexCount);
+                std::vector<uint32_t> clusterOffsets;
+                fd::optimizeVertexCache(optimizedIndices.data(), indices.data(), indexCount, vertexCount, info.cacheSize, 
+                    pPositions != nullptr ? &clusterOffsets : nullptr);
+                if (pPositions != nullptr)
+                {
+                    fd::optimizeOverdraw(indices.data(), optimizedIndices.data(), indexCount, pPositions,
+                        static_cast<uint32_t>(sizeof(Vector3)), clusterOffsets);
+                }
+                else
+                {
+                    indices.swap(optimizedIndices);
+                }
+            };
+
+            std::vector<uint32_t> parallelSubMeshIndices;
+            for (uint32_t i = 0; i < subMeshCount; ++i)
+            {
+                const auto &subMeshInfo = m_subMeshInfos[i];
+                if (subMeshInfo.topology != PrimitiveTopology::TRIANGLE_LIST) continue;
+#if defined(DEBUG)
+                auto statistics = analyzeVertexCache(i, info.cacheSize);
+                VG_LOG(plog::debug) << "Sub mesh " << i << " vertex cache before optimization, ACMR: " << statistics.acmr 
+                    << ", ATVR: " << statistics.atvr << std::endl;
+#endif //DEBUG
+                if (static_cast<uint32_t>(subMeshInfo.indices.size()) > info.parallelIndexCountThreshold)
+                {
+                    parallelSubMeshIndices.push_back(i);
+                }
+                else
+                {
+                    optimizeSubMesh(i);
+                }
+            }
+            //Each index of the pool writes only indices of its own sub mesh.
+            fd::getDefaultThreadPool().parallelFor(static_cast<uint32_t>(parallelSubMeshIndices.size()), [&](uint32_t index) {
+                optimizeSubMesh(parallelSubMeshIndices[index]);
+            });
+#if defined(DEBUG)
+            for (uint32_t i = 0; i < subMeshCount; ++i)
+            {
+                if (m_subMeshInfos[i].topology != PrimitiveTopology::TRIANGLE_LIST) continue;
+                auto statistics = analyzeVertexCache(i, info.cacheSize);
+                VG_LOG(plog::debug) << "Sub mesh " << i << " vertex cache after optimization, ACMR: " << statistics.acmr 
+                    << ", ATVR: " << statistics.atvr << std::endl;
+            }
+#endif //DEBUG
+        }
+
+        //Reorder and deduplicate vertices with all indices of the mesh.
+        if (info.optimizeVertexFetch == VG_TRUE || info.deduplicateVertices == VG_TRUE)
+        {
+            std::vector<uint32_t> allIndices;
+            for (uint32_t i = 0; i < subMeshCount; ++i)
+            {
+                const auto &indices = m_subMeshInfos[i].indices;
+                allIndices.insert(allIndices.end(), indices.cbegin(), indices.cend());
+            }
+            uint32_t indexCount = static_cast<uint32_t>(allIndices.size());
+
+            std::vector<fd::VertexStream> streams;
+            Bool32 canDeduplicate = info.deduplicateVertices;
+            if (canDeduplicate == VG_TRUE)
+            {
+                for (const auto &data : m_pData->datas)
+                {
+                    for (const auto &name : data.arrDataNames)
+                    {
+                        uint32_t count = data.getDataCount(name);
+                        if (count < vertexCount)
+                        {
+                            //Vertices without this attribute can't be compared.
+                            canDeduplicate = VG_FALSE;
+                            break;
+                        }
+                        uint32_t baseSize = data.getDataBaseSize(name);
+                        streams.push_back(fd::VertexStream(getValue(name, data.mapDatas).data(), baseSize, baseSize));
+                    }
+                }
+            }
+
+            std::vector<uint32_t> remap(vertexCount);
+            uint32_t newVertexCount;
+            if (canDeduplicate == VG_TRUE)
+            {
+                newVertexCount = fd::generateVertexDeduplicateRemap(remap.data(), allIndices.data(), indexCount, vertexCount,
+                    streams.data(), static_cast<uint32_t>(streams.size()));
+            }
+            else
+            {
+                newVertexCount = fd::generateVertexFetchRemap(remap.data(), allIndices.data(), indexCount, vertexCount);
+            }
+
+            for (uint32_t i = 0; i < subMeshCount; ++i)
+            {
+                auto &indices = m_subMeshInfos[i].indices;
+                fd::remapIndices(indices.data(), indices.data(), static_cast<uint32_t>(indices.size()), remap.data());
+            }
+            m_pData->remapElements(remap.data(), vertexCount, newVertexCount);
+            m_vertexCount = newVertexCount;
+        }
+    }
+
+    void SepMesh::_createLODSubMeshInfos()
+    {
+        const auto &info = m_lodInfo;
+        uint32_t subMeshCount = m_appliedSubMeshCount;
+        uint32_t vertexCount = m_vertexCount;
+        m_appliedLODCount = 1u;
+        if (info.indexCountRatios.size() == 0u || vertexCount == 0u) return;
+        if (hasData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME) == VG_FALSE) return;
+        auto positions = getData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME);
+        if (static_cast<uint32_t>(positions.size()) < vertexCount) return;
+
+        uint32_t lodCount = static_cast<uint32_t>(info.indexCountRatios.size()) + 1u;
+        m_usingSubMeshInfos.resize(lodCount * subMeshCount);
+        for (uint32_t lodLevel = 1u; lodLevel < lodCount; ++lodLevel)
+        {
+            float ratio = info.indexCountRatios[lodLevel - 1u];
+            for (uint32_t i = 0; i < subMeshCount; ++i)
+            {
+                //Simplify from the previous level, it is faster and keeps levels nested.
+                const auto &srcSubMeshInfo = m_usingSubMeshInfos[(lodLevel - 1u) * subMeshCount + i];
+                auto &dstSubMeshInfo = m_usingSubMeshInfos[lodLevel * subMeshCount + i];
+                dstSubMeshInfo.topology = srcSubMeshInfo.topology;
+                if (srcSubMeshInfo.topology != PrimitiveTopology::TRIANGLE_LIST)
+                {
+                    dstSubMeshInfo.indices = srcSubMeshInfo.indices;
+                    continue;
+                }
+                const auto &srcIndices = srcSubMeshInfo.indices;
+                uint32_t srcIndexCount = static_cast<uint32_t>(srcIndices.size());
+                uint32_t targetIndexCount = static_cast<uint32_t>(static_cast<float>(m_usingSubMeshInfos[i].indices.size()) * ratio);
+                std::vector<uint32_t> dstIndices(srcIndexCount);
+                float error = 0.0f;
+                uint32_t dstIndexCount = fd::simplifyMesh(dstIndices.data(), srcIndices.data(), srcIndexCount,
+                    reinterpret_cast<const float *>(positions.data()), vertexCount, static_cast<uint32_t>(sizeof(Vector3)),
+                    targetIndexCount, info.targetError, &error);
+                dstIndices.resize(dstIndexCount);
+                dstSubMeshInfo.indices.swap(dstIndices);
+                VG_LOG(plog::debug) << "LOD " << lodLevel << " of sub mesh " << i << ", index count: " << srcIndexCount
+                    << " -> " << dstIndexCount << ", error: " << error << std::endl;
+            }
+        }
+        m_appliedLODCount = lodCount;
+    }
+
+    void SepMesh::_createClusters()
+    {
+        const auto &info = m_clusterInfo;
+        uint32_t subMeshCount = static_cast<uint32_t>(m_usingSubMeshInfos.size());
+        uint32_t vertexCount = m_vertexCount;
+        m_clusters.clear();
+        m_clusterOffsets.clear();
+        if (info.buildClusters == VG_FALSE || vertexCount == 0u) return;
+        if (hasData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME) == VG_FALSE) return;
+        auto positions = getData<MeshData::DataType::VECTOR_3_ARRAY>(VG_VERTEX_POSITION_NAME);
+        if (static_cast<uint32_t>(positions.size()) < vertexCount) return;
+
+        m_clusterOffsets.resize(subMeshCount + 1u);
+        std::vector<fd::MeshCluster> clusters;
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            m_clusterOffsets[i] = static_cast<uint32_t>(m_clusters.size());
+            const auto &subMeshInfo = m_usingSubMeshInfos[i];
+            if (subMeshInfo.topology != PrimitiveTopology::TRIANGLE_LIST) continue;
+            const auto &indices = subMeshInfo.indices;
+            fd::buildMeshClusters(clusters, indices.data(), static_cast<uint32_t>(indices.size()),
+                reinterpret_cast<const float *>(positions.data()), vertexCount, static_cast<uint32_t>(sizeof(Vector3)),
+                info.maxVertexCount, info.maxTriangleCount);
+            //One cluster can't be culled better than the sub mesh.
+            if (clusters.size() > 1u) m_clusters.insert(m_clusters.end(), clusters.cbegin(), clusters.cend());
+        }
+        m_clusterOffsets[subMeshCount] = static_cast<uint32_t>(m_clusters.size());
+        VG_LOG(plog::debug) << "Cluster count of mesh: " << m_clusters.size() << std::endl;
+    }
+
     void SepMesh::_createVertexData()
     {
         auto pPhysicalDevice = pApp->getPhysicalDevice();
         auto nonCoherentAtomSize = pPhysicalDevice->getProperties().limits.nonCoherentAtomSize;
         auto vertexCount = m_appliedVertexCount;
 
+        //Assign every attribute to a binding according to layout policy, and get its offset in the binding.
+        uint32_t layoutCount = static_cast<uint32_t>(m_layoutBindingInfos.size());
+        Bool32 isPositionFirst = layoutCount != 0u && m_layoutBindingInfos.cbegin()->name == VG_VERTEX_POSITION_NAME;
+        std::vector<uint32_t> layoutBindings(layoutCount);
+        std::vector<uint32_t> layoutOffsets(layoutCount);
+        std::vector<uint32_t> bindingStrides;
         uint32_t i = 0u;
-        std::vector<uint32_t> oneSepBufferSizes(m_layoutBindingInfos.size());
-        uint32_t vertexBufferSize = 0u;
         for (const auto& layoutInfo : m_layoutBindingInfos)
         {
-            oneSepBufferSizes[i] = MeshData::getDataBaseSize(layoutInfo.dataType) * vertexCount;
+            uint32_t binding = _getLayoutBinding(layoutInfo, i, isPositionFirst);
+            if (binding >= static_cast<uint32_t>(bindingStrides.size())) bindingStrides.resize(binding + 1u, 0u);
+            layoutBindings[i] = binding;
+            layoutOffsets[i] = bindingStrides[binding];
+            bindingStrides[binding] += MeshData::getDataBaseSize(layoutInfo.dataType);
+            ++i;
+        }
+
+        uint32_t bindingCount = static_cast<uint32_t>(bindingStrides.size());
+        std::vector<uint32_t> oneSepBufferSizes(bindingCount);
+        uint32_t vertexBufferSize = 0u;
+        for (i = 0u; i < bindingCount; ++i)
+        {
+            oneSepBufferSizes[i] = bindingStrides[i] * vertexCount;
             oneSepBufferSizes[i] = static_cast<uint32_t>(std::ceil(static_cast<float>(oneSepBufferSizes[i]) / static_cast<float>(nonCoherentAtomSize)) * nonCoherentAtomSize);
             vertexBufferSize += oneSepBufferSizes[i];
-
-            ++i;
         }
-        std::vector<vk::VertexInputBindingDescription> bindingdescs(m_layoutBindingInfos.size());
-        uint32_t index = 0u;
-        for (const auto& info : m_layoutBindingInfos)
+
+        std::vector<vk::VertexInputBindingDescription> bindingdescs(bindingCount);
+        for (uint32_t index = 0u; index < bindingCount; ++index)
         {
             bindingdescs[index].binding = index;
-            bindingdescs[index].stride = MeshData::getDataBaseSize(info.dataType);
+            bindingdescs[index].stride = bindingStrides[index];
             bindingdescs[index].inputRate = vk::VertexInputRate::eVertex;
-            ++index;
         }
 
-        std::vector<vk::VertexInputAttributeDescription> attriDescs(m_layoutBindingInfos.size());
-        index = 0u;
+        std::vector<vk::VertexInputAttributeDescription> attriDescs(layoutCount);
+        uint32_t index = 0u;
         for (const auto& info : m_layoutBindingInfos)
         {
-            attriDescs[index].binding = index;
+            attriDescs[index].binding = layoutBindings[index];
             attriDescs[index].location = index;
             attriDescs[index].format = MeshData::getBaseFormatWithDataType(info.dataType);
-            attriDescs[index].offset = 0u;
+            attriDescs[index].offset = layoutOffsets[index];
             ++index;
         }
 
@@ -432,19 +822,25 @@ namespace vg
         createInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attriDescs.size());
         createInfo.pVertexAttributeDescriptions = attriDescs.data();
 
-        void *stagingMemory = malloc(vertexBufferSize);
-        std::vector<uint32_t> bindingOffsets(m_layoutBindingInfos.size());
+        std::vector<uint32_t> bindingOffsets(bindingCount);
         uint32_t offset = 0;
-        i = 0;
-        for (const auto& layoutInfo : m_layoutBindingInfos)
+        for (i = 0u; i < bindingCount; ++i)
         {
-            m_pData->memoryCopyData(layoutInfo.dataType, layoutInfo.name, stagingMemory, offset, 0u, vertexCount);
             bindingOffsets[i] = offset;
             offset += oneSepBufferSizes[i];
+        }
+
+        void *stagingMemory = malloc(vertexBufferSize);
+        i = 0;
+        for (const auto& layoutInfo : m_layoutBindingInfos)
+        {
+            uint32_t binding = layoutBindings[i];
+            m_pData->memoryCopyDataWithStride(layoutInfo.dataType, layoutInfo.name, stagingMemory, 
+                bindingOffsets[binding] + layoutOffsets[i], bindingStrides[binding], 0u, vertexCount);
             ++i;
         }
 
-        m_pVertexData->init(vertexCount, stagingMemory, vertexBufferSize, VG_FALSE, createInfo, bindingOffsets.data());
+        m_pVertexData->init(vertexCount, stagingMemory, vertexBufferSize, m_isCacheMemory, createInfo, bindingOffsets.data());
 
         free(stagingMemory);
     }
@@ -480,7 +876,7 @@ namespace vg
             offset += static_cast<uint32_t>(size);
         }
 
-        m_pIndexData->init(subCount, subDatas.data(), stagingMemory, indexBufferSize, VG_FALSE);
+        m_pIndexData->init(subCount, subDatas.data(), stagingMemory, indexBufferSize, m_isCacheMemory);
 
         free(stagingMemory);
     }
@@ -501,6 +897,20 @@ namespace vg
         }
     }
 
+    uint32_t SepMesh::_getLayoutBinding(const MeshData::DataInfo &info, uint32_t layoutIndex, Bool32 isPositionFirst) const
+    {
+        switch (m_vertexLayoutPolicy)
+        {
+        case VertexLayoutPolicy::INTERLEAVED:
+            return 0u;
+        case VertexLayoutPolicy::POSITION_SEPARATE:
+            //Position is the first because it has the highest binding priority.
+            return isPositionFirst == VG_TRUE && layoutIndex != 0u ? 1u : 0u;
+        default:
+            return layoutIndex;
+        }
+    }
+
 #ifdef DEBUG
     void SepMesh::_verifySubMeshIndex(uint32_t subMeshIndex) const
     {
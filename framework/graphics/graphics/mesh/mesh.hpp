@@ -66,6 +66,16 @@ namespace vg
         IndexData *getIndexData() const;
         virtual uint32_t getSubMeshOffset() const;
         virtual uint32_t getSubMeshCount() const;
+        /*Count of LOD levels, level 0 is the original sub meshes.*/
+        virtual uint32_t getLODCount() const;
+        /*Offset from the sub meshes of level 0 to the sub meshes of the LOD level.*/
+        virtual uint32_t getLODSubMeshOffset(uint32_t lodLevel) const;
+        /*Count of clusters of the sub mesh, the sub mesh is drawn as a whole when it is zero.*/
+        virtual uint32_t getClusterCount(uint32_t subMeshIndex) const;
+        /*Clusters of the sub mesh, index offset of a cluster is relative to the start of the sub mesh.*/
+        virtual const fd::MeshCluster *getClusters(uint32_t subMeshIndex) const;
+        /*Clusters can be culled with their normal cones when back faces are culled.*/
+        virtual Bool32 getIsClusterConeCulling() const;
     protected:
         std::shared_ptr<VertexData> m_pVertexData;
         std::shared_ptr<IndexData> m_pIndexData;
@@ -121,6 +131,72 @@ namespace vg
             std::vector<uint32_t> indices;
         };
 
+        /**
+         * Optimization of mesh data when the mesh is applied. It changes order of indices and vertices
+         * of the readable mesh data.
+         * optimizeVertexCache: reorder triangles of triangle list sub meshes for post-transform vertex cache (Tipsify).
+         * optimizeOverdraw: reorder clusters of triangles to draw clusters facing outward first, it needs 3D positions.
+         * optimizeVertexFetch: reorder vertices by their first use in indices.
+         * deduplicateVertices: merge vertices whose all attributes are same, it includes vertex fetch reordering.
+         * parallelIndexCountThreshold: sub meshes with more indices than it are optimized on the default thread pool.
+         */
+        struct OptimizeInfo
+        {
+            Bool32 optimizeVertexCache;
+            Bool32 optimizeOverdraw;
+            Bool32 optimizeVertexFetch;
+            Bool32 deduplicateVertices;
+            uint32_t cacheSize;
+            uint32_t parallelIndexCountThreshold;
+
+            OptimizeInfo(Bool32 optimizeVertexCache = VG_FALSE
+                , Bool32 optimizeOverdraw = VG_FALSE
+                , Bool32 optimizeVertexFetch = VG_FALSE
+                , Bool32 deduplicateVertices = VG_FALSE
+                , uint32_t cacheSize = FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE
+                , uint32_t parallelIndexCountThreshold = 65536u
+                );
+        };
+
+        /**
+         * LOD levels generated with quadric error mesh simplification when the mesh is applied.
+         * indexCountRatios: target index count of each LOD level compared with the original sub mesh, 
+         * level i + 1 uses indexCountRatios[i], eg. {0.5f, 0.25f}.
+         * targetError: max simplification error relative to the extent of the mesh.
+         * LOD sub meshes are placed after the original sub meshes, sub mesh i of level l is at 
+         * index l * subMeshCount + i, and they share the vertex data.
+         */
+        struct LODInfo
+        {
+            std::vector<float> indexCountRatios;
+            float targetError;
+
+            LODInfo(std::vector<float> indexCountRatios = std::vector<float>()
+                , float targetError = 0.05f
+                );
+        };
+
+        /**
+         * Clusters (meshlets) of triangle list sub meshes built when the mesh is applied, they are culled
+         * with their bounding spheres and normal cones when the mesh is recorded to command buffer, and visible
+         * clusters are drawn as ranges of the sub mesh indices.
+         * coneCulling: cull clusters whose triangles all face away from the viewer, only for passes culling back faces.
+         * maxVertexCount, maxTriangleCount: limits of one cluster.
+         */
+        struct ClusterInfo
+        {
+            Bool32 buildClusters;
+            Bool32 coneCulling;
+            uint32_t maxVertexCount;
+            uint32_t maxTriangleCount;
+
+            ClusterInfo(Bool32 buildClusters = VG_FALSE
+                , Bool32 coneCulling = VG_TRUE
+                , uint32_t maxVertexCount = FD_MESH_CLUSTER_DEFAULT_MAX_VERTEX_COUNT
+                , uint32_t maxTriangleCount = FD_MESH_CLUSTER_DEFAULT_MAX_TRIANGLE_COUNT
+                );
+        };
+
         SepMesh(vk::MemoryPropertyFlags bufferMemoryPropertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal);
 
         virtual ~SepMesh();
@@ -170,6 +246,43 @@ namespace vg
         /**Vertex colors of the Mesh added to verties*/
         void setAddedColor(Color value);
 
+        const LODInfo &getLODInfo() const;
+        void setLODInfo(const LODInfo &value);
+
+        virtual uint32_t getLODCount() const override;
+        virtual uint32_t getLODSubMeshOffset(uint32_t lodLevel) const override;
+
+        const ClusterInfo &getClusterInfo() const;
+        void setClusterInfo(const ClusterInfo &value);
+
+        virtual uint32_t getClusterCount(uint32_t subMeshIndex) const override;
+        virtual const fd::MeshCluster *getClusters(uint32_t subMeshIndex) const override;
+        virtual Bool32 getIsClusterConeCulling() const override;
+
+        const OptimizeInfo &getOptimizeInfo() const;
+        void setOptimizeInfo(const OptimizeInfo &value);
+
+        /**
+         * Simulate vertex cache with the readable indices of the sub mesh to get ACMR and ATVR.
+         */
+        fd::VertexCacheStatistics analyzeVertexCache(uint32_t subMeshIndex, uint32_t cacheSize = FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE) const;
+
+        VertexLayoutPolicy getVertexLayoutPolicy() const;
+
+        /**
+         * Set how vertex attributes are packed to bindings when the mesh is applied.
+         * Default is VertexLayoutPolicy::SEPARATE.
+         */
+        void setVertexLayoutPolicy(VertexLayoutPolicy value);
+
+        Bool32 getIsCacheMemory() const;
+
+        /**
+         * Keep host copies of vertices and indices after the mesh is applied, so they can be read on CPU,
+         * eg. by sprite batching of render binder. Default is VG_FALSE.
+         */
+        void setIsCacheMemory(Bool32 value);
+
         virtual void apply(Bool32 makeUnreadable);
 
         //texture coordinate
@@ -216,21 +329,36 @@ namespace vg
 
         Color m_multipliedColor;
         Color m_addedColor;
+        VertexLayoutPolicy m_vertexLayoutPolicy;
+        Bool32 m_isCacheMemory;
+        OptimizeInfo m_optimizeInfo;
+        LODInfo m_lodInfo;
+        ClusterInfo m_clusterInfo;
 
         Bool32 m_applied;
         uint32_t m_appliedVertexCount; //save vertex count to render.
         uint32_t m_appliedSubMeshCount;
+        uint32_t m_appliedLODCount;
         std::set<MeshData::DataInfo> m_layoutBindingInfos;
         std::vector<SubMeshInfo> m_usingSubMeshInfos; //save sub mesh info to render.
+        std::vector<fd::MeshCluster> m_clusters;
+        std::vector<uint32_t> m_clusterOffsets; //offset of the first cluster of every using sub mesh, and the end.
 
         void _createMeshData();
 
+        void _optimizeMeshData();
+
+        void _createLODSubMeshInfos();
+
+        void _createClusters();
+
         void _createVertexData();
 
         void _createIndexData();
 
 
         inline void _sortLayoutBindingInfos();
+        inline uint32_t _getLayoutBinding(const MeshData::DataInfo &info, uint32_t layoutIndex, Bool32 isPositionFirst) const;
         //tool methods
 #ifdef DEBUG
         inline void _verifySubMeshIndex(uint32_t subMeshIndex) const;
@@ -1,5 +1,7 @@
 #include "graphics/mesh/mesh_data.hpp"
 
+#include <algorithm>
+
 namespace vg
 {
     MeshData::DataInfo::DataInfo()
@@ -143,6 +145,33 @@ namespace vg
         std::memcpy(ptr, bytes.data() + srcOffset, srcSize);
     }
 
+    void MeshData::Data::memoryCopyDataWithStride(const std::string name
+        , void* dst
+        , uint32_t offset
+        , uint32_t stride
+        , uint32_t elementStart
+        , uint32_t maxElementCount) const
+    {
+        const auto& bytes = getValue(name, mapDatas);
+        const auto& count = getValue(name, mapDataCounts);
+        uint32_t baseSize = static_cast<uint32_t>(bytes.size()) / count;
+        if (stride == baseSize)
+        {
+            memoryCopyData(name, dst, offset, elementStart, maxElementCount);
+            return;
+        }
+        char *ptr = static_cast<char *>(dst);
+        ptr += offset;
+        uint32_t finalElementCount = std::max(0u, std::min(count - elementStart, maxElementCount));
+        const Byte *pSrc = bytes.data() + elementStart * baseSize;
+        for (uint32_t i = 0; i < finalElementCount; ++i)
+        {
+            std::memcpy(ptr, pSrc, baseSize);
+            ptr += stride;
+            pSrc += baseSize;
+        }
+    }
+
     uint32_t MeshData::getDataBaseSize(const DataType dataType)
     {
         switch (dataType)
@@ -189,5 +218,40 @@ namespace vg
     {
         datas[static_cast<size_t>(type)].memoryCopyData(name, dst, offset, elementStart, maxElementCount);
     }
-    
+
+    void MeshData::memoryCopyDataWithStride(DataType type
+            , const std::string name
+            , void* dst
+            , uint32_t offset
+            , uint32_t stride
+            , uint32_t elementStart
+            , uint32_t maxElementCount) const
+    {
+        datas[static_cast<size_t>(type)].memoryCopyDataWithStride(name, dst, offset, stride, elementStart, maxElementCount);
+    }
+
+    void MeshData::remapElements(const uint32_t *pRemap, uint32_t elementCount, uint32_t newElementCount)
+    {
+        for (auto &data : datas)
+        {
+            for (const auto &name : data.arrDataNames)
+            {
+                auto &bytes = data.mapDatas[name];
+                auto &count = data.mapDataCounts[name];
+                if (count == 0u) continue;
+                uint32_t baseSize = static_cast<uint32_t>(bytes.size()) / count;
+#ifdef DEBUG
+                if (count < elementCount)
+                {
+                    VG_LOG(plog::warning) << "Data " << name << " has " << count << " elements, it is less than "
+                        << elementCount << " elements of the mesh, remapped elements without source will be zero." << std::endl;
+                }
+#endif //DEBUG
+                std::vector<Byte> newBytes(newElementCount * baseSize);
+                fd::remapVertices(newBytes.data(), bytes.data(), std::min(count, elementCount), baseSize, pRemap);
+                bytes.swap(newBytes);
+                count = newElementCount;
+            }
+        }
+    }
 }
\ No newline at end of file
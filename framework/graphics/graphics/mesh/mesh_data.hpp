@@ -213,6 +213,16 @@ namespace vg
                 , uint32_t offset
                 , uint32_t elementStart
                 , uint32_t maxElementCount) const;
+
+            /**
+             * Copy elements to dst with a stride, it is used to write data to interleaved vertex layout.
+             */
+            void memoryCopyDataWithStride(const std::string name
+                , void* dst
+                , uint32_t offset
+                , uint32_t stride
+                , uint32_t elementStart
+                , uint32_t maxElementCount) const;
         };
 
         std::array<Data, static_cast<size_t>(DataType::RANGE_SIZE)> datas;
@@ -247,6 +257,20 @@ namespace vg
             , uint32_t elementStart
             , uint32_t maxElementCount) const;
 
+        void memoryCopyDataWithStride(DataType type
+            , const std::string name
+            , void* dst
+            , uint32_t offset
+            , uint32_t stride
+            , uint32_t elementStart
+            , uint32_t maxElementCount) const;
+
+        /**
+         * Move element i of every data array to pRemap[i] and resize the arrays to newElementCount,
+         * the elements mapped to FD_MESH_OPTIMIZER_INVALID_INDEX are dropped.
+         */
+        void remapElements(const uint32_t *pRemap, uint32_t elementCount, uint32_t newElementCount);
+
         template <DataType type>
         void memoryCopyData(const std::string name
             , void* dst
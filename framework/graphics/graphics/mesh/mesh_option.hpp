@@ -73,6 +73,23 @@ namespace vg
         RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
     };
 
+    /**
+     * Layout policy of vertex attributes when SepMesh creates its vertex buffer.
+     * SEPARATE: every attribute has its own binding.
+     * INTERLEAVED: all attributes are packed into one binding.
+     * POSITION_SEPARATE: position has its own binding and the other attributes are 
+     * interleaved into the second binding, so depth only passes only fetch positions.
+     */
+    enum class VertexLayoutPolicy
+    {
+        SEPARATE,
+        INTERLEAVED,
+        POSITION_SEPARATE,
+        BEGIN_RANGE = SEPARATE,
+        END_RANGE = POSITION_SEPARATE,
+        RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+    };
+
     extern std::array<std::pair<PrimitiveTopology, vk::PrimitiveTopology>, static_cast<size_t>(PrimitiveTopology::RANGE_SIZE)> arrPrimitiveTopologyToVK;
 
     inline vk::PrimitiveTopology tranPrimitiveTopologyTypeToVK(PrimitiveTopology topology)
@@ -46,6 +46,7 @@ namespace vg
             , optionalPhysicalDeviceFeatures
             );
 
+        createDefaultBufferDatas();
         createDefaultTextures();
         createDefaultPasses();
         createDefaultMaterials();
@@ -57,6 +58,7 @@ namespace vg
         destroyDefaultTextures();
         destroyDefaultPasses();
         destroyDefaultMaterials();
+        destroyDefaultBufferDatas();
         pApp = nullptr;
         //fd::moduleDestroy();
         isInited = VG_FALSE;
@@ -3,6 +3,7 @@
 
 #include "graphics/global.hpp"
 #include "graphics/app/app.hpp"
+#include "graphics/buffer_data/buffer_data_default.hpp"
 #include "graphics/texture/texture_default.hpp"
 #include "graphics/pass/pass_default.hpp"
 #include "graphics/material/material_default.hpp"
@@ -73,7 +73,7 @@ namespace vg
 
     Pass::VertexInputFilterInfo::VertexInputFilterInfo(Bool32 filterEnable
         , uint32_t locationCount
-        , uint32_t * pBindings
+        , uint32_t * pLocations
         )
         : filterEnable(filterEnable)
         , locationCount(locationCount)
@@ -230,6 +230,7 @@ namespace vg
         , m_pushConstantChanged(VG_FALSE)
         , m_pushConstantRanges()
         , m_sortedPushConstantItems()
+        , m_pSortedPushConstantItems()
         , m_mapSpecializationAppliedData()
         , m_pipelineLayoutStateID()
         , m_pipelineStateID()
@@ -311,6 +312,11 @@ namespace vg
     {
         return m_bindingSet.getTexture(name);
     }
+
+    const std::vector<std::string> &Pass::getTextureNames() const
+    {
+        return m_bindingSet.getTextureNames();
+    }
     
     void Pass::setTexture(std::string name, const PassTextureInfo &texInfo)
     {
@@ -665,6 +671,8 @@ namespace vg
     void Pass::removePushConstant(std::string name)
     {
         m_pushConstant.removePushConstant(name);
+        //Item of it is deleted, so sorted items are got again when pass is applied.
+        m_pSortedPushConstantItems.clear();
         m_pushConstantChanged = VG_TRUE;
     }
 
@@ -697,23 +705,21 @@ namespace vg
         return m_pushConstantRanges;
     }
 
-    std::vector<Pass::PushConstantUpdateInfo> Pass::getPushconstantUpdates() const
+    uint32_t Pass::getPushconstantUpdateCount() const
     {
-        std::vector<PushConstantUpdateInfo> updateInfos(m_sortedPushConstantItems.size());
-        uint32_t index = 0u;
-        for (const auto &item : m_sortedPushConstantItems)
-        {
-            const auto &pushConstantItem = m_pushConstant.getPushConstant(item.name);
-            PushConstantUpdateInfo updateInfo = {
-                pushConstantItem.getStageFlags(),
-                pushConstantItem.getUpdate().getOffset(),
-                pushConstantItem.getUpdate().getSize(),
-                pushConstantItem.getUpdate().getData(),
-            };
-            updateInfos[index] = updateInfo;
-            ++index;
-        }
-        return updateInfos;
+        return static_cast<uint32_t>(m_pSortedPushConstantItems.size());
+    }
+
+    Pass::PushConstantUpdateInfo Pass::getPushconstantUpdate(uint32_t index) const
+    {
+        const auto &pushConstantItem = *(m_pSortedPushConstantItems[index]);
+        PushConstantUpdateInfo updateInfo = {
+            pushConstantItem.getStageFlags(),
+            pushConstantItem.getUpdate().getOffset(),
+            pushConstantItem.getUpdate().getSize(),
+            pushConstantItem.getUpdate().getData(),
+        };
+        return updateInfo;
     }
 
     uint32_t Pass::getInstanceCount() const
@@ -756,7 +762,7 @@ namespace vg
                     break;
                 }
             }
-            if (isAllSame == VG_FALSE)
+            if (isAllSame == VG_TRUE)
             {
                 return;
             }
@@ -943,11 +949,13 @@ namespace vg
             }
 
             std::vector<vk::PushConstantRange> pushConstantRanges(m_sortedPushConstantItems.size());
+            m_pSortedPushConstantItems.resize(m_sortedPushConstantItems.size());
             uint32_t offset = 0u;
             uint32_t index = 0u;
             for (const auto &sortInfo : m_sortedPushConstantItems)
             {
                 const auto &item = m_pushConstant.getPushConstant(sortInfo.name);
+                m_pSortedPushConstantItems[index] = &item;
                 vk::PushConstantRange range = {
                      item.getStageFlags(),
                      offset,
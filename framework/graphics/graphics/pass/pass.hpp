@@ -134,6 +134,7 @@ namespace vg
         void removeTexture(std::string name);
         PassTextureInfo getTexture(std::string name) const;
         void setTexture(std::string name, const PassTextureInfo &texInfo);
+        const std::vector<std::string> &getTextureNames() const;
 
         //external uniform buffer
         Bool32 hasExtUniformBuffer(std::string name) const;
@@ -266,7 +267,9 @@ namespace vg
             );
 
         const std::vector<vk::PushConstantRange> &getPushConstantRanges() const;
-        std::vector<PushConstantUpdateInfo> getPushconstantUpdates() const;
+        uint32_t getPushconstantUpdateCount() const;
+        //Updates are in order of priorities of push constants applied last time, getting them doesn't allocate memory.
+        PushConstantUpdateInfo getPushconstantUpdate(uint32_t index) const;
 
         uint32_t getInstanceCount() const;
         void setInstanceCount(uint32_t count);
@@ -364,6 +367,8 @@ namespace vg
         static Bool32 _comparePushConstantInfo(const PushConstantSortInfo &, const PushConstantSortInfo &);
         std::vector<vk::PushConstantRange> m_pushConstantRanges;
         std::set<PushConstantSortInfo, Bool32(*)(const PushConstantSortInfo &, const PushConstantSortInfo &)> m_sortedPushConstantItems;
+        //Items of sorted push constants, items of the map of push constant data are never moved.
+        std::vector<const PassPushConstantData::ConstantItem *> m_pSortedPushConstantItems;
 
         //specialization
         struct SpecializationSortInfo {
@@ -22,15 +22,44 @@ namespace vg
     extern "C" const unsigned char VG_LIGHTING_POINT_DIST_FRAG_DEFAULT_CODE[];
     extern "C" const size_t VG_LIGHTING_POINT_DIST_FRAG_DEFAULT_CODE_LEN;
 
+    //light point distance per face
+    extern "C" const unsigned char VG_LIGHTING_POINT_DIST_FACE_VERT_DEFAULT_CODE[];
+    extern "C" const size_t VG_LIGHTING_POINT_DIST_FACE_VERT_DEFAULT_CODE_LEN;
+
+    //deferred composition
+    extern "C" const unsigned char VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE[];
+    extern "C" const size_t VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE_LEN;
+    extern "C" const unsigned char VG_DEFERRED_COMPOSITION_FRAG_DEFAULT_CODE[];
+    extern "C" const size_t VG_DEFERRED_COMPOSITION_FRAG_DEFAULT_CODE_LEN;
+
+    //deferred result
+    extern "C" const unsigned char VG_DEFERRED_RESULT_FRAG_DEFAULT_CODE[];
+    extern "C" const size_t VG_DEFERRED_RESULT_FRAG_DEFAULT_CODE_LEN;
+
     std::shared_ptr<Shader> pDefaultPreDepthShader = nullptr;
     std::shared_ptr<Pass> pDefaultPreDepthPass = nullptr;
     std::shared_ptr<Shader> pDefaultLightingDepthShader = nullptr;
     std::shared_ptr<Pass> pDefaultLightingDepthPass = nullptr;
     std::shared_ptr<Shader> pDefaultLightingPointDistShader = nullptr;
     std::shared_ptr<Pass> pDefaultLightingPointDistPass = nullptr;
+    std::shared_ptr<Shader> pDefaultLightingPointDistFaceShader = nullptr;
+    std::shared_ptr<Pass> pDefaultLightingPointDistFacePass = nullptr;
+    std::shared_ptr<Shader> pDefaultDeferredCompositionShader = nullptr;
+    std::shared_ptr<Pass> pDefaultDeferredCompositionPass = nullptr;
+    std::shared_ptr<Shader> pDefaultDeferredResultShader = nullptr;
+    std::shared_ptr<Pass> pDefaultDeferredResultPass = nullptr;
 
     void createDefaultPasses()
     {
+        //Depth passes only use position, filter other attributes so that meshes with
+        //position separate layout only fetch their position stream.
+        uint32_t positionLocation = 0u;
+        vg::Pass::VertexInputFilterInfo positionFilter = {
+            VG_TRUE,
+            1u,
+            &positionLocation,
+        };
+
         //pre depth shader and pass.
         {
             pDefaultPreDepthShader = std::shared_ptr<Shader>{ 
@@ -58,6 +87,7 @@ namespace vg
             depthStencilState.depthWriteEnable = VG_TRUE;
             depthStencilState.depthCompareOp = vk::CompareOp::eLessOrEqual;
             pDefaultPreDepthPass->setDepthStencilInfo(depthStencilState);
+            pDefaultPreDepthPass->setVertexInputFilterInfo(positionFilter);
 
             pDefaultPreDepthPass->apply();
         }
@@ -89,6 +119,7 @@ namespace vg
             depthStencilState.depthWriteEnable = VG_TRUE;
             depthStencilState.depthCompareOp = vk::CompareOp::eLessOrEqual;
             pDefaultLightingDepthPass->setDepthStencilInfo(depthStencilState);
+            pDefaultLightingDepthPass->setVertexInputFilterInfo(positionFilter);
 
             //depth bias
             vg::Pass::DepthBiasInfo depthBiasInfo = {
@@ -135,6 +166,7 @@ namespace vg
             depthStencilState.depthWriteEnable = VG_TRUE;
             depthStencilState.depthCompareOp = vk::CompareOp::eLessOrEqual;
             pDefaultLightingPointDistPass->setDepthStencilInfo(depthStencilState);
+            pDefaultLightingPointDistPass->setVertexInputFilterInfo(positionFilter);
 
             //depth bias
             // vg::Pass::DepthBiasInfo depthBiasInfo = {
@@ -148,6 +180,110 @@ namespace vg
 
             pDefaultLightingPointDistPass->apply();
         }
+
+        //Light point distance per face shader and pass, one face is rendered with the projector of it
+        //in every pass, so it doesn't need the geometry shader.
+        {
+            pDefaultLightingPointDistFaceShader = std::shared_ptr<Shader>{ 
+                new Shader{VG_LIGHTING_POINT_DIST_FACE_VERT_DEFAULT_CODE, 
+                           VG_LIGHTING_POINT_DIST_FACE_VERT_DEFAULT_CODE_LEN,
+                           VG_LIGHTING_POINT_DIST_FRAG_DEFAULT_CODE,
+                           VG_LIGHTING_POINT_DIST_FRAG_DEFAULT_CODE_LEN,
+                    } 
+                };
+            pDefaultLightingPointDistFacePass = std::shared_ptr<Pass>{ new Pass(pDefaultLightingPointDistFaceShader.get()) };
+    
+            vg::Pass::BuildInDataInfo::Component buildInDataCmps[4] = {
+                    {vg::Pass::BuildInDataType::MATRIX_OBJECT_TO_WORLD},
+                    {vg::Pass::BuildInDataType::MATRIX_OBJECT_TO_VIEW},
+                    {vg::Pass::BuildInDataType::MATRIX_PROJECTION},
+                    {vg::Pass::BuildInDataType::POS_VIEWER},
+                };
+            vg::Pass::BuildInDataInfo buildInDataInfo;
+            buildInDataInfo.componentCount = 4u;
+            buildInDataInfo.pComponent = buildInDataCmps;
+            pDefaultLightingPointDistFacePass->setBuildInDataInfo(buildInDataInfo);
+
+            pDefaultLightingPointDistFacePass->setFrontFace(vk::FrontFace::eClockwise);
+            pDefaultLightingPointDistFacePass->setCullMode(vk::CullModeFlagBits::eBack);
+
+            vk::PipelineDepthStencilStateCreateInfo depthStencilState = {};
+            depthStencilState.depthTestEnable = VG_TRUE;
+            depthStencilState.depthWriteEnable = VG_TRUE;
+            depthStencilState.depthCompareOp = vk::CompareOp::eLessOrEqual;
+            pDefaultLightingPointDistFacePass->setDepthStencilInfo(depthStencilState);
+            pDefaultLightingPointDistFacePass->setVertexInputFilterInfo(positionFilter);
+
+            pDefaultLightingPointDistFacePass->apply();
+        }
+
+        //Deferred composition shader and pass, it is drawn in the second subpass of the deferred target
+        //and only outputs albedo of the G-buffer.
+        {
+            pDefaultDeferredCompositionShader = std::shared_ptr<Shader>{ 
+                new Shader{VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE, 
+                           VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE_LEN,
+                           VG_DEFERRED_COMPOSITION_FRAG_DEFAULT_CODE,
+                           VG_DEFERRED_COMPOSITION_FRAG_DEFAULT_CODE_LEN,
+                    } 
+                };
+            pDefaultDeferredCompositionPass = std::shared_ptr<Pass>{ new Pass(pDefaultDeferredCompositionShader.get()) };
+            pDefaultDeferredCompositionPass->setSubpass(1u);
+
+            vg::Pass::BuildInDataInfo buildInDataInfo;
+            buildInDataInfo.componentCount = 0u;
+            buildInDataInfo.pComponent = nullptr;
+            pDefaultDeferredCompositionPass->setBuildInDataInfo(buildInDataInfo);
+
+            pDefaultDeferredCompositionPass->setCullMode(vk::CullModeFlagBits::eNone);
+
+            vk::PipelineDepthStencilStateCreateInfo depthStencilState = {};
+            depthStencilState.depthTestEnable = VG_FALSE;
+            depthStencilState.depthWriteEnable = VG_FALSE;
+            pDefaultDeferredCompositionPass->setDepthStencilInfo(depthStencilState);
+
+            vk::PipelineInputAssemblyStateCreateInfo inputAssemblyState = {
+                vk::PipelineInputAssemblyStateCreateFlags(),
+                vk::PrimitiveTopology::eTriangleList
+            };
+            pDefaultDeferredCompositionPass->setDefaultInputAssemblyState(inputAssemblyState);
+
+            pDefaultDeferredCompositionPass->apply();
+        }
+
+        //Deferred result shader and pass, it copies color and depth of the deferred target into the trunk.
+        {
+            pDefaultDeferredResultShader = std::shared_ptr<Shader>{ 
+                new Shader{VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE, 
+                           VG_DEFERRED_COMPOSITION_VERT_DEFAULT_CODE_LEN,
+                           VG_DEFERRED_RESULT_FRAG_DEFAULT_CODE,
+                           VG_DEFERRED_RESULT_FRAG_DEFAULT_CODE_LEN,
+                    } 
+                };
+            pDefaultDeferredResultPass = std::shared_ptr<Pass>{ new Pass(pDefaultDeferredResultShader.get()) };
+
+            vg::Pass::BuildInDataInfo buildInDataInfo;
+            buildInDataInfo.componentCount = 0u;
+            buildInDataInfo.pComponent = nullptr;
+            pDefaultDeferredResultPass->setBuildInDataInfo(buildInDataInfo);
+
+            pDefaultDeferredResultPass->setCullMode(vk::CullModeFlagBits::eNone);
+
+            //Depth of the result is written by the fragment shader.
+            vk::PipelineDepthStencilStateCreateInfo depthStencilState = {};
+            depthStencilState.depthTestEnable = VG_TRUE;
+            depthStencilState.depthWriteEnable = VG_TRUE;
+            depthStencilState.depthCompareOp = vk::CompareOp::eAlways;
+            pDefaultDeferredResultPass->setDepthStencilInfo(depthStencilState);
+
+            vk::PipelineInputAssemblyStateCreateInfo inputAssemblyState = {
+                vk::PipelineInputAssemblyStateCreateFlags(),
+                vk::PrimitiveTopology::eTriangleList
+            };
+            pDefaultDeferredResultPass->setDefaultInputAssemblyState(inputAssemblyState);
+
+            pDefaultDeferredResultPass->apply();
+        }
         
     }
 
@@ -159,5 +295,11 @@ namespace vg
         pDefaultLightingDepthPass = nullptr;
         pDefaultLightingPointDistShader = nullptr;
         pDefaultLightingPointDistPass = nullptr;
+        pDefaultLightingPointDistFaceShader = nullptr;
+        pDefaultLightingPointDistFacePass = nullptr;
+        pDefaultDeferredCompositionShader = nullptr;
+        pDefaultDeferredCompositionPass = nullptr;
+        pDefaultDeferredResultShader = nullptr;
+        pDefaultDeferredResultPass = nullptr;
     }
 } //vg
\ No newline at end of file
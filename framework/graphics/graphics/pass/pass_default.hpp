@@ -11,6 +11,12 @@ namespace vg
     extern std::shared_ptr<Pass> pDefaultLightingDepthPass;
     extern std::shared_ptr<Shader> pDefaultLightingPointDistShader;
     extern std::shared_ptr<Pass> pDefaultLightingPointDistPass;
+    extern std::shared_ptr<Shader> pDefaultLightingPointDistFaceShader;
+    extern std::shared_ptr<Pass> pDefaultLightingPointDistFacePass;
+    extern std::shared_ptr<Shader> pDefaultDeferredCompositionShader;
+    extern std::shared_ptr<Pass> pDefaultDeferredCompositionPass;
+    extern std::shared_ptr<Shader> pDefaultDeferredResultShader;
+    extern std::shared_ptr<Pass> pDefaultDeferredResultPass;
 
     extern void createDefaultPasses();
     extern void destroyDefaultPasses();
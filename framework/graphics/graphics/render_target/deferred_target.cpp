@@ -0,0 +1,76 @@
+#include "graphics/render_target/deferred_target.hpp"
+
+namespace vg
+{
+    const vk::Format DeferredTarget::DEFAULT_COLOR_FORMAT(vk::Format::eR8G8B8A8Unorm);
+    const vk::Format DeferredTarget::DEFAULT_DEPTH_FORMAT(vk::Format::eD32Sfloat);
+    const uint32_t DeferredTarget::DEFAULT_GBUFFER_COUNT = 3u;
+    const vk::Format DeferredTarget::DEFAULT_GBUFFER_FORMATS[] = {
+        vk::Format::eR8G8B8A8Unorm,
+        vk::Format::eR16G16B16A16Sfloat,
+        vk::Format::eR16G16B16A16Sfloat,
+    };
+    const uint32_t DeferredTarget::GBUFFER_SUBPASS_INDEX = 0u;
+    const uint32_t DeferredTarget::COMPOSITION_SUBPASS_INDEX = 1u;
+
+    DeferredTarget::DeferredTarget(uint32_t framebufferWidth
+        , uint32_t framebufferHeight
+        , vk::Format colorImageFormat
+        , vk::Format depthImageFormat
+        , uint32_t gbufferCount
+        , const vk::Format *pGBufferFormats
+        )
+        : OnceRenderTarget(framebufferWidth, framebufferHeight)
+        , m_colorImageFormat(colorImageFormat)
+        , m_depthImageFormat(depthImageFormat)
+        , m_gbufferFormats(pGBufferFormats, pGBufferFormats + gbufferCount)
+        , m_pColorAttachment()
+        , m_pDepthAttachment()
+        , m_pGBufferAttachments(gbufferCount)
+    {
+        vk::ClearValue clearValueColor = {
+            std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}
+        };
+        vk::ClearValue clearValueDepthStencil = {
+            vk::ClearDepthStencilValue(1.0f, 0)
+        };
+        std::vector<vk::ClearValue> clearValues(gbufferCount + 2u, clearValueColor);
+        clearValues[gbufferCount + 1u] = clearValueDepthStencil;
+        setClearValues(clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+    }
+
+    vk::Format DeferredTarget::getColorImageFormat() const
+    {
+        return m_colorImageFormat;
+    }
+
+    vk::Format DeferredTarget::getDepthImageFormat() const
+    {
+        return m_depthImageFormat;
+    }
+
+    uint32_t DeferredTarget::getGBufferCount() const
+    {
+        return static_cast<uint32_t>(m_gbufferFormats.size());
+    }
+
+    vk::Format DeferredTarget::getGBufferFormat(uint32_t index) const
+    {
+        return m_gbufferFormats[index];
+    }
+
+    const vk::ImageView *DeferredTarget::getColorAttachment() const
+    {
+        return m_pColorAttachment;
+    }
+
+    const vk::ImageView *DeferredTarget::getDepthAttachment() const
+    {
+        return m_pDepthAttachment;
+    }
+
+    const vk::ImageView *DeferredTarget::getGBufferAttachment(uint32_t index) const
+    {
+        return m_pGBufferAttachments[index];
+    }
+} //vg
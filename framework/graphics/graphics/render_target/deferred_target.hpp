@@ -0,0 +1,48 @@
+#ifndef VG_DEFERRED_TARGET_HPP
+#define VG_DEFERRED_TARGET_HPP
+
+#include "graphics/global.hpp"
+#include "graphics/texture/attachment.hpp"
+#include "graphics/render_target/render_target.hpp"
+
+namespace vg
+{
+    /*Target of deferred rendering, its render pass has two subpasses. Objects with deferred materials fill
+      the G-buffer in the first subpass, the composition subpass reads the G-buffer as input attachments and
+      writes the color attachment. Attachments are in order of color, G-buffer and depth.*/
+    class DeferredTarget : public OnceRenderTarget
+    {
+    public:
+        static const vk::Format DEFAULT_COLOR_FORMAT;
+        static const vk::Format DEFAULT_DEPTH_FORMAT;
+        static const uint32_t DEFAULT_GBUFFER_COUNT;
+        //Albedo, normal and position.
+        static const vk::Format DEFAULT_GBUFFER_FORMATS[];
+        static const uint32_t GBUFFER_SUBPASS_INDEX;
+        static const uint32_t COMPOSITION_SUBPASS_INDEX;
+
+        DeferredTarget(uint32_t framebufferWidth = 0u
+            , uint32_t framebufferHeight = 0u
+            , vk::Format colorImageFormat = DEFAULT_COLOR_FORMAT
+            , vk::Format depthImageFormat = DEFAULT_DEPTH_FORMAT
+            , uint32_t gbufferCount = DEFAULT_GBUFFER_COUNT
+            , const vk::Format *pGBufferFormats = DEFAULT_GBUFFER_FORMATS
+            );
+        vk::Format getColorImageFormat() const;
+        vk::Format getDepthImageFormat() const;
+        uint32_t getGBufferCount() const;
+        vk::Format getGBufferFormat(uint32_t index) const;
+        const vk::ImageView *getColorAttachment() const;
+        const vk::ImageView *getDepthAttachment() const;
+        const vk::ImageView *getGBufferAttachment(uint32_t index) const;
+    protected:
+        vk::Format m_colorImageFormat;
+        vk::Format m_depthImageFormat;
+        std::vector<vk::Format> m_gbufferFormats;
+        const vk::ImageView *m_pColorAttachment;
+        const vk::ImageView *m_pDepthAttachment;
+        std::vector<const vk::ImageView *> m_pGBufferAttachments;
+    };
+} //vg
+
+#endif //VG_DEFERRED_TARGET_HPP
@@ -12,20 +12,67 @@ namespace vg
         , PipelineCache *pPipelineCache
         , RendererPassCache *pRendererPassCache
         , ResultInfo *pResult
+        , GPUTimer *pGPUTimer
+        , const char *sectionName
         )
     {
+        VulkanCmdRecorder recorder(pCommandBuffer);
+        record(pCmdBuffer, &recorder, pPipelineCache, pRendererPassCache, pResult, pGPUTimer, sectionName);
+    }
+
+    void CMDParser::record(CmdBuffer *pCmdBuffer
+        , BaseCmdRecorder *pRecorder
+        , PipelineCache *pPipelineCache
+        , RendererPassCache *pRendererPassCache
+        , ResultInfo *pResult
+        , GPUTimer *pGPUTimer
+        , const char *sectionName
+        )
+    {
+        record(pCmdBuffer->getRange(), pRecorder, pPipelineCache, pRendererPassCache, pResult, pGPUTimer, sectionName);
+    }
+
+    void CMDParser::record(const CmdBuffer::Range &range
+        , BaseCmdRecorder *pRecorder
+        , PipelineCache *pPipelineCache
+        , RendererPassCache *pRendererPassCache
+        , ResultInfo *pResult
+        , GPUTimer *pGPUTimer
+        , const char *sectionName
+        )
+    {
+        //Timestamps can only be written into a vulkan command buffer.
+        auto pCommandBuffer = pRecorder->getCommandBuffer();
+        if (pCommandBuffer == nullptr) pGPUTimer = nullptr;
         uint32_t drawCount = 0u;
-        auto cmdInfoCount = pCmdBuffer->getCmdCount();
+        auto cmdInfoCount = range.cmdCount;
         uint32_t lastSubPassIndex = 0u;
-        const vk::RenderPass *pRenderPass;
-        const vk::Framebuffer *pFramebuffer;
-        for (uint32_t cmdInfoIndex = 0u; cmdInfoIndex < cmdInfoCount; ++cmdInfoIndex)
+        const vk::RenderPass *pRenderPass = nullptr;
+        const vk::Framebuffer *pFramebuffer = nullptr;
+        //Name is only copied for gpu timer, so recording without timer doesn't allocate it.
+        std::string sectionNameStr;
+        if (pGPUTimer != nullptr && sectionName != nullptr) sectionNameStr = sectionName;
+        Bool32 renderPassTimingEnable = pGPUTimer != nullptr && pGPUTimer->getRenderPassTimingEnable() == VG_TRUE;
+        uint32_t sectionIndex = GPUTimer::INVALID_SECTION_INDEX;
+        uint32_t renderPassSectionIndex = GPUTimer::INVALID_SECTION_INDEX;
+        uint32_t renderPassCount = 0u;
+        if (pGPUTimer != nullptr && cmdInfoCount != 0u)
+        {
+            sectionIndex = pGPUTimer->beginSection(pCommandBuffer, sectionNameStr, VG_TRUE);
+        }
+        for (auto iterator = range.first; iterator != range.last; ++iterator)
         {
-            const auto &cmdInfo = *(pCmdBuffer->getCmdInfos() + cmdInfoIndex);
+            const auto &cmdInfo = *iterator;
             const auto &pRenderPassBeginInfo = cmdInfo.pRenderPassBeginInfo;
             if (pRenderPassBeginInfo != nullptr)
             {
-                recordItemRenderPassBegin(pRenderPassBeginInfo, pCommandBuffer);
+                if (renderPassTimingEnable == VG_TRUE)
+                {
+                    renderPassSectionIndex = pGPUTimer->beginSection(pCommandBuffer, 
+                        sectionNameStr + "/pass" + std::to_string(renderPassCount));
+                    ++renderPassCount;
+                }
+                recordItemRenderPassBegin(pRenderPassBeginInfo, pRecorder);
                 lastSubPassIndex = 0u;
                 pRenderPass = pRenderPassBeginInfo->pRenderPass;
                 pFramebuffer = pRenderPassBeginInfo->pFramebuffer;
@@ -35,7 +82,7 @@ namespace vg
             if (pRenderPassInfo != nullptr)
             {
                 if (pRenderPassInfo->subPassIndex - lastSubPassIndex == 1u) {
-                    recordItemNextSubpass(pCommandBuffer);
+                    recordItemNextSubpass(pRecorder);
                 } else if (pRenderPassInfo->subPassIndex - lastSubPassIndex != 0u) {
                     throw std::runtime_error("Error of increasing of subpass index of render pass for cmd info.");
                 } //else it is inner sub pass.
@@ -44,9 +91,9 @@ namespace vg
                     RenderPassInfo tempRenderPassInfo = *pRenderPassInfo;
                     if (tempRenderPassInfo.pRenderPass == nullptr)tempRenderPassInfo.pRenderPass = pRenderPass;
                     if (tempRenderPassInfo.pFramebuffer == nullptr)tempRenderPassInfo.pFramebuffer = pFramebuffer;
-                    recordItem(&tempRenderPassInfo, pCommandBuffer, pPipelineCache, pRendererPassCache, pResult);
+                    recordItem(&tempRenderPassInfo, pRecorder, pPipelineCache, pRendererPassCache, pResult);
                 } else {
-                    recordItem(pRenderPassInfo, pCommandBuffer, pPipelineCache, pRendererPassCache, pResult);
+                    recordItem(pRenderPassInfo, pRecorder, pPipelineCache, pRendererPassCache, pResult);
                 }
             
                 lastSubPassIndex = pRenderPassInfo->subPassIndex;
@@ -58,13 +105,18 @@ namespace vg
             {
                 pRenderPass = nullptr;
                 pFramebuffer = nullptr;
-                recordItemRenderPassEnd(pRenderPassEndInfo, pCommandBuffer);
+                recordItemRenderPassEnd(pRenderPassEndInfo, pRecorder);
+                if (renderPassTimingEnable == VG_TRUE)
+                {
+                    pGPUTimer->endSection(pCommandBuffer, renderPassSectionIndex);
+                    renderPassSectionIndex = GPUTimer::INVALID_SECTION_INDEX;
+                }
             }
 
             auto pBarrierInfo = cmdInfo.pBarrierInfo;
             if (pBarrierInfo != nullptr)
             {
-                pCommandBuffer->pipelineBarrier(pBarrierInfo->srcStageMask
+                pRecorder->pipelineBarrier(pBarrierInfo->srcStageMask
                     , pBarrierInfo->dstStageMask
                     , pBarrierInfo->dependencyFlags
                     , pBarrierInfo->memoryBarrierCount
@@ -77,25 +129,40 @@ namespace vg
             }
         }
 
+        if (pGPUTimer != nullptr)
+        {
+            //The render pass may be ended by next cmd buffer.
+            pGPUTimer->endSection(pCommandBuffer, renderPassSectionIndex);
+            pGPUTimer->endSection(pCommandBuffer, sectionIndex);
+        }
+
         if (pResult != nullptr)pResult->drawCount = drawCount;
     }
 
     void CMDParser::recordTrunkWaitBarrier(CmdBuffer *pTrunkWaitBarrierCmdBuffer
             , vk::CommandBuffer *pCommandBuffer
             )
+    {
+        VulkanCmdRecorder recorder(pCommandBuffer);
+        recordTrunkWaitBarrier(pTrunkWaitBarrierCmdBuffer, &recorder);
+    }
+
+    void CMDParser::recordTrunkWaitBarrier(CmdBuffer *pTrunkWaitBarrierCmdBuffer
+            , BaseCmdRecorder *pRecorder
+            )
     {
         if (pTrunkWaitBarrierCmdBuffer->getCmdCount() == 0) return;
         vk::PipelineStageFlags srcStageMask = vk::PipelineStageFlags();
         vk::PipelineStageFlags dstStageMask = vk::PipelineStageFlags();
         vk::DependencyFlags dependencyFlags = vk::DependencyFlags();
-        uint32_t cmdCount = pTrunkWaitBarrierCmdBuffer->getCmdCount();
-        for (uint32_t i = 0; i < cmdCount; ++i)
+        auto endIterator = pTrunkWaitBarrierCmdBuffer->getEndCmd();
+        for (auto iterator = pTrunkWaitBarrierCmdBuffer->getFirstCmd(); iterator != endIterator; ++iterator)
         {
-            const auto &cmdInfo = *(pTrunkWaitBarrierCmdBuffer->getCmdInfos() + i);
+            const auto &cmdInfo = *iterator;
             if (cmdInfo.pRenderPassInfo != nullptr) 
                 VG_LOG(plog::warning) << "The render pass info in trunk wait barrier cmd buffer is invalid." << std::endl;
             const auto &trunkWaitBarrierInfo = *(cmdInfo.pBarrierInfo);
-            pCommandBuffer->pipelineBarrier(trunkWaitBarrierInfo.srcStageMask, 
+            pRecorder->pipelineBarrier(trunkWaitBarrierInfo.srcStageMask, 
                 trunkWaitBarrierInfo.dstStageMask, 
                 trunkWaitBarrierInfo.dependencyFlags,
                 trunkWaitBarrierInfo.memoryBarrierCount,
@@ -109,7 +176,7 @@ namespace vg
     }
 
     void CMDParser::recordItemRenderPassBegin(const RenderPassBeginInfo *pRenderPassBeginInfo
-            ,  vk::CommandBuffer *pCommandBuffer)
+            ,  BaseCmdRecorder *pRecorder)
     {
         uint32_t framebufferWidth = pRenderPassBeginInfo->framebufferWidth;
         uint32_t framebufferHeight = pRenderPassBeginInfo->framebufferHeight;
@@ -129,27 +196,27 @@ namespace vg
             pRenderPassBeginInfo->pClearValues
         };
 
-        pCommandBuffer->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
+        pRecorder->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
     }
 
     void CMDParser::recordItemRenderPassEnd(const RenderPassEndInfo *pRenderPassEndInfo
-            ,  vk::CommandBuffer *pCommandBuffer)
+            ,  BaseCmdRecorder *pRecorder)
     {
-        pCommandBuffer->endRenderPass();
+        pRecorder->endRenderPass();
     }
 
-    void CMDParser::recordItemRenderPassEnd(vk::CommandBuffer *pCommandBuffer)
+    void CMDParser::recordItemRenderPassEnd(BaseCmdRecorder *pRecorder)
     {
-        pCommandBuffer->endRenderPass();
+        pRecorder->endRenderPass();
     }
 
-    void CMDParser::recordItemNextSubpass(vk::CommandBuffer *pCommandBuffer)
+    void CMDParser::recordItemNextSubpass(BaseCmdRecorder *pRecorder)
     {
-        pCommandBuffer->nextSubpass(vk::SubpassContents::eInline);
+        pRecorder->nextSubpass(vk::SubpassContents::eInline);
     }
 
     void CMDParser::recordItem(const RenderPassInfo *pRenderPassInfo
-        ,  vk::CommandBuffer *pCommandBuffer
+        ,  BaseCmdRecorder *pRecorder
         , PipelineCache *pPipelineCache
         , RendererPassCache *pRendererPassCache
         , ResultInfo *pResult)
@@ -181,7 +248,7 @@ namespace vg
                 pPipelineCache,
                 pPipeline);
             _recordCommandBuffer(pPipeline.get(),
-                pCommandBuffer,
+                pRecorder,
                 renderPassInfo.framebufferWidth,
                 renderPassInfo.framebufferHeight,
                 renderPassInfo.pMesh,
@@ -191,7 +258,12 @@ namespace vg
                 renderPassInfo.viewport,
                 renderPassInfo.scissor,
                 renderPassInfo.pCmdDraw,
-                renderPassInfo.pCmdDrawIndexed
+                renderPassInfo.pCmdDrawIndexed,
+                renderPassInfo.pGeometryBinding,
+                renderPassInfo.projMatrix,
+                renderPassInfo.viewMatrix,
+                renderPassInfo.modelMatrix,
+                renderPassInfo.omniDirectional
             );
         }
         else
@@ -228,7 +300,7 @@ namespace vg
     }
 
     void CMDParser::_recordCommandBuffer(vk::Pipeline *pPipeline,
-        vk::CommandBuffer *pCommandBuffer,
+        BaseCmdRecorder *pRecorder,
         uint32_t framebufferWidth,
         uint32_t framebufferHeight,
         const BaseMesh *pMesh,
@@ -238,7 +310,12 @@ namespace vg
         const fd::Viewport viewport,
         const fd::Rect2D scissor,
         const CmdDraw * pCmdDraw,
-        const CmdDrawIndexed * pCmdDrawIndexed
+        const CmdDrawIndexed * pCmdDrawIndexed,
+        const CmdGeometryBinding * pGeometryBinding,
+        const Matrix4x4 &projMatrix,
+        const Matrix4x4 &viewMatrix,
+        const Matrix4x4 &modelMatrix,
+        Bool32 omniDirectional
         )
     {   
         const auto& viewportOfPass = pPass->getViewport();
@@ -263,7 +340,7 @@ namespace vg
             1.0f * finalViewport.maxDepth                                      //maxDepth
         };
 
-        pCommandBuffer->setViewport(0, vkViewport);
+        pRecorder->setViewport(0, vkViewport);
 
         fd::Rect2D finalScissor = scissorOfPass;
         glm::vec2 minOfClipRect(scissor.x, scissor.y);
@@ -296,15 +373,16 @@ namespace vg
             }
         };
 
-        pCommandBuffer->setScissor(0, vkScissor);
+        pRecorder->setScissor(0, vkScissor);
 
         auto pPipelineLayout = pRendererPass->getPipelineLayout();    
 
         //push constants
-        auto pushConstantUpdates = pPass->getPushconstantUpdates();
-        for(const auto& pushConstantUpdate : pushConstantUpdates)
+        uint32_t pushConstantUpdateCount = pPass->getPushconstantUpdateCount();
+        for (uint32_t i = 0u; i < pushConstantUpdateCount; ++i)
         {
-            pCommandBuffer->pushConstants(*pPipelineLayout, 
+            auto pushConstantUpdate = pPass->getPushconstantUpdate(i);
+            pRecorder->pushConstants(*pPipelineLayout, 
                 pushConstantUpdate.stageFlags, 
                 pushConstantUpdate.offset,
                 pushConstantUpdate.size,
@@ -319,25 +397,25 @@ namespace vg
             depthBiasInfo.dynamic == VG_TRUE
             ) 
         {
-            pCommandBuffer->setDepthBias(depthBiasUpdateInfo.constantFactor,
+            pRecorder->setDepthBias(depthBiasUpdateInfo.constantFactor,
                 depthBiasUpdateInfo.clamp,
                 depthBiasUpdateInfo.slopeFactor
             );
         }
 
 
-        pCommandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, *pPipeline);
+        pRecorder->bindPipeline(vk::PipelineBindPoint::eGraphics, *pPipeline);
 
         uint32_t descriptSetCount = pRendererPass->getDescriptorSetCount();
         auto pDescriptorSets = pRendererPass->getDescriptorSets();
         uint32_t dynamicOffsetCount = pRendererPass->getPass()->getDescriptorDynamicOffsetCount();
         auto pDynamicOffsets = pRendererPass->getPass()->getDescriptorDynamicOffsets();
 
-        pCommandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pPipelineLayout, 
+        pRecorder->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pPipelineLayout, 
             0u, descriptSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
 
         //dynamic line width
-        pCommandBuffer->setLineWidth(pPass->getLineWidth());
+        pRecorder->setLineWidth(pPass->getLineWidth());
 
         if (pMesh != nullptr) {
             auto pContentMesh = dynamic_cast<const ContentMesh *>(pMesh);
@@ -347,18 +425,25 @@ namespace vg
             const auto &subIndexDatas = pIndexData->getSubIndexDatas();
             const auto &subIndexData = subIndexDatas[subMeshIndex];
     
-            vertexDataToCommandBuffer(*pCommandBuffer, pVertexData, subIndexData.vertexDataIndex);
-            indexDataToCommandBuffer(*pCommandBuffer, pIndexData, subMeshIndex);
+            if (pGeometryBinding != nullptr) {
+                vertexDataToCommandBuffer(*pRecorder, pVertexData, subIndexData.vertexDataIndex,
+                    pGeometryBinding->pVertexBuffer, pGeometryBinding->vertexBufferOffset);
+                indexDataToCommandBuffer(*pRecorder, pIndexData, subMeshIndex,
+                    pGeometryBinding->pIndexBuffer, pGeometryBinding->indexBufferOffset);
+            } else {
+                vertexDataToCommandBuffer(*pRecorder, pVertexData, subIndexData.vertexDataIndex);
+                indexDataToCommandBuffer(*pRecorder, pIndexData, subMeshIndex);
+            }
         }
 
         if (pCmdDraw != nullptr) {
-            pCommandBuffer->draw(pCmdDraw->vertexCount, 
+            pRecorder->draw(pCmdDraw->vertexCount, 
                 pCmdDraw->instanceCount,
                 pCmdDraw->firstVertex,
                 pCmdDraw->firstInstance
                 );
         } else if (pCmdDrawIndexed != nullptr) {
-            pCommandBuffer->drawIndexed(pCmdDrawIndexed->indexCount,
+            pRecorder->drawIndexed(pCmdDrawIndexed->indexCount,
                 pCmdDrawIndexed->instanceCount,
                 pCmdDrawIndexed->firstIndex,
                 pCmdDrawIndexed->vertexOffset,
@@ -385,15 +470,91 @@ namespace vg
             uint32_t instanceOffset = 0u;
             uint32_t instanceCount = pPass->getInstanceCount();
     
-            pCommandBuffer->drawIndexed(subIndexData.indexCount, 
-                instanceCount, 
-                indexOffset, 
-                vertexOffset, 
-                instanceOffset);
+            //Instances may be placed by shader, so clusters are only culled for single instance.
+            //Omni-directional projection isn't a frustum, the whole sub mesh is drawn.
+            if (pContentMesh->getClusterCount(subMeshIndex) != 0u && instanceCount == 1u && omniDirectional == VG_FALSE) {
+                _recordClusterDraws(pRecorder, pContentMesh, subMeshIndex, pPass, 
+                    projMatrix, viewMatrix, modelMatrix);
+            } else {
+                pRecorder->drawIndexed(subIndexData.indexCount, 
+                    instanceCount, 
+                    indexOffset, 
+                    vertexOffset, 
+                    instanceOffset);
+            }
         } else {
 
         }
         //m_pCommandBuffer->draw(3, 1, 0, 0);
     }
 
+    void CMDParser::_recordClusterDraws(BaseCmdRecorder *pRecorder,
+        const ContentMesh *pContentMesh,
+        uint32_t subMeshIndex,
+        const Pass *pPass,
+        const Matrix4x4 &projMatrix,
+        const Matrix4x4 &viewMatrix,
+        const Matrix4x4 &modelMatrix
+        )
+    {
+        uint32_t clusterCount = pContentMesh->getClusterCount(subMeshIndex);
+        const fd::MeshCluster *pClusters = pContentMesh->getClusters(subMeshIndex);
+
+        //Frustum planes in model space.
+        Matrix4x4 mvpMatrix = projMatrix * viewMatrix * modelMatrix;
+        float planes[24];
+        fd::getFrustumPlanes(&mvpMatrix[0][0], planes);
+
+        //Cone culling needs viewer position, it is only for perspective projection.
+        Bool32 cullAway = VG_FALSE;
+        Bool32 cullToward = VG_FALSE;
+        glm::vec4 viewerPosition(0.0f, 0.0f, 0.0f, 1.0f);
+        auto cullMode = pPass->getCullMode();
+        if (pContentMesh->getIsClusterConeCulling() == VG_TRUE && projMatrix[3][3] == 0.0f)
+        {
+            //Normal side of triangles is front when the winding is kept by the transform.
+            Bool32 isNormalSideFront = (pPass->getFrontFace() == vk::FrontFace::eCounterClockwise) == 
+                (glm::determinant(mvpMatrix) > 0.0f);
+            Bool32 cullBack = (cullMode & vk::CullModeFlagBits::eBack) ? VG_TRUE : VG_FALSE;
+            Bool32 cullFront = (cullMode & vk::CullModeFlagBits::eFront) ? VG_TRUE : VG_FALSE;
+            cullAway = isNormalSideFront ? cullBack : cullFront;
+            cullToward = isNormalSideFront ? cullFront : cullBack;
+            viewerPosition = glm::inverse(viewMatrix * modelMatrix) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            viewerPosition /= viewerPosition.w;
+        }
+
+        uint32_t drawIndexOffset = 0u;
+        uint32_t drawIndexCount = 0u;
+        for (uint32_t i = 0; i < clusterCount; ++i)
+        {
+            const auto &cluster = pClusters[i];
+            Bool32 isVisible = fd::isClusterOutsideFrustum(cluster, planes) == VG_FALSE;
+            if (isVisible == VG_TRUE && cullAway == VG_TRUE)
+            {
+                isVisible = fd::isClusterBackfacing(cluster, &viewerPosition[0]) == VG_FALSE;
+            }
+            if (isVisible == VG_TRUE && cullToward == VG_TRUE)
+            {
+                fd::MeshCluster reversedCluster = cluster;
+                for (uint32_t j = 0; j < 3u; ++j) reversedCluster.coneAxis[j] = - cluster.coneAxis[j];
+                isVisible = fd::isClusterBackfacing(reversedCluster, &viewerPosition[0]) == VG_FALSE;
+            }
+
+            if (isVisible == VG_TRUE)
+            {
+                if (drawIndexCount == 0u) drawIndexOffset = cluster.indexOffset;
+                drawIndexCount += cluster.indexCount;
+            }
+            else if (drawIndexCount != 0u)
+            {
+                pRecorder->drawIndexed(drawIndexCount, 1u, drawIndexOffset, 0u, 0u);
+                drawIndexCount = 0u;
+            }
+        }
+        if (drawIndexCount != 0u)
+        {
+            pRecorder->drawIndexed(drawIndexCount, 1u, drawIndexOffset, 0u, 0u);
+        }
+    }
+
 } //vg
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "graphics/mesh/mesh.hpp"
 #include "graphics/buffer_data/util.hpp"
 #include "graphics/material/cmd.hpp"
+#include "graphics/renderer/gpu_timer.hpp"
+#include "graphics/renderer/cmd_recorder.hpp"
 
 namespace vg
 {
@@ -20,28 +22,59 @@ namespace vg
             ResultInfo(uint32_t drawCount = 0u);
         };
 
+        /*When gpu timer is not null, timestamps are written around the cmd buffer as a section named
+          by section name, and around every render pass of it when render pass timing is enabled.*/
         static void record(CmdBuffer *pCmdBuffer
             , vk::CommandBuffer *pCommandBuffer
             , PipelineCache *pPipelineCache
             , RendererPassCache *pRendererPassCache
             , ResultInfo *pResult = nullptr
+            , GPUTimer *pGPUTimer = nullptr
+            , const char *sectionName = nullptr
+            );
+
+        //Gpu timer is ignored when the recorder doesn't record into a vulkan command buffer.
+        static void record(CmdBuffer *pCmdBuffer
+            , BaseCmdRecorder *pRecorder
+            , PipelineCache *pPipelineCache
+            , RendererPassCache *pRendererPassCache
+            , ResultInfo *pResult = nullptr
+            , GPUTimer *pGPUTimer = nullptr
+            , const char *sectionName = nullptr
+            );
+
+        /*Ranges of a cmd buffer can be recorded into different command buffers, a range beginning inside
+          a render pass should be recorded into a secondary command buffer continuing the render pass, and
+          render pass infos of it should have render pass and framebuffer. Recording isn't thread safe, the
+          frame arena and pipeline and renderer pass caches are shared, so ranges are recorded one by one.*/
+        static void record(const CmdBuffer::Range &range
+            , BaseCmdRecorder *pRecorder
+            , PipelineCache *pPipelineCache
+            , RendererPassCache *pRendererPassCache
+            , ResultInfo *pResult = nullptr
+            , GPUTimer *pGPUTimer = nullptr
+            , const char *sectionName = nullptr
             );
             
         static void recordTrunkWaitBarrier(CmdBuffer *pTrunkWaitBarrierCmdBuffer
             , vk::CommandBuffer *pCommandBuffer
             );
 
+        static void recordTrunkWaitBarrier(CmdBuffer *pTrunkWaitBarrierCmdBuffer
+            , BaseCmdRecorder *pRecorder
+            );
+
         static void recordItemRenderPassBegin(const RenderPassBeginInfo *pRenderPassBeginInfo
-            ,  vk::CommandBuffer *pCommandBuffer
+            ,  BaseCmdRecorder *pRecorder
             );
         static void recordItemRenderPassEnd(const RenderPassEndInfo *pRenderPassEndInfo
-            ,  vk::CommandBuffer *pCommandBuffer);
-        static void recordItemRenderPassEnd(vk::CommandBuffer *pCommandBuffer);
+            ,  BaseCmdRecorder *pRecorder);
+        static void recordItemRenderPassEnd(BaseCmdRecorder *pRecorder);
 
-        static void recordItemNextSubpass(vk::CommandBuffer *pCommandBuffer);
+        static void recordItemNextSubpass(BaseCmdRecorder *pRecorder);
 
         static void recordItem(const RenderPassInfo *pRenderPassInfo
-            , vk::CommandBuffer *pCommandBuffer
+            , BaseCmdRecorder *pRecorder
             , PipelineCache *pPipelineCache
             , RendererPassCache *pRendererPassCache
             , ResultInfo *pResult = nullptr);
@@ -55,7 +88,7 @@ namespace vg
             std::shared_ptr<vk::Pipeline> &pPipeline);
 
         static void _recordCommandBuffer(vk::Pipeline *pPipeline,
-            vk::CommandBuffer *pCommandBuffer,
+            BaseCmdRecorder *pRecorder,
             uint32_t framebufferWidth,
             uint32_t framebufferHeight,
             const BaseMesh *pMesh,
@@ -65,7 +98,23 @@ namespace vg
             const fd::Viewport viewport,
             const fd::Rect2D scissor,
             const CmdDraw * pCmdDraw,
-            const CmdDrawIndexed * pCmdDrawIndexed
+            const CmdDrawIndexed * pCmdDrawIndexed,
+            const CmdGeometryBinding * pGeometryBinding,
+            const Matrix4x4 &projMatrix,
+            const Matrix4x4 &viewMatrix,
+            const Matrix4x4 &modelMatrix,
+            Bool32 omniDirectional
+        );
+
+        /*Cull clusters of the sub mesh with the frustum and normal cones, and draw visible clusters,
+          adjacent visible clusters are merged to one draw.*/
+        static void _recordClusterDraws(BaseCmdRecorder *pRecorder,
+            const ContentMesh *pContentMesh,
+            uint32_t subMeshIndex,
+            const Pass *pPass,
+            const Matrix4x4 &projMatrix,
+            const Matrix4x4 &viewMatrix,
+            const Matrix4x4 &modelMatrix
         );
     };
 } //vg
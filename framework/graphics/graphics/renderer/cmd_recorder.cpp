@@ -0,0 +1,1062 @@
+#include "graphics/renderer/cmd_recorder.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace vg
+{
+    BaseCmdRecorder::BaseCmdRecorder()
+    {
+
+    }
+
+    BaseCmdRecorder::~BaseCmdRecorder()
+    {
+
+    }
+
+    vk::CommandBuffer *BaseCmdRecorder::getCommandBuffer() const
+    {
+        return nullptr;
+    }
+
+    VulkanCmdRecorder::VulkanCmdRecorder(vk::CommandBuffer *pCommandBuffer)
+        : BaseCmdRecorder()
+        , m_pCommandBuffer(pCommandBuffer)
+    {
+
+    }
+
+    vk::CommandBuffer *VulkanCmdRecorder::getCommandBuffer() const
+    {
+        return m_pCommandBuffer;
+    }
+
+    void VulkanCmdRecorder::setCommandBuffer(vk::CommandBuffer *pCommandBuffer)
+    {
+        m_pCommandBuffer = pCommandBuffer;
+    }
+
+    void VulkanCmdRecorder::beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents)
+    {
+        m_pCommandBuffer->beginRenderPass(beginInfo, contents);
+    }
+
+    void VulkanCmdRecorder::nextSubpass(vk::SubpassContents contents)
+    {
+        m_pCommandBuffer->nextSubpass(contents);
+    }
+
+    void VulkanCmdRecorder::endRenderPass()
+    {
+        m_pCommandBuffer->endRenderPass();
+    }
+
+    void VulkanCmdRecorder::pipelineBarrier(vk::PipelineStageFlags srcStageMask
+        , vk::PipelineStageFlags dstStageMask
+        , vk::DependencyFlags dependencyFlags
+        , uint32_t memoryBarrierCount
+        , const vk::MemoryBarrier *pMemoryBarriers
+        , uint32_t bufferMemoryBarrierCount
+        , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+        , uint32_t imageMemoryBarrierCount
+        , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+        )
+    {
+        m_pCommandBuffer->pipelineBarrier(srcStageMask
+            , dstStageMask
+            , dependencyFlags
+            , memoryBarrierCount
+            , pMemoryBarriers
+            , bufferMemoryBarrierCount
+            , pBufferMemoryBarriers
+            , imageMemoryBarrierCount
+            , pImageMemoryBarriers
+            );
+    }
+
+    void VulkanCmdRecorder::setViewport(uint32_t firstViewport, const vk::Viewport &viewport)
+    {
+        m_pCommandBuffer->setViewport(firstViewport, viewport);
+    }
+
+    void VulkanCmdRecorder::setScissor(uint32_t firstScissor, const vk::Rect2D &scissor)
+    {
+        m_pCommandBuffer->setScissor(firstScissor, scissor);
+    }
+
+    void VulkanCmdRecorder::setDepthBias(float constantFactor, float clamp, float slopeFactor)
+    {
+        m_pCommandBuffer->setDepthBias(constantFactor, clamp, slopeFactor);
+    }
+
+    void VulkanCmdRecorder::setLineWidth(float lineWidth)
+    {
+        m_pCommandBuffer->setLineWidth(lineWidth);
+    }
+
+    void VulkanCmdRecorder::pushConstants(vk::PipelineLayout layout
+        , vk::ShaderStageFlags stageFlags
+        , uint32_t offset
+        , uint32_t size
+        , const void *pValues
+        )
+    {
+        m_pCommandBuffer->pushConstants(layout, stageFlags, offset, size, pValues);
+    }
+
+    void VulkanCmdRecorder::bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline)
+    {
+        m_pCommandBuffer->bindPipeline(bindPoint, pipeline);
+    }
+
+    void VulkanCmdRecorder::bindDescriptorSets(vk::PipelineBindPoint bindPoint
+        , vk::PipelineLayout layout
+        , uint32_t firstSet
+        , uint32_t descriptorSetCount
+        , const vk::DescriptorSet *pDescriptorSets
+        , uint32_t dynamicOffsetCount
+        , const uint32_t *pDynamicOffsets
+        )
+    {
+        m_pCommandBuffer->bindDescriptorSets(bindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets,
+            dynamicOffsetCount, pDynamicOffsets);
+    }
+
+    void VulkanCmdRecorder::bindVertexBuffers(uint32_t firstBinding
+        , uint32_t bindingCount
+        , const vk::Buffer *pBuffers
+        , const vk::DeviceSize *pOffsets
+        )
+    {
+        m_pCommandBuffer->bindVertexBuffers(firstBinding, bindingCount, pBuffers, pOffsets);
+    }
+
+    void VulkanCmdRecorder::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType)
+    {
+        m_pCommandBuffer->bindIndexBuffer(buffer, offset, indexType);
+    }
+
+    void VulkanCmdRecorder::draw(uint32_t vertexCount
+        , uint32_t instanceCount
+        , uint32_t firstVertex
+        , uint32_t firstInstance
+        )
+    {
+        m_pCommandBuffer->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    void VulkanCmdRecorder::drawIndexed(uint32_t indexCount
+        , uint32_t instanceCount
+        , uint32_t firstIndex
+        , int32_t vertexOffset
+        , uint32_t firstInstance
+        )
+    {
+        m_pCommandBuffer->drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+
+    NullCmdRecorder::NullCmdRecorder()
+        : BaseCmdRecorder()
+        , m_counts()
+        , m_redundantCounts()
+        , m_drawVertexCount(0u)
+        , m_stateValids()
+        , m_viewport()
+        , m_scissor()
+        , m_depthBias()
+        , m_lineWidth(0.0f)
+        , m_pipeline()
+        , m_descriptorSetLayout()
+        , m_descriptorSets()
+        , m_dynamicOffsets()
+        , m_vertexBuffers()
+        , m_vertexBufferOffsets()
+        , m_indexBuffer()
+        , m_indexBufferOffset(0u)
+        , m_indexType()
+    {
+        reset();
+    }
+
+    uint32_t NullCmdRecorder::getCount(CmdRecordType type) const
+    {
+        return m_counts[static_cast<size_t>(type)];
+    }
+
+    uint32_t NullCmdRecorder::getRedundantCount(CmdRecordType type) const
+    {
+        return m_redundantCounts[static_cast<size_t>(type)];
+    }
+
+    uint32_t NullCmdRecorder::getTotalCount() const
+    {
+        uint32_t count = 0u;
+        for (const auto &item : m_counts)
+        {
+            count += item;
+        }
+        return count;
+    }
+
+    uint32_t NullCmdRecorder::getDrawCount() const
+    {
+        return getCount(CmdRecordType::DRAW) + getCount(CmdRecordType::DRAW_INDEXED);
+    }
+
+    uint64_t NullCmdRecorder::getDrawVertexCount() const
+    {
+        return m_drawVertexCount;
+    }
+
+    void NullCmdRecorder::reset()
+    {
+        m_counts.fill(0u);
+        m_redundantCounts.fill(0u);
+        m_drawVertexCount = 0u;
+        m_stateValids.fill(VG_FALSE);
+    }
+
+    void NullCmdRecorder::beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents)
+    {
+        _count(CmdRecordType::BEGIN_RENDER_PASS);
+        //State bound in other render pass isn't compared.
+        m_stateValids.fill(VG_FALSE);
+    }
+
+    void NullCmdRecorder::nextSubpass(vk::SubpassContents contents)
+    {
+        _count(CmdRecordType::NEXT_SUBPASS);
+    }
+
+    void NullCmdRecorder::endRenderPass()
+    {
+        _count(CmdRecordType::END_RENDER_PASS);
+    }
+
+    void NullCmdRecorder::pipelineBarrier(vk::PipelineStageFlags srcStageMask
+        , vk::PipelineStageFlags dstStageMask
+        , vk::DependencyFlags dependencyFlags
+        , uint32_t memoryBarrierCount
+        , const vk::MemoryBarrier *pMemoryBarriers
+        , uint32_t bufferMemoryBarrierCount
+        , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+        , uint32_t imageMemoryBarrierCount
+        , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+        )
+    {
+        _count(CmdRecordType::PIPELINE_BARRIER);
+    }
+
+    void NullCmdRecorder::setViewport(uint32_t firstViewport, const vk::Viewport &viewport)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::SET_VIEWPORT)];
+        _count(CmdRecordType::SET_VIEWPORT, isValid == VG_TRUE && m_viewport == viewport);
+        isValid = VG_TRUE;
+        m_viewport = viewport;
+    }
+
+    void NullCmdRecorder::setScissor(uint32_t firstScissor, const vk::Rect2D &scissor)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::SET_SCISSOR)];
+        _count(CmdRecordType::SET_SCISSOR, isValid == VG_TRUE && m_scissor == scissor);
+        isValid = VG_TRUE;
+        m_scissor = scissor;
+    }
+
+    void NullCmdRecorder::setDepthBias(float constantFactor, float clamp, float slopeFactor)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::SET_DEPTH_BIAS)];
+        std::array<float, 3> depthBias = {constantFactor, clamp, slopeFactor};
+        _count(CmdRecordType::SET_DEPTH_BIAS, isValid == VG_TRUE && m_depthBias == depthBias);
+        isValid = VG_TRUE;
+        m_depthBias = depthBias;
+    }
+
+    void NullCmdRecorder::setLineWidth(float lineWidth)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::SET_LINE_WIDTH)];
+        _count(CmdRecordType::SET_LINE_WIDTH, isValid == VG_TRUE && m_lineWidth == lineWidth);
+        isValid = VG_TRUE;
+        m_lineWidth = lineWidth;
+    }
+
+    void NullCmdRecorder::pushConstants(vk::PipelineLayout layout
+        , vk::ShaderStageFlags stageFlags
+        , uint32_t offset
+        , uint32_t size
+        , const void *pValues
+        )
+    {
+        _count(CmdRecordType::PUSH_CONSTANTS);
+    }
+
+    void NullCmdRecorder::bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::BIND_PIPELINE)];
+        _count(CmdRecordType::BIND_PIPELINE, isValid == VG_TRUE && m_pipeline == pipeline);
+        isValid = VG_TRUE;
+        m_pipeline = pipeline;
+    }
+
+    void NullCmdRecorder::bindDescriptorSets(vk::PipelineBindPoint bindPoint
+        , vk::PipelineLayout layout
+        , uint32_t firstSet
+        , uint32_t descriptorSetCount
+        , const vk::DescriptorSet *pDescriptorSets
+        , uint32_t dynamicOffsetCount
+        , const uint32_t *pDynamicOffsets
+        )
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::BIND_DESCRIPTOR_SETS)];
+        Bool32 isRedundant = isValid == VG_TRUE &&
+            firstSet == 0u &&
+            m_descriptorSetLayout == layout &&
+            m_descriptorSets.size() == descriptorSetCount &&
+            m_dynamicOffsets.size() == dynamicOffsetCount &&
+            std::equal(m_descriptorSets.begin(), m_descriptorSets.end(), pDescriptorSets) &&
+            std::equal(m_dynamicOffsets.begin(), m_dynamicOffsets.end(), pDynamicOffsets);
+        _count(CmdRecordType::BIND_DESCRIPTOR_SETS, isRedundant);
+        //Only sets bound from first set are kept for comparing.
+        isValid = firstSet == 0u ? VG_TRUE : VG_FALSE;
+        m_descriptorSetLayout = layout;
+        m_descriptorSets.assign(pDescriptorSets, pDescriptorSets + descriptorSetCount);
+        m_dynamicOffsets.assign(pDynamicOffsets, pDynamicOffsets + dynamicOffsetCount);
+    }
+
+    void NullCmdRecorder::bindVertexBuffers(uint32_t firstBinding
+        , uint32_t bindingCount
+        , const vk::Buffer *pBuffers
+        , const vk::DeviceSize *pOffsets
+        )
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::BIND_VERTEX_BUFFERS)];
+        Bool32 isRedundant = isValid == VG_TRUE &&
+            firstBinding == 0u &&
+            m_vertexBuffers.size() == bindingCount &&
+            std::equal(m_vertexBuffers.begin(), m_vertexBuffers.end(), pBuffers) &&
+            std::equal(m_vertexBufferOffsets.begin(), m_vertexBufferOffsets.end(), pOffsets);
+        _count(CmdRecordType::BIND_VERTEX_BUFFERS, isRedundant);
+        isValid = firstBinding == 0u ? VG_TRUE : VG_FALSE;
+        m_vertexBuffers.assign(pBuffers, pBuffers + bindingCount);
+        m_vertexBufferOffsets.assign(pOffsets, pOffsets + bindingCount);
+    }
+
+    void NullCmdRecorder::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType)
+    {
+        auto &isValid = m_stateValids[static_cast<size_t>(CmdRecordType::BIND_INDEX_BUFFER)];
+        Bool32 isRedundant = isValid == VG_TRUE &&
+            m_indexBuffer == buffer &&
+            m_indexBufferOffset == offset &&
+            m_indexType == indexType;
+        _count(CmdRecordType::BIND_INDEX_BUFFER, isRedundant);
+        isValid = VG_TRUE;
+        m_indexBuffer = buffer;
+        m_indexBufferOffset = offset;
+        m_indexType = indexType;
+    }
+
+    void NullCmdRecorder::draw(uint32_t vertexCount
+        , uint32_t instanceCount
+        , uint32_t firstVertex
+        , uint32_t firstInstance
+        )
+    {
+        _count(CmdRecordType::DRAW);
+        m_drawVertexCount += static_cast<uint64_t>(vertexCount) * static_cast<uint64_t>(instanceCount);
+    }
+
+    void NullCmdRecorder::drawIndexed(uint32_t indexCount
+        , uint32_t instanceCount
+        , uint32_t firstIndex
+        , int32_t vertexOffset
+        , uint32_t firstInstance
+        )
+    {
+        _count(CmdRecordType::DRAW_INDEXED);
+        m_drawVertexCount += static_cast<uint64_t>(indexCount) * static_cast<uint64_t>(instanceCount);
+    }
+
+    void NullCmdRecorder::_count(CmdRecordType type, Bool32 isRedundant)
+    {
+        ++m_counts[static_cast<size_t>(type)];
+        if (isRedundant == VG_TRUE) ++m_redundantCounts[static_cast<size_t>(type)];
+    }
+
+    //"VGCT" in little endian.
+    const uint32_t TraceCmdRecorder::TRACE_MAGIC = 0x54434756u;
+    const uint32_t TraceCmdRecorder::TRACE_VERSION = 1u;
+
+    template <typename HandleType>
+    void TraceCmdRecorder::_writeHandle(HandleType handle)
+    {
+        uint64_t value = 0u;
+        std::memcpy(&value, &handle, sizeof(handle));
+        uint32_t id = 0u;
+        if (value != 0u)
+        {
+            auto iterator = m_handleIDs.find(value);
+            if (iterator == m_handleIDs.end())
+            {
+                id = static_cast<uint32_t>(m_handleIDs.size()) + 1u;
+                m_handleIDs[value] = id;
+            }
+            else
+            {
+                id = iterator->second;
+            }
+        }
+        _writeUint32(id);
+    }
+
+    TraceCmdRecorder::TraceCmdRecorder()
+        : BaseCmdRecorder()
+        , m_data()
+        , m_cmdCount(0u)
+        , m_handleIDs()
+    {
+        _writeHeader();
+    }
+
+    const std::vector<uint8_t> &TraceCmdRecorder::getData() const
+    {
+        return m_data;
+    }
+
+    uint32_t TraceCmdRecorder::getCmdCount() const
+    {
+        return m_cmdCount;
+    }
+
+    uint32_t TraceCmdRecorder::getHandleCount() const
+    {
+        return static_cast<uint32_t>(m_handleIDs.size());
+    }
+
+    void TraceCmdRecorder::reset()
+    {
+        m_data.clear();
+        m_cmdCount = 0u;
+        m_handleIDs.clear();
+        _writeHeader();
+    }
+
+    Bool32 TraceCmdRecorder::save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (file.is_open() == false)
+        {
+            VG_LOG(plog::warning) << "Failed to open file to save cmd trace: " << path << std::endl;
+            return VG_FALSE;
+        }
+        file.write(reinterpret_cast<const char *>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+        return VG_TRUE;
+    }
+
+    Bool32 TraceCmdRecorder::load(const std::string &path, std::vector<uint8_t> &data)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (file.is_open() == false)
+        {
+            VG_LOG(plog::warning) << "Failed to open file to load cmd trace: " << path << std::endl;
+            return VG_FALSE;
+        }
+        auto end = file.tellg();
+        if (end < 0)
+        {
+            VG_LOG(plog::warning) << "Failed to get size of cmd trace: " << path << std::endl;
+            return VG_FALSE;
+        }
+        auto size = static_cast<size_t>(end);
+        data.resize(size);
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(size));
+        if (file.fail() || static_cast<size_t>(file.gcount()) != size)
+        {
+            VG_LOG(plog::warning) << "Failed to read cmd trace, read " << file.gcount() << " of " << size
+                << " bytes: " << path << std::endl;
+            data.clear();
+            return VG_FALSE;
+        }
+        return VG_TRUE;
+    }
+
+    //Reader of trace data, it becomes invalid when reading goes over the end of data.
+    struct _TraceReader
+    {
+        const std::vector<uint8_t> &data;
+        size_t offset;
+        Bool32 isValid;
+
+        void read(void *pValue, size_t size)
+        {
+            if (isValid == VG_FALSE || offset + size > data.size())
+            {
+                isValid = VG_FALSE;
+                std::memset(pValue, 0, size);
+                return;
+            }
+            std::memcpy(pValue, data.data() + offset, size);
+            offset += size;
+        }
+
+        uint32_t readUint32()
+        {
+            uint32_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        uint64_t readUint64()
+        {
+            uint64_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        //Count of items is invalid when the items are bigger than rest of data.
+        uint32_t readCount(size_t itemSize)
+        {
+            uint32_t count = readUint32();
+            if (isValid == VG_TRUE && static_cast<uint64_t>(count) * itemSize > data.size() - offset)
+            {
+                isValid = VG_FALSE;
+            }
+            return isValid == VG_TRUE ? count : 0u;
+        }
+
+        float readFloat()
+        {
+            float value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        //Handle is made of the id, so ids are kept when it is recorded by another trace recorder.
+        template <typename HandleType>
+        HandleType readHandle()
+        {
+            uint64_t id = static_cast<uint64_t>(readUint32());
+            HandleType handle;
+            std::memcpy(&handle, &id, sizeof(handle));
+            return handle;
+        }
+    };
+
+    Bool32 TraceCmdRecorder::replay(const std::vector<uint8_t> &data, BaseCmdRecorder *pRecorder)
+    {
+        _TraceReader reader = {data, 0u, VG_TRUE};
+        if (reader.readUint32() != TRACE_MAGIC || reader.readUint32() != TRACE_VERSION)
+        {
+            VG_LOG(plog::warning) << "Invalid header of cmd trace." << std::endl;
+            return VG_FALSE;
+        }
+
+        std::vector<vk::ClearValue> clearValues;
+        std::vector<vk::MemoryBarrier> memoryBarriers;
+        std::vector<vk::BufferMemoryBarrier> bufferMemoryBarriers;
+        std::vector<vk::ImageMemoryBarrier> imageMemoryBarriers;
+        std::vector<uint8_t> pushConstantValues;
+        std::vector<vk::DescriptorSet> descriptorSets;
+        std::vector<uint32_t> dynamicOffsets;
+        std::vector<vk::Buffer> buffers;
+        std::vector<vk::DeviceSize> offsets;
+        while (reader.offset < data.size())
+        {
+            uint8_t typeValue;
+            reader.read(&typeValue, sizeof(typeValue));
+            if (typeValue >= static_cast<uint8_t>(CmdRecordType::RANGE_SIZE))
+            {
+                reader.isValid = VG_FALSE;
+                break;
+            }
+            auto type = static_cast<CmdRecordType>(typeValue);
+            switch (type)
+            {
+            case CmdRecordType::BEGIN_RENDER_PASS:
+            {
+                vk::RenderPassBeginInfo beginInfo;
+                beginInfo.renderPass = reader.readHandle<vk::RenderPass>();
+                beginInfo.framebuffer = reader.readHandle<vk::Framebuffer>();
+                beginInfo.renderArea.offset.x = static_cast<int32_t>(reader.readUint32());
+                beginInfo.renderArea.offset.y = static_cast<int32_t>(reader.readUint32());
+                beginInfo.renderArea.extent.width = reader.readUint32();
+                beginInfo.renderArea.extent.height = reader.readUint32();
+                auto contents = static_cast<vk::SubpassContents>(reader.readUint32());
+                uint32_t clearValueCount = reader.readCount(sizeof(vk::ClearValue));
+                if (reader.isValid == VG_FALSE) break;
+                clearValues.resize(clearValueCount);
+                for (auto &clearValue : clearValues)
+                {
+                    reader.read(&clearValue, sizeof(clearValue));
+                }
+                beginInfo.clearValueCount = clearValueCount;
+                beginInfo.pClearValues = clearValues.data();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->beginRenderPass(beginInfo, contents);
+                break;
+            }
+            case CmdRecordType::NEXT_SUBPASS:
+            {
+                auto contents = static_cast<vk::SubpassContents>(reader.readUint32());
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->nextSubpass(contents);
+                break;
+            }
+            case CmdRecordType::END_RENDER_PASS:
+            {
+                pRecorder->endRenderPass();
+                break;
+            }
+            case CmdRecordType::PIPELINE_BARRIER:
+            {
+                auto srcStageMask = vk::PipelineStageFlags(static_cast<vk::PipelineStageFlagBits>(reader.readUint32()));
+                auto dstStageMask = vk::PipelineStageFlags(static_cast<vk::PipelineStageFlagBits>(reader.readUint32()));
+                auto dependencyFlags = vk::DependencyFlags(static_cast<vk::DependencyFlagBits>(reader.readUint32()));
+                memoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 2u));
+                for (auto &barrier : memoryBarriers)
+                {
+                    barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    if (reader.isValid == VG_FALSE) break;
+                }
+                bufferMemoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 5u + sizeof(uint64_t) * 2u));
+                for (auto &barrier : bufferMemoryBarriers)
+                {
+                    barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    barrier.srcQueueFamilyIndex = reader.readUint32();
+                    barrier.dstQueueFamilyIndex = reader.readUint32();
+                    barrier.buffer = reader.readHandle<vk::Buffer>();
+                    barrier.offset = reader.readUint64();
+                    barrier.size = reader.readUint64();
+                    if (reader.isValid == VG_FALSE) break;
+                }
+                imageMemoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 12u));
+                for (auto &barrier : imageMemoryBarriers)
+                {
+                    barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    barrier.oldLayout = static_cast<vk::ImageLayout>(reader.readUint32());
+                    barrier.newLayout = static_cast<vk::ImageLayout>(reader.readUint32());
+                    barrier.srcQueueFamilyIndex = reader.readUint32();
+                    barrier.dstQueueFamilyIndex = reader.readUint32();
+                    barrier.image = reader.readHandle<vk::Image>();
+                    barrier.subresourceRange.aspectMask = vk::ImageAspectFlags(
+                        static_cast<vk::ImageAspectFlagBits>(reader.readUint32()));
+                    barrier.subresourceRange.baseMipLevel = reader.readUint32();
+                    barrier.subresourceRange.levelCount = reader.readUint32();
+                    barrier.subresourceRange.baseArrayLayer = reader.readUint32();
+                    barrier.subresourceRange.layerCount = reader.readUint32();
+                    if (reader.isValid == VG_FALSE) break;
+                }
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->pipelineBarrier(srcStageMask
+                    , dstStageMask
+                    , dependencyFlags
+                    , static_cast<uint32_t>(memoryBarriers.size())
+                    , memoryBarriers.data()
+                    , static_cast<uint32_t>(bufferMemoryBarriers.size())
+                    , bufferMemoryBarriers.data()
+                    , static_cast<uint32_t>(imageMemoryBarriers.size())
+                    , imageMemoryBarriers.data()
+                    );
+                break;
+            }
+            case CmdRecordType::SET_VIEWPORT:
+            {
+                uint32_t firstViewport = reader.readUint32();
+                vk::Viewport viewport;
+                viewport.x = reader.readFloat();
+                viewport.y = reader.readFloat();
+                viewport.width = reader.readFloat();
+                viewport.height = reader.readFloat();
+                viewport.minDepth = reader.readFloat();
+                viewport.maxDepth = reader.readFloat();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->setViewport(firstViewport, viewport);
+                break;
+            }
+            case CmdRecordType::SET_SCISSOR:
+            {
+                uint32_t firstScissor = reader.readUint32();
+                vk::Rect2D scissor;
+                scissor.offset.x = static_cast<int32_t>(reader.readUint32());
+                scissor.offset.y = static_cast<int32_t>(reader.readUint32());
+                scissor.extent.width = reader.readUint32();
+                scissor.extent.height = reader.readUint32();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->setScissor(firstScissor, scissor);
+                break;
+            }
+            case CmdRecordType::SET_DEPTH_BIAS:
+            {
+                float constantFactor = reader.readFloat();
+                float clamp = reader.readFloat();
+                float slopeFactor = reader.readFloat();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->setDepthBias(constantFactor, clamp, slopeFactor);
+                break;
+            }
+            case CmdRecordType::SET_LINE_WIDTH:
+            {
+                float lineWidth = reader.readFloat();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->setLineWidth(lineWidth);
+                break;
+            }
+            case CmdRecordType::PUSH_CONSTANTS:
+            {
+                auto layout = reader.readHandle<vk::PipelineLayout>();
+                auto stageFlags = vk::ShaderStageFlags(static_cast<vk::ShaderStageFlagBits>(reader.readUint32()));
+                uint32_t offset = reader.readUint32();
+                uint32_t size = reader.readCount(sizeof(uint8_t));
+                if (reader.isValid == VG_FALSE) break;
+                pushConstantValues.resize(size);
+                reader.read(pushConstantValues.data(), size);
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->pushConstants(layout, stageFlags, offset, size, pushConstantValues.data());
+                break;
+            }
+            case CmdRecordType::BIND_PIPELINE:
+            {
+                auto bindPoint = static_cast<vk::PipelineBindPoint>(reader.readUint32());
+                auto pipeline = reader.readHandle<vk::Pipeline>();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->bindPipeline(bindPoint, pipeline);
+                break;
+            }
+            case CmdRecordType::BIND_DESCRIPTOR_SETS:
+            {
+                auto bindPoint = static_cast<vk::PipelineBindPoint>(reader.readUint32());
+                auto layout = reader.readHandle<vk::PipelineLayout>();
+                uint32_t firstSet = reader.readUint32();
+                descriptorSets.resize(reader.readCount(sizeof(uint32_t)));
+                for (auto &descriptorSet : descriptorSets)
+                {
+                    descriptorSet = reader.readHandle<vk::DescriptorSet>();
+                    if (reader.isValid == VG_FALSE) break;
+                }
+                dynamicOffsets.resize(reader.readCount(sizeof(uint32_t)));
+                for (auto &dynamicOffset : dynamicOffsets)
+                {
+                    dynamicOffset = reader.readUint32();
+                    if (reader.isValid == VG_FALSE) break;
+                }
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->bindDescriptorSets(bindPoint
+                    , layout
+                    , firstSet
+                    , static_cast<uint32_t>(descriptorSets.size())
+                    , descriptorSets.data()
+                    , static_cast<uint32_t>(dynamicOffsets.size())
+                    , dynamicOffsets.data()
+                    );
+                break;
+            }
+            case CmdRecordType::BIND_VERTEX_BUFFERS:
+            {
+                uint32_t firstBinding = reader.readUint32();
+                uint32_t bindingCount = reader.readCount(sizeof(uint32_t) + sizeof(uint64_t));
+                buffers.resize(bindingCount);
+                offsets.resize(bindingCount);
+                for (uint32_t i = 0; i < bindingCount && reader.isValid == VG_TRUE; ++i)
+                {
+                    buffers[i] = reader.readHandle<vk::Buffer>();
+                    offsets[i] = reader.readUint64();
+                }
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->bindVertexBuffers(firstBinding, bindingCount, buffers.data(), offsets.data());
+                break;
+            }
+            case CmdRecordType::BIND_INDEX_BUFFER:
+            {
+                auto buffer = reader.readHandle<vk::Buffer>();
+                vk::DeviceSize offset = reader.readUint64();
+                auto indexType = static_cast<vk::IndexType>(reader.readUint32());
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->bindIndexBuffer(buffer, offset, indexType);
+                break;
+            }
+            case CmdRecordType::DRAW:
+            {
+                uint32_t vertexCount = reader.readUint32();
+                uint32_t instanceCount = reader.readUint32();
+                uint32_t firstVertex = reader.readUint32();
+                uint32_t firstInstance = reader.readUint32();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+                break;
+            }
+            case CmdRecordType::DRAW_INDEXED:
+            {
+                uint32_t indexCount = reader.readUint32();
+                uint32_t instanceCount = reader.readUint32();
+                uint32_t firstIndex = reader.readUint32();
+                int32_t vertexOffset = static_cast<int32_t>(reader.readUint32());
+                uint32_t firstInstance = reader.readUint32();
+                if (reader.isValid == VG_FALSE) break;
+                pRecorder->drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+                break;
+            }
+            default:
+                reader.isValid = VG_FALSE;
+                break;
+            }
+            if (reader.isValid == VG_FALSE) break;
+        }
+
+        if (reader.isValid == VG_FALSE)
+        {
+            VG_LOG(plog::warning) << "Invalid cmd in cmd trace at offset: " << reader.offset << std::endl;
+        }
+        return reader.isValid;
+    }
+
+    void TraceCmdRecorder::beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents)
+    {
+        _writeType(CmdRecordType::BEGIN_RENDER_PASS);
+        _writeHandle(beginInfo.renderPass);
+        _writeHandle(beginInfo.framebuffer);
+        _writeUint32(static_cast<uint32_t>(beginInfo.renderArea.offset.x));
+        _writeUint32(static_cast<uint32_t>(beginInfo.renderArea.offset.y));
+        _writeUint32(beginInfo.renderArea.extent.width);
+        _writeUint32(beginInfo.renderArea.extent.height);
+        _writeUint32(static_cast<uint32_t>(contents));
+        _writeUint32(beginInfo.clearValueCount);
+        _write(beginInfo.pClearValues, sizeof(vk::ClearValue) * beginInfo.clearValueCount);
+    }
+
+    void TraceCmdRecorder::nextSubpass(vk::SubpassContents contents)
+    {
+        _writeType(CmdRecordType::NEXT_SUBPASS);
+        _writeUint32(static_cast<uint32_t>(contents));
+    }
+
+    void TraceCmdRecorder::endRenderPass()
+    {
+        _writeType(CmdRecordType::END_RENDER_PASS);
+    }
+
+    void TraceCmdRecorder::pipelineBarrier(vk::PipelineStageFlags srcStageMask
+        , vk::PipelineStageFlags dstStageMask
+        , vk::DependencyFlags dependencyFlags
+        , uint32_t memoryBarrierCount
+        , const vk::MemoryBarrier *pMemoryBarriers
+        , uint32_t bufferMemoryBarrierCount
+        , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+        , uint32_t imageMemoryBarrierCount
+        , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+        )
+    {
+        _writeType(CmdRecordType::PIPELINE_BARRIER);
+        _writeUint32(static_cast<uint32_t>(srcStageMask));
+        _writeUint32(static_cast<uint32_t>(dstStageMask));
+        _writeUint32(static_cast<uint32_t>(dependencyFlags));
+        _writeUint32(memoryBarrierCount);
+        for (uint32_t i = 0; i < memoryBarrierCount; ++i)
+        {
+            const auto &barrier = pMemoryBarriers[i];
+            _writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+            _writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+        }
+        _writeUint32(bufferMemoryBarrierCount);
+        for (uint32_t i = 0; i < bufferMemoryBarrierCount; ++i)
+        {
+            const auto &barrier = pBufferMemoryBarriers[i];
+            _writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+            _writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+            _writeUint32(barrier.srcQueueFamilyIndex);
+            _writeUint32(barrier.dstQueueFamilyIndex);
+            _writeHandle(barrier.buffer);
+            _writeUint64(barrier.offset);
+            _writeUint64(barrier.size);
+        }
+        _writeUint32(imageMemoryBarrierCount);
+        for (uint32_t i = 0; i < imageMemoryBarrierCount; ++i)
+        {
+            const auto &barrier = pImageMemoryBarriers[i];
+            _writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+            _writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+            _writeUint32(static_cast<uint32_t>(barrier.oldLayout));
+            _writeUint32(static_cast<uint32_t>(barrier.newLayout));
+            _writeUint32(barrier.srcQueueFamilyIndex);
+            _writeUint32(barrier.dstQueueFamilyIndex);
+            _writeHandle(barrier.image);
+            _writeUint32(static_cast<uint32_t>(barrier.subresourceRange.aspectMask));
+            _writeUint32(barrier.subresourceRange.baseMipLevel);
+            _writeUint32(barrier.subresourceRange.levelCount);
+            _writeUint32(barrier.subresourceRange.baseArrayLayer);
+            _writeUint32(barrier.subresourceRange.layerCount);
+        }
+    }
+
+    void TraceCmdRecorder::setViewport(uint32_t firstViewport, const vk::Viewport &viewport)
+    {
+        _writeType(CmdRecordType::SET_VIEWPORT);
+        _writeUint32(firstViewport);
+        _writeFloat(viewport.x);
+        _writeFloat(viewport.y);
+        _writeFloat(viewport.width);
+        _writeFloat(viewport.height);
+        _writeFloat(viewport.minDepth);
+        _writeFloat(viewport.maxDepth);
+    }
+
+    void TraceCmdRecorder::setScissor(uint32_t firstScissor, const vk::Rect2D &scissor)
+    {
+        _writeType(CmdRecordType::SET_SCISSOR);
+        _writeUint32(firstScissor);
+        _writeUint32(static_cast<uint32_t>(scissor.offset.x));
+        _writeUint32(static_cast<uint32_t>(scissor.offset.y));
+        _writeUint32(scissor.extent.width);
+        _writeUint32(scissor.extent.height);
+    }
+
+    void TraceCmdRecorder::setDepthBias(float constantFactor, float clamp, float slopeFactor)
+    {
+        _writeType(CmdRecordType::SET_DEPTH_BIAS);
+        _writeFloat(constantFactor);
+        _writeFloat(clamp);
+        _writeFloat(slopeFactor);
+    }
+
+    void TraceCmdRecorder::setLineWidth(float lineWidth)
+    {
+        _writeType(CmdRecordType::SET_LINE_WIDTH);
+        _writeFloat(lineWidth);
+    }
+
+    void TraceCmdRecorder::pushConstants(vk::PipelineLayout layout
+        , vk::ShaderStageFlags stageFlags
+        , uint32_t offset
+        , uint32_t size
+        , const void *pValues
+        )
+    {
+        _writeType(CmdRecordType::PUSH_CONSTANTS);
+        _writeHandle(layout);
+        _writeUint32(static_cast<uint32_t>(stageFlags));
+        _writeUint32(offset);
+        _writeUint32(size);
+        _write(pValues, size);
+    }
+
+    void TraceCmdRecorder::bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline)
+    {
+        _writeType(CmdRecordType::BIND_PIPELINE);
+        _writeUint32(static_cast<uint32_t>(bindPoint));
+        _writeHandle(pipeline);
+    }
+
+    void TraceCmdRecorder::bindDescriptorSets(vk::PipelineBindPoint bindPoint
+        , vk::PipelineLayout layout
+        , uint32_t firstSet
+        , uint32_t descriptorSetCount
+        , const vk::DescriptorSet *pDescriptorSets
+        , uint32_t dynamicOffsetCount
+        , const uint32_t *pDynamicOffsets
+        )
+    {
+        _writeType(CmdRecordType::BIND_DESCRIPTOR_SETS);
+        _writeUint32(static_cast<uint32_t>(bindPoint));
+        _writeHandle(layout);
+        _writeUint32(firstSet);
+        _writeUint32(descriptorSetCount);
+        for (uint32_t i = 0; i < descriptorSetCount; ++i)
+        {
+            _writeHandle(pDescriptorSets[i]);
+        }
+        _writeUint32(dynamicOffsetCount);
+        _write(pDynamicOffsets, sizeof(uint32_t) * dynamicOffsetCount);
+    }
+
+    void TraceCmdRecorder::bindVertexBuffers(uint32_t firstBinding
+        , uint32_t bindingCount
+        , const vk::Buffer *pBuffers
+        , const vk::DeviceSize *pOffsets
+        )
+    {
+        _writeType(CmdRecordType::BIND_VERTEX_BUFFERS);
+        _writeUint32(firstBinding);
+        _writeUint32(bindingCount);
+        for (uint32_t i = 0; i < bindingCount; ++i)
+        {
+            _writeHandle(pBuffers[i]);
+            _writeUint64(pOffsets[i]);
+        }
+    }
+
+    void TraceCmdRecorder::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType)
+    {
+        _writeType(CmdRecordType::BIND_INDEX_BUFFER);
+        _writeHandle(buffer);
+        _writeUint64(offset);
+        _writeUint32(static_cast<uint32_t>(indexType));
+    }
+
+    void TraceCmdRecorder::draw(uint32_t vertexCount
+        , uint32_t instanceCount
+        , uint32_t firstVertex
+        , uint32_t firstInstance
+        )
+    {
+        _writeType(CmdRecordType::DRAW);
+        _writeUint32(vertexCount);
+        _writeUint32(instanceCount);
+        _writeUint32(firstVertex);
+        _writeUint32(firstInstance);
+    }
+
+    void TraceCmdRecorder::drawIndexed(uint32_t indexCount
+        , uint32_t instanceCount
+        , uint32_t firstIndex
+        , int32_t vertexOffset
+        , uint32_t firstInstance
+        )
+    {
+        _writeType(CmdRecordType::DRAW_INDEXED);
+        _writeUint32(indexCount);
+        _writeUint32(instanceCount);
+        _writeUint32(firstIndex);
+        _writeUint32(static_cast<uint32_t>(vertexOffset));
+        _writeUint32(firstInstance);
+    }
+
+    void TraceCmdRecorder::_writeHeader()
+    {
+        _writeUint32(TRACE_MAGIC);
+        _writeUint32(TRACE_VERSION);
+    }
+
+    void TraceCmdRecorder::_writeType(CmdRecordType type)
+    {
+        uint8_t value = static_cast<uint8_t>(type);
+        _write(&value, sizeof(value));
+        ++m_cmdCount;
+    }
+
+    void TraceCmdRecorder::_write(const void *pValue, size_t size)
+    {
+        if (size == 0u) return;
+        auto pBytes = reinterpret_cast<const uint8_t *>(pValue);
+        m_data.insert(m_data.end(), pBytes, pBytes + size);
+    }
+
+    void TraceCmdRecorder::_writeUint32(uint32_t value)
+    {
+        _write(&value, sizeof(value));
+    }
+
+    void TraceCmdRecorder::_writeUint64(uint64_t value)
+    {
+        _write(&value, sizeof(value));
+    }
+
+    void TraceCmdRecorder::_writeFloat(float value)
+    {
+        _write(&value, sizeof(value));
+    }
+
+} //vg
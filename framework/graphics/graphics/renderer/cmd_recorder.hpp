@@ -0,0 +1,329 @@
+#ifndef VG_CMD_RECORDER_HPP
+#define VG_CMD_RECORDER_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "graphics/global.hpp"
+
+namespace vg
+{
+    enum class CmdRecordType
+    {
+        BEGIN_RENDER_PASS,
+        NEXT_SUBPASS,
+        END_RENDER_PASS,
+        PIPELINE_BARRIER,
+        SET_VIEWPORT,
+        SET_SCISSOR,
+        SET_DEPTH_BIAS,
+        SET_LINE_WIDTH,
+        PUSH_CONSTANTS,
+        BIND_PIPELINE,
+        BIND_DESCRIPTOR_SETS,
+        BIND_VERTEX_BUFFERS,
+        BIND_INDEX_BUFFER,
+        DRAW,
+        DRAW_INDEXED,
+        BEGIN_RANGE = BEGIN_RENDER_PASS,
+        END_RANGE = DRAW_INDEXED,
+        RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+    };
+
+    /*Target of commands recorded by cmd parser, functions are same as the functions of vk::CommandBuffer
+      used by the parser.*/
+    class BaseCmdRecorder
+    {
+    public:
+        BaseCmdRecorder();
+        virtual ~BaseCmdRecorder();
+        //It is nullptr when commands are not recorded into a vulkan command buffer, gpu timer is skipped then.
+        virtual vk::CommandBuffer *getCommandBuffer() const;
+
+        virtual void beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents) = 0;
+        virtual void nextSubpass(vk::SubpassContents contents) = 0;
+        virtual void endRenderPass() = 0;
+        virtual void pipelineBarrier(vk::PipelineStageFlags srcStageMask
+            , vk::PipelineStageFlags dstStageMask
+            , vk::DependencyFlags dependencyFlags
+            , uint32_t memoryBarrierCount
+            , const vk::MemoryBarrier *pMemoryBarriers
+            , uint32_t bufferMemoryBarrierCount
+            , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+            , uint32_t imageMemoryBarrierCount
+            , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+            ) = 0;
+        virtual void setViewport(uint32_t firstViewport, const vk::Viewport &viewport) = 0;
+        virtual void setScissor(uint32_t firstScissor, const vk::Rect2D &scissor) = 0;
+        virtual void setDepthBias(float constantFactor, float clamp, float slopeFactor) = 0;
+        virtual void setLineWidth(float lineWidth) = 0;
+        virtual void pushConstants(vk::PipelineLayout layout
+            , vk::ShaderStageFlags stageFlags
+            , uint32_t offset
+            , uint32_t size
+            , const void *pValues
+            ) = 0;
+        virtual void bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline) = 0;
+        virtual void bindDescriptorSets(vk::PipelineBindPoint bindPoint
+            , vk::PipelineLayout layout
+            , uint32_t firstSet
+            , uint32_t descriptorSetCount
+            , const vk::DescriptorSet *pDescriptorSets
+            , uint32_t dynamicOffsetCount
+            , const uint32_t *pDynamicOffsets
+            ) = 0;
+        virtual void bindVertexBuffers(uint32_t firstBinding
+            , uint32_t bindingCount
+            , const vk::Buffer *pBuffers
+            , const vk::DeviceSize *pOffsets
+            ) = 0;
+        virtual void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) = 0;
+        virtual void draw(uint32_t vertexCount
+            , uint32_t instanceCount
+            , uint32_t firstVertex
+            , uint32_t firstInstance
+            ) = 0;
+        virtual void drawIndexed(uint32_t indexCount
+            , uint32_t instanceCount
+            , uint32_t firstIndex
+            , int32_t vertexOffset
+            , uint32_t firstInstance
+            ) = 0;
+    };
+
+    //It records commands into a vulkan command buffer, it is the recorder used by renderer.
+    class VulkanCmdRecorder : public BaseCmdRecorder
+    {
+    public:
+        VulkanCmdRecorder(vk::CommandBuffer *pCommandBuffer = nullptr);
+        virtual vk::CommandBuffer *getCommandBuffer() const override;
+        void setCommandBuffer(vk::CommandBuffer *pCommandBuffer);
+
+        virtual void beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents) override;
+        virtual void nextSubpass(vk::SubpassContents contents) override;
+        virtual void endRenderPass() override;
+        virtual void pipelineBarrier(vk::PipelineStageFlags srcStageMask
+            , vk::PipelineStageFlags dstStageMask
+            , vk::DependencyFlags dependencyFlags
+            , uint32_t memoryBarrierCount
+            , const vk::MemoryBarrier *pMemoryBarriers
+            , uint32_t bufferMemoryBarrierCount
+            , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+            , uint32_t imageMemoryBarrierCount
+            , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+            ) override;
+        virtual void setViewport(uint32_t firstViewport, const vk::Viewport &viewport) override;
+        virtual void setScissor(uint32_t firstScissor, const vk::Rect2D &scissor) override;
+        virtual void setDepthBias(float constantFactor, float clamp, float slopeFactor) override;
+        virtual void setLineWidth(float lineWidth) override;
+        virtual void pushConstants(vk::PipelineLayout layout
+            , vk::ShaderStageFlags stageFlags
+            , uint32_t offset
+            , uint32_t size
+            , const void *pValues
+            ) override;
+        virtual void bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline) override;
+        virtual void bindDescriptorSets(vk::PipelineBindPoint bindPoint
+            , vk::PipelineLayout layout
+            , uint32_t firstSet
+            , uint32_t descriptorSetCount
+            , const vk::DescriptorSet *pDescriptorSets
+            , uint32_t dynamicOffsetCount
+            , const uint32_t *pDynamicOffsets
+            ) override;
+        virtual void bindVertexBuffers(uint32_t firstBinding
+            , uint32_t bindingCount
+            , const vk::Buffer *pBuffers
+            , const vk::DeviceSize *pOffsets
+            ) override;
+        virtual void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) override;
+        virtual void draw(uint32_t vertexCount
+            , uint32_t instanceCount
+            , uint32_t firstVertex
+            , uint32_t firstInstance
+            ) override;
+        virtual void drawIndexed(uint32_t indexCount
+            , uint32_t instanceCount
+            , uint32_t firstIndex
+            , int32_t vertexOffset
+            , uint32_t firstInstance
+            ) override;
+    private:
+        vk::CommandBuffer *m_pCommandBuffer;
+    };
+
+    /*It only counts commands, so recording can be benchmarked without gpu. A command is counted as redundant
+      when it sets same state as the last one of its type in current render pass.*/
+    class NullCmdRecorder : public BaseCmdRecorder
+    {
+    public:
+        NullCmdRecorder();
+        uint32_t getCount(CmdRecordType type) const;
+        uint32_t getRedundantCount(CmdRecordType type) const;
+        uint32_t getTotalCount() const;
+        uint32_t getDrawCount() const;
+        //Sum of vertex count of draws and index count of indexed draws multiplied by instance count.
+        uint64_t getDrawVertexCount() const;
+        void reset();
+
+        virtual void beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents) override;
+        virtual void nextSubpass(vk::SubpassContents contents) override;
+        virtual void endRenderPass() override;
+        virtual void pipelineBarrier(vk::PipelineStageFlags srcStageMask
+            , vk::PipelineStageFlags dstStageMask
+            , vk::DependencyFlags dependencyFlags
+            , uint32_t memoryBarrierCount
+            , const vk::MemoryBarrier *pMemoryBarriers
+            , uint32_t bufferMemoryBarrierCount
+            , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+            , uint32_t imageMemoryBarrierCount
+            , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+            ) override;
+        virtual void setViewport(uint32_t firstViewport, const vk::Viewport &viewport) override;
+        virtual void setScissor(uint32_t firstScissor, const vk::Rect2D &scissor) override;
+        virtual void setDepthBias(float constantFactor, float clamp, float slopeFactor) override;
+        virtual void setLineWidth(float lineWidth) override;
+        virtual void pushConstants(vk::PipelineLayout layout
+            , vk::ShaderStageFlags stageFlags
+            , uint32_t offset
+            , uint32_t size
+            , const void *pValues
+            ) override;
+        virtual void bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline) override;
+        virtual void bindDescriptorSets(vk::PipelineBindPoint bindPoint
+            , vk::PipelineLayout layout
+            , uint32_t firstSet
+            , uint32_t descriptorSetCount
+            , const vk::DescriptorSet *pDescriptorSets
+            , uint32_t dynamicOffsetCount
+            , const uint32_t *pDynamicOffsets
+            ) override;
+        virtual void bindVertexBuffers(uint32_t firstBinding
+            , uint32_t bindingCount
+            , const vk::Buffer *pBuffers
+            , const vk::DeviceSize *pOffsets
+            ) override;
+        virtual void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) override;
+        virtual void draw(uint32_t vertexCount
+            , uint32_t instanceCount
+            , uint32_t firstVertex
+            , uint32_t firstInstance
+            ) override;
+        virtual void drawIndexed(uint32_t indexCount
+            , uint32_t instanceCount
+            , uint32_t firstIndex
+            , int32_t vertexOffset
+            , uint32_t firstInstance
+            ) override;
+    private:
+        std::array<uint32_t, static_cast<size_t>(CmdRecordType::RANGE_SIZE)> m_counts;
+        std::array<uint32_t, static_cast<size_t>(CmdRecordType::RANGE_SIZE)> m_redundantCounts;
+        uint64_t m_drawVertexCount;
+        //State set last in current render pass, it is invalid when the flag of it is false.
+        std::array<Bool32, static_cast<size_t>(CmdRecordType::RANGE_SIZE)> m_stateValids;
+        vk::Viewport m_viewport;
+        vk::Rect2D m_scissor;
+        std::array<float, 3> m_depthBias;
+        float m_lineWidth;
+        vk::Pipeline m_pipeline;
+        vk::PipelineLayout m_descriptorSetLayout;
+        std::vector<vk::DescriptorSet> m_descriptorSets;
+        std::vector<uint32_t> m_dynamicOffsets;
+        std::vector<vk::Buffer> m_vertexBuffers;
+        std::vector<vk::DeviceSize> m_vertexBufferOffsets;
+        vk::Buffer m_indexBuffer;
+        vk::DeviceSize m_indexBufferOffset;
+        vk::IndexType m_indexType;
+
+        void _count(CmdRecordType type, Bool32 isRedundant = VG_FALSE);
+    };
+
+    /*It serializes commands into a compact binary trace. Handles are replaced by ids in order of first using,
+      so traces of same frame are same between runs and versions and can be compared byte by byte.
+      Replaying feeds commands of a trace into another recorder, handles passed to it are made of the ids,
+      so it should be a recorder without gpu.*/
+    class TraceCmdRecorder : public BaseCmdRecorder
+    {
+    public:
+        static const uint32_t TRACE_MAGIC;
+        static const uint32_t TRACE_VERSION;
+
+        TraceCmdRecorder();
+        const std::vector<uint8_t> &getData() const;
+        uint32_t getCmdCount() const;
+        uint32_t getHandleCount() const;
+        //It clears commands and ids of handles.
+        void reset();
+        Bool32 save(const std::string &path) const;
+        static Bool32 load(const std::string &path, std::vector<uint8_t> &data);
+        //It returns false when the trace is invalid, commands before the invalid one are still replayed.
+        static Bool32 replay(const std::vector<uint8_t> &data, BaseCmdRecorder *pRecorder);
+
+        virtual void beginRenderPass(const vk::RenderPassBeginInfo &beginInfo, vk::SubpassContents contents) override;
+        virtual void nextSubpass(vk::SubpassContents contents) override;
+        virtual void endRenderPass() override;
+        virtual void pipelineBarrier(vk::PipelineStageFlags srcStageMask
+            , vk::PipelineStageFlags dstStageMask
+            , vk::DependencyFlags dependencyFlags
+            , uint32_t memoryBarrierCount
+            , const vk::MemoryBarrier *pMemoryBarriers
+            , uint32_t bufferMemoryBarrierCount
+            , const vk::BufferMemoryBarrier *pBufferMemoryBarriers
+            , uint32_t imageMemoryBarrierCount
+            , const vk::ImageMemoryBarrier *pImageMemoryBarriers
+            ) override;
+        virtual void setViewport(uint32_t firstViewport, const vk::Viewport &viewport) override;
+        virtual void setScissor(uint32_t firstScissor, const vk::Rect2D &scissor) override;
+        virtual void setDepthBias(float constantFactor, float clamp, float slopeFactor) override;
+        virtual void setLineWidth(float lineWidth) override;
+        virtual void pushConstants(vk::PipelineLayout layout
+            , vk::ShaderStageFlags stageFlags
+            , uint32_t offset
+            , uint32_t size
+            , const void *pValues
+            ) override;
+        virtual void bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline) override;
+        virtual void bindDescriptorSets(vk::PipelineBindPoint bindPoint
+            , vk::PipelineLayout layout
+            , uint32_t firstSet
+            , uint32_t descriptorSetCount
+            , const vk::DescriptorSet *pDescriptorSets
+            , uint32_t dynamicOffsetCount
+            , const uint32_t *pDynamicOffsets
+            ) override;
+        virtual void bindVertexBuffers(uint32_t firstBinding
+            , uint32_t bindingCount
+            , const vk::Buffer *pBuffers
+            , const vk::DeviceSize *pOffsets
+            ) override;
+        virtual void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) override;
+        virtual void draw(uint32_t vertexCount
+            , uint32_t instanceCount
+            , uint32_t firstVertex
+            , uint32_t firstInstance
+            ) override;
+        virtual void drawIndexed(uint32_t indexCount
+            , uint32_t instanceCount
+            , uint32_t firstIndex
+            , int32_t vertexOffset
+            , uint32_t firstInstance
+            ) override;
+    private:
+        std::vector<uint8_t> m_data;
+        uint32_t m_cmdCount;
+        //Id 0 is null handle.
+        std::unordered_map<uint64_t, uint32_t> m_handleIDs;
+
+        void _writeHeader();
+        void _writeType(CmdRecordType type);
+        void _write(const void *pValue, size_t size);
+        void _writeUint32(uint32_t value);
+        void _writeUint64(uint64_t value);
+        void _writeFloat(float value);
+        template <typename HandleType>
+        void _writeHandle(HandleType handle);
+    };
+} //vg
+
+#endif //VG_CMD_RECORDER_HPP
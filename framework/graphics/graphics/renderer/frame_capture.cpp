@@ -0,0 +1,654 @@
+#include "graphics/renderer/frame_capture.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+namespace vg
+{
+    //"VGFC" in little endian.
+    const uint32_t FrameCapture::CAPTURE_MAGIC = 0x43464756u;
+    const uint32_t FrameCapture::CAPTURE_VERSION = 2u;
+    const uint32_t FrameCapture::INVALID_RESOURCE_INDEX = std::numeric_limits<uint32_t>::max();
+
+    //Flags of parts of a cmd info in a saved capture.
+    static const uint8_t _CMD_FLAG_RENDER_PASS_BEGIN = 1u;
+    static const uint8_t _CMD_FLAG_RENDER_PASS = 2u;
+    static const uint8_t _CMD_FLAG_RENDER_PASS_END = 4u;
+    static const uint8_t _CMD_FLAG_BARRIER = 8u;
+    //Flags of optional parts of a render pass info in a saved capture.
+    static const uint8_t _RENDER_PASS_FLAG_MESH = 1u;
+    static const uint8_t _RENDER_PASS_FLAG_DRAW = 2u;
+    static const uint8_t _RENDER_PASS_FLAG_DRAW_INDEXED = 4u;
+    static const uint8_t _RENDER_PASS_FLAG_GEOMETRY_BINDING = 8u;
+    static const uint8_t _RENDER_PASS_FLAG_OMNI_DIRECTIONAL = 16u;
+
+    struct _CaptureWriter
+    {
+        std::vector<uint8_t> data;
+
+        void write(const void *pValue, size_t size)
+        {
+            if (size == 0u) return;
+            auto pBytes = reinterpret_cast<const uint8_t *>(pValue);
+            data.insert(data.end(), pBytes, pBytes + size);
+        }
+
+        void writeUint8(uint8_t value)
+        {
+            write(&value, sizeof(value));
+        }
+
+        void writeUint32(uint32_t value)
+        {
+            write(&value, sizeof(value));
+        }
+
+        void writeUint64(uint64_t value)
+        {
+            write(&value, sizeof(value));
+        }
+
+        void writeMatrix(const Matrix4x4 &matrix)
+        {
+            write(&matrix[0][0], sizeof(float) * 16u);
+        }
+
+        void writeRect(const fd::Rect2D &rect)
+        {
+            float values[4] = {rect.x, rect.y, rect.width, rect.height};
+            write(values, sizeof(values));
+        }
+
+        void writeViewport(const fd::Viewport &viewport)
+        {
+            float values[6] = {viewport.x, viewport.y, viewport.width, viewport.height,
+                viewport.minDepth, viewport.maxDepth};
+            write(values, sizeof(values));
+        }
+    };
+
+    //Reader of a saved capture, it becomes invalid when reading goes over the end of data.
+    struct _CaptureReader
+    {
+        const std::vector<uint8_t> &data;
+        size_t offset;
+        Bool32 isValid;
+
+        void read(void *pValue, size_t size)
+        {
+            if (isValid == VG_FALSE || offset + size > data.size())
+            {
+                isValid = VG_FALSE;
+                std::memset(pValue, 0, size);
+                return;
+            }
+            std::memcpy(pValue, data.data() + offset, size);
+            offset += size;
+        }
+
+        uint8_t readUint8()
+        {
+            uint8_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        uint32_t readUint32()
+        {
+            uint32_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        uint64_t readUint64()
+        {
+            uint64_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        //Count of items is invalid when the items are bigger than rest of data.
+        uint32_t readCount(size_t itemSize)
+        {
+            uint32_t count = readUint32();
+            if (isValid == VG_TRUE && static_cast<uint64_t>(count) * itemSize > data.size() - offset)
+            {
+                isValid = VG_FALSE;
+            }
+            return isValid == VG_TRUE ? count : 0u;
+        }
+
+        Matrix4x4 readMatrix()
+        {
+            Matrix4x4 matrix;
+            read(&matrix[0][0], sizeof(float) * 16u);
+            return matrix;
+        }
+
+        fd::Rect2D readRect()
+        {
+            float values[4];
+            read(values, sizeof(values));
+            return fd::Rect2D(values[0], values[1], values[2], values[3]);
+        }
+
+        fd::Viewport readViewport()
+        {
+            float values[6];
+            read(values, sizeof(values));
+            return fd::Viewport(values[0], values[1], values[2], values[3], values[4], values[5]);
+        }
+
+        //Item of the index, it becomes invalid when the index is out of items.
+        template <typename T>
+        T readResource(const std::vector<T> &items, Bool32 isNullable = VG_FALSE)
+        {
+            uint32_t index = readUint32();
+            if (isNullable == VG_TRUE && index == FrameCapture::INVALID_RESOURCE_INDEX) return T();
+            if (isValid == VG_FALSE || index >= items.size())
+            {
+                isValid = VG_FALSE;
+                return T();
+            }
+            return items[index];
+        }
+
+        template <typename T>
+        const T *readInstance(const std::unordered_map<InstanceID, const T *> &instances)
+        {
+            InstanceID id = readUint32();
+            auto iterator = instances.find(id);
+            if (isValid == VG_FALSE || iterator == instances.end())
+            {
+                isValid = VG_FALSE;
+                return nullptr;
+            }
+            return iterator->second;
+        }
+    };
+
+    template <typename T>
+    uint32_t FrameCapture::_findIndex(const std::vector<T> &items, const T &item)
+    {
+        auto iterator = std::find(items.begin(), items.end(), item);
+        if (iterator == items.end()) return INVALID_RESOURCE_INDEX;
+        return static_cast<uint32_t>(iterator - items.begin());
+    }
+
+    template <typename T>
+    void FrameCapture::_addResource(std::vector<T> &items, const T &item)
+    {
+        if (_findIndex(items, item) == INVALID_RESOURCE_INDEX) items.push_back(item);
+    }
+
+    FrameCapture::Resources::Resources()
+        : passes()
+        , meshes()
+        , renderPasses()
+        , framebuffers()
+        , buffers()
+        , barrierBuffers()
+        , barrierImages()
+    {
+
+    }
+
+    FrameCapture::FrameCapture()
+        : m_names()
+        , m_types()
+        , m_pCmdBuffers()
+        , m_resources()
+    {
+
+    }
+
+    void FrameCapture::clear()
+    {
+        m_names.clear();
+        m_types.clear();
+        m_pCmdBuffers.clear();
+        m_resources = Resources();
+    }
+
+    void FrameCapture::capture(const std::string &name
+        , const CmdBuffer *pCmdBuffer
+        , CmdBufferType type
+        )
+    {
+        std::shared_ptr<CmdBuffer> pCapturedCmdBuffer(new CmdBuffer());
+        pCapturedCmdBuffer->begin();
+        auto endIterator = pCmdBuffer->getEndCmd();
+        for (auto iterator = pCmdBuffer->getFirstCmd(); iterator != endIterator; ++iterator)
+        {
+            const auto &cmdInfo = *iterator;
+            _captureCmd(cmdInfo);
+            pCapturedCmdBuffer->addCmd(cmdInfo);
+        }
+        pCapturedCmdBuffer->end();
+        m_names.push_back(name);
+        m_types.push_back(type);
+        m_pCmdBuffers.push_back(pCapturedCmdBuffer);
+    }
+
+    uint32_t FrameCapture::getCmdBufferCount() const
+    {
+        return static_cast<uint32_t>(m_pCmdBuffers.size());
+    }
+
+    const std::string &FrameCapture::getCmdBufferName(uint32_t index) const
+    {
+        return m_names[index];
+    }
+
+    FrameCapture::CmdBufferType FrameCapture::getCmdBufferType(uint32_t index) const
+    {
+        return m_types[index];
+    }
+
+    const CmdBuffer *FrameCapture::getCmdBuffer(uint32_t index) const
+    {
+        return m_pCmdBuffers[index].get();
+    }
+
+    const FrameCapture::Resources &FrameCapture::getResources() const
+    {
+        return m_resources;
+    }
+
+    Bool32 FrameCapture::save(const std::string &path) const
+    {
+        _CaptureWriter writer;
+        writer.writeUint32(CAPTURE_MAGIC);
+        writer.writeUint32(CAPTURE_VERSION);
+        writer.writeUint32(static_cast<uint32_t>(m_pCmdBuffers.size()));
+        for (size_t cmdBufferIndex = 0; cmdBufferIndex < m_pCmdBuffers.size(); ++cmdBufferIndex)
+        {
+            const auto &name = m_names[cmdBufferIndex];
+            writer.writeUint32(static_cast<uint32_t>(name.size()));
+            writer.write(name.data(), name.size());
+            writer.writeUint8(static_cast<uint8_t>(m_types[cmdBufferIndex]));
+            const auto &pCmdBuffer = m_pCmdBuffers[cmdBufferIndex];
+            writer.writeUint32(pCmdBuffer->getCmdCount());
+            auto endIterator = pCmdBuffer->getEndCmd();
+            for (auto iterator = pCmdBuffer->getFirstCmd(); iterator != endIterator; ++iterator)
+            {
+                const auto &cmdInfo = *iterator;
+                uint8_t flags = 0u;
+                if (cmdInfo.pRenderPassBeginInfo != nullptr) flags |= _CMD_FLAG_RENDER_PASS_BEGIN;
+                if (cmdInfo.pRenderPassInfo != nullptr) flags |= _CMD_FLAG_RENDER_PASS;
+                if (cmdInfo.pRenderPassEndInfo != nullptr) flags |= _CMD_FLAG_RENDER_PASS_END;
+                if (cmdInfo.pBarrierInfo != nullptr) flags |= _CMD_FLAG_BARRIER;
+                writer.writeUint8(flags);
+
+                if (cmdInfo.pRenderPassBeginInfo != nullptr)
+                {
+                    const auto &beginInfo = *(cmdInfo.pRenderPassBeginInfo);
+                    writer.writeUint32(_findIndex(m_resources.renderPasses, beginInfo.pRenderPass));
+                    writer.writeUint32(_findIndex(m_resources.framebuffers, beginInfo.pFramebuffer));
+                    writer.writeUint32(beginInfo.framebufferWidth);
+                    writer.writeUint32(beginInfo.framebufferHeight);
+                    writer.writeRect(beginInfo.renderArea);
+                    writer.writeUint32(beginInfo.clearValueCount);
+                    writer.write(beginInfo.pClearValues, sizeof(vk::ClearValue) * beginInfo.clearValueCount);
+                }
+
+                if (cmdInfo.pRenderPassInfo != nullptr)
+                {
+                    const auto &renderPassInfo = *(cmdInfo.pRenderPassInfo);
+                    uint8_t renderPassFlags = 0u;
+                    if (renderPassInfo.pMesh != nullptr) renderPassFlags |= _RENDER_PASS_FLAG_MESH;
+                    if (renderPassInfo.pCmdDraw != nullptr) renderPassFlags |= _RENDER_PASS_FLAG_DRAW;
+                    if (renderPassInfo.pCmdDrawIndexed != nullptr) renderPassFlags |= _RENDER_PASS_FLAG_DRAW_INDEXED;
+                    if (renderPassInfo.pGeometryBinding != nullptr) renderPassFlags |= _RENDER_PASS_FLAG_GEOMETRY_BINDING;
+                    if (renderPassInfo.omniDirectional == VG_TRUE) renderPassFlags |= _RENDER_PASS_FLAG_OMNI_DIRECTIONAL;
+                    writer.writeUint8(renderPassFlags);
+                    //Render pass and framebuffer may be null, they are got from the render pass begin info then.
+                    writer.writeUint32(_findIndex(m_resources.renderPasses, renderPassInfo.pRenderPass));
+                    writer.writeUint32(renderPassInfo.subPassIndex);
+                    writer.writeUint32(_findIndex(m_resources.framebuffers, renderPassInfo.pFramebuffer));
+                    writer.writeUint32(renderPassInfo.framebufferWidth);
+                    writer.writeUint32(renderPassInfo.framebufferHeight);
+                    writer.writeMatrix(renderPassInfo.projMatrix);
+                    writer.writeMatrix(renderPassInfo.viewMatrix);
+                    writer.writeUint32(renderPassInfo.pPass->getID());
+                    writer.writeMatrix(renderPassInfo.modelMatrix);
+                    if (renderPassInfo.pMesh != nullptr) writer.writeUint32(renderPassInfo.pMesh->getID());
+                    writer.writeUint32(renderPassInfo.subMeshIndex);
+                    writer.writeViewport(renderPassInfo.viewport);
+                    writer.writeRect(renderPassInfo.scissor);
+                    writer.writeUint32(renderPassInfo.objectID);
+                    if (renderPassInfo.pCmdDraw != nullptr)
+                    {
+                        const auto &cmdDraw = *(renderPassInfo.pCmdDraw);
+                        writer.writeUint32(cmdDraw.vertexCount);
+                        writer.writeUint32(cmdDraw.instanceCount);
+                        writer.writeUint32(cmdDraw.firstVertex);
+                        writer.writeUint32(cmdDraw.firstInstance);
+                    }
+                    if (renderPassInfo.pCmdDrawIndexed != nullptr)
+                    {
+                        const auto &cmdDrawIndexed = *(renderPassInfo.pCmdDrawIndexed);
+                        writer.writeUint32(cmdDrawIndexed.indexCount);
+                        writer.writeUint32(cmdDrawIndexed.instanceCount);
+                        writer.writeUint32(cmdDrawIndexed.firstIndex);
+                        writer.writeUint32(cmdDrawIndexed.vertexOffset);
+                        writer.writeUint32(cmdDrawIndexed.firstInstance);
+                    }
+                    if (renderPassInfo.pGeometryBinding != nullptr)
+                    {
+                        const auto &geometryBinding = *(renderPassInfo.pGeometryBinding);
+                        writer.writeUint32(_findIndex(m_resources.buffers, geometryBinding.pVertexBuffer));
+                        writer.writeUint32(geometryBinding.vertexBufferOffset);
+                        writer.writeUint32(_findIndex(m_resources.buffers, geometryBinding.pIndexBuffer));
+                        writer.writeUint32(geometryBinding.indexBufferOffset);
+                    }
+                }
+
+                if (cmdInfo.pBarrierInfo != nullptr)
+                {
+                    const auto &barrierInfo = *(cmdInfo.pBarrierInfo);
+                    writer.writeUint32(static_cast<uint32_t>(barrierInfo.srcStageMask));
+                    writer.writeUint32(static_cast<uint32_t>(barrierInfo.dstStageMask));
+                    writer.writeUint32(static_cast<uint32_t>(barrierInfo.dependencyFlags));
+                    writer.writeUint32(barrierInfo.memoryBarrierCount);
+                    for (uint32_t j = 0; j < barrierInfo.memoryBarrierCount; ++j)
+                    {
+                        const auto &barrier = barrierInfo.pMemoryBarriers[j];
+                        writer.writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+                    }
+                    writer.writeUint32(barrierInfo.bufferMemoryBarrierCount);
+                    for (uint32_t j = 0; j < barrierInfo.bufferMemoryBarrierCount; ++j)
+                    {
+                        const auto &barrier = barrierInfo.pBufferMemoryBarriers[j];
+                        writer.writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+                        writer.writeUint32(barrier.srcQueueFamilyIndex);
+                        writer.writeUint32(barrier.dstQueueFamilyIndex);
+                        writer.writeUint32(_findIndex(m_resources.barrierBuffers, barrier.buffer));
+                        writer.writeUint64(barrier.offset);
+                        writer.writeUint64(barrier.size);
+                    }
+                    writer.writeUint32(barrierInfo.imageMemoryBarrierCount);
+                    for (uint32_t j = 0; j < barrierInfo.imageMemoryBarrierCount; ++j)
+                    {
+                        const auto &barrier = barrierInfo.pImageMemoryBarriers[j];
+                        writer.writeUint32(static_cast<uint32_t>(barrier.srcAccessMask));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.dstAccessMask));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.oldLayout));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.newLayout));
+                        writer.writeUint32(barrier.srcQueueFamilyIndex);
+                        writer.writeUint32(barrier.dstQueueFamilyIndex);
+                        writer.writeUint32(_findIndex(m_resources.barrierImages, barrier.image));
+                        writer.writeUint32(static_cast<uint32_t>(barrier.subresourceRange.aspectMask));
+                        writer.writeUint32(barrier.subresourceRange.baseMipLevel);
+                        writer.writeUint32(barrier.subresourceRange.levelCount);
+                        writer.writeUint32(barrier.subresourceRange.baseArrayLayer);
+                        writer.writeUint32(barrier.subresourceRange.layerCount);
+                    }
+                }
+            }
+        }
+
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (file.is_open() == false)
+        {
+            VG_LOG(plog::warning) << "Failed to open file to save frame capture: " << path << std::endl;
+            return VG_FALSE;
+        }
+        file.write(reinterpret_cast<const char *>(writer.data.data()), static_cast<std::streamsize>(writer.data.size()));
+        return VG_TRUE;
+    }
+
+    Bool32 FrameCapture::load(const std::string &path, const Resources &resources)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (file.is_open() == false)
+        {
+            VG_LOG(plog::warning) << "Failed to open file to load frame capture: " << path << std::endl;
+            return VG_FALSE;
+        }
+        std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        _CaptureReader reader = {data, 0u, VG_TRUE};
+        if (reader.readUint32() != CAPTURE_MAGIC || reader.readUint32() != CAPTURE_VERSION)
+        {
+            VG_LOG(plog::warning) << "Invalid header of frame capture: " << path << std::endl;
+            return VG_FALSE;
+        }
+
+        std::vector<std::string> names;
+        std::vector<CmdBufferType> types;
+        std::vector<std::shared_ptr<CmdBuffer>> pCmdBuffers;
+        std::vector<vk::ClearValue> clearValues;
+        std::vector<vk::MemoryBarrier> memoryBarriers;
+        std::vector<vk::BufferMemoryBarrier> bufferMemoryBarriers;
+        std::vector<vk::ImageMemoryBarrier> imageMemoryBarriers;
+        uint32_t cmdBufferCount = reader.readUint32();
+        for (uint32_t cmdBufferIndex = 0; cmdBufferIndex < cmdBufferCount && reader.isValid == VG_TRUE; ++cmdBufferIndex)
+        {
+            std::string name(reader.readCount(sizeof(char)), '\0');
+            reader.read(&name[0], name.size());
+            uint8_t type = reader.readUint8();
+            if (type > static_cast<uint8_t>(CmdBufferType::END_RANGE)) reader.isValid = VG_FALSE;
+            std::shared_ptr<CmdBuffer> pCmdBuffer(new CmdBuffer());
+            pCmdBuffer->begin();
+            uint32_t cmdCount = reader.readCount(sizeof(uint8_t));
+            for (uint32_t i = 0; i < cmdCount && reader.isValid == VG_TRUE; ++i)
+            {
+                uint8_t flags = reader.readUint8();
+                CmdInfo cmdInfo;
+                //Cmd buffer copies the infos when the cmd is added, so they are only valid in the iteration.
+                RenderPassBeginInfo beginInfo;
+                RenderPassInfo renderPassInfo;
+                CmdDraw cmdDraw;
+                CmdDrawIndexed cmdDrawIndexed;
+                CmdGeometryBinding geometryBinding;
+                RenderPassEndInfo endInfo;
+                BarrierInfo barrierInfo;
+
+                if ((flags & _CMD_FLAG_RENDER_PASS_BEGIN) != 0u)
+                {
+                    beginInfo.pRenderPass = reader.readResource(resources.renderPasses);
+                    beginInfo.pFramebuffer = reader.readResource(resources.framebuffers);
+                    beginInfo.framebufferWidth = reader.readUint32();
+                    beginInfo.framebufferHeight = reader.readUint32();
+                    beginInfo.renderArea = reader.readRect();
+                    clearValues.resize(reader.readCount(sizeof(vk::ClearValue)));
+                    for (auto &clearValue : clearValues)
+                    {
+                        reader.read(&clearValue, sizeof(clearValue));
+                    }
+                    beginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+                    beginInfo.pClearValues = clearValues.data();
+                    cmdInfo.pRenderPassBeginInfo = &beginInfo;
+                }
+
+                if ((flags & _CMD_FLAG_RENDER_PASS) != 0u)
+                {
+                    uint8_t renderPassFlags = reader.readUint8();
+                    renderPassInfo.pRenderPass = reader.readResource(resources.renderPasses, VG_TRUE);
+                    renderPassInfo.subPassIndex = reader.readUint32();
+                    renderPassInfo.pFramebuffer = reader.readResource(resources.framebuffers, VG_TRUE);
+                    renderPassInfo.framebufferWidth = reader.readUint32();
+                    renderPassInfo.framebufferHeight = reader.readUint32();
+                    renderPassInfo.projMatrix = reader.readMatrix();
+                    renderPassInfo.viewMatrix = reader.readMatrix();
+                    renderPassInfo.pPass = reader.readInstance(resources.passes);
+                    renderPassInfo.modelMatrix = reader.readMatrix();
+                    if ((renderPassFlags & _RENDER_PASS_FLAG_MESH) != 0u)
+                    {
+                        renderPassInfo.pMesh = reader.readInstance(resources.meshes);
+                    }
+                    renderPassInfo.subMeshIndex = reader.readUint32();
+                    renderPassInfo.viewport = reader.readViewport();
+                    renderPassInfo.scissor = reader.readRect();
+                    renderPassInfo.objectID = reader.readUint32();
+                    renderPassInfo.omniDirectional = (renderPassFlags & _RENDER_PASS_FLAG_OMNI_DIRECTIONAL) != 0u ? VG_TRUE : VG_FALSE;
+                    if ((renderPassFlags & _RENDER_PASS_FLAG_DRAW) != 0u)
+                    {
+                        cmdDraw.vertexCount = reader.readUint32();
+                        cmdDraw.instanceCount = reader.readUint32();
+                        cmdDraw.firstVertex = reader.readUint32();
+                        cmdDraw.firstInstance = reader.readUint32();
+                        renderPassInfo.pCmdDraw = &cmdDraw;
+                    }
+                    if ((renderPassFlags & _RENDER_PASS_FLAG_DRAW_INDEXED) != 0u)
+                    {
+                        cmdDrawIndexed.indexCount = reader.readUint32();
+                        cmdDrawIndexed.instanceCount = reader.readUint32();
+                        cmdDrawIndexed.firstIndex = reader.readUint32();
+                        cmdDrawIndexed.vertexOffset = reader.readUint32();
+                        cmdDrawIndexed.firstInstance = reader.readUint32();
+                        renderPassInfo.pCmdDrawIndexed = &cmdDrawIndexed;
+                    }
+                    if ((renderPassFlags & _RENDER_PASS_FLAG_GEOMETRY_BINDING) != 0u)
+                    {
+                        geometryBinding.pVertexBuffer = reader.readResource(resources.buffers, VG_TRUE);
+                        geometryBinding.vertexBufferOffset = reader.readUint32();
+                        geometryBinding.pIndexBuffer = reader.readResource(resources.buffers, VG_TRUE);
+                        geometryBinding.indexBufferOffset = reader.readUint32();
+                        renderPassInfo.pGeometryBinding = &geometryBinding;
+                    }
+                    cmdInfo.pRenderPassInfo = &renderPassInfo;
+                }
+
+                if ((flags & _CMD_FLAG_RENDER_PASS_END) != 0u)
+                {
+                    cmdInfo.pRenderPassEndInfo = &endInfo;
+                }
+
+                if ((flags & _CMD_FLAG_BARRIER) != 0u)
+                {
+                    barrierInfo.srcStageMask = vk::PipelineStageFlags(static_cast<vk::PipelineStageFlagBits>(reader.readUint32()));
+                    barrierInfo.dstStageMask = vk::PipelineStageFlags(static_cast<vk::PipelineStageFlagBits>(reader.readUint32()));
+                    barrierInfo.dependencyFlags = vk::DependencyFlags(static_cast<vk::DependencyFlagBits>(reader.readUint32()));
+                    memoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 2u));
+                    for (auto &barrier : memoryBarriers)
+                    {
+                        barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                        barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                    }
+                    bufferMemoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 5u + sizeof(uint64_t) * 2u));
+                    for (auto &barrier : bufferMemoryBarriers)
+                    {
+                        barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                        barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                        barrier.srcQueueFamilyIndex = reader.readUint32();
+                        barrier.dstQueueFamilyIndex = reader.readUint32();
+                        barrier.buffer = reader.readResource(resources.barrierBuffers);
+                        barrier.offset = reader.readUint64();
+                        barrier.size = reader.readUint64();
+                    }
+                    imageMemoryBarriers.resize(reader.readCount(sizeof(uint32_t) * 12u));
+                    for (auto &barrier : imageMemoryBarriers)
+                    {
+                        barrier.srcAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                        barrier.dstAccessMask = vk::AccessFlags(static_cast<vk::AccessFlagBits>(reader.readUint32()));
+                        barrier.oldLayout = static_cast<vk::ImageLayout>(reader.readUint32());
+                        barrier.newLayout = static_cast<vk::ImageLayout>(reader.readUint32());
+                        barrier.srcQueueFamilyIndex = reader.readUint32();
+                        barrier.dstQueueFamilyIndex = reader.readUint32();
+                        barrier.image = reader.readResource(resources.barrierImages);
+                        barrier.subresourceRange.aspectMask = vk::ImageAspectFlags(
+                            static_cast<vk::ImageAspectFlagBits>(reader.readUint32()));
+                        barrier.subresourceRange.baseMipLevel = reader.readUint32();
+                        barrier.subresourceRange.levelCount = reader.readUint32();
+                        barrier.subresourceRange.baseArrayLayer = reader.readUint32();
+                        barrier.subresourceRange.layerCount = reader.readUint32();
+                    }
+                    barrierInfo.memoryBarrierCount = static_cast<uint32_t>(memoryBarriers.size());
+                    barrierInfo.pMemoryBarriers = memoryBarriers.data();
+                    barrierInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferMemoryBarriers.size());
+                    barrierInfo.pBufferMemoryBarriers = bufferMemoryBarriers.data();
+                    barrierInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageMemoryBarriers.size());
+                    barrierInfo.pImageMemoryBarriers = imageMemoryBarriers.data();
+                    cmdInfo.pBarrierInfo = &barrierInfo;
+                }
+
+                if (reader.isValid == VG_TRUE) pCmdBuffer->addCmd(cmdInfo);
+            }
+            pCmdBuffer->end();
+            names.push_back(name);
+            types.push_back(static_cast<CmdBufferType>(type));
+            pCmdBuffers.push_back(pCmdBuffer);
+        }
+
+        if (reader.isValid == VG_FALSE)
+        {
+            VG_LOG(plog::warning) << "Invalid frame capture or missing resource of it at offset "
+                << reader.offset << " of file: " << path << std::endl;
+            return VG_FALSE;
+        }
+        m_names = names;
+        m_types = types;
+        m_pCmdBuffers = pCmdBuffers;
+        m_resources = resources;
+        return VG_TRUE;
+    }
+
+    void FrameCapture::replay(BaseCmdRecorder *pRecorder
+        , PipelineCache *pPipelineCache
+        , RendererPassCache *pRendererPassCache
+        , CMDParser::ResultInfo *pResult
+        ) const
+    {
+        uint32_t drawCount = 0u;
+        CMDParser::ResultInfo cmdParseResult;
+        for (size_t i = 0; i < m_pCmdBuffers.size(); ++i)
+        {
+            if (m_types[i] == CmdBufferType::TRUNK_WAIT_BARRIER)
+            {
+                CMDParser::recordTrunkWaitBarrier(m_pCmdBuffers[i].get(), pRecorder);
+                continue;
+            }
+            CMDParser::record(m_pCmdBuffers[i].get()
+                , pRecorder
+                , pPipelineCache
+                , pRendererPassCache
+                , &cmdParseResult
+                );
+            drawCount += cmdParseResult.drawCount;
+        }
+        if (pResult != nullptr) pResult->drawCount = drawCount;
+    }
+
+    void FrameCapture::_captureCmd(const CmdInfo &cmdInfo)
+    {
+        if (cmdInfo.pRenderPassBeginInfo != nullptr)
+        {
+            _addResource(m_resources.renderPasses, cmdInfo.pRenderPassBeginInfo->pRenderPass);
+            _addResource(m_resources.framebuffers, cmdInfo.pRenderPassBeginInfo->pFramebuffer);
+        }
+        if (cmdInfo.pRenderPassInfo != nullptr)
+        {
+            const auto &renderPassInfo = *(cmdInfo.pRenderPassInfo);
+            if (renderPassInfo.pRenderPass != nullptr) _addResource(m_resources.renderPasses, renderPassInfo.pRenderPass);
+            if (renderPassInfo.pFramebuffer != nullptr) _addResource(m_resources.framebuffers, renderPassInfo.pFramebuffer);
+            m_resources.passes[renderPassInfo.pPass->getID()] = renderPassInfo.pPass;
+            if (renderPassInfo.pMesh != nullptr) m_resources.meshes[renderPassInfo.pMesh->getID()] = renderPassInfo.pMesh;
+            if (renderPassInfo.pGeometryBinding != nullptr)
+            {
+                const auto &geometryBinding = *(renderPassInfo.pGeometryBinding);
+                if (geometryBinding.pVertexBuffer != nullptr) _addResource(m_resources.buffers, geometryBinding.pVertexBuffer);
+                if (geometryBinding.pIndexBuffer != nullptr) _addResource(m_resources.buffers, geometryBinding.pIndexBuffer);
+            }
+        }
+        if (cmdInfo.pBarrierInfo != nullptr)
+        {
+            const auto &barrierInfo = *(cmdInfo.pBarrierInfo);
+            for (uint32_t i = 0; i < barrierInfo.bufferMemoryBarrierCount; ++i)
+            {
+                _addResource(m_resources.barrierBuffers, barrierInfo.pBufferMemoryBarriers[i].buffer);
+            }
+            for (uint32_t i = 0; i < barrierInfo.imageMemoryBarrierCount; ++i)
+            {
+                _addResource(m_resources.barrierImages, barrierInfo.pImageMemoryBarriers[i].image);
+            }
+        }
+    }
+} //vg
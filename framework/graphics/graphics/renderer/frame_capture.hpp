@@ -0,0 +1,92 @@
+#ifndef VG_FRAME_CAPTURE_HPP
+#define VG_FRAME_CAPTURE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include "graphics/global.hpp"
+#include "graphics/material/cmd.hpp"
+#include "graphics/renderer/cmd_parser.hpp"
+
+namespace vg
+{
+    /*Copies of cmd buffers of a frame, they can be recorded again and again by cmd parser without updating and
+      binding scene. Passes and meshes are saved as their instance ids, vulkan objects are saved as indices
+      of them in resources of the capture, so a saved capture is loaded with resources of a same scene.
+      Resources only come from a live capture, so the replaying process should build the same scene again,
+      capture one frame of it and load the file with getResources() of that capture.*/
+    class FrameCapture
+    {
+    public:
+        static const uint32_t CAPTURE_MAGIC;
+        static const uint32_t CAPTURE_VERSION;
+        static const uint32_t INVALID_RESOURCE_INDEX;
+
+        //How a captured cmd buffer is recorded, it is same as the renderer recording the original one.
+        enum class CmdBufferType
+        {
+            //Recorded by CMDParser::record.
+            RENDER,
+            //Recorded by CMDParser::recordTrunkWaitBarrier, barriers of it are merged.
+            TRUNK_WAIT_BARRIER,
+            BEGIN_RANGE = RENDER,
+            END_RANGE = TRUNK_WAIT_BARRIER,
+            RANGE_SIZE = (END_RANGE - BEGIN_RANGE + 1)
+        };
+
+        //Objects referenced by captured cmds, vulkan objects are in order of first using.
+        struct Resources
+        {
+            std::unordered_map<InstanceID, const Pass *> passes;
+            std::unordered_map<InstanceID, const BaseMesh *> meshes;
+            std::vector<const vk::RenderPass *> renderPasses;
+            std::vector<const vk::Framebuffer *> framebuffers;
+            //Buffers of geometry bindings.
+            std::vector<const vk::Buffer *> buffers;
+            std::vector<vk::Buffer> barrierBuffers;
+            std::vector<vk::Image> barrierImages;
+
+            Resources();
+        };
+
+        FrameCapture();
+        void clear();
+        //The cmd buffer is copied, pointers of resources in it should be valid until the capture is replayed.
+        void capture(const std::string &name
+            , const CmdBuffer *pCmdBuffer
+            , CmdBufferType type = CmdBufferType::RENDER
+            );
+        uint32_t getCmdBufferCount() const;
+        const std::string &getCmdBufferName(uint32_t index) const;
+        CmdBufferType getCmdBufferType(uint32_t index) const;
+        const CmdBuffer *getCmdBuffer(uint32_t index) const;
+        const Resources &getResources() const;
+
+        Bool32 save(const std::string &path) const;
+        /*It returns false when the file is invalid or a resource isn't found in the resources. The resources
+          should be got from a capture of the same scene in this process, see the class description.*/
+        Bool32 load(const std::string &path, const Resources &resources);
+
+        /*All cmd buffers are recorded in order of capturing by the way of their types, draw count of them
+          is added up into the result.*/
+        void replay(BaseCmdRecorder *pRecorder
+            , PipelineCache *pPipelineCache
+            , RendererPassCache *pRendererPassCache
+            , CMDParser::ResultInfo *pResult = nullptr
+            ) const;
+    private:
+        std::vector<std::string> m_names;
+        std::vector<CmdBufferType> m_types;
+        std::vector<std::shared_ptr<CmdBuffer>> m_pCmdBuffers;
+        Resources m_resources;
+
+        template <typename T>
+        static uint32_t _findIndex(const std::vector<T> &items, const T &item);
+        template <typename T>
+        static void _addResource(std::vector<T> &items, const T &item);
+        void _captureCmd(const CmdInfo &cmdInfo);
+    };
+} //vg
+
+#endif //VG_FRAME_CAPTURE_HPP
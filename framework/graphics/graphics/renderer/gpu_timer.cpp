@@ -0,0 +1,323 @@
+#include "graphics/renderer/gpu_timer.hpp"
+
+#include <limits>
+#include <algorithm>
+#include "graphics/app/app.hpp"
+
+namespace vg
+{
+    const uint32_t GPUTimer::DEFAULT_MAX_SECTION_COUNT = 64u;
+    const uint32_t GPUTimer::DEFAULT_FRAME_COUNT = 3u;
+    const uint32_t GPUTimer::INVALID_SECTION_INDEX = std::numeric_limits<uint32_t>::max();
+
+    //Count of statistics of every statistics query, it matches members of PipelineStatistics.
+    const uint32_t STATISTICS_VALUE_COUNT = 5u;
+
+    GPUTimer::PipelineStatistics::PipelineStatistics(uint64_t inputAssemblyVertices
+        , uint64_t inputAssemblyPrimitives
+        , uint64_t vertexShaderInvocations
+        , uint64_t clippingPrimitives
+        , uint64_t fragmentShaderInvocations
+        )
+        : inputAssemblyVertices(inputAssemblyVertices)
+        , inputAssemblyPrimitives(inputAssemblyPrimitives)
+        , vertexShaderInvocations(vertexShaderInvocations)
+        , clippingPrimitives(clippingPrimitives)
+        , fragmentShaderInvocations(fragmentShaderInvocations)
+    {
+
+    }
+
+    GPUTimer::SectionResult::SectionResult(std::string name
+        , float time
+        , uint32_t count
+        , Bool32 hasStatistics
+        , PipelineStatistics statistics
+        )
+        : name(name)
+        , time(time)
+        , count(count)
+        , hasStatistics(hasStatistics)
+        , statistics(statistics)
+    {
+
+    }
+
+    GPUTimer::GPUTimer(uint32_t maxSectionCount
+        , uint32_t frameCount
+        )
+        : m_maxSectionCount(maxSectionCount)
+        , m_frameCount(frameCount)
+        , m_isSupported(VG_FALSE)
+        , m_isPipelineStatisticsSupported(VG_FALSE)
+        , m_pipelineStatisticsEnable(VG_FALSE)
+        , m_renderPassTimingEnable(VG_FALSE)
+        , m_timestampPeriod(1.0f)
+        , m_timestampMask(0u)
+        , m_pTimestampPool()
+        , m_pStatisticsPool()
+        , m_frames(frameCount)
+        , m_frameIndex(frameCount - 1u)
+        , m_isStatisticsActive(VG_FALSE)
+        , m_timestamps()
+        , m_statistics()
+        , m_results()
+    {
+#ifdef DEBUG
+        if (maxSectionCount == 0u || frameCount == 0u)
+            throw std::invalid_argument("Max section count and frame count of gpu timer should not be 0.");
+#endif //DEBUG
+        for (auto &frame : m_frames)
+        {
+            frame.isRecorded = VG_FALSE;
+        }
+        _createQueryPools();
+    }
+
+    uint32_t GPUTimer::getMaxSectionCount() const
+    {
+        return m_maxSectionCount;
+    }
+
+    uint32_t GPUTimer::getFrameCount() const
+    {
+        return m_frameCount;
+    }
+
+    Bool32 GPUTimer::isSupported() const
+    {
+        return m_isSupported;
+    }
+
+    Bool32 GPUTimer::isPipelineStatisticsSupported() const
+    {
+        return m_isPipelineStatisticsSupported;
+    }
+
+    Bool32 GPUTimer::getPipelineStatisticsEnable() const
+    {
+        return m_pipelineStatisticsEnable;
+    }
+
+    void GPUTimer::setPipelineStatisticsEnable(Bool32 value)
+    {
+        m_pipelineStatisticsEnable = value;
+    }
+
+    Bool32 GPUTimer::getRenderPassTimingEnable() const
+    {
+        return m_renderPassTimingEnable;
+    }
+
+    void GPUTimer::setRenderPassTimingEnable(Bool32 value)
+    {
+        m_renderPassTimingEnable = value;
+    }
+
+    void GPUTimer::beginFrame(vk::CommandBuffer *pCommandBuffer)
+    {
+        if (m_isSupported == VG_FALSE) return;
+        m_frameIndex = (m_frameIndex + 1u) % m_frameCount;
+        auto &frame = m_frames[m_frameIndex];
+        if (frame.isRecorded == VG_TRUE && _readResults(frame, m_frameIndex) == VG_FALSE)
+        {
+            VG_LOG(plog::debug) << "Gpu timer results of frame are not available, last results are kept." << std::endl;
+        }
+        frame.sections.clear();
+        frame.isRecorded = VG_FALSE;
+        m_isStatisticsActive = VG_FALSE;
+
+        pCommandBuffer->resetQueryPool(*m_pTimestampPool, m_frameIndex * m_maxSectionCount * 2u, m_maxSectionCount * 2u);
+        if (m_pStatisticsPool != nullptr)
+        {
+            pCommandBuffer->resetQueryPool(*m_pStatisticsPool, m_frameIndex * m_maxSectionCount, m_maxSectionCount);
+        }
+    }
+
+    void GPUTimer::endFrame()
+    {
+        if (m_isSupported == VG_FALSE) return;
+        auto &frame = m_frames[m_frameIndex];
+#ifdef DEBUG
+        for (const auto &section : frame.sections)
+        {
+            if (section.isEnded == VG_FALSE)
+                throw std::runtime_error("Section " + section.name + " of gpu timer isn't ended in the frame.");
+        }
+#endif //DEBUG
+        frame.isRecorded = frame.sections.size() != 0u ? VG_TRUE : VG_FALSE;
+    }
+
+    uint32_t GPUTimer::beginSection(vk::CommandBuffer *pCommandBuffer
+        , const std::string &name
+        , Bool32 withStatistics
+        )
+    {
+        if (m_isSupported == VG_FALSE) return INVALID_SECTION_INDEX;
+        auto &frame = m_frames[m_frameIndex];
+        uint32_t sectionIndex = static_cast<uint32_t>(frame.sections.size());
+        if (sectionIndex >= m_maxSectionCount) return INVALID_SECTION_INDEX;
+        //Queries of the same type can't be active at the same time in a command buffer.
+        Bool32 hasStatistics = withStatistics == VG_TRUE &&
+            m_pipelineStatisticsEnable == VG_TRUE &&
+            m_pStatisticsPool != nullptr &&
+            m_isStatisticsActive == VG_FALSE;
+        _Section section = {
+            name,
+            hasStatistics,
+            VG_FALSE,
+        };
+        frame.sections.push_back(section);
+
+        uint32_t queryIndex = m_frameIndex * m_maxSectionCount + sectionIndex;
+        pCommandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *m_pTimestampPool, queryIndex * 2u);
+        if (hasStatistics == VG_TRUE)
+        {
+            pCommandBuffer->beginQuery(*m_pStatisticsPool, queryIndex, vk::QueryControlFlags());
+            m_isStatisticsActive = VG_TRUE;
+        }
+        return sectionIndex;
+    }
+
+    void GPUTimer::endSection(vk::CommandBuffer *pCommandBuffer, uint32_t sectionIndex)
+    {
+        if (m_isSupported == VG_FALSE || sectionIndex == INVALID_SECTION_INDEX) return;
+        auto &section = m_frames[m_frameIndex].sections[sectionIndex];
+#ifdef DEBUG
+        if (section.isEnded == VG_TRUE)
+            throw std::invalid_argument("The section of gpu timer has been ended.");
+#endif //DEBUG
+        uint32_t queryIndex = m_frameIndex * m_maxSectionCount + sectionIndex;
+        if (section.hasStatistics == VG_TRUE)
+        {
+            pCommandBuffer->endQuery(*m_pStatisticsPool, queryIndex);
+            m_isStatisticsActive = VG_FALSE;
+        }
+        pCommandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *m_pTimestampPool, queryIndex * 2u + 1u);
+        section.isEnded = VG_TRUE;
+    }
+
+    const std::vector<GPUTimer::SectionResult> &GPUTimer::getResults() const
+    {
+        return m_results;
+    }
+
+    void GPUTimer::_createQueryPools()
+    {
+        auto pPhysicalDevice = pApp->getPhysicalDevice();
+        auto queueFamilyProperties = pPhysicalDevice->getQueueFamilyProperties();
+        uint32_t timestampValidBits = queueFamilyProperties[pApp->getGraphicsFamily()].timestampValidBits;
+        if (timestampValidBits == 0u)
+        {
+            VG_LOG(plog::warning) << "Graphics queue doesn't support timestamps, gpu timer is disabled." << std::endl;
+            return;
+        }
+        m_isSupported = VG_TRUE;
+        m_timestampPeriod = pPhysicalDevice->getProperties().limits.timestampPeriod;
+        m_timestampMask = timestampValidBits >= 64u ? std::numeric_limits<uint64_t>::max() :
+            (static_cast<uint64_t>(1u) << timestampValidBits) - 1u;
+
+        auto pDevice = pApp->getDevice();
+        vk::QueryPoolCreateInfo createInfo = {
+            vk::QueryPoolCreateFlags(),
+            vk::QueryType::eTimestamp,
+            m_frameCount * m_maxSectionCount * 2u,
+            vk::QueryPipelineStatisticFlags()
+        };
+        m_pTimestampPool = fd::createQueryPool(pDevice, createInfo);
+        m_timestamps.resize(m_maxSectionCount * 2u);
+
+        m_isPipelineStatisticsSupported = pApp->getPhysicalDeviceFeatures().pipelineStatisticsQuery;
+        if (m_isPipelineStatisticsSupported == VG_TRUE)
+        {
+            vk::QueryPoolCreateInfo statisticsCreateInfo = {
+                vk::QueryPoolCreateFlags(),
+                vk::QueryType::ePipelineStatistics,
+                m_frameCount * m_maxSectionCount,
+                vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+                    vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+                    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+                    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+                    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations
+            };
+            m_pStatisticsPool = fd::createQueryPool(pDevice, statisticsCreateInfo);
+            m_statistics.resize(m_maxSectionCount * STATISTICS_VALUE_COUNT);
+        }
+    }
+
+    Bool32 GPUTimer::_readResults(const _Frame &frame, uint32_t frameIndex)
+    {
+        auto pDevice = pApp->getDevice();
+        uint32_t sectionCount = static_cast<uint32_t>(frame.sections.size());
+        uint32_t firstQuery = frameIndex * m_maxSectionCount;
+        //Without wait flag, it returns not ready instead of waiting when any query isn't available.
+        auto result = pDevice->getQueryPoolResults<uint64_t>(*m_pTimestampPool
+            , firstQuery * 2u
+            , sectionCount * 2u
+            , vk::ArrayProxy<uint64_t>(sectionCount * 2u, m_timestamps.data())
+            , static_cast<vk::DeviceSize>(sizeof(uint64_t))
+            , vk::QueryResultFlagBits::e64
+            );
+        if (result != vk::Result::eSuccess) return VG_FALSE;
+
+        Bool32 hasStatistics = VG_FALSE;
+        for (const auto &section : frame.sections)
+        {
+            if (section.hasStatistics == VG_TRUE) hasStatistics = VG_TRUE;
+        }
+        if (hasStatistics == VG_TRUE)
+        {
+            //Queries of sections without statistics are never available, so every query is read alone.
+            for (uint32_t i = 0u; i < sectionCount; ++i)
+            {
+                if (frame.sections[i].hasStatistics == VG_FALSE) continue;
+                result = pDevice->getQueryPoolResults<uint64_t>(*m_pStatisticsPool
+                    , firstQuery + i
+                    , 1u
+                    , vk::ArrayProxy<uint64_t>(STATISTICS_VALUE_COUNT, m_statistics.data() + i * STATISTICS_VALUE_COUNT)
+                    , static_cast<vk::DeviceSize>(sizeof(uint64_t) * STATISTICS_VALUE_COUNT)
+                    , vk::QueryResultFlagBits::e64
+                    );
+                if (result != vk::Result::eSuccess) return VG_FALSE;
+            }
+        }
+
+        m_results.clear();
+        for (uint32_t i = 0u; i < sectionCount; ++i)
+        {
+            const auto &section = frame.sections[i];
+            uint64_t ticks = (m_timestamps[i * 2u + 1u] - m_timestamps[i * 2u]) & m_timestampMask;
+            float time = static_cast<float>(static_cast<double>(ticks) * static_cast<double>(m_timestampPeriod) / 1000000.0);
+            PipelineStatistics statistics;
+            if (section.hasStatistics == VG_TRUE)
+            {
+                const uint64_t *pValues = m_statistics.data() + i * STATISTICS_VALUE_COUNT;
+                statistics = PipelineStatistics(pValues[0], pValues[1], pValues[2], pValues[3], pValues[4]);
+            }
+
+            auto iterator = std::find_if(m_results.begin(), m_results.end(), [&section](const SectionResult &item)
+            {
+                return item.name == section.name;
+            });
+            if (iterator == m_results.end())
+            {
+                m_results.push_back(SectionResult(section.name, time, 1u, section.hasStatistics, statistics));
+            }
+            else
+            {
+                iterator->time += time;
+                ++iterator->count;
+                if (section.hasStatistics == VG_TRUE)
+                {
+                    iterator->hasStatistics = VG_TRUE;
+                    iterator->statistics.inputAssemblyVertices += statistics.inputAssemblyVertices;
+                    iterator->statistics.inputAssemblyPrimitives += statistics.inputAssemblyPrimitives;
+                    iterator->statistics.vertexShaderInvocations += statistics.vertexShaderInvocations;
+                    iterator->statistics.clippingPrimitives += statistics.clippingPrimitives;
+                    iterator->statistics.fragmentShaderInvocations += statistics.fragmentShaderInvocations;
+                }
+            }
+        }
+        return VG_TRUE;
+    }
+} //vg
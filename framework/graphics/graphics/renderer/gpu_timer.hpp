@@ -0,0 +1,119 @@
+#ifndef VG_GPU_TIMER_HPP
+#define VG_GPU_TIMER_HPP
+
+#include "graphics/global.hpp"
+
+namespace vg
+{
+    /*Timestamp queries written around sections of a command buffer. Every frame uses its own range of the
+      query pools, a range is read without waiting when it is used again, so results are late by frame count
+      frames and the GPU is never stalled by reading them. Frame count should be bigger than count of frames
+      in flight, results are kept unchanged when queries of the frame are still not available.*/
+    class GPUTimer
+    {
+    public:
+        static const uint32_t DEFAULT_MAX_SECTION_COUNT;
+        static const uint32_t DEFAULT_FRAME_COUNT;
+        static const uint32_t INVALID_SECTION_INDEX;
+
+        struct PipelineStatistics
+        {
+            uint64_t inputAssemblyVertices;
+            uint64_t inputAssemblyPrimitives;
+            uint64_t vertexShaderInvocations;
+            uint64_t clippingPrimitives;
+            uint64_t fragmentShaderInvocations;
+
+            PipelineStatistics(uint64_t inputAssemblyVertices = 0u
+                , uint64_t inputAssemblyPrimitives = 0u
+                , uint64_t vertexShaderInvocations = 0u
+                , uint64_t clippingPrimitives = 0u
+                , uint64_t fragmentShaderInvocations = 0u
+                );
+        };
+
+        //Sections with same name in a frame are added up.
+        struct SectionResult
+        {
+            std::string name;
+            //Milliseconds.
+            float time;
+            uint32_t count;
+            Bool32 hasStatistics;
+            PipelineStatistics statistics;
+
+            SectionResult(std::string name = ""
+                , float time = 0.0f
+                , uint32_t count = 0u
+                , Bool32 hasStatistics = VG_FALSE
+                , PipelineStatistics statistics = PipelineStatistics()
+                );
+        };
+
+        GPUTimer(uint32_t maxSectionCount = DEFAULT_MAX_SECTION_COUNT
+            , uint32_t frameCount = DEFAULT_FRAME_COUNT
+            );
+        uint32_t getMaxSectionCount() const;
+        uint32_t getFrameCount() const;
+        //It is false when the graphics queue doesn't support timestamps, sections are ignored then.
+        Bool32 isSupported() const;
+        //It needs pipelineStatisticsQuery feature of the device.
+        Bool32 isPipelineStatisticsSupported() const;
+        Bool32 getPipelineStatisticsEnable() const;
+        void setPipelineStatisticsEnable(Bool32 value);
+        //Every render pass in a section is timed as a section named by the section and index of the pass.
+        Bool32 getRenderPassTimingEnable() const;
+        void setRenderPassTimingEnable(Bool32 value);
+
+        /*It should be called after the command buffer begins and outside of render passes, it reads results
+          of the frame which used the same range before and resets the range.*/
+        void beginFrame(vk::CommandBuffer *pCommandBuffer);
+        //All sections begun in the frame should be ended before it.
+        void endFrame();
+        /*Statistics are only queried when they are enabled and no other section with statistics is active.
+          It returns INVALID_SECTION_INDEX when sections of the frame are used up.*/
+        uint32_t beginSection(vk::CommandBuffer *pCommandBuffer
+            , const std::string &name
+            , Bool32 withStatistics = VG_FALSE
+            );
+        void endSection(vk::CommandBuffer *pCommandBuffer, uint32_t sectionIndex);
+        //Results of the latest frame whose queries are available, sections are in order of beginning.
+        const std::vector<SectionResult> &getResults() const;
+    private:
+        struct _Section
+        {
+            std::string name;
+            Bool32 hasStatistics;
+            Bool32 isEnded;
+        };
+
+        struct _Frame
+        {
+            std::vector<_Section> sections;
+            Bool32 isRecorded;
+        };
+
+        uint32_t m_maxSectionCount;
+        uint32_t m_frameCount;
+        Bool32 m_isSupported;
+        Bool32 m_isPipelineStatisticsSupported;
+        Bool32 m_pipelineStatisticsEnable;
+        Bool32 m_renderPassTimingEnable;
+        //Nanoseconds per timestamp tick.
+        float m_timestampPeriod;
+        uint64_t m_timestampMask;
+        std::shared_ptr<vk::QueryPool> m_pTimestampPool;
+        std::shared_ptr<vk::QueryPool> m_pStatisticsPool;
+        std::vector<_Frame> m_frames;
+        uint32_t m_frameIndex;
+        Bool32 m_isStatisticsActive;
+        std::vector<uint64_t> m_timestamps;
+        std::vector<uint64_t> m_statistics;
+        std::vector<SectionResult> m_results;
+
+        void _createQueryPools();
+        Bool32 _readResults(const _Frame &frame, uint32_t frameIndex);
+    };
+} //vg
+
+#endif //VG_GPU_TIMER_HPP
@@ -64,7 +64,6 @@ namespace vg
 
     RendererObjectDataCache::RendererObjectDataCache()
         : m_mapDatas()
-        , m_mapDatasBack()
     {
 
     }
@@ -76,32 +75,35 @@ namespace vg
 
     void RendererObjectDataCache::begin()
     {
-        m_mapDatasBack = m_mapDatas;
-        m_mapDatas.clear();
+        for (auto &pair : m_mapDatas)
+        {
+            pair.second.isUsed = VG_FALSE;
+        }
     }
 
     RendererObjectData *RendererObjectDataCache::get(InstanceID objectID)
     {
-        RendererObjectData * pCurr;
         auto key = objectID;
-        if (m_mapDatas[key] != nullptr) {
-            pCurr = m_mapDatas[key].get();
-        } else if (m_mapDatasBack[key] != nullptr) {
-            m_mapDatas[key] = m_mapDatasBack[key];
-            m_mapDatasBack.erase(key);
-            pCurr = m_mapDatas[key].get();
+        auto iterator = m_mapDatas.find(key);
+        if (iterator != m_mapDatas.end()) {
+            iterator->second.isUsed = VG_TRUE;
+            return iterator->second.pData.get();
         } else {
             auto pNew = std::shared_ptr<RendererObjectData>{new RendererObjectData()};
-            m_mapDatas[key] = pNew;
-            pCurr = pNew.get();
+            _Item item = {pNew, VG_TRUE};
+            m_mapDatas[key] = item;
+            return pNew.get();
         }
-        return pCurr;
     }
 
     void RendererObjectDataCache::end()
     {
-        //Delete useless renderer passes.
-        m_mapDatasBack.clear();
+        //Delete data of objects which aren't rendered.
+        for (auto iterator = m_mapDatas.begin(); iterator != m_mapDatas.end();)
+        {
+            if (iterator->second.isUsed == VG_FALSE) iterator = m_mapDatas.erase(iterator);
+            else ++iterator;
+        }
     }
 
 }
\ No newline at end of file
@@ -31,8 +31,12 @@ namespace vg
         void end();
 
     private:
-        //Map between pass and renderer pass, key is instance ID of pass.
-        std::unordered_map<InstanceID, std::shared_ptr<RendererObjectData>> m_mapDatas;
-        std::unordered_map<InstanceID, std::shared_ptr<RendererObjectData>> m_mapDatasBack;
+        struct _Item
+        {
+            std::shared_ptr<RendererObjectData> pData;
+            Bool32 isUsed;
+        };
+        //Map between object and its data, key is instance ID of object. Data of objects not got in a frame is deleted when the frame ends.
+        std::unordered_map<InstanceID, _Item> m_mapDatas;
     };
 }
\ No newline at end of file
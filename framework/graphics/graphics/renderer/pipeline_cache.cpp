@@ -42,16 +42,7 @@ namespace vg
             if (info.pVertexData != nullptr) {
                 const auto & subVertexDatas = info.pVertexData->getSubVertexDatas();
                 const auto & subVertexData = subVertexDatas[subIndexData.vertexDataIndex];
-                const auto & targetVertexInputStateInfo = subVertexData.vertexInputStateInfo;
-                vertexInputStateInfo = targetVertexInputStateInfo;
-                vertexBindingDeses.resize(vertexInputStateInfo.vertexBindingDescriptionCount);
-                memcpy(vertexBindingDeses.data(), targetVertexInputStateInfo.pVertexBindingDescriptions, 
-                    vertexInputStateInfo.vertexBindingDescriptionCount * sizeof(vk::VertexInputBindingDescription));
-                vertexAttributeDeses.resize(vertexInputStateInfo.vertexAttributeDescriptionCount);
-                memcpy(vertexAttributeDeses.data(), targetVertexInputStateInfo.pVertexAttributeDescriptions,
-                    vertexInputStateInfo.vertexAttributeDescriptionCount * sizeof(vk::VertexInputAttributeDescription));
-                vertexInputStateInfo.pVertexBindingDescriptions = vertexBindingDeses.data();
-                vertexInputStateInfo.pVertexAttributeDescriptions = vertexAttributeDeses.data();
+                vertexInputStateInfo = subVertexData.vertexInputStateInfo;
             }
         }
     }
@@ -68,8 +59,10 @@ namespace vg
         , passSubPass(target.passSubPass)
         , inputAssemblyStateInfo(target.inputAssemblyStateInfo)
         , vertexInputStateInfo(target.vertexInputStateInfo)
-        , vertexBindingDeses(target.vertexBindingDeses)
-        , vertexAttributeDeses(target.vertexAttributeDeses)
+        , vertexBindingDeses(target.vertexInputStateInfo.pVertexBindingDescriptions, 
+            target.vertexInputStateInfo.pVertexBindingDescriptions + target.vertexInputStateInfo.vertexBindingDescriptionCount)
+        , vertexAttributeDeses(target.vertexInputStateInfo.pVertexAttributeDescriptions,
+            target.vertexInputStateInfo.pVertexAttributeDescriptions + target.vertexInputStateInfo.vertexAttributeDescriptionCount)
     {
 
         vertexInputStateInfo.pVertexBindingDescriptions = vertexBindingDeses.data();
@@ -89,8 +82,10 @@ namespace vg
         passSubPass = target.passSubPass;
         inputAssemblyStateInfo = target.inputAssemblyStateInfo;
         vertexInputStateInfo = target.vertexInputStateInfo;
-        vertexBindingDeses = target.vertexBindingDeses;
-        vertexAttributeDeses = target.vertexAttributeDeses;
+        vertexBindingDeses.assign(target.vertexInputStateInfo.pVertexBindingDescriptions, 
+            target.vertexInputStateInfo.pVertexBindingDescriptions + target.vertexInputStateInfo.vertexBindingDescriptionCount);
+        vertexAttributeDeses.assign(target.vertexInputStateInfo.pVertexAttributeDescriptions,
+            target.vertexInputStateInfo.pVertexAttributeDescriptions + target.vertexInputStateInfo.vertexAttributeDescriptionCount);
 
         vertexInputStateInfo.pVertexBindingDescriptions = vertexBindingDeses.data();
         vertexInputStateInfo.pVertexAttributeDescriptions = vertexAttributeDeses.data();
@@ -167,7 +162,6 @@ namespace vg
     PipelineCache::PipelineCache()
         : m_mapPipelineNoState()
         , m_mapPipelineFull()
-        , m_mapPipelineFullBack()
     {
         _createPipelineCache();
     }
@@ -179,50 +173,34 @@ namespace vg
 
     void PipelineCache::begin()
     {
-        m_mapPipelineFullBack = m_mapPipelineFull;
-        m_mapPipelineFull.clear();
+        for (auto &pair : m_mapPipelineFull)
+        {
+            pair.second.isUsed = VG_FALSE;
+        }
     }
 
     std::shared_ptr<vk::Pipeline> PipelineCache::get(const Info & info)
     {
-        //delete old pipeline.
-
+        //Key isn't copied when pipeline is found, so finding doesn't allocate memory.
         auto fullInfo = InfoFullKey(info);
 
-        auto pOldPipeline1 = m_mapPipelineNoState[fullInfo];
-
-        auto pOldPipeline2 = m_mapPipelineFullBack[fullInfo];
-
-        std::shared_ptr<vk::Pipeline> pPipeline;
-        if (pOldPipeline1 != nullptr) 
+        auto iteratorFull = m_mapPipelineFull.find(fullInfo);
+        if (iteratorFull != m_mapPipelineFull.end()) //Pipeline don't change.
         {
-            if (pOldPipeline2 != nullptr) //Pipeline don't change.
-            {
-                m_mapPipelineFull[fullInfo] = pOldPipeline2;
-                m_mapPipelineFullBack.erase(fullInfo);
-                pPipeline = pOldPipeline2;
-            } 
-            else if (m_mapPipelineFull[fullInfo] != nullptr) //Pipeline don't change.
-            {
-                pPipeline = m_mapPipelineFull[fullInfo];
-            }
-            else
-            {
-                
-                //has old pipeline. delete it from two map.
-                m_mapPipelineNoState.erase(fullInfo);
-                //m_mapPipelineFullBack.erase(info);
-                pPipeline = _createNewPipeline(info);
-                m_mapPipelineNoState[fullInfo] = pPipeline;
-                m_mapPipelineFull[fullInfo] = pPipeline;
-            }
+            iteratorFull->second.isUsed = VG_TRUE;
+            return iteratorFull->second.pPipeline;
         }
-        else //Old pipeline don't exist.
+
+        //Old pipeline don't exist or state is changed, old pipeline with same objects is replaced.
+        auto pPipeline = _createNewPipeline(info);
+        auto iteratorNoState = m_mapPipelineNoState.find(fullInfo);
+        if (iteratorNoState != m_mapPipelineNoState.end())
         {
-            pPipeline = _createNewPipeline(info);
-            m_mapPipelineNoState[fullInfo] = pPipeline;
-            m_mapPipelineFull[fullInfo] = pPipeline;
+            m_mapPipelineNoState.erase(iteratorNoState);
         }
+        m_mapPipelineNoState.insert({fullInfo, pPipeline});
+        _Item item = {pPipeline, VG_TRUE};
+        m_mapPipelineFull.insert({fullInfo, item});
 
         return pPipeline;
     }
@@ -230,7 +208,11 @@ namespace vg
     void PipelineCache::end()
     {
         //Delete unuseful pipelines.
-        m_mapPipelineFullBack.clear();
+        for (auto iterator = m_mapPipelineFull.begin(); iterator != m_mapPipelineFull.end();)
+        {
+            if (iterator->second.isUsed == VG_FALSE) iterator = m_mapPipelineFull.erase(iterator);
+            else ++iterator;
+        }
     }
 
     std::shared_ptr<vk::Pipeline> PipelineCache::_createNewPipeline(const Info & info)
@@ -270,6 +252,7 @@ namespace vg
 
         vk::PipelineVertexInputStateCreateInfo newVertexInputStateInfo;
         std::vector<vk::VertexInputAttributeDescription> newAttrDeses;
+        std::vector<vk::VertexInputBindingDescription> newBindingDeses;
         if (info.pVertexData != nullptr) {
             const auto &pVertexData = info.pVertexData;
             const VertexData::SubVertexData &subVertexData = pVertexData->getSubVertexDatas()[vertexSubIndex];
@@ -299,6 +282,26 @@ namespace vg
                 }
                 newVertexInputStateInfo.vertexAttributeDescriptionCount = newAttrDesIndex;
                 newVertexInputStateInfo.pVertexAttributeDescriptions = newAttrDeses.data();
+                //Only keep bindings used by the remaining attributes, so a pass only filtering position
+                //don't fetch other streams of a mesh with position separate layout.
+                uint32_t bindingDesCount = originVertexInputStateInfo.vertexBindingDescriptionCount;
+                newBindingDeses.resize(bindingDesCount);
+                uint32_t newBindingDesIndex = 0u;
+                for (uint32_t bindingDesIndex = 0u; bindingDesIndex < bindingDesCount; ++bindingDesIndex)
+                {
+                    const auto &bindingDes = *(originVertexInputStateInfo.pVertexBindingDescriptions + bindingDesIndex);
+                    for (uint32_t attrDesIndex = 0u; attrDesIndex < newAttrDesIndex; ++attrDesIndex)
+                    {
+                        if (newAttrDeses[attrDesIndex].binding == bindingDes.binding)
+                        {
+                            newBindingDeses[newBindingDesIndex] = bindingDes;
+                            ++newBindingDesIndex;
+                            break;
+                        }
+                    }
+                }
+                newVertexInputStateInfo.vertexBindingDescriptionCount = newBindingDesIndex;
+                newVertexInputStateInfo.pVertexBindingDescriptions = newBindingDeses.data();
                 createInfo.pVertexInputState = &newVertexInputStateInfo;
             }
             else
@@ -54,6 +54,9 @@ namespace vg {
             std::vector<vk::VertexInputBindingDescription> vertexBindingDeses;
             std::vector<vk::VertexInputAttributeDescription> vertexAttributeDeses;
 
+            /*Key got from info points to vertex input descriptions of the vertex data, it is used to find
+              pipelines without allocating memory. Copied key owns copies of descriptions, so keys in maps
+              are always copied.*/
             InfoFullKey(Info info);
             InfoFullKey(const InfoFullKey &);
             InfoFullKey& operator=(const InfoFullKey &);
@@ -75,20 +78,24 @@ namespace vg {
         PipelineCache();
         ~PipelineCache();
         /**
-         * When frame begin, this method is called to move cache to back and make cache
-         * to empty. After rendering process, we will pick useful pipeline from back.
+         * When frame begin, this method is called to mark all pipelines with full state as unused,
+         * pipelines got in rendering process are marked as used again.
          **/
         void begin();
         std::shared_ptr<vk::Pipeline> get(const Info &info);
         /**
-         * At end of frame, this method is called to delete all useless pipeline in back.
+         * At end of frame, this method is called to delete all unused pipelines with full state.
          **/
         void end();
 
     private:
+        struct _Item
+        {
+            std::shared_ptr<vk::Pipeline> pPipeline;
+            Bool32 isUsed;
+        };
         std::unordered_map<InfoFullKey, std::shared_ptr<vk::Pipeline>, Hash, EqualNoState> m_mapPipelineNoState;
-        std::unordered_map<InfoFullKey, std::shared_ptr<vk::Pipeline>, Hash, EqualFull> m_mapPipelineFull;
-        std::unordered_map<InfoFullKey, std::shared_ptr<vk::Pipeline>, Hash, EqualFull> m_mapPipelineFullBack;
+        std::unordered_map<InfoFullKey, _Item, Hash, EqualFull> m_mapPipelineFull;
         std::shared_ptr<vk::PipelineCache> m_pPipelineCache;
         std::shared_ptr<vk::Pipeline> _createNewPipeline(const Info &info);
         void _createPipelineCache();
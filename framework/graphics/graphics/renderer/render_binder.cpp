@@ -3,10 +3,12 @@
 #include "graphics/util/gemo_util.hpp"
 #include "graphics/scene/light_3.hpp"
 #include "graphics/scene/visual_object_2.hpp"
+#include "graphics/material/material_default.hpp"
+#include "graphics/buffer_data/buffer_data_default.hpp"
 
 namespace vg
 {
-    void fillValidVisualObjects(std::vector<const VisualObject<SpaceType::SPACE_2> *> &arrPVObjs
+    void fillValidVisualObjects(const VisualObject<SpaceType::SPACE_2> **arrPVObjs
         , uint32_t &PVObjIndex
         , const Transform<SpaceType::SPACE_2> *pTransform
         , const Scene<SpaceType::SPACE_2> *pScene
@@ -22,21 +24,29 @@ namespace vg
         , Bool32 shadowEnable
         , Bool32 preDepthEnable
         , Bool32 postRenderEnable
+        , Bool32 deferredEnable
+        , Bool32 spriteBatchEnable
 
         , Bool32 firstScene
         , const BaseScene *pScene
         , const BaseProjector *pProjector
         , const PostRender *pPostRender
+        , const Material *pDeferredCompositionMaterial
 
         , const PreDepthTarget *pPreDepthTarget
         , const PostRenderTarget *pPostRenderTarget
+        , const DeferredTarget *pDeferredTarget
         , const MultiRenderTarget *pRendererTarget
 
         , const Texture *pPreDepthResultTex
         , const Texture *pPostRenderTex
+        , const Texture *pDeferredColorTex
+        , const Texture *pDeferredDepthTex
+        , const Texture * const *pDeferredGBufferTexs
 
         , CmdBuffer *pLightDepthCmdBuffer
         , CmdBuffer *pPreDepthCmdBuffer
+        , CmdBuffer *pDeferredCmdBuffer
         , CmdBuffer *pBranchCmdBuffer
         , CmdBuffer *pTrunkWaitBarrierCmdBuffer
         , CmdBuffer *pTrunkRenderPassCmdBuffer
@@ -47,21 +57,29 @@ namespace vg
         , shadowEnable(shadowEnable) 
         , preDepthEnable(preDepthEnable)
         , postRenderEnable(postRenderEnable)
+        , deferredEnable(deferredEnable)
+        , spriteBatchEnable(spriteBatchEnable)
 
         , firstScene(firstScene)
         , pScene(pScene)
         , pProjector(pProjector)
         , pPostRender(pPostRender)
+        , pDeferredCompositionMaterial(pDeferredCompositionMaterial)
 
         , pPreDepthTarget(pPreDepthTarget)
         , pPostRenderTarget(pPostRenderTarget)
+        , pDeferredTarget(pDeferredTarget)
         , pRendererTarget(pRendererTarget)
 
         , pPreDepthResultTex(pPreDepthResultTex)
         , pPostRenderTex(pPostRenderTex)
+        , pDeferredColorTex(pDeferredColorTex)
+        , pDeferredDepthTex(pDeferredDepthTex)
+        , pDeferredGBufferTexs(pDeferredGBufferTexs)
 
         , pLightDepthCmdBuffer(pLightDepthCmdBuffer)
         , pPreDepthCmdBuffer(pPreDepthCmdBuffer)
+        , pDeferredCmdBuffer(pDeferredCmdBuffer)
         , pBranchCmdBuffer(pBranchCmdBuffer)
         , pTrunkWaitBarrierCmdBuffer(pTrunkWaitBarrierCmdBuffer)
         , pTrunkRenderPassCmdBuffer(pTrunkRenderPassCmdBuffer)
@@ -77,23 +95,38 @@ namespace vg
         , m_bindedObjectCountForLighting(0u)
         , m_bindedObjectsForPreDepth()
         , m_bindedObjectCountForPreDepth(0u)
+        , m_bindedObjectsForDeferred()
+        , m_bindedObjectCountForDeferred(0u)
         , m_bindedObjects()
         , m_bindedObjectCount(0u)
+        , m_spriteBatchEnable(VG_FALSE)
+        , m_spriteBatcher()
         //light data buffer
-        , m_lightDataBufferCache([](const vg::InstanceID &sceneID) {
-            return std::shared_ptr<BufferData>{new BufferData(vk::BufferUsageFlagBits::eUniformBuffer
-                , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
-            };
+        , m_lightDataBlockCache([](const vg::InstanceID &sceneID) {
+            return std::shared_ptr<_LightDataBlock>{new _LightDataBlock()};
         })
         , m_lightTypeCount()
         , m_pCurrLightDataBuffer()
         , m_lightPassTextureInfos()
         , m_lightTextureInfos()
+        , m_shadowAtlases()
+        , m_changedShadowTiles()
+        , m_deferredGBufferTextureNames()
     {}
 
+    RenderBinder::_LightDataBlock::_LightDataBlock()
+        : buffer(vk::BufferUsageFlagBits::eUniformBuffer
+            , vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        , registeredLightStateID(0u)
+        , sortedLights()
+        , memory()
+    {
+
+    }
+
     void RenderBinder::begin()
     {
-        m_lightDataBufferCache.begin();
+        m_lightDataBlockCache.begin();
         m_objectDataCache.begin();
     }
 
@@ -106,7 +139,7 @@ namespace vg
 
     void RenderBinder::end()
     {
-        m_lightDataBufferCache.end();
+        m_lightDataBlockCache.end();
         m_objectDataCache.end();
     }
 
@@ -114,6 +147,7 @@ namespace vg
     {
         m_bindedObjectCountForPreDepth = 0u;
         m_bindedObjectCountForLighting = 0u;
+        m_bindedObjectCountForDeferred = 0u;
         m_bindedObjectCount = 0u;
     }
 
@@ -131,6 +165,12 @@ namespace vg
         }
         m_bindedObjectCountForPreDepth = 0u;
 
+        for (uint32_t i = 0; i < m_bindedObjectCountForDeferred; ++i)
+        {
+            m_bindedObjectsForDeferred[i]->endBindForDeferred();
+        }
+        m_bindedObjectCountForDeferred = 0u;
+
         for (uint32_t i = 0; i < m_bindedObjectCount; ++i) 
         {
             m_bindedObjects[i]->endBind();
@@ -143,6 +183,7 @@ namespace vg
         m_pRendererPassCache = info.pRendererPassCache;
         m_lightingEnable = info.lightingEnable;
         m_shadowEnable = info.shadowEnable;
+        m_spriteBatchEnable = info.spriteBatchEnable;
         if (info.lightingEnable == VG_TRUE)
         {
             _syncLightData(info.pScene);
@@ -174,6 +215,14 @@ namespace vg
                     info.pLightDepthCmdBuffer
                 );
             }
+            _DeferredInfo deferredInfo = {
+                info.pDeferredTarget,
+                info.pDeferredColorTex,
+                info.pDeferredDepthTex,
+                info.pDeferredGBufferTexs,
+                info.pDeferredCompositionMaterial,
+                info.pDeferredCmdBuffer,
+            };
             _bindScene3(nullptr,
                 dynamic_cast<const Scene<SpaceType::SPACE_3> *>(info.pScene), 
                 dynamic_cast<const Projector<SpaceType::SPACE_3> *>(info.pProjector),
@@ -185,7 +234,9 @@ namespace vg
                 info.preDepthEnable ? info.pPreDepthCmdBuffer : nullptr,
                 info.pBranchCmdBuffer,                    
                 info.pTrunkWaitBarrierCmdBuffer,
-                info.pTrunkRenderPassCmdBuffer
+                info.pTrunkRenderPassCmdBuffer,
+                fd::Viewport(),
+                info.deferredEnable ? &deferredInfo : nullptr
                 );
         } 
         else 
@@ -253,93 +304,205 @@ namespace vg
     {
 
     VG_LOG(plog::debug) << "Begin to bind for light depth." << std::endl;
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer bindForLightDepthCostTimer(fd::CostTimer::TimerType::ONCE);
-        fd::CostTimer exportDepthRenderInfoCostTimer(fd::CostTimer::TimerType::ACCUMULATION);
-        bindForLightDepthCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_ZONE("RenderBinder::bindForLightDepth");
 
+        //Lights using shadow atlases are collected and rendered atlas by atlas after other lights.
+        auto &shadowAtlases = m_shadowAtlases;
+        auto &changedShadowTiles = m_changedShadowTiles;
+        shadowAtlases.clear();
+        for (auto &tiles : changedShadowTiles)
+        {
+            tiles.clear();
+        }
         uint32_t lightCount = pScene->getLightCount();
         for (uint32_t i = 0u; i < lightCount; ++i) {
            auto *pLight = pScene->getLightWithIndex(i);
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        exportDepthRenderInfoCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+           FD_PROFILE_BEGIN("RenderBinder::exportDepthRenderInfo");
 
            auto depthRenderInfo = pLight->getDepthRenderInfo();
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        exportDepthRenderInfoCostTimer.end();
-        fd::CostTimer oneLightBindCosttimer(fd::CostTimer::TimerType::ONCE);
-        oneLightBindCosttimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
-        
-           for (uint32_t j = 0; j < depthRenderInfo.renderCount; ++j) {
-                const OnceRenderTarget *pRenderTarget = dynamic_cast<const OnceRenderTarget *>(*(depthRenderInfo.pDepthTargets + j));
-                _renderPassBegin(pRenderTarget
-                 , pRenderTarget->getRenderPass()
-                 , pRenderTarget->getFramebuffer()
-                 , pPreDepthCmdBuffer
-                 );
-                _bindScene3(pLight
-                    , pScene
-                    , dynamic_cast<const Projector<SpaceType::SPACE_3> *>(*(depthRenderInfo.pProjectors + j))
-                    , nullptr
-                    , pRenderTarget
-                    , nullptr
-                    , nullptr
-                    , nullptr
-                    , nullptr
-                    , pPreDepthCmdBuffer
-                    );
-                _renderPassEnd(pPreDepthCmdBuffer);
+           FD_PROFILE_END();
+           FD_PROFILE_ZONE("RenderBinder::bindOneLightDepth");
+
+           if (depthRenderInfo.pShadowAtlas != nullptr)
+           {
+                //The tile is rendered only when the light or its casters are changed.
+                auto pShadowAtlas = depthRenderInfo.pShadowAtlas;
+                auto pLightProjector = dynamic_cast<const Projector<SpaceType::SPACE_3> *>(*(depthRenderInfo.pProjectors));
+                auto casterHash = _caculateCasterHash(pScene, pLightProjector);
+                auto iterator = std::find(shadowAtlases.begin(), shadowAtlases.end(), pShadowAtlas);
+                auto atlasIndex = static_cast<size_t>(iterator - shadowAtlases.begin());
+                if (iterator == shadowAtlases.end())
+                {
+                    shadowAtlases.push_back(pShadowAtlas);
+                    if (changedShadowTiles.size() < shadowAtlases.size()) changedShadowTiles.resize(shadowAtlases.size());
+                }
+                if (pShadowAtlas->isTileChanged(pLight->getID(), casterHash))
+                {
+                    _ShadowTileInfo tileInfo = {
+                        pLight,
+                        pLightProjector,
+                        casterHash,
+                    };
+                    changedShadowTiles[atlasIndex].push_back(tileInfo);
+                }
+           }
+           else
+           {
+               for (uint32_t j = 0; j < depthRenderInfo.renderCount; ++j) {
+                    const OnceRenderTarget *pRenderTarget = dynamic_cast<const OnceRenderTarget *>(*(depthRenderInfo.pDepthTargets + j));
+                    _renderPassBegin(pRenderTarget
+                     , pRenderTarget->getRenderPass()
+                     , pRenderTarget->getFramebuffer()
+                     , pPreDepthCmdBuffer
+                     );
+                    _bindScene3(pLight
+                        , pScene
+                        , dynamic_cast<const Projector<SpaceType::SPACE_3> *>(*(depthRenderInfo.pProjectors + j))
+                        , nullptr
+                        , pRenderTarget
+                        , nullptr
+                        , nullptr
+                        , nullptr
+                        , nullptr
+                        , pPreDepthCmdBuffer
+                        );
+                    _renderPassEnd(pPreDepthCmdBuffer);
+               }
            }
-
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        oneLightBindCosttimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "One light Bind cost time: " 
-                << oneLightBindCosttimer.costTimer << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
 
         }
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        bindForLightDepthCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Export light depth render info cost time: " 
-                << exportDepthRenderInfoCostTimer.costTimer << std::endl;
-        VG_COST_TIME_LOG(plog::debug) << "Bind for light depth cost time: " 
-                << bindForLightDepthCostTimer.costTimer 
-                << "ms, scene id: " << pScene->getID() 
-                << ", scene type: " << (pScene->getSpaceType() == SpaceType::SPACE_3 ? "space3" : "space2") 
-                <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        uint32_t shadowAtlasCount = static_cast<uint32_t>(shadowAtlases.size());
+        for (uint32_t i = 0u; i < shadowAtlasCount; ++i)
+        {
+            _bindForShadowAtlas(pScene, shadowAtlases[i], changedShadowTiles[i], pPreDepthCmdBuffer);
+        }
 
         VG_LOG(plog::debug) << "End to bind for light depth." << std::endl;
     }
 
+    void RenderBinder::_bindForShadowAtlas(const Scene<SpaceType::SPACE_3> *pScene
+        , LightShadowAtlas *pShadowAtlas
+        , const std::vector<_ShadowTileInfo> &changedTiles
+        , CmdBuffer *pPreDepthCmdBuffer
+        )
+    {
+        if (changedTiles.empty()) return;
+        //Tiles of lights which aren't in the scene now are discarded by clearing the whole atlas,
+        //they are rendered again when lights come back.
+        Bool32 isWhole = pShadowAtlas->getIsCleared() == VG_FALSE ||
+            static_cast<uint32_t>(changedTiles.size()) == pShadowAtlas->getTileCount();
+        if (isWhole == VG_TRUE)
+        {
+            pShadowAtlas->resetTiles();
+            _renderPassBegin(pShadowAtlas
+                , pShadowAtlas->getRenderPass()
+                , pShadowAtlas->getFramebuffer()
+                , pPreDepthCmdBuffer
+                );
+        }
+        for (const auto &tileInfo : changedTiles)
+        {
+            const auto &area = pShadowAtlas->getTileArea(tileInfo.pLight->getID());
+            if (isWhole == VG_FALSE)
+            {
+                //Render area includes border of the tile, it is cleared and only the tile is drawn by viewport.
+                const auto &clearArea = pShadowAtlas->getTileClearArea(tileInfo.pLight->getID());
+                _renderPassBegin(pShadowAtlas
+                    , pShadowAtlas->getTileRenderPass()
+                    , pShadowAtlas->getFramebuffer()
+                    , pPreDepthCmdBuffer
+                    , &clearArea
+                    );
+            }
+            _bindScene3(tileInfo.pLight
+                , pScene
+                , tileInfo.pProjector
+                , nullptr
+                , pShadowAtlas
+                , nullptr
+                , nullptr
+                , nullptr
+                , nullptr
+                , pPreDepthCmdBuffer
+                , fd::Viewport(area.x, area.y, area.width, area.height)
+                );
+            if (isWhole == VG_FALSE)
+            {
+                _renderPassEnd(pPreDepthCmdBuffer);
+            }
+            pShadowAtlas->setTileRendered(tileInfo.pLight->getID(), tileInfo.casterHash);
+        }
+        if (isWhole == VG_TRUE)
+        {
+            _renderPassEnd(pPreDepthCmdBuffer);
+        }
+    }
+
+    uint64_t RenderBinder::_caculateCasterHash(const Scene<SpaceType::SPACE_3> *pScene
+        , const Projector<SpaceType::SPACE_3> *pProjector
+        ) const
+    {
+        using SceneType = Scene<SpaceType::SPACE_3>;
+        auto projMatrix = pScene->getProjMatrix(pProjector);
+        auto viewMatrix = pProjector->getWorldToLocalMatrix();
+        uint64_t hash = fd::hashBytes(&projMatrix, static_cast<uint32_t>(sizeof(Matrix4x4)));
+        hash = fd::hashBytes(&viewMatrix, static_cast<uint32_t>(sizeof(Matrix4x4)), hash);
+        uint32_t visualObjectCount = pScene->getVisualObjectCount();
+        for (uint32_t i = 0; i < visualObjectCount; ++i)
+        {
+            auto pVisualObject = pScene->getVisualObjectWithIndex(i);
+            auto pMesh = dynamic_cast<const SceneType::VisualObjectType::MeshDimType *>(pVisualObject->getMesh());
+            auto pTransform = pVisualObject->getTransform();
+            //Casters out of the projection don't change the shadow.
+            if (pMesh->getIsHasBounds() == VG_TRUE &&
+                pVisualObject->getIsVisibilityCheck() == VG_TRUE &&
+                pScene->isInProjection(pProjector, pTransform, pMesh->getBounds()) == VG_FALSE)
+            {
+                continue;
+            }
+            InstanceID objectID = pVisualObject->getID();
+            auto modelMatrix = pTransform->getMatrixLocalToWorld();
+            uint32_t subMeshRange[2] = {
+                pVisualObject->getSubMeshOffset(),
+                pVisualObject->getSubMeshCount(),
+            };
+            hash = fd::hashBytes(&objectID, static_cast<uint32_t>(sizeof(InstanceID)), hash);
+            hash = fd::hashBytes(&modelMatrix, static_cast<uint32_t>(sizeof(Matrix4x4)), hash);
+            hash = fd::hashBytes(&pMesh, static_cast<uint32_t>(sizeof(pMesh)), hash);
+            hash = fd::hashBytes(subMeshRange, static_cast<uint32_t>(sizeof(subMeshRange)), hash);
+        }
+        return hash;
+    }
+
     void RenderBinder::_syncLightData(const BaseScene *pScene)
     {
     VG_LOG(plog::debug) << "Begin to sync light data." << std::endl;
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer syncLightDataCostTimer(fd::CostTimer::TimerType::ONCE);
-        syncLightDataCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
-        BufferData *pLightDataBuffer = m_lightDataBufferCache.caching(pScene->getID()).get();
+        FD_PROFILE_ZONE("RenderBinder::syncLightData");
+        _LightDataBlock *pLightDataBlock = m_lightDataBlockCache.caching(pScene->getID()).get();
+        BufferData *pLightDataBuffer = &(pLightDataBlock->buffer);
         m_pCurrLightDataBuffer = pLightDataBuffer; 
 
-        auto arrRegisteredLights = pScene->getArrRegisteredLights();
-        auto mapReigsteredLights = pScene->getMapRegisteredLights();
+        const auto &mapReigsteredLights = pScene->getMapRegisteredLights();
+        auto &arrRegisteredLights = pLightDataBlock->sortedLights;
 
-        m_lightTypeCount = static_cast<uint32_t>(arrRegisteredLights.size());
+        //copy and sort array only when light types are registered or unregistered.
+        if (pLightDataBlock->registeredLightStateID != pScene->getRegisteredLightStateID())
+        {
+            const auto &arrSceneRegisteredLights = pScene->getArrRegisteredLights();
+            arrRegisteredLights.assign(arrSceneRegisteredLights.cbegin(), arrSceneRegisteredLights.cend());
+            std::sort(arrRegisteredLights.begin(), arrRegisteredLights.end(), [&](const std::type_info *item1, const std::type_info *item2) {
+                const auto &lightInfo1 = mapReigsteredLights.at(std::type_index(*item1));
+                const auto &lightInfo2 = mapReigsteredLights.at(std::type_index(*item2));
+                auto result = static_cast<int32_t>(lightInfo1.bindingPriority) - static_cast<int32_t>(lightInfo2.bindingPriority);
+                return result < 0;
+            });
+            pLightDataBlock->registeredLightStateID = pScene->getRegisteredLightStateID();
+        }
 
-        //copy and sort array.
-        std::sort(arrRegisteredLights.begin(), arrRegisteredLights.end(), [&](const std::type_info *item1, const std::type_info *item2) {
-            const auto &lightInfo1 = mapReigsteredLights[std::type_index(*item1)];
-            const auto &lightInfo2 = mapReigsteredLights[std::type_index(*item2)];
-            auto result = static_cast<int32_t>(lightInfo1.bindingPriority) - static_cast<int32_t>(lightInfo2.bindingPriority);
-            return result < 0;
-        });
+        m_lightTypeCount = static_cast<uint32_t>(arrRegisteredLights.size());
 
         uint32_t vectorSize = static_cast<uint32_t>(sizeof(Vector4));
         //count total size of light data.        
@@ -351,7 +514,7 @@ namespace vg
             const auto lightGroupSize = pScene->getLightGroupSize(*pLightTypeInfo);
             if (lightGroupSize == 0u) continue;
 
-            const auto &lightInfo = mapReigsteredLights[std::type_index(*pLightTypeInfo)];
+            const auto &lightInfo = mapReigsteredLights.at(std::type_index(*pLightTypeInfo));
             uint32_t maxLightCount = lightInfo.maxCount;
             uint32_t textureCount = lightInfo.textureCount;
             //space for count variable.
@@ -370,8 +533,25 @@ namespace vg
             m_lightPassTextureInfos.resize(static_cast<uint32_t>(totalTextureBindingCount));
         }
         
-        //Allocate memory and copy ligth data to it.
-        std::vector<Byte> memory(totalSize);
+        //Whole block is uploaded when its layout is changed, otherwise only range of changed data is uploaded.
+        auto &memory = pLightDataBlock->memory;
+        Bool32 isWholeChanged = static_cast<uint32_t>(memory.size()) != totalSize || 
+            pLightDataBuffer->getBufferSize() < totalSize;
+        if (static_cast<uint32_t>(memory.size()) != totalSize)
+        {
+            memory.assign(static_cast<size_t>(totalSize), 0u);
+        }
+        uint32_t changedBegin = totalSize;
+        uint32_t changedEnd = 0u;
+        auto copyData = [&](uint32_t dstOffset, const void *pSrc, uint32_t size)
+        {
+            if (memcmp(memory.data() + dstOffset, pSrc, size) == 0) return;
+            memcpy(memory.data() + dstOffset, pSrc, size);
+            changedBegin = std::min(changedBegin, dstOffset);
+            changedEnd = std::max(changedEnd, dstOffset + size);
+        };
+
+        //Copy ligth data to memory.
         uint32_t offset = 0u;
         uint32_t lightTypeOffset = 0u;
         uint32_t lightBindingOffset = 0u;
@@ -379,7 +559,7 @@ namespace vg
         {
             const uint32_t lightGroupSize = pScene->getLightGroupSize(*pLightTypeInfo);
             if (lightGroupSize == 0u) continue;
-            const auto &lightInfo = mapReigsteredLights[std::type_index(*pLightTypeInfo)];
+            const auto &lightInfo = mapReigsteredLights.at(std::type_index(*pLightTypeInfo));
             BaseLight * const *lightGroup;
             if (pScene->getSpaceType() == SpaceType::SPACE_2) 
             {
@@ -395,7 +575,7 @@ namespace vg
             uint32_t maxLightCount = lightInfo.maxCount;
             uint32_t lightCount = static_cast<uint32_t>(lightGroupSize);
             //copy data to buffer
-            memcpy(memory.data() + offset, &lightCount, sizeof(uint32_t));
+            copyData(offset, &lightCount, static_cast<uint32_t>(sizeof(uint32_t)));
             offset += vectorSize;
             for (uint32_t lightIndex = 0u; lightIndex < lightGroupSize; ++lightIndex)
             {
@@ -404,7 +584,7 @@ namespace vg
                 //check if data size is equal between light and light type registed.
                 if (lightExportInfo.dataSize != lightInfo.dataSize)
                     throw std::runtime_error("The data size of the light is not equal to the data size of this light type registerd to scene. ");
-                memcpy(memory.data() + offset, lightExportInfo.pData, lightExportInfo.dataSize);
+                copyData(offset, lightExportInfo.pData, lightExportInfo.dataSize);
                 offset += lightInfo.dataSize;
             }
             
@@ -453,18 +633,19 @@ namespace vg
             lightTypeOffset += vectorSize;
             lightTypeOffset += lightInfo.dataSize * maxLightCount;
             //offet should be entire block memory for last light types because light count may be is less than max light count.
+            //data of removed lights is left behind count of lights and isn't read by shaders.
             offset = lightTypeOffset;
         }
 
-        pLightDataBuffer->updateBuffer(memory.data(), totalSize);
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        syncLightDataCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Sync light data cost time: " 
-                << syncLightDataCostTimer.costTimer 
-                << "ms, scene id: " << pScene->getID() 
-                << ", scene type: " << (pScene->getSpaceType() == SpaceType::SPACE_3 ? "space3" : "space2") 
-                <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        if (isWholeChanged == VG_TRUE)
+        {
+            pLightDataBuffer->updateBuffer(memory.data(), totalSize);
+        }
+        else if (changedBegin < changedEnd)
+        {
+            MemorySlice slice(memory.data() + changedBegin, changedEnd - changedBegin, changedBegin);
+            pLightDataBuffer->updateBuffer(slice, totalSize);
+        }
         VG_LOG(plog::debug) << "End to sync light data." << std::endl;
     }
 
@@ -564,11 +745,7 @@ namespace vg
         using SceneType = Scene<SpaceType::SPACE_2>;
         auto pDevice = pApp->getDevice();
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        
-        fd::CostTimer preparingCommonMatrixsCostTimer(fd::CostTimer::TimerType::ONCE);
-        preparingCommonMatrixsCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_BEGIN("RenderBinder::prepareCommonMatrixs");
         auto projMatrix3x3 = pScene->getProjMatrix(pProjector);
         auto projMatrix = tranMat3ToMat4(projMatrix3x3);
 #ifdef USE_WORLD_BOUNDS
@@ -578,22 +755,17 @@ namespace vg
         auto viewMatrix3x3 = pProjector->getWorldToLocalMatrix();
         auto viewMatrix = tranMat3ToMat4(viewMatrix3x3);
         auto viewerPos = tranVec3ToVec4(viewerPos3x3);
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        preparingCommonMatrixsCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Preparing common matrixs cost time: " 
-                << preparingCommonMatrixsCostTimer.costTimer << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_END();
 
         uint32_t visualObjectCount = pScene->getVisualObjectCount();
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer visibilityCheckCostTimer(fd::CostTimer::TimerType::ONCE);
-        visibilityCheckCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_BEGIN("RenderBinder::checkVisibility");
 
         //flat visual objects and filter them that is out of projection with its bounds.
         //allocate enough space for array to storage points.
-        std::vector<const SceneType::VisualObjectType *> validVisualObjects(visualObjectCount);
+        auto &frameArena = fd::getDefaultFrameArena();
+        fd::FrameArenaScope frameArenaScope(frameArena);
+        auto validVisualObjects = frameArena.allocateArray<const SceneType::VisualObjectType *>(visualObjectCount);
         uint32_t validVisualObjectCount(0u);
         auto pRoot = pScene->pRootTransform;
         fillValidVisualObjects(validVisualObjects
@@ -607,29 +779,19 @@ namespace vg
 #endif //USE_WORLD_BOUNDS
         );
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        visibilityCheckCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Visibility check cost time: " 
-                << visibilityCheckCostTimer.costTimer <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_END();
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer preparingBuildInDataCostTimer(fd::CostTimer::TimerType::ACCUMULATION);
-        fd::CostTimer bindObjectCostTimer(fd::CostTimer::TimerType::ACCUMULATION);
-#endif //DEBUG and VG_ENABLE_COST_TIMER
         //------Doing render.
-        for (uint32_t i = 0u; i < validVisualObjectCount; ++i)
+        auto bindVisualObject = [&](const SceneType::VisualObjectType *pVisualObject)
         {
-            auto pVisualObject = validVisualObjects[i];
             auto pObjectRenderData = m_objectDataCache.get(pVisualObject->getID());
             auto modelMatrix = tranMat3ToMat4(pVisualObject->getTransform()->getMatrixLocalToWorld());
             if (pPreDepthCmdBuffer != nullptr) 
             {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_BEGIN("RenderBinder::setBuildInData");
                 _setBuildInData(nullptr
                     , VG_TRUE
+                    , VG_FALSE
                     , pVisualObject
                     , modelMatrix
                     , viewMatrix
@@ -637,16 +799,13 @@ namespace vg
                     , nullptr
                     , viewerPos
                 );
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER    
+                FD_PROFILE_END();
             }
             if (pTrunkRenderPassCmdBuffer != nullptr)
             {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_BEGIN("RenderBinder::setBuildInData");
                 _setBuildInData(pLight
+                    , VG_FALSE
                     , VG_FALSE
                     , pVisualObject
                     , modelMatrix
@@ -655,13 +814,9 @@ namespace vg
                     , pPreDepthResultTex
                     , viewerPos
                     );
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_END();
             }
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                bindObjectCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+            FD_PROFILE_BEGIN("RenderBinder::bindVisualObject");
             if (pPreDepthCmdBuffer != nullptr) 
             {
                 BaseVisualObject::BindInfo info = {
@@ -677,7 +832,7 @@ namespace vg
                 result.pTrunkRenderPassCmdBuffer = pPreDepthCmdBuffer;
                 result.pBranchCmdBuffer = nullptr;
                 result.pTrunkWaitBarrierCmdBuffer = nullptr;
-                _bindVisualObject(VG_FALSE, VG_TRUE, pVisualObject, info, &result);
+                _bindVisualObject(VG_FALSE, VG_TRUE, VG_FALSE, pVisualObject, info, &result);
             }
 
             if (pTrunkRenderPassCmdBuffer != nullptr)
@@ -695,24 +850,95 @@ namespace vg
                 result.pTrunkRenderPassCmdBuffer = pTrunkRenderPassCmdBuffer;
                 result.pBranchCmdBuffer = pBranchCmdBuffer;
                 result.pTrunkWaitBarrierCmdBuffer = pTrunkWaitBarrierCmdBuffer;
-                _bindVisualObject(pLight, VG_FALSE, pVisualObject, info, &result);
+                _bindVisualObject(pLight, VG_FALSE, VG_FALSE, pVisualObject, info, &result);
             }
             
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                bindObjectCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+            FD_PROFILE_END();
+        };
+
+        //Sprites are merged only in the trunk render pass, objects of pre-depth are bound one by one.
+        Bool32 isSpriteBatch = m_spriteBatchEnable == VG_TRUE && pTrunkRenderPassCmdBuffer != nullptr &&
+            pPreDepthCmdBuffer == nullptr && pDefaultTransientBuffer != nullptr;
+        auto flushSprites = [&]()
+        {
+            uint32_t spriteCount = m_spriteBatcher.getSpriteCount();
+            if (spriteCount == 0u) return;
+            if (spriteCount == 1u)
+            {
+                //A single sprite is bound as usual, so its draw isn't changed.
+                auto pSprite = m_spriteBatcher.getSprite(0u);
+                m_spriteBatcher.clear();
+                bindVisualObject(pSprite);
+                return;
+            }
+            SpriteBatcher::Batch batch;
+            m_spriteBatcher.flush(pDefaultTransientBuffer.get(), &batch);
+            //Vertices of the batch are in world space.
+            Matrix4x4 modelMatrix(1.0f);
+            FD_PROFILE_BEGIN("RenderBinder::setBuildInData");
+            _setBuildInData(pLight
+                , VG_FALSE
+                , VG_FALSE
+                , batch.pFirstSprite
+                , modelMatrix
+                , viewMatrix
+                , projMatrix
+                , pPreDepthResultTex
+                , viewerPos
+                );
+            FD_PROFILE_END();
+
+            //It is same as default binding of material, clip rect of the batch is its scissor.
+            fd::Viewport viewport;
+            fd::Rect2D clipRect = batch.hasClipRect ? batch.clipRect : fd::Rect2D();
+            RenderPassInfo trunkRenderPassInfo;
+            trunkRenderPassInfo.pRenderPass = nullptr;
+            trunkRenderPassInfo.pFramebuffer = nullptr;
+            trunkRenderPassInfo.framebufferWidth = pRenderTarget != nullptr ? pRenderTarget->getFramebufferWidth() : 0u;
+            trunkRenderPassInfo.framebufferHeight = pRenderTarget != nullptr ? pRenderTarget->getFramebufferHeight() : 0u;
+            trunkRenderPassInfo.projMatrix = projMatrix;
+            trunkRenderPassInfo.viewMatrix = viewMatrix;
+            trunkRenderPassInfo.pPass = batch.pPass;
+            trunkRenderPassInfo.modelMatrix = modelMatrix;
+            trunkRenderPassInfo.pMesh = batch.pFirstSprite->getMesh();
+            trunkRenderPassInfo.subMeshIndex = 0u;
+            trunkRenderPassInfo.viewport = viewport;
+            trunkRenderPassInfo.scissor = fd::Rect2D(viewport.x + clipRect.x * viewport.width
+                , viewport.y + clipRect.y * viewport.height
+                , clipRect.width * viewport.width
+                , clipRect.height * viewport.height
+                );
+            trunkRenderPassInfo.objectID = batch.pFirstSprite->getID();
+            trunkRenderPassInfo.pCmdDrawIndexed = &batch.cmdDrawIndexed;
+            trunkRenderPassInfo.pGeometryBinding = &batch.geometryBinding;
+            CmdInfo cmdInfo;
+            cmdInfo.pRenderPassInfo = &trunkRenderPassInfo;
+            pTrunkRenderPassCmdBuffer->addCmd(cmdInfo);
+        };
+
+        for (uint32_t i = 0u; i < validVisualObjectCount; ++i)
+        {
+            auto pVisualObject = validVisualObjects[i];
+            if (isSpriteBatch == VG_TRUE)
+            {
+                if (m_spriteBatcher.isSprite(pVisualObject) == VG_TRUE)
+                {
+                    auto pObjectRenderData = m_objectDataCache.get(pVisualObject->getID());
+                    Bool32 hasClipRect = pObjectRenderData->hasClipRect;
+                    fd::Rect2D clipRect = hasClipRect ? pObjectRenderData->clipRects[0] : fd::Rect2D();
+                    if (m_spriteBatcher.canAdd(pVisualObject, hasClipRect, clipRect) == VG_FALSE) flushSprites();
+                    m_spriteBatcher.add(pVisualObject, hasClipRect, clipRect);
+                    continue;
+                }
+                //Paint order is kept, so sprites before the object are drawn first.
+                flushSprites();
+            }
+            bindVisualObject(pVisualObject);
         }
-        
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        VG_COST_TIME_LOG(plog::debug) << "Preparing buildin data cost time: " 
-            << preparingBuildInDataCostTimer.costTimer <<  std::endl;
-        
-        VG_COST_TIME_LOG(plog::debug) << "Bind Visual Object cost time: " 
-            << bindObjectCostTimer.costTimer <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        flushSprites();
     }
 
-    void fillValidVisualObjects(std::vector<const VisualObject<SpaceType::SPACE_2> *> &arrPVObjs
+    void fillValidVisualObjects(const VisualObject<SpaceType::SPACE_2> **arrPVObjs
         , uint32_t &PVObjIndex
         , const Transform<SpaceType::SPACE_2> *pTransform
         , const Scene<SpaceType::SPACE_2> *pScene
@@ -785,10 +1011,11 @@ namespace vg
                     const VisualObject2 *pObject = dynamic_cast<const VisualObject2 *>(pVisualObjectOfChild);
                     if (pObject->getHasClipRect()) {
                         uint32_t subMeshCount = pVisualObjectOfChild->getSubMeshCount();
-                        auto pRects = pObject->getClipRects();
-                        std::vector<fd::Rect2D> rects(subMeshCount);
+                        //Rects are intersected in place, so no temporary array is needed.
+                        pObjectRenderData->setHasClipRect(VG_TRUE);
+                        pObjectRenderData->updateClipRects(pObject->getClipRects(), subMeshCount);
+                        auto &rects = pObjectRenderData->clipRects;
                         for (auto i = 0u; i < subMeshCount; ++i) {
-                            rects[i] = *(pRects + i);
                             float minX = std::max(rects[i].x, clipRect.x);
                             float minY = std::max(rects[i].y, clipRect.y);
                             float maxX = std::min(rects[i].x + rects[i].width, clipRect.x + clipRect.width);
@@ -798,9 +1025,6 @@ namespace vg
                             rects[i].setWidth(maxX - minX);
                             rects[i].setHeight(maxY - minY);
                         }
-
-                        pObjectRenderData->setHasClipRect(VG_TRUE);
-                        pObjectRenderData->updateClipRects(rects);
                     } else {
                         uint32_t subMeshCount = pVisualObjectOfChild->getSubMeshCount();
                         pObjectRenderData->setHasClipRect(VG_TRUE);
@@ -821,6 +1045,8 @@ namespace vg
         , CmdBuffer *pBranchCmdBuffer
         , CmdBuffer *pTrunkWaitBarrierCmdBuffer        
         , CmdBuffer *pTrunkRenderPassCmdBuffer
+        , const fd::Viewport &viewport
+        , const _DeferredInfo *pDeferredInfo
         )
     {
         using SceneType = Scene<SpaceType::SPACE_3>;
@@ -830,11 +1056,7 @@ namespace vg
         auto queueTypeCount = static_cast<uint32_t>(RenderQueueType::RANGE_SIZE);
         auto pDevice = pApp->getDevice();
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        
-        fd::CostTimer preparingCommonMatrixsCostTimer(fd::CostTimer::TimerType::ONCE);
-        preparingCommonMatrixsCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_BEGIN("RenderBinder::prepareCommonMatrixs");
 
         auto projMatrix = pScene->getProjMatrix(pProjector);
 
@@ -843,23 +1065,20 @@ namespace vg
 #endif
         auto viewerPos = pProjector->getLocalToWorldMatrix() * Vector4(0.0f, 0.0f, 0.0f, 1.0f);
         auto viewMatrix = pProjector->getWorldToLocalMatrix();
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        preparingCommonMatrixsCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Preparing common matrixs cost time: " 
-                << preparingCommonMatrixsCostTimer.costTimer <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        //Clusters can't be culled with projection matrix of omni-directional projector, eg. point lights.
+        Bool32 omniDirectional = pProjector->getOmniDirectional();
+        FD_PROFILE_END();
 
         uint32_t visualObjectCount = pScene->getVisualObjectCount();
         
         //----------Preparing render.
 
         //Filter visualObject is out of projection with its bounds.
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer visibilityCheckCostTimer(fd::CostTimer::TimerType::ONCE);
-        visibilityCheckCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_BEGIN("RenderBinder::checkVisibility");
 
-        std::vector<const SceneType::VisualObjectType *> validVisualObjects(visualObjectCount); //allocate enough space for array to storage points.
+        auto &frameArena = fd::getDefaultFrameArena();
+        fd::FrameArenaScope frameArenaScope(frameArena);
+        auto validVisualObjects = frameArena.allocateArray<const SceneType::VisualObjectType *>(visualObjectCount); //allocate enough space for array to storage points.
         uint32_t validVisualObjectCount(0u);
         for (uint32_t i = 0; i < visualObjectCount; ++i)
         {
@@ -906,14 +1125,10 @@ namespace vg
             }
         }
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        visibilityCheckCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Visibility check cost time: " 
-                << visibilityCheckCostTimer.costTimer <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_END();
 
         //Get queue count for each queue type.
-        std::vector<uint32_t> queueLengths(queueTypeCount, 0u);
+        uint32_t queueLengths[static_cast<size_t>(RenderQueueType::RANGE_SIZE)] = {};
         for (uint32_t i = 0; i < validVisualObjectCount; ++i)
         {
             auto pVisualObject = validVisualObjects[i];
@@ -921,11 +1136,15 @@ namespace vg
             ++queueLengths[static_cast<size_t>(renderQueueType)];
         }
 
-        std::vector<std::vector<const SceneType::VisualObjectType *>> queues(queueTypeCount);
-        //Resize queues and reset quue counts to zero for preparing next use.
+        //Queues are ranges of one array in order of queue types.
+        auto queueObjects = frameArena.allocateArray<const SceneType::VisualObjectType *>(validVisualObjectCount);
+        const SceneType::VisualObjectType **queues[static_cast<size_t>(RenderQueueType::RANGE_SIZE)];
+        //Reset quue counts to zero for preparing next use.
+        uint32_t queueOffset = 0u;
         for (uint32_t i = 0; i < queueTypeCount; ++i)
         {
-            queues[i].resize(queueLengths[i], nullptr);
+            queues[i] = queueObjects + queueOffset;
+            queueOffset += queueLengths[i];
             queueLengths[i] = 0u;
         }
 
@@ -938,8 +1157,8 @@ namespace vg
         }
 
         //sort transparent queue.
-        std::sort(queues[static_cast<size_t>(RenderQueueType::TRANSPARENT)].begin(),
-            queues[static_cast<size_t>(RenderQueueType::TRANSPARENT)].end(),
+        std::sort(queues[static_cast<size_t>(RenderQueueType::TRANSPARENT)],
+            queues[static_cast<size_t>(RenderQueueType::TRANSPARENT)] + queueLengths[static_cast<size_t>(RenderQueueType::TRANSPARENT)],
             [&viewMatrix, &projMatrix](const typename SceneType::ObjectType *pObject1, const typename SceneType::ObjectType *pObject2)
             {
                 auto modelMatrix1 = pObject1->getTransform()->getMatrixLocalToWorld();
@@ -961,10 +1180,29 @@ namespace vg
         
             });
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer preparingBuildInDataCostTimer(fd::CostTimer::TimerType::ACCUMULATION);
-        fd::CostTimer bindObjectCostTimer(fd::CostTimer::TimerType::ACCUMULATION);
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        //The deferred render pass is only recorded when some visible objects have deferred materials.
+        Bool32 hasDeferredObjects = VG_FALSE;
+        if (pDeferredInfo != nullptr && pTrunkRenderPassCmdBuffer != nullptr)
+        {
+            for (uint32_t i = 0; i < validVisualObjectCount; ++i)
+            {
+                if (validVisualObjects[i]->hasDeferredMaterial())
+                {
+                    hasDeferredObjects = VG_TRUE;
+                    break;
+                }
+            }
+        }
+        if (hasDeferredObjects)
+        {
+            _renderPassBegin(pDeferredInfo->pTarget
+                , pDeferredInfo->pTarget->getRenderPass()
+                , pDeferredInfo->pTarget->getFramebuffer()
+                , pDeferredInfo->pCmdBuffer
+                );
+            _bindForDeferredResult(pDeferredInfo, pRenderTarget, pTrunkRenderPassCmdBuffer);
+        }
+
         //-----Doing render
         for (uint32_t typeIndex = 0u; typeIndex < queueTypeCount; ++typeIndex)
         {
@@ -974,13 +1212,13 @@ namespace vg
                 auto pVisualObject = queues[typeIndex][objectIndex];
                 auto pObjectRenderData = m_objectDataCache.get(pVisualObject->getID());
                 auto modelMatrix = pVisualObject->getTransform()->getMatrixLocalToWorld();
+                Bool32 isDeferred = hasDeferredObjects && pVisualObject->hasDeferredMaterial();
                 if (pPreDepthCmdBuffer != nullptr) 
                 {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                    FD_PROFILE_BEGIN("RenderBinder::setBuildInData");
                     _setBuildInData(nullptr
                         , VG_TRUE
+                        , VG_FALSE
                         , pVisualObject
                         , modelMatrix
                         , viewMatrix
@@ -988,17 +1226,14 @@ namespace vg
                         , nullptr
                         , viewerPos
                     );
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER   
+                FD_PROFILE_END();
                 }
                 if (pTrunkRenderPassCmdBuffer != nullptr)
                 {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                    FD_PROFILE_BEGIN("RenderBinder::setBuildInData");
                     _setBuildInData(pLight
                         , VG_FALSE
+                        , isDeferred
                         , pVisualObject
                         , modelMatrix
                         , viewMatrix
@@ -1006,13 +1241,9 @@ namespace vg
                         , pPreDepthResultTex
                         , viewerPos
                     );
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                preparingBuildInDataCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_END();
                 }
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                bindObjectCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_BEGIN("RenderBinder::bindVisualObject");
                 if (pPreDepthCmdBuffer != nullptr) 
                 {
                     BaseVisualObject::BindInfo info = {
@@ -1022,16 +1253,37 @@ namespace vg
                         &viewMatrix,
                         pObjectRenderData->hasClipRect,
                         pObjectRenderData->clipRects,
+                        fd::Viewport(),
+                        omniDirectional,
                         };
                     
                     BaseVisualObject::BindResult result;
                     result.pTrunkRenderPassCmdBuffer = pPreDepthCmdBuffer;
                     result.pBranchCmdBuffer = nullptr;
                     result.pTrunkWaitBarrierCmdBuffer = nullptr;
-                    _bindVisualObject(nullptr, VG_TRUE, pVisualObject, info, &result);
+                    _bindVisualObject(nullptr, VG_TRUE, VG_FALSE, pVisualObject, info, &result);
                 }
     
-                if (pTrunkRenderPassCmdBuffer != nullptr)
+                if (isDeferred)
+                {
+                    BaseVisualObject::BindInfo info = {
+                        pDeferredInfo->pTarget->getFramebufferWidth(),
+                        pDeferredInfo->pTarget->getFramebufferHeight(),
+                        &projMatrix,
+                        &viewMatrix,
+                        pObjectRenderData->hasClipRect,
+                        pObjectRenderData->clipRects,
+                        viewport,
+                        omniDirectional,
+                        };
+        
+                    BaseVisualObject::BindResult result;
+                    result.pTrunkRenderPassCmdBuffer = pDeferredInfo->pCmdBuffer;
+                    result.pBranchCmdBuffer = nullptr;
+                    result.pTrunkWaitBarrierCmdBuffer = nullptr;
+                    _bindVisualObject(pLight, VG_FALSE, VG_TRUE, pVisualObject, info, &result);
+                }
+                else if (pTrunkRenderPassCmdBuffer != nullptr)
                 {
                     BaseVisualObject::BindInfo info = {
                         pRenderTarget != nullptr ? pRenderTarget->getFramebufferWidth() : 0u,
@@ -1040,32 +1292,152 @@ namespace vg
                         &viewMatrix,
                         pObjectRenderData->hasClipRect,
                         pObjectRenderData->clipRects,
+                        viewport,
+                        omniDirectional,
                         };
         
                     BaseVisualObject::BindResult result;
                     result.pTrunkRenderPassCmdBuffer = pTrunkRenderPassCmdBuffer;
                     result.pBranchCmdBuffer = pBranchCmdBuffer;
                     result.pTrunkWaitBarrierCmdBuffer = pTrunkWaitBarrierCmdBuffer;
-                    _bindVisualObject(pLight, VG_FALSE, pVisualObject, info, &result);
+                    _bindVisualObject(pLight, VG_FALSE, VG_FALSE, pVisualObject, info, &result);
                     
                 }
                 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-                bindObjectCostTimer.end();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+                FD_PROFILE_END();
+            }
+        }
+
+        if (hasDeferredObjects)
+        {
+            _bindForDeferredComposition(pDeferredInfo);
+            _renderPassEnd(pDeferredInfo->pCmdBuffer);
+        }
+    }
+
+    void RenderBinder::_bindForDeferredResult(const _DeferredInfo *pDeferredInfo
+        , const BaseRenderTarget *pRenderTarget
+        , CmdBuffer *pTrunkRenderPassCmdBuffer
+        )
+    {
+        auto pPass = pDefaultDeferredResultMaterial->getMainPass();
+        auto pRendererPass = m_pRendererPassCache->get(pPass, 0);
+        const char *names[2] = {
+            VG_PASS_DEFERRED_COLOR_TEXTURE_NAME,
+            VG_PASS_DEFERRED_DEPTH_TEXTURE_NAME,
+        };
+        const Texture *pTextures[2] = {
+            pDeferredInfo->pColorTex,
+            pDeferredInfo->pDepthTex,
+        };
+        uint32_t bindingPriorities[2] = {
+            VG_PASS_DEFERRED_COLOR_TEXTURE_BINDING_PRIORITY,
+            VG_PASS_DEFERRED_DEPTH_TEXTURE_BINDING_PRIORITY,
+        };
+        for (uint32_t i = 0u; i < 2u; ++i)
+        {
+            vg::PassTextureInfo::TextureInfo itemInfo = {
+                pTextures[i],
+                nullptr,
+                nullptr,
+                vk::ImageLayout::eUndefined,
+            };
+            PassTextureInfo info = {
+                vg::SamplerTextureType::TEX_2D,
+                1u,
+                &itemInfo,
+                bindingPriorities[i],
+                vg::ImageDescriptorType::COMBINED_IMAGE_SAMPLER,
+                vk::ShaderStageFlagBits::eFragment,
+            };
+            if (pRendererPass->getBindingSet().hasTexture(names[i]) == VG_FALSE)
+            {
+                pRendererPass->getBindingSet().addTexture(names[i], info);
+            }
+            else
+            {
+                pRendererPass->getBindingSet().setTexture(names[i], info);
+            }
+        }
+
+        CmdDraw cmdDraw = {3, 1, 0, 0};
+        RenderPassInfo renderPassInfo;
+        renderPassInfo.pRenderPass = nullptr;
+        renderPassInfo.pFramebuffer = nullptr;
+        renderPassInfo.framebufferWidth = pRenderTarget->getFramebufferWidth();
+        renderPassInfo.framebufferHeight = pRenderTarget->getFramebufferHeight();
+        renderPassInfo.pPass = pPass;
+        renderPassInfo.pMesh = nullptr;
+        renderPassInfo.objectID = 0;
+        renderPassInfo.pCmdDraw = &cmdDraw;
+
+        CmdInfo cmdInfo;
+        cmdInfo.pRenderPassInfo = &renderPassInfo;
+        pTrunkRenderPassCmdBuffer->addCmd(cmdInfo);
+    }
+
+    void RenderBinder::_bindForDeferredComposition(const _DeferredInfo *pDeferredInfo)
+    {
+        auto pPass = pDeferredInfo->pCompositionMaterial->getMainPass();
+        auto pRendererPass = m_pRendererPassCache->get(pPass, 0);
+        uint32_t gbufferCount = pDeferredInfo->pTarget->getGBufferCount();
+        auto &names = m_deferredGBufferTextureNames;
+        for (uint32_t i = static_cast<uint32_t>(names.size()); i < gbufferCount; ++i)
+        {
+            names.push_back(VG_PASS_DEFERRED_GBUFFER_TEXTURE_NAME + std::to_string(i));
+        }
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            vg::PassTextureInfo::TextureInfo itemInfo = {
+                *(pDeferredInfo->pGBufferTexs + i),
+                nullptr,
+                nullptr,
+                vk::ImageLayout::eShaderReadOnlyOptimal,
+            };
+            PassTextureInfo info = {
+                vg::SamplerTextureType::TEX_2D,
+                1u,
+                &itemInfo,
+                VG_PASS_DEFERRED_GBUFFER_MIN_BINDING_PRIORITY + i,
+                vg::ImageDescriptorType::INPUT_ATTACHMENT,
+                vk::ShaderStageFlagBits::eFragment,
+            };
+            const auto &name = names[i];
+            if (pRendererPass->getBindingSet().hasTexture(name) == VG_FALSE)
+            {
+                pRendererPass->getBindingSet().addTexture(name, info);
+            }
+            else
+            {
+                pRendererPass->getBindingSet().setTexture(name, info);
             }
         }
+        //The default composition only outputs albedo, so light data is only bound to other materials.
+        if (pDeferredInfo->pCompositionMaterial != pDefaultDeferredCompositionMaterial.get())
+        {
+            _bindLightData(pRendererPass);
+        }
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        VG_COST_TIME_LOG(plog::debug) << "Preparing buildin data cost time: " 
-            << preparingBuildInDataCostTimer.costTimer <<  std::endl;
-        VG_COST_TIME_LOG(plog::debug) << "Bind Visual Object cost time: " 
-            << bindObjectCostTimer.costTimer <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        CmdDraw cmdDraw = {3, 1, 0, 0};
+        RenderPassInfo renderPassInfo;
+        renderPassInfo.pRenderPass = nullptr;
+        renderPassInfo.subPassIndex = DeferredTarget::COMPOSITION_SUBPASS_INDEX;
+        renderPassInfo.pFramebuffer = nullptr;
+        renderPassInfo.framebufferWidth = pDeferredInfo->pTarget->getFramebufferWidth();
+        renderPassInfo.framebufferHeight = pDeferredInfo->pTarget->getFramebufferHeight();
+        renderPassInfo.pPass = pPass;
+        renderPassInfo.pMesh = nullptr;
+        renderPassInfo.objectID = 0;
+        renderPassInfo.pCmdDraw = &cmdDraw;
+
+        CmdInfo cmdInfo;
+        cmdInfo.pRenderPassInfo = &renderPassInfo;
+        pDeferredInfo->pCmdBuffer->addCmd(cmdInfo);
     }
 
     void RenderBinder::_setBuildInData(const BaseLight *pLight
         , Bool32 isPreDepth
+        , Bool32 isDeferred
         , const BaseVisualObject * pVisualObject
         , Matrix4x4 modelMatrix
         , Matrix4x4 viewMatrix
@@ -1087,6 +1459,10 @@ namespace vg
             {
                 pMaterial = pVisualObject->getPreDepthMaterial(materialIndex);
             }
+            else if (isDeferred)
+            {
+                pMaterial = pVisualObject->getDeferredMaterial(materialIndex);
+            }
             else
             {
                 pMaterial = pVisualObject->getMaterial(materialIndex);
@@ -1179,45 +1555,7 @@ namespace vg
 
                 if (isPreDepth == VG_FALSE && pLight == nullptr)
                 {                
-                    //light data buffer.
-                    if (m_lightingEnable && m_lightTypeCount > 0)
-                    {
-                        vg::PassBufferInfo::BufferInfo itemInfo = {
-                            m_pCurrLightDataBuffer,
-                            0u,
-                            m_pCurrLightDataBuffer->getBufferSize(),
-                        };
-                        PassBufferInfo info = {
-                            1u,
-                            &itemInfo,
-                            VG_PASS_LIGHT_DATA_BUFFER_BINDING_PRIORITY,
-                            vg::BufferDescriptorType::UNIFORM_BUFFER,
-                            vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
-                        };
-                        if (pRendererPass->getBindingSet().hasBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME) == VG_FALSE)
-                        {
-							pRendererPass->getBindingSet().addBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME, info);
-                        }
-                        else
-                        {
-                            pRendererPass->getBindingSet().setBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME, info);
-                        }
-                        //light textures.
-                        auto &lightPassTextureInfos = m_lightPassTextureInfos;
-                        uint32_t textureInfoCount = static_cast<uint32_t>(lightPassTextureInfos.size());
-                        for (uint32_t textureInfoIndex = 0u; textureInfoIndex < textureInfoCount; ++textureInfoIndex)
-                        {
-                            std::string name = VG_PASS_LIGHT_TEXTURE_NAME + std::to_string(textureInfoIndex);
-                            if (pRendererPass->getBindingSet().hasTexture(name) == VG_FALSE) 
-                            {
-                                pRendererPass->getBindingSet().addTexture(name, lightPassTextureInfos[textureInfoIndex]);
-                            }
-                            else
-                            {
-                                pRendererPass->getBindingSet().setTexture(name, lightPassTextureInfos[textureInfoIndex]);
-                            }
-                        }
-                    }
+                    _bindLightData(pRendererPass);
     
                     if (pPreDepthResultTex != nullptr)
                     {
@@ -1265,8 +1603,52 @@ namespace vg
         }
     }
 
+    void RenderBinder::_bindLightData(RendererPass *pRendererPass)
+    {
+        //light data buffer.
+        if (m_lightingEnable && m_lightTypeCount > 0)
+        {
+            vg::PassBufferInfo::BufferInfo itemInfo = {
+                m_pCurrLightDataBuffer,
+                0u,
+                m_pCurrLightDataBuffer->getBufferSize(),
+            };
+            PassBufferInfo info = {
+                1u,
+                &itemInfo,
+                VG_PASS_LIGHT_DATA_BUFFER_BINDING_PRIORITY,
+                vg::BufferDescriptorType::UNIFORM_BUFFER,
+                vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
+            };
+            if (pRendererPass->getBindingSet().hasBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME) == VG_FALSE)
+            {
+                pRendererPass->getBindingSet().addBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME, info);
+            }
+            else
+            {
+                pRendererPass->getBindingSet().setBuffer(VG_PASS_LIGHT_DATA_BUFFER_NAME, info);
+            }
+            //light textures.
+            auto &lightPassTextureInfos = m_lightPassTextureInfos;
+            uint32_t textureInfoCount = static_cast<uint32_t>(lightPassTextureInfos.size());
+            for (uint32_t textureInfoIndex = 0u; textureInfoIndex < textureInfoCount; ++textureInfoIndex)
+            {
+                std::string name = VG_PASS_LIGHT_TEXTURE_NAME + std::to_string(textureInfoIndex);
+                if (pRendererPass->getBindingSet().hasTexture(name) == VG_FALSE) 
+                {
+                    pRendererPass->getBindingSet().addTexture(name, lightPassTextureInfos[textureInfoIndex]);
+                }
+                else
+                {
+                    pRendererPass->getBindingSet().setTexture(name, lightPassTextureInfos[textureInfoIndex]);
+                }
+            }
+        }
+    }
+
     void RenderBinder::_bindVisualObject(const BaseLight *pLight
         , Bool32 isPreDepth
+        , Bool32 isDeferred
         , const BaseVisualObject *pVisublObject
         , BaseVisualObject::BindInfo & bindInfo
         , BaseVisualObject::BindResult *pResult
@@ -1295,6 +1677,17 @@ namespace vg
             m_bindedObjectsForPreDepth[m_bindedObjectCountForPreDepth] = pVisublObject;
             ++m_bindedObjectCountForPreDepth;
 
+        } else if (isDeferred)
+        {
+            pVisublObject->beginBindForDeferred(bindInfo, pResult);
+            if (static_cast<uint32_t>(m_bindedObjectsForDeferred.size()) == m_bindedObjectCountForDeferred) {
+                auto newSize = getNextCapacity(static_cast<uint32_t>(m_bindedObjectsForDeferred.size()));
+                m_bindedObjectsForDeferred.resize(newSize);
+            }
+    
+            m_bindedObjectsForDeferred[m_bindedObjectCountForDeferred] = pVisublObject;
+            ++m_bindedObjectCountForDeferred;
+
         } else {
             pVisublObject->beginBind(bindInfo, pResult);
             if (static_cast<uint32_t>(m_bindedObjects.size()) == m_bindedObjectCount) {
@@ -1312,12 +1705,10 @@ namespace vg
         , const vk::RenderPass *pRenderPass
         , const vk::Framebuffer *pFramebuffer
         , CmdBuffer *pCmdBuffer
+        , const fd::Rect2D *pRenderArea
         )
     {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer renderPassBeginCostTimer(fd::CostTimer::TimerType::ONCE);
-        renderPassBeginCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_ZONE("RenderBinder::renderPassBegin");
 
         const auto framebufferWidth = pRenderTarget->getFramebufferWidth();
         const auto framebufferHeight = pRenderTarget->getFramebufferHeight();
@@ -1326,37 +1717,22 @@ namespace vg
         beginInfo.pFramebuffer = pFramebuffer;
         beginInfo.framebufferWidth = framebufferWidth;
         beginInfo.framebufferHeight = framebufferHeight;
-        beginInfo.renderArea = pRenderTarget->getRenderArea();
+        beginInfo.renderArea = pRenderArea != nullptr ? *pRenderArea : pRenderTarget->getRenderArea();
         beginInfo.clearValueCount = pRenderTarget->getClearValueCount();
         beginInfo.pClearValues = pRenderTarget->getClearValues();
 
         CmdInfo cmdInfo;
         cmdInfo.pRenderPassBeginInfo = &beginInfo;
         pCmdBuffer->addCmd(cmdInfo);
-
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        renderPassBeginCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Render pass begin cost time: " 
-                << renderPassBeginCostTimer.costTimer << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
     }
 
     void RenderBinder::_renderPassEnd(CmdBuffer *pCmdBuffer)
     {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer renderPassEndCostTimer(fd::CostTimer::TimerType::ONCE);
-        renderPassEndCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_ZONE("RenderBinder::renderPassEnd");
 
         RenderPassEndInfo endInfo;
         CmdInfo cmdInfo;
         cmdInfo.pRenderPassEndInfo = &endInfo;
         pCmdBuffer->addCmd(cmdInfo);
-
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        renderPassEndCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Render pass end cost time: " 
-                << renderPassEndCostTimer.costTimer << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
     }
 } //vg
\ No newline at end of file
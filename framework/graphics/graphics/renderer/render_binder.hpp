@@ -11,9 +11,12 @@
 #include "graphics/render_target/render_target.hpp"
 #include "graphics/render_target/pre_depth_target.hpp"
 #include "graphics/render_target/post_render_target.hpp"
+#include "graphics/render_target/deferred_target.hpp"
 #include "graphics/util/frame_object_cache.hpp"
 #include "graphics/renderer/renderer_pass.hpp"
 #include "graphics/renderer/object_data_cache.hpp"
+#include "graphics/renderer/sprite_batcher.hpp"
+#include "graphics/light/light_shadow_atlas.hpp"
 
 namespace vg
 {
@@ -25,21 +28,31 @@ namespace vg
         Bool32 shadowEnable;
         Bool32 preDepthEnable;
         Bool32 postRenderEnable;
+        Bool32 deferredEnable;
+        //Consecutive sprites of 2D scenes are merged into batches, it isn't used with pre-depth.
+        Bool32 spriteBatchEnable;
 
         Bool32 firstScene;
         const BaseScene *pScene;
         const BaseProjector *pProjector;
         const PostRender *pPostRender;
+        const Material *pDeferredCompositionMaterial;
 
         const PreDepthTarget *pPreDepthTarget;
         const PostRenderTarget *pPostRenderTarget;
+        const DeferredTarget *pDeferredTarget;
         const MultiRenderTarget *pRendererTarget;
 
         const Texture *pPreDepthResultTex;
         const Texture *pPostRenderTex;
+        const Texture *pDeferredColorTex;
+        const Texture *pDeferredDepthTex;
+        //Count of them is G-buffer count of the deferred target.
+        const Texture * const *pDeferredGBufferTexs;
 
         CmdBuffer *pLightDepthCmdBuffer;
         CmdBuffer *pPreDepthCmdBuffer;
+        CmdBuffer *pDeferredCmdBuffer;
         CmdBuffer *pBranchCmdBuffer;
         CmdBuffer *pTrunkWaitBarrierCmdBuffer;
         CmdBuffer *pTrunkRenderPassCmdBuffer;
@@ -50,21 +63,29 @@ namespace vg
             , Bool32 shadowEnable = VG_FALSE
             , Bool32 preDepthEnable = VG_FALSE
             , Bool32 postRenderEnable = VG_FALSE
+            , Bool32 deferredEnable = VG_FALSE
+            , Bool32 spriteBatchEnable = VG_FALSE
 
             , Bool32 firstScene = VG_TRUE
             , const BaseScene *pScene = nullptr
             , const BaseProjector *pProjector = nullptr
             , const PostRender *pPostRender = nullptr
+            , const Material *pDeferredCompositionMaterial = nullptr
     
             , const PreDepthTarget *pPreDepthTarget = nullptr
             , const PostRenderTarget *pPostRenderTarget = nullptr
+            , const DeferredTarget *pDeferredTarget = nullptr
             , const MultiRenderTarget *pRendererTarget = nullptr
 
             , const Texture *pPreDepthResultTex = nullptr
             , const Texture *pPostRenderTex = nullptr
+            , const Texture *pDeferredColorTex = nullptr
+            , const Texture *pDeferredDepthTex = nullptr
+            , const Texture * const *pDeferredGBufferTexs = nullptr
 
             , CmdBuffer *pLightDepthCmdBuffer = nullptr
             , CmdBuffer *pPreDepthCmdBuffer = nullptr
+            , CmdBuffer *pDeferredCmdBuffer = nullptr
             , CmdBuffer *pBranchCmdBuffer = nullptr
             , CmdBuffer *pTrunkWaitBarrierCmdBuffer = nullptr
             , CmdBuffer *pTrunkRenderPassCmdBuffer = nullptr
@@ -91,20 +112,61 @@ namespace vg
         uint32_t m_bindedObjectCountForLighting;
         std::vector<const BaseVisualObject *> m_bindedObjectsForPreDepth;
         uint32_t m_bindedObjectCountForPreDepth;
+        std::vector<const BaseVisualObject *> m_bindedObjectsForDeferred;
+        uint32_t m_bindedObjectCountForDeferred;
         std::vector<const BaseVisualObject *> m_bindedObjects;
         uint32_t m_bindedObjectCount;
 
         RendererObjectDataCache m_objectDataCache;
 
+        Bool32 m_spriteBatchEnable;
+        SpriteBatcher m_spriteBatcher;
+
+        /*Light data of a scene is kept between frames, only data of changed lights is copied to the buffer,
+          and registered light types are sorted again only when they are registered or unregistered.*/
+        struct _LightDataBlock
+        {
+            BufferData buffer;
+            BaseScene::RegisteredLightStateID registeredLightStateID;
+            std::vector<const std::type_info *> sortedLights;
+            std::vector<Byte> memory;
+
+            _LightDataBlock();
+        };
+
         //light data buffer.
         Bool32 m_lightingEnable;
         Bool32 m_shadowEnable;
-        FrameObjectCache<InstanceID, std::shared_ptr<BufferData>> m_lightDataBufferCache;
+        FrameObjectCache<InstanceID, std::shared_ptr<_LightDataBlock>> m_lightDataBlockCache;
         BufferData *m_pCurrLightDataBuffer;
         uint32_t m_lightTypeCount;
         std::vector<PassTextureInfo> m_lightPassTextureInfos;
         std::vector<std::vector<PassTextureInfo::TextureInfo>> m_lightTextureInfos;
 
+        //Tile of a shadow atlas should be rendered again.
+        struct _ShadowTileInfo
+        {
+            const BaseLight *pLight;
+            const Projector<SpaceType::SPACE_3> *pProjector;
+            uint64_t casterHash;
+        };
+        //Shadow atlases of the frame and changed tiles of them, changed tiles of an atlas are kept for reusing.
+        std::vector<LightShadowAtlas *> m_shadowAtlases;
+        std::vector<std::vector<_ShadowTileInfo>> m_changedShadowTiles;
+
+        //Objects with deferred materials are drawn in the render pass of the deferred target.
+        struct _DeferredInfo
+        {
+            const DeferredTarget *pTarget;
+            const Texture *pColorTex;
+            const Texture *pDepthTex;
+            const Texture * const *pGBufferTexs;
+            const Material *pCompositionMaterial;
+            CmdBuffer *pCmdBuffer;
+        };
+        //Binding names of G-buffer textures, they are built when G-buffer count grows instead of every frame.
+        std::vector<std::string> m_deferredGBufferTextureNames;
+
         void _beginBind();
 
         void _bind(RenderBinderInfo info);
@@ -115,6 +177,19 @@ namespace vg
             , const Projector<SpaceType::SPACE_3> *pProjector
             , CmdBuffer *pPreDepthCmdBuffer = nullptr);
 
+        /*Changed tiles are rendered in a render pass clearing the whole atlas when all tiles are changed,
+          otherwise every changed tile is rendered in a render pass only clearing the tile.*/
+        void _bindForShadowAtlas(const Scene<SpaceType::SPACE_3> *pScene
+            , LightShadowAtlas *pShadowAtlas
+            , const std::vector<_ShadowTileInfo> &changedTiles
+            , CmdBuffer *pPreDepthCmdBuffer
+            );
+
+        //Hash of the projector and casters in it, shadow of the projector isn't changed when it is same.
+        uint64_t _caculateCasterHash(const Scene<SpaceType::SPACE_3> *pScene
+            , const Projector<SpaceType::SPACE_3> *pProjector
+            ) const;
+
         void _syncLightData(const BaseScene *pScene);
 
         void _bindForRenderPassBegin(RenderBinderInfo info);
@@ -143,10 +218,23 @@ namespace vg
             , CmdBuffer *pBranchCmdBuffer = nullptr
             , CmdBuffer *pTrunkWaitBarrierCmdBuffer = nullptr
             , CmdBuffer *pTrunkRenderPassCmdBuffer = nullptr
+            , const fd::Viewport &viewport = fd::Viewport()
+            , const _DeferredInfo *pDeferredInfo = nullptr
+            );
+
+        /*Result of the deferred target is drawn first in the trunk render pass, its depth is written too,
+          so objects drawn forward are tested with deferred objects.*/
+        void _bindForDeferredResult(const _DeferredInfo *pDeferredInfo
+            , const BaseRenderTarget *pRenderTarget
+            , CmdBuffer *pTrunkRenderPassCmdBuffer
             );
+
+        //Composition is drawn once in the second subpass after all objects have filled the G-buffer.
+        void _bindForDeferredComposition(const _DeferredInfo *pDeferredInfo);
             
         void _setBuildInData(const BaseLight *pLight
             , Bool32 isPreDepth
+            , Bool32 isDeferred
             , const BaseVisualObject * pVisualObject
             , Matrix4x4 modelMatrix
             , Matrix4x4 viewMatrix
@@ -155,8 +243,11 @@ namespace vg
             , Vector4 viewerPos
         );
 
+        void _bindLightData(RendererPass *pRendererPass);
+
         void _bindVisualObject(const BaseLight *pLight
             , Bool32 isPreDepth
+            , Bool32 isDeferred
             , const BaseVisualObject *pVisublObject
             , BaseVisualObject::BindInfo & bindInfo
             , BaseVisualObject::BindResult *pResult
@@ -166,6 +257,7 @@ namespace vg
             , const vk::RenderPass *pRenderPass
             , const vk::Framebuffer *pFramebuffer
             , CmdBuffer *pCmdBuffer
+            , const fd::Rect2D *pRenderArea = nullptr
             );
         void _renderPassEnd(CmdBuffer *pCmdBuffer);
     };
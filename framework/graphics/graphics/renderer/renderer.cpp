@@ -4,6 +4,7 @@
 #include "graphics/buffer_data/util.hpp"
 #include "graphics/util/gemo_util.hpp"
 #include "graphics/renderer/cmd_parser.hpp"
+#include "graphics/material/material_default.hpp"
 
 #define USE_WORLD_BOUNDS
 
@@ -42,9 +43,13 @@ namespace vg
 
     Renderer::RenderResultInfo::RenderResultInfo(Bool32 isRendered
         , uint32_t drawCount
+        , uint32_t gpuSectionCount
+        , const GPUTimer::SectionResult *pGPUSections
         )
         : isRendered(isRendered)
         , drawCount(drawCount)
+        , gpuSectionCount(gpuSectionCount)
+        , pGPUSections(pGPUSections)
     {
 
     }
@@ -72,10 +77,19 @@ namespace vg
         , m_postRenderEnable(VG_FALSE)
         , m_pPostRenderTarget()
         , m_pPostRenderCmdbuffer()
-
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        , m_preparingRenderCostTimer(fd::CostTimer::TimerType::AVERAGE)
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        //deferred
+        , m_deferredEnable(VG_FALSE)
+        , m_pDeferredCompositionMaterial(nullptr)
+        , m_pDeferredTarget()
+        , m_pDeferredCmdBuffer()
+        , m_deferredGBufferTexs()
+        //sprite batch
+        , m_spriteBatchEnable(VG_FALSE)
+        //gpu timer
+        , m_gpuTimerEnable(VG_FALSE)
+        , m_pGPUTimer()
+        //frame capture
+        , m_pFrameCapture(nullptr)
     {
         setRendererTarget(pRendererTarget);
         _createCommandPool();
@@ -197,6 +211,77 @@ namespace vg
         }
     }
 
+    void Renderer::enableDeferred()
+    {
+        if (m_deferredEnable == VG_FALSE)
+        {
+            m_deferredEnable = VG_TRUE;
+            if (m_framebufferWidth != 0u && m_framebufferHeight != 0u)
+            {
+                _createDeferredObjs();
+            }
+        }
+    }
+
+    void Renderer::disableDeferred()
+    {
+        if (m_deferredEnable == VG_TRUE)
+        {
+            m_deferredEnable = VG_FALSE;
+            _destroyDeferredObjs();
+        }
+    }
+
+    const Material *Renderer::getDeferredCompositionMaterial() const
+    {
+        return m_pDeferredCompositionMaterial;
+    }
+
+    void Renderer::setDeferredCompositionMaterial(const Material *pMaterial)
+    {
+        m_pDeferredCompositionMaterial = pMaterial;
+    }
+
+    void Renderer::enableSpriteBatch()
+    {
+        m_spriteBatchEnable = VG_TRUE;
+    }
+
+    void Renderer::disableSpriteBatch()
+    {
+        m_spriteBatchEnable = VG_FALSE;
+    }
+
+    void Renderer::enableGPUTimer()
+    {
+        if (m_gpuTimerEnable == VG_FALSE)
+        {
+            m_gpuTimerEnable = VG_TRUE;
+            m_pGPUTimer = std::shared_ptr<GPUTimer>{
+                new GPUTimer{}
+            };
+        }
+    }
+
+    void Renderer::disableGPUTimer()
+    {
+        if (m_gpuTimerEnable == VG_TRUE)
+        {
+            m_gpuTimerEnable = VG_FALSE;
+            m_pGPUTimer = nullptr;
+        }
+    }
+
+    GPUTimer *Renderer::getGPUTimer() const
+    {
+        return m_pGPUTimer.get();
+    }
+
+    void Renderer::captureNextFrame(FrameCapture *pCapture)
+    {
+        m_pFrameCapture = pCapture;
+    }
+
     Bool32 Renderer::isValidForRender() const
     {
         return _isValidForRender();
@@ -205,6 +290,7 @@ namespace vg
     void Renderer::render(const RenderInfo &info, 
         RenderResultInfo &resultInfo)
     {
+        FD_PROFILE_ZONE("Renderer::render");
         _preRender();
         _renderBegin(info, resultInfo);
         _render(info, resultInfo);
@@ -226,13 +312,6 @@ namespace vg
     //     return oldFun;
     // }
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-    const fd::CostTimer &Renderer::getPreparingRenderCostTimer() const
-    {
-        return m_preparingRenderCostTimer;
-    }
-#endif //DEBUG and VG_ENABLE_COST_TIMER
-
     Bool32 Renderer::_isValidForRender() const
     {
         return VG_TRUE;
@@ -264,6 +343,17 @@ namespace vg
                 _destroyPostRenderObjs();
             }
         }
+        if (m_deferredEnable)
+        {
+            if (width != 0u && height != 0u)
+            {
+                _createDeferredObjs();
+            }
+            else
+            {
+                _destroyDeferredObjs();
+            }
+        }
     }
 
     void Renderer::_preRender()
@@ -272,12 +362,7 @@ namespace vg
 
     void Renderer::_renderBegin(const RenderInfo & info, RenderResultInfo & resultInfo)
     {
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        m_preparingRenderCostTimer.begin();
-
-        fd::CostTimer renderBeginCostTimer(fd::CostTimer::TimerType::ONCE);
-        renderBeginCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_ZONE("Renderer::renderBegin");
         m_pipelineCache.begin();
         m_rendererPassCache.begin();
         m_renderBinder.begin();
@@ -288,22 +373,25 @@ namespace vg
             const auto pScene = sceneInfo.pScene;
             pScene->beginRender();
         }
-
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        renderBeginCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Render begin cost time: "
-            << renderBeginCostTimer.costTimer
-            << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
     }
 
     void Renderer::_render(const RenderInfo &info
             , RenderResultInfo &resultInfo)
     {
         resultInfo.drawCount = 0u;
+        resultInfo.gpuSectionCount = 0u;
+        resultInfo.pGPUSections = nullptr;
+
+        //Temporary arrays of last frame are never used again.
+        fd::getDefaultFrameArena().reset();
+        if (m_pFrameCapture != nullptr) m_pFrameCapture->clear();
 
         //command buffer begin
         _recordCommandBufferForBegin();
+        if (m_pGPUTimer != nullptr)
+        {
+            m_pGPUTimer->beginFrame(m_pCommandBuffer.get());
+        }
 
         uint32_t count = info.sceneInfoCount;
         for (uint32_t i = 0; i < count; ++i)
@@ -313,18 +401,24 @@ namespace vg
             _renderScene(sceneInfo, i == 0, resultInfo);
         }
 
+        if (m_pGPUTimer != nullptr)
+        {
+            m_pGPUTimer->endFrame();
+            const auto &gpuSections = m_pGPUTimer->getResults();
+            resultInfo.gpuSectionCount = static_cast<uint32_t>(gpuSections.size());
+            resultInfo.pGPUSections = gpuSections.data();
+        }
+
         //command buffer end
         _recordCommandBufferForEnd();
+        m_pFrameCapture = nullptr;
 
     }
 
     void Renderer::_renderEnd(const RenderInfo & info, RenderResultInfo & resultInfo)
     {
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer renderEndCostTimer(fd::CostTimer::TimerType::ONCE);
-        renderEndCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER    
+        FD_PROFILE_ZONE("Renderer::renderEnd");
 
         /*auto pDevice = pApp->getDevice();
         pDevice->waitForFences(*m_waitFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
@@ -363,15 +457,7 @@ namespace vg
         m_renderBinder.end();
         m_rendererPassCache.end();
         m_pipelineCache.end();
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        renderEndCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Render end cost time: " 
-                << renderEndCostTimer.costTimer 
-                << std::endl;
 
-        m_preparingRenderCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Average cost time of preparing render: " << m_preparingRenderCostTimer.costTimer << "ms." << std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
     }
 
     void Renderer::_postRender()
@@ -389,13 +475,13 @@ namespace vg
         Bool32 postRenderEnable = m_postRenderEnable == VG_TRUE && 
             sceneInfo.pPostRender != nullptr &&
             sceneInfo.pPostRender->isValidBindToRender() == VG_TRUE;
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer bindSceneCostTimer(fd::CostTimer::TimerType::ONCE);
-        fd::CostTimer recordSceneCostTimer(fd::CostTimer::TimerType::ONCE);
-        fd::CostTimer preparingSceneCostTimer(fd::CostTimer::TimerType::ONCE);
-        bindSceneCostTimer.begin();
-        preparingSceneCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        Bool32 deferredEnable = m_deferredEnable == VG_TRUE && 
+            m_pDeferredTarget != nullptr &&
+            pScene->getSpaceType() == SpaceType::SPACE_3;
+        Bool32 spriteBatchEnable = m_spriteBatchEnable == VG_TRUE &&
+            pScene->getSpaceType() == SpaceType::SPACE_2;
+        FD_PROFILE_ZONE("Renderer::renderScene");
+        FD_PROFILE_BEGIN("Renderer::bindScene");
         if (lightingEnable)
         {
             m_pLightDepthCmdBuffer->begin();
@@ -404,6 +490,10 @@ namespace vg
         {
             m_pPreDepthCmdBuffer->begin();
         }
+        if (deferredEnable)
+        {
+            m_pDeferredCmdBuffer->begin();
+        }
         m_branchCmdBuffer.begin();
         m_trunkWaitBarrierCmdBuffer.begin();                        
         m_trunkRenderPassCmdBuffer.begin();
@@ -412,27 +502,42 @@ namespace vg
             m_pPostRenderCmdbuffer->begin();
         }
 
+        const Material *pDeferredCompositionMaterial = nullptr;
+        if (deferredEnable)
+        {
+            pDeferredCompositionMaterial = m_pDeferredCompositionMaterial != nullptr ? 
+                m_pDeferredCompositionMaterial : pDefaultDeferredCompositionMaterial.get();
+        }
+
         RenderBinderInfo bindInfo = {
             &m_rendererPassCache,
             lightingEnable,
             shadowEnable,
             preDepthEnable,
             postRenderEnable,
+            deferredEnable,
+            spriteBatchEnable,
 
             isFirstScene,
             pScene,
             pCamera->getProjectorBase(),
             postRenderEnable ? pPostRender : nullptr,
+            pDeferredCompositionMaterial,
 
             preDepthEnable ? m_pPreDepthTarget.get() : nullptr,
             postRenderEnable ? m_pPostRenderTarget.get() : nullptr,
+            deferredEnable ? m_pDeferredTarget.get() : nullptr,
             m_pRendererTarget,
 
             preDepthEnable ? m_pPreDepthTarget->getDepthTargetTexture() : nullptr,
             postRenderEnable ? m_pPostRenderTarget->getColorTargetTexture() : nullptr,
+            deferredEnable ? m_pDeferredTarget->getColorTargetTexture() : nullptr,
+            deferredEnable ? m_pDeferredTarget->getDepthTargetTexture() : nullptr,
+            deferredEnable ? m_deferredGBufferTexs.data() : nullptr,
 
             lightingEnable && shadowEnable ? m_pLightDepthCmdBuffer.get() : nullptr,
             preDepthEnable ? m_pPreDepthCmdBuffer.get() : nullptr,
+            deferredEnable ? m_pDeferredCmdBuffer.get() : nullptr,
             &m_branchCmdBuffer,
             &m_trunkWaitBarrierCmdBuffer,
             &m_trunkRenderPassCmdBuffer,
@@ -441,10 +546,20 @@ namespace vg
 
         m_renderBinder.bind(bindInfo);
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        bindSceneCostTimer.end();
-        recordSceneCostTimer.begin();
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        //Cmd buffers are captured in order of recording.
+        if (m_pFrameCapture != nullptr)
+        {
+            if (lightingEnable && shadowEnable) m_pFrameCapture->capture("light depth", m_pLightDepthCmdBuffer.get());
+            if (preDepthEnable) m_pFrameCapture->capture("pre depth", m_pPreDepthCmdBuffer.get());
+            if (deferredEnable) m_pFrameCapture->capture("deferred", m_pDeferredCmdBuffer.get());
+            m_pFrameCapture->capture("branch", &m_branchCmdBuffer);
+            m_pFrameCapture->capture("trunk wait barrier", &m_trunkWaitBarrierCmdBuffer, FrameCapture::CmdBufferType::TRUNK_WAIT_BARRIER);
+            m_pFrameCapture->capture("trunk", &m_trunkRenderPassCmdBuffer);
+            if (postRenderEnable) m_pFrameCapture->capture("post render", m_pPostRenderCmdbuffer.get());
+        }
+
+        FD_PROFILE_END();
+        FD_PROFILE_BEGIN("Renderer::recordScene");
 
         CMDParser::ResultInfo cmdParseResult;
          
@@ -457,6 +572,8 @@ namespace vg
                 , &m_pipelineCache
                 , &m_rendererPassCache
                 , &cmdParseResult
+                , m_pGPUTimer.get()
+                , "light depth"
             );
             resultInfo.drawCount += cmdParseResult.drawCount;
         }
@@ -468,6 +585,21 @@ namespace vg
                 , &m_pipelineCache
                 , &m_rendererPassCache
                 , &cmdParseResult
+                , m_pGPUTimer.get()
+                , "pre depth"
+                );
+            resultInfo.drawCount += cmdParseResult.drawCount;
+        }
+        //deferred, its result is sampled by the trunk render pass.
+        if (deferredEnable)
+        {
+            CMDParser::record(m_pDeferredCmdBuffer.get()
+                , m_pCommandBuffer.get()
+                , &m_pipelineCache
+                , &m_rendererPassCache
+                , &cmdParseResult
+                , m_pGPUTimer.get()
+                , "deferred"
                 );
             resultInfo.drawCount += cmdParseResult.drawCount;
         }
@@ -476,7 +608,9 @@ namespace vg
             m_pCommandBuffer.get(),
             &m_pipelineCache,
             &m_rendererPassCache,
-            &cmdParseResult
+            &cmdParseResult,
+            m_pGPUTimer.get(),
+            "branch"
             );
         resultInfo.drawCount += cmdParseResult.drawCount;
         //trunk wait barrier
@@ -488,6 +622,8 @@ namespace vg
             , &m_pipelineCache
             , &m_rendererPassCache
             , &cmdParseResult
+            , m_pGPUTimer.get()
+            , "trunk"
             );
         resultInfo.drawCount += cmdParseResult.drawCount;
         //post render record
@@ -498,6 +634,8 @@ namespace vg
                 , &m_pipelineCache
                 , &m_rendererPassCache
                 , &cmdParseResult
+                , m_pGPUTimer.get()
+                , "post render"
                 );
             resultInfo.drawCount += cmdParseResult.drawCount;
         }
@@ -510,6 +648,10 @@ namespace vg
         {
             m_pPreDepthCmdBuffer->end();
         }
+        if (deferredEnable)
+        {
+            m_pDeferredCmdBuffer->end();
+        }
         m_trunkRenderPassCmdBuffer.end();
         m_trunkWaitBarrierCmdBuffer.end();
         m_branchCmdBuffer.end();
@@ -518,25 +660,7 @@ namespace vg
             m_pPostRenderCmdbuffer->end();
         }
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        recordSceneCostTimer.end();
-        preparingSceneCostTimer.end();
-        VG_COST_TIME_LOG(plog::debug) << "Bind scene cost time: " 
-            << bindSceneCostTimer.costTimer 
-            << "ms, scene id: " << pScene->getID() 
-            << ", scene type: " << (pScene->getSpaceType() == SpaceType::SPACE_3 ? "space3" : "space2") 
-            <<  std::endl;
-        VG_COST_TIME_LOG(plog::debug) << "Record scene cost time: " 
-            << recordSceneCostTimer.costTimer 
-            << "ms, scene id: " << pScene->getID() 
-            << ", scene type: " << (pScene->getSpaceType() == SpaceType::SPACE_3 ? "space3" : "space2") 
-            <<  std::endl;
-        VG_COST_TIME_LOG(plog::debug) << "Preparing scene cost time: " 
-            << preparingSceneCostTimer.costTimer 
-            << "ms, scene id: " << pScene->getID() 
-            << ", scene type: " << (pScene->getSpaceType() == SpaceType::SPACE_3 ? "space3" : "space2") 
-            <<  std::endl;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
+        FD_PROFILE_END();
     }
 
     void Renderer::_recordCommandBufferForBegin()
@@ -646,4 +770,30 @@ namespace vg
         m_pPostRenderCmdbuffer = nullptr;
     }
 
+    void Renderer::_createDeferredObjs()
+    {
+        m_pDeferredTarget = std::shared_ptr<RendererDeferredTarget>{
+            new RendererDeferredTarget{
+                m_framebufferWidth,
+                m_framebufferHeight,
+            }
+        };
+        m_pDeferredCmdBuffer = std::shared_ptr<CmdBuffer>{
+            new CmdBuffer{}
+        };
+        uint32_t gbufferCount = m_pDeferredTarget->getGBufferCount();
+        m_deferredGBufferTexs.resize(gbufferCount);
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            m_deferredGBufferTexs[i] = m_pDeferredTarget->getGBufferTexture(i);
+        }
+    }
+
+    void Renderer::_destroyDeferredObjs()
+    {
+        m_pDeferredTarget = nullptr;
+        m_pDeferredCmdBuffer = nullptr;
+        m_deferredGBufferTexs.clear();
+    }
+
 }
\ No newline at end of file
@@ -14,10 +14,12 @@
 #include "graphics/post_render/post_render.hpp"
 #include "graphics/renderer/renderer_pre_depth_target.hpp"
 #include "graphics/renderer/renderer_post_render_target.hpp"
+#include "graphics/renderer/renderer_deferred_target.hpp"
 #include "graphics/renderer/render_binder.hpp"
 #include "graphics/renderer/renderer_pass.hpp"
+#include "graphics/renderer/gpu_timer.hpp"
+#include "graphics/renderer/frame_capture.hpp"
 
-//todo: batch mesh,
 //todo: cache graphics pipeline.
 
 namespace vg
@@ -59,9 +61,16 @@ namespace vg
         struct RenderResultInfo {
             Bool32 isRendered;
             uint32_t drawCount;
+            /*Gpu time of cmd buffers of a frame rendered frame count of gpu timer frames ago, they are
+              valid until next rendering and empty when gpu timer is disabled.*/
+            uint32_t gpuSectionCount;
+            const GPUTimer::SectionResult *pGPUSections;
 
             RenderResultInfo(Bool32 isRendered = VG_FALSE
-                , uint32_t drawCount = 0u);
+                , uint32_t drawCount = 0u
+                , uint32_t gpuSectionCount = 0u
+                , const GPUTimer::SectionResult *pGPUSections = nullptr
+                );
         };
 
         Renderer(const RendererTarget * pRendererTarget = nullptr);
@@ -82,15 +91,36 @@ namespace vg
         void enablePostRender();
         void disablePostRender();
 
+        /*Objects with deferred materials of 3D scenes write the shared G-buffer, the composition material
+          lights them in the second subpass, then the result is copied into the trunk with its depth.
+          Other objects are still rendered forward.*/
+        void enableDeferred();
+        void disableDeferred();
+        const Material *getDeferredCompositionMaterial() const;
+        //The default composition material is used when it is nullptr.
+        void setDeferredCompositionMaterial(const Material *pMaterial);
+
+        /*Consecutive sprites of 2D scenes are merged into one draw when they share pass and clip rect,
+          see SpriteBatcher for objects which are sprites. It isn't used by scenes with pre-depth.*/
+        void enableSpriteBatch();
+        void disableSpriteBatch();
+
+        //Timestamps are written around cmd buffers of every scene, such as light depth, pre depth and trunk.
+        void enableGPUTimer();
+        void disableGPUTimer();
+        //It is nullptr when gpu timer is disabled, options of statistics and render passes are set by it.
+        GPUTimer *getGPUTimer() const;
+
+        /*Cmd buffers of all scenes of next rendered frame are copied into the capture after binding, it is
+          cleared first. The capture can be replayed without updating and binding scenes.*/
+        void captureNextFrame(FrameCapture *pCapture);
+
         Bool32 isValidForRender() const;
 
         // void renderBegin();
         void render(const RenderInfo &info, RenderResultInfo &resultInfo);
         // void renderEnd(const RenderInfo &info);
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        const fd::CostTimer &getPreparingRenderCostTimer() const;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
     protected:
         uint32_t m_framebufferWidth;
         uint32_t m_framebufferHeight;
@@ -119,14 +149,29 @@ namespace vg
         Bool32 m_postRenderEnable;
         std::shared_ptr<RendererPostRenderTarget> m_pPostRenderTarget;
         std::shared_ptr<CmdBuffer> m_pPostRenderCmdbuffer;
+
+        //deferred
+        Bool32 m_deferredEnable;
+        const Material *m_pDeferredCompositionMaterial;
+        std::shared_ptr<RendererDeferredTarget> m_pDeferredTarget;
+        std::shared_ptr<CmdBuffer> m_pDeferredCmdBuffer;
+        //G-buffer textures of the deferred target for binding, they are filled when the target is created.
+        std::vector<const Texture *> m_deferredGBufferTexs;
+
+        //sprite batch
+        Bool32 m_spriteBatchEnable;
+
+        //gpu timer
+        Bool32 m_gpuTimerEnable;
+        std::shared_ptr<GPUTimer> m_pGPUTimer;
+
+        //frame capture, it is only kept until next frame is rendered.
+        FrameCapture *m_pFrameCapture;
         
         CmdBuffer m_trunkRenderPassCmdBuffer;
         CmdBuffer m_trunkWaitBarrierCmdBuffer;
         CmdBuffer m_branchCmdBuffer;
 
-#if defined(DEBUG) && defined(VG_ENABLE_COST_TIMER)
-        fd::CostTimer m_preparingRenderCostTimer;
-#endif //DEBUG and VG_ENABLE_COST_TIMER
 
         void _resetFramebufferSize(uint32_t width, uint32_t height);
 
@@ -154,6 +199,8 @@ namespace vg
         void _destroyPreDepthObjs();
         void _createPostRenderObjs();
         void _destroyPostRenderObjs();
+        void _createDeferredObjs();
+        void _destroyDeferredObjs();
 
     private:
     };
@@ -0,0 +1,244 @@
+#include "graphics/renderer/renderer_deferred_target.hpp"
+
+namespace vg
+{
+    RendererDeferredTarget::RendererDeferredTarget(uint32_t framebufferWidth
+        , uint32_t framebufferHeight
+        , vk::Format colorImageFormat
+        , vk::Format depthImageFormat
+        , uint32_t gbufferCount
+        , const vk::Format *pGBufferFormats
+        )
+        : DeferredTarget(framebufferWidth
+            , framebufferHeight
+            , colorImageFormat
+            , depthImageFormat
+            , gbufferCount
+            , pGBufferFormats
+            )
+        , m_pColorTargetTex()
+        , m_pDepthTargetTex()
+        , m_pGBufferTexs()
+        , m_pMyRenderPass()
+        , m_pMyFramebuffer()
+    {
+        _createObjs();
+    }
+
+    const Texture2DColorAttachment *RendererDeferredTarget::getColorTargetTexture() const
+    {
+        return m_pColorTargetTex.get();
+    }
+
+    const Texture2DDepthAttachment *RendererDeferredTarget::getDepthTargetTexture() const
+    {
+        return m_pDepthTargetTex.get();
+    }
+
+    const TextureColorAttachment *RendererDeferredTarget::getGBufferTexture(uint32_t index) const
+    {
+        return m_pGBufferTexs[index].get();
+    }
+
+    void RendererDeferredTarget::_createObjs()
+    {
+        auto pDevice = pApp->getDevice();
+        const auto framebufferWidth = m_framebufferWidth;
+        const auto framebufferHeight = m_framebufferHeight;
+        const auto gbufferCount = getGBufferCount();
+        //color attachment
+        auto pColorTex = new Texture2DColorAttachment(
+            m_colorImageFormat,
+            framebufferWidth,
+            framebufferHeight
+            );
+        m_pColorTargetTex = std::shared_ptr<Texture2DColorAttachment>(pColorTex);
+        m_pColorAttachment = m_pColorTargetTex->getImageView()->getImageView();
+
+        //G-buffer attachments
+        m_pGBufferTexs.resize(gbufferCount);
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            auto pGBufferTex = new TextureColorAttachment(
+                m_gbufferFormats[i],
+                framebufferWidth,
+                framebufferHeight,
+                VG_TRUE,
+                vk::ImageUsageFlagBits::eTransientAttachment
+                );
+            m_pGBufferTexs[i] = std::shared_ptr<TextureColorAttachment>(pGBufferTex);
+            m_pGBufferAttachments[i] = m_pGBufferTexs[i]->getImageView()->getImageView();
+        }
+
+        //depth attachment
+        auto pDepthTex = new Texture2DDepthAttachment(
+            m_depthImageFormat,
+            framebufferWidth,
+            framebufferHeight
+            );
+        m_pDepthTargetTex = std::shared_ptr<Texture2DDepthAttachment>(pDepthTex);
+        m_pDepthAttachment = m_pDepthTargetTex->getImageView()->getImageView();
+
+        //render pass.
+        uint32_t attachmentCount = gbufferCount + 2u;
+        uint32_t depthAttachmentIndex = gbufferCount + 1u;
+        std::vector<vk::AttachmentDescription> attachmentDess(attachmentCount);
+        attachmentDess[0] = {
+            vk::AttachmentDescriptionFlags(),
+            m_colorImageFormat,
+            vk::SampleCountFlagBits::e1,
+            vk::AttachmentLoadOp::eClear,
+            vk::AttachmentStoreOp::eStore,
+            vk::AttachmentLoadOp::eDontCare,
+            vk::AttachmentStoreOp::eDontCare,
+            vk::ImageLayout::eUndefined,
+            m_pColorTargetTex->getImage()->getInfo().layout,
+        };
+        //G-buffer is discarded at the end of the render pass.
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            attachmentDess[i + 1u] = {
+                vk::AttachmentDescriptionFlags(),
+                m_gbufferFormats[i],
+                vk::SampleCountFlagBits::e1,
+                vk::AttachmentLoadOp::eClear,
+                vk::AttachmentStoreOp::eDontCare,
+                vk::AttachmentLoadOp::eDontCare,
+                vk::AttachmentStoreOp::eDontCare,
+                vk::ImageLayout::eUndefined,
+                vk::ImageLayout::eColorAttachmentOptimal,
+            };
+        }
+        attachmentDess[depthAttachmentIndex] = {
+            vk::AttachmentDescriptionFlags(),
+            m_depthImageFormat,
+            vk::SampleCountFlagBits::e1,
+            vk::AttachmentLoadOp::eClear,
+            vk::AttachmentStoreOp::eStore,
+            vk::AttachmentLoadOp::eDontCare,
+            vk::AttachmentStoreOp::eDontCare,
+            vk::ImageLayout::eUndefined,
+            vk::ImageLayout::eDepthStencilReadOnlyOptimal,
+        };
+
+        //first subpass: fill G-buffer.
+        std::vector<vk::AttachmentReference> gbufferAttachmentRefs(gbufferCount);
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            gbufferAttachmentRefs[i] = {i + 1u, vk::ImageLayout::eColorAttachmentOptimal};
+        }
+        vk::AttachmentReference depthAttachmentRef = {
+            depthAttachmentIndex,
+            vk::ImageLayout::eDepthStencilAttachmentOptimal
+        };
+
+        //second subpass: composition with G-buffer.
+        std::vector<vk::AttachmentReference> inputAttachmentRefs(gbufferCount);
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            inputAttachmentRefs[i] = {i + 1u, vk::ImageLayout::eShaderReadOnlyOptimal};
+        }
+        vk::AttachmentReference colorAttachmentRef = {
+            uint32_t(0),
+            vk::ImageLayout::eColorAttachmentOptimal
+        };
+
+        std::array<vk::SubpassDescription, 2> subpasses = {
+            vk::SubpassDescription
+            {
+                vk::SubpassDescriptionFlags(),       //flags
+                vk::PipelineBindPoint::eGraphics,    //pipelineBindPoint
+                0,                                   //inputAttachmentCount
+                nullptr,                             //pInputAttachments
+                gbufferCount,                        //colorAttachmentCount
+                gbufferAttachmentRefs.data(),        //pColorAttachments
+                nullptr,                             //pResolveAttachments
+                &depthAttachmentRef,                 //pDepthStencilAttachment
+                0,                                   //preserveAttachmentCount
+                nullptr                              //pPreserveAttachments
+            },
+            vk::SubpassDescription
+            {
+                vk::SubpassDescriptionFlags(),       //flags
+                vk::PipelineBindPoint::eGraphics,    //pipelineBindPoint
+                gbufferCount,                        //inputAttachmentCount
+                inputAttachmentRefs.data(),          //pInputAttachments
+                1u,                                  //colorAttachmentCount
+                &colorAttachmentRef,                 //pColorAttachments
+                nullptr,                             //pResolveAttachments
+                nullptr,                             //pDepthStencilAttachment
+                0,                                   //preserveAttachmentCount
+                nullptr                              //pPreserveAttachments
+            },
+        };
+
+        //Color and depth are sampled by the trunk render pass after this render pass.
+        std::array<vk::SubpassDependency, 3> dependencies = {
+            vk::SubpassDependency
+            {
+                VK_SUBPASS_EXTERNAL,
+                GBUFFER_SUBPASS_INDEX,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+                vk::AccessFlagBits::eShaderRead,
+                vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+                vk::DependencyFlagBits::eByRegion
+            },
+            vk::SubpassDependency
+            {
+                GBUFFER_SUBPASS_INDEX,
+                COMPOSITION_SUBPASS_INDEX,
+                vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::AccessFlagBits::eColorAttachmentWrite,
+                vk::AccessFlagBits::eInputAttachmentRead,
+                vk::DependencyFlagBits::eByRegion
+            },
+            vk::SubpassDependency
+            {
+                COMPOSITION_SUBPASS_INDEX,
+                VK_SUBPASS_EXTERNAL,
+                vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eLateFragmentTests,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+                vk::AccessFlagBits::eShaderRead,
+                vk::DependencyFlags()
+            },
+        };
+
+        vk::RenderPassCreateInfo renderPassCreateInfo = {
+            vk::RenderPassCreateFlags(),
+            static_cast<uint32_t>(attachmentDess.size()),
+            attachmentDess.data(),
+            static_cast<uint32_t>(subpasses.size()),
+            subpasses.data(),
+            static_cast<uint32_t>(dependencies.size()),
+            dependencies.data()
+        };
+
+        m_pMyRenderPass = fd::createRenderPass(pDevice, renderPassCreateInfo);
+        m_pRenderPass = m_pMyRenderPass.get();
+
+        //frame buffer.
+        std::vector<vk::ImageView> attachments(attachmentCount);
+        attachments[0] = *m_pColorAttachment;
+        for (uint32_t i = 0u; i < gbufferCount; ++i)
+        {
+            attachments[i + 1u] = *m_pGBufferAttachments[i];
+        }
+        attachments[depthAttachmentIndex] = *m_pDepthAttachment;
+
+        vk::FramebufferCreateInfo frameBufferCreateInfo = {
+            vk::FramebufferCreateFlags(),
+            *m_pRenderPass,
+            static_cast<uint32_t>(attachments.size()),
+            attachments.data(),
+            framebufferWidth,
+            framebufferHeight,
+            1u,
+        };
+
+        m_pMyFramebuffer = fd::createFrameBuffer(pDevice, frameBufferCreateInfo);
+        m_pFramebuffer = m_pMyFramebuffer.get();
+    }
+} //vg
@@ -0,0 +1,37 @@
+#ifndef VG_RENDERER_DEFERRED_TARGET_HPP
+#define VG_RENDERER_DEFERRED_TARGET_HPP
+
+#include "graphics/global.hpp"
+#include "graphics/texture/texture_2d.hpp"
+#include "graphics/texture/texture_color_attachment.hpp"
+#include "graphics/render_target/deferred_target.hpp"
+
+namespace vg
+{
+    /*The G-buffer is only read in the render pass, so it isn't stored and is created with transient
+      attachment usage, it can stay in tile memory when lazily allocated memory is supported.
+      Color and depth are stored to be copied to the trunk render target.*/
+    class RendererDeferredTarget : public DeferredTarget
+    {
+    public:
+        RendererDeferredTarget(uint32_t framebufferWidth = 0u
+            , uint32_t framebufferHeight = 0u
+            , vk::Format colorImageFormat = DEFAULT_COLOR_FORMAT
+            , vk::Format depthImageFormat = DEFAULT_DEPTH_FORMAT
+            , uint32_t gbufferCount = DEFAULT_GBUFFER_COUNT
+            , const vk::Format *pGBufferFormats = DEFAULT_GBUFFER_FORMATS
+            );
+        const Texture2DColorAttachment *getColorTargetTexture() const;
+        const Texture2DDepthAttachment *getDepthTargetTexture() const;
+        const TextureColorAttachment *getGBufferTexture(uint32_t index) const;
+    private:
+        std::shared_ptr<Texture2DColorAttachment> m_pColorTargetTex;
+        std::shared_ptr<Texture2DDepthAttachment> m_pDepthTargetTex;
+        std::vector<std::shared_ptr<TextureColorAttachment>> m_pGBufferTexs;
+        std::shared_ptr<vk::RenderPass> m_pMyRenderPass;
+        std::shared_ptr<vk::Framebuffer> m_pMyFramebuffer;
+        void _createObjs();
+    };
+} //vg
+
+#endif //VG_RENDERER_DEFERRED_TARGET_HPP
@@ -313,7 +313,6 @@ namespace vg
 
     RendererPassCache::RendererPassCache()
         : m_mapPasses()
-        , m_mapPassesBack()
     {
 
     }
@@ -325,33 +324,36 @@ namespace vg
 
     void RendererPassCache::begin()
     {
-        m_mapPassesBack = m_mapPasses;
-        m_mapPasses.clear();
+        for (auto &pair : m_mapPasses)
+        {
+            pair.second.isUsed = VG_FALSE;
+        }
     }
 
     RendererPass *RendererPassCache::get(const Pass *pPass, InstanceID objectID)
     {
-        RendererPass * pCurr;
-        auto key = std::to_string(pPass->getID()) + "_" + std::to_string(objectID);
-        if (m_mapPasses[key] != nullptr) {
-            pCurr = m_mapPasses[key].get();
-        } else if (m_mapPassesBack[key] != nullptr) {
-            m_mapPasses[key] = m_mapPassesBack[key];
-            m_mapPassesBack.erase(key);
-            pCurr = m_mapPasses[key].get();
+        //Key of ids doesn't allocate memory as key of string does, it is computed in every draw.
+        uint64_t key = (static_cast<uint64_t>(pPass->getID()) << 32u) | static_cast<uint64_t>(objectID);
+        auto iterator = m_mapPasses.find(key);
+        if (iterator != m_mapPasses.end()) {
+            iterator->second.isUsed = VG_TRUE;
+            return iterator->second.pRendererPass.get();
         } else {
             auto pNew = _createNewRendererPass(pPass);
-            m_mapPasses[key] = pNew;
-            pCurr = pNew.get();
+            _Item item = {pNew, VG_TRUE};
+            m_mapPasses[key] = item;
+            return pNew.get();
         }
-
-        return pCurr;
     }
 
     void RendererPassCache::end()
     {
         //Delete useless renderer passes.
-        m_mapPassesBack.clear();
+        for (auto iterator = m_mapPasses.begin(); iterator != m_mapPasses.end();)
+        {
+            if (iterator->second.isUsed == VG_FALSE) iterator = m_mapPasses.erase(iterator);
+            else ++iterator;
+        }
     }
 
     std::shared_ptr<RendererPass> RendererPassCache::_createNewRendererPass(const Pass *pPass)
@@ -10,6 +10,9 @@
 #define VG_PASS_LIGHT_DATA_BUFFER_NAME "_light_data_buffer"
 #define VG_PASS_LIGHT_TEXTURE_NAME "_light_texture"
 #define VG_PASS_LIGHT_RENDER_DATA_NAME "_light_render_data"
+#define VG_PASS_DEFERRED_COLOR_TEXTURE_NAME "_deferred_color_tex"
+#define VG_PASS_DEFERRED_DEPTH_TEXTURE_NAME "_deferred_depth_tex"
+#define VG_PASS_DEFERRED_GBUFFER_TEXTURE_NAME "_deferred_gbuffer_tex"
 
 #define VG_PASS_BUILDIN_DATA_LAYOUT_PRIORITY 0
 #define VG_PASS_LIGHT_RENDER_DATA_LAYOUT_PRIORITY 1
@@ -18,7 +21,11 @@
 #define VG_PASS_PRE_DEPTH_TEXTURE_BINDING_PRIORITY 0
 #define VG_PASS_POST_RENDER_TEXTURE_BINDING_PRIORITY 1
 #define VG_PASS_LIGHT_DATA_BUFFER_BINDING_PRIORITY 2
+//Light textures use priorities from it, so other build in bindings are put after them.
 #define VG_PASS_LIGHT_TEXTURE_MIN_BINDING_PRIORITY 3
+#define VG_PASS_DEFERRED_COLOR_TEXTURE_BINDING_PRIORITY 50
+#define VG_PASS_DEFERRED_DEPTH_TEXTURE_BINDING_PRIORITY 51
+#define VG_PASS_DEFERRED_GBUFFER_MIN_BINDING_PRIORITY 52
 #define VG_PASS_OTHER_MIN_BINDING_PRIORITY 100
 
 namespace vg
@@ -155,8 +162,8 @@ namespace vg
         ~RendererPassCache();
 
         /**
-         * When frame begin, It is called to move cache to back and make cache
-         * to empty. After rendering process, we will pick useful pipeline from back.
+         * When frame begin, It is called to mark all cached renderer passes as unused,
+         * renderer passes got in rendering process are marked as used again.
          **/
         void begin();
 
@@ -171,9 +178,13 @@ namespace vg
         void end();
 
     private:
-        //Map between pass and renderer pass, key is instance ID of pass.
-        std::unordered_map<std::string, std::shared_ptr<RendererPass>> m_mapPasses;
-        std::unordered_map<std::string, std::shared_ptr<RendererPass>> m_mapPassesBack;
+        struct _Item
+        {
+            std::shared_ptr<RendererPass> pRendererPass;
+            Bool32 isUsed;
+        };
+        //Map between pass and renderer pass, key is made of instance IDs of pass and object.
+        std::unordered_map<uint64_t, _Item> m_mapPasses;
         std::shared_ptr<RendererPass> _createNewRendererPass(const Pass *pPass);
     };
 } //vg
@@ -0,0 +1,191 @@
+#include "graphics/renderer/sprite_batcher.hpp"
+
+#include <typeinfo>
+#include "graphics/mesh/mesh.hpp"
+#include "graphics/material/material.hpp"
+
+namespace vg
+{
+    SpriteBatcher::Batch::Batch()
+        : pFirstSprite(nullptr)
+        , pPass(nullptr)
+        , spriteCount(0u)
+        , hasClipRect(VG_FALSE)
+        , clipRect()
+        , geometryBinding()
+        , cmdDrawIndexed()
+    {
+
+    }
+
+    SpriteBatcher::SpriteBatcher()
+        : m_sprites()
+        , m_pPass(nullptr)
+        , m_pVertexInputStateInfo(nullptr)
+        , m_hasClipRect(VG_FALSE)
+        , m_clipRect()
+        , m_vertexCount(0u)
+        , m_indexCount(0u)
+    {
+
+    }
+
+    Bool32 SpriteBatcher::isSprite(const VisualObject<SpaceType::SPACE_2> *pVisualObject) const
+    {
+        auto pContentMesh = dynamic_cast<const ContentMesh *>(pVisualObject->getMesh());
+        if (pContentMesh == nullptr) return VG_FALSE;
+        //Sub mesh 0 is required because cmd parser adds offsets of sub datas before it to offsets of the geometry binding.
+        if (pVisualObject->getSubMeshCount() != 1u || pVisualObject->getSubMeshOffset() != 0u) return VG_FALSE;
+        if (pVisualObject->getMaterialCount() != 1u) return VG_FALSE;
+
+        //Materials overriding binding may add cmds of their own, so only default materials are merged.
+        auto pMaterial = pVisualObject->getMaterial();
+        if (typeid(*pMaterial) != typeid(Material) || pMaterial->getPassCount() != 1u) return VG_FALSE;
+        if (pMaterial->getPassWithIndex(0u)->getInstanceCount() != 1u) return VG_FALSE;
+
+        auto pVertexData = pContentMesh->getVertexData();
+        auto pIndexData = pContentMesh->getIndexData();
+        if (pVertexData == nullptr || pIndexData == nullptr) return VG_FALSE;
+        if (pVertexData->getBufferData().getMemory() == nullptr || pIndexData->getBufferData().getMemory() == nullptr) return VG_FALSE;
+        if (pVertexData->getSubVertexDataCount() == 0u || pIndexData->getSubIndexDataCount() == 0u) return VG_FALSE;
+
+        const auto &subIndexData = *(pIndexData->getSubIndexDatas());
+        if (subIndexData.indexType != vk::IndexType::eUint32 ||
+            subIndexData.inputAssemblyStateInfo.topology != vk::PrimitiveTopology::eTriangleList ||
+            subIndexData.vertexDataIndex != 0u) return VG_FALSE;
+
+        const auto &subVertexData = *(pVertexData->getSubVertexDatas());
+        const auto &stateInfo = subVertexData.vertexInputStateInfo;
+        if (stateInfo.vertexBindingDescriptionCount != 1u) return VG_FALSE;
+        if (subVertexData.pBindingBufferOffsets != nullptr && *(subVertexData.pBindingBufferOffsets) != 0u) return VG_FALSE;
+        for (uint32_t i = 0; i < stateInfo.vertexAttributeDescriptionCount; ++i)
+        {
+            const auto &attrDesc = *(stateInfo.pVertexAttributeDescriptions + i);
+            //Position has the highest binding priority, so it is at location 0.
+            if (attrDesc.location == 0u) return attrDesc.format == vk::Format::eR32G32Sfloat ? VG_TRUE : VG_FALSE;
+        }
+        return VG_FALSE;
+    }
+
+    Bool32 SpriteBatcher::canAdd(const VisualObject<SpaceType::SPACE_2> *pSprite
+        , Bool32 hasClipRect
+        , const fd::Rect2D &clipRect
+        ) const
+    {
+        if (m_sprites.size() == 0u) return VG_TRUE;
+        if (pSprite->getMaterial()->getPassWithIndex(0u) != m_pPass) return VG_FALSE;
+        if (hasClipRect != m_hasClipRect || (hasClipRect == VG_TRUE && clipRect != m_clipRect)) return VG_FALSE;
+        auto pContentMesh = dynamic_cast<const ContentMesh *>(pSprite->getMesh());
+        const auto &stateInfo = pContentMesh->getVertexData()->getSubVertexDatas()->vertexInputStateInfo;
+        return _isSameLayout(stateInfo, *m_pVertexInputStateInfo);
+    }
+
+    void SpriteBatcher::add(const VisualObject<SpaceType::SPACE_2> *pSprite
+        , Bool32 hasClipRect
+        , const fd::Rect2D &clipRect
+        )
+    {
+        auto pContentMesh = dynamic_cast<const ContentMesh *>(pSprite->getMesh());
+        const auto &subVertexData = *(pContentMesh->getVertexData()->getSubVertexDatas());
+        const auto &subIndexData = *(pContentMesh->getIndexData()->getSubIndexDatas());
+        if (m_sprites.size() == 0u)
+        {
+            m_pPass = pSprite->getMaterial()->getPassWithIndex(0u);
+            m_pVertexInputStateInfo = &subVertexData.vertexInputStateInfo;
+            m_hasClipRect = hasClipRect;
+            m_clipRect = clipRect;
+        }
+        m_sprites.push_back(pSprite);
+        m_vertexCount += subVertexData.vertexCount;
+        m_indexCount += subIndexData.indexCount;
+    }
+
+    uint32_t SpriteBatcher::getSpriteCount() const
+    {
+        return static_cast<uint32_t>(m_sprites.size());
+    }
+
+    const VisualObject<SpaceType::SPACE_2> *SpriteBatcher::getSprite(uint32_t index) const
+    {
+        return m_sprites[index];
+    }
+
+    void SpriteBatcher::flush(TransientBuffer *pTransientBuffer, Batch *pBatch)
+    {
+        FD_PROFILE_ZONE("SpriteBatcher::flush");
+        const auto &stateInfo = *m_pVertexInputStateInfo;
+        uint32_t stride = stateInfo.pVertexBindingDescriptions->stride;
+        uint32_t positionOffset = 0u;
+        for (uint32_t i = 0; i < stateInfo.vertexAttributeDescriptionCount; ++i)
+        {
+            const auto &attrDesc = *(stateInfo.pVertexAttributeDescriptions + i);
+            if (attrDesc.location == 0u) positionOffset = attrDesc.offset;
+        }
+
+        auto vertexAllocation = pTransientBuffer->allocate(m_vertexCount * stride);
+        auto indexAllocation = pTransientBuffer->allocate(m_indexCount * static_cast<uint32_t>(sizeof(uint32_t)));
+        auto pVertices = static_cast<uint8_t *>(vertexAllocation.pMemory);
+        auto pIndices = static_cast<uint32_t *>(indexAllocation.pMemory);
+        uint32_t vertexOffset = 0u;
+        uint32_t indexOffset = 0u;
+        for (const auto &pSprite : m_sprites)
+        {
+            auto pContentMesh = dynamic_cast<const ContentMesh *>(pSprite->getMesh());
+            auto pVertexData = pContentMesh->getVertexData();
+            auto pIndexData = pContentMesh->getIndexData();
+            uint32_t vertexCount = pVertexData->getSubVertexDatas()->vertexCount;
+            uint32_t indexCount = pIndexData->getSubIndexDatas()->indexCount;
+            fd::transformVertices2(pVertexData->getBufferData().getMemory()
+                , pVertices + static_cast<size_t>(vertexOffset) * stride
+                , vertexCount
+                , stride
+                , positionOffset
+                , pSprite->getTransform()->getMatrixLocalToWorld()
+                );
+            fd::offsetIndices(static_cast<const uint32_t *>(pIndexData->getBufferData().getMemory())
+                , pIndices + indexOffset
+                , indexCount
+                , vertexOffset
+                );
+            vertexOffset += vertexCount;
+            indexOffset += indexCount;
+        }
+
+        auto &batch = *pBatch;
+        batch.pFirstSprite = m_sprites[0];
+        batch.pPass = m_pPass;
+        batch.spriteCount = static_cast<uint32_t>(m_sprites.size());
+        batch.hasClipRect = m_hasClipRect;
+        batch.clipRect = m_clipRect;
+        batch.geometryBinding = CmdGeometryBinding(vertexAllocation.pBuffer, vertexAllocation.offset
+            , indexAllocation.pBuffer, indexAllocation.offset);
+        batch.cmdDrawIndexed = CmdDrawIndexed(m_indexCount, 1u, 0u, 0u, 0u);
+        clear();
+    }
+
+    void SpriteBatcher::clear()
+    {
+        m_sprites.clear();
+        m_pPass = nullptr;
+        m_pVertexInputStateInfo = nullptr;
+        m_hasClipRect = VG_FALSE;
+        m_clipRect = fd::Rect2D();
+        m_vertexCount = 0u;
+        m_indexCount = 0u;
+    }
+
+    Bool32 SpriteBatcher::_isSameLayout(const vk::PipelineVertexInputStateCreateInfo &stateInfo1
+        , const vk::PipelineVertexInputStateCreateInfo &stateInfo2
+        )
+    {
+        if (&stateInfo1 == &stateInfo2) return VG_TRUE;
+        if (stateInfo1.pVertexBindingDescriptions->stride != stateInfo2.pVertexBindingDescriptions->stride) return VG_FALSE;
+        if (stateInfo1.vertexAttributeDescriptionCount != stateInfo2.vertexAttributeDescriptionCount) return VG_FALSE;
+        uint32_t count = stateInfo1.vertexAttributeDescriptionCount;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (*(stateInfo1.pVertexAttributeDescriptions + i) != *(stateInfo2.pVertexAttributeDescriptions + i)) return VG_FALSE;
+        }
+        return VG_TRUE;
+    }
+} //vg
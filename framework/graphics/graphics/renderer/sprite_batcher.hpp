@@ -0,0 +1,67 @@
+#ifndef VG_SPRITE_BATCHER_HPP
+#define VG_SPRITE_BATCHER_HPP
+
+#include <vector>
+#include "graphics/global.hpp"
+#include "graphics/scene/visual_object.hpp"
+#include "graphics/material/cmd.hpp"
+#include "graphics/buffer_data/transient_buffer.hpp"
+
+namespace vg
+{
+    /*Consecutive sprites of a 2D scene are merged into one draw when they have same pass, vertex layout and
+      clip rect, textures are owned by pass so sprites of a batch have same textures too. Vertices of sprites
+      are transformed to world space on CPU and written with their indices into the transient buffer, so the
+      batch is drawn with identity model matrix. A sprite is a visual object with one sub mesh drawn by
+      one pass of a default material, its mesh should have one interleaved vertex binding with 2D position
+      at location 0, 32 bit triangle list indices and host memory cached (SepMesh::setIsCacheMemory).*/
+    class SpriteBatcher
+    {
+    public:
+        struct Batch
+        {
+            //Built-in data and pipeline of the batch are got from renderer pass of the first sprite.
+            const VisualObject<SpaceType::SPACE_2> *pFirstSprite;
+            const Pass *pPass;
+            uint32_t spriteCount;
+            Bool32 hasClipRect;
+            fd::Rect2D clipRect;
+            CmdGeometryBinding geometryBinding;
+            CmdDrawIndexed cmdDrawIndexed;
+
+            Batch();
+        };
+
+        SpriteBatcher();
+        Bool32 isSprite(const VisualObject<SpaceType::SPACE_2> *pVisualObject) const;
+        //It returns false when the sprite can't be merged into pending sprites, they should be flushed first.
+        Bool32 canAdd(const VisualObject<SpaceType::SPACE_2> *pSprite
+            , Bool32 hasClipRect
+            , const fd::Rect2D &clipRect
+            ) const;
+        void add(const VisualObject<SpaceType::SPACE_2> *pSprite
+            , Bool32 hasClipRect
+            , const fd::Rect2D &clipRect
+            );
+        uint32_t getSpriteCount() const;
+        const VisualObject<SpaceType::SPACE_2> *getSprite(uint32_t index) const;
+        //Geometry of pending sprites is written into the transient buffer and pending sprites are cleared.
+        void flush(TransientBuffer *pTransientBuffer, Batch *pBatch);
+        //Pending sprites are cleared without writing geometry, eg. when a single sprite is bound as usual.
+        void clear();
+    private:
+        std::vector<const VisualObject<SpaceType::SPACE_2> *> m_sprites;
+        const Pass *m_pPass;
+        const vk::PipelineVertexInputStateCreateInfo *m_pVertexInputStateInfo;
+        Bool32 m_hasClipRect;
+        fd::Rect2D m_clipRect;
+        uint32_t m_vertexCount;
+        uint32_t m_indexCount;
+
+        static Bool32 _isSameLayout(const vk::PipelineVertexInputStateCreateInfo &stateInfo1
+            , const vk::PipelineVertexInputStateCreateInfo &stateInfo2
+            );
+    };
+} //vg
+
+#endif //VG_SPRITE_BATCHER_HPP
@@ -340,12 +340,14 @@ namespace vg
         , const OnceRenderTarget *const *pDepthTargets
         , const void *pData
         , uint32_t dataSize
+        , LightShadowAtlas *pShadowAtlas
         )
         : renderCount(renderCount)
         , pProjectors(pProjectors)
         , pDepthTargets(pDepthTargets)
         , pData(pData)
         , dataSize(dataSize)
+        , pShadowAtlas(pShadowAtlas)
     {
 
     }
@@ -20,6 +20,8 @@
 
 namespace vg
 {
+    class LightShadowAtlas;
+
     struct LightDataInfo {
         uint32_t layoutPriority;
         LightDataInfo(uint32_t layoutPriority = 0u);
@@ -166,12 +168,15 @@ namespace vg
         const OnceRenderTarget *const *pDepthTargets;
         const void *pData;
         uint32_t dataSize;
+        //Atlas containing the depth target when the light renders to a tile of it.
+        LightShadowAtlas *pShadowAtlas;
 
         LightDepthRenderInfo(uint32_t renderCount = 0u
             , const BaseProjector *const *pProjectors = nullptr
             , const OnceRenderTarget *const *pDepthTargets = nullptr
             , const void *pData = nullptr
             , uint32_t dataSize = 0u
+            , LightShadowAtlas *pShadowAtlas = nullptr
             );
     };
 
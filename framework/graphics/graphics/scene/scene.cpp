@@ -20,6 +20,7 @@ namespace vg
         , m_space()
         , m_arrRegisteredLights()
         , m_mapRegisteredLights()
+        , m_registeredLightStateID(1u)
     {
 
     }
@@ -64,16 +65,21 @@ namespace vg
         return m_mapRegisteredLights.count(lightTypeInfo) != 0;
     }
 
-    const std::vector<const std::type_info *> BaseScene::getArrRegisteredLights() const
+    const std::vector<const std::type_info *> &BaseScene::getArrRegisteredLights() const
     {
         return m_arrRegisteredLights;
     }
 
-    const std::unordered_map<std::type_index, SceneLightRegisterInfo> BaseScene::getMapRegisteredLights() const
+    const std::unordered_map<std::type_index, SceneLightRegisterInfo> &BaseScene::getMapRegisteredLights() const
     {
         return m_mapRegisteredLights;
     }
 
+    BaseScene::RegisteredLightStateID BaseScene::getRegisteredLightStateID() const
+    {
+        return m_registeredLightStateID;
+    }
+
     void BaseScene::registerLight(const std::type_info &lightTypeInfo, const SceneLightRegisterInfo &lightInfo)
     {
         _registerLight(lightTypeInfo, lightInfo);
@@ -112,6 +118,7 @@ namespace vg
             }
             m_arrRegisteredLights.push_back(&lightTypeInfo);
         }
+        _updateRegisteredLightStateID();
     }
     
     void BaseScene::_unregisterLight(const std::type_info &lightTypeInfo)
@@ -119,6 +126,7 @@ namespace vg
         m_mapRegisteredLights.erase(std::type_index(lightTypeInfo));
         auto iterator = std::find(m_arrRegisteredLights.begin(), m_arrRegisteredLights.end(), &lightTypeInfo);
         m_arrRegisteredLights.erase(iterator);
+        _updateRegisteredLightStateID();
     }
 
     void BaseScene::_beginRender() const
@@ -130,6 +138,16 @@ namespace vg
         
     }
 
+    void BaseScene::_updateRegisteredLightStateID()
+    {
+        ++m_registeredLightStateID;
+        //0 is kept for state which hasn't been synchronized.
+        if (m_registeredLightStateID == 0u)
+        {
+            m_registeredLightStateID = 1u;
+        }
+    }
+
 //Scene
     template <SpaceType SPACE_TYPE>
     Scene<SPACE_TYPE>::Scene()
@@ -29,6 +29,7 @@ namespace vg
     class BaseScene : public Base
     {
     public:
+        using RegisteredLightStateID = uint32_t;
         BaseScene();
         SpaceType getSpaceType() const;
         Bool32 getIsRightHand() const;
@@ -38,8 +39,10 @@ namespace vg
         const Space &getSpace() const;
         uint32_t getRegisterLightCount() const;
         Bool32 isHasRegisterLight(const std::type_info &lightTypeInfo) const;
-        const std::vector<const std::type_info *> getArrRegisteredLights() const;
-        const std::unordered_map<std::type_index, SceneLightRegisterInfo> getMapRegisteredLights() const;
+        const std::vector<const std::type_info *> &getArrRegisteredLights() const;
+        const std::unordered_map<std::type_index, SceneLightRegisterInfo> &getMapRegisteredLights() const;
+        //It is changed when a light type is registered or unregistered.
+        RegisteredLightStateID getRegisteredLightStateID() const;
         void registerLight(const std::type_info &lightTypeInfo, const SceneLightRegisterInfo &lightInfo);
         void unregisterLight(const std::type_info &lightTypeInfo);
         virtual uint32_t getLightGroupSize(const std::type_info &lightTypeInfo) const = 0;
@@ -49,11 +52,13 @@ namespace vg
         Space m_space;
         std::vector<const std::type_info *> m_arrRegisteredLights;
         std::unordered_map<std::type_index, SceneLightRegisterInfo> m_mapRegisteredLights;
+        RegisteredLightStateID m_registeredLightStateID;
 
         virtual void _registerLight(const std::type_info &lightTypeInfo, const SceneLightRegisterInfo &lightInfo);
         virtual void _unregisterLight(const std::type_info &lightTypeInfo);
         virtual void _beginRender() const;
         virtual void _endRender() const;
+        void _updateRegisteredLightStateID();
     };
 
     template <SpaceType SPACE_TYPE>
@@ -3,6 +3,7 @@
 #include "graphics/util/gemo_util.hpp"
 #include "graphics/scene/camera_3.hpp"
 #include "graphics/scene/camera_op_3.hpp"
+#include "graphics/scene/visual_object_3.hpp"
 
 namespace vg
 {
@@ -364,6 +365,48 @@ namespace vg
         }
     }
 
+    float Scene3::getProjectedSize(const ProjectorType *pProjector
+        , const TransformType *pTransform
+        , BoundsType bounds) const
+    {
+        auto modelMatrix = pTransform->getMatrixLocalToWorld();
+        auto mvMatrix = pProjector->getWorldToLocalMatrix() * modelMatrix;
+        auto size = bounds.getSize();
+        auto center = bounds.getMin() + size * 0.5f;
+        float maxScale = glm::max(glm::length(Vector3(modelMatrix[0])), 
+            glm::max(glm::length(Vector3(modelMatrix[1])), glm::length(Vector3(modelMatrix[2]))));
+        float radius = glm::length(size) * 0.5f * maxScale;
+        auto centerInProjectorLocal = Vector3(mvMatrix * Vector4(center, 1.0f));
+        Bool32 rightHand = pProjector->getSpace().rightHand;
+        if (pProjector->getOrthographic() == VG_TRUE)
+        {
+            const ProjectorOP3 *pProjectorOP3 = dynamic_cast<const ProjectorOP3 *>(pProjector);
+            auto viewSize = pProjectorOP3->getViewBounds().getSize();
+            float viewHeight = rightHand == VG_TRUE ? viewSize.z : viewSize.y;
+            return viewHeight > 0.0f ? radius * 2.0f / viewHeight : 0.0f;
+        }
+        else
+        {
+            const Projector3 *pProjector3 = dynamic_cast<const Projector3 *>(pProjector);
+            //Depth axis is y when it is right hand.
+            float depth = rightHand == VG_TRUE ? centerInProjectorLocal.y : centerInProjectorLocal.z;
+            if (depth - radius <= pProjector3->getDepthNear()) return std::numeric_limits<float>::max();
+            return radius / (depth * glm::tan(pProjector3->getFov() / 2.0f));
+        }
+    }
+
+    void Scene3::updateLOD(const ProjectorType *pProjector)
+    {
+        for (auto pVisualObject : m_arrPVisualObjects)
+        {
+            VisualObject3 *pVisualObject3 = dynamic_cast<VisualObject3 *>(pVisualObject);
+            if (pVisualObject3 == nullptr || pVisualObject3->getLODScreenSizes().size() == 0u) continue;
+            auto pMesh = dynamic_cast<const VisualObjectType::MeshDimType *>(pVisualObject3->getMesh());
+            if (pMesh == nullptr || pMesh->getIsHasBounds() == VG_FALSE) continue;
+            float screenSize = getProjectedSize(pProjector, pVisualObject3->getTransform(), pMesh->getBounds());
+            pVisualObject3->updateLOD(screenSize);
+        }
+    }
 
     
 } //namespace kgs
\ No newline at end of file
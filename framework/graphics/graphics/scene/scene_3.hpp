@@ -19,6 +19,19 @@ namespace vg
         virtual Bool32 isInProjection(const ProjectorType *pProjector
             , BoundsType bounds
             , fd::Rect2D *projectionRect = nullptr) const override;
+
+        /**
+         * Projected size of the bounds relative to view height of the projector, 
+         * it is diameter of the bounding sphere of the bounds.
+         */
+        float getProjectedSize(const ProjectorType *pProjector
+            , const TransformType *pTransform
+            , BoundsType bounds) const;
+
+        /**
+         * Select LOD levels of visual objects with their projected sizes in the projector.
+         */
+        void updateLOD(const ProjectorType *pProjector);
     };
 
 } //namespace kgs
@@ -8,6 +8,8 @@ namespace vg
         , const Matrix4x4 *pViewMatrix
         , Bool32 hasClipRect
         , std::vector<fd::Rect2D> clipRects
+        , fd::Viewport viewport
+        , Bool32 omniDirectional
         )
         : framebufferWidth(framebufferWidth)
         , framebufferHeight(framebufferHeight)
@@ -15,6 +17,8 @@ namespace vg
         , pViewMatrix(pViewMatrix)
         , hasClipRect(hasClipRect)
         , clipRects(clipRects)
+        , viewport(viewport)
+        , omniDirectional(omniDirectional)
     {
     }
 
@@ -34,10 +38,13 @@ namespace vg
         , m_materialCount(0)
         , m_pMaterials()
         , m_pPreDepthMaterials()
+        , m_pDeferredMaterials()
         , m_mapPLightingMaterials()
         , m_pMesh()
         , m_subMeshOffset(-1)
         , m_subMeshCount(-1)
+        , m_lodLevel(0u)
+        , m_lodSubMeshOffset(0u)
         , m_isVisibilityCheck(VG_TRUE)
     {
 
@@ -59,6 +66,7 @@ namespace vg
             m_materialCount = count;
             m_pMaterials.resize(count);
             m_pPreDepthMaterials.resize(count);
+            m_pDeferredMaterials.resize(count);
             _resizeLightingMaterialMap();
         }
     }
@@ -121,6 +129,46 @@ namespace vg
         }
     }
 
+    const Material *BaseVisualObject::getDeferredMaterial(uint32_t index) const
+    {
+        _checkDeferredMaterialValid(index);
+        return m_pDeferredMaterials[index];
+    }
+        
+    Material *BaseVisualObject::getDeferredMaterial(uint32_t index)
+    {
+        _checkDeferredMaterialValid(index);
+        return m_pDeferredMaterials[index];
+    }
+
+    void BaseVisualObject::setDeferredMaterial(fd::ArrayProxy<Material *> pMaterials, uint32_t offset)
+    {
+        uint32_t count = static_cast<uint32_t>(pMaterials.size());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            m_pDeferredMaterials[offset] = *(pMaterials.data() + i);
+            ++offset;
+        }
+    }
+        
+    void BaseVisualObject::setDeferredMaterial(Material *pMaterial)
+    {
+        for (uint32_t i = 0; i < m_materialCount; ++i) {
+            m_pDeferredMaterials[i] = pMaterial;
+        }
+    }
+
+    Bool32 BaseVisualObject::hasDeferredMaterial() const
+    {
+        uint32_t subMeshCount = getSubMeshCount();
+        if (subMeshCount == 0u || static_cast<uint32_t>(m_pDeferredMaterials.size()) < subMeshCount) return VG_FALSE;
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            if (m_pDeferredMaterials[i] == nullptr) return VG_FALSE;
+        }
+        return VG_TRUE;
+    }
+
     const Material *BaseVisualObject::getLightingMaterial(const std::type_info &lightTypeInfo, uint32_t index) const
     {
         _checkLightingMaterialValid(lightTypeInfo, index);
@@ -175,9 +223,9 @@ namespace vg
     uint32_t BaseVisualObject::getSubMeshOffset() const
     {
         if (m_subMeshOffset < 0) {
-            return dynamic_cast<const ContentMesh *>(m_pMesh)->getSubMeshOffset();
+            return dynamic_cast<const ContentMesh *>(m_pMesh)->getSubMeshOffset() + m_lodSubMeshOffset;
         } else {
-            return m_subMeshOffset;
+            return m_subMeshOffset + m_lodSubMeshOffset;
         }
     }
         
@@ -196,6 +244,17 @@ namespace vg
         m_subMeshCount = static_cast<int32_t>(subMeshCount);
     }
 
+    uint32_t BaseVisualObject::getLODLevel() const
+    {
+        return m_lodLevel;
+    }
+
+    void BaseVisualObject::setLODLevel(uint32_t value)
+    {
+        m_lodLevel = value;
+        _updateLODSubMeshOffset(dynamic_cast<const ContentMesh *>(m_pMesh));
+    }
+
     Bool32 BaseVisualObject::getIsVisibilityCheck() const
     {
         return m_isVisibilityCheck;
@@ -230,6 +289,8 @@ namespace vg
                 subMeshIndex,
                 info.hasClipRect,
                 info.hasClipRect ? *(info.clipRects.data() + i) : fd::Rect2D(),
+                info.viewport,
+                info.omniDirectional,
                 };
     
             Material::BindResult resultForVisualizer;
@@ -263,6 +324,65 @@ namespace vg
         }
     }
 
+    void BaseVisualObject::beginBindForDeferred(const BindInfo info, BindResult *pResult) const
+    {
+        auto &result = *pResult;
+        uint32_t subMeshCount = getSubMeshCount();
+        auto modelMatrix = _getModelMatrix();        
+        uint32_t subMeshOffset = getSubMeshOffset();        
+        uint32_t materialCount = m_materialCount;
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            _checkDeferredMaterialValid(i);
+            
+            auto pMaterial = m_pDeferredMaterials[i];
+            uint32_t subMeshIndex = subMeshOffset + i;
+            Material::BindInfo infoForVisualizer = {
+                info.framebufferWidth,
+                info.framebufferHeight,
+                info.pProjMatrix,
+                info.pViewMatrix,
+                m_id,
+                &modelMatrix,
+                m_pMesh,
+                subMeshIndex,
+                info.hasClipRect,
+                info.hasClipRect ? *(info.clipRects.data() + i) : fd::Rect2D(),
+                info.viewport,
+                info.omniDirectional,
+                };
+    
+            Material::BindResult resultForVisualizer;
+
+            if (result.pBranchCmdBuffer != nullptr)
+                resultForVisualizer.pBranchCmdBuffer = result.pBranchCmdBuffer;
+            if (result.pTrunkRenderPassCmdBuffer != nullptr)
+                resultForVisualizer.pTrunkRenderPassCmdBuffer = result.pTrunkRenderPassCmdBuffer;
+            if (result.pTrunkWaitBarrierCmdBuffer != nullptr)
+                resultForVisualizer.pTrunkWaitBarrierCmdBuffer = result.pTrunkWaitBarrierCmdBuffer;
+            pMaterial->beginBind(infoForVisualizer, &resultForVisualizer);
+        }
+        
+    }
+
+    void BaseVisualObject::endBindForDeferred() const
+    {
+        uint32_t subMeshCount = getSubMeshCount();
+        uint32_t subMeshOffset = getSubMeshOffset();
+        uint32_t materialCount = m_materialCount;    
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            _checkDeferredMaterialValid(i);
+            auto pMaterial = m_pDeferredMaterials[i];
+            uint32_t subMeshIndex = subMeshOffset + i;
+            Material::EndBindInfo info = {
+                m_id,
+                subMeshIndex,
+            };
+            pMaterial->endBind(info);
+        }
+    }
+
     void BaseVisualObject::beginBind(const BindInfo info, BindResult *pResult) const
     {
         auto &result = *pResult;
@@ -287,6 +407,8 @@ namespace vg
                 subMeshIndex,
                 info.hasClipRect,
                 info.hasClipRect ? *(info.clipRects.data() + i) : fd::Rect2D(),
+                info.viewport,
+                info.omniDirectional,
                 };
     
             Material::BindResult resultForVisualizer;
@@ -350,6 +472,8 @@ namespace vg
                 subMeshIndex,
                 info.hasClipRect,
                 info.hasClipRect ? *(info.clipRects.data() + i) : fd::Rect2D(),
+                info.viewport,
+                info.omniDirectional,
                 };
     
             Material::BindResult resultForVisualizer;
@@ -407,6 +531,15 @@ namespace vg
         }
     }
 
+    void BaseVisualObject::_updateLODSubMeshOffset(const ContentMesh *pContentMesh)
+    {
+        m_lodSubMeshOffset = 0u;
+        if (m_lodLevel == 0u || pContentMesh == nullptr) return;
+        uint32_t lodCount = pContentMesh->getLODCount();
+        if (lodCount == 0u) return;
+        m_lodSubMeshOffset = pContentMesh->getLODSubMeshOffset(m_lodLevel < lodCount ? m_lodLevel : lodCount - 1u);
+    }
+
     void BaseVisualObject::_checkPreDepthMaterialValid(uint32_t index) const
     {
         auto &pMaterials = m_pPreDepthMaterials;
@@ -416,6 +549,15 @@ namespace vg
         }
     }
     
+    void BaseVisualObject::_checkDeferredMaterialValid(uint32_t index) const
+    {
+        auto &pMaterials = m_pDeferredMaterials;
+        if (static_cast<uint32_t>(pMaterials.size()) <= index || pMaterials[index] == nullptr)
+        {
+            throw std::runtime_error("The deferred material at index " + std::to_string(index) + " is invalid.");
+        }
+    }
+    
     void BaseVisualObject::_checkLightingMaterialValid(const std::type_info &lightTypeInfo, uint32_t index) const
     {
         size_t count = m_mapPLightingMaterials.count(std::type_index(lightTypeInfo));
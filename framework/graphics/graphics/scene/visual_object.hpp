@@ -21,12 +21,17 @@ namespace vg
             const Matrix4x4 *pViewMatrix;
             Bool32 hasClipRect;
             std::vector<fd::Rect2D> clipRects;
+            fd::Viewport viewport;
+            //It is true when the projection is omni-directional, eg. for point lights.
+            Bool32 omniDirectional;
             BindInfo(uint32_t framebufferWidth = 0u
                 , uint32_t framebufferHeight = 0u
                 , const Matrix4x4 *pProjMatrix = nullptr
                 , const Matrix4x4 *pViewMatrix = nullptr
                 , Bool32 hasClipRect = VG_FALSE
                 , std::vector<fd::Rect2D> clipRects = std::vector<fd::Rect2D>()
+                , fd::Viewport viewport = fd::Viewport()
+                , Bool32 omniDirectional = VG_FALSE
                 );
         };
     
@@ -58,6 +63,14 @@ namespace vg
         void setPreDepthMaterial(fd::ArrayProxy<Material *> pMaterials, uint32_t offset = 0u);
         void setPreDepthMaterial(Material *pMaterial);
 
+        /*Deferred materials write the G-buffer of the deferred target of the renderer, the object is drawn
+          in the shared deferred render pass instead of the trunk when all its sub meshes have them.*/
+        const Material *getDeferredMaterial(uint32_t index = 0u) const;
+        Material *getDeferredMaterial(uint32_t index = 0);
+        void setDeferredMaterial(fd::ArrayProxy<Material *> pMaterials, uint32_t offset = 0u);
+        void setDeferredMaterial(Material *pMaterial);
+        Bool32 hasDeferredMaterial() const;
+
         const Material *getLightingMaterial(const std::type_info &lightTypeInfo, uint32_t index = 0u) const;
         Material *getLightingMaterial(const std::type_info &lightTypeInfo, uint32_t index = 0);
         void setLightingMaterial(const std::type_info &lightTypeInfo, fd::ArrayProxy<Material *> pMaterials, uint32_t offset = 0u);
@@ -71,6 +84,10 @@ namespace vg
 
         virtual void updateSubMeshInfo(uint32_t subMeshOffset, uint32_t subMeshCount);
 
+        /*LOD level of the mesh to draw, it is clamped to the LOD count of the mesh.*/
+        uint32_t getLODLevel() const;
+        void setLODLevel(uint32_t value);
+
         Bool32 getIsVisibilityCheck() const;
         void setIsVisibilityCheck(Bool32 value);
 
@@ -83,6 +100,8 @@ namespace vg
 
         void beginBindForPreDepth(const BindInfo info, BindResult *pResult) const;
         void endBindForPreDepth() const;
+        void beginBindForDeferred(const BindInfo info, BindResult *pResult) const;
+        void endBindForDeferred() const;
         void beginBind(const BindInfo info, BindResult *pResult) const;
         void endBind() const;
         void beginBindForLighting(const std::type_info &lightTypeInfo, const BindInfo info, BindResult *pResult) const;
@@ -92,20 +111,26 @@ namespace vg
         uint32_t m_materialCount;
         std::vector<Material *> m_pMaterials;
         std::vector<Material *> m_pPreDepthMaterials;
+        std::vector<Material *> m_pDeferredMaterials;
         std::unordered_map<std::type_index, std::vector<Material *>> m_mapPLightingMaterials;
 
         BaseMesh *m_pMesh;
         int32_t m_subMeshOffset;
         int32_t m_subMeshCount;
+        uint32_t m_lodLevel;
+        //Sub mesh offset of the LOD level, it is updated with the level so binding doesn't cast the mesh.
+        uint32_t m_lodSubMeshOffset;
         Bool32 m_isVisibilityCheck;
         // Bool32 m_hasClipRect;
         //Valid range of ClipRect is [(0, 0), (1, 1)]
         // std::vector<fd::Rect2D> m_clipRects;
         // void _asyncMeshData();
         void _resizeLightingMaterialMap();
+        void _updateLODSubMeshOffset(const ContentMesh *pContentMesh);
         virtual Matrix4x4 _getModelMatrix() const = 0;
 
         void _checkPreDepthMaterialValid(uint32_t index) const;
+        void _checkDeferredMaterialValid(uint32_t index) const;
         void _checkLightingMaterialValid(const std::type_info &lightTypeInfo, uint32_t index) const;
         void _checkMaterialValid(uint32_t index) const;
     };
@@ -129,6 +154,7 @@ namespace vg
             m_pMesh = pMesh;
             m_subMeshOffset = -1;
             m_subMeshCount = -1;
+            _updateLODSubMeshOffset(dynamic_cast<const ContentMesh *>(m_pMesh));
             //m_clipRects.resize(dynamic_cast<const ContentMesh *>(m_pMesh)->getSubMeshOffset());
         }
 
@@ -139,6 +165,7 @@ namespace vg
             m_pMesh = pMesh;
             m_subMeshOffset = subMeshOffset;
             m_subMeshCount = subMeshCount;
+            _updateLODSubMeshOffset(dynamic_cast<const ContentMesh *>(m_pMesh));
             // m_clipRects.resize(subMeshCount);
         }
     protected:
@@ -4,10 +4,57 @@ namespace vg
 {
     VisualObject3::VisualObject3()
         : VisualObject<SpaceType::SPACE_3>()
+        , m_lodScreenSizes()
+        , m_lodHysteresis(0.1f)
     {
 
     }
 
+    const std::vector<float> &VisualObject3::getLODScreenSizes() const
+    {
+        return m_lodScreenSizes;
+    }
+
+    void VisualObject3::setLODScreenSizes(const std::vector<float> &value)
+    {
+        m_lodScreenSizes = value;
+    }
+
+    float VisualObject3::getLODHysteresis() const
+    {
+        return m_lodHysteresis;
+    }
+
+    void VisualObject3::setLODHysteresis(float value)
+    {
+        m_lodHysteresis = value;
+    }
+
+    uint32_t VisualObject3::updateLOD(float screenSize)
+    {
+        //Coarser level is selected only if size is less than the lower edge of the band, 
+        //and finer level is selected only if size is more than the upper edge of the band.
+        uint32_t minLevel = 0u;
+        uint32_t maxLevel = 0u;
+        for (const auto &lodScreenSize : m_lodScreenSizes)
+        {
+            if (screenSize < lodScreenSize * (1.0f - m_lodHysteresis)) ++minLevel;
+            if (screenSize < lodScreenSize * (1.0f + m_lodHysteresis)) ++maxLevel;
+        }
+        uint32_t level = m_lodLevel;
+        if (level < minLevel) level = minLevel;
+        if (level > maxLevel) level = maxLevel;
+        const ContentMesh *pContentMesh = dynamic_cast<const ContentMesh *>(m_pMesh);
+        if (pContentMesh != nullptr)
+        {
+            uint32_t lodCount = pContentMesh->getLODCount();
+            if (lodCount != 0u && level >= lodCount) level = lodCount - 1u;
+        }
+        m_lodLevel = level;
+        _updateLODSubMeshOffset(pContentMesh);
+        return level;
+    }
+
     Matrix4x4 VisualObject3::_getModelMatrix() const
     {
         return m_pTransform->getMatrixLocalToWorld();
@@ -18,7 +18,28 @@ namespace vg
 
         }
 
+        /**
+         * LOD level i + 1 is used when projected screen size of the object is less than lodScreenSizes[i],
+         * screen size is diameter of bounding sphere of the mesh relative to view height, sizes should be descending.
+         */
+        const std::vector<float> &getLODScreenSizes() const;
+        void setLODScreenSizes(const std::vector<float> &value);
+
+        /**
+         * Relative band around every screen size of LOD in which the current level is kept to avoid popping.
+         */
+        float getLODHysteresis() const;
+        void setLODHysteresis(float value);
+
+        /**
+         * Select LOD level with projected screen size, return the selected level.
+         */
+        uint32_t updateLOD(float screenSize);
+
         virtual Matrix4x4 _getModelMatrix() const override;
+    protected:
+        std::vector<float> m_lodScreenSizes;
+        float m_lodHysteresis;
     };
 
 } //namespace kgs
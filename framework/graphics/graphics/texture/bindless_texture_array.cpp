@@ -0,0 +1,90 @@
+#include "graphics/texture/bindless_texture_array.hpp"
+
+namespace vg
+{
+    BindlessTextureArray::BindlessTextureArray(SamplerTextureType textureType
+        , uint32_t capacity
+        )
+        : m_textureType(textureType)
+        , m_textureInfos(capacity)
+        , m_mapIndices()
+        , m_freeIndices(capacity)
+    {
+#ifdef DEBUG
+        const auto &limits = pApp->getPhysicalDevice()->getProperties().limits;
+        if (capacity > std::min(limits.maxPerStageDescriptorSampledImages, limits.maxPerStageDescriptorSamplers))
+            throw std::runtime_error("Capacity of the bindless texture array is greater than the limits of the device.");
+#endif //DEBUG
+        //Lower indices are used first.
+        for (uint32_t i = 0u; i < capacity; ++i)
+        {
+            m_freeIndices[i] = capacity - 1u - i;
+        }
+    }
+
+    uint32_t BindlessTextureArray::getCapacity() const
+    {
+        return static_cast<uint32_t>(m_textureInfos.size());
+    }
+
+    uint32_t BindlessTextureArray::getTextureCount() const
+    {
+        return static_cast<uint32_t>(m_mapIndices.size());
+    }
+
+    uint32_t BindlessTextureArray::addTexture(const Texture *pTexture
+        , const Texture::ImageView *pImageView
+        , const Texture::Sampler *pSampler
+        )
+    {
+        _SlotKey key = std::make_tuple(pTexture, pImageView, pSampler);
+        auto iterator = m_mapIndices.find(key);
+        if (iterator != m_mapIndices.end()) return iterator->second;
+        if (m_freeIndices.size() == 0u)
+            throw std::runtime_error("The bindless texture array is full.");
+        uint32_t index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+        m_textureInfos[index] = PassTextureInfo::TextureInfo(pTexture, pImageView, pSampler);
+        m_mapIndices[key] = index;
+        return index;
+    }
+
+    void BindlessTextureArray::removeTexture(uint32_t index)
+    {
+        auto &info = m_textureInfos[index];
+        if (info.pTexture == nullptr) return;
+        m_mapIndices.erase(std::make_tuple(info.pTexture, info.pImageView, info.pSampler));
+        info = PassTextureInfo::TextureInfo();
+        m_freeIndices.push_back(index);
+    }
+
+    PassTextureInfo BindlessTextureArray::getTextureInfo(uint32_t bindingPriority
+        , vk::ShaderStageFlags stageFlags
+        ) const
+    {
+        return PassTextureInfo(m_textureType
+            , static_cast<uint32_t>(m_textureInfos.size())
+            , m_textureInfos.data()
+            , bindingPriority
+            , ImageDescriptorType::COMBINED_IMAGE_SAMPLER
+            , stageFlags
+            );
+    }
+
+    void BindlessTextureArray::bindToPass(Pass *pPass
+        , std::string name
+        , uint32_t bindingPriority
+        , vk::ShaderStageFlags stageFlags
+        ) const
+    {
+        auto info = getTextureInfo(bindingPriority, stageFlags);
+        if (pPass->hasTexture(name))
+        {
+            pPass->setTexture(name, info);
+        }
+        else
+        {
+            pPass->addTexture(name, info);
+        }
+    }
+} //namespace vg
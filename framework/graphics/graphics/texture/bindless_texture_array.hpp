@@ -0,0 +1,55 @@
+#ifndef VG_BINDLESS_TEXTURE_ARRAY_H
+#define VG_BINDLESS_TEXTURE_ARRAY_H
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include "graphics/global.hpp"
+#include "graphics/texture/texture.hpp"
+#include "graphics/pass/pass.hpp"
+
+#define VG_BINDLESS_TEXTURE_ARRAY_DEFAULT_CAPACITY 128u
+
+namespace vg
+{
+    /*Bind textures as one array binding with fixed capacity, materials select their textures with indices,
+      eg. from push constants or instance data, so draws with different textures can share one pass.
+      Empty slots are bound with the default texture. Indices in shaders should be dynamically uniform
+      unless the device supports non uniform indexing of sampled image arrays.*/
+    class BindlessTextureArray
+    {
+    public:
+        BindlessTextureArray(SamplerTextureType textureType = SamplerTextureType::TEX_2D
+            , uint32_t capacity = VG_BINDLESS_TEXTURE_ARRAY_DEFAULT_CAPACITY
+            );
+
+        uint32_t getCapacity() const;
+        uint32_t getTextureCount() const;
+        /*Get index of the texture in the array, same texture with same image view and sampler uses same slot,
+          freed slots are reused.*/
+        uint32_t addTexture(const Texture *pTexture
+            , const Texture::ImageView *pImageView = nullptr
+            , const Texture::Sampler *pSampler = nullptr
+            );
+        void removeTexture(uint32_t index);
+        //Binding info of all slots, the textures are referred until the info is added to or set to a pass.
+        PassTextureInfo getTextureInfo(uint32_t bindingPriority
+            , vk::ShaderStageFlags stageFlags = vk::ShaderStageFlagBits::eFragment
+            ) const;
+        //Add the array to the pass or update it, the pass should be applied after it.
+        void bindToPass(Pass *pPass
+            , std::string name
+            , uint32_t bindingPriority
+            , vk::ShaderStageFlags stageFlags = vk::ShaderStageFlagBits::eFragment
+            ) const;
+    private:
+        using _SlotKey = std::tuple<const Texture *, const Texture::ImageView *, const Texture::Sampler *>;
+
+        SamplerTextureType m_textureType;
+        std::vector<PassTextureInfo::TextureInfo> m_textureInfos;
+        std::map<_SlotKey, uint32_t> m_mapIndices;
+        std::vector<uint32_t> m_freeIndices;
+    };
+} //namespace vg
+
+#endif //VG_BINDLESS_TEXTURE_ARRAY_H
@@ -1,5 +1,7 @@
 #include "graphics/texture/texture.hpp"
 
+#include "graphics/texture/texture_format.hpp"
+
 namespace vg
 {
     inline uint32_t caculateImageSizeWithMipmapLevel(uint32_t size, uint32_t mipmapLevel);
@@ -110,9 +112,18 @@ namespace vg
 
         const auto &memRequirements = pDevice->getImageMemoryRequirements(*m_pImage);
 
+        //Transient attachments are only kept in tile memory when lazily allocated memory is supported.
+        vk::MemoryPropertyFlags memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+        if (info.usage & vk::ImageUsageFlagBits::eTransientAttachment)
+        {
+            vk::MemoryPropertyFlags lazilyProperties = memoryProperties | vk::MemoryPropertyFlagBits::eLazilyAllocated;
+            if (vg::hasMemoryType(pApp->getPhysicalDevice(), memRequirements.memoryTypeBits, lazilyProperties))
+                memoryProperties = lazilyProperties;
+        }
+
         vk::MemoryAllocateInfo allocInfo = {
             memRequirements.size,
-            vg::findMemoryType(pApp->getPhysicalDevice(), memRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal)
+            vg::findMemoryType(pApp->getPhysicalDevice(), memRequirements.memoryTypeBits, memoryProperties)
         };
 
         m_pImageMemory = fd::allocateMemory(pDevice, allocInfo);
@@ -353,6 +364,10 @@ namespace vg
         , m_pSampler()
         , m_mapPOtherImageViews()
         , m_mapPOtherSamplers()
+        , m_residentMipLevel(0u)
+        , m_resourceStateID(0u)
+        , m_isGenerateMipmapsOnCPU(VG_FALSE)
+        , m_mipmapGenerateInfo()
     {
 
     }
@@ -488,6 +503,52 @@ namespace vg
         }
     }
 
+    uint32_t Texture::getMipLevels() const
+    {
+        return m_mipLevels;
+    }
+
+    uint32_t Texture::getCachedMipLevelSize(uint32_t mipLevel) const
+    {
+        if (m_pMemory == nullptr) return 0u;
+        uint32_t size = 0u;
+        for (const auto &component : m_components)
+        {
+            if (component.mipLevel == mipLevel) size += component.size;
+        }
+        return size;
+    }
+
+    uint32_t Texture::getResidentMipLevel() const
+    {
+        return m_residentMipLevel;
+    }
+
+    uint32_t Texture::getResourceStateID() const
+    {
+        return m_resourceStateID;
+    }
+
+    Bool32 Texture::getIsGenerateMipmapsOnCPU() const
+    {
+        return m_isGenerateMipmapsOnCPU;
+    }
+
+    void Texture::setIsGenerateMipmapsOnCPU(Bool32 value)
+    {
+        m_isGenerateMipmapsOnCPU = value;
+    }
+
+    const fd::MipmapGenerateInfo &Texture::getMipmapGenerateInfo() const
+    {
+        return m_mipmapGenerateInfo;
+    }
+
+    void Texture::setMipmapGenerateInfo(const fd::MipmapGenerateInfo &info)
+    {
+        m_mipmapGenerateInfo = info;
+    }
+
     void Texture::_init(Bool32 importContent)
     {
         _updateMipMapLevels();
@@ -541,11 +602,11 @@ namespace vg
             vkImageType,
             m_format,
             {
-                m_width,
-                m_height,
-                m_depth
+                caculateImageSizeWithMipmapLevel(m_width, m_residentMipLevel),
+                caculateImageSizeWithMipmapLevel(m_height, m_residentMipLevel),
+                caculateImageSizeWithMipmapLevel(m_depth, m_residentMipLevel)
             },
-            m_mipLevels,
+            m_mipLevels - m_residentMipLevel,
             m_arrayLayers,
             vk::SampleCountFlagBits::e1,
             vk::ImageTiling::eOptimal,
@@ -573,7 +634,7 @@ namespace vg
             {
                 m_allAspectFlags,
                 uint32_t(0),
-                m_mipLevels,
+                m_pImage->getInfo().mipLevels,
                 uint32_t(0),
                 m_arrayLayers,
             },
@@ -612,7 +673,21 @@ namespace vg
         , Bool32 cacheMemory
         , Bool32 createMipmaps)
     {
-        vk::Image image = *(m_pImage->getImage());
+        if (createMipmaps && size && m_mipLevels > 1u && _isMipmapsGeneratedOnCPU())
+        {
+            std::vector<TextureDataInfo::Component> components;
+            std::vector<uint8_t> chainMemory;
+            if (generateMipmapsOnCPU(m_format, m_width, m_height, m_arrayLayers, m_mipLevels, m_mipmapGenerateInfo,
+                memory, components, chainMemory))
+            {
+                //The generated chain is applied as data of all levels.
+                TextureDataInfo chainLayoutInfo(static_cast<uint32_t>(components.size()), components.data());
+                _applyData(chainLayoutInfo, chainMemory.data(), static_cast<uint32_t>(chainMemory.size()),
+                    cacheMemory, VG_FALSE);
+                return;
+            }
+        }
+
         if (cacheMemory)
         {
             m_components.resize(layoutInfo.componentCount);
@@ -628,6 +703,13 @@ namespace vg
             m_memorySize = 0;
         }
 
+        if (m_residentMipLevel != 0u && (cacheMemory == VG_FALSE || createMipmaps))
+        {
+            //Finer levels can't be uploaded later without cached data of all levels.
+            m_residentMipLevel = 0u;
+            _createResidentImage();
+        }
+
         if (size)
         {
             if (cacheMemory) 
@@ -640,6 +722,13 @@ namespace vg
                 memcpy(m_pMemory, memory, size);
                 m_realSize = size;
             }
+
+            if (createMipmaps == VG_FALSE)
+            {
+                _uploadComponents(layoutInfo, memory, m_residentMipLevel);
+                return;
+            }
+            vk::Image image = *(m_pImage->getImage());
             auto pDevice = pApp->getDevice();
 
             //create staging buffer.
@@ -653,128 +742,208 @@ namespace vg
             memcpy(data, memory, static_cast<size_t>(size));
             pDevice->unmapMemory(*pStagingBufferMemory);
             auto pCommandBuffer = beginSingleTimeCommands();
-            if (createMipmaps)
-            {
-                //transfer image from initial current image layout to dst layout.
-                //here use undefined layout not to use curr layout of image, it can clear image old data.
-                _tranImageLayout(pCommandBuffer, image, m_layout, vk::ImageLayout::eTransferDstOptimal,
-                    0, 1, 0, m_arrayLayers);
+            //transfer image from initial current image layout to dst layout.
+            //here use undefined layout not to use curr layout of image, it can clear image old data.
+            _tranImageLayout(pCommandBuffer, image, m_layout, vk::ImageLayout::eTransferDstOptimal,
+                0, 1, 0, m_arrayLayers);
 
-                //copy the first mip of the chain.
-                _copyBufferToImage(pCommandBuffer, *pStagingBuffer, image, m_width, m_height, m_depth, 0, 0, m_arrayLayers);
+            //copy the first mip of the chain.
+            _copyBufferToImage(pCommandBuffer, *pStagingBuffer, image, m_width, m_height, m_depth, 0, 0, m_arrayLayers);
 
 #ifdef DEBUG
-                //check format.
-                const auto &pPhysicalDevice = pApp->getPhysicalDevice();
-                const auto &formatProperties = pPhysicalDevice->getFormatProperties(m_format);
-                if ((formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eBlitSrc) == vk::FormatFeatureFlags())
-                {
-                    throw std::runtime_error("The texture format don't support for blit source, mip-chain generation requires it.");
-                }
-                if ((formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eBlitDst) == vk::FormatFeatureFlags())
-                {
-                    throw std::runtime_error("The texture format don't support for blit destination, mip-chain generation requires it.");
-                }
+            //check format.
+            const auto &pPhysicalDevice = pApp->getPhysicalDevice();
+            const auto &formatProperties = pPhysicalDevice->getFormatProperties(m_format);
+            if ((formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eBlitSrc) == vk::FormatFeatureFlags())
+            {
+                throw std::runtime_error("The texture format don't support for blit source, mip-chain generation requires it.");
+            }
+            if ((formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eBlitDst) == vk::FormatFeatureFlags())
+            {
+                throw std::runtime_error("The texture format don't support for blit destination, mip-chain generation requires it.");
+            }
 #endif // DEBUG
 
-                //transition first mip level to transfer source for read during blit.
-                _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, 
-                vk::ImageLayout::eTransferSrcOptimal, 0, 1, 0, m_arrayLayers);
-
-                for (uint32_t i = 1; i < m_mipLevels; ++i)
-                {
-                    vk::ImageBlit blit;
-                    blit.srcSubresource.aspectMask = m_allAspectFlags;
-                    blit.srcSubresource.baseArrayLayer = 0;
-                    blit.srcSubresource.layerCount = m_arrayLayers;
-                    blit.srcSubresource.mipLevel = i - 1;
-                    blit.dstSubresource.aspectMask = m_allAspectFlags;
-                    blit.dstSubresource.baseArrayLayer = 0;
-                    blit.dstSubresource.layerCount = m_arrayLayers;
-                    blit.dstSubresource.mipLevel = i;
-
-                    // each mipmap is the size divided by two
-                    blit.srcOffsets[1] = vk::Offset3D(caculateImageSizeWithMipmapLevel(m_width, i - 1),
-                        caculateImageSizeWithMipmapLevel(m_height, i - 1),
-                        caculateImageSizeWithMipmapLevel(m_depth, i - 1));
-
-                    blit.dstOffsets[1] = vk::Offset3D(caculateImageSizeWithMipmapLevel(m_width, i),
-                        caculateImageSizeWithMipmapLevel(m_height, i),
-                        caculateImageSizeWithMipmapLevel(m_depth, i));
-
-                    // transferDst go to transferSrc because this mipmap will be the source for the next iteration (the next level)
-                    _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
-                        i, 1, 0, m_arrayLayers);
-
-                    pCommandBuffer->blitImage(image, vk::ImageLayout::eTransferSrcOptimal,
-                        image, vk::ImageLayout::eTransferDstOptimal, blit,
-                        vk::Filter::eLinear);
-
-                    _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal,
-                        i, 1, 0, m_arrayLayers);
-                }
+            //transition first mip level to transfer source for read during blit.
+            _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, 
+            vk::ImageLayout::eTransferSrcOptimal, 0, 1, 0, m_arrayLayers);
 
-                //transfer all level and all layer to shader read layout.
-                _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferSrcOptimal, m_layout,
-                    0, m_mipLevels, 0, m_arrayLayers);
+            for (uint32_t i = 1; i < m_mipLevels; ++i)
+            {
+                vk::ImageBlit blit;
+                blit.srcSubresource.aspectMask = m_allAspectFlags;
+                blit.srcSubresource.baseArrayLayer = 0;
+                blit.srcSubresource.layerCount = m_arrayLayers;
+                blit.srcSubresource.mipLevel = i - 1;
+                blit.dstSubresource.aspectMask = m_allAspectFlags;
+                blit.dstSubresource.baseArrayLayer = 0;
+                blit.dstSubresource.layerCount = m_arrayLayers;
+                blit.dstSubresource.mipLevel = i;
+
+                // each mipmap is the size divided by two
+                blit.srcOffsets[1] = vk::Offset3D(caculateImageSizeWithMipmapLevel(m_width, i - 1),
+                    caculateImageSizeWithMipmapLevel(m_height, i - 1),
+                    caculateImageSizeWithMipmapLevel(m_depth, i - 1));
+
+                blit.dstOffsets[1] = vk::Offset3D(caculateImageSizeWithMipmapLevel(m_width, i),
+                    caculateImageSizeWithMipmapLevel(m_height, i),
+                    caculateImageSizeWithMipmapLevel(m_depth, i));
+
+                // transferDst go to transferSrc because this mipmap will be the source for the next iteration (the next level)
+                _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+                    i, 1, 0, m_arrayLayers);
+
+                pCommandBuffer->blitImage(image, vk::ImageLayout::eTransferSrcOptimal,
+                    image, vk::ImageLayout::eTransferDstOptimal, blit,
+                    vk::Filter::eLinear);
+
+                _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal,
+                    i, 1, 0, m_arrayLayers);
             }
-            else
+
+            //transfer all level and all layer to shader read layout.
+            _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferSrcOptimal, m_layout,
+                0, m_mipLevels, 0, m_arrayLayers);
+
+            holdSingleTimeCommandResource(pStagingBuffer);
+            holdSingleTimeCommandResource(pStagingBufferMemory);
+            endSingleTimeCommands(pCommandBuffer);
+        }
+    }
+
+    Bool32 Texture::_isMipmapsGeneratedOnCPU() const
+    {
+        //Only levels of 2d images are generated on CPU.
+        if (m_depth > 1u) return VG_FALSE;
+        if (m_isGenerateMipmapsOnCPU || isCompressedFormat(m_format)) return VG_TRUE;
+        const auto &pPhysicalDevice = pApp->getPhysicalDevice();
+        const auto &formatProperties = pPhysicalDevice->getFormatProperties(m_format);
+        //Mipmaps are blitted with linear filter.
+        const auto blitFeatures = vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst |
+            vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+        return (formatProperties.optimalTilingFeatures & blitFeatures) != blitFeatures ? VG_TRUE : VG_FALSE;
+    }
+
+    void Texture::_setResidentMipLevel(uint32_t level)
+    {
+        level = std::min(level, m_mipLevels - 1u);
+        if (level == m_residentMipLevel) return;
+#ifdef DEBUG
+        if (level != 0u && m_pMemory == nullptr)
+            throw std::runtime_error("Resident mip level of the texture can only be changed when its data of all levels are cached.");
+#endif //DEBUG
+        m_residentMipLevel = level;
+        _createResidentImage();
+        if (m_pMemory != nullptr)
+        {
+            _uploadComponents(m_dataLayout, m_pMemory, m_residentMipLevel);
+        }
+    }
+
+    void Texture::_createResidentImage()
+    {
+#ifdef DEBUG
+        if (m_mapPOtherImageViews.size())
+            throw std::runtime_error("Image views created by name would refer to the old image after the image is recreated.");
+#endif //DEBUG
+        //The old image may be used by the commands of current batch.
+        holdSingleTimeCommandResource(m_pImage);
+        holdSingleTimeCommandResource(m_pImageView);
+        _createImage(VG_TRUE);
+        _createImageView();
+        ++m_resourceStateID;
+    }
+
+    void Texture::_uploadComponents(const TextureDataInfo &layoutInfo
+        , const void *memory
+        , uint32_t baseMipLevel)
+    {
+        vk::Image image = *(m_pImage->getImage());
+        const auto componentCount = layoutInfo.componentCount;
+        //Only components of the levels in the image are copied to staging buffer.
+        std::vector<vk::BufferImageCopy> bufferCopyRegions;
+        std::vector<uint32_t> srcOffsets;
+        bufferCopyRegions.reserve(componentCount);
+        srcOffsets.reserve(componentCount);
+        uint32_t srcOffset = 0u;
+        uint32_t offset = 0u;
+        for (uint32_t i = 0u; i < componentCount; ++i)
+        {
+            const auto component = *(layoutInfo.pComponent + i);
+            if (component.mipLevel >= baseMipLevel)
             {
-                const auto pComponent = layoutInfo.pComponent;
-                const auto componentCount = layoutInfo.componentCount;
-                std::vector<vk::BufferImageCopy> bufferCopyRegions(componentCount);
-                uint32_t offset = 0u;
-                for (uint32_t i = 0u; i < componentCount; ++i)
+                uint32_t width;
+                uint32_t height;
+                uint32_t depth;
+                if (component.hasImageExtent)
                 {
-                    uint32_t width;
-                    uint32_t height;
-                    uint32_t depth;
-                    const auto component = *(layoutInfo.pComponent + i);
-                    if (component.hasImageExtent)
-                    {
-                        width = component.width;
-                        height = component.height;
-                        depth = component.depth;
-                    }
-                    else
-                    {
-                        width = caculateImageSizeWithMipmapLevel(m_width, component.mipLevel);
-                        height = caculateImageSizeWithMipmapLevel(m_height, component.mipLevel);
-                        depth = caculateImageSizeWithMipmapLevel(m_depth, component.mipLevel);
-                    }
-                    vk::ImageSubresourceLayers subresourceLayers = {
-                        m_allAspectFlags,              //aspectMask
-                        component.mipLevel,            //mipLevel
-                        component.baseArrayLayer,      //baseArrayLayer
-                        component.layerCount           //layerCount
-                    };
-                    vk::BufferImageCopy copyInfo = { 
-                        offset,                                 //bufferOffset
-                        0,                                      //bufferRowLength
-                        0,                                      //bufferImageHeight
-                        subresourceLayers,                      //imageSubresource
-                        vk::Offset3D(0, 0, 0),                  //imageOffset
-                        vk::Extent3D(width, height, depth)      //imageExtent
-                    };
-
-                    bufferCopyRegions[i] = copyInfo;
-                    offset += component.size;
+                    width = component.width;
+                    height = component.height;
+                    depth = component.depth;
                 }
-                //transfer image from initial current image layout to dst layout.
-                //here use undefined layout not to use curr layout of image, it can clear image old data.
-                _tranImageLayout(pCommandBuffer, image, m_layout, vk::ImageLayout::eTransferDstOptimal,
-                    0, m_mipLevels, 0, m_arrayLayers);
-                
-                pCommandBuffer->copyBufferToImage(*pStagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, bufferCopyRegions);
+                else
+                {
+                    width = caculateImageSizeWithMipmapLevel(m_width, component.mipLevel);
+                    height = caculateImageSizeWithMipmapLevel(m_height, component.mipLevel);
+                    depth = caculateImageSizeWithMipmapLevel(m_depth, component.mipLevel);
+                }
+                vk::ImageSubresourceLayers subresourceLayers = {
+                    m_allAspectFlags,                          //aspectMask
+                    component.mipLevel - baseMipLevel,         //mipLevel
+                    component.baseArrayLayer,                  //baseArrayLayer
+                    component.layerCount                       //layerCount
+                };
+                vk::BufferImageCopy copyInfo = { 
+                    offset,                                 //bufferOffset
+                    0,                                      //bufferRowLength
+                    0,                                      //bufferImageHeight
+                    subresourceLayers,                      //imageSubresource
+                    vk::Offset3D(0, 0, 0),                  //imageOffset
+                    vk::Extent3D(width, height, depth)      //imageExtent
+                };
+
+                bufferCopyRegions.push_back(copyInfo);
+                srcOffsets.push_back(srcOffset);
+                offset += component.size;
+            }
+            srcOffset += component.size;
+        }
+        if (offset == 0u) return;
 
-                //transfer to shader read layout.
-                _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, m_layout,
-                    0, m_mipLevels, 0, m_arrayLayers);
+        auto pDevice = pApp->getDevice();
 
-            }
+        //create staging buffer.
+        std::shared_ptr<vk::Buffer> pStagingBuffer;
+        std::shared_ptr<vk::DeviceMemory> pStagingBufferMemory;
+        _createBuffer(offset, vk::BufferUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+            pStagingBuffer, pStagingBufferMemory);
 
-            endSingleTimeCommands(pCommandBuffer);
+        char *data = static_cast<char *>(pDevice->mapMemory(*pStagingBufferMemory, 0, offset));
+        uint32_t regionCount = static_cast<uint32_t>(bufferCopyRegions.size());
+        for (uint32_t i = 0u; i < regionCount; ++i)
+        {
+            uint32_t regionSize = (i + 1u < regionCount ? static_cast<uint32_t>(bufferCopyRegions[i + 1u].bufferOffset) : offset) - 
+                static_cast<uint32_t>(bufferCopyRegions[i].bufferOffset);
+            memcpy(data + bufferCopyRegions[i].bufferOffset, static_cast<const char *>(memory) + srcOffsets[i], regionSize);
         }
+        pDevice->unmapMemory(*pStagingBufferMemory);
+
+        uint32_t mipLevels = m_pImage->getInfo().mipLevels;
+        auto pCommandBuffer = beginSingleTimeCommands();
+        //transfer image from initial current image layout to dst layout.
+        _tranImageLayout(pCommandBuffer, image, m_layout, vk::ImageLayout::eTransferDstOptimal,
+            0, mipLevels, 0, m_arrayLayers);
+        
+        pCommandBuffer->copyBufferToImage(*pStagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, bufferCopyRegions);
+
+        //transfer to shader read layout.
+        _tranImageLayout(pCommandBuffer, image, vk::ImageLayout::eTransferDstOptimal, m_layout,
+            0, mipLevels, 0, m_arrayLayers);
+
+        holdSingleTimeCommandResource(pStagingBuffer);
+        holdSingleTimeCommandResource(pStagingBufferMemory);
+        endSingleTimeCommands(pCommandBuffer);
     }
 
     void Texture::_createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags properties,
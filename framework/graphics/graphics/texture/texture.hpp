@@ -2,6 +2,7 @@
 #define VG_TEXTURE_H
 
 #include "foundation/wrapper.hpp"
+#include "foundation/mipmap_generator.hpp"
 #include "graphics/util/find_memory.hpp"
 #include "graphics/global.hpp"
 #include "graphics/app/app.hpp"
@@ -230,6 +231,20 @@ namespace vg
         const ImageView *getImageView(std::string name) const;
         const Sampler *createSampler(std::string name, SamplerCreateInfo createInfo);
         const Sampler *getSampler(std::string name) const;
+
+        uint32_t getMipLevels() const;
+        //Size of cached data of the mip level, it is 0 when data isn't cached.
+        uint32_t getCachedMipLevelSize(uint32_t mipLevel) const;
+        //Finest mip level which is in the image, the image only contains the levels from it to the last level.
+        uint32_t getResidentMipLevel() const;
+        //It is changed when the image is recreated, descriptors using the texture should be updated.
+        uint32_t getResourceStateID() const;
+        /*Mipmaps created by applying data are generated on CPU when it is true or the format can't be blitted,
+          eg. integer and block compressed formats. The generated chain is uploaded with one staging copy.*/
+        Bool32 getIsGenerateMipmapsOnCPU() const;
+        void setIsGenerateMipmapsOnCPU(Bool32 value);
+        const fd::MipmapGenerateInfo &getMipmapGenerateInfo() const;
+        void setMipmapGenerateInfo(const fd::MipmapGenerateInfo &info);
     protected:
         TextureType m_type;        
         uint32_t m_width;
@@ -257,6 +272,10 @@ namespace vg
 
         std::unordered_map<std::string, std::shared_ptr<ImageView>> m_mapPOtherImageViews;
         std::unordered_map<std::string, std::shared_ptr<Sampler>> m_mapPOtherSamplers;
+        uint32_t m_residentMipLevel;
+        uint32_t m_resourceStateID;
+        Bool32 m_isGenerateMipmapsOnCPU;
+        fd::MipmapGenerateInfo m_mipmapGenerateInfo;
 
         virtual void _init(Bool32 importContent);
 
@@ -271,6 +290,14 @@ namespace vg
             , uint32_t size
             , Bool32 cacheMemory = VG_FALSE
             , Bool32 createMipmaps = VG_FALSE);
+        Bool32 _isMipmapsGeneratedOnCPU() const;
+        /*Recreate the image with the levels from the resident level and upload them from cached memory,
+          the sampled level is clamped to the resident level because finer levels aren't in the image.*/
+        void _setResidentMipLevel(uint32_t level);
+        void _createResidentImage();
+        void _uploadComponents(const TextureDataInfo &layoutInfo
+            , const void *memory
+            , uint32_t baseMipLevel);
 
         void _createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags properties,
             std::shared_ptr<vk::Buffer>& pBuffer, std::shared_ptr<vk::DeviceMemory>& pBufferMemory);
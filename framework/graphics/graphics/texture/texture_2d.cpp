@@ -49,6 +49,11 @@ namespace vg
         _applyData(layoutInfo, memory, size, cacheMemory, createMipmaps);
     }
 
+    void Texture2D::setResidentMipLevel(uint32_t level)
+    {
+        _setResidentMipLevel(level);
+    }
+
 
     Texture2DColorAttachment::Texture2DColorAttachment(vk::Format format
         , uint32_t width
@@ -25,6 +25,9 @@ namespace vg
             , uint32_t size
             , Bool32 cacheMemory = VG_FALSE
             , Bool32 createMipmaps = VG_FALSE);
+        /*Only levels from the resident level are kept in the image, it is used to stream the texture.
+          Data of all levels should be cached by applying data with cache memory and without creating mipmaps.*/
+        void setResidentMipLevel(uint32_t level);
     private:
         Texture2D() = delete;
     };
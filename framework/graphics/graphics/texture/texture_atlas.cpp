@@ -0,0 +1,135 @@
+#include "graphics/texture/texture_atlas.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include "graphics/texture/texture_format.hpp"
+
+namespace vg
+{
+    TextureAtlas::Region::Region(uint32_t layer
+        , Vector4 uvScaleBias
+        )
+        : layer(layer)
+        , uvScaleBias(uvScaleBias)
+    {
+
+    }
+
+    TextureAtlas::TextureAtlas(vk::Format format
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , Bool32 mipmap
+        , uint32_t padding
+        )
+        : m_pTexture()
+        , m_width(width)
+        , m_height(height)
+        , m_padding(padding)
+        , m_pixelSize()
+        , m_packers(layerCount, fd::SkylinePacker(width, height))
+        , m_regions()
+        , m_memory()
+        , m_isChanged(VG_FALSE)
+    {
+        fd::MipmapChannelType channelType;
+        uint32_t channelCount;
+        if (getMipmapChannelInfo(format, channelType, channelCount) == VG_FALSE)
+        {
+            throw std::runtime_error("The format of the texture atlas isn't an uncompressed color format.");
+        }
+        m_pixelSize = fd::getMipmapChannelSize(channelType) * channelCount;
+        m_memory.resize(static_cast<size_t>(width) * height * layerCount * m_pixelSize);
+        m_pTexture = std::make_shared<Texture2DArray>(format, mipmap, width, height, layerCount);
+    }
+
+    Bool32 TextureAtlas::addTexture(uint32_t width, uint32_t height, const void *pPixels, uint32_t &index)
+    {
+        uint32_t layerCount = static_cast<uint32_t>(m_packers.size());
+        for (uint32_t layer = 0u; layer < layerCount; ++layer)
+        {
+            fd::SkylinePacker::Rect rect;
+            if (m_packers[layer].pack(width + m_padding * 2u, height + m_padding * 2u, rect) == VG_FALSE) continue;
+            _copyPixels(layer, rect, static_cast<const uint8_t *>(pPixels));
+            Vector4 uvScaleBias(static_cast<float>(width) / static_cast<float>(m_width)
+                , static_cast<float>(height) / static_cast<float>(m_height)
+                , static_cast<float>(rect.x + m_padding) / static_cast<float>(m_width)
+                , static_cast<float>(rect.y + m_padding) / static_cast<float>(m_height)
+                );
+            index = static_cast<uint32_t>(m_regions.size());
+            m_regions.push_back(Region(layer, uvScaleBias));
+            m_isChanged = VG_TRUE;
+            return VG_TRUE;
+        }
+        return VG_FALSE;
+    }
+
+    uint32_t TextureAtlas::getRegionCount() const
+    {
+        return static_cast<uint32_t>(m_regions.size());
+    }
+
+    const TextureAtlas::Region &TextureAtlas::getRegion(uint32_t index) const
+    {
+        return m_regions[index];
+    }
+
+    void TextureAtlas::apply()
+    {
+        if (m_isChanged == VG_FALSE) return;
+        uint32_t size = static_cast<uint32_t>(m_memory.size());
+        TextureDataInfo::Component component(0u
+            , 0u
+            , static_cast<uint32_t>(m_packers.size())
+            , size
+            , VG_TRUE
+            , m_width
+            , m_height
+            , 1u
+            );
+        TextureDataInfo layoutInfo(1u, &component);
+        m_pTexture->applyData(layoutInfo, m_memory.data(), size, VG_FALSE, m_pTexture->getIsMipmap());
+        m_isChanged = VG_FALSE;
+    }
+
+    const Texture2DArray *TextureAtlas::getTexture() const
+    {
+        return m_pTexture.get();
+    }
+
+    Texture2DArray *TextureAtlas::getTexture()
+    {
+        return m_pTexture.get();
+    }
+
+    uint32_t TextureAtlas::getLayerCount() const
+    {
+        return static_cast<uint32_t>(m_packers.size());
+    }
+
+    float TextureAtlas::getOccupancy(uint32_t layer) const
+    {
+        return m_packers[layer].getOccupancy();
+    }
+
+    void TextureAtlas::_copyPixels(uint32_t layer, const fd::SkylinePacker::Rect &rect, const uint8_t *pPixels)
+    {
+        uint32_t width = rect.width - m_padding * 2u;
+        uint32_t height = rect.height - m_padding * 2u;
+        uint8_t *pLayer = m_memory.data() + static_cast<size_t>(layer) * m_width * m_height * m_pixelSize;
+        for (uint32_t y = 0u; y < rect.height; ++y)
+        {
+            //Rows and columns in the padding are copies of edge pixels.
+            uint32_t srcY = std::min(static_cast<uint32_t>(std::max(static_cast<int32_t>(y) -
+                static_cast<int32_t>(m_padding), 0)), height - 1u);
+            const uint8_t *pSrcRow = pPixels + static_cast<size_t>(srcY) * width * m_pixelSize;
+            uint8_t *pDstRow = pLayer + (static_cast<size_t>(rect.y + y) * m_width + rect.x) * m_pixelSize;
+            for (uint32_t x = 0u; x < m_padding; ++x)
+            {
+                memcpy(pDstRow + x * m_pixelSize, pSrcRow, m_pixelSize);
+                memcpy(pDstRow + (m_padding + width + x) * m_pixelSize, pSrcRow + (width - 1u) * m_pixelSize, m_pixelSize);
+            }
+            memcpy(pDstRow + m_padding * m_pixelSize, pSrcRow, static_cast<size_t>(width) * m_pixelSize);
+        }
+    }
+} //namespace vg
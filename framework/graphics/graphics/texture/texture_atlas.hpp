@@ -0,0 +1,67 @@
+#ifndef VG_TEXTURE_ATLAS_H
+#define VG_TEXTURE_ATLAS_H
+
+#include <vector>
+#include <foundation/rect_packer.hpp>
+#include "graphics/global.hpp"
+#include "graphics/texture/texture_2d_array.hpp"
+
+#define VG_TEXTURE_ATLAS_DEFAULT_PADDING 4u
+
+namespace vg
+{
+    /*Pack small textures into layers of a 2d array texture, so passes differing only by these textures
+      can share the array. Each texture is sampled with its layer and uv * scale + bias.
+      Edge pixels of textures are repeated into the padding around them, so filtering and mipmaps up to
+      level log2(padding) don't bleed neighbours. The format should be an uncompressed color format.*/
+    class TextureAtlas
+    {
+    public:
+        struct Region
+        {
+            uint32_t layer;
+            //xy are scale and zw are bias of uv.
+            Vector4 uvScaleBias;
+
+            Region(uint32_t layer = 0u
+                , Vector4 uvScaleBias = Vector4(1.0f, 1.0f, 0.0f, 0.0f)
+                );
+        };
+
+        TextureAtlas(vk::Format format
+            , uint32_t width
+            , uint32_t height
+            , uint32_t layerCount
+            , Bool32 mipmap = VG_TRUE
+            , uint32_t padding = VG_TEXTURE_ATLAS_DEFAULT_PADDING
+            );
+
+        /*Pack the texture with tightly packed pixels, index of its region is got when it is packed.
+          It returns false when no layer has enough space.*/
+        Bool32 addTexture(uint32_t width, uint32_t height, const void *pPixels, uint32_t &index);
+        uint32_t getRegionCount() const;
+        const Region &getRegion(uint32_t index) const;
+        /*Upload all layers with one staging copy when textures are added after last applying,
+          mipmaps are generated again.*/
+        void apply();
+
+        const Texture2DArray *getTexture() const;
+        Texture2DArray *getTexture();
+        uint32_t getLayerCount() const;
+        float getOccupancy(uint32_t layer) const;
+    private:
+        std::shared_ptr<Texture2DArray> m_pTexture;
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_padding;
+        uint32_t m_pixelSize;
+        std::vector<fd::SkylinePacker> m_packers;
+        std::vector<Region> m_regions;
+        std::vector<uint8_t> m_memory;
+        Bool32 m_isChanged;
+
+        void _copyPixels(uint32_t layer, const fd::SkylinePacker::Rect &rect, const uint8_t *pPixels);
+    };
+} //namespace vg
+
+#endif //VG_TEXTURE_ATLAS_H
@@ -22,7 +22,7 @@ namespace vg
         m_width = width;
         m_height = height;
         m_allAspectFlags = vk::ImageAspectFlagBits::eColor;
-        m_usageFlags = vk::ImageUsageFlagBits::eColorAttachment;
+        m_usageFlags |= vk::ImageUsageFlagBits::eColorAttachment;
         m_layout = vk::ImageLayout::eColorAttachmentOptimal;
 
         if (isInputUsage)
@@ -0,0 +1,251 @@
+#include "graphics/texture/texture_format.hpp"
+
+#include <array>
+#include <tuple>
+#include <cstring>
+#include <algorithm>
+#include <foundation/texture_compression.hpp>
+#include "graphics/app/app.hpp"
+
+namespace vg
+{
+    //Compressed format, its block format and its decoded format.
+    static const std::array<std::tuple<vk::Format, fd::BlockFormat, vk::Format>, 10u> arrCompressedFormatToDecoded = {
+        std::make_tuple(vk::Format::eBc1RgbUnormBlock, fd::BlockFormat::BC1_RGB, vk::Format::eR8G8B8A8Unorm),
+        std::make_tuple(vk::Format::eBc1RgbSrgbBlock, fd::BlockFormat::BC1_RGB, vk::Format::eR8G8B8A8Srgb),
+        std::make_tuple(vk::Format::eBc1RgbaUnormBlock, fd::BlockFormat::BC1, vk::Format::eR8G8B8A8Unorm),
+        std::make_tuple(vk::Format::eBc1RgbaSrgbBlock, fd::BlockFormat::BC1, vk::Format::eR8G8B8A8Srgb),
+        std::make_tuple(vk::Format::eBc2UnormBlock, fd::BlockFormat::BC2, vk::Format::eR8G8B8A8Unorm),
+        std::make_tuple(vk::Format::eBc2SrgbBlock, fd::BlockFormat::BC2, vk::Format::eR8G8B8A8Srgb),
+        std::make_tuple(vk::Format::eBc3UnormBlock, fd::BlockFormat::BC3, vk::Format::eR8G8B8A8Unorm),
+        std::make_tuple(vk::Format::eBc3SrgbBlock, fd::BlockFormat::BC3, vk::Format::eR8G8B8A8Srgb),
+        std::make_tuple(vk::Format::eBc4UnormBlock, fd::BlockFormat::BC4, vk::Format::eR8Unorm),
+        std::make_tuple(vk::Format::eBc5UnormBlock, fd::BlockFormat::BC5, vk::Format::eR8G8Unorm),
+    };
+
+    //Format and channel type and count of its pixels for generating mipmaps on CPU.
+    static const std::array<std::tuple<vk::Format, fd::MipmapChannelType, uint32_t>, 29u> arrFormatToMipmapChannelInfo = {
+        std::make_tuple(vk::Format::eR8Unorm, fd::MipmapChannelType::UNORM8, 1u),
+        std::make_tuple(vk::Format::eR8G8Unorm, fd::MipmapChannelType::UNORM8, 2u),
+        std::make_tuple(vk::Format::eR8G8B8Unorm, fd::MipmapChannelType::UNORM8, 3u),
+        std::make_tuple(vk::Format::eB8G8R8Unorm, fd::MipmapChannelType::UNORM8, 3u),
+        std::make_tuple(vk::Format::eR8G8B8A8Unorm, fd::MipmapChannelType::UNORM8, 4u),
+        std::make_tuple(vk::Format::eB8G8R8A8Unorm, fd::MipmapChannelType::UNORM8, 4u),
+        std::make_tuple(vk::Format::eR8Srgb, fd::MipmapChannelType::SRGB8, 1u),
+        std::make_tuple(vk::Format::eR8G8Srgb, fd::MipmapChannelType::SRGB8, 2u),
+        std::make_tuple(vk::Format::eR8G8B8Srgb, fd::MipmapChannelType::SRGB8, 3u),
+        std::make_tuple(vk::Format::eB8G8R8Srgb, fd::MipmapChannelType::SRGB8, 3u),
+        std::make_tuple(vk::Format::eR8G8B8A8Srgb, fd::MipmapChannelType::SRGB8, 4u),
+        std::make_tuple(vk::Format::eB8G8R8A8Srgb, fd::MipmapChannelType::SRGB8, 4u),
+        std::make_tuple(vk::Format::eR8Uint, fd::MipmapChannelType::UINT8, 1u),
+        std::make_tuple(vk::Format::eR8G8Uint, fd::MipmapChannelType::UINT8, 2u),
+        std::make_tuple(vk::Format::eR8G8B8Uint, fd::MipmapChannelType::UINT8, 3u),
+        std::make_tuple(vk::Format::eR8G8B8A8Uint, fd::MipmapChannelType::UINT8, 4u),
+        std::make_tuple(vk::Format::eR16Unorm, fd::MipmapChannelType::UNORM16, 1u),
+        std::make_tuple(vk::Format::eR16G16Unorm, fd::MipmapChannelType::UNORM16, 2u),
+        std::make_tuple(vk::Format::eR16G16B16Unorm, fd::MipmapChannelType::UNORM16, 3u),
+        std::make_tuple(vk::Format::eR16G16B16A16Unorm, fd::MipmapChannelType::UNORM16, 4u),
+        std::make_tuple(vk::Format::eR16Uint, fd::MipmapChannelType::UINT16, 1u),
+        std::make_tuple(vk::Format::eR16G16Uint, fd::MipmapChannelType::UINT16, 2u),
+        std::make_tuple(vk::Format::eR16G16B16Uint, fd::MipmapChannelType::UINT16, 3u),
+        std::make_tuple(vk::Format::eR16G16B16A16Uint, fd::MipmapChannelType::UINT16, 4u),
+        std::make_tuple(vk::Format::eR32Sfloat, fd::MipmapChannelType::FLOAT32, 1u),
+        std::make_tuple(vk::Format::eR32G32Sfloat, fd::MipmapChannelType::FLOAT32, 2u),
+        std::make_tuple(vk::Format::eR32G32B32Sfloat, fd::MipmapChannelType::FLOAT32, 3u),
+        std::make_tuple(vk::Format::eR32G32B32A32Sfloat, fd::MipmapChannelType::FLOAT32, 4u),
+        std::make_tuple(vk::Format::eA8B8G8R8UnormPack32, fd::MipmapChannelType::UNORM8, 4u),
+    };
+
+    static const std::tuple<vk::Format, fd::BlockFormat, vk::Format> *_findBlockFormatInfo(vk::Format format)
+    {
+        for (const auto &item : arrCompressedFormatToDecoded)
+        {
+            if (std::get<0>(item) == format) return &item;
+        }
+        return nullptr;
+    }
+
+    Bool32 isCompressedFormat(vk::Format format)
+    {
+        return format >= vk::Format::eBc1RgbUnormBlock && format <= vk::Format::eAstc12x12SrgbBlock ? VG_TRUE : VG_FALSE;
+    }
+
+    Bool32 isFormatSupported(vk::Format format
+        , vk::FormatFeatureFlags features
+        )
+    {
+        const auto &formatProperties = pApp->getPhysicalDevice()->getFormatProperties(format);
+        return (formatProperties.optimalTilingFeatures & features) == features ? VG_TRUE : VG_FALSE;
+    }
+
+    vk::Format findSupportedFormat(const std::vector<vk::Format> &candidates
+        , vk::FormatFeatureFlags features
+        )
+    {
+        for (const auto &format : candidates)
+        {
+            if (isFormatSupported(format, features)) return format;
+        }
+        return vk::Format::eUndefined;
+    }
+
+    Bool32 decodeUnsupportedTextureData(vk::Format format
+        , uint32_t width
+        , uint32_t height
+        , const TextureDataInfo &layoutInfo
+        , const void *memory
+        , vk::Format &decodedFormat
+        , std::vector<TextureDataInfo::Component> &decodedComponents
+        , std::vector<uint8_t> &decodedMemory
+        )
+    {
+        if (isFormatSupported(format)) return VG_FALSE;
+        auto pItem = _findBlockFormatInfo(format);
+        if (pItem == nullptr) return VG_FALSE;
+        auto blockFormat = std::get<1>(*pItem);
+        decodedFormat = std::get<2>(*pItem);
+        uint32_t channelCount = fd::getBlockFormatChannelCount(blockFormat);
+
+        VG_LOG(plog::warning) << "Texture format " << vk::to_string(format) << " isn't supported, it is decoded to " <<
+            vk::to_string(decodedFormat) << " on CPU." << std::endl;
+
+        uint32_t componentCount = layoutInfo.componentCount;
+        decodedComponents.resize(componentCount);
+        uint32_t decodedSize = 0u;
+        for (uint32_t i = 0u; i < componentCount; ++i)
+        {
+            auto component = *(layoutInfo.pComponent + i);
+            if (component.hasImageExtent == VG_FALSE)
+            {
+                component.hasImageExtent = VG_TRUE;
+                component.width = std::max(1u, width >> component.mipLevel);
+                component.height = std::max(1u, height >> component.mipLevel);
+                component.depth = 1u;
+            }
+            component.size = component.width * component.height * std::max(1u, component.layerCount) * channelCount;
+            decodedComponents[i] = component;
+            decodedSize += component.size;
+        }
+
+        decodedMemory.resize(decodedSize);
+        const uint8_t *pSrc = static_cast<const uint8_t *>(memory);
+        uint8_t *pDst = decodedMemory.data();
+        for (uint32_t i = 0u; i < componentCount; ++i)
+        {
+            const auto &component = decodedComponents[i];
+            uint32_t layerCount = std::max(1u, component.layerCount);
+            uint32_t srcLayerSize = (layoutInfo.pComponent + i)->size / layerCount;
+            uint32_t dstLayerSize = component.size / layerCount;
+            for (uint32_t layer = 0u; layer < layerCount; ++layer)
+            {
+                fd::decompressBlocks(blockFormat, pSrc, component.width, component.height, pDst);
+                pSrc += srcLayerSize;
+                pDst += dstLayerSize;
+            }
+        }
+        return VG_TRUE;
+    }
+
+    Bool32 getMipmapChannelInfo(vk::Format format
+        , fd::MipmapChannelType &type
+        , uint32_t &channelCount
+        )
+    {
+        for (const auto &item : arrFormatToMipmapChannelInfo)
+        {
+            if (std::get<0>(item) == format)
+            {
+                type = std::get<1>(item);
+                channelCount = std::get<2>(item);
+                return VG_TRUE;
+            }
+        }
+        return VG_FALSE;
+    }
+
+    Bool32 generateMipmapsOnCPU(vk::Format format
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t levelCount
+        , const fd::MipmapGenerateInfo &info
+        , const void *memory
+        , std::vector<TextureDataInfo::Component> &components
+        , std::vector<uint8_t> &chainMemory
+        )
+    {
+        fd::MipmapChannelType type;
+        uint32_t channelCount;
+        auto pBlockItem = _findBlockFormatInfo(format);
+        if (pBlockItem != nullptr)
+        {
+            type = std::get<2>(*pBlockItem) == vk::Format::eR8G8B8A8Srgb ? fd::MipmapChannelType::SRGB8 :
+                fd::MipmapChannelType::UNORM8;
+            channelCount = fd::getBlockFormatChannelCount(std::get<1>(*pBlockItem));
+        }
+        else if (getMipmapChannelInfo(format, type, channelCount) == VG_FALSE)
+        {
+            return VG_FALSE;
+        }
+
+        //Pixels of all levels are generated in a buffer, then they are copied or encoded to the chain memory.
+        uint32_t pixelSize = fd::getMipmapChannelSize(type) * channelCount;
+        std::vector<uint8_t> pixelMemory;
+        uint8_t *pPixels;
+        if (pBlockItem != nullptr)
+        {
+            pixelMemory.resize(fd::caculateMipmapLevelOffset(type, channelCount, width, height, layerCount, levelCount));
+            uint32_t blockLayerSize = fd::getBlockCompressedSize(std::get<1>(*pBlockItem), width, height);
+            for (uint32_t layer = 0u; layer < layerCount; ++layer)
+            {
+                fd::decompressBlocks(std::get<1>(*pBlockItem), static_cast<const uint8_t *>(memory) + layer * blockLayerSize,
+                    width, height, pixelMemory.data() + layer * width * height * pixelSize);
+            }
+            pPixels = pixelMemory.data();
+        }
+        else
+        {
+            chainMemory.resize(fd::caculateMipmapLevelOffset(type, channelCount, width, height, layerCount, levelCount));
+            memcpy(chainMemory.data(), memory, width * height * layerCount * pixelSize);
+            pPixels = chainMemory.data();
+        }
+
+        fd::generateMipmaps(type, channelCount, info, width, height, layerCount, levelCount, pPixels);
+
+        components.resize(levelCount);
+        uint32_t chainSize = 0u;
+        for (uint32_t level = 0u; level < levelCount; ++level)
+        {
+            auto &component = components[level];
+            component.mipLevel = level;
+            component.baseArrayLayer = 0u;
+            component.layerCount = layerCount;
+            component.hasImageExtent = VG_TRUE;
+            component.width = std::max(1u, width >> level);
+            component.height = std::max(1u, height >> level);
+            component.depth = 1u;
+            component.size = pBlockItem != nullptr ?
+                fd::getBlockCompressedSize(std::get<1>(*pBlockItem), component.width, component.height) * layerCount :
+                component.width * component.height * layerCount * pixelSize;
+            chainSize += component.size;
+        }
+
+        if (pBlockItem != nullptr)
+        {
+            chainMemory.resize(chainSize);
+            uint8_t *pBlocks = chainMemory.data();
+            for (uint32_t level = 0u; level < levelCount; ++level)
+            {
+                const auto &component = components[level];
+                uint32_t blockLayerSize = component.size / layerCount;
+                for (uint32_t layer = 0u; layer < layerCount; ++layer)
+                {
+                    fd::compressBlocks(std::get<1>(*pBlockItem), pPixels, component.width, component.height, pBlocks);
+                    pPixels += component.width * component.height * pixelSize;
+                    pBlocks += blockLayerSize;
+                }
+            }
+        }
+        return VG_TRUE;
+    }
+} //namespace vg
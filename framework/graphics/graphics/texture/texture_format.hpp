@@ -0,0 +1,61 @@
+#ifndef VG_TEXTURE_FORMAT_H
+#define VG_TEXTURE_FORMAT_H
+
+#include <vector>
+#include <foundation/mipmap_generator.hpp>
+#include "graphics/global.hpp"
+#include "graphics/texture/texture.hpp"
+
+namespace vg
+{
+    //BC, ETC2 and ASTC formats, their data can't be blitted to generate mipmaps.
+    extern Bool32 isCompressedFormat(vk::Format format);
+
+    //Optimal tiling of the format supports the features in the physical device.
+    extern Bool32 isFormatSupported(vk::Format format
+        , vk::FormatFeatureFlags features = vk::FormatFeatureFlagBits::eSampledImage
+        );
+
+    /*Get the first supported format of the candidates, eg. BC7, ASTC and ETC2 versions of a texture,
+      it returns undefined format when none of them is supported.*/
+    extern vk::Format findSupportedFormat(const std::vector<vk::Format> &candidates
+        , vk::FormatFeatureFlags features = vk::FormatFeatureFlagBits::eSampledImage
+        );
+
+    /*Decode data of BC1 ~ BC5 formats on CPU when the device can't sample the format. Decoded format is
+      RGBA8 of same color space for BC1 ~ BC3, R8 for BC4 and R8G8 for BC5, components are in same order.
+      Components without image extent use the width and height with their mip levels.
+      It returns false when the format is supported or it can't be decoded on CPU.*/
+    extern Bool32 decodeUnsupportedTextureData(vk::Format format
+        , uint32_t width
+        , uint32_t height
+        , const TextureDataInfo &layoutInfo
+        , const void *memory
+        , vk::Format &decodedFormat
+        , std::vector<TextureDataInfo::Component> &decodedComponents
+        , std::vector<uint8_t> &decodedMemory
+        );
+
+    /*Channel type and channel count of pixels of the format for generating mipmaps on CPU,
+      it returns false when the format can't be filtered on CPU.*/
+    extern Bool32 getMipmapChannelInfo(vk::Format format
+        , fd::MipmapChannelType &type
+        , uint32_t &channelCount
+        );
+
+    /*Generate the mip chain from data of level 0 of all layers on CPU, data of BC1 ~ BC5 formats is decoded,
+      filtered and encoded again. Every component of the result is a level with all layers.
+      It returns false when the format can't be filtered on CPU.*/
+    extern Bool32 generateMipmapsOnCPU(vk::Format format
+        , uint32_t width
+        , uint32_t height
+        , uint32_t layerCount
+        , uint32_t levelCount
+        , const fd::MipmapGenerateInfo &info
+        , const void *memory
+        , std::vector<TextureDataInfo::Component> &components
+        , std::vector<uint8_t> &chainMemory
+        );
+} //namespace vg
+
+#endif //VG_TEXTURE_FORMAT_H
@@ -0,0 +1,169 @@
+#include "graphics/texture/texture_streamer.hpp"
+
+#include "graphics/util/single_time_command.hpp"
+
+namespace vg
+{
+    TextureStreamer::_TextureInfo::_TextureInfo(Texture2D *pTexture)
+        : pTexture(pTexture)
+        , pPasses()
+    {
+
+    }
+
+    TextureStreamer::TextureStreamer(uint64_t memoryBudget
+        , uint32_t maxUploadCountPerUpdate
+        )
+        : m_residency(memoryBudget, maxUploadCountPerUpdate)
+        , m_mapTextureIndices()
+        , m_mapTextureInfos()
+        , m_changes()
+    {
+
+    }
+
+    void TextureStreamer::addTexture(Texture2D *pTexture, uint32_t mipTailLevel)
+    {
+        if (m_mapTextureIndices.count(pTexture) != 0u) return;
+        uint32_t mipLevels = pTexture->getMipLevels();
+        std::vector<uint64_t> mipSizes(mipLevels);
+        for (uint32_t level = 0u; level < mipLevels; ++level)
+        {
+            mipSizes[level] = pTexture->getCachedMipLevelSize(level);
+        }
+#ifdef DEBUG
+        if (mipSizes[0] == 0u)
+            throw std::runtime_error("Data of all mip levels of the streaming texture should be cached.");
+#endif //DEBUG
+        uint32_t textureIndex = m_residency.addTexture(mipSizes.data(), mipLevels, mipTailLevel);
+        m_mapTextureIndices[pTexture] = textureIndex;
+        m_mapTextureInfos[textureIndex] = _TextureInfo(pTexture);
+        pTexture->setResidentMipLevel(m_residency.getResidentLevel(textureIndex));
+    }
+
+    void TextureStreamer::removeTexture(const Texture2D *pTexture)
+    {
+        auto iterator = m_mapTextureIndices.find(pTexture);
+        if (iterator == m_mapTextureIndices.end()) return;
+        uint32_t textureIndex = iterator->second;
+        auto &info = m_mapTextureInfos[textureIndex];
+        info.pTexture->setResidentMipLevel(0u);
+        for (auto pPass : info.pPasses)
+        {
+            pPass->apply();
+        }
+        m_residency.removeTexture(textureIndex);
+        m_mapTextureInfos.erase(textureIndex);
+        m_mapTextureIndices.erase(iterator);
+    }
+
+    Bool32 TextureStreamer::hasTexture(const Texture *pTexture) const
+    {
+        return m_mapTextureIndices.count(pTexture) != 0u ? VG_TRUE : VG_FALSE;
+    }
+
+    void TextureStreamer::requestMipLevel(const Texture *pTexture, uint32_t mipLevel)
+    {
+        auto iterator = m_mapTextureIndices.find(pTexture);
+        if (iterator == m_mapTextureIndices.end()) return;
+        m_residency.request(iterator->second, mipLevel);
+    }
+
+    void TextureStreamer::requestForVisualObject(const Scene3 *pScene
+        , const Scene3::ProjectorType *pProjector
+        , VisualObject3 *pVisualObject
+        , float uvDensity
+        , uint32_t viewportHeight
+        )
+    {
+        auto pMesh = dynamic_cast<const VisualObject3::MeshDimType *>(pVisualObject->getMesh());
+        if (pMesh == nullptr || pMesh->getIsHasBounds() == VG_FALSE) return;
+        auto pTransform = pVisualObject->getTransform();
+        auto bounds = pMesh->getBounds();
+        if (pScene->isInProjection(pProjector, pTransform, bounds) == VG_FALSE) return;
+
+        //Pixels per world unit of the object, sizes are diameters of the bounding sphere.
+        auto modelMatrix = pTransform->getMatrixLocalToWorld();
+        float maxScale = glm::max(glm::length(Vector3(modelMatrix[0])),
+            glm::max(glm::length(Vector3(modelMatrix[1])), glm::length(Vector3(modelMatrix[2]))));
+        float worldSize = glm::length(bounds.getSize()) * maxScale;
+        float screenSize = pScene->getProjectedSize(pProjector, pTransform, bounds);
+        float pixelsPerWorldUnit = worldSize > 0.0f ? screenSize * static_cast<float>(viewportHeight) / worldSize : 0.0f;
+
+        uint32_t materialCount = pVisualObject->getMaterialCount();
+        for (uint32_t materialIndex = 0u; materialIndex < materialCount; ++materialIndex)
+        {
+            auto pMaterial = pVisualObject->getMaterial(materialIndex);
+            uint32_t passCount = pMaterial->getPassCount();
+            for (uint32_t passIndex = 0u; passIndex < passCount; ++passIndex)
+            {
+                auto pPass = pMaterial->getPassWithIndex(passIndex);
+                for (const auto &name : pPass->getTextureNames())
+                {
+                    auto textureInfo = pPass->getTexture(name);
+                    for (uint32_t i = 0u; i < textureInfo.textureCount; ++i)
+                    {
+                        auto iterator = m_mapTextureIndices.find((textureInfo.pTextures + i)->pTexture);
+                        if (iterator == m_mapTextureIndices.end()) continue;
+                        auto &info = m_mapTextureInfos[iterator->second];
+                        info.pPasses.insert(pPass);
+                        auto pTexture = info.pTexture;
+                        uint32_t level = fd::caculateStreamingMipLevel(std::max(pTexture->getWidth(), pTexture->getHeight())
+                            , pTexture->getMipLevels()
+                            , uvDensity
+                            , pixelsPerWorldUnit
+                            );
+                        m_residency.request(iterator->second, level);
+                    }
+                }
+            }
+        }
+    }
+
+    void TextureStreamer::update()
+    {
+        m_residency.update(m_changes);
+        if (m_changes.size() == 0u) return;
+        Bool32 isInBatch = getIsInSingleTimeCommandBatch();
+        if (isInBatch == VG_FALSE) beginSingleTimeCommandBatch();
+        std::unordered_set<Pass *> pPasses;
+        for (const auto &change : m_changes)
+        {
+            auto &info = m_mapTextureInfos[change.textureIndex];
+            info.pTexture->setResidentMipLevel(change.residentLevel);
+            pPasses.insert(info.pPasses.begin(), info.pPasses.end());
+        }
+        if (isInBatch == VG_FALSE) endSingleTimeCommandBatch();
+
+        //Descriptor sets are updated with recreated images.
+        for (auto pPass : pPasses)
+        {
+            pPass->apply();
+        }
+    }
+
+    uint64_t TextureStreamer::getMemoryBudget() const
+    {
+        return m_residency.getMemoryBudget();
+    }
+
+    void TextureStreamer::setMemoryBudget(uint64_t value)
+    {
+        m_residency.setMemoryBudget(value);
+    }
+
+    uint32_t TextureStreamer::getMaxUploadCountPerUpdate() const
+    {
+        return m_residency.getMaxLoadCountPerUpdate();
+    }
+
+    void TextureStreamer::setMaxUploadCountPerUpdate(uint32_t value)
+    {
+        m_residency.setMaxLoadCountPerUpdate(value);
+    }
+
+    uint64_t TextureStreamer::getResidentMemorySize() const
+    {
+        return m_residency.getResidentSize();
+    }
+} //namespace vg
@@ -0,0 +1,67 @@
+#ifndef VG_TEXTURE_STREAMER_H
+#define VG_TEXTURE_STREAMER_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <foundation/texture_streaming.hpp>
+#include "graphics/global.hpp"
+#include "graphics/texture/texture_2d.hpp"
+#include "graphics/pass/pass.hpp"
+#include "graphics/scene/scene_3.hpp"
+#include "graphics/scene/visual_object_3.hpp"
+
+namespace vg
+{
+    /*Stream mip levels of 2d textures, only mip tails are resident at beginning. Finer levels are requested
+      every frame with projected sizes of objects using the textures, and they are uploaded at update with
+      a limited count and evicted with least recently used order when the memory budget is exceeded.
+      Data of all levels of the textures should be cached, textures should be added before passes using them
+      are applied.*/
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer(uint64_t memoryBudget = FD_TEXTURE_STREAMING_DEFAULT_MEMORY_BUDGET
+            , uint32_t maxUploadCountPerUpdate = FD_TEXTURE_STREAMING_DEFAULT_MAX_LOAD_COUNT
+            );
+
+        /*Levels from the mip tail level to the last level are always resident.*/
+        void addTexture(Texture2D *pTexture, uint32_t mipTailLevel);
+        //All levels of the texture become resident when it is removed.
+        void removeTexture(const Texture2D *pTexture);
+        Bool32 hasTexture(const Texture *pTexture) const;
+        void requestMipLevel(const Texture *pTexture, uint32_t mipLevel);
+        /*Request levels of streaming textures of passes of the visual object when it is in the projection,
+          uvDensity is texture coordinate units per world unit of its mesh, it can be got by fd::caculateUVDensity.
+          Passes of the object are applied when their textures are changed.*/
+        void requestForVisualObject(const Scene3 *pScene
+            , const Scene3::ProjectorType *pProjector
+            , VisualObject3 *pVisualObject
+            , float uvDensity
+            , uint32_t viewportHeight
+            );
+        /*Change resident levels of requested textures of this frame, uploads of one update are submitted
+          in a single time command batch.*/
+        void update();
+
+        uint64_t getMemoryBudget() const;
+        void setMemoryBudget(uint64_t value);
+        uint32_t getMaxUploadCountPerUpdate() const;
+        void setMaxUploadCountPerUpdate(uint32_t value);
+        uint64_t getResidentMemorySize() const;
+    private:
+        struct _TextureInfo
+        {
+            Texture2D *pTexture;
+            std::unordered_set<Pass *> pPasses;
+
+            _TextureInfo(Texture2D *pTexture = nullptr);
+        };
+
+        fd::TextureResidency m_residency;
+        std::unordered_map<const Texture *, uint32_t> m_mapTextureIndices;
+        std::unordered_map<uint32_t, _TextureInfo> m_mapTextureInfos;
+        std::vector<fd::TextureResidency::Change> m_changes;
+    };
+} //namespace vg
+
+#endif // !VG_TEXTURE_STREAMER_H
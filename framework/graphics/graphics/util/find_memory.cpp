@@ -16,5 +16,17 @@ namespace vg
         throw std::runtime_error("Failed to find suitable memory type!");
 
     }
-}
 
+    vk::Bool32 hasMemoryType(const vk::PhysicalDevice *pPhysicalDevice, uint32_t typeFilter, vk::MemoryPropertyFlags properties)
+    {
+        vk::PhysicalDeviceMemoryProperties memProperties = pPhysicalDevice->getMemoryProperties();
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; ++i)
+        {
+            if (typeFilter & (1 << i) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                return VK_TRUE;
+            }
+        }
+        return VK_FALSE;
+    }
+}
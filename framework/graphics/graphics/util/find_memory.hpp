@@ -5,6 +5,8 @@
 namespace vg
 {
     extern uint32_t findMemoryType(const vk::PhysicalDevice *pPhysicalDevice, uint32_t typeFilter, vk::MemoryPropertyFlags properties);
+    //It is used to check optional memory properties before findMemoryType throws for them.
+    extern vk::Bool32 hasMemoryType(const vk::PhysicalDevice *pPhysicalDevice, uint32_t typeFilter, vk::MemoryPropertyFlags properties);
 } //namespace fd
 
 #endif // !VG_FIND_MEMORY_H
@@ -20,9 +20,14 @@ namespace vg
         ObjectType caching(KeyType key);
         void end();
     private:
+        //Objects not cached in a frame are deleted when the frame ends, nodes of used objects are never moved.
+        struct _Item
+        {
+            ObjectType object;
+            Bool32 isUsed;
+        };
         Bool32 m_isDoing;
-        std::unordered_map<KeyType, ObjectType> m_mapObjects;
-        std::unordered_map<KeyType, ObjectType> m_mapOldObjects;
+        std::unordered_map<KeyType, _Item> m_mapObjects;
         Bool32 m_hasCreator;
         Creator m_creator;
     };
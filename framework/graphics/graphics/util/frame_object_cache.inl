@@ -4,7 +4,6 @@ namespace vg
     FrameObjectCache<KeyType, ObjectType>::FrameObjectCache()
         : m_isDoing()
         , m_mapObjects()
-        , m_mapOldObjects()
         , m_hasCreator()
         , m_creator()
     {
@@ -36,20 +35,20 @@ namespace vg
     void FrameObjectCache<KeyType, ObjectType>::begin()
     {
         m_isDoing = VG_TRUE;
-        m_mapOldObjects = m_mapObjects;
-        m_mapObjects.clear();
+        for (auto &pair : m_mapObjects)
+        {
+            pair.second.isUsed = VG_FALSE;
+        }
     }
 
     template <typename KeyType, typename ObjectType>
     ObjectType FrameObjectCache<KeyType, ObjectType>::caching(KeyType key)
     {
-        Bool32 isHas = m_mapOldObjects.count(key) != 0;
-        if (isHas)
+        auto iterator = m_mapObjects.find(key);
+        if (iterator != m_mapObjects.end())
         {
-            auto iterator = m_mapOldObjects.find(key);
-            auto oldObj = iterator->second;
-            m_mapObjects.insert({key, oldObj});
-            return oldObj;
+            iterator->second.isUsed = VG_TRUE;
+            return iterator->second.object;
         }
         else
         {
@@ -57,7 +56,8 @@ namespace vg
             if (m_hasCreator) {
                 newObj = m_creator(key);
             }
-            m_mapObjects.insert({key, newObj});
+            _Item item = {newObj, VG_TRUE};
+            m_mapObjects.insert({key, item});
             return newObj;
         }
     }
@@ -66,6 +66,10 @@ namespace vg
     void FrameObjectCache<KeyType, ObjectType>::end()
     {
         m_isDoing = VG_FALSE;
-        m_mapOldObjects.clear();
+        for (auto iterator = m_mapObjects.begin(); iterator != m_mapObjects.end();)
+        {
+            if (iterator->second.isUsed == VG_FALSE) iterator = m_mapObjects.erase(iterator);
+            else ++iterator;
+        }
     }
 } //vg
\ No newline at end of file
@@ -48,4 +48,28 @@ namespace vg
 
         return data;
     }
+
+    UsedQueueFamily UsedQueueFamily::findQueueFamilies(const vk::PhysicalDevice& physicalDevice)
+    {
+        UsedQueueFamily data;
+
+        auto queueFamilyProperties = physicalDevice.getQueueFamilyProperties();
+
+        int i = 0;
+        for (const auto& queueFamilyProperty : queueFamilyProperties)
+        {
+            if (queueFamilyProperty.queueCount > data.graphicsMaxQueueCount
+                && queueFamilyProperty.queueCount > 0 
+                && queueFamilyProperty.queueFlags & vk::QueueFlagBits::eGraphics)
+            {
+                data.graphicsFamily = i;
+                data.graphicsMaxQueueCount = queueFamilyProperty.queueCount;
+            }
+            ++i;
+        }
+        data.presentFamily = data.graphicsFamily;
+        data.presentMaxQueueCount = data.graphicsMaxQueueCount;
+
+        return data;
+    }
 } //namespace kgs
@@ -18,6 +18,8 @@ namespace vg
 
         UsedQueueFamily static findQueueFamilies(const vk::PhysicalDevice& physicalDevice
             , const vk::SurfaceKHR& surface);
+        //Without surface, the graphics family is used as present family, it is for headless applications.
+        UsedQueueFamily static findQueueFamilies(const vk::PhysicalDevice& physicalDevice);
     };
 }
 
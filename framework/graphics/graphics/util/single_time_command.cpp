@@ -3,7 +3,10 @@
 
 namespace vg
 {
-    std::shared_ptr<vk::CommandBuffer> beginSingleTimeCommands() {
+    static std::shared_ptr<vk::CommandBuffer> pBatchCommandBuffer = nullptr;
+    static std::vector<std::shared_ptr<void>> batchResources;
+
+    static std::shared_ptr<vk::CommandBuffer> _beginCommands() {
         auto pDevice = pApp->getDevice();
         auto pCommandPool = pApp->getCommandPoolForTransientBuffer();
         vk::CommandBufferAllocateInfo allocateInfo = {
@@ -24,7 +27,7 @@ namespace vg
         return pCommandBuffer;
     }
 
-    void endSingleTimeCommands(const std::shared_ptr<vk::CommandBuffer> &pCommandBuffer) {
+    static void _endCommands(const std::shared_ptr<vk::CommandBuffer> &pCommandBuffer) {
         auto pDevice = pApp->getDevice();
         vk::Queue queue;
         uint32_t queueIndex;
@@ -37,4 +40,41 @@ namespace vg
 
         pApp->freeGraphicsQueue(queueIndex);
     }
+
+    std::shared_ptr<vk::CommandBuffer> beginSingleTimeCommands() {
+        if (pBatchCommandBuffer != nullptr) return pBatchCommandBuffer;
+        return _beginCommands();
+    }
+
+    void endSingleTimeCommands(const std::shared_ptr<vk::CommandBuffer> &pCommandBuffer) {
+        if (pCommandBuffer == pBatchCommandBuffer) return;
+        _endCommands(pCommandBuffer);
+    }
+
+    void beginSingleTimeCommandBatch() {
+#ifdef DEBUG
+        if (pBatchCommandBuffer != nullptr)
+            throw std::runtime_error("Single time command batch is already begun.");
+#endif //DEBUG
+        pBatchCommandBuffer = _beginCommands();
+    }
+
+    void endSingleTimeCommandBatch() {
+#ifdef DEBUG
+        if (pBatchCommandBuffer == nullptr)
+            throw std::runtime_error("Single time command batch isn't begun.");
+#endif //DEBUG
+        auto pCommandBuffer = pBatchCommandBuffer;
+        pBatchCommandBuffer = nullptr;
+        _endCommands(pCommandBuffer);
+        batchResources.clear();
+    }
+
+    Bool32 getIsInSingleTimeCommandBatch() {
+        return pBatchCommandBuffer != nullptr ? VG_TRUE : VG_FALSE;
+    }
+
+    void holdSingleTimeCommandResource(const std::shared_ptr<void> &pResource) {
+        if (pBatchCommandBuffer != nullptr) batchResources.push_back(pResource);
+    }
 } //namespace kgs
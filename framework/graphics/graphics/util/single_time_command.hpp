@@ -9,5 +9,17 @@ namespace vg
     extern std::shared_ptr<vk::CommandBuffer> beginSingleTimeCommands();
 
     extern void endSingleTimeCommands(const std::shared_ptr<vk::CommandBuffer> &pCommandBuffer);
+
+    /*Single time commands between begin and end of a batch are recorded into one command buffer, 
+      which is submitted once when the batch is ended, so many uploads only wait queue once.*/
+    extern void beginSingleTimeCommandBatch();
+
+    extern void endSingleTimeCommandBatch();
+
+    extern Bool32 getIsInSingleTimeCommandBatch();
+
+    /*Keep resources used by single time commands alive until commands are finished, 
+      it is only needed in a batch, because commands out of batch are finished when they are ended.*/
+    extern void holdSingleTimeCommandResource(const std::shared_ptr<void> &pResource);
 } //namespace kgs
 #endif // !VG_SINGLE_TIME_COMMAND_H
@@ -10,13 +10,13 @@ namespace vg
 {
 //only map
 template <typename T>
-inline Bool32 hasValue(std::string name, const std::unordered_map<std::string, T> &map)
+inline Bool32 hasValue(const std::string &name, const std::unordered_map<std::string, T> &map)
 {
     return map.count(name) != 0;
 }
 
 template <typename T>
-inline const T &getValue(std::string name, const std::unordered_map<std::string, T> &map)
+inline const T &getValue(const std::string &name, const std::unordered_map<std::string, T> &map)
 {
     const auto &iterator = map.find(name);
     if (iterator == map.cend())
@@ -30,7 +30,7 @@ inline const T &getValue(std::string name, const std::unordered_map<std::string,
 }
 
 template <typename T>
-inline T &getValue(std::string name, std::unordered_map<std::string, T> &map)
+inline T &getValue(const std::string &name, std::unordered_map<std::string, T> &map)
 {
     const auto &iterator = map.find(name);
     if (iterator == map.cend())
@@ -44,7 +44,7 @@ inline T &getValue(std::string name, std::unordered_map<std::string, T> &map)
 }
 
 template <typename T>
-inline void setValue(std::string name, const T &value, std::unordered_map<std::string, T> &map)
+inline void setValue(const std::string &name, const T &value, std::unordered_map<std::string, T> &map)
 {
     const auto &iterator = map.find(name);
     if (iterator == map.cend())
@@ -58,7 +58,7 @@ inline void setValue(std::string name, const T &value, std::unordered_map<std::s
 }
 
 template <typename T>
-inline void addValue(std::string name, const T &value, std::unordered_map<std::string, T> &map)
+inline void addValue(const std::string &name, const T &value, std::unordered_map<std::string, T> &map)
 {
     const auto &iterator = map.find(name);
     if (iterator != map.cend())
@@ -69,20 +69,20 @@ inline void addValue(std::string name, const T &value, std::unordered_map<std::s
 }
 
 template <typename T>
-inline void removeValue(std::string name, std::unordered_map<std::string, T> &map)
+inline void removeValue(const std::string &name, std::unordered_map<std::string, T> &map)
 {
     map.erase(name);
 }
 
 //array and map
 template <typename T>
-inline Bool32 hasValue(std::string name, const std::unordered_map<std::string, T> &map, const std::vector<std::string> &arr)
+inline Bool32 hasValue(const std::string &name, const std::unordered_map<std::string, T> &map, const std::vector<std::string> &arr)
 {
     return map.count(name) != 0;
 }
 
 template <typename T>
-inline const T &getValue(std::string name, const std::unordered_map<std::string, T> &map, const std::vector<std::string> &arr)
+inline const T &getValue(const std::string &name, const std::unordered_map<std::string, T> &map, const std::vector<std::string> &arr)
 {
     const auto &iterator = map.find(name);
     if (iterator == map.cend())
@@ -96,7 +96,7 @@ inline const T &getValue(std::string name, const std::unordered_map<std::string,
 }
 
 template <typename T>
-inline T &getValue(std::string name, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
+inline T &getValue(const std::string &name, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
 {
     const auto &iterator = map.find(name);
     if (iterator == map.cend())
@@ -110,7 +110,7 @@ inline T &getValue(std::string name, std::unordered_map<std::string, T> &map, st
 }
 
 template <typename T>
-inline void setValue(std::string name, const T &value, std::unordered_map<std::string, T> &map,
+inline void setValue(const std::string &name, const T &value, std::unordered_map<std::string, T> &map,
                      std::vector<std::string> &arr)
 {
     {
@@ -127,7 +127,7 @@ inline void setValue(std::string name, const T &value, std::unordered_map<std::s
 }
 
 template <typename T>
-inline void addValue(std::string name, const T &value, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
+inline void addValue(const std::string &name, const T &value, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
 {
     {
         const auto &iterator = map.find(name);
@@ -148,7 +148,7 @@ inline void addValue(std::string name, const T &value, std::unordered_map<std::s
 }
 
 template <typename T>
-inline void removeValue(std::string name, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
+inline void removeValue(const std::string &name, std::unordered_map<std::string, T> &map, std::vector<std::string> &arr)
 {
     map.erase(name);
     auto iterator = std::find(arr.begin(), arr.end(), name);
@@ -0,0 +1,20 @@
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (set = 0, binding = 0) uniform sampler2D colorTex;
+layout (set = 0, binding = 1) uniform sampler2D depthTex;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+void main() 
+{
+    //Pixels without deferred objects keep content of the trunk.
+    float depth = texture(depthTex, inUV).r;
+    if (depth >= 1.0) discard;
+    outColor = texture(colorTex, inUV);
+    gl_FragDepth = depth;
+}
\ No newline at end of file
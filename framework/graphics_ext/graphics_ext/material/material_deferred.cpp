@@ -28,9 +28,7 @@ namespace vge
         , m_pColorAttachment()
         , m_pDepthStencilAttachment()
         , m_arrPDeferredAttachments()
-        , m_pRectMesh(std::shared_ptr<vg::DimSepMesh2>{
-                new vg::DimSepMesh2(vk::MemoryPropertyFlagBits::eHostVisible)
-            })
+        , m_pRectMesh()
     {
         m_deferredAttachmentInfos.resize(info.deferredAttachmentCount);
         memcpy(m_deferredAttachmentInfos.data(), 
@@ -43,6 +41,7 @@ namespace vge
         _createFramebuffer();
         _createOtherPasses(info);
         _initPasses(info);
+        _createRectMesh();
     }
 
     void MaterialDeferred::_beginBind(const BindInfo info, BindResult *pResult) const
@@ -112,26 +111,25 @@ namespace vge
             point.x = point.x * 2 - 1;
             point.y = point.y * 2 - 1;
         }
-    
-        std::vector<uint32_t> indices = {
-            0, 1, 3, 3, 1, 2
-        };
-    
-        pRectMesh->setVertexCount(static_cast<uint32_t>(rectPoses.size()));
-        if (m_pRectMesh->hasPositions() == VG_TRUE)
-        {
-            m_pRectMesh->removePositions();
-        }
-        pRectMesh->addPositions(rectPoses);
-        if (m_pRectMesh->hasTextureCoordinates<vg::TextureCoordinateType::VECTOR_2, vg::TextureCoordinateIndex::TextureCoordinate_0>() == VG_TRUE)
+
+        //Vertices of the rect are written into the transient buffer, so every bind in a frame keeps its own rect.
+        const auto &subVertexData = *(pRectMesh->getVertexData()->getSubVertexDatas());
+        const auto &inputStateInfo = subVertexData.vertexInputStateInfo;
+        auto allocation = vg::pDefaultTransientBuffer->allocate(subVertexData.bufferSize);
+        //Attributes are in order of adding to the mesh, position is first and uv is second.
+        const std::vector<vg::Vector2> *pAttributes[2] = {&rectPoses, &rectUVs};
+        for (uint32_t i = 0u; i < 2u; ++i)
         {
-            m_pRectMesh->removeTextureCoordinates<vg::TextureCoordinateType::VECTOR_2, vg::TextureCoordinateIndex::TextureCoordinate_0>();
+            const auto &attrDesc = inputStateInfo.pVertexAttributeDescriptions[i];
+            uint32_t stride = inputStateInfo.pVertexBindingDescriptions[attrDesc.binding].stride;
+            uint32_t offset = subVertexData.pBindingBufferOffsets[attrDesc.binding] + attrDesc.offset;
+            for (uint32_t j = 0u; j < 4u; ++j)
+            {
+                memcpy(static_cast<char *>(allocation.pMemory) + offset + j * stride,
+                    &(*pAttributes[i])[j], sizeof(vg::Vector2));
+            }
         }
-        pRectMesh->addTextureCoordinates<vg::TextureCoordinateType::VECTOR_2, vg::TextureCoordinateIndex::TextureCoordinate_0>(
-            rectUVs
-        );
-        pRectMesh->setIndices(indices, vg::PrimitiveTopology::TRIANGLE_LIST, 0u);
-        pRectMesh->apply(VG_TRUE);
+        vg::CmdGeometryBinding geometryBinding(allocation.pBuffer, allocation.offset);
     
         auto &result = *pResult;
 
@@ -183,6 +181,7 @@ namespace vge
             renderPassInfo.viewport = viewport;
             renderPassInfo.scissor = scissor;
             renderPassInfo.objectID = info.objectID;
+            renderPassInfo.omniDirectional = info.omniDirectional;
     
             vg::CmdInfo cmdInfo;
             cmdInfo.pRenderPassInfo = &renderPassInfo;
@@ -239,6 +238,7 @@ namespace vge
             trunkRenderPassInfo.viewport = fd::Viewport();
             trunkRenderPassInfo.scissor = info.hasClipRect ? info.clipRect : fd::Rect2D();
             trunkRenderPassInfo.objectID = info.objectID;
+            trunkRenderPassInfo.pGeometryBinding = &geometryBinding;
     
             vg::CmdInfo cmdInfo;
             cmdInfo.pRenderPassInfo = &trunkRenderPassInfo;
@@ -610,6 +610,34 @@ namespace vge
         }
     }
 
+    void MaterialDeferred::_createRectMesh()
+    {
+        //Only layout and indices of the mesh are used, vertices of every bind are in the transient buffer.
+        m_pRectMesh = std::shared_ptr<vg::DimSepMesh2>{new vg::DimSepMesh2()};
+        std::vector<vg::Vector2> rectPoses = {
+            vg::Vector2{-1.0f, -1.0f},
+            vg::Vector2{1.0f, -1.0f},
+            vg::Vector2{1.0f, 1.0f},
+            vg::Vector2{-1.0f, 1.0f},
+        };
+        std::vector<vg::Vector2> rectUVs = {
+            vg::Vector2{0.0f, 0.0f},
+            vg::Vector2{1.0f, 0.0f},
+            vg::Vector2{1.0f, 1.0f},
+            vg::Vector2{0.0f, 1.0f},
+        };
+        std::vector<uint32_t> indices = {
+            0, 1, 3, 3, 1, 2
+        };
+        m_pRectMesh->setVertexCount(static_cast<uint32_t>(rectPoses.size()));
+        m_pRectMesh->addPositions(rectPoses);
+        m_pRectMesh->addTextureCoordinates<vg::TextureCoordinateType::VECTOR_2, vg::TextureCoordinateIndex::TextureCoordinate_0>(
+            rectUVs
+        );
+        m_pRectMesh->setIndices(indices, vg::PrimitiveTopology::TRIANGLE_LIST, 0u);
+        m_pRectMesh->apply(VG_TRUE);
+    }
+
     vg::DimSepMesh2 *MaterialDeferred::_getRectMesh() const
     {
         return m_pRectMesh.get();
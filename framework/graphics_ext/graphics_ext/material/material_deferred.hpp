@@ -58,6 +58,7 @@ namespace vge
         void _createFramebuffer();
         void _createOtherPasses(CreateInfo createInfo);
         void _initPasses(CreateInfo createInfo);              
+        void _createRectMesh();
 
          vg::DimSepMesh2 *_getRectMesh() const;
 
@@ -65,6 +65,7 @@ namespace vge
             trunkRenderPassInfo.viewport = fd::Viewport();
             trunkRenderPassInfo.scissor = info.hasClipRect ? info.clipRect : fd::Rect2D();
             trunkRenderPassInfo.objectID = info.objectID;
+            trunkRenderPassInfo.omniDirectional = info.omniDirectional;
 
             vg::CmdInfo cmdInfo;
             cmdInfo.pRenderPassInfo = &trunkRenderPassInfo;
@@ -86,6 +87,7 @@ namespace vge
             trunkRenderPassInfo.subMeshIndex = info.subMeshIndex;
             trunkRenderPassInfo.viewport = fd::Viewport();
             trunkRenderPassInfo.objectID = info.objectID;
+            trunkRenderPassInfo.omniDirectional = info.omniDirectional;
 
             fd::Rect2D clipRect = fd::Rect2D();
             if (info.hasClipRect)
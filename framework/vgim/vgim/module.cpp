@@ -242,8 +242,9 @@ namespace vgim
             ++vertexSubDataCount;
         }
 
-        pVertexData->updateBuffer(vertexSlices, vertexSize, VG_FALSE);
-        pIndexData->updateBuffer(indexSlices, indexSize, VG_FALSE);
+        //UI is rebuilt every frame, so it is written to the transient buffer without creating buffers.
+        pVertexData->updateTransientBuffer(vg::pDefaultTransientBuffer.get(), vertexSlices, vertexSize);
+        pIndexData->updateTransientBuffer(vg::pDefaultTransientBuffer.get(), indexSlices, indexSize);
 
         pVertexData->updateSubDataCount(vertexSubDataCount);
         if (vertexSubDataCount)
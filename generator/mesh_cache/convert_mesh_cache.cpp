@@ -0,0 +1,120 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <sampleslib/scene_assimp.hpp>
+
+using VertexLayoutComponent = sampleslib::AssimpScene::VertexLayoutComponent;
+
+bool parse_layout(const char* str, std::vector<VertexLayoutComponent> &layouts)
+{
+    struct ComponentName {
+        const char* name;
+        VertexLayoutComponent component;
+    };
+    const ComponentName names[] = {
+        { "position", VertexLayoutComponent::VERTEX_COMPONENT_POSITION },
+        { "normal", VertexLayoutComponent::VERTEX_COMPONENT_NORMAL },
+        { "color", VertexLayoutComponent::VERTEX_COMPONENT_COLOR },
+        { "uv", VertexLayoutComponent::VERTEX_COMPONENT_UV },
+        { "tangent", VertexLayoutComponent::VERTEX_COMPONENT_TANGENT },
+        { "bitangent", VertexLayoutComponent::VERTEX_COMPONENT_BITANGENT },
+        { "dummy_float", VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_FLOAT },
+        { "dummy_vec4", VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_VEC4 },
+    };
+    std::string layoutStr(str);
+    size_t start = 0u;
+    while (start <= layoutStr.size()) {
+        size_t end = layoutStr.find(',', start);
+        if (end == std::string::npos) end = layoutStr.size();
+        std::string name = layoutStr.substr(start, end - start);
+        bool found = false;
+        for (const auto &componentName : names) {
+            if (name == componentName.name) {
+                layouts.push_back(componentName.component);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Unknown vertex layout component: %s\n", name.c_str());
+            return false;
+        }
+        start = end + 1u;
+    }
+    return true;
+}
+
+void print_usage()
+{
+    fprintf(stderr, "Usage: convert_mesh_cache <input model file> <output cache file> <layout> [options]\n"
+        "  layout: components separated by comma, eg. position,color,normal,uv\n"
+        "    components: position, normal, color, uv, tangent, bitangent, dummy_float, dummy_vec4\n"
+        "  options should be same as the create info of AssimpScene loading the cache:\n"
+        "    --offset x y z\n"
+        "    --scale x y z\n"
+        "    --uv-scale s t\n"
+        "    --right-hand\n"
+        "    --multiple-mesh\n"
+        "    --optimize-mesh\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4) {
+        print_usage();
+        return 4;
+    }
+    const char * inputFilePath = argv[1];
+    const char * outputFilePath = argv[2];
+    std::vector<VertexLayoutComponent> layouts;
+    if (!parse_layout(argv[3], layouts)) {
+        print_usage();
+        return 4;
+    }
+
+    sampleslib::AssimpScene::CreateInfo createInfo;
+    createInfo.fileName = inputFilePath;
+    createInfo.layoutComponentCount = static_cast<uint32_t>(layouts.size());
+    createInfo.pLayoutComponent = layouts.data();
+    for (int i = 4; i < argc; ++i) {
+        if (strcmp(argv[i], "--offset") == 0 && i + 3 < argc) {
+            createInfo.offset = vg::Vector3(atof(argv[i + 1]), atof(argv[i + 2]), atof(argv[i + 3]));
+            i += 3;
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 3 < argc) {
+            createInfo.scale = vg::Vector3(atof(argv[i + 1]), atof(argv[i + 2]), atof(argv[i + 3]));
+            i += 3;
+        } else if (strcmp(argv[i], "--uv-scale") == 0 && i + 2 < argc) {
+            createInfo.uvScale = vg::Vector2(atof(argv[i + 1]), atof(argv[i + 2]));
+            i += 2;
+        } else if (strcmp(argv[i], "--right-hand") == 0) {
+            createInfo.isRightHand = VG_TRUE;
+        } else if (strcmp(argv[i], "--multiple-mesh") == 0) {
+            createInfo.multipleMesh = VG_TRUE;
+        } else if (strcmp(argv[i], "--optimize-mesh") == 0) {
+            createInfo.optimizeMesh = VG_TRUE;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage();
+            return 4;
+        }
+    }
+
+    sampleslib::AssimpScene::ImportedData data;
+    try {
+        sampleslib::AssimpScene::importData(createInfo, data);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "Failed to import %s: %s\n", inputFilePath, e.what());
+        return 1;
+    }
+    if (sampleslib::AssimpScene::writeCache(createInfo, data, outputFilePath) == VG_FALSE) {
+        fprintf(stderr, "Failed to write mesh cache %s\n", outputFilePath);
+        return 2;
+    }
+    printf("Mesh cache %s: %d meshes, %d vertices, %d indices.\n", outputFilePath,
+        static_cast<int>(data.vertexCounts.size()),
+        static_cast<int>(data.vertexBuffer.size() * sizeof(float) / (data.vertexSize != 0u ? data.vertexSize : 1u)),
+        static_cast<int>(data.indexBuffer.size()));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include <gli/gli.hpp>
+#include <foundation/foundation.hpp>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+struct FormatName {
+    const char* name;
+    fd::BlockFormat blockFormat;
+    gli::format format;
+    gli::format srgbFormat;
+};
+
+const FormatName formatNames[] = {
+    { "bc1", fd::BlockFormat::BC1, gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::FORMAT_RGBA_DXT1_SRGB_BLOCK8 },
+    { "bc2", fd::BlockFormat::BC2, gli::FORMAT_RGBA_DXT3_UNORM_BLOCK16, gli::FORMAT_RGBA_DXT3_SRGB_BLOCK16 },
+    { "bc3", fd::BlockFormat::BC3, gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16, gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16 },
+    { "bc4", fd::BlockFormat::BC4, gli::FORMAT_R_ATI1N_UNORM_BLOCK8, gli::FORMAT_UNDEFINED },
+    { "bc5", fd::BlockFormat::BC5, gli::FORMAT_RG_ATI2N_UNORM_BLOCK16, gli::FORMAT_UNDEFINED },
+};
+
+void print_usage()
+{
+    fprintf(stderr, "Usage: compress_texture <input image file> <output ktx file> <format> [options]\n"
+        "  format: bc1, bc2, bc3, bc4 or bc5\n"
+        "    bc4 uses the red channel and bc5 uses the red and green channels of the image.\n"
+        "  options:\n"
+        "    --srgb, data is in srgb color space, it is only valid for bc1, bc2 and bc3.\n"
+        "    --no-mipmaps\n"
+        "    --kaiser, mipmaps are filtered by kaiser filter instead of box filter.\n"
+        "    --alpha-cutoff value, alpha coverage of mipmaps with the cutoff is kept for cutout textures.\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4) {
+        print_usage();
+        return 4;
+    }
+    const char * inputFilePath = argv[1];
+    const char * outputFilePath = argv[2];
+    const FormatName *pFormatName = nullptr;
+    for (const auto &formatName : formatNames) {
+        if (strcmp(argv[3], formatName.name) == 0) {
+            pFormatName = &formatName;
+            break;
+        }
+    }
+    if (pFormatName == nullptr) {
+        fprintf(stderr, "Unknown format: %s\n", argv[3]);
+        print_usage();
+        return 4;
+    }
+    bool isSrgb = false;
+    bool isMipmaps = true;
+    fd::MipmapGenerateInfo mipmapInfo;
+    for (int i = 4; i < argc; ++i) {
+        if (strcmp(argv[i], "--srgb") == 0 && pFormatName->srgbFormat != gli::FORMAT_UNDEFINED) {
+            isSrgb = true;
+        } else if (strcmp(argv[i], "--no-mipmaps") == 0) {
+            isMipmaps = false;
+        } else if (strcmp(argv[i], "--kaiser") == 0) {
+            mipmapInfo.filter = fd::MipmapFilter::KAISER;
+        } else if (strcmp(argv[i], "--alpha-cutoff") == 0 && i + 1 < argc) {
+            mipmapInfo.isPreserveAlphaCoverage = FD_TRUE;
+            mipmapInfo.alphaCutoff = static_cast<float>(atof(argv[i + 1]));
+            i += 1;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage();
+            return 4;
+        }
+    }
+
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc *pImage = stbi_load(inputFilePath, &imageWidth, &imageHeight, &imageChannels, STBI_rgb_alpha);
+    if (pImage == nullptr) {
+        fprintf(stderr, "Failed to load image %s: %s\n", inputFilePath, stbi_failure_reason());
+        return 1;
+    }
+    uint32_t width = static_cast<uint32_t>(imageWidth);
+    uint32_t height = static_cast<uint32_t>(imageHeight);
+    auto blockFormat = pFormatName->blockFormat;
+    uint32_t channelCount = fd::getBlockFormatChannelCount(blockFormat);
+    gli::texture2d::extent_type extent(width, height);
+    uint32_t levelCount = isMipmaps ? static_cast<uint32_t>(gli::levels(extent)) : 1u;
+    //Filtering of mipmaps is deterministic, so same image always gets same file.
+    auto channelType = isSrgb ? fd::MipmapChannelType::SRGB8 : fd::MipmapChannelType::UNORM8;
+    std::vector<uint8_t> pixels(fd::caculateMipmapLevelOffset(channelType, channelCount, width, height, 1u, levelCount));
+    for (uint32_t i = 0; i < width * height; ++i) {
+        for (uint32_t c = 0; c < channelCount; ++c) pixels[i * channelCount + c] = pImage[i * 4u + c];
+    }
+    stbi_image_free(pImage);
+    fd::generateMipmaps(channelType, channelCount, mipmapInfo, width, height, 1u, levelCount, pixels.data());
+
+    gli::texture2d texture(isSrgb ? pFormatName->srgbFormat : pFormatName->format, extent, levelCount);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t levelWidth = std::max(1u, width >> level);
+        uint32_t levelHeight = std::max(1u, height >> level);
+        if (texture.size(level) != fd::getBlockCompressedSize(blockFormat, levelWidth, levelHeight)) {
+            fprintf(stderr, "Size of level %d is different from size of the ktx texture.\n", static_cast<int>(level));
+            return 2;
+        }
+        const uint8_t *pLevelPixels = pixels.data() +
+            fd::caculateMipmapLevelOffset(channelType, channelCount, width, height, 1u, level);
+        fd::compressBlocks(blockFormat, pLevelPixels, levelWidth, levelHeight,
+            static_cast<uint8_t *>(texture.data(0, 0, level)));
+    }
+
+    if (gli::save_ktx(texture, outputFilePath) == false) {
+        fprintf(stderr, "Failed to write ktx file %s\n", outputFilePath);
+        return 2;
+    }
+    printf("Compressed texture %s: %s, %dx%d, %d levels.\n", outputFilePath, pFormatName->name,
+        imageWidth, imageHeight, static_cast<int>(levelCount));
+    return EXIT_SUCCESS;
+}
@@ -82,9 +82,11 @@ void Window::_createModel()
     createInfo.layoutComponentCount = layoutCount - 1;
     createInfo.pLayoutComponent = layouts;
     createInfo.offset = vg::Vector3(0.0f, 0.0f, 0.0f);
+    createInfo.cacheFileName = "models/samplebuilding.meshcache";
     m_assimpScene.init(createInfo);
 
     createInfo.fileName = "models/samplebuilding_glass.dae";
+    createInfo.cacheFileName = "models/samplebuilding_glass.meshcache";
     createInfo.layoutComponentCount = layoutCount; //add uv component.
     m_assimpSceneGlass.init(createInfo);
 }
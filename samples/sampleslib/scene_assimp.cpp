@@ -17,6 +17,8 @@ namespace sampleslib
         , vg::Bool32 isRightHand
         , vg::Bool32 multipleObject
         , vg::Bool32 multipleMesh
+        , vg::Bool32 optimizeMesh
+        , const char *cacheFileName
         )
         : fileName(fileName)
         , layoutComponentCount(layoutComponentCount)
@@ -28,6 +30,20 @@ namespace sampleslib
         , isRightHand(isRightHand)
         , multipleObject(multipleObject)
         , multipleMesh(multipleMesh)
+        , optimizeMesh(optimizeMesh)
+        , cacheFileName(cacheFileName)
+    {
+    }
+
+    AssimpScene::ImportedData::ImportedData()
+        : vertexSize(0u)
+        , vertexBuffer()
+        , indexBuffer()
+        , vertexCounts()
+        , indexCounts()
+        , materialIndices()
+        , boundses()
+        , materials()
     {
     }
 
@@ -63,9 +79,25 @@ namespace sampleslib
         return m_pObjects;
     }
 
-    void AssimpScene::_init(const CreateInfo &createInfo)
+    uint64_t AssimpScene::getCacheKey(const CreateInfo &createInfo)
+    {
+        const uint32_t version = SAMPLES_LIB_SCENE_ASSIMP_CACHE_VERSION;
+        uint64_t key = fd::hashMeshCacheKey(&version, sizeof(version));
+        //Changed source is found with its size, modification time and sampled content.
+        key = fd::hashMeshCacheSource(createInfo.fileName, key);
+        key = fd::hashMeshCacheKey(createInfo.pLayoutComponent, 
+            createInfo.layoutComponentCount * static_cast<uint32_t>(sizeof(VertexLayoutComponent)), key);
+        key = fd::hashMeshCacheKey(&createInfo.offset, sizeof(createInfo.offset), key);
+        key = fd::hashMeshCacheKey(&createInfo.scale, sizeof(createInfo.scale), key);
+        key = fd::hashMeshCacheKey(&createInfo.uvScale, sizeof(createInfo.uvScale), key);
+        key = fd::hashMeshCacheKey(&createInfo.isRightHand, sizeof(createInfo.isRightHand), key);
+        key = fd::hashMeshCacheKey(&createInfo.multipleMesh, sizeof(createInfo.multipleMesh), key);
+        key = fd::hashMeshCacheKey(&createInfo.optimizeMesh, sizeof(createInfo.optimizeMesh), key);
+        return key;
+    }
+
+    void AssimpScene::importData(const CreateInfo &createInfo, ImportedData &data)
     {
-        const auto &device = vg::pApp->getDevice();
         Assimp::Importer importer;
         const aiScene* pScene;
 
@@ -81,74 +113,8 @@ namespace sampleslib
         else
         {
             uint32_t meshCount = pScene->mNumMeshes;
-            //Constructing the shared vertex buffer data.
-            auto &pSharedVertexData = m_pSharedVertexData;
-            auto &pSharedIndexData = m_pSharedIndexData;
-
-            uint32_t vertexSize = 0u;
-            {
-                //Constructing vertex input binding description and attribute description.
-                uint32_t componentCount = createInfo.layoutComponentCount;
-                const VertexLayoutComponent *pComponent = createInfo.pLayoutComponent;
-                uint32_t binding = 0u;
-                uint32_t stride = 0u;
-                uint32_t offset = 0u;
-                vk::Format format;
-                std::vector<vk::VertexInputAttributeDescription> attributeDescs(componentCount);
-                for (uint32_t i = 0; i < componentCount; ++i)
-                {
-                    switch (*(pComponent + i))
-                    {
-                    case VertexLayoutComponent::VERTEX_COMPONENT_UV:
-                        stride += 2u * static_cast<uint32_t>(sizeof(float));
-                        format = vk::Format::eR32G32Sfloat;
-                        break;
-                    case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_FLOAT:
-                        stride += static_cast<uint32_t>(sizeof(float));
-                        format = vk::Format::eR32Sfloat;
-                        break;
-                    case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_VEC4:
-                        stride += 4u * static_cast<uint32_t>(sizeof(float));
-                        format = vk::Format::eR32G32B32A32Sfloat;
-                        break;
-                    default:
-                        // All components except the ones listed above are made up of 3 floats
-                        stride += 3u * static_cast<uint32_t>(sizeof(float));
-                        format = vk::Format::eR32G32B32Sfloat;
-                    }
-    
-                    attributeDescs[i].binding = binding;
-                    attributeDescs[i].location = i;
-                    attributeDescs[i].format = format;
-                    attributeDescs[i].offset = offset;
-                    
-                    offset = stride;
-                }
-                vk::VertexInputBindingDescription bindingDesc[1] = {};
-                bindingDesc[0].binding = binding;
-                bindingDesc[0].stride = stride;
-                bindingDesc[0].inputRate = vk::VertexInputRate::eVertex;
-
-                uint32_t bindingBufferOffsets[1] = { 0u };
-    
-                //Constructing pipeline vertex input state create info.
-                vk::PipelineVertexInputStateCreateInfo vertexInfo = {};
-                vertexInfo.vertexBindingDescriptionCount = 1u;
-                vertexInfo.pVertexBindingDescriptions = bindingDesc;
-                vertexInfo.vertexAttributeDescriptionCount = attributeDescs.size();
-                vertexInfo.pVertexAttributeDescriptions = attributeDescs.data();
-        
-                //Constructing pipeline input assembly state create info.
-                vk::PipelineInputAssemblyStateCreateInfo iaInfo = {};
-                iaInfo.topology = vk::PrimitiveTopology::eTriangleList;
-    
-                pSharedVertexData->updateDesData(vertexInfo, bindingBufferOffsets);
-                pSharedIndexData->updateDesData(vk::IndexType::eUint32, iaInfo);
-
-                vertexSize = stride;
-            }
-
-            std::vector<fd::Bounds<vg::Vector3>> boundses(meshCount);
+            uint32_t vertexSize = _getVertexSize(createInfo);
+            data.vertexSize = vertexSize;
 
             {
                 uint32_t vertexSubDataCount = meshCount;
@@ -157,20 +123,49 @@ namespace sampleslib
                 vg::Vector3 scale = createInfo.scale;
                 vg::Vector2 uvScale = createInfo.uvScale;
                 vg::Vector3 offset = createInfo.offset;
+                //If it isn't right hand, y will be inversed and then positions and normals are rotated.
+                vg::Quaternion leftHandRotation(vg::Vector3(glm::radians(180.0f), glm::radians(0.0f), glm::radians(0.0f)));
     
-                std::vector<uint32_t> vertexCounts(vertexSubDataCount);
-                std::vector<uint32_t> vertexBufferSizes(vertexSubDataCount);
-    
-                std::vector<uint32_t> indexCounts(indexSubDataCount);
-                std::vector<uint32_t> indexBufferSizes(indexSubDataCount);
-                std::vector<uint32_t> indexVertexDataIndices(indexSubDataCount);
-        
-                std::vector<float> vertexBuffer;
-                std::vector<uint32_t> indexBuffer;
-    
+                auto &vertexCounts = data.vertexCounts;
+                vertexCounts.resize(vertexSubDataCount);
+                auto &indexCounts = data.indexCounts;
+                indexCounts.resize(indexSubDataCount);
+                auto &materialIndices = data.materialIndices;
+                materialIndices.resize(indexSubDataCount);
+                auto &boundses = data.boundses;
+                boundses.resize(meshCount);
+
+                //Offsets of every mesh in the packed buffers are got by prefix sum of counts, 
+                //so meshes can be packed in parallel into the preallocated buffers.
+                std::vector<uint32_t> vertexOffsets(meshCount);
+                std::vector<uint32_t> indexOffsets(meshCount);
+                uint32_t totalVertexCount = 0u;
+                uint32_t totalIndexCount = 0u;
                 for (uint32_t i = 0; i < meshCount; ++i)
                 {
                     const aiMesh *paiMesh = pScene->mMeshes[i];
+                    uint32_t indexCount = 0u;
+                    uint32_t faceCount = paiMesh->mNumFaces;
+                    for (uint32_t j = 0; j < faceCount; ++j)
+                    {
+                        if (paiMesh->mFaces[j].mNumIndices == 3) indexCount += 3u;
+                    }
+                    vertexCounts[i] = paiMesh->mNumVertices;
+                    indexCounts[i] = indexCount;
+                    materialIndices[i] = paiMesh->mMaterialIndex;
+                    vertexOffsets[i] = totalVertexCount;
+                    indexOffsets[i] = totalIndexCount;
+                    totalVertexCount += paiMesh->mNumVertices;
+                    totalIndexCount += indexCount;
+                }
+        
+                auto &vertexBuffer = data.vertexBuffer;
+                vertexBuffer.resize(static_cast<size_t>(totalVertexCount) * vertexSize / sizeof(float));
+                auto &indexBuffer = data.indexBuffer;
+                indexBuffer.resize(totalIndexCount);
+
+                auto packMesh = [&](uint32_t i) {
+                    const aiMesh *paiMesh = pScene->mMeshes[i];
     
                     aiColor3D diffuseColor(0.0f, 0.0f, 0.0f);
                     pScene->mMaterials[paiMesh->mMaterialIndex]->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor);
@@ -180,12 +175,12 @@ namespace sampleslib
                     vg::Vector3 minOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::max());
                     vg::Vector3 maxOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::lowest());
     
-                    uint32_t vertexCount = paiMesh->mNumVertices;
-                    vertexCounts[i] = vertexCount;
-
+                    uint32_t vertexCount = vertexCounts[i];
+                    uint32_t indexCount = indexCounts[i];
                     uint32_t vertexBufferSize = vertexSize * vertexCount;
-                    uint32_t indexCount = 0u;
-                    uint32_t indexBufferSize = 0u;          
+                    float *pVertices = vertexBuffer.data() + static_cast<size_t>(vertexOffsets[i]) * vertexSize / sizeof(float);
+                    uint32_t *pIndices = indexBuffer.data() + indexOffsets[i];
+                    float *pVertex = pVertices;
                     for (uint32_t j = 0; j < vertexCount; ++j)
                     {
                         const aiVector3D *pPos = &(paiMesh->mVertices[j]);
@@ -211,8 +206,7 @@ namespace sampleslib
                                 if (! createInfo.isRightHand) {
                                     y = - pPos->y;
                                     vg::Vector4 temp(x, y, z, 1.0f);
-                                    vg::Quaternion tempQ(vg::Vector3(glm::radians(180.0f), glm::radians(0.0f), glm::radians(0.0f)));
-                                    temp = tempQ * temp;
+                                    temp = leftHandRotation * temp;
                                     x = temp.x;
                                     y = temp.y;
                                     z = temp.z;
@@ -225,9 +219,9 @@ namespace sampleslib
                                 x = x * scale.x + offset.x;
                                 y = y * scale.y + offset.y;
                                 z = z * scale.z + offset.z;
-                                vertexBuffer.push_back(x);
-                                vertexBuffer.push_back(y);
-                                vertexBuffer.push_back(z);
+                                *pVertex++ = x;
+                                *pVertex++ = y;
+                                *pVertex++ = z;
 
                                 //bounds...
                                 if (minOfBounds.x > x)minOfBounds.x = x;
@@ -248,8 +242,7 @@ namespace sampleslib
                                 if (! createInfo.isRightHand) {
                                     y = - pNormal->y;
                                     vg::Vector4 temp(x, y, z, 0.0f);
-                                    vg::Quaternion tempQ(vg::Vector3(glm::radians(180.0f), glm::radians(0.0f), glm::radians(0.0f)));
-                                    temp = tempQ * temp;
+                                    temp = leftHandRotation * temp;
                                     temp = glm::normalize(temp);
                                     x = temp.x;
                                     y = temp.y;
@@ -258,238 +251,459 @@ namespace sampleslib
                                 else {
                                     y = pNormal->y;
                                 }
-                                vertexBuffer.push_back(x);
-                                vertexBuffer.push_back(y);
-                                vertexBuffer.push_back(z);
+                                *pVertex++ = x;
+                                *pVertex++ = y;
+                                *pVertex++ = z;
                                 break;
                             }
                             case VertexLayoutComponent::VERTEX_COMPONENT_UV:
                             {
-                                vertexBuffer.push_back(pTexCoord->x * uvScale.s);
-                                vertexBuffer.push_back(pTexCoord->y * uvScale.t);
+                                *pVertex++ = pTexCoord->x * uvScale.s;
+                                *pVertex++ = pTexCoord->y * uvScale.t;
                                 break;
                             }
                             case VertexLayoutComponent::VERTEX_COMPONENT_COLOR:
                             {
-                                vertexBuffer.push_back(pColor->r * diffuseColor.r);
-                                vertexBuffer.push_back(pColor->g * diffuseColor.g);
-                                vertexBuffer.push_back(pColor->b * diffuseColor.b);
+                                *pVertex++ = pColor->r * diffuseColor.r;
+                                *pVertex++ = pColor->g * diffuseColor.g;
+                                *pVertex++ = pColor->b * diffuseColor.b;
                                 break;
                             }
                             case VertexLayoutComponent::VERTEX_COMPONENT_TANGENT:
                             {
-                                vertexBuffer.push_back(pTangent->x);
-                                vertexBuffer.push_back(yDelta * pTangent->y);
-                                vertexBuffer.push_back(pTangent->z);
+                                *pVertex++ = pTangent->x;
+                                *pVertex++ = yDelta * pTangent->y;
+                                *pVertex++ = pTangent->z;
                                 break;
                             }
                             case VertexLayoutComponent::VERTEX_COMPONENT_BITANGENT:
                             {
-                                vertexBuffer.push_back(pBitangent->x);
-                                vertexBuffer.push_back(yDelta * pBitangent->y);
-                                vertexBuffer.push_back(pBitangent->z);
+                                *pVertex++ = pBitangent->x;
+                                *pVertex++ = yDelta * pBitangent->y;
+                                *pVertex++ = pBitangent->z;
                                 break;
                             }
                             // Dummy components for padding
                             case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_FLOAT:
                             {
-                                vertexBuffer.push_back(0.0f);
+                                *pVertex++ = 0.0f;
                                 break;
                             }
                             case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_VEC4:
                             {
-                                vertexBuffer.push_back(0.0f);
-                                vertexBuffer.push_back(0.0f);
-                                vertexBuffer.push_back(0.0f);
-                                vertexBuffer.push_back(0.0f);
+                                *pVertex++ = 0.0f;
+                                *pVertex++ = 0.0f;
+                                *pVertex++ = 0.0f;
+                                *pVertex++ = 0.0f;
                                 break;
                             }
                             }
                         }
                     }
 
-                    vertexBufferSizes[i] = vertexBufferSize;
                     //bounds...
                     boundses[i].setMinMax(minOfBounds, maxOfBounds);
 
+                    uint32_t *pIndex = pIndices;
                     uint32_t faceCount = paiMesh->mNumFaces;
                     for (uint32_t j = 0; j < faceCount; ++j)
                     {
                         const aiFace &face = paiMesh->mFaces[j];
                         if (face.mNumIndices != 3)
                             continue;
-                        indexBuffer.push_back(face.mIndices[0]);
-                        indexBuffer.push_back(face.mIndices[1]);
-                        indexBuffer.push_back(face.mIndices[2]);
-                        indexCount += 3u;
+                        *pIndex++ = face.mIndices[0];
+                        *pIndex++ = face.mIndices[1];
+                        *pIndex++ = face.mIndices[2];
                     }
 
-                    indexBufferSize = indexCount * 4u;
-
-                    indexCounts[i] = indexCount;
-                    indexBufferSizes[i] = indexBufferSize;
-                    indexVertexDataIndices[i] = i;
-                }
-
-                pSharedVertexData->updateBuffer(vertexBuffer.data(), 
-                    static_cast<uint32_t>(vertexBuffer.size() * sizeof(float)),
-                    VG_FALSE);
+                    if (createInfo.optimizeMesh)
+                    {
+                        //Indices of the mesh are local, so its vertices can be reordered in place.
+                        std::vector<uint32_t> optimizedIndices(indexCount);
+                        fd::optimizeVertexCache(optimizedIndices.data(), pIndices, indexCount, vertexCount);
+                        std::vector<uint32_t> remap(vertexCount);
+                        fd::generateVertexFetchRemap(remap.data(), optimizedIndices.data(), indexCount, vertexCount);
+                        fd::remapIndices(pIndices, optimizedIndices.data(), indexCount, remap.data());
+                        //Unused vertices are moved to the end so the vertex count and bounds of the mesh are kept.
+                        uint32_t unusedIndex = 0u;
+                        for (const auto &index : remap) 
+                        {
+                            if (index != FD_MESH_OPTIMIZER_INVALID_INDEX) ++unusedIndex;
+                        }
+                        for (auto &index : remap)
+                        {
+                            if (index == FD_MESH_OPTIMIZER_INVALID_INDEX) index = unusedIndex++;
+                        }
+                        std::vector<float> optimizedVertices(pVertices, pVertices + vertexBufferSize / sizeof(float));
+                        fd::remapVertices(pVertices, optimizedVertices.data(), vertexCount, vertexSize, remap.data());
+                    }
 
-                if (createInfo.multipleMesh == false) {
-                    uint32_t base = 0u;
-                    uint32_t indexOffset = 0u;
-                    if (vertexSubDataCount != indexSubDataCount) throw std::runtime_error("Logic error!");
-                    for (uint32_t i = 0; i < meshCount; ++i) {
-                        uint32_t indexCount = indexCounts[i];
+                    if (createInfo.multipleMesh == false) {
+                        uint32_t base = vertexOffsets[i];
                         for (uint32_t j = 0; j < indexCount; ++j) {
-                            indexBuffer[indexOffset + j] += base;
+                            pIndices[j] += base;
                         }
-                        base += vertexCounts[i];
-                        indexOffset += indexCount;
                     }
-                }
+                };
 
-                pSharedIndexData->updateBuffer(indexBuffer.data(),
-                    static_cast<uint32_t>(indexBuffer.size() * sizeof(uint32_t)),
-                    VG_FALSE);
+                if (vertexSubDataCount != indexSubDataCount) throw std::runtime_error("Logic error!");
+                fd::getDefaultThreadPool().parallelFor(meshCount, packMesh);
+            }
 
-                if (createInfo.multipleMesh)
-                {
-                    pSharedVertexData->updateSubDataCount(vertexSubDataCount);
-                    if (vertexSubDataCount)
-                    {
-                        const auto &firstSubVertexData = pSharedVertexData->getSubVertexDatas()[0];
-                        pSharedVertexData->updateDesData(firstSubVertexData.vertexInputStateInfo, firstSubVertexData.pBindingBufferOffsets);
-                        pSharedVertexData->updateVertexCount(vertexCounts);
-                        pSharedVertexData->updateBufferSize(vertexBufferSizes);
-                    }
-            
-                    pSharedIndexData->updateSubDataCount(indexSubDataCount);
-                    if (indexSubDataCount)
-                    {
-                        const auto &firstSubIndexData = pSharedIndexData->getSubIndexDatas()[0];
-                        pSharedIndexData->updateDesData(firstSubIndexData.indexType, firstSubIndexData.inputAssemblyStateInfo);
-                        pSharedIndexData->updateIndexCount(indexCounts);
-                        pSharedIndexData->updateBufferSize(indexBufferSizes);
-                        pSharedIndexData->updateVertexDataIndex(indexVertexDataIndices);
-                    }
-                } 
-                else
+            //Material references.
+            uint32_t materialCount = pScene->mNumMaterials;
+            data.materials.resize(materialCount);
+            for (uint32_t i = 0; i < materialCount; ++i)
+            {
+                const aiMaterial *paiMaterial = pScene->mMaterials[i];
+                aiString name;
+                paiMaterial->Get(AI_MATKEY_NAME, name);
+                aiString diffuseTexture;
+                if (paiMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0u)
                 {
-                    pSharedVertexData->updateSubDataCount(1u);
-                    uint32_t vertexCount = 0u;
-                    for (auto count : vertexCounts) {
-                        vertexCount += count;
-                    }
-                    pSharedVertexData->updateVertexCount(vertexCount);
-                    
-                    uint32_t vertexBufferSize = 0u;
-                    for (auto size : vertexBufferSizes) {
-                        vertexBufferSize += size;
-                    }
-                    pSharedVertexData->updateBufferSize(vertexBufferSize);
+                    paiMaterial->GetTexture(aiTextureType_DIFFUSE, 0u, &diffuseTexture);
+                }
+                aiColor4D diffuseColor(1.0f, 1.0f, 1.0f, 1.0f);
+                paiMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor);
+                float color[4] = {diffuseColor.r, diffuseColor.g, diffuseColor.b, diffuseColor.a};
+                data.materials[i] = fd::MeshCacheMaterial(name.C_Str(), diffuseTexture.C_Str(), color);
+            }
+        }
+    }
 
-                    pSharedIndexData->updateSubDataCount(1u);
-                    uint32_t indexCount = 0u;
-                    for (auto count : indexCounts) {
-                        indexCount += count;
-                    }
-                    pSharedIndexData->updateIndexCount(indexCount);
+    vg::Bool32 AssimpScene::writeCache(const CreateInfo &createInfo, const ImportedData &data, const char *cacheFileName)
+    {
+        fd::MeshCacheWriter writer;
+        uint32_t vertexCount = 0u;
+        for (auto count : data.vertexCounts) {
+            vertexCount += count;
+        }
+        writer.addVertexStream(data.vertexBuffer.data(), data.vertexSize, vertexCount);
+        writer.addIndexStream(data.indexBuffer.data(), static_cast<uint32_t>(data.indexBuffer.size()));
+        uint32_t meshCount = static_cast<uint32_t>(data.vertexCounts.size());
+        uint32_t vertexOffset = 0u;
+        uint32_t indexOffset = 0u;
+        for (uint32_t i = 0; i < meshCount; ++i)
+        {
+            fd::MeshCacheSubMesh subMesh;
+            subMesh.vertexOffset = vertexOffset;
+            subMesh.vertexCount = data.vertexCounts[i];
+            subMesh.indexOffset = indexOffset;
+            subMesh.indexCount = data.indexCounts[i];
+            subMesh.materialIndex = data.materialIndices[i];
+            const auto &bounds = data.boundses[i];
+            for (uint32_t j = 0; j < 3u; ++j)
+            {
+                subMesh.boundsMin[j] = bounds.getMin()[j];
+                subMesh.boundsMax[j] = bounds.getMax()[j];
+            }
+            writer.addSubMesh(subMesh);
+            vertexOffset += subMesh.vertexCount;
+            indexOffset += subMesh.indexCount;
+        }
+        for (const auto &material : data.materials)
+        {
+            writer.addMaterial(material);
+        }
+        return writer.write(cacheFileName, getCacheKey(createInfo));
+    }
 
-                    uint32_t indexBufferSize = 0u;
-                    for (auto size : indexBufferSizes) {
-                        indexBufferSize += size;
-                    }
-                    pSharedIndexData->updateBufferSize(indexBufferSize);
+    void AssimpScene::_init(const CreateInfo &createInfo)
+    {
+        //Constructing the shared vertex buffer data.
+        auto &pSharedVertexData = m_pSharedVertexData;
+        auto &pSharedIndexData = m_pSharedIndexData;
 
-                    std::array<uint32_t, 1> vertexDataIndex = { 0u };
-                    pSharedIndexData->updateVertexDataIndex(vertexDataIndex);
+        uint32_t vertexSize = 0u;
+        {
+            //Constructing vertex input binding description and attribute description.
+            uint32_t componentCount = createInfo.layoutComponentCount;
+            const VertexLayoutComponent *pComponent = createInfo.pLayoutComponent;
+            uint32_t binding = 0u;
+            uint32_t stride = 0u;
+            uint32_t offset = 0u;
+            vk::Format format;
+            std::vector<vk::VertexInputAttributeDescription> attributeDescs(componentCount);
+            for (uint32_t i = 0; i < componentCount; ++i)
+            {
+                switch (*(pComponent + i))
+                {
+                case VertexLayoutComponent::VERTEX_COMPONENT_UV:
+                    stride += 2u * static_cast<uint32_t>(sizeof(float));
+                    format = vk::Format::eR32G32Sfloat;
+                    break;
+                case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_FLOAT:
+                    stride += static_cast<uint32_t>(sizeof(float));
+                    format = vk::Format::eR32Sfloat;
+                    break;
+                case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_VEC4:
+                    stride += 4u * static_cast<uint32_t>(sizeof(float));
+                    format = vk::Format::eR32G32B32A32Sfloat;
+                    break;
+                default:
+                    // All components except the ones listed above are made up of 3 floats
+                    stride += 3u * static_cast<uint32_t>(sizeof(float));
+                    format = vk::Format::eR32G32B32Sfloat;
                 }
+
+                attributeDescs[i].binding = binding;
+                attributeDescs[i].location = i;
+                attributeDescs[i].format = format;
+                attributeDescs[i].offset = offset;
+                
+                offset = stride;
             }
+            vk::VertexInputBindingDescription bindingDesc[1] = {};
+            bindingDesc[0].binding = binding;
+            bindingDesc[0].stride = stride;
+            bindingDesc[0].inputRate = vk::VertexInputRate::eVertex;
+
+            uint32_t bindingBufferOffsets[1] = { 0u };
+
+            //Constructing pipeline vertex input state create info.
+            vk::PipelineVertexInputStateCreateInfo vertexInfo = {};
+            vertexInfo.vertexBindingDescriptionCount = 1u;
+            vertexInfo.pVertexBindingDescriptions = bindingDesc;
+            vertexInfo.vertexAttributeDescriptionCount = attributeDescs.size();
+            vertexInfo.pVertexAttributeDescriptions = attributeDescs.data();
+    
+            //Constructing pipeline input assembly state create info.
+            vk::PipelineInputAssemblyStateCreateInfo iaInfo = {};
+            iaInfo.topology = vk::PrimitiveTopology::eTriangleList;
+
+            pSharedVertexData->updateDesData(vertexInfo, bindingBufferOffsets);
+            pSharedIndexData->updateDesData(vk::IndexType::eUint32, iaInfo);
 
-            fd::Bounds<vg::Vector3> integrateBounds;
-            if (createInfo.multipleMesh == false || createInfo.multipleObject == false) 
+            vertexSize = stride;
+        }
+
+        fd::MeshCacheFile cacheFile;
+        if (createInfo.cacheFileName != nullptr && 
+            cacheFile.open(createInfo.cacheFileName, getCacheKey(createInfo)) == VG_TRUE &&
+            cacheFile.getVertexStreamCount() == 1u && cacheFile.getIndexStreamCount() == 1u &&
+            cacheFile.getVertexStream(0u).stride == vertexSize)
+        {
+            //The mapped streams are copied to staging memory directly.
+            uint32_t meshCount = cacheFile.getSubMeshCount();
+            const fd::MeshCacheSubMesh *pSubMeshes = cacheFile.getSubMeshes();
+            std::vector<uint32_t> vertexCounts(meshCount);
+            std::vector<uint32_t> indexCounts(meshCount);
+            std::vector<fd::Bounds<vg::Vector3>> boundses(meshCount);
+            for (uint32_t i = 0; i < meshCount; ++i)
             {
-                vg::Vector3 minOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::max());
-                vg::Vector3 maxOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::lowest());
-                for (uint32_t i = 0; i < meshCount; ++i)
-                {
-                    //bounds...
-                    float x = boundses[i].getMin().x;
-                    float y = boundses[i].getMin().y;
-                    float z = boundses[i].getMin().z;
-                    if (minOfBounds.x > x)minOfBounds.x = x;
-                    if (minOfBounds.y > y)minOfBounds.y = y;
-                    if (minOfBounds.z > z)minOfBounds.z = z;
-                    x = boundses[i].getMax().x;
-                    y = boundses[i].getMax().y;
-                    z = boundses[i].getMax().z;
-                    if (maxOfBounds.x < x)maxOfBounds.x = x;
-                    if (maxOfBounds.y < y)maxOfBounds.y = y;
-                    if (maxOfBounds.z < z)maxOfBounds.z = z;
-                }
-                integrateBounds.setMinMax(minOfBounds, maxOfBounds);
+                vertexCounts[i] = pSubMeshes[i].vertexCount;
+                indexCounts[i] = pSubMeshes[i].indexCount;
+                boundses[i].setMinMax(vg::Vector3(pSubMeshes[i].boundsMin[0], pSubMeshes[i].boundsMin[1], pSubMeshes[i].boundsMin[2]),
+                    vg::Vector3(pSubMeshes[i].boundsMax[0], pSubMeshes[i].boundsMax[1], pSubMeshes[i].boundsMax[2]));
+            }
+            _createMeshes(createInfo, vertexSize, cacheFile.getVertexStreamData(0u), cacheFile.getIndexStreamData(0u),
+                vertexCounts, indexCounts, boundses);
+        }
+        else
+        {
+            ImportedData data;
+            importData(createInfo, data);
+            if (createInfo.cacheFileName != nullptr) writeCache(createInfo, data, createInfo.cacheFileName);
+            _createMeshes(createInfo, vertexSize, data.vertexBuffer.data(), data.indexBuffer.data(),
+                data.vertexCounts, data.indexCounts, data.boundses);
+        }
+    }
+
+    uint32_t AssimpScene::_getVertexSize(const CreateInfo &createInfo)
+    {
+        uint32_t stride = 0u;
+        for (uint32_t i = 0; i < createInfo.layoutComponentCount; ++i)
+        {
+            switch (*(createInfo.pLayoutComponent + i))
+            {
+            case VertexLayoutComponent::VERTEX_COMPONENT_UV:
+                stride += 2u * static_cast<uint32_t>(sizeof(float));
+                break;
+            case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_FLOAT:
+                stride += static_cast<uint32_t>(sizeof(float));
+                break;
+            case VertexLayoutComponent::VERTEX_COMPONENT_DUMMY_VEC4:
+                stride += 4u * static_cast<uint32_t>(sizeof(float));
+                break;
+            default:
+                stride += 3u * static_cast<uint32_t>(sizeof(float));
             }
+        }
+        return stride;
+    }
 
-            if (createInfo.multipleMesh == false)
+    void AssimpScene::_createMeshes(const CreateInfo &createInfo
+        , uint32_t vertexSize
+        , const void *pVertices
+        , const uint32_t *pIndices
+        , const std::vector<uint32_t> &vertexCounts
+        , const std::vector<uint32_t> &indexCounts
+        , std::vector<fd::Bounds<vg::Vector3>> boundses
+        )
+    {
+        uint32_t meshCount = static_cast<uint32_t>(vertexCounts.size());
+        auto &pSharedVertexData = m_pSharedVertexData;
+        auto &pSharedIndexData = m_pSharedIndexData;
+
+        {
+            uint32_t vertexSubDataCount = meshCount;
+            uint32_t indexSubDataCount = meshCount;
+            std::vector<uint32_t> vertexBufferSizes(vertexSubDataCount);
+            std::vector<uint32_t> indexBufferSizes(indexSubDataCount);
+            std::vector<uint32_t> indexVertexDataIndices(indexSubDataCount);
+            uint32_t totalVertexCount = 0u;
+            uint32_t totalIndexCount = 0u;
+            for (uint32_t i = 0; i < meshCount; ++i)
             {
-                meshCount = 1u;
-                boundses.resize(1u);
-                boundses[0] = integrateBounds;
+                vertexBufferSizes[i] = vertexSize * vertexCounts[i];
+                indexBufferSizes[i] = indexCounts[i] * 4u;
+                indexVertexDataIndices[i] = i;
+                totalVertexCount += vertexCounts[i];
+                totalIndexCount += indexCounts[i];
             }
 
+            pSharedVertexData->updateBuffer(pVertices, 
+                vertexSize * totalVertexCount,
+                VG_FALSE);
+
+            pSharedIndexData->updateBuffer(pIndices,
+                static_cast<uint32_t>(totalIndexCount * sizeof(uint32_t)),
+                VG_FALSE);
+
+            if (createInfo.multipleMesh)
             {
-                //Filling the meshes vertex buffer data.
-                if (createInfo.multipleObject)
+                pSharedVertexData->updateSubDataCount(vertexSubDataCount);
+                if (vertexSubDataCount)
                 {
-                    auto &pMeshes = m_pMeshes;
-                    pMeshes.resize(meshCount);
-        
-                    for (uint32_t i = 0; i < meshCount; ++i)
-                    {
-                        auto &pMesh = pMeshes[i];
-                        pMesh = std::shared_ptr<vg::DimSharedContentMesh3>(new vg::DimSharedContentMesh3());
-                        pMesh->init(pSharedVertexData, pSharedIndexData, i, 1u);
-                        pMesh->setIsHasBounds(VG_TRUE);
-                        pMesh->setBounds(boundses[i]);
-                    }
+                    const auto &firstSubVertexData = pSharedVertexData->getSubVertexDatas()[0];
+                    pSharedVertexData->updateDesData(firstSubVertexData.vertexInputStateInfo, firstSubVertexData.pBindingBufferOffsets);
+                    pSharedVertexData->updateVertexCount(vertexCounts);
+                    pSharedVertexData->updateBufferSize(vertexBufferSizes);
                 }
-                else
+        
+                pSharedIndexData->updateSubDataCount(indexSubDataCount);
+                if (indexSubDataCount)
                 {
-                    auto &pMeshes = m_pMeshes;
-                    pMeshes.resize(1u);
+                    const auto &firstSubIndexData = pSharedIndexData->getSubIndexDatas()[0];
+                    pSharedIndexData->updateDesData(firstSubIndexData.indexType, firstSubIndexData.inputAssemblyStateInfo);
+                    pSharedIndexData->updateIndexCount(indexCounts);
+                    pSharedIndexData->updateBufferSize(indexBufferSizes);
+                    pSharedIndexData->updateVertexDataIndex(indexVertexDataIndices);
+                }
+            } 
+            else
+            {
+                pSharedVertexData->updateSubDataCount(1u);
+                uint32_t vertexCount = 0u;
+                for (auto count : vertexCounts) {
+                    vertexCount += count;
+                }
+                pSharedVertexData->updateVertexCount(vertexCount);
+                
+                uint32_t vertexBufferSize = 0u;
+                for (auto size : vertexBufferSizes) {
+                    vertexBufferSize += size;
+                }
+                pSharedVertexData->updateBufferSize(vertexBufferSize);
+
+                pSharedIndexData->updateSubDataCount(1u);
+                uint32_t indexCount = 0u;
+                for (auto count : indexCounts) {
+                    indexCount += count;
+                }
+                pSharedIndexData->updateIndexCount(indexCount);
+
+                uint32_t indexBufferSize = 0u;
+                for (auto size : indexBufferSizes) {
+                    indexBufferSize += size;
+                }
+                pSharedIndexData->updateBufferSize(indexBufferSize);
+
+                std::array<uint32_t, 1> vertexDataIndex = { 0u };
+                pSharedIndexData->updateVertexDataIndex(vertexDataIndex);
+            }
+        }
+
+        fd::Bounds<vg::Vector3> integrateBounds;
+        if (createInfo.multipleMesh == false || createInfo.multipleObject == false) 
+        {
+            vg::Vector3 minOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::max());
+            vg::Vector3 maxOfBounds(std::numeric_limits<typename vg::Vector3::value_type>::lowest());
+            for (uint32_t i = 0; i < meshCount; ++i)
+            {
+                //bounds...
+                float x = boundses[i].getMin().x;
+                float y = boundses[i].getMin().y;
+                float z = boundses[i].getMin().z;
+                if (minOfBounds.x > x)minOfBounds.x = x;
+                if (minOfBounds.y > y)minOfBounds.y = y;
+                if (minOfBounds.z > z)minOfBounds.z = z;
+                x = boundses[i].getMax().x;
+                y = boundses[i].getMax().y;
+                z = boundses[i].getMax().z;
+                if (maxOfBounds.x < x)maxOfBounds.x = x;
+                if (maxOfBounds.y < y)maxOfBounds.y = y;
+                if (maxOfBounds.z < z)maxOfBounds.z = z;
+            }
+            integrateBounds.setMinMax(minOfBounds, maxOfBounds);
+        }
+
+        if (createInfo.multipleMesh == false)
+        {
+            meshCount = 1u;
+            boundses.resize(1u);
+            boundses[0] = integrateBounds;
+        }
 
-                    auto &pMesh = pMeshes[0];
+        {
+            //Filling the meshes vertex buffer data.
+            if (createInfo.multipleObject)
+            {
+                auto &pMeshes = m_pMeshes;
+                pMeshes.resize(meshCount);
+    
+                for (uint32_t i = 0; i < meshCount; ++i)
+                {
+                    auto &pMesh = pMeshes[i];
                     pMesh = std::shared_ptr<vg::DimSharedContentMesh3>(new vg::DimSharedContentMesh3());
-                    pMesh->init(pSharedVertexData, pSharedIndexData, 0, meshCount);
+                    pMesh->init(pSharedVertexData, pSharedIndexData, i, 1u);
                     pMesh->setIsHasBounds(VG_TRUE);
-                    pMesh->setBounds(integrateBounds);
+                    pMesh->setBounds(boundses[i]);
                 }
-                
             }
+            else
+            {
+                auto &pMeshes = m_pMeshes;
+                pMeshes.resize(1u);
+
+                auto &pMesh = pMeshes[0];
+                pMesh = std::shared_ptr<vg::DimSharedContentMesh3>(new vg::DimSharedContentMesh3());
+                pMesh->init(pSharedVertexData, pSharedIndexData, 0, meshCount);
+                pMesh->setIsHasBounds(VG_TRUE);
+                pMesh->setBounds(integrateBounds);
+            }
+            
+        }
 
+        {
+            //Filling the visual object.
+            if (createInfo.isCreateObject)
             {
-                //Filling the visual object.
-                if (createInfo.isCreateObject)
-                {
-                    auto &pMeshes = m_pMeshes;                    
-                    uint32_t count = static_cast<uint32_t>(pMeshes.size());
-                    auto &pObjects = m_pObjects;
-                    pObjects.resize(count);
+                auto &pMeshes = m_pMeshes;                    
+                uint32_t count = static_cast<uint32_t>(pMeshes.size());
+                auto &pObjects = m_pObjects;
+                pObjects.resize(count);
 
-                    for (uint32_t i = 0; i < count; ++i)
-                    {
-                        pObjects[i] = std::shared_ptr<vg::VisualObject3>(new vg::VisualObject3());
-                        pObjects[i]->setMesh(pMeshes[i].get());
-                    }
-                }
-                else
+                for (uint32_t i = 0; i < count; ++i)
                 {
-                    m_pObjects.resize(0);
+                    pObjects[i] = std::shared_ptr<vg::VisualObject3>(new vg::VisualObject3());
+                    pObjects[i]->setMesh(pMeshes[i].get());
                 }
             }
-    
+            else
+            {
+                m_pObjects.resize(0);
+            }
         }
-
     }
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <framework/framework.hpp>
 
+//Change it when the data written to mesh cache is changed.
+#define SAMPLES_LIB_SCENE_ASSIMP_CACHE_VERSION 1u
+
 namespace sampleslib
 {
     class AssimpScene
@@ -31,6 +34,10 @@ namespace sampleslib
             vg::Bool32 isRightHand;
             vg::Bool32 multipleObject;
             vg::Bool32 multipleMesh;
+            vg::Bool32 optimizeMesh; //Reorder indices and vertices of every mesh for vertex cache and vertex fetch.
+            //Binary mesh cache file, it is mapped instead of importing the source file when it matches the source
+            //and settings, otherwise it is written after importing.
+            const char *cacheFileName;
             CreateInfo(const char* fileName = nullptr
                 , uint32_t layoutComponentCount = 0u
                 , const VertexLayoutComponent *pLayoutComponent = nullptr
@@ -41,9 +48,30 @@ namespace sampleslib
                 , vg::Bool32 isRightHand = VG_FALSE
                 , vg::Bool32 multipleObject = VG_FALSE
                 , vg::Bool32 multipleMesh = VG_FALSE
+                , vg::Bool32 optimizeMesh = VG_FALSE
+                , const char *cacheFileName = nullptr
                 );
         };
 
+        //Vertices and indices packed with the layout of create info, they are what the mesh cache stores.
+        struct ImportedData {
+            uint32_t vertexSize;
+            std::vector<float> vertexBuffer;
+            std::vector<uint32_t> indexBuffer;
+            std::vector<uint32_t> vertexCounts;
+            std::vector<uint32_t> indexCounts;
+            std::vector<uint32_t> materialIndices;
+            std::vector<fd::Bounds<vg::Vector3>> boundses;
+            std::vector<fd::MeshCacheMaterial> materials;
+            ImportedData();
+        };
+
+        /*Key of mesh cache, it depends on the source file size, vertex layout and import settings.*/
+        static uint64_t getCacheKey(const CreateInfo &createInfo);
+        /*Import the source file with Assimp, it doesn't need graphics device.*/
+        static void importData(const CreateInfo &createInfo, ImportedData &data);
+        static vg::Bool32 writeCache(const CreateInfo &createInfo, const ImportedData &data, const char *cacheFileName);
+
         AssimpScene();
         AssimpScene(const CreateInfo &createInfo);
         void init(const CreateInfo &createInfo);
@@ -51,6 +79,15 @@ namespace sampleslib
         const std::vector<std::shared_ptr<vg::VisualObject3>> getObjects() const;
     protected:
         void _init(const CreateInfo &createInfo);
+        static uint32_t _getVertexSize(const CreateInfo &createInfo);
+        void _createMeshes(const CreateInfo &createInfo
+            , uint32_t vertexSize
+            , const void *pVertices
+            , const uint32_t *pIndices
+            , const std::vector<uint32_t> &vertexCounts
+            , const std::vector<uint32_t> &indexCounts
+            , std::vector<fd::Bounds<vg::Vector3>> boundses
+            );
         std::shared_ptr<vg::VertexData> m_pSharedVertexData;
         std::shared_ptr<vg::IndexData> m_pSharedIndexData;
         std::vector<std::shared_ptr<vg::DimSharedContentMesh3>> m_pMeshes;
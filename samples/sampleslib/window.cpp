@@ -130,6 +130,10 @@ namespace sampleslib
 
         m_pCamera->getTransform()->setLocalMatrix(localMatrix);
 
+        for (const auto &pScene : m_pScenes)
+        {
+            pScene->updateLOD(m_pCamera->getProjector());
+        }
     }
 
     template <>
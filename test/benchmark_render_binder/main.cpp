@@ -0,0 +1,439 @@
+#include <plog/Log.h>
+#include <plog/Appenders/ConsoleAppender.h>
+#include <graphics/graphics.hpp>
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+
+/*Benchmark of cpu side of rendering, scenes are bound to cmd buffers every frame like Renderer does, but cmd
+  buffers are never recorded to vulkan command buffers and nothing is submitted. Only a headless device is
+  created for resources of scenes, so it runs without window and presentation.
+  The last bound frame is captured and replayed through cmd parser into a null recorder, so recording and
+  pipeline cache are measured without updating and binding scene. When capture path is given, the capture
+  is saved to a file with the path as prefix and loaded again before replaying.
+  When sprite batch is 1, 2D meshes keep their vertices on host and consecutive objects with same material
+  are merged into batches, eg. with one material.
+  When deferred is 1, objects of 3D scene also have deferred materials, so they are drawn in the render pass of
+  a deferred target and G-buffers are bound to the default composition material every frame.
+  Usage: benchmark_render_binder [-objects count] [-depth depth] [-materials count] [-frames count]
+      [-capture path] [-sprite-batch 0|1] [-deferred 0|1]*/
+
+//Allocations of the whole program are counted, the profiler reads the count around binding of every frame.
+FD_DEFINE_ALLOCATION_COUNTING_NEW()
+
+struct BenchmarkInfo
+{
+    uint32_t objectCount;
+    //Objects are put into chains of parent and child, it is the length of chains.
+    uint32_t hierarchyDepth;
+    uint32_t materialCount;
+    uint32_t frameCount;
+    std::string capturePath;
+    vg::Bool32 spriteBatch;
+    vg::Bool32 deferred;
+};
+
+template <vg::SpaceType SPACE_TYPE>
+struct SpaceObjectInfo
+{
+};
+
+template <>
+struct SpaceObjectInfo<vg::SpaceType::SPACE_2>
+{
+    using SceneType = vg::Scene2;
+    using CameraType = vg::CameraOP2;
+    using VisualObjectType = vg::VisualObject2;
+    using MeshType = vg::DimSepMesh2;
+    static const char *getName() { return "space2"; }
+};
+
+template <>
+struct SpaceObjectInfo<vg::SpaceType::SPACE_3>
+{
+    using SceneType = vg::Scene3;
+    using CameraType = vg::Camera3;
+    using VisualObjectType = vg::VisualObject3;
+    using MeshType = vg::DimSepMesh3;
+    static const char *getName() { return "space3"; }
+};
+
+float random(float min, float max)
+{
+    return min + (max - min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+std::shared_ptr<vg::DimSepMesh2> createMesh(vg::DimSepMesh2 *, vg::Bool32 spriteBatch)
+{
+    std::vector<vg::Vector2> positions = {
+        vg::Vector2(-0.05f, -0.05f),
+        vg::Vector2(0.05f, -0.05f),
+        vg::Vector2(0.05f, 0.05f),
+        vg::Vector2(-0.05f, 0.05f),
+    };
+    std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+    auto pMesh = std::shared_ptr<vg::DimSepMesh2>(new vg::DimSepMesh2());
+    pMesh->setVertexCount(static_cast<uint32_t>(positions.size()));
+    pMesh->addPositions(positions);
+    pMesh->setIndices(indices, vg::PrimitiveTopology::TRIANGLE_LIST, 0u);
+    if (spriteBatch == VG_TRUE)
+    {
+        pMesh->setVertexLayoutPolicy(vg::VertexLayoutPolicy::INTERLEAVED);
+        pMesh->setIsCacheMemory(VG_TRUE);
+    }
+    pMesh->apply(VG_TRUE);
+    return pMesh;
+}
+
+//Sprites are only batched in 2D scenes.
+std::shared_ptr<vg::DimSepMesh3> createMesh(vg::DimSepMesh3 *, vg::Bool32)
+{
+    std::vector<vg::Vector3> positions = {
+        vg::Vector3(-0.5f, -0.5f, -0.5f),
+        vg::Vector3(0.5f, -0.5f, -0.5f),
+        vg::Vector3(0.5f, 0.5f, -0.5f),
+        vg::Vector3(-0.5f, 0.5f, -0.5f),
+        vg::Vector3(-0.5f, -0.5f, 0.5f),
+        vg::Vector3(0.5f, -0.5f, 0.5f),
+        vg::Vector3(0.5f, 0.5f, 0.5f),
+        vg::Vector3(-0.5f, 0.5f, 0.5f),
+    };
+    std::vector<uint32_t> indices = {
+        0, 1, 2, 0, 2, 3,
+        4, 6, 5, 4, 7, 6,
+        0, 4, 5, 0, 5, 1,
+        3, 2, 6, 3, 6, 7,
+        0, 3, 7, 0, 7, 4,
+        1, 5, 6, 1, 6, 2,
+    };
+    auto pMesh = std::shared_ptr<vg::DimSepMesh3>(new vg::DimSepMesh3());
+    pMesh->setVertexCount(static_cast<uint32_t>(positions.size()));
+    pMesh->addPositions(positions);
+    pMesh->setIndices(indices, vg::PrimitiveTopology::TRIANGLE_LIST, 0u);
+    pMesh->apply(VG_TRUE);
+    return pMesh;
+}
+
+void updateCamera(vg::CameraOP2 *pCamera)
+{
+    pCamera->updateProj(fd::Bounds<vg::Vector2>(vg::Vector2(-1.0f, -1.0f), vg::Vector2(1.0f, 1.0f)));
+}
+
+void updateCamera(vg::Camera3 *pCamera)
+{
+    pCamera->updateProj(glm::radians(60.0f), 1.0f, 0.1f, 256.0f);
+}
+
+//Roots are spread wider than the projection, so part of them are culled.
+vg::Vector2 createRootPosition(vg::Vector2 *)
+{
+    return vg::Vector2(random(-2.0f, 2.0f), random(-2.0f, 2.0f));
+}
+
+vg::Vector3 createRootPosition(vg::Vector3 *)
+{
+    return vg::Vector3(random(-80.0f, 80.0f), random(-80.0f, 80.0f), random(2.0f, 120.0f));
+}
+
+/*Materials differ in queue type, priority and pass, they share shader modules of the default pre depth shader,
+  so no shader files are needed.*/
+std::vector<std::shared_ptr<vg::Material>> createMaterials(uint32_t count)
+{
+    std::vector<std::shared_ptr<vg::Material>> pMaterials(count);
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+        auto pMaterial = std::shared_ptr<vg::Material>(new vg::Material());
+        pMaterial->setRenderQueueType(i % 4u == 3u ? vg::MaterialShowType::TRANSPARENT : vg::MaterialShowType::OPAQUE);
+        pMaterial->setRenderPriority(i);
+        auto pShader = pMaterial->getMainShader();
+        pShader->setVertShaderModule(const_cast<vk::ShaderModule *>(vg::pDefaultPreDepthShader->getVertShaderModule()));
+        pShader->setFragShaderModule(const_cast<vk::ShaderModule *>(vg::pDefaultPreDepthShader->getFragShaderModule()));
+        auto pPass = pMaterial->getMainPass();
+        vg::Pass::BuildInDataInfo::Component buildInDataCmp = {
+            {vg::Pass::BuildInDataType::MATRIX_OBJECT_TO_NDC},
+        };
+        vg::Pass::BuildInDataInfo buildInDataInfo;
+        buildInDataInfo.componentCount = 1u;
+        buildInDataInfo.pComponent = &buildInDataCmp;
+        pPass->setBuildInDataInfo(buildInDataInfo);
+        pPass->setMainColor(vg::Color(static_cast<float>(i) / static_cast<float>(count), 1.0f, 1.0f, 1.0f));
+        pPass->setCullMode(vk::CullModeFlagBits::eNone);
+        pMaterial->apply();
+        pMaterials[i] = pMaterial;
+    }
+    return pMaterials;
+}
+
+template <vg::SpaceType SPACE_TYPE>
+void runBenchmark(const BenchmarkInfo &info)
+{
+    using SceneType = typename SpaceObjectInfo<SPACE_TYPE>::SceneType;
+    using CameraType = typename SpaceObjectInfo<SPACE_TYPE>::CameraType;
+    using VisualObjectType = typename SpaceObjectInfo<SPACE_TYPE>::VisualObjectType;
+    using MeshType = typename SpaceObjectInfo<SPACE_TYPE>::MeshType;
+    using PointType = typename vg::SpaceTypeInfo<SPACE_TYPE>::PointType;
+
+    srand(1u);
+    auto pMesh = createMesh(static_cast<MeshType *>(nullptr), info.spriteBatch);
+    auto pMaterials = createMaterials(info.materialCount);
+    SceneType scene;
+    CameraType camera;
+    updateCamera(&camera);
+    scene.addCamera(&camera);
+
+    std::vector<std::shared_ptr<VisualObjectType>> pObjects(info.objectCount);
+    std::vector<VisualObjectType *> pRoots;
+    std::vector<PointType> rootPositions;
+    for (uint32_t i = 0u; i < info.objectCount; ++i)
+    {
+        auto pObject = std::shared_ptr<VisualObjectType>(new VisualObjectType());
+        pObject->setMesh(pMesh.get());
+        pObject->setMaterialCount(1u);
+        pObject->setMaterial(pMaterials[i % info.materialCount].get());
+        if (info.deferred == VG_TRUE) pObject->setDeferredMaterial(pMaterials[i % info.materialCount].get());
+        if (i % info.hierarchyDepth == 0u)
+        {
+            scene.addVisualObject(pObject.get());
+            pRoots.push_back(pObject.get());
+            rootPositions.push_back(createRootPosition(static_cast<PointType *>(nullptr)));
+        }
+        else
+        {
+            scene.addVisualObject(pObject.get(), pObjects[i - 1u].get());
+        }
+        pObjects[i] = pObject;
+    }
+
+    //Trunk target is a color texture, so no surface is needed.
+    vg::TextureColorAttachment colorTex(vk::Format::eR8G8B8A8Unorm, 512u, 512u);
+    vg::ColorTexRendererTarget rendererTarget(&colorTex);
+    vg::RendererPassCache rendererPassCache;
+    vg::RenderBinder renderBinder;
+    vg::CmdBuffer branchCmdBuffer;
+    vg::CmdBuffer trunkWaitBarrierCmdBuffer;
+    vg::CmdBuffer trunkRenderPassCmdBuffer;
+    //Deferred target has same size as the trunk target, it is only used by 3D scene.
+    vg::RendererDeferredTarget deferredTarget(512u, 512u);
+    vg::CmdBuffer deferredCmdBuffer;
+    std::vector<const vg::Texture *> deferredGBufferTexs(deferredTarget.getGBufferCount());
+    for (uint32_t i = 0u; i < deferredTarget.getGBufferCount(); ++i)
+    {
+        deferredGBufferTexs[i] = deferredTarget.getGBufferTexture(i);
+    }
+
+    auto &profiler = fd::getDefaultProfiler();
+    std::unordered_map<std::string, uint64_t> stageTimes;
+    std::vector<std::string> stageNames;
+    uint64_t bindTime = 0u;
+    uint64_t allocations = 0u;
+    uint64_t lastFrameAllocations = 0u;
+    auto &frameArena = fd::getDefaultFrameArena();
+    uint32_t cmdCount = 0u;
+    vg::FrameCapture frameCapture;
+    //The first frame creates caches, it isn't measured.
+    for (uint32_t frame = 0u; frame <= info.frameCount; ++frame)
+    {
+        //Roots are moved every frame, so transforms of all objects are changed.
+        for (size_t i = 0u; i < pRoots.size(); ++i)
+        {
+            PointType offset(0.0f);
+            offset.x = static_cast<float>(frame % 16u) * 0.01f;
+            pRoots[i]->getTransform()->setLocalPosition(rootPositions[i] + offset);
+        }
+
+        profiler.beginFrame();
+        uint64_t beginTime = profiler.getTime();
+        {
+            FD_PROFILE_ZONE("Benchmark::frame");
+            frameArena.reset();
+            //Geometry of sprite batches is written into it, it begins a frame like window does.
+            vg::pDefaultTransientBuffer->beginFrame();
+            rendererPassCache.begin();
+            renderBinder.begin();
+            scene.beginRender();
+            if (info.deferred == VG_TRUE) deferredCmdBuffer.begin();
+            branchCmdBuffer.begin();
+            trunkWaitBarrierCmdBuffer.begin();
+            trunkRenderPassCmdBuffer.begin();
+
+            vg::RenderBinderInfo bindInfo(&rendererPassCache);
+            bindInfo.pScene = &scene;
+            bindInfo.pProjector = camera.getProjectorBase();
+            bindInfo.pRendererTarget = &rendererTarget;
+            bindInfo.spriteBatchEnable = info.spriteBatch;
+            if (info.deferred == VG_TRUE)
+            {
+                bindInfo.deferredEnable = VG_TRUE;
+                bindInfo.pDeferredCompositionMaterial = vg::pDefaultDeferredCompositionMaterial.get();
+                bindInfo.pDeferredTarget = &deferredTarget;
+                bindInfo.pDeferredColorTex = deferredTarget.getColorTargetTexture();
+                bindInfo.pDeferredDepthTex = deferredTarget.getDepthTargetTexture();
+                bindInfo.pDeferredGBufferTexs = deferredGBufferTexs.data();
+                bindInfo.pDeferredCmdBuffer = &deferredCmdBuffer;
+            }
+            bindInfo.pBranchCmdBuffer = &branchCmdBuffer;
+            bindInfo.pTrunkWaitBarrierCmdBuffer = &trunkWaitBarrierCmdBuffer;
+            bindInfo.pTrunkRenderPassCmdBuffer = &trunkRenderPassCmdBuffer;
+            renderBinder.bind(bindInfo);
+
+            cmdCount = branchCmdBuffer.getCmdCount() + trunkRenderPassCmdBuffer.getCmdCount();
+            trunkRenderPassCmdBuffer.end();
+            trunkWaitBarrierCmdBuffer.end();
+            branchCmdBuffer.end();
+            if (info.deferred == VG_TRUE) deferredCmdBuffer.end();
+            scene.endRender();
+            renderBinder.end();
+            rendererPassCache.end();
+        }
+        uint64_t endTime = profiler.getTime();
+        profiler.endFrame();
+        if (frame == info.frameCount)
+        {
+            if (info.deferred == VG_TRUE) frameCapture.capture("deferred", &deferredCmdBuffer);
+            frameCapture.capture("branch", &branchCmdBuffer);
+            frameCapture.capture("trunk wait barrier", &trunkWaitBarrierCmdBuffer, vg::FrameCapture::CmdBufferType::TRUNK_WAIT_BARRIER);
+            frameCapture.capture("trunk", &trunkRenderPassCmdBuffer);
+        }
+        if (frame == 0u) continue;
+
+        bindTime += endTime - beginTime;
+        allocations += profiler.getLastFrameAllocationCount();
+        lastFrameAllocations = profiler.getLastFrameAllocationCount();
+        for (const auto &stat : profiler.getLastFrameStats())
+        {
+            std::string name = stat.name;
+            if (stageTimes.count(name) == 0u) stageNames.push_back(name);
+            stageTimes[name] += stat.totalTime;
+        }
+    }
+
+    if (info.capturePath.empty() == false)
+    {
+        std::string path = info.capturePath + "_" + SpaceObjectInfo<SPACE_TYPE>::getName() + ".vgfc";
+        auto resources = frameCapture.getResources();
+        if (frameCapture.save(path) == VG_FALSE || frameCapture.load(path, resources) == VG_FALSE)
+        {
+            LOG(plog::warning) << "Failed to save and load frame capture: " << path << std::endl;
+        }
+    }
+
+    vg::PipelineCache pipelineCache;
+    vg::NullCmdRecorder recorder;
+    vg::CMDParser::ResultInfo replayResult;
+    uint64_t recordTime = 0u;
+    uint64_t replayAllocations = 0u;
+    //The first replay creates pipelines, it isn't measured.
+    for (uint32_t frame = 0u; frame <= info.frameCount; ++frame)
+    {
+        recorder.reset();
+        profiler.beginFrame();
+        uint64_t beginTime = profiler.getTime();
+        frameArena.reset();
+        pipelineCache.begin();
+        rendererPassCache.begin();
+        frameCapture.replay(&recorder, &pipelineCache, &rendererPassCache, &replayResult);
+        rendererPassCache.end();
+        pipelineCache.end();
+        uint64_t endTime = profiler.getTime();
+        profiler.endFrame();
+        if (frame == 0u) continue;
+        recordTime += endTime - beginTime;
+        replayAllocations += profiler.getLastFrameAllocationCount();
+    }
+
+    double frameTime = static_cast<double>(bindTime) / static_cast<double>(info.frameCount) / 1000000.0;
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << SpaceObjectInfo<SPACE_TYPE>::getName()
+        << ": objects " << info.objectCount
+        << ", depth " << info.hierarchyDepth
+        << ", materials " << info.materialCount
+        << ", frames " << info.frameCount
+        << ", sprite batch " << info.spriteBatch
+        << ", deferred " << info.deferred << std::endl;
+    std::cout << "  frame time: " << frameTime << " ms" << std::endl;
+    std::cout << "  throughput: " << static_cast<double>(info.objectCount) / frameTime << " objects/ms" << std::endl;
+    std::cout << "  allocations per frame: " << static_cast<double>(allocations) / static_cast<double>(info.frameCount)
+        << ", last frame: " << lastFrameAllocations << std::endl;
+    std::cout << "  frame arena capacity: " << frameArena.getCapacity()
+        << " bytes, blocks allocated: " << frameArena.getBlockAllocationCount() << std::endl;
+    std::cout << "  cmds per frame: " << cmdCount
+        << ", cmd buffer capacity: " << branchCmdBuffer.getCapacity() + trunkRenderPassCmdBuffer.getCapacity()
+        << " bytes" << std::endl;
+    std::cout << "  replay record time: "
+        << static_cast<double>(recordTime) / static_cast<double>(info.frameCount) / 1000000.0 << " ms"
+        << ", allocations per replay: " << static_cast<double>(replayAllocations) / static_cast<double>(info.frameCount) << std::endl;
+    std::cout << "  replay draws: " << replayResult.drawCount
+        << ", vulkan cmds: " << recorder.getTotalCount() << std::endl;
+    std::cout << "  redundant pipeline binds: " << recorder.getRedundantCount(vg::CmdRecordType::BIND_PIPELINE)
+        << ", descriptor set binds: " << recorder.getRedundantCount(vg::CmdRecordType::BIND_DESCRIPTOR_SETS)
+        << ", vertex buffer binds: " << recorder.getRedundantCount(vg::CmdRecordType::BIND_VERTEX_BUFFERS)
+        << ", index buffer binds: " << recorder.getRedundantCount(vg::CmdRecordType::BIND_INDEX_BUFFER)
+        << std::endl;
+    for (const auto &name : stageNames)
+    {
+        std::cout << "  " << std::left << std::setw(36) << name << std::right
+            << static_cast<double>(stageTimes[name]) / static_cast<double>(info.frameCount) / 1000000.0
+            << " ms" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BenchmarkInfo info = {
+        4096u,
+        4u,
+        16u,
+        64u,
+    };
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "-capture") == 0)
+        {
+            info.capturePath = argv[i + 1];
+            continue;
+        }
+        if (std::strcmp(argv[i], "-sprite-batch") == 0)
+        {
+            info.spriteBatch = std::strtol(argv[i + 1], nullptr, 10) != 0l ? VG_TRUE : VG_FALSE;
+            continue;
+        }
+        if (std::strcmp(argv[i], "-deferred") == 0)
+        {
+            info.deferred = std::strtol(argv[i + 1], nullptr, 10) != 0l ? VG_TRUE : VG_FALSE;
+            continue;
+        }
+        uint32_t value = static_cast<uint32_t>(std::max(1l, std::strtol(argv[i + 1], nullptr, 10)));
+        if (std::strcmp(argv[i], "-objects") == 0) info.objectCount = value;
+        else if (std::strcmp(argv[i], "-depth") == 0) info.hierarchyDepth = value;
+        else if (std::strcmp(argv[i], "-materials") == 0) info.materialCount = value;
+        else if (std::strcmp(argv[i], "-frames") == 0) info.frameCount = value;
+        else std::cout << "Unknown argument: " << argv[i] << std::endl;
+    }
+
+    static plog::ConsoleAppender<plog::TxtFormatter> consoleAppender;
+    plog::init(plog::warning, &consoleAppender);
+    vg::moduleCreate(plog::warning, &consoleAppender);
+    try
+    {
+        vg::moduleCreateVkinstance("benchmark_render_binder", VK_MAKE_VERSION(1, 0, 0), {});
+        vg::moduleCreateOther(nullptr, 1u, 1u, vg::PhysicalDeviceFeatures(), vg::PhysicalDeviceFeaturePriorities());
+    }
+    catch (const std::exception &e)
+    {
+        //Machines without any vulkan device can't run it, it isn't a failure of the benchmark.
+        LOG(plog::warning) << "Benchmark is skipped, failed to create headless device: " << e.what() << std::endl;
+        return 0;
+    }
+
+    runBenchmark<vg::SpaceType::SPACE_3>(info);
+    runBenchmark<vg::SpaceType::SPACE_2>(info);
+
+    vg::moduleDestory();
+    return 0;
+}
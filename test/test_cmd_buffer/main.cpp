@@ -0,0 +1,217 @@
+#include <plog/Log.h>
+#include <graphics/graphics.hpp>
+
+#include <vector>
+#include <cstring>
+
+//Fake handle, cmd buffer only copies handles.
+template <typename HandleType>
+HandleType createHandle(uint64_t value)
+{
+    HandleType handle;
+    std::memcpy(&handle, &value, sizeof(handle));
+    return handle;
+}
+
+const vk::RenderPass renderPass = createHandle<vk::RenderPass>(0x1000u);
+const vk::Framebuffer framebuffer = createHandle<vk::Framebuffer>(0x2000u);
+const vk::Image image = createHandle<vk::Image>(0x3000u);
+
+//A render pass with draw count of draws, then a barrier with barrier count of image barriers.
+void addFrame(vg::CmdBuffer &cmdBuffer, uint32_t drawCount, uint32_t barrierCount)
+{
+    vk::ClearValue clearValues[2] = {
+        vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}),
+        vk::ClearDepthStencilValue(1.0f, 0u),
+    };
+    vg::RenderPassBeginInfo renderPassBeginInfo(&renderPass, &framebuffer, 640u, 480u
+        , fd::Rect2D(0.0f, 0.0f, 640.0f, 480.0f), 2u, clearValues);
+    vg::CmdInfo beginCmdInfo;
+    beginCmdInfo.pRenderPassBeginInfo = &renderPassBeginInfo;
+    cmdBuffer.addCmd(beginCmdInfo);
+
+    for (uint32_t i = 0; i < drawCount; ++i)
+    {
+        vg::CmdDrawIndexed cmdDrawIndexed(36u, 1u, i, 0u, 0u);
+        vg::RenderPassInfo renderPassInfo;
+        renderPassInfo.objectID = i;
+        renderPassInfo.pCmdDrawIndexed = &cmdDrawIndexed;
+        vg::CmdInfo cmdInfo;
+        cmdInfo.pRenderPassInfo = &renderPassInfo;
+        cmdBuffer.addCmd(cmdInfo);
+    }
+
+    vg::RenderPassEndInfo renderPassEndInfo;
+    vg::CmdInfo endCmdInfo;
+    endCmdInfo.pRenderPassEndInfo = &renderPassEndInfo;
+    cmdBuffer.addCmd(endCmdInfo);
+
+    std::vector<vk::ImageMemoryBarrier> imageBarriers(barrierCount);
+    for (auto &imageBarrier : imageBarriers)
+    {
+        imageBarrier.image = image;
+    }
+    vg::BarrierInfo barrierInfo(vk::PipelineStageFlagBits::eColorAttachmentOutput
+        , vk::PipelineStageFlagBits::eFragmentShader
+        , vk::DependencyFlags()
+        , 0u, nullptr
+        , 0u, nullptr
+        , barrierCount, imageBarriers.data()
+        );
+    vg::CmdInfo barrierCmdInfo;
+    barrierCmdInfo.pBarrierInfo = &barrierInfo;
+    cmdBuffer.addCmd(barrierCmdInfo);
+}
+
+//Cmds are read back in order of adding with copies of their inlined data.
+bool checkFrame(const vg::CmdBuffer &cmdBuffer, uint32_t drawCount, uint32_t barrierCount)
+{
+    if (cmdBuffer.getCmdCount() != drawCount + 3u)
+    {
+        LOG(plog::error) << "Wrong count of cmds: " << cmdBuffer.getCmdCount() << std::endl;
+        return false;
+    }
+    auto iterator = cmdBuffer.getFirstCmd();
+    const auto *pRenderPassBeginInfo = iterator->pRenderPassBeginInfo;
+    if (pRenderPassBeginInfo == nullptr || iterator->pRenderPassInfo != nullptr ||
+        *(pRenderPassBeginInfo->pRenderPass) != renderPass ||
+        pRenderPassBeginInfo->clearValueCount != 2u ||
+        pRenderPassBeginInfo->pClearValues[1].depthStencil.depth != 1.0f)
+    {
+        LOG(plog::error) << "Render pass begin info is not copied." << std::endl;
+        return false;
+    }
+    ++iterator;
+    for (uint32_t i = 0; i < drawCount; ++i, ++iterator)
+    {
+        const auto *pRenderPassInfo = iterator->pRenderPassInfo;
+        if (pRenderPassInfo == nullptr || pRenderPassInfo->objectID != i ||
+            pRenderPassInfo->pCmdDraw != nullptr || pRenderPassInfo->pGeometryBinding != nullptr ||
+            pRenderPassInfo->pCmdDrawIndexed == nullptr || pRenderPassInfo->pCmdDrawIndexed->firstIndex != i)
+        {
+            LOG(plog::error) << "Render pass info " << i << " is not copied." << std::endl;
+            return false;
+        }
+    }
+    if (iterator->pRenderPassEndInfo == nullptr)
+    {
+        LOG(plog::error) << "Render pass end info is not copied." << std::endl;
+        return false;
+    }
+    ++iterator;
+    const auto *pBarrierInfo = iterator->pBarrierInfo;
+    if (pBarrierInfo == nullptr || pBarrierInfo->imageMemoryBarrierCount != barrierCount ||
+        pBarrierInfo->pMemoryBarriers != nullptr ||
+        pBarrierInfo->pImageMemoryBarriers[barrierCount - 1u].image != image)
+    {
+        LOG(plog::error) << "Barrier info is not copied." << std::endl;
+        return false;
+    }
+    ++iterator;
+    if (iterator != cmdBuffer.getEndCmd())
+    {
+        LOG(plog::error) << "Cmds are not ended after last cmd." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testAddCmd()
+{
+    vg::CmdBuffer cmdBuffer(1024u);
+    cmdBuffer.begin();
+    if (cmdBuffer.getFirstCmd() != cmdBuffer.getEndCmd())
+    {
+        LOG(plog::error) << "Empty cmd buffer has cmds." << std::endl;
+        return false;
+    }
+    //Draws are put into some chunks and barriers are larger than a chunk.
+    addFrame(cmdBuffer, 20u, 32u);
+    cmdBuffer.end();
+    if (checkFrame(cmdBuffer, 20u, 32u) == false) return false;
+
+    //Chunks are reused when it begins again.
+    auto capacity = cmdBuffer.getCapacity();
+    cmdBuffer.begin();
+    addFrame(cmdBuffer, 20u, 32u);
+    cmdBuffer.end();
+    if (checkFrame(cmdBuffer, 20u, 32u) == false) return false;
+    if (cmdBuffer.getCapacity() != capacity)
+    {
+        LOG(plog::error) << "Chunks are not reused, capacity: " << cmdBuffer.getCapacity()
+            << ", capacity of last frame: " << capacity << std::endl;
+        return false;
+    }
+
+    cmdBuffer.clear();
+    if (cmdBuffer.getCapacity() != 0u || cmdBuffer.getCmdCount() != 0u)
+    {
+        LOG(plog::error) << "Chunks are not released by clear." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testSplitRanges()
+{
+    vg::CmdBuffer cmdBuffer(1024u);
+    cmdBuffer.begin();
+    addFrame(cmdBuffer, 30u, 1u);
+    cmdBuffer.end();
+
+    //33 cmds are split into ranges of 9, 8, 8 and 8 cmds.
+    vg::CmdBuffer::Range ranges[4];
+    cmdBuffer.splitRanges(4u, ranges);
+    auto iterator = cmdBuffer.getFirstCmd();
+    for (uint32_t rangeIndex = 0; rangeIndex < 4u; ++rangeIndex)
+    {
+        const auto &range = ranges[rangeIndex];
+        uint32_t expectedCount = rangeIndex == 0u ? 9u : 8u;
+        if (range.cmdCount != expectedCount || range.first != iterator)
+        {
+            LOG(plog::error) << "Range " << rangeIndex << " has " << range.cmdCount
+                << " cmds or isn't after last range." << std::endl;
+            return false;
+        }
+        uint32_t count = 0u;
+        for (; iterator != range.last; ++iterator)
+        {
+            ++count;
+        }
+        if (count != expectedCount)
+        {
+            LOG(plog::error) << "Range " << rangeIndex << " has " << count << " cmds in it." << std::endl;
+            return false;
+        }
+    }
+    if (iterator != cmdBuffer.getEndCmd())
+    {
+        LOG(plog::error) << "Ranges don't cover all cmds." << std::endl;
+        return false;
+    }
+
+    //Ranges are empty when there are fewer cmds than ranges.
+    cmdBuffer.begin();
+    addFrame(cmdBuffer, 0u, 1u);
+    cmdBuffer.end();
+    cmdBuffer.splitRanges(4u, ranges);
+    if (ranges[2].cmdCount != 1u || ranges[3].cmdCount != 0u ||
+        ranges[3].first != ranges[3].last || ranges[3].last != cmdBuffer.getEndCmd())
+    {
+        LOG(plog::error) << "Ranges of few cmds are wrong." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    vg::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testAddCmd() == false) result = 1;
+    if (testSplitRanges() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,198 @@
+#include <plog/Log.h>
+#include <graphics/graphics.hpp>
+
+#include <vector>
+#include <cstring>
+
+//Fake handle, recorders without gpu only compare and serialize handles.
+template <typename HandleType>
+HandleType createHandle(uint64_t value)
+{
+    HandleType handle;
+    std::memcpy(&handle, &value, sizeof(handle));
+    return handle;
+}
+
+//Two same draws in a render pass, then a barrier and a draw in another render pass.
+void recordFrame(vg::BaseCmdRecorder *pRecorder)
+{
+    auto renderPass = createHandle<vk::RenderPass>(0x1000u);
+    auto framebuffer = createHandle<vk::Framebuffer>(0x2000u);
+    auto pipeline = createHandle<vk::Pipeline>(0x3000u);
+    auto layout = createHandle<vk::PipelineLayout>(0x4000u);
+    auto descriptorSet = createHandle<vk::DescriptorSet>(0x5000u);
+    auto buffer = createHandle<vk::Buffer>(0x6000u);
+    auto image = createHandle<vk::Image>(0x7000u);
+
+    vk::ClearValue clearValue = vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f});
+    vk::RenderPassBeginInfo beginInfo = {
+        renderPass,
+        framebuffer,
+        vk::Rect2D(vk::Offset2D(0, 0), vk::Extent2D(640u, 480u)),
+        1u,
+        &clearValue
+    };
+    vk::Viewport viewport(0.0f, 0.0f, 640.0f, 480.0f, 0.0f, 1.0f);
+    vk::Rect2D scissor(vk::Offset2D(0, 0), vk::Extent2D(640u, 480u));
+    float pushValues[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    uint32_t dynamicOffset = 256u;
+    vk::DeviceSize vertexOffset = 64u;
+
+    pRecorder->beginRenderPass(beginInfo, vk::SubpassContents::eInline);
+    for (uint32_t i = 0; i < 2u; ++i)
+    {
+        pRecorder->setViewport(0u, viewport);
+        pRecorder->setScissor(0u, scissor);
+        pRecorder->pushConstants(layout, vk::ShaderStageFlagBits::eVertex, 0u, sizeof(pushValues), pushValues);
+        pRecorder->bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        pRecorder->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, 0u, 1u, &descriptorSet, 1u, &dynamicOffset);
+        pRecorder->setLineWidth(1.0f);
+        pRecorder->bindVertexBuffers(0u, 1u, &buffer, &vertexOffset);
+        pRecorder->bindIndexBuffer(buffer, 0u, vk::IndexType::eUint16);
+        pRecorder->drawIndexed(36u, 1u, 0u, 0, 0u);
+    }
+    pRecorder->endRenderPass();
+
+    vk::ImageMemoryBarrier imageBarrier = {
+        vk::AccessFlagBits::eColorAttachmentWrite,
+        vk::AccessFlagBits::eShaderRead,
+        vk::ImageLayout::eColorAttachmentOptimal,
+        vk::ImageLayout::eShaderReadOnlyOptimal,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        image,
+        vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0u, 1u, 0u, 1u)
+    };
+    pRecorder->pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput
+        , vk::PipelineStageFlagBits::eFragmentShader
+        , vk::DependencyFlags()
+        , 0u, nullptr
+        , 0u, nullptr
+        , 1u, &imageBarrier
+        );
+
+    pRecorder->beginRenderPass(beginInfo, vk::SubpassContents::eInline);
+    pRecorder->bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+    pRecorder->draw(3u, 2u, 0u, 0u);
+    pRecorder->endRenderPass();
+}
+
+bool testNullRecorder()
+{
+    vg::NullCmdRecorder recorder;
+    recordFrame(&recorder);
+    if (recorder.getTotalCount() != 25u || recorder.getDrawCount() != 3u || recorder.getDrawVertexCount() != 78u)
+    {
+        LOG(plog::error) << "Wrong count of cmds: " << recorder.getTotalCount()
+            << ", draws: " << recorder.getDrawCount()
+            << ", vertices: " << recorder.getDrawVertexCount() << std::endl;
+        return false;
+    }
+    //Second draw of first render pass sets same state again, state isn't compared across render passes.
+    const vg::CmdRecordType redundantTypes[] = {
+        vg::CmdRecordType::SET_VIEWPORT,
+        vg::CmdRecordType::SET_SCISSOR,
+        vg::CmdRecordType::SET_LINE_WIDTH,
+        vg::CmdRecordType::BIND_PIPELINE,
+        vg::CmdRecordType::BIND_DESCRIPTOR_SETS,
+        vg::CmdRecordType::BIND_VERTEX_BUFFERS,
+        vg::CmdRecordType::BIND_INDEX_BUFFER,
+    };
+    for (auto type : redundantTypes)
+    {
+        if (recorder.getRedundantCount(type) != 1u)
+        {
+            LOG(plog::error) << "Wrong redundant count of cmd type " << static_cast<uint32_t>(type) << ": "
+                << recorder.getRedundantCount(type) << std::endl;
+            return false;
+        }
+    }
+    if (recorder.getRedundantCount(vg::CmdRecordType::PUSH_CONSTANTS) != 0u ||
+        recorder.getRedundantCount(vg::CmdRecordType::DRAW_INDEXED) != 0u)
+    {
+        LOG(plog::error) << "Push constants and draws should never be redundant." << std::endl;
+        return false;
+    }
+    recorder.reset();
+    if (recorder.getTotalCount() != 0u)
+    {
+        LOG(plog::error) << "Counts are not cleared by reset." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testTraceRecorder()
+{
+    vg::TraceCmdRecorder recorder;
+    recordFrame(&recorder);
+    if (recorder.getCmdCount() != 25u || recorder.getHandleCount() != 7u)
+    {
+        LOG(plog::error) << "Wrong count of traced cmds: " << recorder.getCmdCount()
+            << ", handles: " << recorder.getHandleCount() << std::endl;
+        return false;
+    }
+
+    //Trace is same when same frame is recorded again.
+    vg::TraceCmdRecorder otherRecorder;
+    recordFrame(&otherRecorder);
+    if (otherRecorder.getData() != recorder.getData())
+    {
+        LOG(plog::error) << "Traces of same frame are different." << std::endl;
+        return false;
+    }
+
+    //Replaying into null recorder gives same counts as recording directly.
+    vg::NullCmdRecorder nullRecorder;
+    if (vg::TraceCmdRecorder::replay(recorder.getData(), &nullRecorder) == VG_FALSE ||
+        nullRecorder.getTotalCount() != 25u ||
+        nullRecorder.getDrawVertexCount() != 78u ||
+        nullRecorder.getRedundantCount(vg::CmdRecordType::BIND_PIPELINE) != 1u)
+    {
+        LOG(plog::error) << "Replayed cmds are different from recorded cmds." << std::endl;
+        return false;
+    }
+
+    //Replaying into trace recorder gives same trace.
+    vg::TraceCmdRecorder replayRecorder;
+    if (vg::TraceCmdRecorder::replay(recorder.getData(), &replayRecorder) == VG_FALSE ||
+        replayRecorder.getData() != recorder.getData())
+    {
+        LOG(plog::error) << "Trace of replaying is different from original trace." << std::endl;
+        return false;
+    }
+
+    //Truncated trace is invalid, cmds before the truncated one are still replayed.
+    auto truncatedData = recorder.getData();
+    truncatedData.resize(truncatedData.size() - 2u);
+    nullRecorder.reset();
+    if (vg::TraceCmdRecorder::replay(truncatedData, &nullRecorder) == VG_TRUE ||
+        nullRecorder.getTotalCount() != 23u)
+    {
+        LOG(plog::error) << "Truncated trace isn't detected, replayed cmds: " << nullRecorder.getTotalCount() << std::endl;
+        return false;
+    }
+
+    const std::string path = "test_cmd_recorder.vgct";
+    std::vector<uint8_t> loadedData;
+    if (recorder.save(path) == VG_FALSE ||
+        vg::TraceCmdRecorder::load(path, loadedData) == VG_FALSE ||
+        loadedData != recorder.getData())
+    {
+        LOG(plog::error) << "Loaded trace is different from saved trace." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    vg::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testNullRecorder() == false) result = 1;
+    if (testTraceRecorder() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,127 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <cstdint>
+
+FD_DEFINE_ALLOCATION_COUNTING_NEW()
+
+//Allocations whose results are never used may be removed by compilers, so results are written into it.
+uint32_t *volatile pEscapedValue = nullptr;
+
+struct Item
+{
+    uint32_t value;
+    double weight;
+};
+
+//Temporary arrays of a frame, their sizes are changed with the frame.
+void allocateFrame(fd::FrameArena &arena, uint32_t frame)
+{
+    auto pIndices = arena.allocateArray<uint32_t>(100u + frame % 7u);
+    auto pItems = arena.allocateArray<Item>(300u);
+    {
+        fd::FrameArenaScope scope(arena);
+        auto pPointers = arena.allocateArray<const Item *>(1000u);
+        pPointers[0] = pItems;
+    }
+    pIndices[0] = frame;
+}
+
+bool testAllocate()
+{
+    fd::FrameArena arena(256u);
+    auto pBytes = arena.allocateArray<uint8_t>(3u);
+    auto pItems = arena.allocateArray<Item>(4u);
+    if (reinterpret_cast<uintptr_t>(pItems) % alignof(Item) != 0u || pItems[3].value != 0u || pItems[3].weight != 0.0)
+    {
+        LOG(plog::error) << "Items are not aligned or not initialized." << std::endl;
+        return false;
+    }
+    if (reinterpret_cast<uint8_t *>(pItems) < pBytes + 3u || arena.getBlockAllocationCount() != 1u)
+    {
+        LOG(plog::error) << "Items are overlapped with bytes or put into another block." << std::endl;
+        return false;
+    }
+
+    //Memory allocated after a marker is reused after rewinding.
+    auto marker = arena.getMarker();
+    auto pFirst = arena.allocateArray<uint32_t>(8u);
+    arena.rewind(marker);
+    auto pSecond = arena.allocateArray<uint32_t>(8u);
+    if (pFirst != pSecond)
+    {
+        LOG(plog::error) << "Memory isn't reused after rewinding." << std::endl;
+        return false;
+    }
+
+    //Allocation larger than block size gets a block of its own.
+    auto pLarge = arena.allocateArray<uint8_t>(1000u);
+    if (pLarge == nullptr || arena.getBlockAllocationCount() != 2u || arena.getCapacity() < 1256u)
+    {
+        LOG(plog::error) << "Large allocation isn't put into a new block, capacity: " << arena.getCapacity() << std::endl;
+        return false;
+    }
+
+    //Blocks are kept when it is reset.
+    arena.reset();
+    if (arena.getUsedSize() != 0u || arena.allocateArray<uint8_t>(3u) != pBytes || arena.getBlockAllocationCount() != 2u)
+    {
+        LOG(plog::error) << "Blocks are not reused after resetting." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testSteadyState()
+{
+    //Frames after the largest frame don't allocate from heap.
+    fd::FrameArena arena(1024u);
+    for (uint32_t frame = 0u; frame < 8u; ++frame)
+    {
+        arena.reset();
+        allocateFrame(arena, frame);
+    }
+    uint64_t blockAllocationCount = arena.getBlockAllocationCount();
+    auto &profiler = fd::getDefaultProfiler();
+    for (uint32_t frame = 8u; frame < 64u; ++frame)
+    {
+        profiler.beginFrame();
+        arena.reset();
+        allocateFrame(arena, frame);
+        profiler.endFrame();
+        if (profiler.getLastFrameAllocationCount() != 0u)
+        {
+            LOG(plog::error) << "Frame " << frame << " allocates " << profiler.getLastFrameAllocationCount() << " times." << std::endl;
+            return false;
+        }
+    }
+    if (arena.getBlockAllocationCount() != blockAllocationCount)
+    {
+        LOG(plog::error) << "Blocks are allocated in steady state." << std::endl;
+        return false;
+    }
+
+    //Counting hook sees allocations of the frame.
+    profiler.beginFrame();
+    pEscapedValue = new uint32_t(1u);
+    delete pEscapedValue;
+    profiler.endFrame();
+    if (profiler.getLastFrameAllocationCount() != 1u)
+    {
+        LOG(plog::error) << "Allocation of the frame isn't counted." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testAllocate() == false) result = 1;
+    if (testSteadyState() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,178 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+//Cluster containing the point, it returns false when the point is out of the grid.
+bool findCluster(const fd::LightClusterAssigner &assigner, const glm::vec3 &point, uint32_t &clusterIndex)
+{
+    const auto &gridInfo = assigner.getGridInfo();
+    uint32_t z = assigner.caculateSlice(point.z);
+    if (z == gridInfo.clusterCountZ) return false;
+    float u = (point.x / point.z / gridInfo.tanHalfFovX + 1.0f) * 0.5f;
+    float v = (point.y / point.z / gridInfo.tanHalfFovY + 1.0f) * 0.5f;
+    if (u < 0.0f || u >= 1.0f || v < 0.0f || v >= 1.0f) return false;
+    uint32_t x = static_cast<uint32_t>(u * gridInfo.clusterCountX);
+    uint32_t y = static_cast<uint32_t>(v * gridInfo.clusterCountY);
+    clusterIndex = assigner.getClusterIndex(x, y, z);
+    return true;
+}
+
+bool isAssigned(const fd::LightClusterAssigner &assigner, uint32_t clusterIndex, uint32_t lightIndex)
+{
+    const auto &cluster = assigner.getClusters()[clusterIndex];
+    const auto &indices = assigner.getLightIndices();
+    return std::binary_search(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count, lightIndex);
+}
+
+float random(float min, float max)
+{
+    return min + (max - min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+bool testLists()
+{
+    fd::LightClusterGridInfo gridInfo(16u, 9u, 24u, 1.0f, 0.5625f, 0.1f, 100.0f);
+    fd::LightClusterAssigner assigner(gridInfo);
+    srand(1u);
+    for (uint32_t i = 0; i < 4096u; ++i)
+    {
+        glm::vec3 position(random(-60.0f, 60.0f), random(-40.0f, 40.0f), random(-10.0f, 110.0f));
+        if (i % 2u == 0u)
+        {
+            assigner.addPointLight(position, random(0.5f, 5.0f));
+        }
+        else
+        {
+            glm::vec3 direction(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f));
+            if (glm::length(direction) < 0.01f) direction = glm::vec3(0.0f, 0.0f, 1.0f);
+            assigner.addSpotLight(position, direction, random(0.5f, 8.0f), random(0.1f, 1.4f));
+        }
+    }
+    assigner.assign();
+
+    //Lists are compact and ascending.
+    const auto &clusters = assigner.getClusters();
+    const auto &indices = assigner.getLightIndices();
+    if (clusters.size() != assigner.getClusterCount())
+    {
+        LOG(plog::error) << "Cluster count is " << clusters.size() << std::endl;
+        return false;
+    }
+    uint32_t offset = 0u;
+    for (const auto &cluster : clusters)
+    {
+        if (cluster.offset != offset)
+        {
+            LOG(plog::error) << "Light index lists aren't compact." << std::endl;
+            return false;
+        }
+        for (uint32_t i = 1u; i < cluster.count; ++i)
+        {
+            if (indices[cluster.offset + i - 1u] >= indices[cluster.offset + i])
+            {
+                LOG(plog::error) << "Light indices of a cluster aren't ascending." << std::endl;
+                return false;
+            }
+        }
+        offset += cluster.count;
+    }
+    if (offset != indices.size())
+    {
+        LOG(plog::error) << "Light index count is " << indices.size() << ", sum of cluster counts is " << offset << std::endl;
+        return false;
+    }
+
+    //Every sampled point lit by a light is in a cluster containing the light, points of spot lights are
+    //sampled in their bounding spheres, so the check of them is weaker.
+    fd::LightClusterAssigner pointAssigner(gridInfo);
+    srand(2u);
+    std::vector<glm::vec4> spheres;
+    for (uint32_t i = 0; i < 1024u; ++i)
+    {
+        glm::vec3 position(random(-60.0f, 60.0f), random(-40.0f, 40.0f), random(-10.0f, 110.0f));
+        float range = random(0.5f, 5.0f);
+        pointAssigner.addPointLight(position, range);
+        spheres.push_back(glm::vec4(position, range));
+    }
+    pointAssigner.assign();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(spheres.size()); ++i)
+    {
+        const auto &sphere = spheres[i];
+        for (uint32_t sample = 0; sample < 256u; ++sample)
+        {
+            glm::vec3 direction(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f));
+            if (glm::length(direction) > 1.0f) continue;
+            glm::vec3 point = glm::vec3(sphere.x, sphere.y, sphere.z) + direction * sphere.w;
+            uint32_t clusterIndex;
+            if (findCluster(pointAssigner, point, clusterIndex) == false) continue;
+            if (isAssigned(pointAssigner, clusterIndex, i) == false)
+            {
+                LOG(plog::error) << "Light " << i << " isn't assigned to cluster " << clusterIndex << std::endl;
+                return false;
+            }
+        }
+    }
+
+    //The result is same when it is assigned again.
+    auto oldIndices = indices;
+    assigner.assign();
+    if (oldIndices != assigner.getLightIndices())
+    {
+        LOG(plog::error) << "Assignment isn't deterministic." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testSingleCluster()
+{
+    fd::LightClusterGridInfo gridInfo(4u, 4u, 4u, 1.0f, 1.0f, 1.0f, 16.0f);
+    fd::LightClusterAssigner assigner(gridInfo);
+    //Slices are [1, 2), [2, 4), [4, 8) and [8, 16), tiles at depth 6 are 3 wide.
+    assigner.addPointLight(glm::vec3(1.5f, -1.5f, 6.0f), 0.2f);
+    //Behind the far plane and in front of the near plane.
+    assigner.addPointLight(glm::vec3(0.0f, 0.0f, 20.0f), 1.0f);
+    assigner.addPointLight(glm::vec3(0.0f, 0.0f, 0.2f), 0.5f);
+    //Out of the left of the frustum.
+    assigner.addPointLight(glm::vec3(-10.0f, 0.0f, 4.0f), 1.0f);
+    assigner.assign();
+
+    const auto &clusters = assigner.getClusters();
+    uint32_t expectedIndex = assigner.getClusterIndex(2u, 1u, 2u);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(clusters.size()); ++i)
+    {
+        uint32_t expectedCount = i == expectedIndex ? 1u : 0u;
+        if (clusters[i].count != expectedCount)
+        {
+            LOG(plog::error) << "Cluster " << i << " has " << clusters[i].count << " lights." << std::endl;
+            return false;
+        }
+    }
+    if (assigner.getLightIndices().size() != 1u || assigner.getLightIndices()[0] != 0u)
+    {
+        LOG(plog::error) << "Lights out of the grid are assigned." << std::endl;
+        return false;
+    }
+    if (assigner.caculateSlice(0.5f) != 4u || assigner.caculateSlice(3.0f) != 1u || assigner.caculateSlice(16.0f) != 4u)
+    {
+        LOG(plog::error) << "Slices of depth are wrong." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testLists() == false) result = 1;
+    if (testSingleCluster() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,153 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#define TEST_MESH_CACHE_FILE_NAME "test_mesh_cache.bin"
+#define TEST_MESH_CACHE_SOURCE_FILE_NAME "test_mesh_cache_source.bin"
+
+bool testWriteAndRead()
+{
+    //Interleaved position and uv of a quad, two sub meshes share the vertices.
+    std::vector<float> vertices = {
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+        1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
+    };
+    std::vector<uint32_t> indices = {0, 2, 1, 1, 2, 3};
+    uint32_t stride = 5u * static_cast<uint32_t>(sizeof(float));
+    uint64_t key = fd::hashMeshCacheKey(&stride, sizeof(stride));
+
+    fd::MeshCacheWriter writer;
+    uint32_t vertexStreamIndex = writer.addVertexStream(vertices.data(), stride, 4u);
+    uint32_t indexStreamIndex = writer.addIndexStream(indices.data(), static_cast<uint32_t>(indices.size()));
+    for (uint32_t i = 0; i < 2u; ++i)
+    {
+        fd::MeshCacheSubMesh subMesh;
+        subMesh.vertexStreamIndex = vertexStreamIndex;
+        subMesh.vertexCount = 4u;
+        subMesh.indexStreamIndex = indexStreamIndex;
+        subMesh.indexOffset = i * 3u;
+        subMesh.indexCount = 3u;
+        subMesh.materialIndex = i;
+        subMesh.boundsMax[0] = 1.0f;
+        subMesh.boundsMax[1] = 1.0f;
+        writer.addSubMesh(subMesh);
+    }
+    float red[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    writer.addMaterial(fd::MeshCacheMaterial("red", "red.png", red));
+    writer.addMaterial(fd::MeshCacheMaterial("default"));
+    if (writer.write(TEST_MESH_CACHE_FILE_NAME, key) == FD_FALSE)
+    {
+        LOG(plog::error) << "Failed to write mesh cache." << std::endl;
+        return false;
+    }
+
+    fd::MeshCacheFile file;
+    if (file.open(TEST_MESH_CACHE_FILE_NAME, key + 1u) == FD_TRUE)
+    {
+        LOG(plog::error) << "Mesh cache with different key is opened." << std::endl;
+        return false;
+    }
+    if (file.open(TEST_MESH_CACHE_FILE_NAME, key) == FD_FALSE)
+    {
+        LOG(plog::error) << "Failed to open mesh cache." << std::endl;
+        return false;
+    }
+    const auto &vertexStream = file.getVertexStream(0u);
+    const auto &indexStream = file.getIndexStream(0u);
+    if (file.getVertexStreamCount() != 1u || vertexStream.stride != stride || vertexStream.count != 4u ||
+        memcmp(file.getVertexStreamData(0u), vertices.data(), vertices.size() * sizeof(float)) != 0 ||
+        reinterpret_cast<uintptr_t>(file.getVertexStreamData(0u)) % FD_MESH_CACHE_ALIGNMENT != 0u)
+    {
+        LOG(plog::error) << "Vertex stream of mesh cache is wrong." << std::endl;
+        return false;
+    }
+    if (file.getIndexStreamCount() != 1u || indexStream.count != 6u ||
+        memcmp(file.getIndexStreamData(0u), indices.data(), indices.size() * sizeof(uint32_t)) != 0)
+    {
+        LOG(plog::error) << "Index stream of mesh cache is wrong." << std::endl;
+        return false;
+    }
+    if (file.getSubMeshCount() != 2u || file.getSubMeshes()[1].indexOffset != 3u ||
+        file.getSubMeshes()[1].materialIndex != 1u || file.getSubMeshes()[0].boundsMax[1] != 1.0f)
+    {
+        LOG(plog::error) << "Sub mesh table of mesh cache is wrong." << std::endl;
+        return false;
+    }
+    if (file.getMaterialCount() != 2u || strcmp(file.getMaterials()[0].diffuseTexture, "red.png") != 0 ||
+        file.getMaterials()[0].diffuseColor[1] != 0.0f || strcmp(file.getMaterials()[1].name, "default") != 0)
+    {
+        LOG(plog::error) << "Material table of mesh cache is wrong." << std::endl;
+        return false;
+    }
+    file.close();
+
+    //A truncated file isn't accepted.
+    FILE *pFile = fopen(TEST_MESH_CACHE_FILE_NAME, "rb");
+    std::vector<char> content(1024u);
+    size_t size = fread(content.data(), 1u, content.size(), pFile);
+    fclose(pFile);
+    pFile = fopen(TEST_MESH_CACHE_FILE_NAME, "wb");
+    fwrite(content.data(), 1u, size - 4u, pFile);
+    fclose(pFile);
+    fd::Bool32 isTruncatedOpen = file.open(TEST_MESH_CACHE_FILE_NAME, key);
+    remove(TEST_MESH_CACHE_FILE_NAME);
+    if (isTruncatedOpen == FD_TRUE)
+    {
+        LOG(plog::error) << "Truncated mesh cache is opened." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testHashSource()
+{
+    //Source is bigger than 3 samples, so only head, middle and tail are hashed.
+    std::vector<uint8_t> content(FD_MESH_CACHE_SOURCE_SAMPLE_SIZE * 4u);
+    for (size_t i = 0; i < content.size(); ++i)
+    {
+        content[i] = static_cast<uint8_t>(i * 7u);
+    }
+    FILE *pFile = fopen(TEST_MESH_CACHE_SOURCE_FILE_NAME, "wb");
+    fwrite(content.data(), 1u, content.size(), pFile);
+    fclose(pFile);
+    uint64_t hash = fd::hashMeshCacheSource(TEST_MESH_CACHE_SOURCE_FILE_NAME);
+    uint64_t sameHash = fd::hashMeshCacheSource(TEST_MESH_CACHE_SOURCE_FILE_NAME);
+
+    //A byte in the middle sample is changed with same size.
+    content[content.size() / 2u] += 1u;
+    pFile = fopen(TEST_MESH_CACHE_SOURCE_FILE_NAME, "wb");
+    fwrite(content.data(), 1u, content.size(), pFile);
+    fclose(pFile);
+    uint64_t changedHash = fd::hashMeshCacheSource(TEST_MESH_CACHE_SOURCE_FILE_NAME);
+    remove(TEST_MESH_CACHE_SOURCE_FILE_NAME);
+    uint64_t missingHash = fd::hashMeshCacheSource(TEST_MESH_CACHE_SOURCE_FILE_NAME);
+
+    if (hash != sameHash)
+    {
+        LOG(plog::error) << "Hash of same source is different." << std::endl;
+        return false;
+    }
+    if (hash == changedHash || hash == missingHash)
+    {
+        LOG(plog::error) << "Hash of changed source isn't changed." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testWriteAndRead() == false) result = 1;
+    if (testHashSource() == false) result = 1;
+    return result;
+}
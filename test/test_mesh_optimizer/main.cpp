@@ -0,0 +1,305 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+//Build a grid with size * size quads whose triangles are shuffled, it is the worst input order for vertex cache.
+void createShuffledGrid(uint32_t size, std::vector<float> &positions, std::vector<uint32_t> &indices)
+{
+    uint32_t vertexCountPerLine = size + 1u;
+    positions.resize(vertexCountPerLine * vertexCountPerLine * 3u);
+    for (uint32_t y = 0; y < vertexCountPerLine; ++y)
+    {
+        for (uint32_t x = 0; x < vertexCountPerLine; ++x)
+        {
+            uint32_t vertex = y * vertexCountPerLine + x;
+            positions[vertex * 3u] = static_cast<float>(x);
+            positions[vertex * 3u + 1u] = static_cast<float>(y);
+            positions[vertex * 3u + 2u] = 0.0f;
+        }
+    }
+
+    std::vector<uint32_t> quads(size * size);
+    for (uint32_t i = 0; i < size * size; ++i) quads[i] = i;
+    std::mt19937 random(1u);
+    std::shuffle(quads.begin(), quads.end(), random);
+
+    indices.clear();
+    for (const auto &quad : quads)
+    {
+        uint32_t x = quad % size;
+        uint32_t y = quad / size;
+        uint32_t v0 = y * vertexCountPerLine + x;
+        uint32_t v1 = v0 + 1u;
+        uint32_t v2 = v0 + vertexCountPerLine;
+        uint32_t v3 = v2 + 1u;
+        indices.insert(indices.end(), {v0, v2, v1, v1, v2, v3});
+    }
+}
+
+bool testVertexCache()
+{
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    createShuffledGrid(64u, positions, indices);
+    uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3u);
+    uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    fd::VertexCacheStatistics before = fd::analyzeVertexCache(indices.data(), indexCount, vertexCount);
+
+    std::vector<uint32_t> optimizedIndices(indexCount);
+    std::vector<uint32_t> clusterOffsets;
+    fd::optimizeVertexCache(optimizedIndices.data(), indices.data(), indexCount, vertexCount,
+        FD_MESH_OPTIMIZER_DEFAULT_CACHE_SIZE, &clusterOffsets);
+    fd::VertexCacheStatistics after = fd::analyzeVertexCache(optimizedIndices.data(), indexCount, vertexCount);
+
+    std::vector<uint32_t> overdrawIndices(indexCount);
+    fd::optimizeOverdraw(overdrawIndices.data(), optimizedIndices.data(), indexCount,
+        positions.data(), 3u * sizeof(float), clusterOffsets);
+    fd::VertexCacheStatistics afterOverdraw = fd::analyzeVertexCache(overdrawIndices.data(), indexCount, vertexCount);
+
+    LOG(plog::debug) << "Vertex cache, before: ACMR " << before.acmr << ", ATVR " << before.atvr
+        << "; after: ACMR " << after.acmr << ", ATVR " << after.atvr
+        << "; after overdraw: ACMR " << afterOverdraw.acmr << ", ATVR " << afterOverdraw.atvr
+        << ", cluster count: " << clusterOffsets.size() << std::endl;
+
+    //The triangles must be kept.
+    std::vector<uint32_t> sortedSrc(indices);
+    std::vector<uint32_t> sortedDst(overdrawIndices);
+    std::sort(sortedSrc.begin(), sortedSrc.end());
+    std::sort(sortedDst.begin(), sortedDst.end());
+    if (sortedSrc != sortedDst)
+    {
+        LOG(plog::error) << "Optimized indices don't keep the original vertices." << std::endl;
+        return false;
+    }
+    if (after.acmr >= before.acmr || after.acmr > 1.0f)
+    {
+        LOG(plog::error) << "Vertex cache optimization doesn't reduce ACMR." << std::endl;
+        return false;
+    }
+    if (afterOverdraw.acmr > after.acmr * 1.1f)
+    {
+        LOG(plog::error) << "Overdraw optimization breaks vertex cache efficiency." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testVertexRemap()
+{
+    //Two triangles of a quad whose shared vertices are duplicated and one unused vertex at the end.
+    std::vector<float> positions = {
+        0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f,
+        1.0f, 0.0f, 0.0f,
+        1.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, 0.0f,
+        5.0f, 5.0f, 5.0f,
+    };
+    std::vector<uint32_t> indices = {5, 4, 3, 0, 1, 2};
+    uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3u);
+    uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    fd::VertexStream stream(positions.data(), 3u * sizeof(float), 3u * sizeof(float));
+    std::vector<uint32_t> remap(vertexCount);
+    uint32_t uniqueCount = fd::generateVertexDeduplicateRemap(remap.data(), indices.data(), indexCount, vertexCount, &stream, 1u);
+    if (uniqueCount != 4u || remap[6] != FD_MESH_OPTIMIZER_INVALID_INDEX)
+    {
+        LOG(plog::error) << "Deduplicate remap is wrong, unique count: " << uniqueCount << std::endl;
+        return false;
+    }
+
+    std::vector<float> newPositions(uniqueCount * 3u);
+    fd::remapVertices(newPositions.data(), positions.data(), vertexCount, 3u * sizeof(float), remap.data());
+    fd::remapIndices(indices.data(), indices.data(), indexCount, remap.data());
+    //Vertices should be ordered by their first use.
+    std::vector<uint32_t> expectIndices = {0, 1, 2, 3, 1, 2};
+    if (indices != expectIndices || newPositions[0] != 1.0f || newPositions[1] != 1.0f)
+    {
+        LOG(plog::error) << "Remapped vertices is wrong." << std::endl;
+        return false;
+    }
+
+    uint32_t fetchCount = fd::generateVertexFetchRemap(remap.data(), indices.data(), indexCount, uniqueCount);
+    if (fetchCount != uniqueCount)
+    {
+        LOG(plog::error) << "Vertex fetch remap is wrong." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//Build a height field grid, the surface is flat when height is zero.
+void createHeightField(uint32_t size, float height, std::vector<float> &positions, std::vector<uint32_t> &indices)
+{
+    uint32_t vertexCountPerLine = size + 1u;
+    positions.resize(vertexCountPerLine * vertexCountPerLine * 3u);
+    for (uint32_t y = 0; y < vertexCountPerLine; ++y)
+    {
+        for (uint32_t x = 0; x < vertexCountPerLine; ++x)
+        {
+            uint32_t vertex = y * vertexCountPerLine + x;
+            float u = static_cast<float>(x) / static_cast<float>(size);
+            float v = static_cast<float>(y) / static_cast<float>(size);
+            positions[vertex * 3u] = u;
+            positions[vertex * 3u + 1u] = v;
+            positions[vertex * 3u + 2u] = height * std::sin(u * 6.28f) * std::sin(v * 6.28f);
+        }
+    }
+
+    indices.clear();
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t v0 = y * vertexCountPerLine + x;
+            uint32_t v1 = v0 + 1u;
+            uint32_t v2 = v0 + vertexCountPerLine;
+            uint32_t v3 = v2 + 1u;
+            indices.insert(indices.end(), {v0, v2, v1, v1, v2, v3});
+        }
+    }
+}
+
+bool testSimplify()
+{
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    createHeightField(32u, 0.0f, positions, indices);
+    uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3u);
+    uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    //A flat grid can be simplified to a few triangles without error.
+    std::vector<uint32_t> lodIndices(indexCount);
+    float error = 0.0f;
+    uint32_t lodIndexCount = fd::simplifyMesh(lodIndices.data(), indices.data(), indexCount, positions.data(),
+        vertexCount, 3u * sizeof(float), indexCount / 20u, 0.001f, &error);
+    LOG(plog::debug) << "Simplify flat grid, index count: " << indexCount << " -> " << lodIndexCount
+        << ", error: " << error << std::endl;
+    if (lodIndexCount > indexCount / 20u || lodIndexCount == 0u || error > 0.001f)
+    {
+        LOG(plog::error) << "Flat grid isn't simplified to the target." << std::endl;
+        return false;
+    }
+
+    //A curved surface is limited by the target error.
+    createHeightField(32u, 0.2f, positions, indices);
+    uint32_t halfIndexCount = fd::simplifyMesh(lodIndices.data(), indices.data(), indexCount, positions.data(),
+        vertexCount, 3u * sizeof(float), indexCount / 2u, 1.0f, &error);
+    uint32_t strictIndexCount = fd::simplifyMesh(lodIndices.data(), indices.data(), indexCount, positions.data(),
+        vertexCount, 3u * sizeof(float), indexCount / 20u, 0.0005f, &error);
+    LOG(plog::debug) << "Simplify curved grid, index count: " << indexCount << " -> " << halfIndexCount
+        << ", with small error: " << strictIndexCount << ", error: " << error << std::endl;
+    if (halfIndexCount > indexCount / 2u || strictIndexCount <= indexCount / 20u || error > 0.0005f)
+    {
+        LOG(plog::error) << "Simplification of curved grid doesn't respect target." << std::endl;
+        return false;
+    }
+    for (uint32_t i = 0; i < strictIndexCount; ++i)
+    {
+        if (lodIndices[i] >= vertexCount)
+        {
+            LOG(plog::error) << "Simplified index is out of range." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testClusters()
+{
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    createHeightField(32u, 0.0f, positions, indices);
+    uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3u);
+    uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    std::vector<fd::MeshCluster> clusters;
+    uint32_t clusterCount = fd::buildMeshClusters(clusters, indices.data(), indexCount, positions.data(),
+        vertexCount, 3u * sizeof(float));
+    LOG(plog::debug) << "Build clusters, triangle count: " << indexCount / 3u
+        << ", cluster count: " << clusterCount << std::endl;
+
+    //Clusters should cover the index list in order and respect the limits.
+    uint32_t indexOffset = 0u;
+    for (const auto &cluster : clusters)
+    {
+        if (cluster.indexOffset != indexOffset ||
+            cluster.vertexCount > FD_MESH_CLUSTER_DEFAULT_MAX_VERTEX_COUNT ||
+            cluster.indexCount > FD_MESH_CLUSTER_DEFAULT_MAX_TRIANGLE_COUNT * 3u)
+        {
+            LOG(plog::error) << "Cluster range is wrong, offset: " << cluster.indexOffset
+                << ", vertex count: " << cluster.vertexCount << std::endl;
+            return false;
+        }
+        indexOffset += cluster.indexCount;
+        for (uint32_t i = 0; i < cluster.indexCount; ++i)
+        {
+            const float *p = positions.data() + indices[cluster.indexOffset + i] * 3u;
+            float x = p[0] - cluster.center[0];
+            float y = p[1] - cluster.center[1];
+            float z = p[2] - cluster.center[2];
+            if (std::sqrt(x * x + y * y + z * z) > cluster.radius * 1.0001f)
+            {
+                LOG(plog::error) << "Bounding sphere of cluster doesn't contain its vertices." << std::endl;
+                return false;
+            }
+        }
+    }
+    if (indexOffset != indexCount || clusterCount < 2u)
+    {
+        LOG(plog::error) << "Clusters don't cover the mesh." << std::endl;
+        return false;
+    }
+
+    //Triangles of the grid face -z, so every cluster is back facing to a viewer at +z.
+    const fd::MeshCluster &cluster = clusters[0];
+    float front[3] = {0.5f, 0.5f, -10.0f};
+    float back[3] = {0.5f, 0.5f, 10.0f};
+    if (cluster.coneCutoff > 0.001f ||
+        fd::isClusterBackfacing(cluster, back) == FD_FALSE ||
+        fd::isClusterBackfacing(cluster, front) == FD_TRUE)
+    {
+        LOG(plog::error) << "Normal cone culling of cluster is wrong." << std::endl;
+        return false;
+    }
+
+    //Clip space of identity matrix is the box [-1, 1] x [-1, 1] x [0, 1].
+    float clipMatrix[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f,
+    };
+    float planes[24];
+    fd::getFrustumPlanes(clipMatrix, planes);
+    fd::MeshCluster outside;
+    outside.center[0] = 5.0f;
+    outside.radius = 1.0f;
+    if (fd::isClusterOutsideFrustum(cluster, planes) == FD_TRUE ||
+        fd::isClusterOutsideFrustum(outside, planes) == FD_FALSE)
+    {
+        LOG(plog::error) << "Frustum culling of cluster is wrong." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testVertexCache() == false) result = 1;
+    if (testVertexRemap() == false) result = 1;
+    if (testSimplify() == false) result = 1;
+    if (testClusters() == false) result = 1;
+    return result;
+}
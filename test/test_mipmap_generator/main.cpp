@@ -0,0 +1,144 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+bool testBox()
+{
+    //Two layers of 3 x 2 pixels, odd width makes every pixel of level 1 average all pixels.
+    const uint32_t width = 3u;
+    const uint32_t height = 2u;
+    const uint32_t layerCount = 2u;
+    uint32_t levelCount = fd::caculateMipmapLevelCount(width, height);
+    uint32_t size = fd::caculateMipmapLevelOffset(fd::MipmapChannelType::UNORM8, 1u, width, height, layerCount, levelCount);
+    if (levelCount != 2u || size != (6u + 1u) * layerCount)
+    {
+        LOG(plog::error) << "Mipmap level count is " << levelCount << " and chain size is " << size << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data(size, 0u);
+    const uint8_t pixels[12] = {0u, 30u, 60u, 90u, 120u, 150u, 10u, 10u, 10u, 10u, 10u, 70u};
+    for (uint32_t i = 0; i < 12u; ++i) data[i] = pixels[i];
+    fd::generateMipmaps(fd::MipmapChannelType::UNORM8, 1u, fd::MipmapGenerateInfo(), width, height, layerCount, levelCount,
+        data.data());
+    if (data[12] != 75u || data[13] != 20u)
+    {
+        LOG(plog::error) << "Box filter results are " << static_cast<uint32_t>(data[12]) << " and " <<
+            static_cast<uint32_t>(data[13]) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testSRGB()
+{
+    //Half black and half white is middle gray in linear space, color channels of sRGB are 188 but alpha is 128.
+    std::vector<uint8_t> data(fd::caculateMipmapLevelOffset(fd::MipmapChannelType::SRGB8, 4u, 2u, 2u, 1u, 2u));
+    const uint8_t pixels[16] = {0u, 0u, 0u, 0u, 255u, 255u, 255u, 255u, 255u, 255u, 255u, 255u, 0u, 0u, 0u, 0u};
+    for (uint32_t i = 0; i < 16u; ++i) data[i] = pixels[i];
+    fd::generateMipmaps(fd::MipmapChannelType::SRGB8, 4u, fd::MipmapGenerateInfo(), 2u, 2u, 1u, 2u, data.data());
+    if (data[16] != 188u || data[17] != 188u || data[18] != 188u || data[19] != 128u)
+    {
+        LOG(plog::error) << "sRGB box filter results are " << static_cast<uint32_t>(data[16]) << " and " <<
+            static_cast<uint32_t>(data[19]) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testKaiserAndIntegers()
+{
+    //Constant images are kept by normalized filters, integer channels are kept exactly.
+    const uint32_t width = 13u;
+    const uint32_t height = 7u;
+    uint32_t levelCount = fd::caculateMipmapLevelCount(width, height);
+    uint32_t size = fd::caculateMipmapLevelOffset(fd::MipmapChannelType::UINT16, 2u, width, height, 1u, levelCount);
+    std::vector<uint16_t> data(size / sizeof(uint16_t));
+    for (uint32_t i = 0; i < width * height; ++i)
+    {
+        data[i * 2u] = 40000u;
+        data[i * 2u + 1u] = 7u;
+    }
+    fd::generateMipmaps(fd::MipmapChannelType::UINT16, 2u, fd::MipmapGenerateInfo(fd::MipmapFilter::KAISER),
+        width, height, 1u, levelCount, reinterpret_cast<uint8_t *>(data.data()));
+    for (uint32_t i = width * height; i < data.size() / 2u; ++i)
+    {
+        if (data[i * 2u] != 40000u || data[i * 2u + 1u] != 7u)
+        {
+            LOG(plog::error) << "Kaiser filter changes the constant image at pixel " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+float getCoverage(const uint8_t *pPixels, uint32_t pixelCount, uint8_t cutoff)
+{
+    uint32_t count = 0u;
+    for (uint32_t i = 0; i < pixelCount; ++i)
+    {
+        if (pPixels[i * 4u + 3u] >= cutoff) ++count;
+    }
+    return static_cast<float>(count) / static_cast<float>(pixelCount);
+}
+
+bool testAlphaCoverage()
+{
+    //Thin lines of cutout texture fade with filtering, coverage is kept when it is preserved.
+    //Alpha of the lines changes along y, so coverage of filtered levels can be near the coverage of level 0.
+    const uint32_t size = 64u;
+    uint32_t levelCount = 4u;
+    uint32_t chainSize = fd::caculateMipmapLevelOffset(fd::MipmapChannelType::UNORM8, 4u, size, size, 1u, levelCount);
+    std::vector<uint8_t> source(chainSize, 255u);
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            source[(y * size + x) * 4u + 3u] = x % 4u == 0u ? static_cast<uint8_t>(y * 255u / (size - 1u)) : 0u;
+        }
+    }
+    float targetCoverage = getCoverage(source.data(), size * size, 128u);
+
+    for (uint32_t preserve = 0; preserve < 2u; ++preserve)
+    {
+        std::vector<uint8_t> data = source;
+        fd::MipmapGenerateInfo info(fd::MipmapFilter::BOX, preserve != 0u ? FD_TRUE : FD_FALSE, 128.0f / 255.0f);
+        fd::generateMipmaps(fd::MipmapChannelType::UNORM8, 4u, info, size, size, 1u, levelCount, data.data());
+        //The first level keeps the lines, coverage of the third level is checked.
+        uint32_t offset = fd::caculateMipmapLevelOffset(fd::MipmapChannelType::UNORM8, 4u, size, size, 1u, 2u);
+        float coverage = getCoverage(data.data() + offset, (size >> 2u) * (size >> 2u), 128u);
+        bool isKept = std::abs(coverage - targetCoverage) < 0.05f;
+        if (isKept != (preserve != 0u))
+        {
+            LOG(plog::error) << "Alpha coverage is " << coverage << " with target " << targetCoverage <<
+                " when preserving is " << preserve << std::endl;
+            return false;
+        }
+
+        //Generation is deterministic.
+        std::vector<uint8_t> again = source;
+        fd::generateMipmaps(fd::MipmapChannelType::UNORM8, 4u, info, size, size, 1u, levelCount, again.data());
+        if (again != data)
+        {
+            LOG(plog::error) << "Results of same mipmap generation are different." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testBox() == false) result = 1;
+    if (testSRGB() == false) result = 1;
+    if (testKaiserAndIntegers() == false) result = 1;
+    if (testAlphaCoverage() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,84 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cstdlib>
+
+bool isOverlapped(const fd::SkylinePacker::Rect &a, const fd::SkylinePacker::Rect &b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool testFill()
+{
+    //Same squares fill the bin completely.
+    fd::SkylinePacker packer(64u, 64u);
+    fd::SkylinePacker::Rect rect;
+    for (uint32_t i = 0; i < 16u; ++i)
+    {
+        if (packer.pack(16u, 16u, rect) == FD_FALSE)
+        {
+            LOG(plog::error) << "Square " << i << " can't be packed." << std::endl;
+            return false;
+        }
+    }
+    if (packer.pack(1u, 1u, rect) == FD_TRUE || packer.getOccupancy() != 1.0f)
+    {
+        LOG(plog::error) << "The full bin accepts more rectangles, occupancy is " << packer.getOccupancy() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testRandom()
+{
+    //Rectangles with random sizes don't overlap and they are in the bin.
+    const uint32_t size = 256u;
+    fd::SkylinePacker packer(size, size);
+    std::vector<fd::SkylinePacker::Rect> rects;
+    srand(7u);
+    uint32_t failedCount = 0u;
+    for (uint32_t i = 0; i < 400u; ++i)
+    {
+        uint32_t width = 4u + static_cast<uint32_t>(rand()) % 28u;
+        uint32_t height = 4u + static_cast<uint32_t>(rand()) % 28u;
+        fd::SkylinePacker::Rect rect;
+        if (packer.pack(width, height, rect) == FD_FALSE)
+        {
+            ++failedCount;
+            continue;
+        }
+        if (rect.x + rect.width > size || rect.y + rect.height > size)
+        {
+            LOG(plog::error) << "Rectangle " << i << " is out of the bin." << std::endl;
+            return false;
+        }
+        for (const auto &other : rects)
+        {
+            if (isOverlapped(rect, other))
+            {
+                LOG(plog::error) << "Rectangle " << i << " is overlapped with another." << std::endl;
+                return false;
+            }
+        }
+        rects.push_back(rect);
+    }
+    if (failedCount == 0u || packer.getOccupancy() < 0.7f)
+    {
+        LOG(plog::error) << "Occupancy of the bin is " << packer.getOccupancy() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testFill() == false) result = 1;
+    if (testRandom() == false) result = 1;
+    return result;
+}
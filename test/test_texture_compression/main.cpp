@@ -0,0 +1,130 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+//Root mean square error of every channel.
+double getRMSError(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+{
+    double error = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        double diff = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+        error += diff * diff;
+    }
+    return std::sqrt(error / static_cast<double>(a.size()));
+}
+
+bool testDecodeBC1()
+{
+    //Color0 is red and color1 is blue, index of every pixel is 2.
+    uint8_t block[8] = {0x00, 0xf8, 0x1f, 0x00, 0xaa, 0xaa, 0xaa, 0xaa};
+    std::vector<uint8_t> pixels(16u * 4u);
+    fd::decompressBlocks(fd::BlockFormat::BC1, block, 4u, 4u, pixels.data());
+    if (pixels[0] != 170u || pixels[1] != 0u || pixels[2] != 85u || pixels[3] != 255u)
+    {
+        LOG(plog::error) << "BC1 four color block is decoded wrong." << std::endl;
+        return false;
+    }
+
+    //Color0 isn't greater than color1, index 3 is transparent black.
+    uint8_t transparentBlock[8] = {0x1f, 0x00, 0x00, 0xf8, 0xff, 0xff, 0xff, 0xff};
+    fd::decompressBlocks(fd::BlockFormat::BC1, transparentBlock, 4u, 4u, pixels.data());
+    if (pixels[0] != 0u || pixels[1] != 0u || pixels[2] != 0u || pixels[3] != 0u)
+    {
+        LOG(plog::error) << "BC1 three color block is decoded wrong." << std::endl;
+        return false;
+    }
+
+    //Index 3 of three color mode is opaque black for BC1 without alpha.
+    fd::decompressBlocks(fd::BlockFormat::BC1_RGB, transparentBlock, 4u, 4u, pixels.data());
+    if (pixels[0] != 0u || pixels[1] != 0u || pixels[2] != 0u || pixels[3] != 255u)
+    {
+        LOG(plog::error) << "BC1 RGB three color block is decoded wrong." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testRoundTrip()
+{
+    //Gradients with size which isn't multiple of block size, red and green change along different axises,
+    //so colors of a block aren't on a line and BC1 error is inherent.
+    const uint32_t width = 37u;
+    const uint32_t height = 21u;
+    std::vector<uint8_t> image(width * height * 4u);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint8_t *pPixel = image.data() + (y * width + x) * 4u;
+            pPixel[0] = static_cast<uint8_t>(x * 255u / (width - 1u));
+            pPixel[1] = static_cast<uint8_t>(y * 255u / (height - 1u));
+            pPixel[2] = static_cast<uint8_t>(128u + 64.0 * std::sin(x * 0.2));
+            pPixel[3] = static_cast<uint8_t>((x + y) * 255u / (width + height - 2u));
+        }
+    }
+
+    const fd::BlockFormat formats[] = {fd::BlockFormat::BC1, fd::BlockFormat::BC2, fd::BlockFormat::BC3,
+        fd::BlockFormat::BC4, fd::BlockFormat::BC5};
+    const char *names[] = {"BC1", "BC2", "BC3", "BC4", "BC5"};
+    const double maxErrors[] = {8.0, 8.0, 8.0, 2.0, 2.0};
+    for (uint32_t formatIndex = 0; formatIndex < 5u; ++formatIndex)
+    {
+        auto format = formats[formatIndex];
+        uint32_t channelCount = fd::getBlockFormatChannelCount(format);
+        std::vector<uint8_t> pixels(width * height * channelCount);
+        for (uint32_t i = 0; i < width * height; ++i)
+        {
+            for (uint32_t c = 0; c < channelCount; ++c) pixels[i * channelCount + c] = image[i * 4u + c];
+            //Alpha of BC1 isn't encoded.
+            if (format == fd::BlockFormat::BC1) pixels[i * 4u + 3u] = 255u;
+        }
+        uint32_t size = fd::getBlockCompressedSize(format, width, height);
+        if (size != 10u * 6u * fd::getBlockByteSize(format))
+        {
+            LOG(plog::error) << names[formatIndex] << " compressed size is " << size << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> blocks(size);
+        fd::compressBlocks(format, pixels.data(), width, height, blocks.data());
+        std::vector<uint8_t> decoded(pixels.size());
+        fd::decompressBlocks(format, blocks.data(), width, height, decoded.data());
+        double error = getRMSError(pixels, decoded);
+        if (error > maxErrors[formatIndex])
+        {
+            LOG(plog::error) << names[formatIndex] << " round trip error is " << error << std::endl;
+            return false;
+        }
+
+        //Solid color is kept exactly when it can be represented by endpoints.
+        std::vector<uint8_t> solid(pixels.size(), 0u);
+        for (uint32_t i = 0; i < width * height; ++i)
+        {
+            const uint8_t color[4] = {255u, 0u, 255u, 255u};
+            for (uint32_t c = 0; c < channelCount; ++c) solid[i * channelCount + c] = color[c];
+        }
+        fd::compressBlocks(format, solid.data(), width, height, blocks.data());
+        fd::decompressBlocks(format, blocks.data(), width, height, decoded.data());
+        if (decoded != solid)
+        {
+            LOG(plog::error) << names[formatIndex] << " solid color isn't kept." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testDecodeBC1() == false) result = 1;
+    if (testRoundTrip() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,148 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cmath>
+
+bool testMipLevelSelection()
+{
+    //A quad with 2 x 2 world size mapped to the whole uv range.
+    float positions[] = {
+        0.0f, 0.0f, 0.0f,
+        2.0f, 0.0f, 0.0f,
+        2.0f, 2.0f, 0.0f,
+        0.0f, 2.0f, 0.0f,
+    };
+    float uvs[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f,
+    };
+    uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+    float uvDensity = fd::caculateUVDensity(positions, sizeof(float) * 3u, uvs, sizeof(float) * 2u, indices, 6u);
+    if (std::abs(uvDensity - 0.5f) > 0.0001f)
+    {
+        LOG(plog::error) << "UV density of the quad is " << uvDensity << ", it should be 0.5." << std::endl;
+        return false;
+    }
+
+    //512 texels per world unit are shown with 128 pixels per world unit.
+    uint32_t level = fd::caculateStreamingMipLevel(1024u, 11u, uvDensity, 128.0f);
+    if (level != 2u)
+    {
+        LOG(plog::error) << "Streaming mip level is " << level << ", it should be 2." << std::endl;
+        return false;
+    }
+    if (fd::caculateStreamingMipLevel(1024u, 11u, uvDensity, 4096.0f) != 0u ||
+        fd::caculateStreamingMipLevel(1024u, 11u, uvDensity, 0.0f) != 10u)
+    {
+        LOG(plog::error) << "Streaming mip level isn't clamped." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool testResidency()
+{
+    const uint32_t mipLevelCount = 11u;
+    const uint32_t mipTailLevel = 5u;
+    std::vector<uint64_t> mipSizes(mipLevelCount);
+    for (uint32_t level = 0; level < mipLevelCount; ++level)
+    {
+        uint64_t size = 1024u >> level;
+        mipSizes[level] = size * size * 4u;
+    }
+    uint64_t tailSize = 0u;
+    for (uint32_t level = mipTailLevel; level < mipLevelCount; ++level) tailSize += mipSizes[level];
+    uint64_t fullSize = tailSize;
+    for (uint32_t level = 0; level < mipTailLevel; ++level) fullSize += mipSizes[level];
+
+    //Mip tails of 3 textures, the whole chain of one texture and the chain from level 1 of another fit the budget.
+    fd::TextureResidency residency(tailSize + fullSize * 2u - mipSizes[0], 2u);
+    uint32_t textures[3];
+    for (uint32_t i = 0; i < 3u; ++i)
+    {
+        textures[i] = residency.addTexture(mipSizes.data(), mipLevelCount, mipTailLevel);
+    }
+    if (residency.getResidentSize() != tailSize * 3u || residency.getResidentLevel(textures[0]) != mipTailLevel)
+    {
+        LOG(plog::error) << "Textures should begin with their mip tails resident." << std::endl;
+        return false;
+    }
+
+    std::vector<fd::TextureResidency::Change> changes;
+    residency.request(textures[0], 0u);
+    residency.update(changes);
+    if (changes.size() != 1u || changes[0].textureIndex != textures[0] || changes[0].residentLevel != 0u)
+    {
+        LOG(plog::error) << "Requested texture should be loaded to level 0." << std::endl;
+        return false;
+    }
+
+    //Texture 0 isn't requested anymore, so it is evicted to its mip tail for texture 1.
+    residency.request(textures[1], 0u);
+    residency.update(changes);
+    if (residency.getResidentLevel(textures[0]) != mipTailLevel || residency.getResidentLevel(textures[1]) != 0u)
+    {
+        LOG(plog::error) << "Least recently requested texture should be evicted." << std::endl;
+        return false;
+    }
+    if (residency.getResidentSize() > residency.getMemoryBudget())
+    {
+        LOG(plog::error) << "Resident size exceeds the memory budget." << std::endl;
+        return false;
+    }
+
+    //Both are requested, the second one only gets the finest level which fits the budget.
+    residency.request(textures[1], 0u);
+    residency.request(textures[2], 0u);
+    residency.update(changes);
+    if (residency.getResidentLevel(textures[1]) != 0u || residency.getResidentLevel(textures[2]) != 1u ||
+        residency.getResidentSize() > residency.getMemoryBudget())
+    {
+        LOG(plog::error) << "Texture should be loaded partially when the budget is full." << std::endl;
+        return false;
+    }
+
+    //Requests are limited by max load count per update.
+    residency.setMemoryBudget(fullSize * 3u);
+    for (uint32_t i = 0; i < 3u; ++i) residency.request(textures[i], 0u);
+    residency.setMaxLoadCountPerUpdate(1u);
+    residency.update(changes);
+    if (changes.size() != 1u)
+    {
+        LOG(plog::error) << "Only one texture should be loaded in one update." << std::endl;
+        return false;
+    }
+
+    //Decreasing the budget evicts textures without requests.
+    residency.setMemoryBudget(tailSize * 3u);
+    residency.update(changes);
+    if (residency.getResidentSize() != tailSize * 3u)
+    {
+        LOG(plog::error) << "Textures should be evicted to mip tails when the budget is decreased." << std::endl;
+        return false;
+    }
+
+    residency.removeTexture(textures[1]);
+    if (residency.getResidentSize() != tailSize * 2u ||
+        residency.addTexture(mipSizes.data(), mipLevelCount, mipTailLevel) != textures[1])
+    {
+        LOG(plog::error) << "Removed texture should free its memory and index." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testMipLevelSelection() == false) result = 1;
+    if (testResidency() == false) result = 1;
+    return result;
+}
@@ -0,0 +1,70 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <atomic>
+
+bool testParallelFor()
+{
+    fd::ThreadPool pool(3u);
+    //Every index should be called only once, and all calls should be finished when it returns.
+    for (uint32_t count : {0u, 1u, 2u, 7u, 1000u})
+    {
+        std::vector<uint32_t> callCounts(count, 0u);
+        std::atomic<uint32_t> totalCount(0u);
+        pool.parallelFor(count, [&](uint32_t index) {
+            ++callCounts[index];
+            ++totalCount;
+        });
+        if (totalCount.load() != count)
+        {
+            LOG(plog::error) << "Parallel for calls " << totalCount.load() << " times for count " << count << std::endl;
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (callCounts[i] != 1u)
+            {
+                LOG(plog::error) << "Parallel for calls index " << i << " " << callCounts[i] << " times." << std::endl;
+                return false;
+            }
+        }
+    }
+
+    //Parallel prefix sum writing into disjoint ranges of one buffer.
+    std::vector<uint32_t> sizes = {3u, 0u, 5u, 1u, 8u};
+    std::vector<uint32_t> offsets(sizes.size());
+    uint32_t total = 0u;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        offsets[i] = total;
+        total += sizes[i];
+    }
+    std::vector<uint32_t> buffer(total);
+    pool.parallelFor(static_cast<uint32_t>(sizes.size()), [&](uint32_t index) {
+        for (uint32_t j = 0; j < sizes[index]; ++j) buffer[offsets[index] + j] = index;
+    });
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        for (uint32_t j = 0; j < sizes[i]; ++j)
+        {
+            if (buffer[offsets[i] + j] != i)
+            {
+                LOG(plog::error) << "Parallel for writes wrong data." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testParallelFor() == false) result = 1;
+    return result;
+}
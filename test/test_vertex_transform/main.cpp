@@ -0,0 +1,97 @@
+#include <plog/Log.h>
+#include <foundation/foundation.hpp>
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+//Position is after a color and is followed by a uv, as vertices of a sprite.
+struct Vertex
+{
+    float color[4];
+    float position[2];
+    float uv[2];
+};
+
+float random(float min, float max)
+{
+    return min + (max - min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+bool testTransformVertices()
+{
+    glm::mat3 matrix(glm::vec3(0.8f, 0.6f, 0.0f)
+        , glm::vec3(-1.2f, 1.6f, 0.0f)
+        , glm::vec3(30.0f, -20.0f, 1.0f)
+        );
+    srand(1u);
+    //Odd count makes the last vertex to be transformed alone.
+    const uint32_t vertexCount = 37u;
+    std::vector<Vertex> srcVertices(vertexCount);
+    for (auto &vertex : srcVertices)
+    {
+        for (uint32_t i = 0; i < 4u; ++i) vertex.color[i] = random(0.0f, 1.0f);
+        vertex.position[0] = random(-100.0f, 100.0f);
+        vertex.position[1] = random(-100.0f, 100.0f);
+        vertex.uv[0] = random(0.0f, 1.0f);
+        vertex.uv[1] = random(0.0f, 1.0f);
+    }
+    std::vector<Vertex> dstVertices(vertexCount);
+    fd::transformVertices2(srcVertices.data(), dstVertices.data(), vertexCount
+        , static_cast<uint32_t>(sizeof(Vertex)), static_cast<uint32_t>(offsetof(Vertex, position)), matrix);
+
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const auto &src = srcVertices[i];
+        const auto &dst = dstVertices[i];
+        glm::vec3 expected = matrix * glm::vec3(src.position[0], src.position[1], 1.0f);
+        if (std::fabs(dst.position[0] - expected.x) > 0.001f || std::fabs(dst.position[1] - expected.y) > 0.001f)
+        {
+            LOG(plog::error) << "Position of vertex " << i << " is (" << dst.position[0] << ", " << dst.position[1]
+                << "), it should be (" << expected.x << ", " << expected.y << ")." << std::endl;
+            return false;
+        }
+        if (std::memcmp(src.color, dst.color, sizeof(src.color)) != 0 || std::memcmp(src.uv, dst.uv, sizeof(src.uv)) != 0)
+        {
+            LOG(plog::error) << "Attributes of vertex " << i << " aren't copied." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testOffsetIndices()
+{
+    //Count isn't a multiple of 4.
+    const uint32_t indexCount = 18u;
+    std::vector<uint32_t> srcIndices(indexCount);
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+        srcIndices[i] = i % 4u;
+    }
+    std::vector<uint32_t> dstIndices(indexCount);
+    fd::offsetIndices(srcIndices.data(), dstIndices.data(), indexCount, 100u);
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+        if (dstIndices[i] != srcIndices[i] + 100u)
+        {
+            LOG(plog::error) << "Index " << i << " is " << dstIndices[i] << ", it should be "
+                << srcIndices[i] + 100u << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    fd::moduleCreate(plog::debug);
+    static plog::DebugOutputAppender<plog::TxtFormatter> debugOutputAppender;
+    plog::init(plog::debug, &debugOutputAppender);
+
+    int result = 0;
+    if (testTransformVertices() == false) result = 1;
+    if (testOffsetIndices() == false) result = 1;
+    return result;
+}